@@ -56,6 +56,7 @@ SET (XRT_DKMS_DRIVER_SRCS
   zocl/edge/zocl_edge_kds.c
   zocl/edge/zocl_error.c
   zocl/edge/zocl_mailbox.c
+  zocl/edge/zocl_svm.c
 
   zocl/include/zocl_aie.h
   zocl/include/zocl_bo.h
@@ -72,6 +73,7 @@ SET (XRT_DKMS_DRIVER_SRCS
   zocl/include/zocl_mailbox.h
   zocl/include/zocl_ospi_versal.h
   zocl/include/zocl_sk.h
+  zocl/include/zocl_svm.h
   zocl/include/zocl_util.h
   zocl/include/zocl_xclbin.h
   zocl/include/zocl_xgq.h
@@ -25,14 +25,135 @@
 #include <pybind11/stl_bind.h>
 
 // C++11 includes
+#include <exception>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <stdexcept>
 #include <string>
 
 namespace py = pybind11;
 
 PYBIND11_MAKE_OPAQUE(std::vector<xrt::xclbin::ip>);
 
+namespace {
+
+// Request a view of a buffer protocol object for direct access.  The
+// data is read or written in place, so the buffer must be C contiguous.
+py::buffer_info
+contiguous_buffer(const py::buffer& pyb, bool writable)
+{
+    auto info = pyb.request(writable);
+    py::ssize_t stride = info.itemsize;
+    for (auto dim = info.ndim; dim-- > 0;) {
+        if (info.shape[dim] > 1 && info.strides[dim] != stride)
+            throw std::invalid_argument("buffer must be C contiguous");
+        stride *= info.shape[dim];
+    }
+    return info;
+}
+
+// class async_completion - Completion of an XRT operation awaited in asyncio
+//
+// The future is created on the running event loop of the calling
+// thread.  XRT completes the operation on one of its own threads, the
+// result is handed to the loop with call_soon_threadsafe which wakes
+// the loop through its self pipe, so no Python thread is blocked per
+// operation.  The completion may be destroyed by an XRT thread, the
+// Python objects are released with the GIL held.
+class async_completion
+{
+    py::object m_loop;
+    py::object m_future;
+
+    void
+    post(py::cpp_function fcn)
+    {
+        try {
+            m_loop.attr("call_soon_threadsafe")(fcn);
+        }
+        catch (const py::error_already_set&) {
+            // event loop is closed, nobody is awaiting the result
+        }
+    }
+
+public:
+    async_completion()
+        : m_loop(py::module::import("asyncio").attr("get_running_loop")())
+        , m_future(m_loop.attr("create_future")())
+    {}
+
+    ~async_completion()
+    {
+        py::gil_scoped_acquire gil;
+        m_future = py::object();
+        m_loop = py::object();
+    }
+
+    py::object
+    future() const
+    {
+        return m_future;
+    }
+
+    // Called without the GIL from the completing thread
+    void
+    set_result(std::function<py::object()> result)
+    {
+        py::gil_scoped_acquire gil;
+        auto future = m_future;
+        auto value = result();
+        post(py::cpp_function([future, value] {
+            if (!future.attr("done")().cast<bool>())
+                future.attr("set_result")(value);
+        }));
+    }
+
+    // Called without the GIL from the completing thread
+    void
+    set_exception(std::exception_ptr eptr)
+    {
+        std::string msg = "unknown error";
+        try {
+            std::rethrow_exception(eptr);
+        }
+        catch (const std::exception& ex) {
+            msg = ex.what();
+        }
+        catch (...) {
+        }
+
+        py::gil_scoped_acquire gil;
+        auto future = m_future;
+        auto error = py::reinterpret_borrow<py::object>(PyExc_RuntimeError)(msg);
+        post(py::cpp_function([future, error] {
+            if (!future.attr("done")().cast<bool>())
+                future.attr("set_exception")(error);
+        }));
+    }
+};
+
+py::object
+sync_async(xrt::bo& b, xclBOSyncDirection dir, size_t size, size_t offset)
+{
+    auto completion = std::make_shared<async_completion>();
+    auto future = completion->future();
+    {
+        py::gil_scoped_release release;
+        auto handle = b.async(dir, size, offset);
+        handle.set_callback([completion](std::exception_ptr eptr) {
+            if (eptr)
+                completion->set_exception(eptr);
+            else
+                completion->set_result([] { return py::none(); });
+        });
+    }
+    return future;
+}
+
+}
+
 PYBIND11_MODULE(pyxrt, m) {
     m.doc() = "Pybind11 module for XRT";
 
@@ -130,10 +251,10 @@ PYBIND11_MODULE(pyxrt, m) {
                       }))
         .def("load_xclbin", [](xrt::device& d, const std::string& xclbin) {
                                 return d.load_xclbin(xclbin);
-                            }, "Load an xclbin given the path to the device")
+                            }, py::call_guard<py::gil_scoped_release>(), "Load an xclbin given the path to the device")
         .def("load_xclbin", [](xrt::device& d, const xrt::xclbin& xclbin) {
                                 return d.load_xclbin(xclbin);
-                            }, "Load the xclbin to the device")
+                            }, py::call_guard<py::gil_scoped_release>(), "Load the xclbin to the device")
         .def("register_xclbin", [](xrt::device& d, const xrt::xclbin& xclbin) {
                                 return d.register_xclbin(xclbin);
                             }, "Register an xclbin with the device")
@@ -191,7 +312,7 @@ PYBIND11_MODULE(pyxrt, m) {
         .def(py::init<const xrt::kernel &>())
         .def("start", [](xrt::run& r){
                           r.start();
-                      }, "Start one execution of a run")
+                      }, py::call_guard<py::gil_scoped_release>(), "Start one execution of a run")
         .def("set_arg", [](xrt::run& r, int i, xrt::bo& item){
                             r.set_arg(i, item);
                         }, "Set a specific kernel global argument for a run")
@@ -200,10 +321,21 @@ PYBIND11_MODULE(pyxrt, m) {
                         }, "Set a specific kernel scalar argument for this run")
         .def("wait", ([](xrt::run& r)  {
                            return r.wait(0);
-                      }), "Wait for the run to complete")
+                      }), py::call_guard<py::gil_scoped_release>(), "Wait for the run to complete")
         .def("wait", ([](xrt::run& r, unsigned int timeout_ms)  {
                           return r.wait(timeout_ms);
-                      }), "Wait for the specified milliseconds for the run to complete")
+                      }), py::call_guard<py::gil_scoped_release>(), "Wait for the specified milliseconds for the run to complete")
+        .def("start_async", [](xrt::run& r) {
+                          auto completion = std::make_shared<async_completion>();
+                          auto future = completion->future();
+                          {
+                              py::gil_scoped_release release;
+                              r.start([completion](ert_cmd_state state) {
+                                  completion->set_result([state] { return py::cast(state); });
+                              });
+                          }
+                          return future;
+                      }, "Start one execution of a run, returns an asyncio future for the final state of the run")
         .def("state", &xrt::run::state, "Check the current state of a run object")
         .def("add_callback", &xrt::run::add_callback, "Add a callback function for run state");
 
@@ -269,24 +401,53 @@ PYBIND11_MODULE(pyxrt, m) {
     pybo.def(py::init<xrt::device, size_t, xrt::bo::flags, xrt::memory_group>(), "Create a buffer object with specified properties")
         .def(py::init<xrt::bo, size_t, size_t>(), "Create a sub-buffer of an existing buffer object of specifed size and offset in the existing buffer")
         .def("write", ([](xrt::bo &b, py::buffer pyb, size_t seek)  {
-                           py::buffer_info info = pyb.request();
+                           auto info = contiguous_buffer(pyb, false);
+                           py::gil_scoped_release release;
                            b.write(info.ptr, info.itemsize * info.size , seek);
                        }), "Write the provided data into the buffer object starting at specified offset")
         .def("read", ([](xrt::bo &b, size_t size, size_t skip) {
                           py::array_t<char> result = py::array_t<char>(size);
                           py::buffer_info bufinfo = result.request();
-                          b.read(bufinfo.ptr, size, skip);
+                          {
+                              py::gil_scoped_release release;
+                              b.read(bufinfo.ptr, size, skip);
+                          }
                           return result;
                       }), "Read from the buffer object requested number of bytes starting from specified offset")
+        .def("read_into", ([](xrt::bo &b, py::buffer pyb, size_t skip) {
+                          auto info = contiguous_buffer(pyb, true);
+                          py::gil_scoped_release release;
+                          b.read(info.ptr, info.itemsize * info.size, skip);
+                      }), "Read from the buffer object into the provided writable buffer, filling it, starting from specified offset")
         .def("sync", ([](xrt::bo &b, xclBOSyncDirection dir, size_t size, size_t offset)  {
                           b.sync(dir, size, offset);
-                      }), "Synchronize (DMA or cache flush/invalidation) the buffer in the requested direction")
+                      }), py::call_guard<py::gil_scoped_release>(), "Synchronize (DMA or cache flush/invalidation) the buffer in the requested direction")
         .def("sync", ([](xrt::bo& b, xclBOSyncDirection dir) {
                           b.sync(dir);
-                      }), "Sync entire buffer content in specified direction.")
+                      }), py::call_guard<py::gil_scoped_release>(), "Sync entire buffer content in specified direction.")
+        .def("sync_async", ([](xrt::bo &b, xclBOSyncDirection dir, size_t size, size_t offset)  {
+                          return sync_async(b, dir, size, offset);
+                      }), "Start synchronizing the buffer in the requested direction, returns an asyncio future that completes with the sync")
+        .def("sync_async", ([](xrt::bo& b, xclBOSyncDirection dir) {
+                          return sync_async(b, dir, b.size(), 0);
+                      }), "Start syncing entire buffer content in specified direction, returns an asyncio future")
         .def("map", ([](xrt::bo &b)  {
                          return py::memoryview::from_memory(b.map(), b.size());
                      }), "Create a byte accessible memory view of the buffer object")
+        .def("map", ([](py::object self, py::dtype dtype)  {
+                         auto& b = self.cast<xrt::bo&>();
+                         auto count = static_cast<py::ssize_t>(b.size() / dtype.itemsize());
+                         return py::array(dtype, {count}, {}, b.map(), self);
+                     }), "Create a one dimensional array view of the buffer object with the given element type, no data is copied")
+        .def("map", ([](py::object self, py::dtype dtype, std::vector<py::ssize_t> shape)  {
+                         auto& b = self.cast<xrt::bo&>();
+                         size_t bytes = dtype.itemsize();
+                         for (auto dim : shape)
+                             bytes *= dim;
+                         if (bytes > b.size())
+                             throw std::out_of_range("shape exceeds the size of the buffer object");
+                         return py::array(dtype, shape, {}, b.map(), self);
+                     }), "Create an array view of the buffer object with the given element type and shape, no data is copied")
         .def("size", &xrt::bo::size, "Return the size of the buffer object")
         .def("address", &xrt::bo::address, "Return the device physical address of the buffer object");
 
@@ -115,6 +115,18 @@ public:
   {
     m_graphHandle->read_graph_rtp(port, buffer, size);
   }
+
+  void
+  update_rtps(const std::vector<graph::rtp_update>& rtps)
+  {
+    m_graphHandle->update_graph_rtps(rtps);
+  }
+
+  void
+  read_rtps(const std::vector<graph::rtp_read>& rtps)
+  {
+    m_graphHandle->read_graph_rtps(rtps);
+  }
 };
 
 }
@@ -387,6 +399,24 @@ read_port(const std::string& port_name, void* value, size_t bytes)
   });
 }
 
+void
+graph::
+update_ports(const std::vector<rtp_update>& rtps)
+{
+  xdp::native::profiling_wrapper("xrt::graph::update_ports", [this, &rtps]{
+    handle->update_rtps(rtps);
+  });
+}
+
+void
+graph::
+read_ports(const std::vector<rtp_read>& rtps)
+{
+  xdp::native::profiling_wrapper("xrt::graph::read_ports", [this, &rtps]{
+    handle->read_rtps(rtps);
+  });
+}
+
 } // namespace xrt
 
 ////////////////////////////////////////////////////////////////
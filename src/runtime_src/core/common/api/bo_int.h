@@ -18,6 +18,17 @@ get_buffer_handle(const xrt::bo& bo);
 size_t
 get_offset(const xrt::bo& bo);
 
+// register_host_memory() - Register host memory range with device
+//
+// Userptr buffers within a registered range are sub-buffers of one
+// buffer spanning the range, so the range is pinned once.
+void
+register_host_memory(const xrt_core::device* device, void* ptr, size_t sz);
+
+// unregister_host_memory() - Unregister range containing ptr
+void
+unregister_host_memory(const xrt_core::device* device, void* ptr);
+
 // create_debug_bo() - Create a debug buffer object within a hwctx
 //  
 // Allocates a debug buffer object within a hwctx. The debug BO
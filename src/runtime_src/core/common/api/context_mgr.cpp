@@ -105,10 +105,9 @@ public:
   // Close the cu context and notify threads that might be waiting
   // to open this cu
   void
-  close(const xrt::hw_context& hwctx, cuidx_type ipidx)
+  close(hwctx_handle* hwctx_hdl, cuidx_type ipidx)
   {
     std::lock_guard<std::mutex> lk(m_mutex);
-    auto hwctx_hdl = static_cast<hwctx_handle*>(hwctx);
     auto& ctx = m_ctx[hwctx_hdl];
     if (!ctx.get(ipidx))
       throw std::runtime_error("ctx " + std::to_string(ipidx.index) + " not open");
@@ -161,8 +160,14 @@ void
 close_context(const xrt::hw_context& hwctx, cuidx_type cuidx)
 {
   auto device = xrt_core::hw_context_int::get_core_device_raw(hwctx);
+  close_context(device, static_cast<hwctx_handle*>(hwctx), cuidx);
+}
+
+void
+close_context(const xrt_core::device* device, hwctx_handle* hwctx_hdl, cuidx_type cuidx)
+{
   if (auto ctxmgr = get_device_context_mgr(device)) {
-    ctxmgr->close(hwctx, cuidx);
+    ctxmgr->close(hwctx_hdl, cuidx);
     return;
   }
 
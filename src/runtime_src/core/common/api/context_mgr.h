@@ -14,6 +14,7 @@
 namespace xrt_core {
 
 class device;
+class hwctx_handle;
 
 // Context management is somewhat complex in multi-threaded host
 // applications where same device object is shared between threads.
@@ -59,4 +60,10 @@ open_context(const xrt::hw_context& hwctx, const std::string& ipname);
 void
 close_context(const xrt::hw_context& hwctx, cuidx_type cuidx);
 
+// Close a context given the raw device and hwctx handle.  Used when
+// the context is closed during destruction of the hw context that
+// owns it, at which time no xrt::hw_context can be referenced.
+void
+close_context(const xrt_core::device* device, hwctx_handle* hwctx_hdl, cuidx_type cuidx);
+
 }} // context_mgr, xrt_core
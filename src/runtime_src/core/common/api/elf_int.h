@@ -6,6 +6,7 @@
 // This file defines implementation extensions to the XRT ELF APIs.
 #include "core/include/experimental/xrt_elf.h"
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -20,8 +21,15 @@ namespace xrt_core { namespace elf_int {
 std::vector<uint8_t>
 get_section(const xrt::elf& elf, const std::string& sname);
 
+// ELFIO object of the ELF.  Section data is loaded lazily and
+// the object is shared by all xrt::elf objects with the same
+// content, hold the lock() while accessing it.
 const ELFIO::elfio&
 get_elfio(const xrt::elf& elf);
+
+// Lock for access to the ELFIO object
+std::unique_lock<std::mutex>
+lock(const xrt::elf& elf);
     
 
 }} // xclbin_int, xrt_core
@@ -6,12 +6,60 @@
 
 #include "core/common/error.h"
 
-#include <map>
+#include <array>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace xrt_core {
 
+// Handles are spread over shards each with its own reader / writer
+// lock, so concurrent lookups of different handles, or of the same
+// handle, do not serialize on a single mutex.
+template <typename HandleType, typename ValueType>
+class handle_shards
+{
+  static constexpr size_t num_shards = 16;
+
+  struct shard
+  {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<HandleType, ValueType> handles;
+  };
+
+  std::array<shard, num_shards> shards;
+
+public:
+  // Handles are often pointers whose low bits are zero, mix in
+  // higher bits before selecting the shard
+  shard&
+  get_shard(HandleType handle)
+  {
+    auto h = std::hash<HandleType>{}(handle);
+    return shards[(h ^ (h >> 4) ^ (h >> 12)) % num_shards];
+  }
+
+  const shard&
+  get_shard(HandleType handle) const
+  {
+    return const_cast<handle_shards*>(this)->get_shard(handle);
+  }
+
+  size_t
+  size() const
+  {
+    size_t sz = 0;
+    for (auto& s : shards) {
+      std::shared_lock lk(s.mutex);
+      sz += s.handles.size();
+    }
+    return sz;
+  }
+};
+
 // Custom mutex protected handle map for managing C-API handles that
 // must be explicitly opened and closed.  For some of the C-APIs,
 // the implmentation is a managed shared object so when the handle
@@ -27,25 +75,16 @@ class handle_map
 template <typename HandleType, typename ImplType>
 class handle_map<HandleType, std::shared_ptr<ImplType>>
 {
-  mutable std::mutex mutex;
-  std::map<HandleType, std::shared_ptr<ImplType>> handles;
-
-  std::shared_ptr<ImplType>
-  get_no_lock(HandleType handle) const
-  {
-    auto itr = handles.find(handle);
-    return (itr == handles.end())
-      ? nullptr
-      : itr->second;
-  }
+  handle_shards<HandleType, std::shared_ptr<ImplType>> shards;
 
 public:
   const std::shared_ptr<ImplType>&
   get_or_error(HandleType handle) const
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    auto itr = handles.find(handle);
-    if (itr == handles.end())
+    auto& s = shards.get_shard(handle);
+    std::shared_lock lk(s.mutex);
+    auto itr = s.handles.find(handle);
+    if (itr == s.handles.end())
       throw xrt_core::error(-EINVAL, "No such handle");
 
     return (*itr).second;
@@ -54,9 +93,10 @@ public:
   std::shared_ptr<ImplType>
   get(HandleType handle) const
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    auto itr = handles.find(handle);
-    return (itr == handles.end())
+    auto& s = shards.get_shard(handle);
+    std::shared_lock lk(s.mutex);
+    auto itr = s.handles.find(handle);
+    return (itr == s.handles.end())
       ? nullptr
       : (*itr).second;
   }
@@ -64,53 +104,63 @@ public:
   void
   add(HandleType handle, std::shared_ptr<ImplType>&& impl)
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    handles.emplace(handle, std::move(impl));
+    auto& s = shards.get_shard(handle);
+    std::lock_guard lk(s.mutex);
+    s.handles.emplace(handle, std::move(impl));
   }
 
   void
   remove_or_error(HandleType handle)
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    if (handles.erase(handle) == 0)
+    auto& s = shards.get_shard(handle);
+    std::lock_guard lk(s.mutex);
+    if (s.handles.erase(handle) == 0)
       throw xrt_core::error(-EINVAL, "No such handle");
   }
 
   void
   remove(HandleType handle)
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    handles.erase(handle);
+    // Destroy the implementation outside the lock, its destructor
+    // may be slow or may in turn access handle maps
+    std::shared_ptr<ImplType> impl;
+    auto& s = shards.get_shard(handle);
+    std::lock_guard lk(s.mutex);
+    auto itr = s.handles.find(handle);
+    if (itr == s.handles.end())
+      return;
+    impl = std::move(itr->second);
+    s.handles.erase(itr);
   }
 
   size_t
   count(HandleType handle) const
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    return handles.count(handle);
+    auto& s = shards.get_shard(handle);
+    std::shared_lock lk(s.mutex);
+    return s.handles.count(handle);
   }
 
   size_t
   size() const
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    return handles.size();
+    return shards.size();
   }
 };
 
 template <typename HandleType, typename ImplType>
 class handle_map<HandleType, std::unique_ptr<ImplType>>
 {
-  mutable std::mutex mutex;
-  std::map<HandleType, std::unique_ptr<ImplType>> handles;
+  handle_shards<HandleType, std::unique_ptr<ImplType>> shards;
 
 public:
   ImplType*
   get_or_error(HandleType handle) const
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    auto itr = handles.find(handle);
-    if (itr == handles.end())
+    auto& s = shards.get_shard(handle);
+    std::shared_lock lk(s.mutex);
+    auto itr = s.handles.find(handle);
+    if (itr == s.handles.end())
       throw xrt_core::error(-EINVAL, "No such handle");
     return (*itr).second.get();
   }
@@ -118,9 +168,10 @@ public:
   ImplType*
   get(HandleType handle) const
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    auto itr = handles.find(handle);
-    return (itr == handles.end())
+    auto& s = shards.get_shard(handle);
+    std::shared_lock lk(s.mutex);
+    auto itr = s.handles.find(handle);
+    return (itr == s.handles.end())
       ? nullptr
       : (*itr).second.get();
   }
@@ -128,30 +179,40 @@ public:
   void
   add(HandleType handle, std::unique_ptr<ImplType>&& impl)
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    handles.emplace(handle, std::move(impl));
+    auto& s = shards.get_shard(handle);
+    std::lock_guard lk(s.mutex);
+    s.handles.emplace(handle, std::move(impl));
   }
 
   void
   remove_or_error(HandleType handle)
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    if (handles.erase(handle) == 0)
+    auto& s = shards.get_shard(handle);
+    std::lock_guard lk(s.mutex);
+    if (s.handles.erase(handle) == 0)
       throw xrt_core::error(-EINVAL, "No such handle");
   }
 
   void
   remove(HandleType handle)
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    handles.erase(handle);
+    // Destroy the implementation outside the lock
+    std::unique_ptr<ImplType> impl;
+    auto& s = shards.get_shard(handle);
+    std::lock_guard lk(s.mutex);
+    auto itr = s.handles.find(handle);
+    if (itr == s.handles.end())
+      return;
+    impl = std::move(itr->second);
+    s.handles.erase(itr);
   }
 
   size_t
   count(HandleType handle) const
   {
-    std::lock_guard<std::mutex> lk(mutex);
-    return handles.count(handle);
+    auto& s = shards.get_shard(handle);
+    std::shared_lock lk(s.mutex);
+    return s.handles.count(handle);
   }
 };
 
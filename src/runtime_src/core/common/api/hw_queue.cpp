@@ -10,9 +10,14 @@
 #include "fence_int.h"
 #include "kernel_int.h"
 
+#include "core/common/config_reader.h"
 #include "core/common/debug.h"
 #include "core/common/device.h"
+#include "core/common/error.h"
+#include "core/common/message.h"
+#include "core/common/query_requests.h"
 #include "core/common/thread.h"
+#include "core/common/trace.h"
 #include "core/include/ert.h"
 #include "core/include/xrt_hwqueue.h"
 
@@ -20,13 +25,18 @@
 #include "experimental/xrt_fence.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -59,6 +69,7 @@ inline void
 notify_host(xrt_core::command* cmd, ert_cmd_state state)
 {
   XRT_DEBUGF("xrt_core::kds::command(%d), [running->done]\n", cmd->get_uid());
+  XRT_TRACE_POINT_LOG(xrt_hw_queue_complete, cmd->get_uid(), static_cast<int>(state));
   auto retain = cmd->shared_from_this();
 
   // If retain is last reference to cmd, then the command object is
@@ -75,11 +86,98 @@ notify_host(xrt_core::command* cmd)
   notify_host(cmd, get_command_state(cmd));
 }
 
+// class submission_ring - bounded lock-free multi-producer ring
+//
+// @m_slots: Ring storage, each slot is tagged with a sequence number
+// @m_tail: Next slot to be claimed by a producer
+// @m_head: Next slot to be consumed, owned by the single consumer
+//
+// Producers (host threads calling launch()) claim a slot by advancing
+// m_tail and publish the command by releasing the slot sequence.  The
+// single consumer (the monitor thread) drains published slots in
+// claim order.  A slot is free for reuse when its sequence equals the
+// position a producer is trying to claim.
+template <size_t capacity>
+class submission_ring
+{
+  static_assert(capacity && (capacity & (capacity - 1)) == 0, "capacity must be power of 2");
+  static constexpr size_t mask = capacity - 1;
+
+  struct slot
+  {
+    std::atomic<size_t> seq {0};
+    xrt_core::command* cmd = nullptr;
+  };
+
+  std::array<slot, capacity> m_slots;
+  alignas(64) std::atomic<size_t> m_tail {0};
+  alignas(64) size_t m_head {0};
+
+public:
+  submission_ring()
+  {
+    for (size_t idx = 0; idx < capacity; ++idx)
+      m_slots[idx].seq.store(idx, std::memory_order_relaxed);
+  }
+
+  // try_push() - Publish command, return false if ring is full
+  bool
+  try_push(xrt_core::command* cmd)
+  {
+    auto pos = m_tail.load(std::memory_order_relaxed);
+    while (true) {
+      auto& s = m_slots[pos & mask];
+      auto seq = s.seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          s.cmd = cmd;
+          s.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0) {
+        return false;  // consumer has not released this slot yet
+      }
+      else {
+        pos = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // drain() - Consumer only, append all published commands to @cmds
+  void
+  drain(command_queue_type& cmds)
+  {
+    while (true) {
+      auto& s = m_slots[m_head & mask];
+      if (s.seq.load(std::memory_order_acquire) != m_head + 1)
+        return;
+      cmds.push_back(s.cmd);
+      s.seq.store(m_head + capacity, std::memory_order_release);
+      ++m_head;
+    }
+  }
+
+  // empty() - Consumer only, true if no slot has been claimed
+  //
+  // A claimed but not yet published slot makes the ring non-empty,
+  // the consumer must not park while a producer is mid publish.
+  bool
+  empty() const
+  {
+    return m_tail.load(std::memory_order_seq_cst) == m_head;
+  }
+};
+
 // class command_manager - managed command executuon
 //
 // @m_qimpl: The hw queue used for command submission
-// @work_mutex: Syncrhonize monitor thread with launched commands
-// @work_cond: Kick off monitor thread when there are new commands
+// @submitted_cmds: Lock-free ring of launched commands
+// @parked: True while monitor thread is blocked on work_cond
+// @work_mutex: Synchronize parking of monitor thread
+// @work_cond: Kick off parked monitor thread when there are new commands
+// @aborted_cmds: Commands that were pushed but failed submission
 // @monitor_thread: Thread for asynchronous monitoring of command execution
 // @stop: Stop the monitor thread
 //
@@ -89,6 +187,13 @@ notify_host(xrt_core::command* cmd)
 // completion.  This is the OpenCL model but is also supported by
 // native XRT APIs.
 //
+// Launching a command does not take any lock.  The command is pushed
+// to submitted_cmds and the monitor is rung only if it is parked.
+// Parking and ringing follow the futex protocol: the monitor
+// publishes @parked before it re-checks the ring, and the producer
+// publishes the command before it checks @parked, so at least one
+// side observes the other.
+//
 // The command manager requires submission and wait APIs to be implemented
 // by which ever object (hw queue) uses the manager.
 class command_manager
@@ -104,15 +209,71 @@ public:
   };
 
 private:
+  static constexpr size_t ring_capacity = 1024;
+
   executor* m_impl;
+  submission_ring<ring_capacity> submitted_cmds;
+  std::atomic<bool> parked {false};
   std::mutex work_mutex;
   std::condition_variable work_cond;
-  command_queue_type submitted_cmds;
+  std::mutex aborted_mutex;
+  std::atomic<bool> has_aborted {false};
+  command_queue_type aborted_cmds;
   bool stop = false;
 
   // thread can be constructed only after data members are initialized
   std::thread monitor_thread;
 
+  // Park the monitor thread until a command is launched or
+  // the manager is stopped.  Return false if stopped.
+  bool
+  park()
+  {
+    std::unique_lock<std::mutex> lk(work_mutex);
+    parked.store(true, std::memory_order_seq_cst);
+    while (!stop && submitted_cmds.empty())
+      work_cond.wait(lk);
+    parked.store(false, std::memory_order_relaxed);
+    return !stop;
+  }
+
+  // Ring the doorbell if the monitor thread is parked
+  void
+  ring()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!parked.load(std::memory_order_seq_cst))
+      return;
+
+    // Taking the lock guarantees the monitor is inside the
+    // condition wait, it set parked while holding the lock.
+    std::lock_guard<std::mutex> lk(work_mutex);
+    work_cond.notify_one();
+  }
+
+  // Remove commands that failed submission.  A command that is not
+  // found in @cmds has not yet been drained from the ring and is
+  // retained until next call.
+  void
+  remove_aborted(command_queue_type& cmds)
+  {
+    if (!has_aborted.load(std::memory_order_acquire))
+      return;
+
+    std::lock_guard<std::mutex> lk(aborted_mutex);
+    auto itr = aborted_cmds.begin();
+    while (itr != aborted_cmds.end()) {
+      auto cmd = std::find(cmds.begin(), cmds.end(), *itr);
+      if (cmd == cmds.end()) {
+        ++itr;
+        continue;
+      }
+      cmds.erase(cmd);
+      itr = aborted_cmds.erase(itr);
+    }
+    has_aborted.store(!aborted_cmds.empty(), std::memory_order_release);
+  }
+
   // monitor_loop() - Manage running commands and notify on completion
   //
   // The monitor thread services managed command and asynchronously
@@ -123,21 +284,26 @@ private:
   void
   monitor_loop()
   {
-    std::vector<xrt_core::command*> busy_cmds;
-    std::vector<xrt_core::command*> running_cmds;
+    command_queue_type busy_cmds;
+    command_queue_type running_cmds;
 
     while (true) {
 
       // Larger wait synchronized with launch()
-      {
-        std::unique_lock<std::mutex> lk(work_mutex);
-        while (!stop && running_cmds.empty() && submitted_cmds.empty())
-          work_cond.wait(lk);
-      }
+      if (running_cmds.empty() && submitted_cmds.empty() && !park())
+        return;
 
       if (stop)
         return;
 
+      // Commands that failed submission must be pruned before
+      // exec_wait, which would otherwise wait for a command that
+      // never reached the device.
+      submitted_cmds.drain(running_cmds);
+      remove_aborted(running_cmds);
+      if (running_cmds.empty())
+        continue;
+
       // Finer wait
       m_impl->wait(0);
 
@@ -146,21 +312,21 @@ private:
       // to submitted_cmds.
       //
       // Scenario if before exec_wait is that a new command was added
-      // to submitted_cmds and exec_buf immediately after the critical
-      // section above and that the command completion happens in the
+      // to submitted_cmds and exec_buf immediately after the park
+      // check above and that the command completion happens in the
       // exec_wait call. If submitted_cmds was drained, in for example
-      // above critical section, before the call to exec_wait it would
+      // above park check, before the call to exec_wait it would
       // not be in running_cmds and would not be notified of
       // completion.
       //
       // The sequence is very important.  It must be guaranteed that
       // exec_wait will never return for a command that is not yet
-      // in either running_cmds or submitted_cmds.
-      {
-        std::lock_guard<std::mutex> lk(work_mutex);
-        std::copy(submitted_cmds.begin(), submitted_cmds.end(), std::back_inserter(running_cmds));
-        submitted_cmds.clear();
-      }
+      // in either running_cmds or submitted_cmds.  The command is
+      // published to the ring before exec_buf (see launch()), and the
+      // acquire in drain() makes the publication visible here.
+      submitted_cmds.drain(running_cmds);
+      remove_aborted(running_cmds);
+
       // At this point running_cmds is guaranteed to contain the
       // command(s) for which exec_wait returned.
 
@@ -209,7 +375,7 @@ public:
     XRT_DEBUGF("command_manager::~command_manager() executor(0x%x)\n", m_impl);
     {
       // Modify stop while keeping the lock so that the multi
-      // conditional wait in monitor_loop is atomic.  E.g., a
+      // conditional wait in park() is atomic.  E.g., a
       // std::atomic stop is not sufficient.
       std::lock_guard lk(work_mutex);
       stop = true;
@@ -236,6 +402,20 @@ public:
     m_impl = impl;
   }
 
+  // Pin the monitor thread to specified cpu
+  void
+  pin(unsigned int cpu)
+  {
+    xrt_core::detail::set_cpu_affinity(monitor_thread, cpu);
+  }
+
+  // Pin the monitor thread to cpus of specified NUMA node
+  void
+  pin_numa(int node)
+  {
+    xrt_core::detail::set_numa_affinity(monitor_thread, node);
+  }
+
   // launch() - Submit a command for managed execution
   //
   // This function is used to schedule managed commands for
@@ -249,10 +429,12 @@ public:
 
     // Store command so completion can be tracked.  Make sure this is
     // done prior to exec_buf as exec_wait can otherwise be missed.
-    // See detailed explanation in monitor loop.
-    {
-      std::lock_guard<std::mutex> lk(work_mutex);
-      submitted_cmds.push_back(cmd);
+    // See detailed explanation in monitor loop.  A full ring is
+    // drained by the monitor as soon as exec_wait returns for any of
+    // the already submitted commands.
+    while (!submitted_cmds.try_push(cmd)) {
+      ring();
+      std::this_thread::yield();
     }
 
     // Submit the command
@@ -260,17 +442,22 @@ public:
       m_impl->submit(cmd);
     }
     catch (...) {
-      // Remove the pending command
-      std::lock_guard<std::mutex> lk(work_mutex);
+      // Remove the pending command, the monitor prunes it from its
+      // running list before the command state is examined again.
       assert(get_command_state(cmd)==ERT_CMD_STATE_NEW);
-      if (!submitted_cmds.empty())
-        submitted_cmds.pop_back();
+      {
+        std::lock_guard<std::mutex> lk(aborted_mutex);
+        aborted_cmds.push_back(cmd);
+        has_aborted.store(true, std::memory_order_release);
+      }
+      ring();
       throw;
     }
 
-    // This is somewhat expensive, it is better to have this after the
-    // exec_buf call so that actual execution doesn't have to wait.
-    work_cond.notify_one();
+    // This is only a fence and an atomic load unless the monitor is
+    // parked, it is better to have this after the exec_buf call so
+    // that actual execution doesn't have to wait.
+    ring();
   }
 };
 
@@ -301,6 +488,49 @@ stop_monitor_threads()
     s_command_manager_pool.clear();
 }
 
+// Number of command managers (completion threads) per hw queue
+// as specified by xrt.ini Runtime.completion_threads
+static size_t
+get_completion_threads()
+{
+  static size_t threads = std::max(1u, xrt_core::config::get_completion_threads());
+  return threads;
+}
+
+// Cpus to which completion threads are pinned as specified by xrt.ini
+// Runtime.completion_thread_cpus.  Empty list means no pinning.
+static const std::vector<unsigned int>&
+get_completion_thread_cpus()
+{
+  static std::vector<unsigned int> cpus = [] {
+    std::vector<unsigned int> value;
+    std::stringstream ss(xrt_core::config::get_completion_thread_cpus());
+    std::string tok;
+    while (std::getline(ss, tok, ',')) {
+      try {
+        value.push_back(static_cast<unsigned int>(std::stoul(tok)));
+      }
+      catch (const std::exception&) {
+        xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",
+                                "Ignoring invalid completion thread cpu '" + tok + "'");
+      }
+    }
+    return value;
+  }();
+  return cpus;
+}
+
+// NUMA node of device if xrt.ini Runtime.numa_affinity is enabled,
+// otherwise -1.
+static int
+get_numa_node(const xrt_core::device* device)
+{
+  if (!xrt_core::config::get_numa_affinity())
+    return -1;
+
+  return xrt_core::device_query_default<xrt_core::query::numa_node>(device, -1);
+}
+
 } // namespace
 
 namespace xrt_core {
@@ -309,35 +539,67 @@ namespace xrt_core {
 //
 // Implements the interface required for both managed
 // and unmanaged execution.
+//
+// Managed commands are monitored by one or more command managers
+// (completion threads) as configured by xrt.ini.  Commands are
+// sharded across the managers by hardware context so that commands
+// of one context are always monitored by the same thread.
 class hw_queue_impl : public command_manager::executor
 {
-  std::unique_ptr<command_manager> m_cmd_manager;
+  std::vector<std::atomic<command_manager*>> m_cmd_managers;
   unsigned int m_uid = 0;
+  int m_numa_node = -1;
+
+  // Index of command manager monitoring a command
+  size_t
+  get_shard(xrt_core::command* cmd) const
+  {
+    if (m_cmd_managers.size() == 1)
+      return 0;
 
-  // Thread safe on-demand creation of m_cmd_manager
+    auto hdl = reinterpret_cast<uintptr_t>(cmd->get_hwctx_handle());
+    return std::hash<uintptr_t>{}(hdl) % m_cmd_managers.size();
+  }
+
+  // Thread safe on-demand creation of command manager for shard
   command_manager*
-  get_cmd_manager()
+  get_cmd_manager(size_t shard)
   {
+    if (auto mgr = m_cmd_managers[shard].load(std::memory_order_acquire))
+      return mgr;
+
     std::lock_guard lk(s_pool_mutex);
 
-    if (m_cmd_manager)
-      return m_cmd_manager.get();
+    if (auto mgr = m_cmd_managers[shard].load(std::memory_order_relaxed))
+      return mgr;
 
     // Use recycled manager if any
+    std::unique_ptr<command_manager> mgr;
     if (!s_command_manager_pool.empty()) {
-      m_cmd_manager = std::move(s_command_manager_pool.back());
+      mgr = std::move(s_command_manager_pool.back());
       s_command_manager_pool.pop_back();
-      m_cmd_manager->set_executor(this);
-      return m_cmd_manager.get();
+      mgr->set_executor(this);
+    }
+    else {
+      // Construct new manager
+      mgr = std::make_unique<command_manager>(this);
     }
 
-    // Construct new manager
-    m_cmd_manager = std::make_unique<command_manager>(this);
-    return m_cmd_manager.get();
+    const auto& cpus = get_completion_thread_cpus();
+    if (!cpus.empty())
+      mgr->pin(cpus[shard % cpus.size()]);
+    else if (m_numa_node >= 0)
+      mgr->pin_numa(m_numa_node);
+
+    m_cmd_managers[shard].store(mgr.get(), std::memory_order_release);
+    return mgr.release();
   }
 
 public:
-  hw_queue_impl()
+  explicit
+  hw_queue_impl(const xrt_core::device* device)
+    : m_cmd_managers(get_completion_threads())
+    , m_numa_node(get_numa_node(device))
   {
     static unsigned int count = 0;
     m_uid = count++;
@@ -348,10 +610,12 @@ public:
   ~hw_queue_impl()
   {
     XRT_DEBUGF("hw_queue_impl::~hw_queue_impl(%d)\n", m_uid);
-    if (m_cmd_manager) {
-      m_cmd_manager->clear_executor();
-      std::lock_guard lk(s_pool_mutex);
-      s_command_manager_pool.push_back(std::move(m_cmd_manager));
+    std::lock_guard lk(s_pool_mutex);
+    for (auto& shard : m_cmd_managers) {
+      if (auto mgr = shard.load(std::memory_order_relaxed)) {
+        mgr->clear_executor();
+        s_command_manager_pool.emplace_back(mgr);
+      }
     }
   }
 
@@ -392,6 +656,10 @@ public:
   virtual void
   submit_wait(const xrt::fence& fence) = 0;
 
+  // Enqueue a list of command dependencies
+  virtual void
+  submit_wait(const std::vector<xrt::fence>& fences) = 0;
+
   // Signal a command dependency
   virtual void
   submit_signal(const xrt::fence& fence) = 0;
@@ -401,7 +669,8 @@ public:
   void
   managed_start(xrt_core::command* cmd)
   {
-    get_cmd_manager()->launch(cmd);
+    XRT_TRACE_POINT_LOG(xrt_hw_queue_launch, cmd->get_uid());
+    get_cmd_manager(get_shard(cmd))->launch(cmd);
   }
 
   // Unmanaged start submits command directly for execution
@@ -409,6 +678,7 @@ public:
   void
   unmanaged_start(xrt_core::command* cmd)
   {
+    XRT_TRACE_POINT_LOG(xrt_hw_queue_launch, cmd->get_uid());
     submit(cmd);
   }
 
@@ -422,7 +692,8 @@ class qds_device : public hw_queue_impl
 
 public:
   qds_device(xrt::hw_context hwctx, hwqueue_handle* qhdl)
-    : m_hwctx(std::move(hwctx))
+    : hw_queue_impl(xrt_core::hw_context_int::get_core_device_raw(hwctx))
+    , m_hwctx(std::move(hwctx))
     , m_qhdl(qhdl)
   {}
 
@@ -502,6 +773,16 @@ public:
     m_qhdl->submit_wait(xrt_core::fence_int::get_fence_handle(fence));
   }
 
+  void
+  submit_wait(const std::vector<xrt::fence>& fences) override
+  {
+    std::vector<xrt_core::fence_handle*> handles;
+    handles.reserve(fences.size());
+    for (const auto& fence : fences)
+      handles.push_back(xrt_core::fence_int::get_fence_handle(fence));
+    m_qhdl->submit_wait(handles);
+  }
+
   void
   submit_signal(const xrt::fence& fence) override
   {
@@ -634,7 +915,8 @@ class kds_device : public hw_queue_impl
 
 public:
   explicit kds_device(xrt_core::device* device)
-    : m_device(device)
+    : hw_queue_impl(device)
+    , m_device(device)
   {}
 
   std::cv_status
@@ -716,16 +998,25 @@ public:
     return 1;
   }
 
+  // Legacy KDS and ERT firmware have no fence primitive, and a
+  // fence cannot be signaled from host, so dependencies cannot be
+  // enforced on a device without a hardware queue.
   void
   submit_wait(const xrt::fence&) override
   {
-    throw std::runtime_error("kds_device::submit_wait_on_fence not implemented");
+    throw xrt_core::error(std::errc::not_supported, "kds_device: fence wait not supported by device");
+  }
+
+  void
+  submit_wait(const std::vector<xrt::fence>&) override
+  {
+    throw xrt_core::error(std::errc::not_supported, "kds_device: fence wait not supported by device");
   }
 
   void
   submit_signal(const xrt::fence&) override
   {
-    throw std::runtime_error("kds_device::submit_wait_on_fence not implemented");
+    throw xrt_core::error(std::errc::not_supported, "kds_device: fence signal not supported by device");
   }
 };
 
@@ -921,6 +1212,13 @@ submit_wait(const xrt::fence& fence)
   get_handle()->submit_wait(fence);
 }
 
+void
+hw_queue::
+submit_wait(const std::vector<xrt::fence>& fences)
+{
+  get_handle()->submit_wait(fences);
+}
+
 void
 hw_queue::
 submit_signal(const xrt::fence& fence)
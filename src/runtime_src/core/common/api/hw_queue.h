@@ -91,6 +91,11 @@ public:
   void
   submit_wait(const xrt::fence& fence);
 
+  // Enqueue a list of command dependencies, the queue does not
+  // proceed until all fences are signaled
+  void
+  submit_wait(const std::vector<xrt::fence>& fences);
+
   // Enqueue a command to signal the fence 
   void
   submit_signal(const xrt::fence& fence);
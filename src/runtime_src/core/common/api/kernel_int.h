@@ -11,6 +11,7 @@
 #include "core/include/experimental/xrt_kernel.h"
 
 #include "core/common/config.h"
+#include "core/common/query_requests.h"
 #include "core/common/xclbin_parser.h"
 #include "core/common/shim/buffer_handle.h"
 #include "core/include/experimental/xrt_xclbin.h"
@@ -92,6 +93,27 @@ get_hw_ctx(const xrt::kernel& kernel);
 xrt::kernel
 create_kernel_from_implementation(const xrt::kernel_impl* kernel_impl);
 
+// Prefill the device wide command BO slab with @count BOs.  The
+// returned object shares ownership of the slab, keeping the
+// prefilled BOs cached for as long as it is alive.
+XRT_CORE_COMMON_EXPORT
+std::shared_ptr<void>
+prefill_exec_bufs(const std::shared_ptr<xrt_core::device>& device, unsigned int count);
+
+// Open the contexts of all compute units in @hwctx.  The returned
+// object owns the CU contexts, which are then found and shared by
+// kernels constructed in @hwctx for as long as it is alive.  The
+// object must be released before the hw context is destroyed.
+XRT_CORE_COMMON_EXPORT
+std::shared_ptr<void>
+open_cu_contexts(const xrt::hw_context& hwctx);
+
+// Adaptive run wait statistics for kernels opened on device.
+// Used by shims to implement query::run_wait_stats.
+XRT_CORE_COMMON_EXPORT
+xrt_core::query::run_wait_stats::result_type
+get_run_wait_stats(const xrt_core::device* device);
+
 }} // kernel_int, xrt_core
 
 #endif
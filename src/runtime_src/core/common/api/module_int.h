@@ -43,6 +43,12 @@ patch(const xrt::module&, const std::string& argnm, size_t index, const void* va
 void
 sync(const xrt::module&);
 
+// Restore control code of a hw context specific module to its state
+// before arguments were patched, such that the module can be reused
+// by another run.
+void
+reset(const xrt::module&);
+
 // Get the ERT command opcode in ELF flow
 ert_cmd_opcode
 get_ert_opcode(const xrt::module& module);
@@ -11,6 +11,9 @@
 
 namespace xdp::native {
 
+const bool tracing_enabled =
+  xrt_core::config::get_native_xrt_trace() || xrt_core::config::get_host_trace();
+
 void
 load()
 {
@@ -23,6 +26,7 @@ load()
 // Callbacks for generic start/stop function tracking
 std::function<void (const char*, uint64_t)> function_start_cb ;
 std::function<void (const char*, uint64_t, uint64_t)> function_end_cb ;
+std::function<void (const char*, uint64_t, uint64_t)> function_stat_cb ;
 
 // Callbacks for individual functions to track start/stop and statistics
 std::function<void (const char*, uint64_t, bool)> sync_start_cb ;
@@ -43,6 +47,9 @@ register_functions(void* handle)
   function_end_cb =
     reinterpret_cast<end_type>(xrt_core::dlsym(handle, "native_function_end")) ;
 
+  function_stat_cb =
+    reinterpret_cast<end_type>(xrt_core::dlsym(handle, "native_function_stat")) ;
+
   // Sync callbacks
   sync_start_cb =
     reinterpret_cast<sync_start_type>(xrt_core::dlsym(handle, "native_sync_start")) ;
@@ -72,23 +79,52 @@ api_call_logger(const char* function)
   if (s_load_native) {}
 }
 
+// With a sample interval, only every Nth call of a thread creates
+// trace events.  The other calls are timed here and reported to the
+// plugin in one callback that only updates the summary statistics.
+static bool
+sample_call()
+{
+  static const unsigned int interval =
+    xrt_core::config::get_native_xrt_trace_sample_interval() ;
+  if (interval <= 1 || !function_stat_cb)
+    return true ;
+
+  thread_local unsigned int count = 0 ;
+  if (++count < interval)
+    return false ;
+  count = 0 ;
+  return true ;
+}
+
 generic_api_call_logger::
 generic_api_call_logger(const char* function)
   : api_call_logger(function)
 {
-  if (function_start_cb) {
-    m_funcid = xrt_core::utils::issue_id() ;
-    function_start_cb(m_fullname, m_funcid) ;
+  if (!function_start_cb)
+    return ;
+
+  if (!sample_call()) {
+    m_start = static_cast<uint64_t>(xrt_core::time_ns()) ;
+    return ;
   }
+
+  m_funcid = xrt_core::utils::issue_id() ;
+  function_start_cb(m_fullname, m_funcid) ;
 }
 
 generic_api_call_logger::
 ~generic_api_call_logger()
 {
-  if (function_end_cb) {
-    auto timestamp = static_cast<uint64_t>(xrt_core::time_ns());
-    function_end_cb(m_fullname, m_funcid, timestamp) ;
+  auto timestamp = static_cast<uint64_t>(xrt_core::time_ns());
+
+  if (m_start) {
+    function_stat_cb(m_fullname, m_start, timestamp) ;
+    return ;
   }
+
+  if (function_end_cb)
+    function_end_cb(m_fullname, m_funcid, timestamp) ;
 }
 
 sync_logger::
@@ -21,6 +21,12 @@ register_functions(void* handle);
 void
 warning_function();
 
+// True if native_xrt_trace or host_trace is set.  Resolved once when
+// the library is loaded, so that the wrappers below test one flag and
+// otherwise call the wrapped function directly.  APIs called during
+// static initialization of the library are not traced.
+extern const bool tracing_enabled;
+
 // An instance of the api_call_logger class will be created in every
 // function we are monitoring.  The constructor marks the start time,
 // and the destructor marks the end time
@@ -36,6 +42,8 @@ class api_call_logger
 
 class generic_api_call_logger : public api_call_logger
 {
+  uint64_t m_start = 0 ; // Start time of a call not sampled for trace
+
   generic_api_call_logger() = delete ;
   generic_api_call_logger(const generic_api_call_logger&) = delete ;
   generic_api_call_logger(generic_api_call_logger&&) = delete ;
@@ -51,8 +59,7 @@ template <typename Callable, typename ...Args>
 auto
 profiling_wrapper(const char* function, Callable&& f, Args&&...args)
 {
-  if (xrt_core::config::get_native_xrt_trace()
-      || xrt_core::config::get_host_trace()) {
+  if (tracing_enabled) {
     generic_api_call_logger log_object(function) ;
     return f(std::forward<Args>(args)...) ;  // NOLINT, clang-tidy false positive [potential leak]
   }
@@ -81,8 +88,7 @@ template <typename Callable, typename ...Args>
 auto
 profiling_wrapper_sync(const char* function, xclBOSyncDirection dir, size_t size, Callable&& f, Args&&...args)
 {
-  if (xrt_core::config::get_native_xrt_trace() ||
-      xrt_core::config::get_host_trace()) {
+  if (tracing_enabled) {
     sync_logger log_object(function, (dir == XCL_BO_SYNC_BO_TO_DEVICE), size);
     return f(std::forward<Args>(args)...) ;
   }
@@ -68,6 +68,13 @@ XRT_CORE_COMMON_EXPORT
 std::string
 get_project_name(const xrt::xclbin& xclbin);
 
+// release_payload() - Release resident memory of payload sections
+// Bitstream, PDI, and AIE partition sections are needed only when
+// the xclbin is loaded.  Sections of an xclbin mapped from file are
+// read back on demand.  Returns number of bytes released.
+size_t
+release_payload(const xrt::xclbin& xclbin);
+
 }} // xclbin_int, xrt_core
 
 #endif
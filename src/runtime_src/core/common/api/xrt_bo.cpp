@@ -21,24 +21,49 @@
 #include "kernel_int.h"
 #include "xrt_mem.h"
 #include "core/common/api/bo_int.h"
+#include "core/common/config_reader.h"
 #include "core/common/device.h"
 #include "core/common/memalign.h"
 #include "core/common/message.h"
+#include "core/common/pipeline_trace.h"
 #include "core/common/query_requests.h"
 #include "core/common/system.h"
+#include "core/common/task.h"
+#include "core/common/thread.h"
+#include "core/common/time.h"
 #include "core/common/trace.h"
 #include "core/common/unistd.h"
 #include "core/common/xclbin_parser.h"
+#include "core/include/xclbin.h"
 
 #include "core/common/shim/buffer_handle.h"
 #include "core/common/shim/shared_handle.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cctype>
 #include <cstdlib>
+#include <deque>
+#include <exception>
+#include <filesystem>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 
+#ifdef __linux__
+# include <fcntl.h>
+# include <linux/mempolicy.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
 #ifdef _WIN32
 # pragma warning( disable : 4244 4100 4996 4505 )
 #endif
@@ -75,6 +100,24 @@ is_nodma(const xrt::device& device)
   return is_nodma(device.get_handle().get());
 }
 
+// Trace a BO sync as pipeline stage per direction
+template <typename Function>
+inline void
+trace_sync(xclBOSyncDirection dir, Function&& f)
+{
+  if (!xrt_core::pipeline_trace::enabled()) {
+    f();
+    return;
+  }
+
+  static auto to_device = xrt_core::pipeline_trace::get_stage("sync_bo_to_device");
+  static auto from_device = xrt_core::pipeline_trace::get_stage("sync_bo_from_device");
+  auto start = xrt_core::time_ns();
+  f();
+  xrt_core::pipeline_trace::record(dir == XCL_BO_SYNC_BO_TO_DEVICE ? to_device : from_device,
+                                   start, xrt_core::time_ns());
+}
+
 }
 
 ////////////////////////////////////////////////////////////////
@@ -110,6 +153,238 @@ send_exception_message(const std::string& msg)
   send_exception_message(msg.c_str());
 }
 
+// class async_dma - Worker threads for asynchronous BO sync
+//
+// Asynchronous BO syncs are queued to a small process wide pool of
+// worker threads that perform the DMA, so many transfers can be
+// outstanding without a host thread per transfer.  The pool is
+// started on first asynchronous sync and is sized by xrt.ini
+// Runtime.async_dma_threads.
+class async_dma
+{
+  xrt_core::task::queue m_queue;
+  std::vector<std::thread> m_workers;
+
+  async_dma()
+  {
+    auto threads = std::max(1u, xrt_core::config::get_async_dma_threads());
+    for (unsigned int i = 0; i < threads; ++i)
+      m_workers.emplace_back(xrt_core::thread(xrt_core::task::worker, std::ref(m_queue)));
+  }
+
+public:
+  ~async_dma()
+  {
+    m_queue.stop();
+    for (auto& worker : m_workers)
+      worker.join();
+  }
+
+  async_dma(const async_dma&) = delete;
+  async_dma& operator=(const async_dma&) = delete;
+
+  static async_dma&
+  instance()
+  {
+    static async_dma pool;
+    return pool;
+  }
+
+  template <typename Callable>
+  xrt_core::task::event<void>
+  enqueue(Callable&& fcn)
+  {
+    return xrt_core::task::createF(m_queue, std::forward<Callable>(fcn));
+  }
+
+  size_t
+  size() const
+  {
+    return m_workers.size();
+  }
+};
+
+// class copy_probe - Select fastest buffer copy method per device
+//
+// The first copies of at least probe_size bytes on a device measure
+// the bandwidth of each available copy method in turn, after which
+// the fastest method is used for large copies on that device.  Small
+// copies and disabled probing use M2M over KDMA over host.
+class copy_probe
+{
+public:
+  enum class method { m2m, kdma, host };
+  static constexpr size_t probe_size = 1 << 20;
+
+private:
+  static constexpr size_t num_methods = 3;
+
+  struct state
+  {
+    std::array<double, num_methods> bandwidth {}; // bytes per ns, 0 if not measured
+    std::array<bool, num_methods> failed {};      // method failed, do not use
+  };
+
+  std::mutex m_mutex;
+  std::map<unsigned int, state> m_state;          // device id -> state
+
+public:
+  static copy_probe&
+  instance()
+  {
+    static copy_probe probe;
+    return probe;
+  }
+
+  // select() - Method to use for copy of sz bytes on device
+  method
+  select(unsigned int devid, bool m2m, bool kdma, bool host, size_t sz)
+  {
+    std::array<bool, num_methods> available {m2m, kdma, host};
+
+    std::lock_guard lk(m_mutex);
+    auto& st = m_state[devid];
+    for (size_t idx = 0; idx < num_methods; ++idx)
+      available[idx] = available[idx] && !st.failed[idx];
+
+    // Default priority for small copies or when probing is disabled
+    if (sz < probe_size || !xrt_core::config::get_bo_copy_probe()) {
+      auto itr = std::find(available.begin(), available.end(), true);
+      return itr == available.end()
+        ? method::host
+        : static_cast<method>(std::distance(available.begin(), itr));
+    }
+
+    // Probe unmeasured methods, then use fastest
+    size_t best = num_methods - 1;
+    for (size_t idx = 0; idx < num_methods; ++idx) {
+      if (!available[idx])
+        continue;
+      if (st.bandwidth[idx] == 0)
+        return static_cast<method>(idx);
+      if (st.bandwidth[idx] > st.bandwidth[best] || !available[best])
+        best = idx;
+    }
+    return static_cast<method>(best);
+  }
+
+  // record() - Record bandwidth of completed large copy
+  void
+  record(unsigned int devid, method m, size_t sz, std::chrono::nanoseconds elapsed)
+  {
+    if (sz < probe_size || !elapsed.count())
+      return;
+
+    std::lock_guard lk(m_mutex);
+    auto& bw = m_state[devid].bandwidth[static_cast<size_t>(m)];
+    if (bw == 0)
+      bw = static_cast<double>(sz) / elapsed.count();
+  }
+
+  // fail() - Record that method cannot be used on device
+  void
+  fail(unsigned int devid, method m)
+  {
+    std::lock_guard lk(m_mutex);
+    m_state[devid].failed[static_cast<size_t>(m)] = true;
+  }
+};
+
+// class p2p_peers - Card to card P2P capability per device pair
+//
+// One device can DMA straight into the P2P BAR of another device if
+// both have P2P enabled and the two cards sit below a common PCIe
+// switch.  Peer traffic routed through the root complex is often not
+// supported, so such pairs use the export/import copy instead.  The
+// result is cached per ordered device pair, a failed direct copy
+// disables the pair.
+class p2p_peers
+{
+  std::mutex m_mutex;
+  std::map<std::pair<unsigned int, unsigned int>, bool> m_peers;
+
+  static bool
+  p2p_enabled(const xrt_core::device* device)
+  {
+    try {
+      auto config = xrt_core::device_query<xrt_core::query::p2p_config>(device);
+      return xrt_core::query::p2p_config::parse(config).first
+        == xrt_core::query::p2p_config::value_type::enabled;
+    }
+    catch (const std::exception&) {
+      return false;
+    }
+  }
+
+  // Sysfs path of device in PCIe hierarchy, e.g.
+  // /sys/devices/pci0000:00/0000:00:01.0/0000:01:00.0/0000:02:08.0/0000:03:00.0
+  static std::filesystem::path
+  pcie_path(const xrt_core::device* device)
+  {
+#ifdef __linux__
+    auto bdf = xrt_core::device_query<xrt_core::query::pcie_bdf>(device);
+    return std::filesystem::canonical("/sys/bus/pci/devices/" + xrt_core::query::pcie_bdf::to_string(bdf));
+#else
+    return {};
+#endif
+  }
+
+  // Deepest common ancestor must be a switch port, not the host bridge
+  static bool
+  same_switch(const xrt_core::device* a, const xrt_core::device* b)
+  {
+    try {
+      auto pa = pcie_path(a);
+      auto pb = pcie_path(b);
+      if (pa.empty() || pb.empty())
+        return false;
+
+      std::string common;
+      for (auto ia = pa.begin(), ib = pb.begin(); ia != pa.end() && ib != pb.end() && *ia == *ib; ++ia, ++ib)
+        common = ia->string();
+      return !common.empty() && std::isxdigit(static_cast<unsigned char>(common[0])) && common.find(':') != std::string::npos;
+    }
+    catch (const std::exception&) {
+      return false;
+    }
+  }
+
+public:
+  static p2p_peers&
+  instance()
+  {
+    static p2p_peers peers;
+    return peers;
+  }
+
+  // peers() - True if src device can DMA into P2P BAR of dst device and vice versa
+  bool
+  peers(const xrt_core::device* src, const xrt_core::device* dst)
+  {
+    std::lock_guard lk(m_mutex);
+    auto key = std::make_pair(src->get_device_id(), dst->get_device_id());
+    auto itr = m_peers.find(key);
+    if (itr != m_peers.end())
+      return itr->second;
+
+    auto nodma = [](const xrt_core::device* device) {
+      return xrt_core::device_query_default<xrt_core::query::nodma>(device, 0) != 0;
+    };
+
+    auto capable = !nodma(src) && !nodma(dst)
+      && p2p_enabled(src) && p2p_enabled(dst) && same_switch(src, dst);
+    return m_peers.emplace(key, capable).first->second;
+  }
+
+  // fail() - Record that direct copy between devices failed
+  void
+  fail(const xrt_core::device* src, const xrt_core::device* dst)
+  {
+    std::lock_guard lk(m_mutex);
+    m_peers[std::make_pair(src->get_device_id(), dst->get_device_id())] = false;
+  }
+};
+
 } // namespace
 
 namespace {
@@ -322,7 +597,7 @@ public:
     return device.get_hwctx_handle();
   }
 
-  export_handle
+  virtual export_handle
   export_buffer() const
   {
     if (!shared_handle)
@@ -361,32 +636,49 @@ public:
       throw xrt_core::system_error(EINVAL, "copying past source buffer size");
 
     if (get_device() != src->get_device()) {
-      copy_with_export(src, sz, src_offset, dst_offset);
+      if (!copy_p2p(src, sz, src_offset, dst_offset))
+        copy_with_export(src, sz, src_offset, dst_offset);
       return;
     }
 
-    // try copying with m2m
+    bool m2m = false;
     try {
-      auto m2m = xrt_core::device_query<xrt_core::query::m2m>(get_device());
-      if (xrt_core::query::m2m::to_bool(m2m)) {
-        handle->copy(src->handle.get(), sz, dst_offset, src_offset);
-        return;
-      }
+      m2m = xrt_core::query::m2m::to_bool(xrt_core::device_query<xrt_core::query::m2m>(get_device()));
     }
     catch (const std::exception&) {
     }
 
+    // host copy is fallback, but is a probe candidate only if both
+    // buffers have host memory
+    auto kdma = xrt_core::config::get_cdma();
+    auto host = (!m2m && !kdma) || (sz >= copy_probe::probe_size && has_hbuf() && src->has_hbuf());
+
+    auto& probe = copy_probe::instance();
+    auto devid = get_device()->get_device_id();
+    auto method = probe.select(devid, m2m, kdma, host, sz);
+    auto start = std::chrono::steady_clock::now();
+
+    // try copying with m2m
+    if (method == copy_probe::method::m2m) {
+      handle->copy(src->handle.get(), sz, dst_offset + get_offset(), src_offset + src->get_offset());
+      probe.record(devid, method, sz, std::chrono::steady_clock::now() - start);
+      return;
+    }
+
     // try copying with kdma
-    try {
-      if (xrt_core::config::get_cdma()) {
+    if (method == copy_probe::method::kdma) {
+      try {
         xrt_core::kernel_int::copy_bo_with_kdma
-          (get_device(), sz, handle.get(), dst_offset, src->handle.get(), src_offset);
+          (get_device(), sz, handle.get(), dst_offset + get_offset(), src->handle.get(), src_offset + src->get_offset());
+        probe.record(devid, method, sz, std::chrono::steady_clock::now() - start);
         return;
       }
-    }
-    catch (const std::exception& ex) {
-      auto fmt = boost::format("Reverting to host copy of buffers (%s)") % ex.what();
-      xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",  fmt.str());
+      catch (const std::exception& ex) {
+        probe.fail(devid, method);
+        auto fmt = boost::format("Reverting to host copy of buffers (%s)") % ex.what();
+        xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",  fmt.str());
+      }
+      start = std::chrono::steady_clock::now();
     }
 
     // special case sw emulation on imported buffers
@@ -397,6 +689,45 @@ public:
 
     // revert to copying through host
     copy_through_host(src, sz, src_offset, dst_offset);
+    probe.record(devid, copy_probe::method::host, sz, std::chrono::steady_clock::now() - start);
+  }
+
+  // copy_p2p() - Direct card to card copy through a P2P BAR
+  //
+  // If this buffer is a P2P buffer the source device DMAs its buffer
+  // straight into the BAR mapping of this buffer, otherwise if the
+  // source is a P2P buffer this device DMAs from the source BAR
+  // mapping.  Returns false if neither applies or the devices are not
+  // P2P peers, in which case the caller must copy some other way.
+  bool
+  copy_p2p(const bo_impl* src, size_t sz, size_t src_offset, size_t dst_offset)
+  {
+    auto dst_p2p = get_flags() == bo::flags::p2p && src->get_flags() != bo::flags::host_only;
+    auto src_p2p = src->get_flags() == bo::flags::p2p && get_flags() != bo::flags::host_only;
+    if (!dst_p2p && !src_p2p)
+      return false;
+
+    auto& peers = p2p_peers::instance();
+    if (!peers.peers(src->get_core_device(), get_core_device()))
+      return false;
+
+    try {
+      if (dst_p2p) {
+        auto dst_hbuf = static_cast<char*>(get_hbuf()) + dst_offset;
+        src->get_device()->unmgd_pread(dst_hbuf, sz, src->get_address() + src_offset);
+      }
+      else {
+        auto src_hbuf = static_cast<const char*>(src->get_hbuf()) + src_offset;
+        device->unmgd_pwrite(src_hbuf, sz, get_address() + dst_offset);
+      }
+      return true;
+    }
+    catch (const std::exception& ex) {
+      peers.fail(src->get_core_device(), get_core_device());
+      auto fmt = boost::format("Reverting to copy through export of buffer (%s)") % ex.what();
+      xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", fmt.str());
+      return false;
+    }
   }
 
   void
@@ -408,6 +739,17 @@ public:
     copy(src_import_bo.get_handle().get(), sz, src_offset, dst_offset);
   }
 
+  bool
+  has_hbuf() const
+  {
+    try {
+      return get_hbuf() != nullptr;
+    }
+    catch (const std::exception&) {
+      return false;
+    }
+  }
+
   void
   copy_through_host(const bo_impl* src, size_t sz, size_t src_offset, size_t dst_offset)
   {
@@ -421,13 +763,140 @@ public:
 
     // sync to src to ensure data integrity, logically const
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast) // special case
-    const_cast<bo_impl*>(src)->sync(XCL_BO_SYNC_BO_FROM_DEVICE, sz, src_offset);
+    auto src_bo = const_cast<bo_impl*>(src);
+
+    auto chunk = static_cast<size_t>(xrt_core::config::get_host_copy_chunk_size());
+    if (!chunk || sz <= chunk) {
+      src_bo->sync(XCL_BO_SYNC_BO_FROM_DEVICE, sz, src_offset);
+
+      // copy host side buffer
+      std::memcpy(dst_hbuf + dst_offset, src_hbuf + src_offset, sz);
+
+      // sync modified host buffer to device
+      sync(XCL_BO_SYNC_BO_TO_DEVICE, sz, dst_offset);
+      return;
+    }
+
+    // Pipeline in chunks: read DMA of chunk n+1 and write DMA of
+    // chunk n-1 are in flight on the DMA workers while chunk n is
+    // copied on host.  In flight DMAs are bounded by worker count.
+    auto& pool = async_dma::instance();
+    auto depth = std::max<size_t>(2, pool.size());
+    auto chunks = (sz + chunk - 1) / chunk;
+    auto chunk_size = [sz, chunk] (size_t n) { return std::min(chunk, sz - n * chunk); };
+
+    std::deque<xrt_core::task::event<void>> reads;
+    std::deque<xrt_core::task::event<void>> writes;
+    size_t next_read = 0;
+    auto enqueue_reads = [&] {
+      for (; next_read < chunks && reads.size() < depth / 2 + 1; ++next_read) {
+        auto off = src_offset + next_read * chunk;
+        reads.emplace_back(pool.enqueue([src_bo, off, csz = chunk_size(next_read)] {
+          src_bo->sync(XCL_BO_SYNC_BO_FROM_DEVICE, csz, off);
+        }));
+      }
+    };
+
+    try {
+      for (size_t n = 0; n < chunks; ++n) {
+        enqueue_reads();
+        reads.front().get();
+        reads.pop_front();
+        enqueue_reads();
+
+        auto csz = chunk_size(n);
+        std::memcpy(dst_hbuf + dst_offset + n * chunk, src_hbuf + src_offset + n * chunk, csz);
+
+        if (writes.size() >= depth / 2) {
+          writes.front().get();
+          writes.pop_front();
+        }
+        writes.emplace_back(pool.enqueue([this, off = dst_offset + n * chunk, csz] {
+          sync(XCL_BO_SYNC_BO_TO_DEVICE, csz, off);
+        }));
+      }
+
+      for (auto& write : writes)
+        write.get();
+    }
+    catch (...) {
+      // drain outstanding DMAs before buffers can go away
+      for (auto& ev : reads)
+        try { ev.get(); } catch (...) {}
+      for (auto& ev : writes)
+        try { ev.get(); } catch (...) {}
+      throw;
+    }
+  }
+
+  // fill() - Fill range of buffer with repeated pattern
+  //
+  // Only a seed region of the range is written through host.  When
+  // the device can copy buffers (M2M or KDMA), the seed is replicated
+  // by device side copies that double the filled region each step,
+  // otherwise the full range is written through host.
+  virtual void
+  fill(const void* pattern, size_t pattern_size, size_t sz, size_t offset)
+  {
+    static constexpr size_t seed_size = 1 << 20;
 
-    // copy host side buffer
-    std::memcpy(dst_hbuf + dst_offset, src_hbuf + src_offset, sz);
+    if (!pattern || !pattern_size)
+      throw xrt_core::system_error(EINVAL, "invalid fill pattern");
+    if (sz + offset > size)
+      throw xrt_core::system_error(EINVAL, "filling past buffer size");
+    if (!sz)
+      return;
 
-    // sync modified host buffer to device
-    sync(XCL_BO_SYNC_BO_TO_DEVICE, sz, dst_offset);
+    bool m2m = false;
+    try {
+      m2m = xrt_core::query::m2m::to_bool(xrt_core::device_query<xrt_core::query::m2m>(get_device()));
+    }
+    catch (const std::exception&) {
+    }
+    auto kdma = xrt_core::config::get_cdma();
+    auto& probe = copy_probe::instance();
+    auto devid = get_device()->get_device_id();
+    auto method = probe.select(devid, m2m, kdma, false, sz);
+
+    // Seed is a whole number of patterns unless the range is smaller
+    auto staging_size = std::min(sz, std::max(pattern_size, seed_size / pattern_size * pattern_size));
+    auto seed = (method == copy_probe::method::host) ? sz : staging_size;
+
+    // Replicate pattern into host staging, write the seed in chunks
+    std::vector<char> staging(staging_size);
+    for (size_t idx = 0; idx < staging.size(); idx += pattern_size)
+      std::memcpy(staging.data() + idx, pattern, std::min(pattern_size, staging.size() - idx));
+
+    for (size_t done = 0; done < seed; done += staging.size()) {
+      auto csz = std::min(staging.size(), seed - done);
+      write(staging.data(), csz, offset + done);
+    }
+    if (has_hbuf())
+      sync(XCL_BO_SYNC_BO_TO_DEVICE, seed, offset);
+
+    // Double the filled region with device side copies.  A copy
+    // always starts at a pattern boundary of the filled region
+    for (size_t done = seed; done < sz;) {
+      auto csz = std::min(done, sz - done);
+      try {
+        if (method == copy_probe::method::m2m)
+          handle->copy(handle.get(), csz, offset + done + get_offset(), offset + get_offset());
+        else
+          xrt_core::kernel_int::copy_bo_with_kdma
+            (get_device(), csz, handle.get(), offset + done + get_offset(), handle.get(), offset + get_offset());
+      }
+      catch (const std::exception& ex) {
+        probe.fail(devid, method);
+        auto fmt = boost::format("Reverting to host fill of buffer (%s)") % ex.what();
+        xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",  fmt.str());
+        for (; done < sz; done += staging.size())
+          write(staging.data(), std::min(staging.size(), sz - done), offset + done);
+        if (has_hbuf())
+          sync(XCL_BO_SYNC_BO_TO_DEVICE, sz - seed, offset + seed);
+        return;
+      }
+      done += csz;
+    }
   }
 
 #ifdef XRT_ENABLE_AIE
@@ -459,7 +928,26 @@ public:
     // operation just in case the HW changes in the future.
     // if (get_flags() != bo::flags::host_only)
     handle->sync(static_cast<xrt_core::buffer_handle::direction>(dir), sz, offset);
-    m_usage_logger->log_buffer_sync(device->get_device_id(), device.get_hwctx_handle(), sz, dir);
+    log_sync(dir, sz);
+  }
+
+  // add_sync_range() - Add range of this buffer to a batched sync
+  //
+  // Return false if the buffer cannot be synced as part of a batch,
+  // in which case it must be synced individually.  A buffer that is
+  // added must be logged with log_sync() after the batch is synced.
+  virtual bool
+  add_sync_range(std::vector<xrt_core::buffer_handle::sync_range>& ranges, size_t sz, size_t offset)
+  {
+    ranges.push_back({handle.get(), sz, offset});
+    return true;
+  }
+
+  void
+  log_sync(xclBOSyncDirection dir, size_t sz)
+  {
+    if (xrt_core::usage_metrics::enabled())
+      m_usage_logger->log_buffer_sync(device->get_device_id(), device.get_hwctx_handle(), sz, dir);
   }
 
   virtual uint64_t
@@ -527,6 +1015,107 @@ public:
   {
     throw std::runtime_error("Unsupported feature");
   }
+
+  // ready() - Check if async has completed
+  virtual bool
+  ready() const
+  {
+    throw std::runtime_error("Unsupported feature");
+  }
+
+  // set_callback() - Call function once when async completes
+  virtual void
+  set_callback(std::function<void(std::exception_ptr)>)
+  {
+    throw std::runtime_error("Unsupported feature");
+  }
+};
+
+// class dma_async_handle_impl - BO sync performed by async_dma worker
+//
+// Any error from the sync is rethrown by wait() and passed to the
+// completion callback if any.  The callback is shared with the worker
+// such that it can be called without a reference to the handle.
+class dma_async_handle_impl : public xrt::bo::async_handle_impl
+{
+  struct completion
+  {
+    std::mutex mutex;
+    std::function<void(std::exception_ptr)> callback;
+    std::exception_ptr error;
+    bool done = false;
+
+    void
+    complete(std::exception_ptr eptr)
+    {
+      std::function<void(std::exception_ptr)> fcn;
+      {
+        std::lock_guard lk(mutex);
+        done = true;
+        error = eptr;
+        fcn = std::move(callback);
+      }
+
+      if (fcn)
+        fcn(eptr);
+    }
+  };
+
+  std::shared_ptr<completion> m_completion;
+  xrt_core::task::event<void> m_event;
+  bool m_done = false;
+
+public:
+  dma_async_handle_impl(xrt::bo bo, xclBOSyncDirection dir, size_t sz, size_t offset)
+    : xrt::bo::async_handle_impl(std::move(bo))
+    , m_completion(std::make_shared<completion>())
+    , m_event(async_dma::instance().enqueue([boh = m_bo.get_handle(), dir, sz, offset, cmpl = m_completion] {
+        std::exception_ptr eptr;
+        try {
+          boh->sync(dir, sz, offset);
+        }
+        catch (...) {
+          eptr = std::current_exception();
+        }
+
+        cmpl->complete(eptr);
+        if (eptr)
+          std::rethrow_exception(eptr);
+      }))
+  {}
+
+  void
+  wait() override
+  {
+    if (m_done)
+      return;
+
+    m_event.get(); // rethrows sync error
+    m_done = true;
+  }
+
+  bool
+  ready() const override
+  {
+    return m_done || m_event.ready();
+  }
+
+  void
+  set_callback(std::function<void(std::exception_ptr)> fcn) override
+  {
+    std::exception_ptr eptr;
+    {
+      std::lock_guard lk(m_completion->mutex);
+      if (!m_completion->done) {
+        m_completion->callback = std::move(fcn);
+        return;
+      }
+      eptr = m_completion->error;
+    }
+
+    // lock must not be held while calling the callback
+    fcn(eptr);
+  }
 };
 
 #ifdef XRT_ENABLE_AIE
@@ -552,6 +1141,19 @@ class aie::bo::async_handle_impl : public xrt::bo::async_handle_impl
       async_bo_hdls[gmio_name].clear();
     }
 
+    // Clear handles for a given gmio_name whose BD has finished.  BDs
+    // of a gmio complete in order, so all handles with a BD token up to
+    // and including bd_token are done.
+    void
+    clear(const std::string& gmio_name, uint64_t bd_token)
+    {
+      std::lock_guard lk(async_bo_hdls_mutex);
+      auto& hdls = async_bo_hdls[gmio_name];
+      hdls.erase(std::remove_if(hdls.begin(), hdls.end(),
+                                [bd_token](auto hdl) { return hdl->m_bd_num <= bd_token; }),
+                 hdls.end());
+    }
+
     // Check if async_hdl is present for a particular gmio_name
     // If present then DMA has not finished yet
     bool
@@ -576,13 +1178,13 @@ class aie::bo::async_handle_impl : public xrt::bo::async_handle_impl
   };
 
 public:
-  size_t m_bd_num; // For future use
+  uint64_t m_bd_num; // BD token, 0 if shim does not track BDs
   std::string m_gmio_name;
   static handle_map async_info;
 
 public:
   // async_bo_impl() - Construct async_bo_obj
-  async_handle_impl(xrt::bo bo, size_t bd_num, std::string gmio_name)
+  async_handle_impl(xrt::bo bo, uint64_t bd_num, std::string gmio_name)
     : xrt::bo::async_handle_impl(std::move(bo))
     , m_bd_num(bd_num)
     , m_gmio_name(std::move(gmio_name))
@@ -599,11 +1201,18 @@ public:
       return;
 
     auto device = m_bo.get_handle()->get_device();
-    // DMA has not finished; Wait for it;
-    // In future wait only for specific m_bd_num
-    device->wait_gmio(m_gmio_name.c_str());
-    // All outstanding DMAs for this gmio_name have finishedd; for all bd numbers
-    async_info.clear(m_gmio_name);
+    if (!m_bd_num) {
+      // Shim does not track BDs, wait for all outstanding DMAs for
+      // this gmio_name
+      device->wait_gmio(m_gmio_name.c_str());
+      async_info.clear(m_gmio_name);
+      return;
+    }
+
+    // DMA has not finished; Wait for this BD only, later BDs remain
+    // queued so the GMIO DMA queue can be kept full
+    device->wait_gmio(m_gmio_name.c_str(), m_bd_num);
+    async_info.clear(m_gmio_name, m_bd_num);
   }
 }; // class aie::bo::async_handle_impl
 
@@ -615,7 +1224,8 @@ bo_impl::
 async(xrt::bo& bo, const std::string& port, xclBOSyncDirection dir, size_t sz, size_t offset)
 {
   device->sync_aie_bo_nb(bo, port.c_str(), dir, sz, offset);
-  auto a_bo_impl = std::make_shared<xrt::aie::bo::async_handle_impl>(bo, 0, port);
+  auto bd_token = device->get_gmio_bd_token(port.c_str());
+  auto a_bo_impl = std::make_shared<xrt::aie::bo::async_handle_impl>(bo, bd_token, port);
 
   return xrt::bo::async_handle{a_bo_impl};
 }
@@ -625,13 +1235,8 @@ xrt::bo::async_handle
 bo_impl::
 async(xrt::bo& bo, xclBOSyncDirection dir, size_t sz, size_t offset)
 {
-  throw std::runtime_error("Unsupported feature");
-
-#if 0
-  //TODO for Alveo; base xrt::bo class
-  auto a_bo_impl = std::make_shared<xrt::bo::async_handle_impl>(bo);
+  auto a_bo_impl = std::make_shared<dma_async_handle_impl>(bo, dir, sz, offset);
   return xrt::bo::async_handle{a_bo_impl};
-#endif
 }
 
 // class buffer_ubuf - User provide host side buffer
@@ -676,6 +1281,42 @@ public:
   }
 };
 
+// class buffer_hugepage - XRT allocated huge page host side buffer
+//
+// Host side buffer is mapped from huge pages so that the driver pins
+// few contiguous physical ranges and builds a short SG list for the
+// buffer.
+class buffer_hugepage : public bo_impl
+{
+  void* hbuf;
+  size_t map_size;
+
+public:
+  buffer_hugepage(const device_type& dev, std::unique_ptr<xrt_core::buffer_handle> bhdl, size_t sz, void* b, size_t msz)
+    : bo_impl(dev, std::move(bhdl), sz)
+    , hbuf(b)
+    , map_size(msz)
+  {}
+
+  ~buffer_hugepage() override
+  {
+#ifdef __linux__
+    ::munmap(hbuf, map_size);
+#endif
+  }
+
+  buffer_hugepage(const buffer_hugepage&) = delete;
+  buffer_hugepage(buffer_hugepage&&) = delete;
+  buffer_hugepage& operator=(buffer_hugepage&) = delete;
+  buffer_hugepage& operator=(buffer_hugepage&&) = delete;
+
+  void*
+  get_hbuf() const override
+  {
+    return hbuf;
+  }
+};
+
 // class buffer_kbuf - Kernel driver host side buffer
 //
 // Kernel driver allocated host side buffer.  The host side buffer
@@ -825,16 +1466,148 @@ public:
   }
 };
 
-class buffer_nodma : public bo_impl
+// class bo_slab - Device memory slab for small device only buffers
+//
+// A slab is one driver BO from which device only buffers are carved
+// when Runtime.bo_slab_size is set.  Carved buffers share the handle
+// of the slab and keep it alive, the slab is freed along with its
+// last carved buffer.
+class bo_slab
 {
-  buffer_kbuf m_host_only;
-  buffer_dbuf m_device_only;
+  device_type m_device;  // keep device and context of slab alive
+  std::shared_ptr<xrt_core::buffer_handle> m_handle;
+  std::mutex m_mutex;
+  std::map<size_t, size_t> m_free; // offset -> size of free ranges
 
-  void
-  valid_or_error(size_t sz, size_t offset)
+public:
+  static constexpr size_t no_offset = std::numeric_limits<size_t>::max();
+  static constexpr size_t alignment = 4096;
+
+  bo_slab(device_type dev, std::unique_ptr<xrt_core::buffer_handle> hdl, size_t sz)
+    : m_device(std::move(dev))
+    , m_handle(std::move(hdl))
   {
-    if (!sz)
-      throw xrt_core::system_error(EINVAL, "size must be a positive number");
+    m_free.emplace(0, sz);
+  }
+
+  const std::shared_ptr<xrt_core::buffer_handle>&
+  get_handle() const
+  {
+    return m_handle;
+  }
+
+  // carve() - First fit sz bytes, sz must be multiple of alignment
+  size_t
+  carve(size_t sz)
+  {
+    std::lock_guard lk(m_mutex);
+    auto itr = std::find_if(m_free.begin(), m_free.end(), [sz](const auto& range) { return range.second >= sz; });
+    if (itr == m_free.end())
+      return no_offset;
+
+    auto [offset, avail] = *itr;
+    m_free.erase(itr);
+    if (avail > sz)
+      m_free.emplace(offset + sz, avail - sz);
+    return offset;
+  }
+
+  // release() - Return a carved range, merge with adjacent free ranges
+  void
+  release(size_t offset, size_t sz)
+  {
+    std::lock_guard lk(m_mutex);
+    auto itr = m_free.emplace(offset, sz).first;
+    if (auto next = std::next(itr); next != m_free.end() && offset + sz == next->first) {
+      itr->second += next->second;
+      m_free.erase(next);
+    }
+    if (itr != m_free.begin()) {
+      if (auto prev = std::prev(itr); prev->first + prev->second == itr->first) {
+        prev->second += itr->second;
+        m_free.erase(itr);
+      }
+    }
+  }
+};
+
+// class buffer_slab - Device only buffer carved from a slab
+//
+// The buffer is a range of the slab BO, the driver does not know
+// about it.
+class buffer_slab : public buffer_dbuf
+{
+  std::shared_ptr<bo_slab> m_slab;  // participate in ownership of slab
+  size_t m_offset;
+  size_t m_carved;                  // size carved from slab, aligned
+
+public:
+  buffer_slab(const device_type& dev, std::shared_ptr<bo_slab> slab, size_t offset, size_t carved, size_t sz)
+    : buffer_dbuf(dev, slab->get_handle(), sz)
+    , m_slab(std::move(slab))
+    , m_offset(offset)
+    , m_carved(carved)
+  {}
+
+  ~buffer_slab() override
+  {
+    m_slab->release(m_offset, m_carved);
+  }
+
+  buffer_slab(const buffer_slab&) = delete;
+  buffer_slab(buffer_slab&&) = delete;
+  buffer_slab& operator=(buffer_slab&) = delete;
+  buffer_slab& operator=(buffer_slab&&) = delete;
+
+  size_t
+  get_offset() const override
+  {
+    return m_offset;
+  }
+
+  uint64_t
+  get_address() const override
+  {
+    return bo_impl::get_address() + m_offset;
+  }
+
+  export_handle
+  export_buffer() const override
+  {
+    throw xrt_core::error(std::errc::not_supported, "buffer carved from a slab cannot be exported");
+  }
+
+  void
+  sync(xclBOSyncDirection dir, size_t sz, size_t offset) override
+  {
+    if (sz + offset > size)
+      throw xrt_core::error(-EINVAL, "Invalid offset and size when syncing slab buffer");
+
+    handle->sync(static_cast<xrt_core::buffer_handle::direction>(dir), sz, offset + m_offset);
+    log_sync(dir, sz);
+  }
+
+  bool
+  add_sync_range(std::vector<xrt_core::buffer_handle::sync_range>& ranges, size_t sz, size_t offset) override
+  {
+    if (sz + offset > size)
+      throw xrt_core::error(-EINVAL, "Invalid offset and size when syncing slab buffer");
+
+    ranges.push_back({handle.get(), sz, offset + m_offset});
+    return true;
+  }
+};
+
+class buffer_nodma : public bo_impl
+{
+  buffer_kbuf m_host_only;
+  buffer_dbuf m_device_only;
+
+  void
+  valid_or_error(size_t sz, size_t offset)
+  {
+    if (!sz)
+      throw xrt_core::system_error(EINVAL, "size must be a positive number");
     if (sz + offset > size)
       throw xrt_core::system_error(EINVAL, "offset exceeds buffer size");
   }
@@ -936,6 +1709,16 @@ public:
     // sync through parent buffer, which handles nodma case also
     m_parent->sync(dir, sz, off);
   }
+
+  bool
+  add_sync_range(std::vector<xrt_core::buffer_handle::sync_range>& ranges, size_t sz, size_t offset) override
+  {
+    size_t off = offset + m_offset;
+    if (off + sz > m_parent->get_size())
+      throw xrt_core::error(-EINVAL, "Invalid offset and size when syncing sub buffer");
+
+    return m_parent->add_sync_range(ranges, sz, off);
+  }
 };
 
 // class buffer_xbuf - Wrapper for extern managed xclBufferHandle
@@ -1058,6 +1841,230 @@ alloc_bo(const device_type& device, size_t sz, xrtBufferFlags flags, xrtMemoryGr
   }
 }
 
+// coalesce_sync_ranges() - Merge overlapping and adjacent ranges
+//
+// Sub-buffers add ranges of their parent buffer, ranges of sub-buffers
+// that are next to each other are merged so the parent is synced
+// with one transfer per contiguous region.
+static void
+coalesce_sync_ranges(std::vector<xrt_core::buffer_handle::sync_range>& ranges)
+{
+  if (ranges.size() < 2)
+    return;
+
+  std::sort(ranges.begin(), ranges.end(), [](const auto& lhs, const auto& rhs) {
+    return std::tie(lhs.handle, lhs.offset) < std::tie(rhs.handle, rhs.offset);
+  });
+
+  auto last = ranges.begin();
+  for (auto itr = std::next(last); itr != ranges.end(); ++itr) {
+    if (itr->handle == last->handle && itr->offset <= last->offset + last->size) {
+      last->size = std::max(last->offset + last->size, itr->offset + itr->size) - last->offset;
+      continue;
+    }
+    *(++last) = *itr;
+  }
+  ranges.erase(std::next(last), ranges.end());
+}
+
+// sync_bos() - Sync many buffers in one direction
+//
+// Buffers are batched per device and synced with a single shim
+// request if the shim supports it, otherwise one by one.
+static void
+sync_bos(const std::vector<xrt::bo>& bos, xclBOSyncDirection dir)
+{
+  struct batch
+  {
+    std::vector<xrt_core::buffer_handle::sync_range> ranges;
+    std::vector<xrt::bo_impl*> bos;
+  };
+  std::map<xrt_core::device*, batch> batches;
+
+  for (const auto& bo : bos) {
+    auto boh = bo.get_handle().get();
+    auto& batch = batches[boh->get_device().get()];
+    if (!boh->add_sync_range(batch.ranges, bo.size(), 0)) {
+      boh->sync(dir, bo.size(), 0);
+      continue;
+    }
+    batch.bos.push_back(boh);
+  }
+
+  auto xdir = static_cast<xrt_core::buffer_handle::direction>(dir);
+  for (auto& [device, batch] : batches) {
+    if (batch.ranges.empty())
+      continue;
+
+    coalesce_sync_ranges(batch.ranges);
+
+    try {
+      device->sync_bos(xdir, batch.ranges);
+    }
+    catch (const xrt_core::ishim::not_supported_error&) {
+      for (auto& range : batch.ranges)
+        range.handle->sync(xdir, range.size, range.offset);
+    }
+
+    for (auto boh : batch.bos)
+      boh->log_sync(dir, boh->get_size());
+  }
+}
+
+// sync_rect() - Sync rows of a 3D region of a buffer
+//
+// Contiguous rows are merged into one range.  Bytes between rows are
+// never transferred, since either side may hold the current content.
+// The ranges are synced with a single shim request if the shim
+// supports it.
+static void
+sync_rect(xrt::bo_impl* boh, xclBOSyncDirection dir, const std::array<size_t, 3>& origin,
+          const std::array<size_t, 3>& region, size_t row_pitch, size_t slice_pitch)
+{
+  if (!region[0] || !region[1] || !region[2])
+    throw xrt_core::system_error(EINVAL, "empty sync region");
+  if (!row_pitch)
+    row_pitch = region[0];
+  if (!slice_pitch)
+    slice_pitch = row_pitch * region[1];
+  if (row_pitch < region[0] || slice_pitch < row_pitch * region[1])
+    throw xrt_core::system_error(EINVAL, "invalid row or slice pitch");
+
+  auto start = origin[2] * slice_pitch + origin[1] * row_pitch + origin[0];
+  auto end = start + (region[2] - 1) * slice_pitch + (region[1] - 1) * row_pitch + region[0];
+  if (end > boh->get_size())
+    throw xrt_core::system_error(EINVAL, "syncing past buffer size");
+
+  std::vector<std::pair<size_t, size_t>> rows; // offset, size
+  for (size_t z = 0; z < region[2]; ++z) {
+    for (size_t y = 0; y < region[1]; ++y) {
+      auto offset = start + z * slice_pitch + y * row_pitch;
+      if (!rows.empty() && offset == rows.back().first + rows.back().second)
+        rows.back().second += region[0];
+      else
+        rows.emplace_back(offset, region[0]);
+    }
+  }
+
+  std::vector<xrt_core::buffer_handle::sync_range> ranges;
+  bool batch = true;
+  for (auto [offset, size] : rows)
+    batch = batch && boh->add_sync_range(ranges, size, offset);
+
+  auto xdir = static_cast<xrt_core::buffer_handle::direction>(dir);
+  try {
+    if (!batch || ranges.size() == 1)
+      throw xrt_core::ishim::not_supported_error(__func__);
+    boh->get_device()->sync_bos(xdir, ranges);
+  }
+  catch (const xrt_core::ishim::not_supported_error&) {
+    for (auto [offset, size] : rows)
+      boh->sync(dir, size, offset);
+  }
+
+  boh->log_sync(dir, end - start);
+}
+
+#ifdef __linux__
+// Chunk size and number of chunks in flight for transfers between
+// files and buffers
+constexpr size_t file_chunk_size = 8 * 1024 * 1024;
+constexpr size_t file_queue_depth = 4;
+constexpr size_t file_direct_alignment = 4096;
+
+// Read or write sz bytes at buf from or to file offset foff, retrying
+// short transfers
+static void
+file_io(int fd, char* buf, size_t sz, uint64_t foff, bool load)
+{
+  while (sz) {
+    auto ret = load
+      ? ::pread(fd, buf, sz, static_cast<off_t>(foff))
+      : ::pwrite(fd, buf, sz, static_cast<off_t>(foff));
+    if (ret < 0 && errno == EINTR)
+      continue;
+    if (ret < 0)
+      throw xrt_core::system_error(errno, load ? "failed to read file" : "failed to write file");
+    if (ret == 0)
+      throw xrt_core::error(EIO, "unexpected end of file");
+    buf += ret;
+    sz -= ret;
+    foff += ret;
+  }
+}
+
+// transfer_file() - Transfer between file and start of buffer
+//
+// The buffer is transferred in chunks by a few threads, each reading
+// a chunk into the host side of the buffer and syncing it to device
+// (load), or syncing a chunk from device and writing it (store), so
+// that file I/O of one chunk overlaps DMA of another.
+//
+// For P2P buffers the host side is a mapping of device memory, no
+// sync is needed and with O_DIRECT the storage device transfers
+// straight to or from device memory.  Block aligned chunks use a
+// descriptor opened with O_DIRECT if possible.
+static void
+transfer_file(xrt::bo_impl* boh, int fd, uint64_t foff, size_t sz, bool load)
+{
+  if (sz > boh->get_size())
+    throw xrt_core::error(EINVAL, "file transfer exceeds buffer size");
+  if (!sz)
+    return;
+
+  auto hbuf = static_cast<char*>(boh->get_hbuf());
+  auto p2p = boh->get_flags() == xrt::bo::flags::p2p;
+  auto dir = load ? XCL_BO_SYNC_BO_TO_DEVICE : XCL_BO_SYNC_BO_FROM_DEVICE;
+
+  auto path = "/proc/self/fd/" + std::to_string(fd);
+  int dfd = ::open(path.c_str(), (load ? O_RDONLY : O_WRONLY) | O_DIRECT);
+  auto direct = [dfd, hbuf, foff](size_t pos, size_t len) {
+    return dfd >= 0
+      && (reinterpret_cast<uintptr_t>(hbuf + pos) % file_direct_alignment) == 0
+      && ((foff + pos) % file_direct_alignment) == 0
+      && (len % file_direct_alignment) == 0;
+  };
+
+  auto chunks = (sz + file_chunk_size - 1) / file_chunk_size;
+  std::atomic<size_t> next {0};
+  std::atomic<bool> failed {false};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto worker = [&] {
+    try {
+      for (auto idx = next++; idx < chunks && !failed; idx = next++) {
+        auto pos = idx * file_chunk_size;
+        auto len = std::min(file_chunk_size, sz - pos);
+        if (!load && !p2p)
+          boh->sync(dir, len, pos);
+        file_io(direct(pos, len) ? dfd : fd, hbuf + pos, len, foff + pos, load);
+        if (load && !p2p)
+          boh->sync(dir, len, pos);
+      }
+    }
+    catch (...) {
+      std::lock_guard lk(error_mutex);
+      if (!failed.exchange(true))
+        error = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < std::min(chunks, file_queue_depth); ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto& t : threads)
+    t.join();
+
+  if (dfd >= 0)
+    ::close(dfd);
+
+  if (error)
+    std::rethrow_exception(error);
+}
+#endif
+
 // driver allocates host buffer
 static std::shared_ptr<xrt::bo_impl>
 alloc_kbuf(const device_type& device, size_t sz, xrtBufferFlags flags, xrtMemoryGroup grp)
@@ -1101,10 +2108,159 @@ alloc_hbuf(const device_type& device, xrt_core::aligned_ptr_type&& hbuf, size_t
   return boh;
 }
 
+// Huge page size per xrt.ini Runtime.hbuf_hugepages, 0 if disabled
+static size_t
+get_hugepage_size()
+{
+  static size_t size = [] () -> size_t {
+    auto value = xrt_core::config::get_hbuf_hugepages();
+    if (value.empty())
+      return 0;
+    if (value == "2M")
+      return 2ULL << 20;
+    if (value == "1G")
+      return 1ULL << 30;
+    send_exception_message("Ignoring invalid Runtime.hbuf_hugepages value '" + value + "', expected 2M or 1G");
+    return 0;
+  }();
+  return size;
+}
+
+// Map huge pages for host buffer, return nullptr if not possible
+static void*
+map_hugepages(size_t map_size, size_t page_size)
+{
+#if defined(__linux__) && defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+  auto page_shift = (page_size == (1ULL << 30)) ? 30 : 21;
+  auto flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (page_shift << MAP_HUGE_SHIFT);
+  auto ptr = ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (ptr != MAP_FAILED)
+    return ptr;
+
+  static bool warned = false;
+  if (!warned) {
+    warned = true;
+    xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",
+                            "Failed to map huge pages for host buffer, using regular pages. "
+                            "Check /proc/sys/vm/nr_hugepages or hugepagesz kernel parameter.");
+  }
+#endif
+  return nullptr;
+}
+
+// Prefer NUMA node of device for pages of XRT allocated host buffer
+// if enabled per xrt.ini Runtime.numa_affinity.  Must be called
+// before the buffer is pinned, pages already touched are not moved.
+static void
+bind_numa(const device_type& device, void* hbuf, size_t sz)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+  if (!xrt_core::config::get_numa_affinity())
+    return;
+
+  auto node = xrt_core::device_query_default<xrt_core::query::numa_node>(device.get_core_device(), -1);
+  if (node < 0 || node >= static_cast<int>(sizeof(unsigned long) * 8))
+    return;
+
+  unsigned long nodemask = 1UL << node;
+  if (::syscall(SYS_mbind, hbuf, sz, MPOL_PREFERRED, &nodemask, sizeof(nodemask) * 8, 0))
+    xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT",
+                            "Failed to bind host buffer to NUMA node " + std::to_string(node));
+#endif
+}
+
+// XRT allocates host buffer from huge pages if enabled
+static std::shared_ptr<xrt::bo_impl>
+alloc_hugepage(const device_type& device, size_t sz, xrtBufferFlags flags, xrtMemoryGroup grp)
+{
+  auto page_size = get_hugepage_size();
+  if (!page_size || sz < page_size)
+    return nullptr;
+
+  auto map_size = ((sz + page_size - 1) / page_size) * page_size;
+  auto hbuf = map_hugepages(map_size, page_size);
+  if (!hbuf)
+    return nullptr;
+  bind_numa(device, hbuf, map_size);
+
+  XRT_TRACE_POINT_SCOPE(xrt_bo_alloc_hugepage);
+  try {
+    auto start = std::chrono::steady_clock::now();
+    auto handle = alloc_bo(device, hbuf, sz, flags, grp);
+    if (xrt_core::message::enabled(xrt_core::message::severity_level::debug)) {
+      auto pin_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+      xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT",
+                              "Pinned huge page host buffer of " + std::to_string(sz) + " bytes in "
+                              + std::to_string(pin_us) + " us");
+    }
+    auto boh = std::make_shared<xrt::buffer_hugepage>(device, std::move(handle), sz, hbuf, map_size);
+    boh->get_usage_logger()->log_buffer_info_construct(device->get_device_id(), sz, device.get_hwctx_handle());
+    return boh;
+  }
+  catch (...) {
+#ifdef __linux__
+    ::munmap(hbuf, map_size);
+#endif
+    throw;
+  }
+}
+
+// class bo_slab_pool - Slabs per device, hw context and memory group
+//
+// Slabs are referenced weakly, a slab goes away when its last carved
+// buffer is freed.
+class bo_slab_pool
+{
+  using key_type = std::tuple<const xrt_core::device*, xrt_core::hwctx_handle*, xrtMemoryGroup>;
+  std::mutex m_mutex;
+  std::map<key_type, std::vector<std::weak_ptr<xrt::bo_slab>>> m_slabs;
+
+public:
+  static bo_slab_pool&
+  instance()
+  {
+    static bo_slab_pool pool;
+    return pool;
+  }
+
+  // carve() - Carve a device only buffer of sz bytes
+  std::shared_ptr<xrt::bo_impl>
+  carve(const device_type& device, size_t sz, xrtMemoryGroup grp, size_t slab_size)
+  {
+    auto carved = (sz + xrt::bo_slab::alignment - 1) & ~(xrt::bo_slab::alignment - 1);
+    std::lock_guard lk(m_mutex);
+    auto& slabs = m_slabs[{device.get_core_device(), device.get_hwctx_handle(), grp}];
+    slabs.erase(std::remove_if(slabs.begin(), slabs.end(), [](const auto& slab) { return slab.expired(); }),
+                slabs.end());
+
+    for (auto& weak : slabs) {
+      auto slab = weak.lock();
+      if (!slab)
+        continue;
+      if (auto offset = slab->carve(carved); offset != xrt::bo_slab::no_offset)
+        return std::make_shared<xrt::buffer_slab>(device, std::move(slab), offset, carved, sz);
+    }
+
+    auto slab = std::make_shared<xrt::bo_slab>(device, alloc_bo(device, slab_size, XCL_BO_FLAGS_DEV_ONLY, grp), slab_size);
+    slabs.push_back(slab);
+    auto offset = slab->carve(carved);
+    return std::make_shared<xrt::buffer_slab>(device, std::move(slab), offset, carved, sz);
+  }
+};
+
 static std::shared_ptr<xrt::bo_impl>
 alloc_dbuf(const device_type& device, size_t sz, xrtBufferFlags, xrtMemoryGroup grp)
 {
   XRT_TRACE_POINT_SCOPE(xrt_bo_alloc_dbuf);
+
+  // Small buffers are carved from a shared slab when enabled
+  static size_t slab_size = xrt_core::config::get_bo_slab_size();
+  if (slab_size && sz && sz <= slab_size / 8) {
+    auto boh = bo_slab_pool::instance().carve(device, sz, grp, slab_size);
+    boh->get_usage_logger()->log_buffer_info_construct(device->get_device_id(), sz, device.get_hwctx_handle());
+    return boh;
+  }
+
   auto handle = alloc_bo(device, sz, XCL_BO_FLAGS_DEV_ONLY, grp);
   auto boh = std::make_shared<xrt::buffer_dbuf>(device, std::move(handle), sz);
   boh->get_usage_logger()->log_buffer_info_construct(device->get_device_id(), sz, device.get_hwctx_handle());
@@ -1141,8 +2297,13 @@ alloc(const device_type& device, size_t sz, xrtBufferFlags flags, xrtMemoryGroup
       // In DC scenario, for sw_emu, use the xclAllocBO and xclMapBO instead of xclAllocUserPtrBO,
       // which helps to remove the extra copy in sw_emu.
       return alloc_kbuf(device, sz, flags, grp);
-    else  // NOLINT hicpp-braces-around-statements
-      return alloc_hbuf(device, xrt_core::aligned_alloc(get_alignment(), sz), sz, flags, grp);
+    else if (auto boh = alloc_hugepage(device, sz, flags, grp)) // NOLINT hicpp-braces-around-statements
+      return boh;
+    else {  // NOLINT hicpp-braces-around-statements
+      auto hbuf = xrt_core::aligned_alloc(get_alignment(), sz);
+      bind_numa(device, hbuf.get(), sz);
+      return alloc_hbuf(device, std::move(hbuf), sz, flags, grp);
+    }
 #endif
   case XCL_BO_FLAGS_CACHEABLE:
   case XCL_BO_FLAGS_SVM:
@@ -1164,10 +2325,118 @@ alloc_xbuf(const device_type& device, xcl_buffer_handle xhdl)
   return std::make_shared<xrt::buffer_xbuf>(device, xhdl);
 }
 
+static std::shared_ptr<xrt::bo_impl>
+alloc_sub(const std::shared_ptr<xrt::bo_impl>& parent, size_t size, size_t offset);
+
+// class host_memory_registry - Host memory registered with devices
+//
+// A userptr buffer that lies within a registered range is created as
+// a sub-buffer of a buffer spanning the whole range.  The spanning
+// buffer is allocated on first use for each hardware context, flags,
+// and memory group, so the driver pins the range once per such
+// combination rather than once per buffer.  Unregistering a range
+// drops the spanning buffers, the pages stay pinned until the last
+// sub-buffer is destroyed.
+class host_memory_registry
+{
+  using bo_key = std::tuple<const xrt_core::hwctx_handle*, xrtBufferFlags, xrtMemoryGroup>;
+
+  struct range
+  {
+    size_t size;
+    std::map<bo_key, std::shared_ptr<xrt::bo_impl>> bos;
+  };
+
+  // device -> page aligned start of range -> range
+  using range_map = std::map<uintptr_t, range>;
+
+  std::mutex m_mutex;
+  std::map<const xrt_core::device*, range_map> m_ranges;
+
+  // Range containing [addr, addr + sz) or end()
+  static range_map::iterator
+  find(range_map& ranges, uintptr_t addr, size_t sz)
+  {
+    auto itr = ranges.upper_bound(addr);
+    if (itr == ranges.begin())
+      return ranges.end();
+    --itr;
+    return (addr + sz <= itr->first + itr->second.size) ? itr : ranges.end();
+  }
+
+public:
+  void
+  add(const xrt_core::device* device, void* ptr, size_t sz)
+  {
+    if (!ptr || !sz)
+      throw xrt_core::error(EINVAL, "invalid host memory range");
+
+    auto align = get_alignment();
+    auto start = reinterpret_cast<uintptr_t>(ptr) / align * align;
+    auto end = (reinterpret_cast<uintptr_t>(ptr) + sz + align - 1) / align * align;
+
+    std::lock_guard lk(m_mutex);
+    auto& ranges = m_ranges[device];
+    auto next = ranges.lower_bound(start);
+    if (next != ranges.end() && next->first < end)
+      throw xrt_core::error(EINVAL, "host memory range overlaps registered range");
+    if (next != ranges.begin() && std::prev(next)->first + std::prev(next)->second.size > start)
+      throw xrt_core::error(EINVAL, "host memory range overlaps registered range");
+
+    ranges.emplace_hint(next, start, range{end - start, {}});
+  }
+
+  void
+  remove(const xrt_core::device* device, void* ptr)
+  {
+    std::lock_guard lk(m_mutex);
+    auto& ranges = m_ranges[device];
+    auto itr = find(ranges, reinterpret_cast<uintptr_t>(ptr), 0);
+    if (itr == ranges.end())
+      throw xrt_core::error(EINVAL, "host memory is not registered");
+
+    ranges.erase(itr);
+  }
+
+  // Spanning buffer and offset of userptr within it if the userptr
+  // buffer is within a registered range, nullptr otherwise
+  std::pair<std::shared_ptr<xrt::bo_impl>, size_t>
+  lookup(const device_type& device, void* userptr, size_t sz, xrtBufferFlags flags, xrtMemoryGroup grp)
+  {
+    std::lock_guard lk(m_mutex);
+    auto ditr = m_ranges.find(device.get_core_device());
+    if (ditr == m_ranges.end())
+      return {nullptr, 0};
+
+    auto addr = reinterpret_cast<uintptr_t>(userptr);
+    auto itr = find(ditr->second, addr, sz);
+    if (itr == ditr->second.end())
+      return {nullptr, 0};
+
+    auto& [start, rng] = *itr;
+    auto& bo = rng.bos[{device.get_hwctx_handle(), flags, grp}];
+    if (!bo) {
+      auto hbuf = reinterpret_cast<void*>(start);
+      bo = std::make_shared<xrt::buffer_ubuf>(device, alloc_bo(device, hbuf, rng.size, flags, grp), rng.size, hbuf);
+    }
+    return {bo, addr - start};
+  }
+};
+
+static host_memory_registry&
+host_memory()
+{
+  static host_memory_registry registry;
+  return registry;
+}
+
 static std::shared_ptr<xrt::bo_impl>
 alloc_userptr(const device_type& device, void* userptr, size_t sz, xrtBufferFlags flags, xrtMemoryGroup grp)
 {
   XRT_TRACE_POINT_SCOPE(xrt_bo_alloc_userptr);
+  if (auto [parent, offset] = host_memory().lookup(device, userptr, sz, flags, grp); parent)
+    return alloc_sub(parent, sz, offset);
+
   return alloc_ubuf(device, userptr, sz, flags, grp);
 }
 
@@ -1340,6 +2609,20 @@ wait()
   handle->wait();
 }
 
+bool
+bo::async_handle::
+ready() const
+{
+  return handle->ready();
+}
+
+void
+bo::async_handle::
+set_callback(std::function<void(std::exception_ptr)> fcn)
+{
+  handle->set_callback(std::move(fcn));
+}
+
 bo::
 bo(const xrt::device& device, void* userptr, size_t sz, bo::flags flags, memory_group grp)
   : handle(xdp::native::profiling_wrapper("xrt::bo::bo",
@@ -1497,9 +2780,67 @@ void
 bo::
 sync(xclBOSyncDirection dir, size_t size, size_t offset)
 {
+  XRT_TRACE_POINT_SCOPE2(xrt_bo_sync, static_cast<int>(dir), size);
   return xdp::native::profiling_wrapper_sync("xrt::bo::sync", dir, size,
     [this, dir, size, offset]{
-      handle->sync(dir, size, offset);
+      trace_sync(dir, [this, dir, size, offset] { handle->sync(dir, size, offset); });
+    });
+}
+
+void
+bo::
+sync_many(const std::vector<bo>& bos, xclBOSyncDirection dir)
+{
+  size_t total = 0;
+  for (const auto& bo : bos)
+    total += bo.size();
+
+  return xdp::native::profiling_wrapper_sync("xrt::bo::sync_many", dir, total,
+    [&bos, dir]{
+      trace_sync(dir, [&bos, dir] { sync_bos(bos, dir); });
+    });
+}
+
+void
+bo::
+sync_rect(xclBOSyncDirection dir, const std::array<size_t, 3>& origin,
+          const std::array<size_t, 3>& region, size_t row_pitch, size_t slice_pitch)
+{
+  return xdp::native::profiling_wrapper("xrt::bo::sync_rect",
+    [this, dir, &origin, &region, row_pitch, slice_pitch]{
+      trace_sync(dir, [this, dir, &origin, &region, row_pitch, slice_pitch] {
+        ::sync_rect(handle.get(), dir, origin, region, row_pitch, slice_pitch);
+      });
+    });
+}
+
+void
+bo::
+load_from_file(int fd, uint64_t offset, size_t size)
+{
+  XRT_TRACE_POINT_SCOPE2(xrt_bo_sync, static_cast<int>(XCL_BO_SYNC_BO_TO_DEVICE), size);
+  return xdp::native::profiling_wrapper_sync("xrt::bo::load_from_file", XCL_BO_SYNC_BO_TO_DEVICE, size,
+    [this, fd, offset, size]{
+#ifdef __linux__
+      transfer_file(handle.get(), fd, offset, size, true);
+#else
+      throw xrt_core::error(ENOTSUP, "load_from_file is not supported on this platform");
+#endif
+    });
+}
+
+void
+bo::
+store_to_file(int fd, uint64_t offset, size_t size)
+{
+  XRT_TRACE_POINT_SCOPE2(xrt_bo_sync, static_cast<int>(XCL_BO_SYNC_BO_FROM_DEVICE), size);
+  return xdp::native::profiling_wrapper_sync("xrt::bo::store_to_file", XCL_BO_SYNC_BO_FROM_DEVICE, size,
+    [this, fd, offset, size]{
+#ifdef __linux__
+      transfer_file(handle.get(), fd, offset, size, false);
+#else
+      throw xrt_core::error(ENOTSUP, "store_to_file is not supported on this platform");
+#endif
     });
 }
 
@@ -1547,6 +2888,16 @@ copy(const bo& src, size_t sz, size_t src_offset, size_t dst_offset)
     });
 }
 
+void
+bo::
+fill(const void* pattern, size_t pattern_size, size_t sz, size_t offset)
+{
+  xdp::native::profiling_wrapper("xrt::bo::fill",
+    [this, pattern, pattern_size, sz, offset]{
+      handle->fill(pattern, pattern_size, sz, offset);
+    });
+}
+
 bo::
 ~bo()
 {}
@@ -1658,6 +3009,207 @@ bo(const xrt::hw_context& hwctx, pid_type pid, xrt::bo::export_handle ehdl)
   : xrt::bo::bo{alloc_import_from_pid(device_type{hwctx}, pid, ehdl)}
 {}
 
+// class striped_bo_impl - Host buffer striped over pseudo channels
+//
+// Stripe idx holds granules idx, idx + N, idx + 2N, ... of the host
+// buffer back to back.  Each stripe is a regular buffer whose host
+// side is the staging area for the stripe DMA.
+class striped_bo_impl
+{
+  std::vector<xrt::bo> m_stripes;
+  xrt_core::aligned_ptr_type m_hbuf;
+  size_t m_size;
+  size_t m_granularity;
+
+  // Used banks of same type whose address range is within the group
+  static std::vector<xrt::memory_group>
+  pseudo_channels(const xrt_core::device* device, xrt::memory_group grp)
+  {
+    auto raw = xrt_core::device_query<xrt_core::query::mem_topology_raw>(device);
+    auto topo = reinterpret_cast<const mem_topology*>(raw.data());
+    if (!topo || grp >= static_cast<xrt::memory_group>(topo->m_count))
+      throw xrt_core::error(-EINVAL, "striped_bo: invalid memory group " + std::to_string(grp));
+
+    const auto& group = topo->m_mem_data[grp];
+    auto begin = group.m_base_address;
+    auto end = begin + group.m_size * 1024;
+    std::vector<xrt::memory_group> pcs;
+    for (int32_t idx = 0; idx < topo->m_count; ++idx) {
+      const auto& mem = topo->m_mem_data[idx];
+      if (static_cast<xrt::memory_group>(idx) == grp || !mem.m_used || mem.m_type != group.m_type)
+        continue;
+      if (mem.m_base_address >= begin && mem.m_base_address + mem.m_size * 1024 <= end)
+        pcs.push_back(idx);
+    }
+
+    // Group is a single pseudo channel
+    if (pcs.empty())
+      pcs.push_back(grp);
+
+    return pcs;
+  }
+
+  // Run fcn(idx) for each stripe on the DMA workers
+  template <typename Function>
+  void
+  for_each_stripe(Function&& fcn)
+  {
+    auto& pool = async_dma::instance();
+    std::vector<xrt_core::task::event<void>> events;
+    events.reserve(m_stripes.size());
+    for (size_t idx = 0; idx < m_stripes.size(); ++idx)
+      events.push_back(pool.enqueue([&fcn, idx] { fcn(idx); }));
+
+    // All stripes must be done before fcn goes out of scope
+    std::exception_ptr error;
+    for (auto& event : events) {
+      try {
+        event.wait();
+      }
+      catch (...) {
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+public:
+  striped_bo_impl(const xrt::device& device, size_t sz, xrt::memory_group grp, size_t stripes, size_t granularity)
+    : m_size(sz)
+    , m_granularity(granularity)
+  {
+    if (!granularity || granularity % xrt_core::getpagesize())
+      throw xrt_core::error(-EINVAL, "striped_bo: granularity must be a multiple of page size");
+    if (!sz || sz % granularity)
+      throw xrt_core::error(-EINVAL, "striped_bo: size must be a multiple of granularity");
+
+    auto pcs = pseudo_channels(device.get_handle().get(), grp);
+    if (!stripes)
+      stripes = pcs.size();
+    if (stripes > pcs.size())
+      throw xrt_core::error(-EINVAL, "striped_bo: memory group " + std::to_string(grp)
+                            + " has only " + std::to_string(pcs.size()) + " pseudo channels");
+
+    auto granules = sz / granularity;
+    auto stripe_size = ((granules + stripes - 1) / stripes) * granularity;
+    for (size_t idx = 0; idx < stripes; ++idx)
+      m_stripes.emplace_back(device, stripe_size, xrt::bo::flags::normal, pcs[idx]);
+
+    m_hbuf = xrt_core::aligned_alloc(get_alignment(), sz);
+    if (!m_hbuf)
+      throw xrt_core::error(-ENOMEM, "striped_bo: failed to allocate host buffer");
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  size_t
+  stripes() const
+  {
+    return m_stripes.size();
+  }
+
+  size_t
+  granularity() const
+  {
+    return m_granularity;
+  }
+
+  xrt::bo
+  stripe(size_t idx) const
+  {
+    return m_stripes.at(idx);
+  }
+
+  void*
+  map() const
+  {
+    return m_hbuf.get();
+  }
+
+  void
+  sync(xclBOSyncDirection dir)
+  {
+    auto hbuf = static_cast<char*>(m_hbuf.get());
+    auto granules = m_size / m_granularity;
+    auto n = m_stripes.size();
+    for_each_stripe([this, dir, hbuf, granules, n](size_t idx) {
+      auto& stripe = m_stripes[idx];
+      auto sbuf = stripe.map<char*>();
+      size_t used = 0;
+      if (dir == XCL_BO_SYNC_BO_TO_DEVICE) {
+        for (auto k = idx; k < granules; k += n, used += m_granularity)
+          std::memcpy(sbuf + used, hbuf + k * m_granularity, m_granularity);
+        if (used)
+          stripe.sync(dir, used, 0);
+        return;
+      }
+
+      for (auto k = idx; k < granules; k += n)
+        used += m_granularity;
+      if (!used)
+        return;
+      stripe.sync(dir, used, 0);
+      used = 0;
+      for (auto k = idx; k < granules; k += n, used += m_granularity)
+        std::memcpy(hbuf + k * m_granularity, sbuf + used, m_granularity);
+    });
+  }
+};
+
+striped_bo::
+striped_bo(const xrt::device& device, size_t sz, xrt::memory_group grp, size_t stripes, size_t granularity)
+  : detail::pimpl<striped_bo_impl>(std::make_shared<striped_bo_impl>(device, sz, grp, stripes, granularity))
+{}
+
+size_t
+striped_bo::
+size() const
+{
+  return handle->size();
+}
+
+size_t
+striped_bo::
+stripes() const
+{
+  return handle->stripes();
+}
+
+size_t
+striped_bo::
+granularity() const
+{
+  return handle->granularity();
+}
+
+xrt::bo
+striped_bo::
+stripe(size_t idx) const
+{
+  return handle->stripe(idx);
+}
+
+void*
+striped_bo::
+map()
+{
+  return handle->map();
+}
+
+void
+striped_bo::
+sync(xclBOSyncDirection dir)
+{
+  XRT_TRACE_POINT_SCOPE2(xrt_striped_bo_sync, static_cast<int>(dir), handle->size());
+  handle->sync(dir);
+}
+
 } // xrt::ext
 
 ////////////////////////////////////////////////////////////////
@@ -1679,6 +3231,18 @@ get_offset(const xrt::bo& bo)
   return handle->get_offset();
 }
 
+void
+register_host_memory(const xrt_core::device* device, void* ptr, size_t sz)
+{
+  host_memory().add(device, ptr, sz);
+}
+
+void
+unregister_host_memory(const xrt_core::device* device, void* ptr)
+{
+  host_memory().remove(device, ptr);
+}
+
 xrt::bo
 create_debug_bo(const xrt::hw_context& hwctx, size_t sz)
 {
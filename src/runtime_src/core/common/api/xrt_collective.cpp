@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// This file implements XRT collective APIs as declared in
+// core/include/experimental/xrt_collective.h
+#define XRT_API_SOURCE         // exporting xrt_collective.h
+#define XRT_CORE_COMMON_SOURCE // in same dll as core_common
+#include "core/include/experimental/xrt_collective.h"
+
+#include "core/common/error.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+using options = xrt::collective::options;
+
+// Copy sz bytes of src into dst.  The bo handle is copied because
+// xrt::bo::copy is non-const while the buffers are passed as const.
+static void
+copy(xrt::bo dst, const xrt::bo& src, size_t sz, size_t src_offset, size_t dst_offset)
+{
+  dst.copy(src, sz, src_offset, dst_offset);
+}
+
+// Run fn(idx) for idx in [0, n) on a thread each, rethrow the first
+// exception once all threads are done.
+template <typename Function>
+static void
+parallel_for(size_t n, Function&& fn)
+{
+  std::vector<std::exception_ptr> errors(n);
+  std::vector<std::thread> threads;
+  threads.reserve(n);
+  try {
+    for (size_t idx = 0; idx < n; ++idx)
+      threads.emplace_back([&fn, &errors, idx] {
+        try {
+          fn(idx);
+        }
+        catch (...) {
+          errors[idx] = std::current_exception();
+        }
+      });
+  }
+  catch (...) {
+    for (auto& t : threads)
+      t.join();
+    throw;
+  }
+
+  for (auto& t : threads)
+    t.join();
+
+  for (auto& error : errors)
+    if (error)
+      std::rethrow_exception(error);
+}
+
+// class ring_progress - Chunks forwarded by each hop of a ring
+//
+// A hop forwards chunk k only after the previous hop has delivered
+// it.  A failing hop aborts the ring so waiting hops return.
+class ring_progress
+{
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::vector<size_t> m_done;
+  bool m_abort = false;
+
+public:
+  explicit ring_progress(size_t hops)
+    : m_done(hops, 0)
+  {}
+
+  // Wait for hop to have delivered chunks, false if aborted
+  bool
+  wait(size_t hop, size_t chunks)
+  {
+    std::unique_lock lk(m_mutex);
+    m_cond.wait(lk, [this, hop, chunks] { return m_abort || m_done[hop] >= chunks; });
+    return !m_abort;
+  }
+
+  void
+  complete(size_t hop)
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      ++m_done[hop];
+    }
+    m_cond.notify_all();
+  }
+
+  void
+  abort()
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      m_abort = true;
+    }
+    m_cond.notify_all();
+  }
+};
+
+// Forward src along the chain dsts[0], dsts[1], ... in chunks.  Hop
+// idx copies into dsts[idx] from src or from dsts[idx-1].
+static void
+broadcast_ring(const xrt::bo& src, const std::vector<xrt::bo>& dsts, size_t sz, size_t chunk)
+{
+  auto chunks = (sz + chunk - 1) / chunk;
+  ring_progress progress(dsts.size());
+  parallel_for(dsts.size(), [&](size_t hop) {
+    const auto& from = hop ? dsts[hop - 1] : src;
+    try {
+      for (size_t k = 0; k < chunks; ++k) {
+        if (hop && !progress.wait(hop - 1, k + 1))
+          return;
+        auto offset = k * chunk;
+        auto csz = std::min(chunk, sz - offset);
+        copy(dsts[hop], from, csz, offset, offset);
+        progress.complete(hop);
+      }
+    }
+    catch (...) {
+      progress.abort();
+      throw;
+    }
+  });
+}
+
+// Each round every buffer holding the data copies it to one buffer
+// that does not, doubling the holders.
+static void
+broadcast_tree(const xrt::bo& src, const std::vector<xrt::bo>& dsts, size_t sz)
+{
+  std::vector<const xrt::bo*> holders {&src};
+  size_t next = 0;
+  while (next < dsts.size()) {
+    auto n = std::min(holders.size(), dsts.size() - next);
+    parallel_for(n, [&](size_t idx) {
+      copy(dsts[next + idx], *holders[idx], sz, 0, 0);
+    });
+    for (size_t idx = 0; idx < n; ++idx)
+      holders.push_back(&dsts[next + idx]);
+    next += n;
+  }
+}
+
+static void
+check_chunk(const options& opt)
+{
+  if (!opt.chunk_size)
+    throw xrt_core::error(-EINVAL, "collective chunk size must be a positive number");
+}
+
+} // namespace
+
+namespace xrt::collective {
+
+void
+broadcast(const xrt::bo& src, const std::vector<xrt::bo>& dsts, const options& opt)
+{
+  check_chunk(opt);
+  auto sz = src.size();
+  for (const auto& dst : dsts)
+    if (dst.size() < sz)
+      throw xrt_core::error(-EINVAL, "broadcast destination smaller than source");
+
+  if (dsts.empty() || !sz)
+    return;
+
+  auto sched = opt.sched;
+  if (sched == options::schedule::automatic)
+    sched = (sz < 2 * opt.chunk_size) ? options::schedule::tree : options::schedule::ring;
+
+  if (sched == options::schedule::tree)
+    broadcast_tree(src, dsts, sz);
+  else
+    broadcast_ring(src, dsts, sz, opt.chunk_size);
+}
+
+void
+scatter(const xrt::bo& src, const std::vector<xrt::bo>& dsts, const options&)
+{
+  std::vector<size_t> offsets;
+  size_t total = 0;
+  for (const auto& dst : dsts) {
+    offsets.push_back(total);
+    total += dst.size();
+  }
+  if (total > src.size())
+    throw xrt_core::error(-EINVAL, "scatter source smaller than combined destinations");
+
+  // Slices are disjoint, each goes straight from the root
+  parallel_for(dsts.size(), [&](size_t idx) {
+    if (auto sz = dsts[idx].size())
+      copy(dsts[idx], src, sz, offsets[idx], 0);
+  });
+}
+
+void
+gather(const std::vector<xrt::bo>& srcs, const xrt::bo& dst, const options&)
+{
+  std::vector<size_t> offsets;
+  size_t total = 0;
+  for (const auto& src : srcs) {
+    offsets.push_back(total);
+    total += src.size();
+  }
+  if (total > dst.size())
+    throw xrt_core::error(-EINVAL, "gather destination smaller than combined sources");
+
+  // Slices are disjoint, each goes straight to the root
+  parallel_for(srcs.size(), [&](size_t idx) {
+    if (auto sz = srcs[idx].size())
+      copy(dst, srcs[idx], sz, 0, offsets[idx]);
+  });
+}
+
+void
+all_gather(const std::vector<xrt::bo>& srcs, const std::vector<xrt::bo>& dsts, const options&)
+{
+  if (srcs.size() != dsts.size())
+    throw xrt_core::error(-EINVAL, "all_gather requires one destination per source");
+
+  auto n = srcs.size();
+  if (!n)
+    return;
+
+  auto slice = srcs[0].size();
+  for (const auto& src : srcs)
+    if (src.size() != slice)
+      throw xrt_core::error(-EINVAL, "all_gather sources must be of equal size");
+  for (const auto& dst : dsts)
+    if (dst.size() < n * slice)
+      throw xrt_core::error(-EINVAL, "all_gather destination smaller than combined sources");
+
+  if (!slice)
+    return;
+
+  // Place own slice, then in step s device idx forwards the slice it
+  // received in step s-1 to the next device.  After n-1 steps every
+  // device has every slice, and each link carried n-1 slices.
+  parallel_for(n, [&](size_t idx) {
+    copy(dsts[idx], srcs[idx], slice, 0, idx * slice);
+  });
+  for (size_t step = 1; step < n; ++step) {
+    parallel_for(n, [&](size_t idx) {
+      auto offset = ((idx + n + 1 - step) % n) * slice;
+      copy(dsts[(idx + 1) % n], dsts[idx], slice, offset, offset);
+    });
+  }
+}
+
+} // xrt::collective
@@ -22,6 +22,7 @@
 #include "core/common/trace.h"
 #include "core/common/sysinfo.h"
 
+#include "bo_int.h"
 #include "device_int.h"
 #include "handle.h"
 #include "hw_queue.h"
@@ -304,6 +305,24 @@ get_xclbin_uuid() const
   });
 }
 
+void
+device::
+register_host_memory(void* ptr, size_t size)
+{
+  xdp::native::profiling_wrapper("xrt::device::register_host_memory", [this, ptr, size]{
+    xrt_core::bo_int::register_host_memory(handle.get(), ptr, size);
+  });
+}
+
+void
+device::
+unregister_host_memory(void* ptr)
+{
+  xdp::native::profiling_wrapper("xrt::device::unregister_host_memory", [this, ptr]{
+    xrt_core::bo_int::unregister_host_memory(handle.get(), ptr);
+  });
+}
+
 device::
 operator xclDeviceHandle() const
 {
@@ -8,30 +8,157 @@
 
 #include "elf_int.h"
 #include "core/common/error.h"
+#include "core/common/mapped_file.h"
 
 #include <elfio/elfio.hpp>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
+#include <string_view>
 #include <vector>
 
+namespace {
+
+// class memory_buffer - Read only stream buffer over raw ELF data
+//
+// ELFIO parses from a stream, this stream buffer lets it parse the
+// mapped file in place.  Seeking is required by ELFIO to read
+// headers and sections at their file offsets.
+class memory_buffer : public std::streambuf
+{
+public:
+  memory_buffer(const char* data, size_t size)
+  {
+    auto begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+
+protected:
+  pos_type
+  seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override
+  {
+    char* base = nullptr;
+    switch (dir) {
+    case std::ios_base::beg:
+      base = eback();
+      break;
+    case std::ios_base::cur:
+      base = gptr();
+      break;
+    default:
+      base = egptr();
+      break;
+    }
+
+    auto pos = base + off;
+    if (pos < eback() || pos > egptr())
+      return pos_type(off_type(-1));
+
+    setg(eback(), pos, egptr());
+    return pos_type(pos - eback());
+  }
+
+  pos_type
+  seekpos(pos_type pos, std::ios_base::openmode mode) override
+  {
+    return seekoff(off_type(pos), std::ios_base::beg, mode);
+  }
+};
+
+static std::vector<char>
+read_stream(std::istream& stream)
+{
+  return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+
+} // namespace
+
 namespace xrt {
 
 // class elf_impl - Implementation
+//
+// The ELF file is memory mapped where supported, otherwise its
+// content is read once into memory.  ELFIO parses the raw data in
+// place through a stream over the mapping with lazy loading, so
+// section payloads are read only when accessed and sections
+// extracted by XRT are copied straight from the raw data.  Lazy
+// loading reads from the shared stream, users of the elfio object
+// must hold the lock returned by get_lock().
 class elf_impl
 {
+#ifndef _WIN32
+  std::unique_ptr<xrt_core::mapped_file> m_file; // mapped ELF file, or
+#endif
+  std::vector<char> m_data;   // complete copy of ELF content
+  std::string_view m_raw;     // raw ELF content
+  std::unique_ptr<memory_buffer> m_buffer;
+  std::unique_ptr<std::istream> m_stream;
   ELFIO::elfio m_elf;
+  std::mutex m_mutex;
+
+  void
+  init()
+  {
+#ifndef _WIN32
+    if (m_file)
+      m_raw = {m_file->data(), m_file->size()};
+    else
+#endif
+      m_raw = {m_data.data(), m_data.size()};
+
+    m_buffer = std::make_unique<memory_buffer>(m_raw.data(), m_raw.size());
+    m_stream = std::make_unique<std::istream>(m_buffer.get());
+    if (!m_elf.load(*m_stream, true /*is_lazy*/))
+      throw std::runtime_error("not a valid ELF file");
+  }
+
 public:
   explicit elf_impl(const std::string& fnm)
   {
-    if (!m_elf.load(fnm))
+#ifndef _WIN32
+    m_file = std::make_unique<xrt_core::mapped_file>(fnm);
+#else
+    std::ifstream stream(fnm, std::ios::binary);
+    if (!stream)
+      throw std::runtime_error(fnm + " is not found or is not a valid ELF file");
+    m_data = read_stream(stream);
+#endif
+    try {
+      init();
+    }
+    catch (const std::exception&) {
       throw std::runtime_error(fnm + " is not found or is not a valid ELF file");
+    }
   }
 
-  explicit elf_impl(std::istream& stream)
+  explicit elf_impl(std::vector<char> data)
+    : m_data(std::move(data))
   {
-    if (!m_elf.load(stream))
+    try {
+      init();
+    }
+    catch (const std::exception&) {
       throw std::runtime_error("not a valid ELF stream");
+    }
+  }
+
+  elf_impl(const elf_impl&) = delete;
+  elf_impl(elf_impl&&) = delete;
+  elf_impl& operator=(const elf_impl&) = delete;
+  elf_impl& operator=(elf_impl&&) = delete;
+
+  [[nodiscard]] std::string_view
+  get_raw() const
+  {
+    return m_raw;
   }
 
   [[nodiscard]] const ELFIO::elfio&
@@ -40,6 +167,12 @@ public:
     return m_elf;
   }
 
+  std::unique_lock<std::mutex>
+  get_lock()
+  {
+    return std::unique_lock<std::mutex>(m_mutex);
+  }
+
   [[nodiscard]] xrt::uuid
   get_cfg_uuid() const
   {
@@ -49,16 +182,69 @@ public:
   std::vector<uint8_t>
   get_section(const std::string& sname)
   {
+    std::lock_guard lk(m_mutex);
     auto sec = m_elf.sections[sname];
     if (!sec)
       throw std::runtime_error("Failed to find section: " + sname);
 
-    auto data = sec->get_data();
-    std::vector<uint8_t> vec(data, data + sec->get_size());
-    return vec;
+    auto size = sec->get_size();
+    if (sec->get_type() == ELFIO::SHT_NOBITS)
+      return std::vector<uint8_t>(size, 0);
+
+    // Copy from raw data, the section is not loaded by ELFIO
+    auto offset = sec->get_offset();
+    if (offset > m_raw.size() || size > m_raw.size() - offset)
+      throw std::runtime_error("Section " + sname + " exceeds ELF file size");
+
+    auto data = reinterpret_cast<const uint8_t*>(m_raw.data() + offset);
+    return {data, data + size};
   }
 };
 
+// ELFs in use by this process keyed by hash of their content.  An
+// ELF constructed with the same content as one in use shares the
+// existing implementation and its parse results.  Entries are weak,
+// the cache does not extend the lifetime of an ELF.
+static std::mutex s_elfs_mutex;
+static std::multimap<size_t, std::weak_ptr<elf_impl>> s_elfs;
+
+static std::shared_ptr<elf_impl>
+share_elf(std::shared_ptr<elf_impl> elf)
+{
+  auto raw = elf->get_raw();
+  auto key = std::hash<std::string_view>{}(raw);
+
+  std::lock_guard lk(s_elfs_mutex);
+  auto range = s_elfs.equal_range(key);
+  for (auto itr = range.first; itr != range.second; ++itr) {
+    auto cached = itr->second.lock();
+    if (!cached)
+      continue;
+
+    // Hash collision is possible, compare the full content
+    if (cached->get_raw() == raw)
+      return cached;
+  }
+
+  for (auto itr = s_elfs.begin(); itr != s_elfs.end();)
+    itr = itr->second.expired() ? s_elfs.erase(itr) : std::next(itr);
+
+  s_elfs.emplace(key, elf);
+  return elf;
+}
+
+static std::shared_ptr<elf_impl>
+get_elf(const std::string& fnm)
+{
+  return share_elf(std::make_shared<elf_impl>(fnm));
+}
+
+static std::shared_ptr<elf_impl>
+get_elf(std::istream& stream)
+{
+  return share_elf(std::make_shared<elf_impl>(read_stream(stream)));
+}
+
 } // namespace xrt
 
 ////////////////////////////////////////////////////////////////
@@ -79,6 +265,12 @@ get_elfio(const xrt::elf& elf)
   return elf.get_handle()->get_elfio();
 }
 
+std::unique_lock<std::mutex>
+lock(const xrt::elf& elf)
+{
+  return elf.get_handle()->get_lock();
+}
+
 } // xrt_core::elf_int
 
 ////////////////////////////////////////////////////////////////
@@ -88,12 +280,12 @@ namespace xrt {
 
 elf::
 elf(const std::string& fnm)
-  : detail::pimpl<elf_impl>{std::make_shared<elf_impl>(fnm)}
+  : detail::pimpl<elf_impl>{get_elf(fnm)}
 {}
 
 elf::
 elf(std::istream& stream)
-  : detail::pimpl<elf_impl>{std::make_shared<elf_impl>(stream)}
+  : detail::pimpl<elf_impl>{get_elf(stream)}
 {}
 
 xrt::uuid
@@ -8,15 +8,24 @@
 #define XRT_CORE_COMMON_SOURCE // in same dll as coreutil
 #include "core/include/xrt/xrt_hw_context.h"
 #include "hw_context_int.h"
+#include "kernel_int.h"
 
+#include "core/common/config_reader.h"
 #include "core/common/device.h"
+#include "core/common/message.h"
 #include "core/common/trace.h"
 #include "core/common/shim/hwctx_handle.h"
 #include "core/common/usage_metrics.h"
 #include "core/common/xdp/profile.h"
 
+#include <algorithm>
+#include <chrono>
 #include <limits>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
 
 namespace xrt {
 
@@ -35,6 +44,17 @@ class hw_context_impl : public std::enable_shared_from_this<hw_context_impl>
   std::unique_ptr<xrt_core::hwctx_handle> m_hdl;
   std::shared_ptr<xrt_core::usage_metrics::base_logger> m_usage_logger =
       xrt_core::usage_metrics::get_usage_metrics_logger();
+  std::shared_ptr<void> m_exec_bufs; // prefilled command BOs (optional)
+  std::shared_ptr<void> m_cu_contexts; // pre-opened CU contexts (optional)
+
+  // Prefill device command BO slab per xrt.ini so that command
+  // BOs are not allocated through the driver on the hot path
+  void
+  prefill_exec_bufs()
+  {
+    if (auto count = xrt_core::config::get_exec_bo_prefill())
+      m_exec_bufs = xrt_core::kernel_int::prefill_exec_bufs(m_core_device, count);
+  }
 
 public:
   hw_context_impl(std::shared_ptr<xrt_core::device> device, const xrt::uuid& xclbin_id, cfg_param_type cfg_param)
@@ -44,6 +64,7 @@ public:
     , m_mode(xrt::hw_context::access_mode::shared)
     , m_hdl{m_core_device->create_hw_context(xclbin_id, m_cfg_param, m_mode)}
   {
+    prefill_exec_bufs();
   }
 
   hw_context_impl(std::shared_ptr<xrt_core::device> device, const xrt::uuid& xclbin_id, access_mode mode)
@@ -51,7 +72,9 @@ public:
     , m_xclbin{m_core_device->get_xclbin(xclbin_id)}
     , m_mode{mode}
     , m_hdl{m_core_device->create_hw_context(xclbin_id, m_cfg_param, m_mode)}
-  {}
+  {
+    prefill_exec_bufs();
+  }
 
   std::shared_ptr<hw_context_impl>
   get_shared_ptr()
@@ -59,6 +82,16 @@ public:
     return shared_from_this();
   }
 
+  // Open all CU contexts per xrt.ini so that kernel construction
+  // does not open CU contexts through the driver.  Must be called
+  // after construction of the shared implementation.
+  void
+  open_cu_contexts()
+  {
+    if (xrt_core::config::get_hw_context_open_cus())
+      m_cu_contexts = xrt_core::kernel_int::open_cu_contexts(xrt::hw_context{get_shared_ptr()});
+  }
+
   ~hw_context_impl()
   {
     // This trace point measures the time to tear down a hw context on the device
@@ -71,6 +104,9 @@ public:
     // which is not true at that time.
     xrt_core::xdp::finish_flush_device(this);
 
+    // CU contexts must be closed before the context is destroyed
+    m_cu_contexts.reset();
+
     // Reset within scope of dtor for trace point to measure time to reset
     m_hdl.reset(); 
   }
@@ -100,6 +136,12 @@ public:
     return m_core_device;
   }
 
+  const cfg_param_type&
+  get_cfg_param() const
+  {
+    return m_cfg_param;
+  }
+
   xrt::uuid
   get_uuid() const
   {
@@ -173,11 +215,134 @@ create_hw_context_from_implementation(void* hwctx_impl)
 ////////////////////////////////////////////////////////////////
 namespace xrt {
 
+// class hw_context_cache - Released hardware contexts kept for reuse
+//
+// Creating a hardware context configures the device for the xclbin,
+// which dominates when an application time-multiplexes models by
+// creating and destroying contexts.  With Runtime.hw_context_cache_size
+// set, a released context is kept with its configuration, opened CU
+// contexts, and command buffers, and handed out again when a context
+// with same device, xclbin, configuration, and access mode is created.
+// The least recently released context is destroyed when the cache is
+// full.
+class hw_context_cache
+{
+  using key_type = std::tuple<const xrt_core::device*, xrt::uuid,
+                              xrt::hw_context::cfg_param_type, xrt::hw_context::access_mode>;
+  using entry_type = std::pair<key_type, std::unique_ptr<hw_context_impl>>;
+
+  std::mutex m_mutex;
+  std::list<entry_type> m_released;  // most recently released first
+  size_t m_size = xrt_core::config::get_hw_context_cache_size();
+  static inline bool s_alive = false;
+
+  static key_type
+  get_key(const hw_context_impl* impl)
+  {
+    return {impl->get_core_device().get(), impl->get_uuid(), impl->get_cfg_param(), impl->get_mode()};
+  }
+
+  // Deleter of shared context implementations
+  static void
+  release(hw_context_impl* impl)
+  {
+    if (!s_alive || !instance().m_size)
+      delete impl;  // NOLINT owned by shared_ptr with this deleter
+    else
+      instance().insert(std::unique_ptr<hw_context_impl>(impl));
+  }
+
+  void
+  insert(std::unique_ptr<hw_context_impl> impl)
+  {
+    std::unique_ptr<hw_context_impl> evicted;
+    std::lock_guard lk(m_mutex);
+    auto key = get_key(impl.get());
+    m_released.emplace_front(std::move(key), std::move(impl));
+    if (m_released.size() > m_size) {
+      evicted = std::move(m_released.back().second);
+      m_released.pop_back();
+    }
+  }
+
+  hw_context_cache()
+  {
+    s_alive = true;
+  }
+
+  ~hw_context_cache()
+  {
+    s_alive = false;
+  }
+
+public:
+  hw_context_cache(const hw_context_cache&) = delete;
+  hw_context_cache(hw_context_cache&&) = delete;
+  hw_context_cache& operator=(const hw_context_cache&) = delete;
+  hw_context_cache& operator=(hw_context_cache&&) = delete;
+
+  static hw_context_cache&
+  instance()
+  {
+    static hw_context_cache cache;
+    return cache;
+  }
+
+  // Reuse a released context or create a new context.  Sets hit
+  // if the context was reused.
+  template <typename ModeOrCfg>
+  std::shared_ptr<hw_context_impl>
+  acquire(const xrt::device& device, const xrt::uuid& xclbin_id, const ModeOrCfg& arg, bool& hit)
+  {
+    hit = false;
+    if (m_size) {
+      std::lock_guard lk(m_mutex);
+      auto match = [&device, &xclbin_id, &arg](const entry_type& entry) {
+        auto& [dev, uuid, cfg, mode] = entry.first;
+        if (dev != device.get_handle().get() || uuid != xclbin_id)
+          return false;
+        if constexpr (std::is_same_v<ModeOrCfg, xrt::hw_context::access_mode>)
+          return cfg.empty() && mode == arg;
+        else
+          return cfg == arg && mode == xrt::hw_context::access_mode::shared;
+      };
+      auto itr = std::find_if(m_released.begin(), m_released.end(), match);
+      if (itr != m_released.end()) {
+        auto impl = std::move(itr->second);
+        m_released.erase(itr);
+        hit = true;
+        return {impl.release(), &hw_context_cache::release};
+      }
+    }
+
+    return {new hw_context_impl(device.get_handle(), xclbin_id, arg), &hw_context_cache::release};
+  }
+};
+
+// Log time to create or reuse a hardware context
+static void
+log_hwctx_switch(const xrt::uuid& xclbin_id, bool hit, std::chrono::steady_clock::time_point start)
+{
+  if (!xrt_core::config::get_verbosity())
+    return;
+
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT",
+                          "hw_context for xclbin " + xclbin_id.to_string() + (hit ? " reused" : " created")
+                          + " in " + std::to_string(us) + " us");
+}
+
 static std::shared_ptr<hw_context_impl>
 alloc_hwctx_from_cfg(const xrt::device& device, const xrt::uuid& xclbin_id, const xrt::hw_context::cfg_param_type& cfg_param)
 {
   XRT_TRACE_POINT_SCOPE(xrt_hw_context);
-  auto handle = std::make_shared<hw_context_impl>(device.get_handle(), xclbin_id, cfg_param);
+  auto start = std::chrono::steady_clock::now();
+  bool hit = false;
+  auto handle = hw_context_cache::instance().acquire(device, xclbin_id, cfg_param, hit);
+  if (hit) {
+    log_hwctx_switch(xclbin_id, hit, start);
+    return handle;
+  }
 
   // Update device is called with a raw pointer to dyanamically
   // link to callbacks that exist in XDP via a C-style interface
@@ -186,7 +351,9 @@ alloc_hwctx_from_cfg(const xrt::device& device, const xrt::uuid& xclbin_id, cons
   xrt_core::xdp::update_device(handle.get());
 
   handle->get_usage_logger()->log_hw_ctx_info(handle.get());
+  handle->open_cu_contexts();
 
+  log_hwctx_switch(xclbin_id, hit, start);
   return handle;
 }
 
@@ -194,7 +361,13 @@ static std::shared_ptr<hw_context_impl>
 alloc_hwctx_from_mode(const xrt::device& device, const xrt::uuid& xclbin_id, xrt::hw_context::access_mode mode)
 {
   XRT_TRACE_POINT_SCOPE(xrt_hw_context);
-  auto handle = std::make_shared<hw_context_impl>(device.get_handle(), xclbin_id, mode);
+  auto start = std::chrono::steady_clock::now();
+  bool hit = false;
+  auto handle = hw_context_cache::instance().acquire(device, xclbin_id, mode, hit);
+  if (hit) {
+    log_hwctx_switch(xclbin_id, hit, start);
+    return handle;
+  }
 
   // Update device is called with a raw pointer to dyanamically
   // link to callbacks that exist in XDP via a C-style interface
@@ -203,7 +376,9 @@ alloc_hwctx_from_mode(const xrt::device& device, const xrt::uuid& xclbin_id, xrt
   xrt_core::xdp::update_device(handle.get());
 
   handle->get_usage_logger()->log_hw_ctx_info(handle.get());
+  handle->open_cu_contexts();
 
+  log_hwctx_switch(xclbin_id, hit, start);
   return handle;
 }
 
@@ -253,6 +428,13 @@ get_mode() const
   return get_handle()->get_mode();
 }
 
+int
+hw_context::
+get_completion_fd() const
+{
+  return get_handle()->get_core_device()->get_completion_fd();
+}
+
 hw_context::
 operator xrt_core::hwctx_handle* () const
 {
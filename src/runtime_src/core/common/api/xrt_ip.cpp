@@ -24,6 +24,7 @@
 #include <cstring>
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #ifdef _WIN32
@@ -207,6 +208,18 @@ class ip_impl
       return m_size;
     }
 
+    [[nodiscard]] bool
+    is_exclusive() const
+    {
+      return m_hwctx.get_mode() == xrt::hw_context::access_mode::exclusive;
+    }
+
+    [[nodiscard]] bool
+    has_read_range() const
+    {
+      return m_readrange.second != 0;
+    }
+
     void
     set_read_range(uint32_t start, uint32_t size)
     {
@@ -215,6 +228,16 @@ class ip_impl
     }
   };
 
+  void
+  check_range_or_error(size_t offset, size_t count) const
+  {
+    if (offset % sizeof(uint32_t))
+      throw std::out_of_range("Register offset must be 32-bit aligned");
+
+    if ((offset + count * sizeof(uint32_t)) > m_ipctx.get_size())
+      throw std::out_of_range("Cannot read or write outside ip register space");
+  }
+
   [[nodiscard]] unsigned int
   get_cuidx_or_error(size_t offset) const
   {
@@ -237,6 +260,10 @@ private:
   ip_context m_ipctx;
   uint32_t m_uid;                                  // internal unique id for debug
 
+  // Register space mapped into host address space, owned by the shim
+  std::mutex m_map_mutex;
+  volatile uint32_t* m_regs = nullptr;
+
 public:
   // ip_impl - constructor
   //
@@ -291,6 +318,66 @@ public:
       m_device->xwrite(XCL_ADDR_KERNEL_CTRL, m_ipctx.get_address() + offset, &data, 4);
   }
 
+  // Map register space for direct access.  Only an IP opened in an
+  // exclusive context can be mapped, there is no arbitration of
+  // accesses through the mapping.
+  volatile uint32_t*
+  map_registers()
+  {
+    std::lock_guard lk(m_map_mutex);
+    if (m_regs)
+      return m_regs;
+
+    if (!m_ipctx.is_exclusive())
+      throw xrt_core::error(EPERM, "IP registers can be mapped only with exclusive access");
+
+    if (m_ipctx.has_read_range())
+      throw xrt_core::error(EPERM, "IP registers with a read range cannot be mapped");
+
+    if (!has_reg_read_write())
+      throw xrt_core::error(std::errc::not_supported, "IP register mapping is not supported");
+
+    size_t size = 0;
+    auto regs = m_device->map_cu_registers(m_ipctx.get_idx(), size);
+    if (size < m_ipctx.get_size())
+      throw xrt_core::error(EINVAL, "Mapped IP register space is smaller than IP address range");
+
+    m_regs = regs;
+    return m_regs;
+  }
+
+  // Registers are read and written word by word, AXI-Lite register
+  // space does not support wider or burst accesses
+  void
+  read_registers(uint32_t offset, uint32_t* data, size_t count) const
+  {
+    check_range_or_error(offset, count);
+    if (auto regs = m_regs) {
+      auto src = regs + offset / sizeof(uint32_t);
+      for (size_t i = 0; i < count; ++i)
+        data[i] = src[i];
+      return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+      data[i] = read_register(offset + static_cast<uint32_t>(i * sizeof(uint32_t)));
+  }
+
+  void
+  write_registers(uint32_t offset, const uint32_t* data, size_t count)
+  {
+    check_range_or_error(offset, count);
+    if (auto regs = m_regs) {
+      auto dst = regs + offset / sizeof(uint32_t);
+      for (size_t i = 0; i < count; ++i)
+        dst[i] = data[i];
+      return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+      write_register(offset + static_cast<uint32_t>(i * sizeof(uint32_t)), data[i]);
+  }
+
   std::shared_ptr<ip::interrupt_impl>
   get_interrupt()
   {
@@ -360,6 +447,33 @@ read_register(uint32_t offset) const
   }) ;
 }
 
+volatile uint32_t*
+ip::
+map_registers()
+{
+  return xdp::native::profiling_wrapper("xrt::ip::map_registers", [this] {
+    return handle->map_registers();
+  }) ;
+}
+
+void
+ip::
+write_registers(uint32_t offset, const uint32_t* data, size_t count)
+{
+  xdp::native::profiling_wrapper("xrt::ip::write_registers", [this, offset, data, count] {
+    handle->write_registers(offset, data, count);
+  }) ;
+}
+
+void
+ip::
+read_registers(uint32_t offset, uint32_t* data, size_t count) const
+{
+  xdp::native::profiling_wrapper("xrt::ip::read_registers", [this, offset, data, count] {
+    handle->read_registers(offset, data, count);
+  }) ;
+}
+
 xrt::ip::interrupt
 ip::
 create_interrupt_notify()
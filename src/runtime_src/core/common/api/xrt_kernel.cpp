@@ -41,7 +41,12 @@
 #include "core/common/debug.h"
 #include "core/common/error.h"
 #include "core/common/message.h"
+#include "core/common/pipeline_trace.h"
+#include "core/common/query_requests.h"
 #include "core/common/system.h"
+#include "core/common/task.h"
+#include "core/common/thread.h"
+#include "core/common/time.h"
 #include "core/common/trace.h"
 #include "core/common/usage_metrics.h"
 #include "core/common/xclbin_parser.h"
@@ -57,11 +62,15 @@
 #include <cstdarg>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <fstream>
+#include <thread>
 #include <type_traits>
 #include <utility>
 using namespace std::chrono_literals;
@@ -351,7 +360,7 @@ cu_access_mode(xrt::hw_context::access_mode mode)
 struct device_type
 {
   std::shared_ptr<xrt_core::device> core_device;
-  xrt_core::bo_cache exec_buffer_cache;
+  xrt_core::bo_slab exec_buffer_cache;  // device wide command BOs
   uint32_t uid; // internal unique id for debug
 
   static constexpr unsigned int cache_size = 128;
@@ -393,10 +402,17 @@ struct device_type
   device_type& operator=(device_type&&) = delete;
 
   template <typename CommandType>
-  xrt_core::bo_cache::cmd_bo<CommandType>
-  create_exec_buf()
+  xrt_core::bo_slab::cmd_bo<CommandType>
+  create_exec_buf(size_t size = xrt_core::bo_slab::min_size)
   {
-    return exec_buffer_cache.alloc<CommandType>();
+    return exec_buffer_cache.alloc<CommandType>(size);
+  }
+
+  template <typename CommandType>
+  void
+  release_exec_buf(xrt_core::bo_slab::cmd_bo<CommandType>&& execbuf, size_t size = xrt_core::bo_slab::min_size)
+  {
+    exec_buffer_cache.release(std::move(execbuf), size);
   }
 
   [[nodiscard]] xrt_core::device*
@@ -587,10 +603,43 @@ public:
     return ipctx;
   }
 
+  // open_all() - open contexts of all CUs of all kernels in hwctx
+  //
+  // The returned contexts are found by open() when kernels are
+  // constructed in hwctx, for as long as they are referenced.  CUs
+  // that fail to open are skipped, the error is reported if and when
+  // a kernel using the CU is constructed.
+  static std::vector<std::shared_ptr<ip_context>>
+  open_all(const xrt::hw_context& hwctx)
+  {
+    std::vector<std::shared_ptr<ip_context>> ipctxs;
+    auto xclbin = hwctx.get_xclbin();
+    if (!xclbin)
+      return ipctxs;
+
+    for (const auto& kernel : xclbin.get_kernels()) {
+      for (const auto& cu : kernel.get_cus()) {
+        try {
+          ipctxs.push_back(open(hwctx, cu));
+        }
+        catch (const std::exception& ex) {
+          XRT_DEBUGF("ip_context::open_all() skipping cu(%s): %s\n", cu.get_name().c_str(), ex.what());
+        }
+      }
+    }
+
+    return ipctxs;
+  }
+
   [[nodiscard]] access_mode
   get_access_mode() const
   {
-    return cu_access_mode(m_hwctx.get_mode());
+    // The hwctx is always alive when called from a kernel, which
+    // holds a reference to it
+    auto impl = m_hwctx.lock();
+    return impl
+      ? cu_access_mode(xrt::hw_context{impl}.get_mode())
+      : access_mode::shared;
   }
 
   // For symmetry
@@ -625,8 +674,7 @@ public:
   [[nodiscard]] slot_id
   get_slot() const
   {
-    auto hwctx_hdl = static_cast<xrt_core::hwctx_handle*>(m_hwctx);
-    return hwctx_hdl->get_slotidx();
+    return m_hwctx_hdl->get_slotidx();
   }
 
   // Check if arg is connected to specified memory bank
@@ -648,7 +696,7 @@ public:
   ~ip_context()
   {
     try {
-      xrt_core::context_mgr::close_context(m_hwctx, m_idx);
+      xrt_core::context_mgr::close_context(m_device, m_hwctx_hdl, m_idx);
     }
     catch (...) {
     }
@@ -663,16 +711,23 @@ public:
 
 private:
   // regular CU
-  ip_context(xrt::hw_context xhwctx, xrt::xclbin::ip xip)
-    : m_hwctx(std::move(xhwctx))
+  ip_context(const xrt::hw_context& hwctx, xrt::xclbin::ip xip)
+    : m_hwctx(hwctx.get_handle())
+    , m_device(xrt_core::hw_context_int::get_core_device_raw(hwctx))
+    , m_hwctx_hdl(static_cast<xrt_core::hwctx_handle*>(hwctx))
     , m_ip(std::move(xip))
-    , m_args(m_hwctx.get_xclbin(), m_ip)
-    , m_idx(xrt_core::context_mgr::open_context(m_hwctx, m_ip.get_name()))
+    , m_args(hwctx.get_xclbin(), m_ip)
+    , m_idx(xrt_core::context_mgr::open_context(hwctx, m_ip.get_name()))
     , m_address(m_ip.get_base_address())
     , m_size(m_ip.get_size())
   {}
 
-  xrt::hw_context m_hwctx;    // hw context in which IP is opened
+  // The hw context is not owned by the ip_context.  Kernels using
+  // the ip_context own the hw context, and contexts opened through
+  // open_all() are owned by the hw context itself.
+  std::weak_ptr<xrt::hw_context_impl> m_hwctx; // hw context in which IP is opened
+  xrt_core::device* m_device;                  // device of hw context
+  xrt_core::hwctx_handle* m_hwctx_hdl;         // shim handle of hw context
   xrt::xclbin::ip m_ip;       // the xclbin ip object
   connectivity m_args;        // argument memory connections
   xrt_core::cuidx_type m_idx; // cu domain and index
@@ -680,13 +735,208 @@ private:
   size_t m_size;              // cache address space size
 };
 
+// class adaptive_wait - Bounded spin before blocking in exec_wait
+//
+// @m_name: Name of kernel for which statistics are collected
+// @m_ewma_ns: Moving average of observed completion times
+// @m_hits: Number of waits satisfied while spinning
+// @m_misses: Number of waits that fell back to exec_wait
+//
+// Kernels that complete in a few micro seconds pay an exec_wait
+// wakeup latency that can exceed the kernel execution time itself.
+// When enabled through xrt.ini Runtime.adaptive_wait, an unmanaged
+// wait first spins on the command packet state.  The spin is bounded
+// by the moving average of recent completion times of the kernel,
+// kernels averaging above Runtime.adaptive_wait_max_us are never
+// spun on.
+//
+// An adaptive_wait object is shared by all run objects of a kernel.
+// Updates are relaxed, lost updates due to concurrent waits only
+// affect the accuracy of the average.
+class adaptive_wait
+{
+  static constexpr unsigned int ewma_shift = 3; // weight 1/8 to new sample
+
+  std::string m_name;
+  std::atomic<uint64_t> m_ewma_ns {0};
+  std::atomic<uint64_t> m_hits {0};
+  std::atomic<uint64_t> m_misses {0};
+
+  static uint64_t
+  max_budget_ns()
+  {
+    static uint64_t max = static_cast<uint64_t>(xrt_core::config::get_adaptive_wait_max_us()) * 1000;
+    return max;
+  }
+
+  void
+  record(std::chrono::nanoseconds elapsed)
+  {
+    auto sample = static_cast<uint64_t>(elapsed.count());
+    auto ewma = m_ewma_ns.load(std::memory_order_relaxed);
+    ewma = ewma
+      ? ewma - (ewma >> ewma_shift) + (sample >> ewma_shift)
+      : sample;
+    m_ewma_ns.store(ewma, std::memory_order_relaxed);
+  }
+
+public:
+  explicit
+  adaptive_wait(std::string name)
+    : m_name(std::move(name))
+  {}
+
+  // Current spin budget measured from command start.  Spin slightly
+  // past the expected completion time to absorb jitter.
+  std::chrono::nanoseconds
+  budget() const
+  {
+    auto ewma = m_ewma_ns.load(std::memory_order_relaxed);
+    auto budget = ewma + (ewma >> 1);
+    return std::chrono::nanoseconds(budget <= max_budget_ns() ? budget : 0);
+  }
+
+  void
+  hit(std::chrono::nanoseconds elapsed)
+  {
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    record(elapsed);
+  }
+
+  void
+  miss(std::chrono::nanoseconds elapsed)
+  {
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    record(elapsed);
+  }
+
+  xrt_core::query::run_wait_stats::data
+  get_stats() const
+  {
+    return {m_name
+          , m_ewma_ns.load(std::memory_order_relaxed)
+          , static_cast<uint64_t>(budget().count())
+          , m_hits.load(std::memory_order_relaxed)
+          , m_misses.load(std::memory_order_relaxed)};
+  }
+};
+
+// Adaptive wait statistics per device for xrt_core::query
+// The registry holds weak references, expired entries are
+// pruned when new kernels are registered.
+class adaptive_wait_registry
+{
+  using wait_list = std::vector<std::weak_ptr<adaptive_wait>>;
+  std::mutex m_mutex;
+  std::map<const xrt_core::device*, wait_list> m_device_waits;
+
+public:
+  void
+  add(const xrt_core::device* device, const std::shared_ptr<adaptive_wait>& aw)
+  {
+    std::lock_guard lk(m_mutex);
+    auto& waits = m_device_waits[device];
+    waits.erase(std::remove_if(waits.begin(), waits.end(),
+                               [](const auto& w) { return w.expired(); }),
+                waits.end());
+    waits.push_back(aw);
+  }
+
+  xrt_core::query::run_wait_stats::result_type
+  get_stats(const xrt_core::device* device)
+  {
+    xrt_core::query::run_wait_stats::result_type stats;
+    std::lock_guard lk(m_mutex);
+    auto itr = m_device_waits.find(device);
+    if (itr == m_device_waits.end())
+      return stats;
+
+    for (const auto& w : itr->second)
+      if (auto aw = w.lock())
+        stats.push_back(aw->get_stats());
+
+    return stats;
+  }
+
+  static adaptive_wait_registry&
+  instance()
+  {
+    static adaptive_wait_registry registry;
+    return registry;
+  }
+};
+
+// class callback_dispatch - Worker threads for completion callbacks
+//
+// When xrt.ini Runtime.callback_threads is non zero, run object
+// completion callbacks are queued to a small process wide pool of
+// worker threads rather than executed by the thread that observed
+// the completion.  Callbacks of different commands may then execute
+// concurrently and in any order.
+class callback_dispatch
+{
+  xrt_core::task::queue m_queue;
+  std::vector<std::thread> m_workers;
+
+  explicit callback_dispatch(unsigned int threads)
+  {
+    for (unsigned int i = 0; i < threads; ++i)
+      m_workers.emplace_back(xrt_core::thread(xrt_core::task::worker, std::ref(m_queue)));
+  }
+
+public:
+  ~callback_dispatch()
+  {
+    m_queue.stop();
+    for (auto& worker : m_workers)
+      worker.join();
+  }
+
+  callback_dispatch(const callback_dispatch&) = delete;
+  callback_dispatch& operator=(const callback_dispatch&) = delete;
+
+  // Pool of worker threads or nullptr if callbacks are not dispatched
+  static callback_dispatch*
+  instance()
+  {
+    static auto threads = xrt_core::config::get_callback_threads();
+    if (!threads)
+      return nullptr;
+
+    static callback_dispatch pool(threads);
+    return &pool;
+  }
+
+  template <typename Callable>
+  void
+  enqueue(Callable&& fcn)
+  {
+    xrt_core::task::createF(m_queue, std::forward<Callable>(fcn));
+  }
+};
+
+// Encode cumask into num_cumasks command CU mask words
+static void
+encode_cumasks(uint32_t* masks, const std::bitset<max_cus>& cumask, size_t num_cumasks)
+{
+  std::fill(masks, masks + num_cumasks, 0);
+
+  for (size_t cu_idx = 0; cu_idx < max_cus; ++cu_idx) {
+    if (!cumask.test(cu_idx))
+      continue;
+    auto mask_idx = cu_idx / cus_per_word;
+    auto idx_in_mask = cu_idx - mask_idx * cus_per_word;
+    masks[mask_idx] |= (1 << idx_in_mask);
+  }
+}
+
 // class kernel_command - Immplements command API expected by schedulers
 //
 // The kernel command is
 class kernel_command : public xrt_core::command
 {
 public:
-  using execbuf_type = xrt_core::bo_cache::cmd_bo<ert_start_kernel_cmd>;
+  using execbuf_type = xrt_core::bo_slab::cmd_bo<ert_start_kernel_cmd>;
   using callback_function_type = std::function<void(ert_cmd_state)>;
   using callback_list = std::vector<callback_function_type>;
 
@@ -704,11 +954,13 @@ private:
 
 public:
   explicit
-  kernel_command(std::shared_ptr<device_type> dev, xrt_core::hw_queue hwqueue, xrt::hw_context hwctx = xrt::hw_context())
+  kernel_command(std::shared_ptr<device_type> dev, xrt_core::hw_queue hwqueue, xrt::hw_context hwctx = xrt::hw_context(),
+                 size_t execbuf_size = xrt_core::bo_slab::min_size)
     : m_device(std::move(dev))
     , m_hwqueue(std::move(hwqueue))
     , m_hwctx(std::move(hwctx))
-    , m_execbuf(m_device->create_exec_buf<ert_start_kernel_cmd>())
+    , m_execbuf_size(execbuf_size)
+    , m_execbuf(m_device->create_exec_buf<ert_start_kernel_cmd>(m_execbuf_size))
     , m_done(true)
   {
     static unsigned int count = 0;
@@ -719,8 +971,8 @@ public:
   ~kernel_command() override
   {
     XRT_DEBUGF("kernel_command::~kernel_command(%d)\n", m_uid);
-    // This is problematic, bo_cache should return managed BOs
-    m_device->exec_buffer_cache.release(std::move(m_execbuf));
+    // This is problematic, bo_slab should return managed BOs
+    m_device->release_exec_buf(std::move(m_execbuf), m_execbuf_size);
   }
 
   kernel_command(const kernel_command&) = delete;
@@ -732,15 +984,7 @@ public:
   encode_compute_units(const std::bitset<max_cus>& cumask, size_t num_cumasks)
   {
     auto ecmd = get_ert_cmd<ert_packet*>();
-    std::fill(ecmd->data, ecmd->data + num_cumasks, 0);
-
-    for (size_t cu_idx = 0; cu_idx < max_cus; ++cu_idx) {
-      if (!cumask.test(cu_idx))
-        continue;
-      auto mask_idx = cu_idx / cus_per_word;
-      auto idx_in_mask = cu_idx - mask_idx * cus_per_word;
-      ecmd->data[mask_idx] |= (1 << idx_in_mask);
-    }
+    encode_cumasks(ecmd->data, cumask, num_cumasks);
   }
 
   // Check if this kernel_command object is in done state
@@ -851,6 +1095,35 @@ public:
       (*cb)(state);
   }
 
+  // Run registered callbacks on the callback dispatch threads if
+  // enabled, the command is kept alive until the callbacks have run.
+  void
+  dispatch_callbacks(ert_cmd_state state) const
+  {
+    auto dispatch = callback_dispatch::instance();
+    if (!dispatch) {
+      run_callbacks(state);
+      return;
+    }
+
+    auto self = std::static_pointer_cast<const kernel_command>(shared_from_this());
+    dispatch->enqueue([self, state] { self->run_callbacks(state); });
+  }
+
+  // Enable adaptive spin wait for unmanaged execution
+  void
+  set_adaptive_wait(std::shared_ptr<adaptive_wait> aw)
+  {
+    m_adaptive_wait = std::move(aw);
+  }
+
+  // Trace executions of this command as specified pipeline stage
+  void
+  set_trace_stage(xrt_core::pipeline_trace::stage_id stage)
+  {
+    m_trace_stage = stage;
+  }
+
   // Submit the command for execution.
   void
   run()
@@ -862,10 +1135,58 @@ public:
       m_managed = (m_callbacks && !m_callbacks->empty());
       m_done = false;
     }
+
+    if (m_adaptive_wait)
+      m_start = std::chrono::steady_clock::now();
+
+    if (m_trace_stage != xrt_core::pipeline_trace::no_stage) {
+      m_trace_queued = 0;
+      m_trace_start = xrt_core::time_ns();
+    }
+
     if (m_managed)
       m_hwqueue.managed_start(this);
     else
       m_hwqueue.unmanaged_start(this);
+
+    if (m_trace_stage != xrt_core::pipeline_trace::no_stage)
+      m_trace_queued = xrt_core::time_ns();
+  }
+
+  // Spin on command state within the adaptive wait budget.
+  // Return true if command completed while spinning.
+  bool
+  spin_wait() const
+  {
+    if (!m_adaptive_wait)
+      return false;
+
+    auto budget = m_adaptive_wait->budget();
+    if (!budget.count())
+      return false;
+
+    auto deadline = m_start + budget;
+    auto now = m_start;
+    do {
+      m_hwqueue.poll(this);
+      auto state = get_state_raw();
+      now = std::chrono::steady_clock::now();
+      if (state >= ERT_CMD_STATE_COMPLETED) {
+        notify(state);
+        m_adaptive_wait->hit(now - m_start);
+        return true;
+      }
+    } while (now < deadline);
+
+    return false;
+  }
+
+  // Record completion time of a wait that was not satisfied by spinning
+  void
+  spin_miss() const
+  {
+    if (m_adaptive_wait)
+      m_adaptive_wait->miss(std::chrono::steady_clock::now() - m_start);
   }
 
   // Wait for command completion
@@ -877,8 +1198,9 @@ public:
       while (!m_done)
         m_exec_done.wait(lk);
     }
-    else {
+    else if (!spin_wait()) {
       m_hwqueue.wait(this);
+      spin_miss();
     }
 
     return get_state_raw(); // state wont change after wait
@@ -893,9 +1215,10 @@ public:
         if (m_exec_done.wait_for(lk, timeout_ms) == std::cv_status::timeout)
           return {get_state_raw(), std::cv_status::timeout};
     }
-    else {
+    else if (!spin_wait()) {
       if (m_hwqueue.wait(this, timeout_ms) == std::cv_status::timeout)
         return {get_state_raw(), std::cv_status::timeout};
+      spin_miss();
     }
 
     return {get_state_raw(), std::cv_status::no_timeout};
@@ -949,10 +1272,17 @@ public:
       callbacks = (m_callbacks && !m_callbacks->empty());
     }
 
+    if (complete && m_trace_stage != xrt_core::pipeline_trace::no_stage) {
+      // Command may complete before run() has returned from submission
+      auto end = xrt_core::time_ns();
+      auto queued = m_trace_queued.load();
+      xrt_core::pipeline_trace::record(m_trace_stage, m_trace_start, end, (queued ? queued : end) - m_trace_start);
+    }
+
     if (complete) {
       m_exec_done.notify_all();
       if (callbacks)
-        run_callbacks(s);
+        dispatch_callbacks(s);
     }
   }
 
@@ -965,10 +1295,20 @@ public:
     get_exec_bo()->bind_at(index, bh, off, sz);
   }
 
+  void
+  bind_arg_at_index(size_t index, const xrt::bo_view& view)
+  {
+    auto& bo = view.get_parent();
+    auto bh = xrt_core::bo_int::get_buffer_handle(bo);
+    auto off = xrt_core::bo_int::get_offset(bo) + view.offset();
+    get_exec_bo()->bind_at(index, bh, off, view.size());
+  }
+
 private:
   std::shared_ptr<device_type> m_device;
   xrt_core::hw_queue m_hwqueue;  // hwqueue for command submission
   xrt::hw_context m_hwctx;       // hw_context for command
+  size_t m_execbuf_size;         // requested size of execution buffer
   execbuf_type m_execbuf;        // underlying execution buffer
   unsigned int m_uid = 0;
   bool m_managed = false;
@@ -978,6 +1318,14 @@ private:
   mutable std::condition_variable m_exec_done;
 
   std::unique_ptr<callback_list> m_callbacks;
+
+  std::shared_ptr<adaptive_wait> m_adaptive_wait; // optional spin wait
+  std::chrono::steady_clock::time_point m_start;  // start time for spin wait
+
+  // pipeline trace of command executions
+  xrt_core::pipeline_trace::stage_id m_trace_stage = xrt_core::pipeline_trace::no_stage;
+  uint64_t m_trace_start = 0;                     // time_ns() of run()
+  std::atomic<uint64_t> m_trace_queued {0};       // time_ns() when submitted
 };
 
 // class argument - get argument value from va_arg
@@ -1271,6 +1619,10 @@ public:
   { return arg.type; }
 };
 
+// Device object shared by kernels and runlists, see definition
+static std::shared_ptr<device_type>
+get_device(const std::shared_ptr<xrt_core::device>& core_device);
+
 } // namespace
 
 namespace xrt {
@@ -1295,6 +1647,22 @@ public:
   using ipctx = std::shared_ptr<ip_context>;
   using ctxmgr_type = xrt_core::context_mgr::device_context_mgr;
 
+  // Compute units a run executes on
+  struct cu_set
+  {
+    std::vector<ipctx> ips;
+    std::bitset<max_cus> cumask;
+  };
+
+  // Immutable state shared by all runs of the kernel.  A run copies
+  // the command template into its own exec buffer and shares the CU
+  // set until it filters CUs.
+  struct run_template
+  {
+    cu_set cus;                        // all CUs of the kernel
+    std::vector<uint32_t> cmd;         // header, cu masks, fa descriptor header
+  };
+
 private:
   std::string name;                    // kernel name
   std::shared_ptr<device_type> device; // shared ownership
@@ -1316,9 +1684,20 @@ private:
   size_t num_cumasks = 1;              // Required number of command cu masks
   control_type protocol = control_type::none; // Default opcode
   uint32_t uid;                        // Internal unique id for debug
+  std::shared_ptr<adaptive_wait> m_adaptive_wait; // Adaptive wait stats shared by runs (optional)
   std::shared_ptr<xrt_core::usage_metrics::base_logger> m_usage_logger =
       xrt_core::usage_metrics::get_usage_metrics_logger();
 
+  // Hw context specific copies of m_module released by run objects.
+  // A new run reuses a released copy rather than allocating and
+  // filling new control code buffers.
+  std::mutex m_module_pool_mutex;
+  std::vector<xrt::module> m_module_pool;
+
+  // Created on first run, CU contexts are opened at construction
+  std::once_flag m_run_template_once;
+  std::shared_ptr<const run_template> m_run_template;
+
   // Open context of a specific compute unit.
   //
   // @cu:  compute unit to open
@@ -1576,6 +1955,12 @@ public:
     // amend args with computed data based on kernel protocol
     amend_args();
 
+    // adaptive wait stats shared by all runs of this kernel
+    if (xrt_core::config::get_adaptive_wait()) {
+      m_adaptive_wait = std::make_shared<adaptive_wait>(name);
+      adaptive_wait_registry::instance().add(device->core_device.get(), m_adaptive_wait);
+    }
+
     m_usage_logger->log_kernel_info(device->core_device.get(), hwctx, name, args.size());
   }
 
@@ -1624,20 +2009,43 @@ public:
     return properties.type;
   }
 
-  // Initialize kernel command and return pointer to payload
-  // after mandatory static data.
-  uint32_t*
-  initialize_command(kernel_command* cmd)
+  std::shared_ptr<const run_template>
+  create_run_template()
   {
-    auto kcmd = cmd->get_ert_cmd<ert_start_kernel_cmd*>();
+    auto tmpl = std::make_shared<run_template>();
+    tmpl->cus = {ipctxs, cumask};
+
+    // header word followed by cu masks
+    constexpr auto fadesc_words = sizeof(ert_fa_descriptor) / sizeof(uint32_t);
+    tmpl->cmd.resize(1 + num_cumasks + fadesc_words);
+    auto kcmd = reinterpret_cast<ert_start_kernel_cmd*>(tmpl->cmd.data());
     initialize_command_header(kcmd);
-    cmd->encode_compute_units(cumask, num_cumasks);
-    auto data = kcmd->data + kcmd->extra_cu_masks;
+    encode_cumasks(&kcmd->cu_mask, cumask, num_cumasks);
 
     if (kcmd->opcode == ERT_START_FA)
-      data = initialize_fadesc(data);
+      initialize_fadesc(kcmd->data + kcmd->extra_cu_masks);
+    else
+      tmpl->cmd.resize(1 + num_cumasks);
 
-    return data;
+    return tmpl;
+  }
+
+  const std::shared_ptr<const run_template>&
+  get_run_template()
+  {
+    std::call_once(m_run_template_once, [this] { m_run_template = create_run_template(); });
+    return m_run_template;
+  }
+
+  // Initialize kernel command from the command template and return
+  // pointer to payload after mandatory static data.
+  uint32_t*
+  initialize_command(kernel_command* cmd)
+  {
+    const auto& tmpl = get_run_template()->cmd;
+    auto kcmd = cmd->get_ert_cmd<ert_start_kernel_cmd*>();
+    std::copy(tmpl.begin(), tmpl.end(), reinterpret_cast<uint32_t*>(kcmd));
+    return kcmd->data + kcmd->extra_cu_masks;
   }
 
   std::string
@@ -1658,6 +2066,41 @@ public:
     return m_module;
   }
 
+  // Get a hw context specific copy of the kernel module for a run
+  xrt::module
+  acquire_module()
+  {
+    if (!m_module)
+      return {};
+
+    {
+      std::lock_guard lk(m_module_pool_mutex);
+      if (!m_module_pool.empty()) {
+        auto module = std::move(m_module_pool.back());
+        m_module_pool.pop_back();
+        return module;
+      }
+    }
+
+    return {m_module, hwctx};
+  }
+
+  // Return module copy no longer used by a run.  The control code is
+  // restored to its unpatched state before the copy is reused.
+  void
+  release_module(xrt::module&& module)
+  {
+    try {
+      xrt_core::module_int::reset(module);
+    }
+    catch (const std::exception&) {
+      return;
+    }
+
+    std::lock_guard lk(m_module_pool_mutex);
+    m_module_pool.push_back(std::move(module));
+  }
+
   const std::bitset<max_cus>&
   get_cumask() const
   {
@@ -1748,9 +2191,21 @@ public:
   }
 
   // Write 'count' 4 byte registers starting at offset
+  // Without register write support the block is written with one
+  // call so the shim can write it as a burst
   void
   write_register_n(uint32_t offset, size_t count, uint32_t* data)
   {
+    if (!count)
+      return;
+
+    if (!has_reg_read_write()) {
+      get_cuidx_or_error(offset);
+      get_cuidx_or_error(offset + (count - 1) * 4);
+      device->core_device->xwrite(XCL_ADDR_KERNEL_CTRL, ipctxs.back()->get_address() + offset, data, count * 4);
+      return;
+    }
+
     for (size_t n = 0; n < count; ++n)
       write_register(offset + n * 4, *(data + n));
   }
@@ -1779,6 +2234,12 @@ public:
     return hwqueue;
   }
 
+  const std::shared_ptr<adaptive_wait>&
+  get_adaptive_wait() const
+  {
+    return m_adaptive_wait;
+  }
+
   const std::vector<argument>&
   get_args() const
   {
@@ -1799,6 +2260,15 @@ public:
   {
     return regmap_size;
   }
+
+  // Size of execution buffer required for run objects of this kernel.
+  // The command packet holds the cu masks and the register map.
+  size_t
+  get_exec_buf_size() const
+  {
+    auto bytes = sizeof(ert_start_kernel_cmd) + (num_cumasks + regmap_size) * sizeof(uint32_t);
+    return std::max(xrt_core::bo_slab::min_size, bytes);
+  }
 };
 
 // struct run_impl - The internals of an xrtRunHandle
@@ -1842,8 +2312,14 @@ class run_impl
     void
     set_arg_value(const argument& arg, const xrt::bo& bo) override
     {
-      auto value = bo.address();
-      set_arg_value(arg, arg_range<uint8_t>{&value, sizeof(value)});
+      set_bo_value(arg, bo.address(), bo.size());
+    }
+
+    // Global argument value for buffer memory at address
+    virtual void
+    set_bo_value(const argument& arg, uint64_t address, size_t /*size*/)
+    {
+      set_arg_value(arg, arg_range<uint8_t>{&address, sizeof(address)});
     }
 
     virtual void
@@ -1926,9 +2402,9 @@ class run_impl
     {}
 
     void
-    set_arg_value(const argument& arg, const xrt::bo& bo) override
+    set_bo_value(const argument& arg, uint64_t address, size_t size) override
     {
-      uint64_t value[2] = {bo.address(), bo.size()}; // NOLINT
+      uint64_t value[2] = {address, size}; // NOLINT
       hs_arg_setter::set_arg_value(arg, arg_range<uint8_t>{value, sizeof(value)});
     }
   };
@@ -1940,15 +2416,16 @@ class run_impl
     return count++;
   }
 
-  // This function copies the module into a hw_context.  The module
-  // will be associated with hwctx specific memory.
-  static xrt::module
-  copy_module(const xrt::module& module, const xrt::hw_context& hwctx)
+  // Release the module of this run for reuse by another run of the
+  // kernel.  The module is shared with run objects cloned from this
+  // run, and it cannot be reused while a command may be executing.
+  void
+  release_module()
   {
-    if (!module)
-      return {};
+    if (!m_module || m_module.get_handle().use_count() != 1 || !cmd->is_done())
+      return;
 
-    return {module, hwctx};
+    kernel->release_module(std::move(m_module));
   }
 
   virtual std::unique_ptr<arg_setter>
@@ -1979,35 +2456,44 @@ class run_impl
     return asetter.get();
   }
 
+  // Keep the CUs of this run for which pred is true.  The CU set is
+  // shared with the kernel and other runs, so a filtered set is a
+  // new set owned by this run and its clones.  Returns false if no
+  // CUs are left, in which case the CUs are unchanged.
+  template <typename Predicate>
   bool
-  validate_ip_arg_connectivity(size_t argidx, int32_t grpidx)
+  filter_cus(Predicate pred)
   {
-    // remove ips that don't meet requested connectivity
-    auto itr = std::remove_if(ips.begin(), ips.end(),
-                   [argidx, grpidx] (const auto& ip) {
-                     return !ip->valid_connection(argidx, grpidx);
-                   });
+    auto cus = std::make_shared<kernel_impl::cu_set>();
+    for (const auto& ip : m_cus->ips) {
+      if (!pred(ip))
+        continue;
+      cus->ips.push_back(ip);
+      cus->cumask.set(ip->get_cuidx());
+    }
 
-    // if no ips are left then error
-    if (itr == ips.begin())
+    if (cus->ips.empty())
       return false;
 
     // no ips were removed
-    if (itr == ips.end())
+    if (cus->ips.size() == m_cus->ips.size())
       return true;
 
-    // update the cumask to set remaining cus, note that removed
-    // cus, while not erased, are no longer valid per move sematics
-    cumask.reset();
-    std::for_each(ips.begin(), itr, [this](const auto& ip) { cumask.set(ip->get_cuidx()); });
-
-    // erase the removed ips and mark that CUs must be
-    // encoded in command packet.
-    ips.erase(itr,ips.end());
+    // mark that CUs must be encoded in command packet
+    m_cus = std::move(cus);
     encode_cumasks = true;
     return true;
   }
 
+  bool
+  validate_ip_arg_connectivity(size_t argidx, int32_t grpidx)
+  {
+    // remove ips that don't meet requested connectivity
+    return filter_cus([argidx, grpidx] (const auto& ip) {
+      return ip->valid_connection(argidx, grpidx);
+    });
+  }
+
   xrt::bo
   validate_bo_at_index(size_t index, const xrt::bo& bo)
   {
@@ -2076,8 +2562,7 @@ class run_impl
   std::shared_ptr<kernel_impl> kernel;    // shared ownership
   xrt::module m_module;                   // instruction module (optional)
   xrt_core::hw_queue m_hwqueue;           // hw queue for command submission
-  std::vector<ipctx> ips;                 // ips controlled by this run object
-  std::bitset<max_cus> cumask;            // cumask for command execution
+  std::shared_ptr<const kernel_impl::cu_set> m_cus; // ips and cumask for command execution
   xrt_core::device* core_device;          // convenience, in scope of kernel
   std::shared_ptr<kernel_command> cmd;    // underlying command object
   uint32_t* data;                         // command argument data payload @0x0
@@ -2091,6 +2576,25 @@ class run_impl
   const runlist_impl* m_runlist = nullptr;// runlist that owns this run (optional)
   std::mutex m_mutex;                     // mutex synchronization
 
+  // One shot completion notification for start(fcn)
+  std::mutex m_completion_mutex;
+  callback_function_type m_completion;
+  bool m_completion_hooked = false;
+
+  void
+  notify_completion(ert_cmd_state state)
+  {
+    callback_function_type fcn;
+    {
+      std::lock_guard lk(m_completion_mutex);
+      fcn = std::move(m_completion);
+      m_completion = nullptr;
+    }
+
+    if (fcn)
+      fcn(state);
+  }
+
 public:
   [[nodiscard]] uint32_t
   get_uid() const
@@ -2125,17 +2629,19 @@ public:
   explicit
   run_impl(std::shared_ptr<kernel_impl> k)
     : kernel(std::move(k))
-    , m_module{copy_module(kernel->get_module(), kernel->get_hw_context())}
+    , m_module{kernel->acquire_module()}
     , m_hwqueue(kernel->get_hw_queue())
-    , ips(kernel->get_ips())
-    , cumask(kernel->get_cumask())
+    , m_cus(kernel->get_run_template(), &kernel->get_run_template()->cus)
     , core_device(kernel->get_core_device())
-    , cmd(std::make_shared<kernel_command>(kernel->get_device(), m_hwqueue, kernel->get_hw_context()))
+    , cmd(std::make_shared<kernel_command>(kernel->get_device(), m_hwqueue, kernel->get_hw_context(), kernel->get_exec_buf_size()))
     , data(initialize_command(cmd.get()))
     , m_header(0)
     , uid(create_uid())
   {
     XRT_DEBUGF("run_impl::run_impl(%d)\n" , uid);
+    cmd->set_adaptive_wait(kernel->get_adaptive_wait());
+    if (xrt_core::pipeline_trace::enabled())
+      cmd->set_trace_stage(xrt_core::pipeline_trace::get_stage(kernel->get_name()));
   }
 
   // Clones a run impl, so that the clone can be executed concurrently
@@ -2145,22 +2651,25 @@ public:
     : kernel(rhs->kernel)
     , m_module{rhs->m_module}
     , m_hwqueue(rhs->m_hwqueue)
-    , ips(rhs->ips)
-    , cumask(rhs->cumask)
+    , m_cus(rhs->m_cus)
     , core_device(rhs->core_device)
-    , cmd(std::make_shared<kernel_command>(kernel->get_device(), m_hwqueue, kernel->get_hw_context()))
+    , cmd(std::make_shared<kernel_command>(kernel->get_device(), m_hwqueue, kernel->get_hw_context(), kernel->get_exec_buf_size()))
     , data(clone_command_data(rhs))
     , m_header(rhs->m_header)
     , uid(create_uid())
     , encode_cumasks(rhs->encode_cumasks)
   {
     XRT_DEBUGF("run_impl::run_impl(%d)\n" , uid);
+    cmd->set_adaptive_wait(kernel->get_adaptive_wait());
+    if (xrt_core::pipeline_trace::enabled())
+      cmd->set_trace_stage(xrt_core::pipeline_trace::get_stage(kernel->get_name()));
   }
 
   virtual
   ~run_impl()
   {
     XRT_DEBUGF("run_impl::~run_impl(%d)\n" , uid);
+    release_module();
   }
 
   run_impl(const run_impl&) = delete;
@@ -2210,29 +2719,14 @@ public:
   void
   set_cus(const std::bitset<max_cus>& mask)
   {
-    auto itr = std::remove_if(ips.begin(), ips.end(),
-                              [&mask] (const auto& ip) {
-                                return !mask.test(ip->get_cuidx());
-                              });
-
-    if (itr == ips.begin())
+    if (!filter_cus([&mask] (const auto& ip) { return mask.test(ip->get_cuidx()); }))
       throw std::runtime_error("Specified No compute units left");
-
-    // update the cumask to set remaining cus, note that removed
-    // cus, while not erased, are no longer valid per move sematics
-    cumask.reset();
-    std::for_each(ips.begin(), itr, [this](const auto& ip) { cumask.set(ip->get_cuidx()); });
-
-    // erase the removed ips and mark that CUs must be
-    // encoded in command packet.
-    ips.erase(itr,ips.end());
-    encode_cumasks = true;
   }
 
   [[nodiscard]] const std::bitset<max_cus>&
   get_cumask() const
   {
-    return cumask;
+    return m_cus->cumask;
   }
 
   arg_range<uint8_t>
@@ -2292,6 +2786,23 @@ public:
     set_arg_value(arg, bo);
   }
 
+  // A view is set by address, no buffer object is created unless
+  // the parent must be copied to a connected bank or the argument
+  // must be patched into a module, which both require a buffer
+  void
+  set_arg_at_index(size_t index, const xrt::bo_view& view)
+  {
+    xcl_bo_flags grp {xrt_core::bo::group_id(view.get_parent())};
+    if (m_module || !validate_ip_arg_connectivity(index, grp.bank)) {
+      set_arg_at_index(index, xrt::bo{view.get_parent(), view.size(), view.offset()});
+      return;
+    }
+
+    auto& arg = kernel->get_arg(index);
+    get_arg_setter()->set_bo_value(arg, view.address(), view.size());
+    cmd->bind_arg_at_index(arg.index(), view);
+  }
+
   void
   set_arg_at_index(size_t index, std::va_list* args)
   {
@@ -2343,7 +2854,7 @@ public:
     if (!encode_cumasks)
       return;
 
-    cmd->encode_compute_units(cumask, kernel->get_num_cumasks());
+    cmd->encode_compute_units(m_cus->cumask, kernel->get_num_cumasks());
     encode_cumasks = false;
   }
 
@@ -2384,14 +2895,44 @@ public:
     // as much as possible, passing kernel impl pointer instead of 
     // constructing args in place
     // sending state as ERT_CMD_STATE_NEW for kernel start
-    m_usage_logger->log_kernel_run_info(kernel.get(), this, ERT_CMD_STATE_NEW);
+    if (xrt_core::usage_metrics::enabled())
+      m_usage_logger->log_kernel_run_info(kernel.get(), this, ERT_CMD_STATE_NEW);
     cmd->run();
   }
 
+  // start() - start the run and call fcn once when it completes
+  //
+  // The command callback that dispatches the notification is added
+  // on first use only, so repeated starts do not grow the command's
+  // callback list.  Adding the callback may call it immediately when
+  // the command is done, at which time no notification is pending.
+  void
+  start(callback_function_type&& fcn)
+  {
+    if (!m_completion_hooked) {
+      cmd->add_callback([this](ert_cmd_state state) { notify_completion(state); });
+      m_completion_hooked = true;
+    }
+
+    {
+      std::lock_guard lk(m_completion_mutex);
+      m_completion = std::move(fcn);
+    }
+
+    try {
+      start();
+    }
+    catch (...) {
+      std::lock_guard lk(m_completion_mutex);
+      m_completion = nullptr;
+      throw;
+    }
+  }
+
   void
   start(const autostart& iterations)
   {
-    if (cumask.count() > 1)
+    if (get_cumask().count() > 1)
       throw xrt_core::error(std::errc::value_too_large, "Only one compute unit allowed with auto restart");
 
     if (!kernel->get_auto_restart_counters())
@@ -2410,6 +2951,12 @@ public:
     m_hwqueue.submit_wait(fence);
   }
 
+  void
+  submit_wait(const std::vector<xrt::fence>& fences)
+  {
+    m_hwqueue.submit_wait(fences);
+  }
+
   void
   submit_signal(const xrt::fence& fence)
   {
@@ -2419,7 +2966,7 @@ public:
   void
   stop()
   {
-    if (cumask.count() > 1)
+    if (get_cumask().count() > 1)
       throw xrt_core::error(std::errc::value_too_large, "Only one compute unit allowed with auto restart");
 
     if (!kernel->get_auto_restart_counters())
@@ -2477,7 +3024,8 @@ public:
       state = cmd->wait();
     }
 
-    m_usage_logger->log_kernel_run_info(kernel.get(), this, state);
+    if (xrt_core::usage_metrics::enabled())
+      m_usage_logger->log_kernel_run_info(kernel.get(), this, state);
 
     return state;
   }
@@ -2503,7 +3051,8 @@ public:
     }
 
     if (state == ERT_CMD_STATE_COMPLETED) {
-      m_usage_logger->log_kernel_run_info(kernel.get(), this, state);
+      if (xrt_core::usage_metrics::enabled())
+        m_usage_logger->log_kernel_run_info(kernel.get(), this, state);
       return std::cv_status::no_timeout;
     }
 
@@ -2686,7 +3235,7 @@ public:
   mailbox_impl(const std::shared_ptr<kernel_impl>& k)
     : run_impl(k)
   {
-    if (cumask.count() > 1)
+    if (get_cumask().count() > 1)
       throw xrt_core::error(std::errc::value_too_large, "Only one compute unit allowed with mailbox");
     auto mtype = k->get_mailbox_type();
     m_readonly = (mtype == mailbox_type::out);
@@ -2904,20 +3453,34 @@ public:
 //
 // Execution of a runlist is carved into multiple
 // submissions of chained ert commands.  The size
-// of a chain is currently hardwired, but at some
-// point will be dyanmic.
+// of a chain is hardwired for regular kernel runs.
+// Runlists of module based (DPU/NPU) runs are
+// typically the layers of a model, where the cost
+// of each submission dominates, so such runlists
+// use chains as large as the ert packet allows and
+// are submitted as one command when they fit.
 class runlist_impl
 {
+  static constexpr size_t word_size = sizeof(uint32_t); // ert payload word size
   static constexpr size_t submit_size = 24;
+  static constexpr size_t max_packet_words = (1 << 11) - 1; // ert_packet::count is 11 bits
+  static constexpr size_t module_submit_size =
+    (max_packet_words - sizeof(ert_cmd_chain_data) / word_size) * word_size / sizeof(uint64_t);
   static constexpr size_t noidx = std::numeric_limits<size_t>::max();
   static constexpr size_t execbuf_size = sizeof(ert_packet) + sizeof(ert_cmd_chain_data) + submit_size * sizeof(uint64_t);
-  static constexpr size_t word_size = sizeof(uint32_t); // ert payload word size
+
+  static size_t
+  chain_execbuf_size(size_t count)
+  {
+    return sizeof(ert_packet) + sizeof(ert_cmd_chain_data) + count * sizeof(uint64_t);
+  }
 
   // The runlist creates its own execution buffers, which are
-  // ert_packets with payload interpreted as ert_cmd_chain_data
+  // ert_packets with payload interpreted as ert_cmd_chain_data.
+  // The buffers are allocated from the device wide command BO slab.
   using cmd_type = ert_packet;
-  using execbuf_type = xrt_core::bo_cache::cmd_bo<cmd_type>;
-  xrt_core::bo_cache_t<execbuf_size> m_exec_buffer_cache;
+  using execbuf_type = xrt_core::bo_slab::cmd_bo<cmd_type>;
+  std::shared_ptr<device_type> m_device;
 
   enum class state { idle, closed, running, error };
   mutable state m_state = state::idle;
@@ -2936,6 +3499,26 @@ class runlist_impl
   std::vector<execbuf_type> m_cmds;
   std::vector<execbuf_type*> m_submitted_cmds;
 
+  // Size of chains in m_cmds, chosen when the first run object is
+  // added to the list.  Streaming chains always use submit_size.
+  size_t m_submit_size = submit_size;
+
+  // Streaming execution.  Run objects appended to a streaming runlist
+  // are chained into m_stream; a chain is submitted when full or on
+  // flush while earlier chains are still executing.  Completed chains
+  // are retired from the front of the stream, their run objects are
+  // released and their execbufs are recycled for new chains.
+  struct stream_chain
+  {
+    execbuf_type execbuf;
+    size_t first;                // stream index of first run in chain
+    std::vector<xrt::run> runs;  // run objects in chain
+    bool submitted = false;
+  };
+  std::deque<stream_chain> m_stream;
+  std::vector<execbuf_type> m_free_chains;
+  size_t m_stream_end = 0;       // stream index of next appended run
+
   static const std::string&
   state_to_string(state st)
   {
@@ -2960,13 +3543,13 @@ class runlist_impl
     return unpack(*execbuf);
   }
 
-  // Execution buffers are cached and reused within this runlist
-  // This function creates or gets an execbuf from the cache
+  // Execution buffers are cached and reused by the device slab
+  // This function creates or gets an execbuf from the slab
   // and initializes the command in prep for add chained commands.
   execbuf_type
-  create_exec_buf()
+  create_exec_buf(size_t size = execbuf_size)
   {
-    auto execbuf = m_exec_buffer_cache.alloc<cmd_type>();
+    auto execbuf = m_device->create_exec_buf<cmd_type>(size);
     auto pkt = execbuf.second;
     pkt->opcode = ERT_CMD_CHAIN;
     pkt->count = sizeof(ert_cmd_chain_data) / word_size;  // payload size in words
@@ -2981,15 +3564,106 @@ class runlist_impl
   execbuf_type*
   get_cmd_chain_for_run_at_index(size_t runidx)
   {
-    auto idx = runidx / submit_size;
+    auto idx = runidx / m_submit_size;
     if (idx < m_cmds.size())
       return &m_cmds[idx];
 
-    m_cmds.push_back(create_exec_buf());
+    m_cmds.push_back(create_exec_buf(chain_execbuf_size(m_submit_size)));
     m_submitted_cmds.reserve(m_cmds.size());
     return &m_cmds.at(idx);
   }
 
+  // Return all chained command execbufs to the device slab
+  void
+  release_exec_bufs()
+  {
+    for (auto& execbuf : m_cmds)
+      m_device->release_exec_buf(std::move(execbuf), chain_execbuf_size(m_submit_size));
+    m_cmds.clear();
+
+    for (auto& chain : m_stream)
+      m_device->release_exec_buf(std::move(chain.execbuf), execbuf_size);
+    m_stream.clear();
+
+    for (auto& execbuf : m_free_chains)
+      m_device->release_exec_buf(std::move(execbuf), execbuf_size);
+    m_free_chains.clear();
+  }
+
+  // Get a chain command for streaming, recycled if possible
+  execbuf_type
+  get_stream_exec_buf()
+  {
+    if (m_free_chains.empty())
+      return create_exec_buf();
+
+    auto execbuf = std::move(m_free_chains.back());
+    m_free_chains.pop_back();
+    auto pkt = execbuf.second;
+    pkt->count = sizeof(ert_cmd_chain_data) / word_size;
+    std::memset(get_ert_cmd_chain_data(pkt), 0, sizeof(ert_cmd_chain_data));
+    return execbuf;
+  }
+
+  // Submit a stream chain that is not yet submitted
+  void
+  submit_stream_chain(stream_chain& chain)
+  {
+    for (auto& run : chain.runs)
+      run.get_handle()->prep_start();
+
+    auto [cmd, pkt] = unpack(chain.execbuf);
+    pkt->state = ERT_CMD_STATE_NEW;
+    m_hwqueue.submit(cmd); // can throw
+    chain.submitted = true;
+  }
+
+  // Check if a submitted stream chain has completed
+  bool
+  is_completed(const stream_chain& chain) const
+  {
+    auto [cmd, pkt] = unpack(chain.execbuf);
+    return m_hwqueue.poll(cmd) && pkt->state >= ERT_CMD_STATE_COMPLETED;
+  }
+
+  // Retire completed chains from the front of the stream.  Throw
+  // command error for the first failing run object of a retired chain.
+  // Remaining run objects of the failed chain are marked aborted.
+  void
+  retire_stream()
+  {
+    while (!m_stream.empty() && m_stream.front().submitted && is_completed(m_stream.front())) {
+      auto chain = std::move(m_stream.front());
+      m_stream.pop_front();
+
+      auto state = get_completed_state(&chain.execbuf, 1ms);
+      for (auto& run : chain.runs)
+        run.get_handle()->clear_runlist();
+      m_free_chains.push_back(std::move(chain.execbuf));
+
+      if (state == ERT_CMD_STATE_COMPLETED)
+        continue;
+
+      auto [cmd, pkt] = unpack(m_free_chains.back());
+      auto error_idx = get_ert_cmd_chain_data(pkt)->error_index;
+      for (auto idx = error_idx + 1; idx < chain.runs.size(); ++idx)
+        set_run_state(chain.runs[idx], ERT_CMD_STATE_ABORT);
+
+      auto run = chain.runs.at(error_idx);
+      set_run_state(run, state);
+      throw xrt::runlist::command_error(run, state, "runlist failed execution of run at index "
+                                        + std::to_string(chain.first + error_idx));
+    }
+  }
+
+  // Run objects of module based kernels execute control code
+  static bool
+  is_module_run(const xrt_core::command* cmd)
+  {
+    auto opcode = cmd->get_ert_packet()->opcode;
+    return opcode == ERT_START_DPU || opcode == ERT_START_NPU || opcode == ERT_START_NPU_PREEMPT;
+  }
+
   void
   set_run_state(const xrt::run& run, ert_cmd_state state) const
   {
@@ -3069,7 +3743,7 @@ class runlist_impl
     for (auto execbuf : m_submitted_cmds) {
       auto state = get_completed_state(execbuf, 1ms);
       if (state == ERT_CMD_STATE_COMPLETED) {
-        runidx += submit_size;
+        runidx += m_submit_size;
         continue;
       }
 
@@ -3130,7 +3804,7 @@ public:
 public:
   explicit
   runlist_impl(xrt::hw_context hwctx)
-    : m_exec_buffer_cache{hwctx.get_device().get_handle(), 128}
+    : m_device{get_device(xrt_core::hw_context_int::get_core_device(hwctx))}
     , m_hwctx{std::move(hwctx)}
     , m_hwqueue{m_hwctx}
   {}
@@ -3144,6 +3818,8 @@ public:
     catch (const std::exception& ex) {
       xrt_core::send_exception_message("runlist clear_runs error: " + std::string(ex.what()));
     }
+
+    release_exec_bufs();
   }
 
   void
@@ -3152,17 +3828,25 @@ public:
     if (m_state != state::idle)
       throw xrt_core::error("runlist must be idle before adding run objects, current state: " + state_to_string(m_state));
 
-    // Get the potentially throwing action out of the way first
+    if (m_stream_end)
+      throw xrt_core::error("streaming runlist must be reset before adding run objects");
+
+    auto run_impl = run.get_handle();
+    auto run_cmd = run_impl->get_cmd();
+
+    // The first run object determines the chain size.  A list of
+    // module based runs is chained into as few commands as possible.
     auto runidx = m_runlist.size();
+    if (!runidx)
+      m_submit_size = is_module_run(run_cmd) ? module_submit_size : submit_size;
+
+    // Get the potentially throwing action out of the way first
     m_runlist.reserve(runidx + 1);
     m_bos.reserve(runidx + 1);
 
     auto execbuf = get_cmd_chain_for_run_at_index(runidx);
     auto [cmd, pkt] = unpack(execbuf);
     auto chain_data = get_ert_cmd_chain_data(pkt);
-    
-    auto run_impl = run.get_handle();
-    auto run_cmd = run_impl->get_cmd();
     auto run_bo = run_cmd->get_exec_bo();
     auto run_bo_props = run_bo->get_properties();
 
@@ -3228,6 +3912,12 @@ public:
   std::cv_status
   wait_throw_on_error(const std::chrono::milliseconds& timeout)
   {
+    // Streaming runlist, wait for last run appended
+    if (!m_stream.empty()) {
+      flush();
+      return wait_stream(m_stream_end - 1, timeout);
+    }
+
     if (m_state != state::running)
       return std::cv_status::no_timeout;
 
@@ -3245,6 +3935,12 @@ public:
   int
   poll_or_throw_on_error()
   {
+    // Streaming runlist, poll retires completed chains
+    if (!m_stream.empty()) {
+      retire_stream();
+      return m_stream.empty() ? 1 : 0;
+    }
+
     if (m_state != state::running)
       return 1;
 
@@ -3256,6 +3952,77 @@ public:
     return 1;
   }
 
+  // Append run object to streaming runlist.  Return the stream index
+  // of the run object.
+  size_t
+  append(xrt::run run)
+  {
+    if (!m_runlist.empty() || m_state != state::idle)
+      throw xrt_core::error("runlist with added run objects cannot be used for streaming, current state: " + state_to_string(m_state));
+
+    // Recycle finished chains, which may release this run object
+    retire_stream();
+
+    if (m_stream.empty() || m_stream.back().submitted)
+      m_stream.push_back({get_stream_exec_buf(), m_stream_end, {}});
+
+    auto& chain = m_stream.back();
+    auto [cmd, pkt] = unpack(chain.execbuf);
+    auto chain_data = get_ert_cmd_chain_data(pkt);
+
+    auto run_impl = run.get_handle();
+    auto run_bo = run_impl->get_cmd()->get_exec_bo();
+    auto run_bo_props = run_bo->get_properties();
+    auto data_idx = chain_data->command_count;
+    chain_data->data[data_idx] = run_bo_props.kmhdl;
+    cmd->bind_at(data_idx, run_bo, 0, run_bo_props.size);
+    chain.runs.reserve(submit_size);
+    run_impl->set_runlist(this);  // throws if run is still in flight
+
+    chain_data->command_count++;
+    pkt->count += sizeof(uint64_t) / word_size;
+    chain.runs.push_back(std::move(run));
+
+    if (chain.runs.size() == submit_size)
+      submit_stream_chain(chain);
+
+    return m_stream_end++;
+  }
+
+  // Submit partially filled streaming chain if any
+  void
+  flush()
+  {
+    if (!m_stream.empty() && !m_stream.back().submitted)
+      submit_stream_chain(m_stream.back());
+  }
+
+  // Wait for streamed run object at @index to complete
+  std::cv_status
+  wait_stream(size_t index, const std::chrono::milliseconds& timeout)
+  {
+    if (index >= m_stream_end)
+      throw xrt_core::error(EINVAL, "runlist index " + std::to_string(index) + " has not been appended");
+
+    // Run at index belongs to a retired chain or the chain containing it
+    auto itr = std::find_if(m_stream.begin(), m_stream.end(),
+                            [index] (const auto& chain) { return index < chain.first + chain.runs.size(); });
+    if (itr == m_stream.end() || index < itr->first) {
+      retire_stream();
+      return std::cv_status::no_timeout;
+    }
+
+    if (!itr->submitted)
+      submit_stream_chain(*itr);
+
+    auto [cmd, pkt] = unpack(itr->execbuf);
+    if (m_hwqueue.wait(cmd, timeout) == std::cv_status::timeout)
+      return std::cv_status::timeout;
+
+    retire_stream();
+    return std::cv_status::no_timeout;
+  }
+
   void
   reset()
   {
@@ -3264,12 +4031,21 @@ public:
                             "Please use wait() to ensure that all commands have completed "
                             "before calling reset().");
 
+    if (std::any_of(m_stream.begin(), m_stream.end(), [](const auto& chain) { return chain.submitted; }))
+      throw xrt_core::error("The runlist has streamed commands executing and cannot be reset. "
+                            "Please use wait() to ensure that all commands have completed "
+                            "before calling reset().");
+
     clear_runs();
+    for (auto& chain : m_stream)
+      for (auto& run : chain.runs)
+        run.get_handle()->clear_runlist();
+    m_stream_end = 0;
 
     m_runlist.clear();
     m_bos.clear();
     m_submitted_cmds.clear();
-    m_cmds.clear();
+    release_exec_bufs();
     m_state = state::idle;
   }
 };
@@ -3288,6 +4064,255 @@ public:
   {}
 };
 
+// class run_template_impl - The internals of a run_template
+//
+// @m_run: Template run object, a clone of the user run object
+// @m_args: Arguments patched per instantiation
+// @m_pool: Instances that can be recycled when idle and released
+//
+// Instances are clones of the template run, the command packet is copied
+// from the template so encoding of the register map and initialization
+// of kernel specific command data is done once.  An instance is
+// recycled when the pool holds the only reference and the command is
+// done.  Since only template arguments are patched per instantiation,
+// a recycled instance is otherwise identical to the template.
+class run_template_impl
+{
+  struct instance
+  {
+    std::shared_ptr<run_impl> run;
+    std::vector<uint32_t> banks;  // memory bank of last validated bo per arg
+  };
+
+  static constexpr uint32_t no_bank = std::numeric_limits<uint32_t>::max();
+
+  std::shared_ptr<run_impl> m_run;
+  std::vector<const argument*> m_args;
+  std::vector<instance> m_pool;
+  std::mutex m_mutex;
+
+  instance&
+  get_instance()
+  {
+    for (auto& inst : m_pool)
+      if (inst.run.use_count() == 1 && inst.run->get_cmd()->is_done())
+        return inst;
+
+    m_pool.push_back({std::make_shared<run_impl>(m_run.get()), std::vector<uint32_t>(m_args.size(), no_bank)});
+    return m_pool.back();
+  }
+
+public:
+  run_template_impl(const xrt::run& run, const std::vector<int>& bo_indices)
+    : m_run(std::make_shared<run_impl>(run.get_handle().get()))
+  {
+    auto kernel = m_run->get_kernel();
+    for (auto idx : bo_indices) {
+      auto& arg = kernel->get_arg(idx);
+      if (arg.type() != xrt_core::xclbin::kernel_argument::argtype::global)
+        throw xrt_core::error(EINVAL, "Run template argument at index " + std::to_string(idx) + " is not a global buffer");
+      m_args.push_back(&arg);
+    }
+  }
+
+  xrt::run
+  instantiate(const xrt::bo* const* bos, size_t count)
+  {
+    if (count != m_args.size())
+      throw xrt_core::error(EINVAL, "Run template expects " + std::to_string(m_args.size())
+                            + " buffer arguments, got " + std::to_string(count));
+
+    std::lock_guard lk(m_mutex);
+    auto& inst = get_instance();
+    for (size_t i = 0; i < count; ++i) {
+      const auto& bo = *bos[i];
+      auto bank = static_cast<uint32_t>(xrt_core::bo::group_id(bo));
+      if (bank == inst.banks[i]) {
+        inst.run->set_arg_value(*m_args[i], bo);
+        continue;
+      }
+
+      // Different memory bank, validate connectivity
+      inst.run->set_arg_at_index(m_args[i]->index(), bo);
+      inst.banks[i] = bank;
+    }
+
+    return xrt::run{inst.run};
+  }
+};
+
+// class run_ring_impl - The internals of a run_ring
+//
+// Each run object in the ring has a completion callback that starts
+// the run object again as long as the ring is running.  All run
+// objects are started in ring order when the ring is started, after
+// which each completion restarts the completed run object, so
+// submission continues in ring order without involving the
+// application.
+class run_ring_impl
+{
+  std::vector<std::shared_ptr<run_impl>> m_runs;
+  std::vector<bool> m_inflight;     // run object started by ring
+
+  mutable std::mutex m_mutex;
+  mutable std::condition_variable m_work_done;
+  size_t m_limit = 0;               // total starts, 0 for unlimited
+  size_t m_submitted = 0;           // starts since ring was started
+  size_t m_completed = 0;           // completions since ring was started
+  bool m_stop = true;               // no more starts
+  std::exception_ptr m_error;       // first error since ring was started
+
+  bool
+  is_done() const
+  {
+    return m_completed == m_submitted;
+  }
+
+  void
+  fail(std::exception_ptr eptr)
+  {
+    if (!m_error)
+      m_error = std::move(eptr);
+    m_stop = true;
+  }
+
+  void
+  start_run(size_t idx)
+  {
+    try {
+      m_runs[idx]->start();
+    }
+    catch (...) {
+      std::lock_guard lk(m_mutex);
+      m_inflight[idx] = false;
+      --m_submitted;
+      fail(std::current_exception());
+      if (is_done())
+        m_work_done.notify_all();
+    }
+  }
+
+  void
+  on_complete(size_t idx, ert_cmd_state state)
+  {
+    {
+      std::lock_guard lk(m_mutex);
+
+      // Callback is also called when added to a completed run
+      // object, or when the run object is started outside the ring
+      if (!m_inflight[idx])
+        return;
+
+      ++m_completed;
+      if (state != ERT_CMD_STATE_COMPLETED)
+        fail(std::make_exception_ptr(xrt::run::command_error
+          (state, "run_ring failed execution of run at index " + std::to_string(idx))));
+
+      if (m_stop || (m_limit && m_submitted == m_limit)) {
+        m_inflight[idx] = false;
+        if (is_done())
+          m_work_done.notify_all();
+        return;
+      }
+
+      ++m_submitted;
+    }
+
+    start_run(idx);
+  }
+
+public:
+  explicit run_ring_impl(const std::vector<xrt::run>& runs)
+    : m_inflight(runs.size(), false)
+  {
+    if (runs.empty())
+      throw xrt_core::error(EINVAL, "run_ring requires at least one run object");
+
+    for (const auto& run : runs) {
+      auto hdl = run.get_handle();
+      if (!hdl->get_cmd()->is_done())
+        throw xrt_core::error(EBUSY, "run_ring run object is running");
+      if (std::find(m_runs.begin(), m_runs.end(), hdl) != m_runs.end())
+        throw xrt_core::error(EINVAL, "run_ring run object added more than once");
+      m_runs.push_back(std::move(hdl));
+    }
+
+    for (size_t idx = 0; idx < m_runs.size(); ++idx)
+      m_runs[idx]->add_callback([this, idx](ert_cmd_state state) { on_complete(idx, state); });
+  }
+
+  ~run_ring_impl()
+  {
+    stop();
+    {
+      std::unique_lock lk(m_mutex);
+      m_work_done.wait(lk, [this] { return is_done(); });
+    }
+
+    for (auto& run : m_runs)
+      run->pop_callback();
+  }
+
+  run_ring_impl(const run_ring_impl&) = delete;
+  run_ring_impl(run_ring_impl&&) = delete;
+  run_ring_impl& operator=(run_ring_impl&) = delete;
+  run_ring_impl& operator=(run_ring_impl&&) = delete;
+
+  void
+  start(size_t iterations)
+  {
+    size_t initial = m_runs.size();
+    {
+      std::lock_guard lk(m_mutex);
+      if (!is_done() || (!m_stop && !m_limit))
+        throw xrt_core::error(EBUSY, "run_ring is running");
+
+      if (iterations && iterations < initial)
+        initial = iterations;
+
+      m_limit = iterations;
+      m_submitted = initial;
+      m_completed = 0;
+      m_stop = false;
+      m_error = nullptr;
+      std::fill_n(m_inflight.begin(), initial, true);
+    }
+
+    for (size_t idx = 0; idx < initial; ++idx)
+      start_run(idx);
+  }
+
+  void
+  stop()
+  {
+    std::lock_guard lk(m_mutex);
+    m_stop = true;
+  }
+
+  std::cv_status
+  wait(const std::chrono::milliseconds& timeout) const
+  {
+    std::unique_lock lk(m_mutex);
+    auto pred = [this] { return is_done() && (m_stop || m_submitted == m_limit); };
+    if (!timeout.count())
+      m_work_done.wait(lk, pred);
+    else if (!m_work_done.wait_for(lk, timeout, pred))
+      return std::cv_status::timeout;
+
+    if (m_error)
+      std::rethrow_exception(m_error);
+
+    return std::cv_status::no_timeout;
+  }
+
+  size_t
+  completed() const
+  {
+    std::lock_guard lk(m_mutex);
+    return m_completed;
+  }
+};
+
 } // namespace xrt
 
 namespace {
@@ -3405,12 +4430,41 @@ alloc_kernel(const std::shared_ptr<device_type>& dev,
   return std::make_shared<xrt::kernel_impl>(dev, xrt::hw_context{dev->get_xrt_device(), xclbin_id, amode}, name);
 }
 
+// Kernels constructed from a hw_context.  A kernel_impl is immutable
+// once constructed, so kernel objects constructed for the same
+// context and same name, including any CU filter, share one
+// kernel_impl rather than each opening CU contexts and building
+// argument tables.  As with the device cache, std::weak_ptr is used
+// so the kernel_impl and its CU contexts are released with the last
+// kernel object.  The key address cannot be reused while an entry
+// is alive since the kernel_impl owns a copy of the hw_context.
+using kernel_cache_key = std::pair<const void*, std::string>;
+static std::map<kernel_cache_key, std::weak_ptr<xrt::kernel_impl>> ctx_kernels;
+static std::mutex ctx_kernels_mutex;
+
 static std::shared_ptr<xrt::kernel_impl>
 alloc_kernel_from_ctx(const std::shared_ptr<device_type>& dev,
                       const xrt::hw_context& hwctx,
                       const std::string& name)
 {
-  return std::make_shared<xrt::kernel_impl>(dev, hwctx, name);
+  kernel_cache_key key{hwctx.get_handle().get(), name};
+  std::lock_guard<std::mutex> lk(ctx_kernels_mutex);
+  auto& entry = ctx_kernels[key];
+  if (auto kernel = entry.lock())
+    return kernel;
+
+  // Purge expired entries so the cache does not grow with contexts
+  // that are gone
+  for (auto itr = ctx_kernels.begin(); itr != ctx_kernels.end();) {
+    if (itr->second.expired() && itr->first != key)
+      itr = ctx_kernels.erase(itr);
+    else
+      ++itr;
+  }
+
+  auto kernel = std::make_shared<xrt::kernel_impl>(dev, hwctx, name);
+  entry = kernel;
+  return kernel;
 }
 
 static std::shared_ptr<xrt::kernel_impl>
@@ -3644,6 +4698,26 @@ create_kernel_from_implementation(const xrt::kernel_impl* kernel_impl)
   return xrt::kernel(const_cast<xrt::kernel_impl*>(kernel_impl)->get_shared_ptr()); // NOLINT
 }
 
+std::shared_ptr<void>
+prefill_exec_bufs(const std::shared_ptr<xrt_core::device>& device, unsigned int count)
+{
+  auto dev = get_device(device);
+  dev->exec_buffer_cache.prefill(xrt_core::bo_slab::min_size, count);
+  return dev;
+}
+
+std::shared_ptr<void>
+open_cu_contexts(const xrt::hw_context& hwctx)
+{
+  return std::make_shared<std::vector<std::shared_ptr<ip_context>>>(ip_context::open_all(hwctx));
+}
+
+xrt_core::query::run_wait_stats::result_type
+get_run_wait_stats(const xrt_core::device* device)
+{
+  return adaptive_wait_registry::instance().get_stats(device);
+}
+
 } // xrt_core::kernel_int
 
 
@@ -3662,7 +4736,7 @@ void
 run::
 start()
 {
-  XRT_TRACE_POINT_SCOPE(xrt_run_start);
+  XRT_TRACE_POINT_SCOPE1(xrt_run_start, static_cast<const void*>(handle.get()));
   xdp::native::profiling_wrapper
     ("xrt::run::start", [this] {
       handle->start();
@@ -3676,6 +4750,17 @@ start(const autostart& iterations)
   handle->start(iterations);
 }
 
+void
+run::
+start(std::function<void(ert_cmd_state)> done)
+{
+  XRT_TRACE_POINT_SCOPE1(xrt_run_start, static_cast<const void*>(handle.get()));
+  xdp::native::profiling_wrapper
+    ("xrt::run::start", [this, &done] {
+      handle->start(std::move(done));
+    });
+}
+
 void
 run::
 stop()
@@ -3694,7 +4779,7 @@ ert_cmd_state
 run::
 wait(const std::chrono::milliseconds& timeout_ms) const
 {
-  XRT_TRACE_POINT_SCOPE(xrt_run_wait);
+  XRT_TRACE_POINT_SCOPE1(xrt_run_wait, static_cast<const void*>(handle.get()));
   return xdp::native::profiling_wrapper("xrt::run::wait",
     [this, &timeout_ms] {
       return handle->wait(timeout_ms);
@@ -3705,7 +4790,7 @@ std::cv_status
 run::
 wait2(const std::chrono::milliseconds& timeout_ms) const
 {
-  XRT_TRACE_POINT_SCOPE(xrt_run_wait2);
+  XRT_TRACE_POINT_SCOPE1(xrt_run_wait2, static_cast<const void*>(handle.get()));
   return xdp::native::profiling_wrapper("xrt::run::wait",
     [this, &timeout_ms] {
       return handle->wait_throw_on_error(timeout_ms);
@@ -3751,6 +4836,13 @@ set_arg_at_index(int index, const xrt::bo& glb)
   handle->set_arg_at_index(index, glb);
 }
 
+void
+run::
+set_arg_at_index(int index, const xrt::bo_view& view)
+{
+  handle->set_arg_at_index(index, view);
+}
+
 void
 run::
 update_arg_at_index(int index, const void* value, size_t bytes)
@@ -3804,6 +4896,16 @@ submit_wait(const xrt::fence& fence)
   });
 }
 
+void
+run::
+submit_wait(const std::vector<xrt::fence>& fences)
+{
+  XRT_TRACE_POINT_SCOPE(xrt_submit_wait);
+  return xdp::native::profiling_wrapper("xrt::run::submit_wait", [this, &fences]{
+    handle->submit_wait(fences);
+  });
+}
+
 void
 run::
 submit_signal(const xrt::fence& fence)
@@ -3967,6 +5069,84 @@ reset()
   handle->reset();
 }
 
+size_t
+runlist::
+append(const xrt::run& run)
+{
+  return handle->append(run);
+}
+
+void
+runlist::
+flush()
+{
+  handle->flush();
+}
+
+std::cv_status
+runlist::
+wait(size_t index, const std::chrono::milliseconds& timeout) const
+{
+  return handle->wait_stream(index, timeout);
+}
+
+run_template::
+run_template(const xrt::run& run, const std::vector<int>& bo_indices)
+  : detail::pimpl<run_template_impl>(xdp::native::profiling_wrapper
+    ("xrt::run_template::run_template", [&run, &bo_indices] {
+      return std::make_shared<run_template_impl>(run, bo_indices);
+    }))
+{}
+
+xrt::run
+run_template::
+instantiate(const xrt::bo* const* bos, size_t count)
+{
+  return xdp::native::profiling_wrapper("xrt::run_template::instantiate", [this, bos, count] {
+    return handle->instantiate(bos, count);
+  });
+}
+
+run_ring::
+run_ring(const std::vector<xrt::run>& runs)
+  : detail::pimpl<run_ring_impl>(xdp::native::profiling_wrapper
+    ("xrt::run_ring::run_ring", [&runs] {
+      return std::make_shared<run_ring_impl>(runs);
+    }))
+{}
+
+void
+run_ring::
+start(size_t iterations)
+{
+  xdp::native::profiling_wrapper("xrt::run_ring::start", [this, iterations] {
+    handle->start(iterations);
+  });
+}
+
+void
+run_ring::
+stop()
+{
+  handle->stop();
+}
+
+std::cv_status
+run_ring::
+wait(const std::chrono::milliseconds& timeout) const
+{
+  return xdp::native::profiling_wrapper("xrt::run_ring::wait", [this, &timeout] {
+    return handle->wait(timeout);
+  });
+}
+
+size_t
+run_ring::
+completed() const
+{
+  return handle->completed();
+}
+
 } // namespace xrt
 
 ////////////////////////////////////////////////////////////////
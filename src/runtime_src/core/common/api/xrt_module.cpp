@@ -22,6 +22,7 @@
 #include <elfio/elfio.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <numeric>
@@ -146,13 +147,17 @@ struct patcher
 
   std::vector<patch_info> m_ctrlcode_patchinfo;
 
+  // Max number of bytes modified at a patch offset by any of the
+  // patching schemes (patch57 modifies up to bd_data_ptr[8])
+  static constexpr size_t max_patch_size = 9 * sizeof(uint32_t);
+
   patcher(symbol_type type, std::vector<patch_info> ctrlcode_offset, buf_type t)
     : m_buf_type(t)
     , m_symbol_type(type)
     , m_ctrlcode_patchinfo(std::move(ctrlcode_offset))
   {}
 
-  void
+  static void
   patch32(uint32_t* bd_data_ptr, uint64_t patch)
   {
     uint64_t base_address = bd_data_ptr[0];
@@ -160,7 +165,7 @@ struct patcher
     bd_data_ptr[0] = (uint32_t)(base_address & 0xFFFFFFFF);                           // NOLINT
   }
 
-  void
+  static void
   patch57(uint32_t* bd_data_ptr, uint64_t patch)
   {
     uint64_t base_address =
@@ -174,7 +179,7 @@ struct patcher
     bd_data_ptr[8] = (bd_data_ptr[8] & 0xFFFFFE00) | ((base_address >> 48) & 0x1FF);  // NOLINT
   }
 
-  void
+  static void
   patch_ctrl48(uint32_t* bd_data_ptr, uint64_t patch)
   {
     // This patching scheme is originated from NPU firmware
@@ -189,7 +194,8 @@ struct patcher
     bd_data_ptr[3] = (bd_data_ptr[3] & 0xFFFF0000) | (base_address >> 32);            // NOLINT
   }
 
-  void patch_shim48(uint32_t* bd_data_ptr, uint64_t patch)
+  static void
+  patch_shim48(uint32_t* bd_data_ptr, uint64_t patch)
   {
     // This patching scheme is originated from NPU firmware
     constexpr uint64_t ddr_aie_addr_offset = 0x80000000;
@@ -204,7 +210,7 @@ struct patcher
   }
 
   void
-  patch(uint8_t* base, uint64_t bo_addr)
+  patch(uint8_t* base, uint64_t bo_addr) const
   {
     for (auto item : m_ctrlcode_patchinfo) {
       auto bd_data_ptr = reinterpret_cast<uint32_t*>(base + item.offset_to_patch_buffer);
@@ -249,6 +255,60 @@ struct patcher
     return argument_name + buf_string;
   }
 
+// class dirty_pages - pages of a buffer object modified since last sync
+//
+// Patching an argument modifies a few words of the control code.
+// Only the pages that were patched are synced to device, a run that
+// changes one argument syncs one page rather than the full control
+// code buffer.
+class dirty_pages
+{
+  static constexpr size_t page_size = 4096;
+  std::vector<bool> m_pages;
+  bool m_dirty = false;
+
+public:
+  void
+  mark(size_t offset, size_t size)
+  {
+    auto last = (offset + size - 1) / page_size;
+    if (last >= m_pages.size())
+      m_pages.resize(last + 1, false);
+
+    for (auto page = offset / page_size; page <= last; ++page)
+      m_pages[page] = true;
+
+    m_dirty = true;
+  }
+
+  // Sync each contiguous run of dirty pages to device
+  void
+  sync(xrt::bo& bo)
+  {
+    if (!m_dirty)
+      return;
+
+    auto bo_size = bo.size();
+    size_t page = 0;
+    while (page < m_pages.size()) {
+      if (!m_pages[page]) {
+        ++page;
+        continue;
+      }
+
+      auto first = page;
+      while (page < m_pages.size() && m_pages[page])
+        m_pages[page++] = false;
+
+      auto offset = first * page_size;
+      if (offset < bo_size)
+        bo.sync(XCL_BO_SYNC_BO_TO_DEVICE, std::min((page - first) * page_size, bo_size - offset), offset);
+    }
+
+    m_dirty = false;
+  }
+};
+
 } // namespace
 
 namespace xrt
@@ -397,6 +457,18 @@ public:
     throw std::runtime_error("Not supported");
   }
 
+  // Get the patcher for a symbol
+  //
+  // @param symbol - symbol name
+  // @param index - argument index, used if symbol name is not found
+  // @param buf_type - whether it is control-code, control-packet, preempt-save or preempt-restore
+  // @Return patcher for symbol, or nullptr if symbol is not patched in buf_type
+  [[nodiscard]] virtual const patcher*
+  get_patcher(const std::string&, size_t, patcher::buf_type) const
+  {
+    throw std::runtime_error("Not supported");
+  }
+
   // Get the number of patchers for arguments.  The returned
   // value is the number of arguments that must be patched before
   // the control code can be executed.
@@ -414,6 +486,14 @@ public:
     throw std::runtime_error("Not supported");
   }
 
+  // Restore control code to its state before any argument was
+  // patched, such that the module can be used by a new run.
+  virtual void
+  reset()
+  {
+    throw std::runtime_error("Not supported");
+  }
+
   // Get the ERT command opcode in ELF flow.
   virtual ert_cmd_opcode
   get_ert_opcode() const
@@ -752,8 +832,8 @@ class module_elf : public module_impl
     return arg2patcher;
   }
 
-  bool
-  patch(uint8_t* base, const std::string& argnm, size_t index, uint64_t patch, patcher::buf_type type) override
+  [[nodiscard]] const patcher*
+  get_patcher(const std::string& argnm, size_t index, patcher::buf_type type) const override
   {
     const std::string key_string = generate_key_string(argnm, type);
     auto it = m_arg2patcher.find(key_string);
@@ -763,10 +843,20 @@ class module_elf : public module_impl
       const std::string key_index_string = generate_key_string(index_string, type);
       it = m_arg2patcher.find(key_index_string);
       if (it == m_arg2patcher.end())
-        return false;
+        return nullptr;
     }
 
-    it->second.patch(base, patch);
+    return &it->second;
+  }
+
+  bool
+  patch(uint8_t* base, const std::string& argnm, size_t index, uint64_t patch, patcher::buf_type type) override
+  {
+    auto p = get_patcher(argnm, index, type);
+    if (!p)
+      return false;
+
+    p->patch(base, patch);
     return true;
   }
 
@@ -797,6 +887,8 @@ public:
     , m_elf(std::move(elf))
     , m_os_abi{ xrt_core::elf_int::get_elfio(m_elf).get_os_abi() }
   {
+    // Sections are loaded on first access from the shared ELF
+    auto lk = xrt_core::elf_int::lock(m_elf);
     if (m_os_abi == Elf_Amd_Aie2ps) {
       m_ctrlcodes = initialize_column_ctrlcode(xrt_core::elf_int::get_elfio(m_elf));
       m_arg2patcher = initialize_arg_patchers(xrt_core::elf_int::get_elfio(m_elf), m_ctrlcodes);
@@ -938,6 +1030,103 @@ class module_sram : public module_impl
   // buffer sync to device.
   bool m_dirty{ false };
 
+  // Pages patched since last sync, per buffer type
+  std::array<dirty_pages, static_cast<size_t>(patcher::buf_type::buf_type_count)> m_dirty_pages;
+
+  // Patchers of arguments indexed by argument index, resolved from
+  // parent module on first patch of the argument.  Avoids a lookup
+  // by symbol name in the parent every time an argument is patched.
+  struct arg_patchers
+  {
+    std::string name;
+    std::array<const patcher*, static_cast<size_t>(patcher::buf_type::buf_type_count)> patchers {};
+    std::array<bool, static_cast<size_t>(patcher::buf_type::buf_type_count)> resolved {};
+  };
+  std::vector<arg_patchers> m_arg_patchers;
+
+  // Control code words as they were before an argument was patched,
+  // in patch order.  Used to restore the control code when the module
+  // is reset for reuse by another run.  Patches applied while the
+  // module is constructed are part of the initial state and not
+  // recorded.
+  struct patch_undo
+  {
+    patcher::buf_type type;
+    uint64_t offset;
+    size_t size;
+    std::array<uint8_t, patcher::max_patch_size> data;
+  };
+  std::vector<patch_undo> m_undo;
+  bool m_record_undo = false;
+
+  const patcher*
+  get_patcher(const std::string& argnm, size_t index, patcher::buf_type type)
+  {
+    if (index >= m_arg_patchers.size())
+      m_arg_patchers.resize(index + 1);
+
+    auto& arg = m_arg_patchers[index];
+    if (arg.name != argnm) {
+      arg = arg_patchers{};
+      arg.name = argnm;
+    }
+
+    auto t = static_cast<size_t>(type);
+    if (!arg.resolved[t]) {
+      arg.patchers[t] = m_parent->get_patcher(argnm, index, type);
+      arg.resolved[t] = true;
+    }
+
+    return arg.patchers[t];
+  }
+
+  // Buffer object patched for buffer type
+  xrt::bo&
+  get_patch_bo(patcher::buf_type type)
+  {
+    switch (type) {
+    case patcher::buf_type::ctrltext:
+      return (m_parent->get_os_abi() == Elf_Amd_Aie2p) ? m_instr_bo : m_buffer;
+    case patcher::buf_type::ctrldata:
+      return m_ctrlpkt_bo;
+    case patcher::buf_type::preempt_save:
+      return m_preempt_save_bo;
+    case patcher::buf_type::preempt_restore:
+      return m_preempt_restore_bo;
+    default:
+      throw std::runtime_error("Invalid buffer type");
+    }
+  }
+
+  // Patch symbol in bo and record the pages modified
+  bool
+  patch_bo(xrt::bo& bo, const std::string& argnm, size_t index, uint64_t value, patcher::buf_type type)
+  {
+    auto p = get_patcher(argnm, index, type);
+    if (!p)
+      return false;
+
+    auto base = bo.map<uint8_t*>();
+    if (m_record_undo) {
+      for (const auto& item : p->m_ctrlcode_patchinfo) {
+        auto& undo = m_undo.emplace_back();
+        undo.type = type;
+        undo.offset = item.offset_to_patch_buffer;
+        undo.size = std::min(patcher::max_patch_size, bo.size() - undo.offset);
+        std::memcpy(undo.data.data(), base + undo.offset, undo.size);
+      }
+    }
+
+    p->patch(base, value);
+
+    auto& pages = m_dirty_pages[static_cast<size_t>(type)];
+    for (const auto& item : p->m_ctrlcode_patchinfo)
+      pages.mark(item.offset_to_patch_buffer, patcher::max_patch_size);
+
+    m_dirty = true;
+    return true;
+  }
+
   // For separated multi-column control code, compute the ctrlcode
   // buffer object address of each column (used in ert_dpu_data).
   void
@@ -1097,30 +1286,25 @@ class module_sram : public module_impl
     if (m_parent->get_os_abi() == Elf_Amd_Aie2p) {
       // patch control-packet buffer
       if (m_ctrlpkt_bo) {
-        if (m_parent->patch(m_ctrlpkt_bo.map<uint8_t*>(), argnm, index, value, patcher::buf_type::ctrldata))
+        if (patch_bo(m_ctrlpkt_bo, argnm, index, value, patcher::buf_type::ctrldata))
           patched = true;
       }
 
       // patch instruction buffer
-      if (m_parent->patch(m_instr_bo.map<uint8_t*>(), argnm, index, value, patcher::buf_type::ctrltext))
+      if (patch_bo(m_instr_bo, argnm, index, value, patcher::buf_type::ctrltext))
           patched = true;
     }
-    else if (m_parent->patch(m_buffer.map<uint8_t*>(), argnm, index, value, patcher::buf_type::ctrltext))
+    else if (patch_bo(m_buffer, argnm, index, value, patcher::buf_type::ctrltext))
       patched = true;
 
-    if (patched) {
+    if (patched)
       m_patched_args.insert(argnm);
-      m_dirty = true;
-    }
   }
 
   void
   patch_instr_value(xrt::bo& bo, const std::string& argnm, size_t index, uint64_t value, patcher::buf_type type)
   {
-    if (!m_parent->patch(bo.map<uint8_t*>(), argnm, index, value, type))
-      return;
-
-    m_dirty = true;
+    patch_bo(bo, argnm, index, value, type);
   }
 
   void
@@ -1139,14 +1323,18 @@ class module_sram : public module_impl
     patch_value(argnm, index, arg_value);
   }
 
-  // Check that all arguments have been patched and sync the buffer
-  // to device if it is dirty.
+  // Check that all arguments have been patched and sync the pages
+  // of the buffers that were patched since last sync to device.
   void
   sync_if_dirty() override
   {
     if (!m_dirty)
       return;
 
+    auto dirty = [this](patcher::buf_type type) -> dirty_pages& {
+      return m_dirty_pages[static_cast<size_t>(type)];
+    };
+
     auto os_abi = m_parent.get()->get_os_abi();
     if (os_abi == Elf_Amd_Aie2ps) {
       if (m_patched_args.size() != m_parent->number_of_arg_patchers()) {
@@ -1154,25 +1342,25 @@ class module_sram : public module_impl
             % m_parent->number_of_arg_patchers() % m_patched_args.size();
         throw std::runtime_error{ fmt.str() };
       }
-      m_buffer.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+      dirty(patcher::buf_type::ctrltext).sync(m_buffer);
     }
     else if (os_abi == Elf_Amd_Aie2p) {
-      m_instr_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+      dirty(patcher::buf_type::ctrltext).sync(m_instr_bo);
 #ifdef _DEBUG
       dump_bo(m_instr_bo, "instrBoPatched.bin");
 #endif
       if (m_ctrlpkt_bo) {
-        m_ctrlpkt_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+        dirty(patcher::buf_type::ctrldata).sync(m_ctrlpkt_bo);
 #ifdef _DEBUG
         dump_bo(m_ctrlpkt_bo, "ctrlpktBoPatched.bin");
 #endif
         }
 
       if (m_preempt_save_bo)
-        m_preempt_save_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+        dirty(patcher::buf_type::preempt_save).sync(m_preempt_save_bo);
 
       if (m_preempt_restore_bo)
-        m_preempt_restore_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+        dirty(patcher::buf_type::preempt_restore).sync(m_preempt_restore_bo);
     }
 
     m_dirty = false;
@@ -1244,6 +1432,24 @@ public:
       create_instruction_buffer(m_parent.get());
       fill_column_bo_address(m_parent->get_data());
     }
+
+    m_record_undo = true;
+  }
+
+  void
+  reset() override
+  {
+    // restore in reverse patch order, the first recorded words of
+    // a location are the initial words
+    for (auto itr = m_undo.rbegin(); itr != m_undo.rend(); ++itr) {
+      auto& bo = get_patch_bo(itr->type);
+      std::memcpy(bo.map<uint8_t*>() + itr->offset, itr->data.data(), itr->size);
+      m_dirty_pages[static_cast<size_t>(itr->type)].mark(itr->offset, itr->size);
+      m_dirty = true;
+    }
+
+    m_undo.clear();
+    m_patched_args.clear();
   }
 
   uint32_t*
@@ -1326,6 +1532,12 @@ patch(const xrt::module& module, const std::string& argnm, size_t index, const v
   module.get_handle()->patch(argnm, index, value, size);
 }
 
+void
+reset(const xrt::module& module)
+{
+  module.get_handle()->reset();
+}
+
 void
 sync(const xrt::module& module)
 {
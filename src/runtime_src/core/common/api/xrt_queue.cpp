@@ -8,10 +8,13 @@
 #define XRT_CORE_COMMON_SOURCE // in same dll as core_common
 #include "core/include/experimental/xrt_queue.h"
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN32
 # pragma warning( disable : 4244 )
@@ -22,58 +25,170 @@ namespace xrt {
 // class queue_impl - insulated implemention of an xrt::queue
 //
 // Manages and executes enqueued tasks.
-// Tasks are executed and completed in order of enqueuing.
 //
-// A queue is associated with exactly one handler thread that executes
-// the task asynchronously to the enqueuer.
+// Tasks of all queues are executed by a process wide pool of worker
+// threads.  An in order queue has at most one task in flight at any
+// time, tasks are executed and completed in order of enqueuing.  An
+// out of order queue passes its tasks to the pool as they are
+// enqueued.
 class queue_impl
 {
-  std::queue<xrt::queue::task> m_queue;  // task queue
+public:
+  using task = xrt::queue::task;
+
+private:
+  // class executor - pool of worker threads shared by all queues
+  //
+  // Workers are created on demand.  A new worker is started when a
+  // job is submitted while no worker is idle.  Tasks may block waiting
+  // for events of other queues, growing the pool rather than bounding
+  // it guarantees that such waits cannot starve the task that will
+  // signal the event.  Idle workers are kept until the process exits.
+  class executor
+  {
+    std::queue<task> m_jobs;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_work;
+    size_t m_idle = 0;
+    bool m_stop = false;
+
+    void
+    run()
+    {
+      while (true) {
+        task job;
+
+        // exclusive synchronized region
+        {
+          std::unique_lock lk(m_mutex);
+          ++m_idle;
+          m_work.wait(lk, [this] { return m_stop || !m_jobs.empty(); });
+          --m_idle;
+
+          // drain remaining jobs before exiting
+          if (m_jobs.empty())
+            return;
+
+          job = std::move(m_jobs.front());
+          m_jobs.pop();
+        }
+
+        job.execute();
+      }
+    }
+
+  public:
+    executor() = default;
+
+    ~executor()
+    {
+      {
+        std::lock_guard lk(m_mutex);
+        m_stop = true;
+        m_work.notify_all();
+      }
+      for (auto& worker : m_workers)
+        worker.join();
+    }
+
+    executor(const executor&) = delete;
+    executor(executor&&) = delete;
+    executor& operator=(const executor&) = delete;
+    executor& operator=(executor&&) = delete;
+
+    // Submit a job for execution by a worker thread
+    void
+    submit(task&& job)
+    {
+      {
+        std::lock_guard lk(m_mutex);
+        if (!m_stop) {
+          m_jobs.push(std::move(job));
+          if (m_jobs.size() > m_idle)
+            m_workers.emplace_back([this] { run(); });
+          m_work.notify_one();
+          return;
+        }
+      }
+
+      // process is exiting and pool is shut down
+      job.execute();
+    }
+
+    static executor&
+    instance()
+    {
+      static executor pool;
+      return pool;
+    }
+  };
+
+  std::deque<task> m_tasks;      // pending tasks of in order queue
   std::mutex m_mutex;
-  std::condition_variable m_work;
+  std::condition_variable m_done;
+  size_t m_inflight = 0;         // jobs submitted to executor
   bool m_stop = false;
+  bool m_in_order = true;
 
-  // single worker thread to run the tasks
-  std::thread m_worker;
-
-  // worker thread, executes tasks as they become ready
+  // Executor job for in order queue, executes pending tasks one at a
+  // time until the queue is empty.  At most one drain job is in flight
+  // per queue.
   void
-  run()
+  drain()
   {
-    while (!m_stop) {
-      xrt::queue::task task;
+    while (true) {
+      task t;
 
       // exclusive synchronized region
       {
-        std::unique_lock lk(m_mutex);
-        m_work.wait(lk, [this] { return m_stop || !m_queue.empty(); });
-
-        if (m_stop)
+        std::lock_guard lk(m_mutex);
+        if (m_stop || m_tasks.empty()) {
+          --m_inflight;
+          m_done.notify_all();
           return;
+        }
 
-        task = std::move(m_queue.front());
-        m_queue.pop();
+        t = std::move(m_tasks.front());
+        m_tasks.pop_front();
       }
 
       // allow enqueue while executing
-      task.execute();
+      t.execute();
     }
   }
 
+  // Executor job for out of order queue, executes one task
+  void
+  execute(task& t)
+  {
+    bool stop = false;
+    {
+      std::lock_guard lk(m_mutex);
+      stop = m_stop;
+    }
+
+    if (!stop)
+      t.execute();
+
+    std::lock_guard lk(m_mutex);
+    --m_inflight;
+    m_done.notify_all();
+  }
+
 public:
-  queue_impl()
-    : m_worker([this] { run(); })
+  explicit
+  queue_impl(queue::order o)
+    : m_in_order(o == queue::order::in_order)
   {}
 
-  // Shut down worker thread
+  // Drop pending tasks and wait for tasks in flight to complete
   ~queue_impl()
   {
-    {
-      std::lock_guard lk(m_mutex);
-      m_stop = true;
-      m_work.notify_one();
-    }
-    m_worker.join();
+    std::unique_lock lk(m_mutex);
+    m_stop = true;
+    m_tasks.clear();
+    m_done.wait(lk, [this] { return m_inflight == 0; });
   }
 
   queue_impl(const queue_impl&) = delete;
@@ -81,13 +196,27 @@ public:
   queue_impl& operator=(const queue_impl&) = delete;
   queue_impl& operator=(queue_impl&&) = delete;
 
-  // Enqueue a task and notify worker
+  // Enqueue a task and schedule it for execution
   void
-  enqueue(queue::task&& t)
+  enqueue(task&& t)
   {
-    std::lock_guard lk(m_mutex);
-    m_queue.push(std::move(t));
-    m_work.notify_one();
+    if (!m_in_order) {
+      {
+        std::lock_guard lk(m_mutex);
+        ++m_inflight;
+      }
+      executor::instance().submit([this, tt = std::move(t)] () mutable { execute(tt); });
+      return;
+    }
+
+    {
+      std::lock_guard lk(m_mutex);
+      m_tasks.push_back(std::move(t));
+      if (m_inflight)
+        return;  // running drain job picks up the task
+      ++m_inflight;
+    }
+    executor::instance().submit([this] { drain(); });
   }
 };
 
@@ -100,7 +229,12 @@ namespace xrt {
 
 queue::
 queue()
-  : m_impl(std::make_shared<queue_impl>())
+  : m_impl(std::make_shared<queue_impl>(order::in_order))
+{}
+
+queue::
+queue(order o)
+  : m_impl(std::make_shared<queue_impl>(o))
 {}
 
 void
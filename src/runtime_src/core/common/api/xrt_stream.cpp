@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_API_SOURCE         // exporting xrt_stream.h
+#define XCL_DRIVER_DLL_EXPORT  // exporting xrt_xclbin.h
+#define XRT_CORE_COMMON_SOURCE // in same dll as coreutil
+#include "core/include/experimental/xrt_stream.h"
+#include "core/common/shim/stream_handle.h"
+#include "core/common/device.h"
+#include "core/common/error.h"
+
+#include <chrono>
+
+namespace xrt {
+
+// class stream_impl - implementation of stream object
+//
+// Thin wrapper around the shim stream_handle which owns the
+// hardware queue.
+class stream_impl
+{
+  std::shared_ptr<xrt_core::device> m_device;
+  std::unique_ptr<xrt_core::stream_handle> m_handle;
+  stream::direction m_dir;
+
+  void
+  check_direction(stream::direction dir, const char* fcn) const
+  {
+    if (m_dir != dir)
+      throw xrt_core::error(std::errc::operation_not_supported,
+                            std::string(fcn) + ": wrong direction for stream");
+  }
+
+public:
+  stream_impl(std::shared_ptr<xrt_core::device> device, stream::direction dir,
+              uint64_t route, uint64_t flow, const stream::config& cfg)
+    : m_device(std::move(device))
+    , m_handle(m_device->create_stream(dir, route, flow, cfg))
+    , m_dir(dir)
+  {}
+
+  size_t
+  writev(const stream::buffer* bufs, size_t count, bool eot)
+  {
+    check_direction(stream::direction::host_to_device, __func__);
+    uint32_t flags = eot ? xrt_core::stream_handle::eot : 0;
+    return m_handle->transfer(bufs, count, flags, nullptr);
+  }
+
+  size_t
+  readv(const stream::buffer* bufs, size_t count)
+  {
+    check_direction(stream::direction::device_to_host, __func__);
+    return m_handle->transfer(bufs, count, 0, nullptr);
+  }
+
+  void
+  submit(const stream::buffer* bufs, size_t count, void* user_data, bool eot)
+  {
+    uint32_t flags = xrt_core::stream_handle::nonblocking;
+    if (eot && m_dir == stream::direction::host_to_device)
+      flags |= xrt_core::stream_handle::eot;
+    m_handle->transfer(bufs, count, flags, user_data);
+  }
+
+  size_t
+  poll(stream::completion* comps, size_t min, size_t max, const std::chrono::milliseconds& timeout)
+  {
+    if (min > max)
+      throw xrt_core::error(std::errc::invalid_argument, "poll: min > max");
+    return m_handle->poll(comps, min, max, static_cast<uint32_t>(timeout.count()));
+  }
+
+  stream::direction
+  get_direction() const
+  {
+    return m_dir;
+  }
+};
+
+////////////////////////////////////////////////////////////////
+// xrt_stream C++ API implmentations (xrt_stream.h)
+////////////////////////////////////////////////////////////////
+stream::
+stream(const xrt::device& device, direction dir, uint64_t route, uint64_t flow,
+       const config& cfg)
+  : detail::pimpl<stream_impl>(std::make_shared<stream_impl>(device.get_handle(), dir, route, flow, cfg))
+{}
+
+size_t
+stream::
+writev(const buffer* bufs, size_t count, bool eot)
+{
+  return handle->writev(bufs, count, eot);
+}
+
+size_t
+stream::
+readv(const buffer* bufs, size_t count)
+{
+  return handle->readv(bufs, count);
+}
+
+void
+stream::
+submit(const buffer* bufs, size_t count, void* user_data, bool eot)
+{
+  handle->submit(bufs, count, user_data, eot);
+}
+
+size_t
+stream::
+poll(completion* comps, size_t min, size_t max, const std::chrono::milliseconds& timeout)
+{
+  return handle->poll(comps, min, max, timeout);
+}
+
+stream::direction
+stream::
+get_direction() const
+{
+  return handle->get_direction();
+}
+
+} // namespace xrt
@@ -9,6 +9,9 @@
 
 #include "core/common/system.h"
 
+#include <exception>
+#include <thread>
+
 namespace xrt::system {
 
 unsigned int
@@ -17,6 +20,41 @@ enumerate_devices()
   return static_cast<unsigned int>(xrt_core::get_total_devices(true/*is_user*/).second);
 }
 
+void
+load_xclbin_all(const std::vector<xrt::device>& devices, const xrt::xclbin& xclbin)
+{
+  // Loads on different devices do not share locks, each device
+  // serializes only its own loads
+  std::vector<std::exception_ptr> errors(devices.size());
+  std::vector<std::thread> threads;
+  threads.reserve(devices.size());
+  try {
+    for (size_t idx = 0; idx < devices.size(); ++idx)
+      threads.emplace_back([&devices, &xclbin, &errors, idx] {
+        try {
+          // load_xclbin is non-const, the device handle is shared
+          auto device = devices[idx];
+          device.load_xclbin(xclbin);
+        }
+        catch (...) {
+          errors[idx] = std::current_exception();
+        }
+      });
+  }
+  catch (...) {
+    for (auto& t : threads)
+      t.join();
+    throw;
+  }
+
+  for (auto& t : threads)
+    t.join();
+
+  for (auto& error : errors)
+    if (error)
+      std::rethrow_exception(error);
+}
+
 } // xrt::system
 
 ////////////////////////////////////////////////////////////////
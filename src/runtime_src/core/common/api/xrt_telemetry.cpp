@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// This file implements XRT telemetry APIs as declared in
+// core/include/experimental/xrt_telemetry.h
+#define XRT_API_SOURCE         // exporting xrt_telemetry.h
+#define XRT_CORE_COMMON_SOURCE // in same dll as core_common
+#include "core/include/experimental/xrt_telemetry.h"
+
+#include "core/common/device.h"
+#include "core/common/error.h"
+#include "core/common/query_requests.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+namespace xq = xrt_core::query;
+using snapshot = xrt::telemetry::snapshot;
+
+// Firmware reports -1 for values it does not support
+template <typename ValueType>
+static bool
+supported(ValueType value)
+{
+  return static_cast<int>(value) != -1;
+}
+
+template <typename QueryRequestType>
+static void
+sample_sensor(const xrt_core::device* device, uint64_t& value)
+{
+  if (auto v = xrt_core::device_query_optional<QueryRequestType>(device))
+    value = *v;
+}
+
+// Firmware telemetry queries are only present on devices with
+// firmware that collects telemetry; all of them are skipped on the
+// first missing query.
+static void
+sample_firmware(const xrt_core::device* device, snapshot& s)
+{
+  try {
+    const auto misc = xrt_core::device_query<xq::misc_telemetry>(device);
+    if (supported(misc.l1_interrupts))
+      s.l1_interrupts = misc.l1_interrupts;
+
+    const auto rtos = xrt_core::device_query<xq::rtos_telemetry>(device);
+    for (const auto& task : rtos) {
+      if (!supported(task.context_starts) || s.rtos_task_count == snapshot::max_rtos_tasks)
+        break;
+      s.rtos_tasks[s.rtos_task_count++] =
+        {task.context_starts, task.schedules, task.syscalls, task.dma_access, task.resource_acquisition};
+    }
+
+    const auto opcodes = xrt_core::device_query<xq::opcode_telemetry>(device);
+    for (const auto& opcode : opcodes) {
+      if (!supported(opcode.count) || s.opcode_count == snapshot::max_opcodes)
+        break;
+      s.opcodes[s.opcode_count++] = opcode.count;
+    }
+
+    const auto stream_buffers = xrt_core::device_query<xq::stream_buffer_telemetry>(device);
+    for (const auto& buf : stream_buffers) {
+      if (!supported(buf.tokens) || s.stream_buffer_count == snapshot::max_stream_buffers)
+        break;
+      s.stream_buffer_tokens[s.stream_buffer_count++] = buf.tokens;
+    }
+
+    const auto aie = xrt_core::device_query<xq::aie_telemetry>(device);
+    for (const auto& col : aie) {
+      if (!supported(col.deep_sleep_count) || s.aie_column_count == snapshot::max_aie_columns)
+        break;
+      s.aie_deep_sleep_count[s.aie_column_count++] = col.deep_sleep_count;
+    }
+  }
+  catch (const xq::exception&) {
+    // Telemetry not supported, or only partially
+  }
+}
+
+static snapshot
+sample(const xrt_core::device* device, uint64_t sequence)
+{
+  snapshot s;
+  s.sequence = sequence;
+  s.timestamp_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>
+    (std::chrono::steady_clock::now().time_since_epoch()).count());
+
+  sample_sensor<xq::temp_fpga>(device, s.temp_fpga_c);
+  sample_sensor<xq::temp_card_top_front>(device, s.temp_card_top_front_c);
+  sample_sensor<xq::hbm_temp>(device, s.temp_hbm_c);
+  sample_sensor<xq::power_microwatts>(device, s.power_microwatts);
+  sample_sensor<xq::fan_speed_rpm>(device, s.fan_speed_rpm);
+  sample_sensor<xq::v12v_pex_millivolts>(device, s.v12v_pex_millivolts);
+  sample_sensor<xq::v12v_pex_milliamps>(device, s.v12v_pex_milliamps);
+  sample_sensor<xq::int_vcc_millivolts>(device, s.int_vcc_millivolts);
+  sample_sensor<xq::int_vcc_milliamps>(device, s.int_vcc_milliamps);
+
+  sample_firmware(device, s);
+  return s;
+}
+
+static void
+counter_delta(uint64_t previous, uint64_t& current)
+{
+  if (previous != snapshot::unavailable && current != snapshot::unavailable && current >= previous)
+    current -= previous;
+}
+
+} // namespace
+
+namespace xrt::telemetry {
+
+// class subscription_impl - periodic sampling of a device
+//
+// Samples are taken by a dedicated thread that sleeps on a condition
+// variable between samples so that stop() takes effect immediately.
+class subscription_impl
+{
+  std::shared_ptr<xrt_core::device> m_device;
+  std::chrono::milliseconds m_interval;
+  subscription::callback_type m_callback;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stop = false;
+  std::thread m_thread;
+
+  void
+  run()
+  {
+    snapshot previous;
+    uint64_t sequence = 0;
+    auto next = std::chrono::steady_clock::now();
+    while (true) {
+      auto current = ::sample(m_device.get(), sequence);
+      try {
+        m_callback(current, sequence ? delta(previous, current) : current);
+      }
+      catch (const std::exception& ex) {
+        xrt_core::send_exception_message(std::string("telemetry callback: ") + ex.what());
+      }
+      previous = current;
+      ++sequence;
+
+      // Fixed rate, a slow sample or callback does not accumulate drift
+      next += m_interval;
+      std::unique_lock lk(m_mutex);
+      if (m_cv.wait_until(lk, next, [this] { return m_stop; }))
+        return;
+    }
+  }
+
+public:
+  subscription_impl(std::shared_ptr<xrt_core::device> device, std::chrono::milliseconds interval,
+                    subscription::callback_type callback)
+    : m_device(std::move(device))
+    , m_interval(std::max(interval, std::chrono::milliseconds(1)))
+    , m_callback(std::move(callback))
+  {
+    m_thread = std::thread([this] { run(); });
+  }
+
+  ~subscription_impl()
+  {
+    stop();
+  }
+
+  subscription_impl(const subscription_impl&) = delete;
+  subscription_impl& operator=(const subscription_impl&) = delete;
+
+  void
+  stop()
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable())
+      m_thread.join();
+  }
+};
+
+snapshot
+sample(const xrt::device& device)
+{
+  return ::sample(device.get_handle().get(), 0);
+}
+
+snapshot
+delta(const snapshot& previous, const snapshot& current)
+{
+  auto d = current;
+  counter_delta(previous.l1_interrupts, d.l1_interrupts);
+
+  auto rtos_count = std::min(previous.rtos_task_count, current.rtos_task_count);
+  for (uint32_t i = 0; i < rtos_count; ++i) {
+    const auto& p = previous.rtos_tasks[i];
+    auto& c = d.rtos_tasks[i];
+    counter_delta(p.context_starts, c.context_starts);
+    counter_delta(p.schedules, c.schedules);
+    counter_delta(p.syscalls, c.syscalls);
+    counter_delta(p.dma_access, c.dma_access);
+    counter_delta(p.resource_acquisition, c.resource_acquisition);
+  }
+
+  auto opcode_count = std::min(previous.opcode_count, current.opcode_count);
+  for (uint32_t i = 0; i < opcode_count; ++i)
+    counter_delta(previous.opcodes[i], d.opcodes[i]);
+
+  auto stream_buffer_count = std::min(previous.stream_buffer_count, current.stream_buffer_count);
+  for (uint32_t i = 0; i < stream_buffer_count; ++i)
+    counter_delta(previous.stream_buffer_tokens[i], d.stream_buffer_tokens[i]);
+
+  auto aie_column_count = std::min(previous.aie_column_count, current.aie_column_count);
+  for (uint32_t i = 0; i < aie_column_count; ++i)
+    counter_delta(previous.aie_deep_sleep_count[i], d.aie_deep_sleep_count[i]);
+
+  return d;
+}
+
+subscription::
+subscription(const xrt::device& device, std::chrono::milliseconds interval, callback_type callback)
+  : detail::pimpl<subscription_impl>(std::make_shared<subscription_impl>(device.get_handle(), interval, std::move(callback)))
+{}
+
+void
+subscription::
+stop()
+{
+  if (handle)
+    handle->stop();
+}
+
+} // xrt::telemetry
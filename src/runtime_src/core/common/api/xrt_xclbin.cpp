@@ -9,7 +9,9 @@
 #include "core/include/experimental/xrt_xclbin.h"
 
 #include "core/common/system.h"
+#include "core/common/config_reader.h"
 #include "core/common/device.h"
+#include "core/common/mapped_file.h"
 #include "core/common/message.h"
 #include "core/common/module_loader.h"
 #include "core/common/query_requests.h"
@@ -23,13 +25,20 @@
 #include "xclbin_int.h"
 
 #include <boost/algorithm/string.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
 
 #include <array>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <map>
 #include <numeric>
+#include <optional>
+#include <random>
 #include <regex>
 #include <set>
+#include <sstream>
 #include <vector>
 #include <mutex>
 
@@ -45,7 +54,7 @@ namespace {
 // NOLINTNEXTLINE
 constexpr size_t operator"" _kb(unsigned long long v)  { return 1024u * v; }
 
-constexpr size_t max_sections = 14;
+constexpr size_t max_sections = 15;
 static const std::array<axlf_section_kind, max_sections> kinds = {
   EMBEDDED_METADATA,
   AIE_METADATA,
@@ -60,7 +69,8 @@ static const std::array<axlf_section_kind, max_sections> kinds = {
   BUILD_METADATA,
   SOFT_KERNEL,
   AIE_PARTITION,
-  IP_METADATA
+  IP_METADATA,
+  RUNTIME_INDEX
 };
 
 static std::vector<char>
@@ -79,14 +89,19 @@ read_file(const std::string& fnm)
   return header;
 }
 
-static std::vector<char>
-read_xclbin(const std::string& fnm)
+static std::string
+get_xclbin_path(const std::string& fnm)
 {
   if (fnm.empty())
     throw std::runtime_error("No xclbin specified");
 
-  auto path = xrt_core::environment::platform_path(fnm);
-  return read_file(path.string());
+  return xrt_core::environment::platform_path(fnm).string();
+}
+
+static std::vector<char>
+read_xclbin(const std::string& fnm)
+{
+  return read_file(get_xclbin_path(fnm));
 }
 
 static std::vector<char>
@@ -447,21 +462,26 @@ class xclbin_impl
     // Pre-condition for this function is that init_mems() and init_ips()
     // have been called.
     static std::vector<xclbin::kernel>
-    init_kernels(const xclbin_impl* ximpl, const std::vector<xclbin::ip>& ips)
+    init_kernels(const xclbin_impl* ximpl, const std::vector<xclbin::ip>& ips,
+                 std::optional<xrt_core::xclbin::runtime_index_object>& index)
     {
       auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
       if (!xml.first)
         return {};
 
-      // get kernel CUs from xclbin meta data
+      // get kernel CUs from the runtime index if present, otherwise
+      // from xclbin meta data, the XML is parsed once for all kernels
+      auto xkernels = index
+        ? std::move(index->kernels)
+        : xrt_core::xclbin::get_kernels(xml.first, xml.second);
+
       std::vector<xclbin::kernel> kernels;
-      for (auto& kernel : xrt_core::xclbin::get_kernels(xml.first, xml.second)) {
-        auto props = xrt_core::xclbin::get_kernel_properties(xml.first, xml.second, kernel.name);
+      for (auto& kernel : xkernels) {
         std::vector<xclbin::ip> cus;
         copy_if_name_match(ips.begin(), ips.end(), std::back_inserter(cus), kernel.name);
         kernels.emplace_back
           (std::make_shared<xclbin::kernel_impl>
-           (std::move(kernel.name), std::move(props), std::move(cus), std::move(kernel.args)));
+           (std::move(kernel.name), std::move(kernel.properties), std::move(cus), std::move(kernel.args)));
       }
 
       return kernels;
@@ -479,9 +499,28 @@ class xclbin_impl
       return aie_partitions;
     }
 
+    // init_runtime_index() - pre-resolved meta data if present
+    //
+    // The RUNTIME_INDEX section is used only when it was created from
+    // the EMBEDDED_METADATA of this xclbin, otherwise the XML is parsed.
+    static std::optional<xrt_core::xclbin::runtime_index_object>
+    init_runtime_index(const xclbin_impl* ximpl)
+    {
+      auto index = ximpl->get_axlf_section(RUNTIME_INDEX);
+      if (!index.first)
+        return std::nullopt;
+
+      auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
+      return xrt_core::xclbin::get_runtime_index(index.first, index.second, xml.first, xml.second);
+    }
+
     static std::string
-    init_project_name(const xclbin_impl* ximpl)
+    init_project_name(const xclbin_impl* ximpl,
+                      const std::optional<xrt_core::xclbin::runtime_index_object>& index)
     {
+      if (index)
+        return index->project_name;
+
       auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
       return xml.first
         ? xrt_core::xclbin::get_project_name(xml.first, xml.second)
@@ -489,8 +528,12 @@ class xclbin_impl
     }
 
     static std::string
-    init_fpga_device_name(const xclbin_impl* ximpl)
+    init_fpga_device_name(const xclbin_impl* ximpl,
+                          const std::optional<xrt_core::xclbin::runtime_index_object>& index)
     {
+      if (index)
+        return index->fpga_device_name;
+
       auto xml = ximpl->get_axlf_section(EMBEDDED_METADATA);
       return xml.first
         ? xrt_core::xclbin::get_fpga_device_name(xml.first, xml.second)
@@ -568,17 +611,22 @@ class xclbin_impl
     }
 
     // xclbin_info() - constructor for xclbin meta data
-    explicit
-    xclbin_info(const xrt::xclbin_impl* impl)
+    xclbin_info(const xrt::xclbin_impl* impl,
+                std::optional<xrt_core::xclbin::runtime_index_object>&& index)
       : m_ximpl(impl)
-      , m_project_name(init_project_name(m_ximpl))
-      , m_fpga_device_name(init_fpga_device_name(m_ximpl))
+      , m_project_name(init_project_name(m_ximpl, index))
+      , m_fpga_device_name(init_fpga_device_name(m_ximpl, index))
       , m_mems(init_mems(m_ximpl))
       , m_ips(init_ips(m_ximpl, m_mems))
-      , m_kernels(init_kernels(m_ximpl, m_ips))
+      , m_kernels(init_kernels(m_ximpl, m_ips, index))
       , m_aie_partitions(init_aie_partitions(m_ximpl))
       , m_membank_encoding(init_mem_encoding(m_mems))
     {}
+
+    explicit
+    xclbin_info(const xrt::xclbin_impl* impl)
+      : xclbin_info(impl, init_runtime_index(impl))
+    {}
   };
 
   // cache of meta data extracted from xclbin
@@ -655,6 +703,15 @@ public:
     throw std::runtime_error("not implemented");
   }
 
+  // Release memory of payload sections that can be restored on
+  // demand, return number of resident bytes released
+  virtual
+  size_t
+  release_payload() const
+  {
+    return 0;
+  }
+
   template <typename SectionType>
   SectionType
   get_section(axlf_section_kind kind) const
@@ -751,39 +808,119 @@ public:
 // class xclbin_full - Implementation of full xclbin
 //
 // A full xclbin is constructed from a file on disk or from a complete
-// binary images for file content
+// binary images for file content.  A file on disk is memory mapped
+// where supported, sections refer directly into the raw data and are
+// not copied.
 class xclbin_full : public xclbin_impl
 {
+#ifndef _WIN32
+  std::unique_ptr<xrt_core::mapped_file> m_file; // mapped xclbin file, or
+#endif
   std::vector<char> m_axlf;    // complete copy of xclbin raw data
   const axlf* m_top = nullptr; // axlf pointer to the raw data
   uuid m_uuid;                 // uuid of xclbin
   uuid m_intf_uuid;
 
-  // sections within this xclbin
-  std::multimap<axlf_section_kind, std::vector<char>> m_axlf_sections;
+  // sections within this xclbin, headers of sections in the raw data
+  std::multimap<axlf_section_kind, const axlf_section_header*> m_axlf_sections;
+
+  // Compressed sections are decompressed on first access and the
+  // complete xclbin is decompressed only if the raw data is requested,
+  // unused sections remain compressed
+  mutable std::mutex m_mutex;
+  mutable std::map<const axlf_section_header*, std::vector<char>> m_decompressed_sections;
+  mutable std::vector<char> m_decompressed_axlf;
+  bool m_compressed = false;
 
   void
   emplace_section(const axlf_section_header* hdr, axlf_section_kind kind)
   {
-    auto section_data = reinterpret_cast<const char*>(m_top) + hdr->m_sectionOffset;
-    std::vector<char> data{section_data, section_data + hdr->m_sectionSize};
-    m_axlf_sections.emplace(kind , std::move(data));
+    m_compressed |= (hdr->m_sectionKind & AXLF_SECTION_COMPRESSED) != 0;
+    m_axlf_sections.emplace(kind, hdr);
   }
 
   void
-  emplace_soft_kernel_sections(const axlf_section_header* hdr)
+  emplace_soft_kernel_sections()
   {
-    while (hdr != nullptr) {
-      emplace_section(hdr, SOFT_KERNEL);
-      hdr = ::xclbin::get_axlf_section_next(m_top, hdr, SOFT_KERNEL);
+    auto begin = m_top->m_sections;
+    auto end = begin + m_top->m_header.m_numSections;
+    for (auto hdr = begin; hdr != end; ++hdr) {
+      if ((hdr->m_sectionKind & ~AXLF_SECTION_COMPRESSED) == SOFT_KERNEL)
+        emplace_section(hdr, SOFT_KERNEL);
     }
   }
 
+  // get_section_data() - data of section, decompressed if necessary
+  std::pair<const char*, size_t>
+  get_section_data(const axlf_section_header* hdr) const
+  {
+    auto section_data = reinterpret_cast<const char*>(m_top) + hdr->m_sectionOffset;
+    if (!(hdr->m_sectionKind & AXLF_SECTION_COMPRESSED))
+      return {section_data, static_cast<size_t>(hdr->m_sectionSize)};
+
+    std::lock_guard lk(m_mutex);
+    auto itr = m_decompressed_sections.find(hdr);
+    if (itr == m_decompressed_sections.end()) {
+      auto data = xrt_core::xclbin::decompress_section(section_data, hdr->m_sectionSize);
+      itr = m_decompressed_sections.emplace(hdr, std::move(data)).first;
+    }
+    return {itr->second.data(), itr->second.size()};
+  }
+
+  // decompress_axlf() - create an xclbin with all sections decompressed
+  //
+  // Consumers of the raw axlf data, e.g. drivers, are unaware of
+  // compressed sections.  Sections are laid out in header order with
+  // the same 8 byte alignment as xclbinutil.
+  std::vector<char>
+  decompress_axlf() const
+  {
+    auto num_sections = m_top->m_header.m_numSections;
+    auto header_size = sizeof(axlf) + (num_sections ? num_sections - 1 : 0) * sizeof(axlf_section_header);
+    auto align = [](size_t offset) { return (offset + 7) & ~static_cast<size_t>(7); };
+
+    std::vector<std::vector<char>> sections(num_sections);
+    size_t size = header_size;
+    for (uint32_t idx = 0; idx < num_sections; ++idx) {
+      const auto& hdr = m_top->m_sections[idx];
+      if (hdr.m_sectionKind & AXLF_SECTION_COMPRESSED) {
+        auto section_data = reinterpret_cast<const char*>(m_top) + hdr.m_sectionOffset;
+        sections[idx] = xrt_core::xclbin::decompress_section(section_data, hdr.m_sectionSize);
+        size = align(size) + sections[idx].size();
+      }
+      else {
+        size = align(size) + hdr.m_sectionSize;
+      }
+    }
+
+    std::vector<char> data(size);
+    auto top = reinterpret_cast<axlf*>(data.data());
+    std::copy_n(reinterpret_cast<const char*>(m_top), header_size, data.data());
+    top->m_header.m_length = size;
+
+    size_t offset = header_size;
+    for (uint32_t idx = 0; idx < num_sections; ++idx) {
+      auto& hdr = top->m_sections[idx];
+      auto section_data = reinterpret_cast<const char*>(m_top) + hdr.m_sectionOffset;
+      offset = align(offset);
+      if (hdr.m_sectionKind & AXLF_SECTION_COMPRESSED) {
+        hdr.m_sectionKind &= ~AXLF_SECTION_COMPRESSED;
+        hdr.m_sectionSize = sections[idx].size();
+        section_data = sections[idx].data();
+      }
+      std::copy_n(section_data, hdr.m_sectionSize, data.data() + offset);
+      hdr.m_sectionOffset = offset;
+      offset += hdr.m_sectionSize;
+    }
+
+    return data;
+  }
+
   void
-  init_axlf()
+  init_axlf(const char* data, size_t size)
   {
-    const axlf* tmp = reinterpret_cast<const axlf*>(m_axlf.data());
-    if (strncmp(tmp->m_magic, "xclbin2", strlen("xclbin2")) != 0) // Future: Do not hardcode "xclbin2"
+    const axlf* tmp = reinterpret_cast<const axlf*>(data);
+    if (size < sizeof(axlf) || strncmp(tmp->m_magic, "xclbin2", strlen("xclbin2")) != 0) // Future: Do not hardcode "xclbin2"
       throw std::runtime_error("Invalid xclbin");
     m_top = tmp;
 
@@ -791,30 +928,73 @@ class xclbin_full : public xclbin_impl
     m_intf_uuid = uuid(m_top->m_header.m_interface_uuid);
 
     for (auto kind : kinds) {
-      auto hdr = xrt_core::xclbin::get_axlf_section(m_top, kind);
-
-      if (!hdr)
+      // account for multiple soft_kernel sections
+      if (kind == SOFT_KERNEL) {
+        emplace_soft_kernel_sections();
         continue;
+      }
 
-      // account for multiple soft_kernel sections
-      if (kind == SOFT_KERNEL)
-        emplace_soft_kernel_sections(hdr);
-      else
+      if (auto hdr = xrt_core::xclbin::get_axlf_section(m_top, kind, true))
         emplace_section(hdr, kind);
     }
+
+    // sections outside of kinds can be compressed too
+    auto begin = m_top->m_sections;
+    auto end = begin + m_top->m_header.m_numSections;
+    m_compressed |= std::any_of(begin, end, [](const auto& hdr) {
+      return (hdr.m_sectionKind & AXLF_SECTION_COMPRESSED) != 0;
+    });
+  }
+
+#ifndef _WIN32
+  // Payload sections are needed only when the xclbin is loaded
+  static bool
+  is_payload_section(uint32_t kind)
+  {
+    switch (kind & ~AXLF_SECTION_COMPRESSED) {
+    case BITSTREAM:
+    case BITSTREAM_PARTIAL_PDI:
+    case PDI:
+    case AIE_PARTITION:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  // Number of bytes in page aligned range that are resident
+  static size_t
+  resident_size(const char* addr, size_t size, size_t page_size)
+  {
+    std::vector<unsigned char> pages(size / page_size);
+    if (::mincore(const_cast<char*>(addr), size, pages.data()))
+      return 0;
+
+    return page_size * std::count_if(pages.begin(), pages.end(), [](auto p) { return p & 1; });
   }
+#endif
 
   void
   init()
   {
-    init_axlf();
+#ifndef _WIN32
+    if (m_file) {
+      init_axlf(m_file->data(), m_file->size());
+      return;
+    }
+#endif
+    init_axlf(m_axlf.data(), m_axlf.size());
   }
 
 public:
   explicit
   xclbin_full(const std::string& filename)
-    : m_axlf(read_xclbin(filename))
   {
+#ifndef _WIN32
+    m_file = std::make_unique<xrt_core::mapped_file>(get_xclbin_path(filename));
+#else
+    m_axlf = read_xclbin(filename);
+#endif
     init();
   }
 
@@ -874,7 +1054,7 @@ public:
   {
     auto itr = m_axlf_sections.find(kind);
     return itr != m_axlf_sections.end()
-      ? std::make_pair((*itr).second.data(), (*itr).second.size())
+      ? get_section_data((*itr).second)
       : std::make_pair(nullptr, size_t(0));
   }
 
@@ -889,7 +1069,7 @@ public:
       std::vector<std::pair<const char*, size_t>> return_sections;
 
       for (auto itr = result.first; itr != result.second; itr++)
-        return_sections.emplace_back(std::make_pair(itr->second.data(), itr->second.size()));
+        return_sections.emplace_back(get_section_data(itr->second));
 
       return return_sections;
     }
@@ -898,10 +1078,53 @@ public:
     }
   }
 
+  // Pages of a mapped xclbin file are private and clean, dropping
+  // them from the mapping keeps the addresses valid, the pages are
+  // read again from the file when accessed.  Section data copied or
+  // decompressed on the heap is not released.
+  size_t
+  release_payload() const override
+  {
+#ifndef _WIN32
+    if (!m_file)
+      return 0;
+
+    static const auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    auto base = reinterpret_cast<uintptr_t>(m_top);
+    size_t released = 0;
+    for (uint32_t idx = 0; idx < m_top->m_header.m_numSections; ++idx) {
+      const auto& hdr = m_top->m_sections[idx];
+      if (!is_payload_section(hdr.m_sectionKind))
+        continue;
+
+      // Only pages entirely within the section
+      auto begin = (base + hdr.m_sectionOffset + page_size - 1) & ~(page_size - 1);
+      auto end = (base + hdr.m_sectionOffset + hdr.m_sectionSize) & ~(page_size - 1);
+      if (end <= begin)
+        continue;
+
+      auto addr = reinterpret_cast<char*>(begin);
+      auto size = end - begin;
+      auto resident = resident_size(addr, size, page_size);
+      if (resident && !::madvise(addr, size, MADV_DONTNEED))
+        released += resident;
+    }
+    return released;
+#else
+    return 0;
+#endif
+  }
+
   const axlf*
   get_axlf() const override
   {
-    return m_top;
+    if (!m_compressed)
+      return m_top;
+
+    std::lock_guard lk(m_mutex);
+    if (m_decompressed_axlf.empty())
+      m_decompressed_axlf = decompress_axlf();
+    return reinterpret_cast<const axlf*>(m_decompressed_axlf.data());
   }
 };
 
@@ -953,11 +1176,183 @@ public:
 // The implementaton may be extended later to support multiple
 // directories and maybe filtering of the xclbins based on to be
 // defined criteria.
+//
+// Lookup by uuid goes through an index of the xclbins in the
+// repository, which is built on first use.  When an index directory
+// is configured, the index of each repository directory is persisted
+// and an xclbin is opened again only if its modification time
+// changed since it was indexed.
 class xclbin_repository_impl
 {
+  struct index_entry
+  {
+    int64_t mtime = 0;
+    std::string uuid;
+    std::string interface_uuid;
+    std::vector<std::string> kernels;
+  };
+
+  // xclbin path -> indexed meta data
+  using index_type = std::map<std::string, index_entry>;
+
   std::vector<std::filesystem::path> m_paths;
   std::vector<std::filesystem::path> m_xclbin_paths;
 
+  mutable std::once_flag m_index_once;
+  mutable index_type m_index;
+
+  static int64_t
+  get_mtime(const std::filesystem::path& path)
+  {
+    return std::filesystem::last_write_time(path).time_since_epoch().count();
+  }
+
+  static index_entry
+  make_index_entry(const std::filesystem::path& path)
+  {
+    xrt::xclbin xclbin{path.string()};
+    index_entry entry;
+    entry.mtime = get_mtime(path);
+    entry.uuid = xclbin.get_uuid().to_string();
+    entry.interface_uuid = xclbin.get_interface_uuid().to_string();
+    for (const auto& kernel : xclbin.get_kernels())
+      entry.kernels.push_back(kernel.get_name());
+    return entry;
+  }
+
+  static std::filesystem::path
+  get_index_file(const std::filesystem::path& dir)
+  {
+    auto index_dir = xrt_core::config::get_xclbin_repo_index_dir();
+    if (index_dir.empty())
+      return {};
+
+    auto repo = std::filesystem::absolute(dir).lexically_normal().string();
+    std::stringstream fnm;
+    fnm << "xclbin_index-" << std::hex << std::hash<std::string>{}(repo) << ".json";
+    return std::filesystem::path(index_dir) / fnm.str();
+  }
+
+  static index_type
+  read_index(const std::filesystem::path& file, const std::filesystem::path& dir)
+  {
+    namespace pt = boost::property_tree;
+    index_type index;
+    if (file.empty() || !std::filesystem::exists(file))
+      return index;
+
+    try {
+      pt::ptree tree;
+      pt::read_json(file.string(), tree);
+
+      // File name is a hash of the directory, check for collision
+      if (tree.get<std::string>("repository") != std::filesystem::absolute(dir).lexically_normal().string())
+        return index;
+
+      for (const auto& [key, xtree] : tree.get_child("xclbins")) {
+        index_entry entry;
+        entry.mtime = xtree.get<int64_t>("mtime");
+        entry.uuid = xtree.get<std::string>("uuid");
+        entry.interface_uuid = xtree.get<std::string>("interface_uuid");
+        for (const auto& kernel : xtree.get_child("kernels"))
+          entry.kernels.push_back(kernel.second.get_value<std::string>());
+        index.emplace(xtree.get<std::string>("path"), std::move(entry));
+      }
+    }
+    catch (const std::exception& ex) {
+      xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT",
+                              "Ignoring xclbin repository index " + file.string() + ": " + ex.what());
+      index.clear();
+    }
+    return index;
+  }
+
+  static void
+  write_index(const std::filesystem::path& file, const std::filesystem::path& dir, const index_type& index)
+  {
+    namespace pt = boost::property_tree;
+    pt::ptree xclbins;
+    for (const auto& [path, entry] : index) {
+      pt::ptree kernels;
+      for (const auto& kernel : entry.kernels) {
+        pt::ptree value;
+        value.put("", kernel);
+        kernels.push_back({"", value});
+      }
+      pt::ptree xtree;
+      xtree.put("path", path);
+      xtree.put("mtime", entry.mtime);
+      xtree.put("uuid", entry.uuid);
+      xtree.put("interface_uuid", entry.interface_uuid);
+      xtree.add_child("kernels", kernels);
+      xclbins.push_back({"", xtree});
+    }
+
+    pt::ptree tree;
+    tree.put("repository", std::filesystem::absolute(dir).lexically_normal().string());
+    tree.add_child("xclbins", xclbins);
+
+    // Write to a temporary file and rename, concurrent processes
+    // never observe a partially written index
+    try {
+      std::filesystem::create_directories(file.parent_path());
+      auto tmp = file;
+      tmp += ".tmp" + std::to_string(std::random_device{}());
+      pt::write_json(tmp.string(), tree);
+      std::filesystem::rename(tmp, file);
+    }
+    catch (const std::exception& ex) {
+      xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT",
+                              "Unable to write xclbin repository index " + file.string() + ": " + ex.what());
+    }
+  }
+
+  // Index the xclbins of one repository directory, reusing entries
+  // of the persisted index whose modification time is unchanged
+  void
+  index_directory(const std::filesystem::path& dir) const
+  {
+    auto file = get_index_file(dir);
+    auto cached = read_index(file, dir);
+    index_type index;
+    bool stale = false;
+
+    for (const auto& xpath : m_xclbin_paths) {
+      if (xpath.parent_path() != dir)
+        continue;
+
+      try {
+        auto itr = cached.find(xpath.string());
+        if (itr != cached.end() && itr->second.mtime == get_mtime(xpath)) {
+          index.insert(*itr);
+          continue;
+        }
+        index.emplace(xpath.string(), make_index_entry(xpath));
+        stale = true;
+      }
+      catch (const std::exception& ex) {
+        xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT",
+                                "Skipping " + xpath.string() + " in xclbin repository index: " + ex.what());
+      }
+    }
+
+    // Removed xclbins are dropped from the persisted index as well
+    if (!file.empty() && (stale || index.size() != cached.size()))
+      write_index(file, dir, index);
+
+    m_index.merge(index);
+  }
+
+  const index_type&
+  get_index() const
+  {
+    std::call_once(m_index_once, [this] {
+      for (const auto& dir : m_paths)
+        index_directory(dir);
+    });
+    return m_index;
+  }
+
   static std::vector<std::filesystem::path>
   get_xclbin_paths(const std::vector<std::filesystem::path>& dirs)
   {
@@ -1012,6 +1407,17 @@ public:
 
     throw std::runtime_error("xclbin file not found: " + name);
   }
+
+  [[nodiscard]] xclbin
+  load(const xrt::uuid& uuid) const
+  {
+    auto str = uuid.to_string();
+    for (const auto& [path, entry] : get_index())
+      if (entry.uuid == str)
+        return xclbin{path};
+
+    throw std::runtime_error("xclbin with uuid not found: " + str);
+  }
 };
 
 } // xrt
@@ -1024,19 +1430,94 @@ namespace xrt {
 ////////////////////////////////////////////////////////////////
 // xrt::xclbin
 ////////////////////////////////////////////////////////////////
+// Full xclbins in use by this process.  An xclbin constructed with
+// the same content as an xclbin in use shares the existing
+// implementation, so the raw data is not copied and its meta data is
+// not extracted again.  Entries are weak, the cache does not extend
+// the lifetime of an xclbin.
+static std::mutex s_xclbins_mutex;
+static std::map<xrt::uuid, std::weak_ptr<xclbin_full>> s_xclbins;
+
+// Find xclbin in use with same content as raw data of specified size
+static std::shared_ptr<xclbin_full>
+find_xclbin(const char* data, size_t size)
+{
+  auto top = reinterpret_cast<const axlf*>(data);
+  if (size < sizeof(axlf) || top->m_header.m_length > size)
+    return nullptr;
+
+  std::lock_guard lk(s_xclbins_mutex);
+  auto itr = s_xclbins.find(xrt::uuid{top->m_header.uuid});
+  if (itr == s_xclbins.end())
+    return nullptr;
+
+  // uuid is preserved by tools that modify xclbin sections, so
+  // compare the full content
+  auto xclbin = itr->second.lock();
+  if (!xclbin)
+    return nullptr;
+
+  auto cached = xclbin->get_axlf();
+  auto length = top->m_header.m_length;
+  if (cached->m_header.m_length != length || std::memcmp(cached, top, length) != 0)
+    return nullptr;
+
+  return xclbin;
+}
+
+static std::shared_ptr<xclbin_full>
+share_xclbin(std::shared_ptr<xclbin_full> xclbin)
+{
+  std::lock_guard lk(s_xclbins_mutex);
+  for (auto itr = s_xclbins.begin(); itr != s_xclbins.end();)
+    itr = itr->second.expired() ? s_xclbins.erase(itr) : std::next(itr);
+
+  s_xclbins[xclbin->get_uuid()] = xclbin;
+  return xclbin;
+}
+
+static std::shared_ptr<xclbin_impl>
+get_xclbin_full(const std::string& filename)
+{
+  auto xclbin = std::make_shared<xclbin_full>(filename);
+  auto top = xclbin->get_axlf();
+  if (auto cached = find_xclbin(reinterpret_cast<const char*>(top), top->m_header.m_length))
+    return cached;
+
+  return share_xclbin(std::move(xclbin));
+}
+
+static std::shared_ptr<xclbin_impl>
+get_xclbin_full(const std::vector<char>& data)
+{
+  if (auto cached = find_xclbin(data.data(), data.size()))
+    return cached;
+
+  return share_xclbin(std::make_shared<xclbin_full>(data));
+}
+
+static std::shared_ptr<xclbin_impl>
+get_xclbin_full(const axlf* top)
+{
+  if (auto cached = find_xclbin(reinterpret_cast<const char*>(top), top->m_header.m_length))
+    return cached;
+
+  return share_xclbin(std::make_shared<xclbin_full>(top));
+}
+
 xclbin::
 xclbin(const std::string& filename)
-  : detail::pimpl<xclbin_impl>(std::make_shared<xclbin_full>(filename))
+  : detail::pimpl<xclbin_impl>(get_xclbin_full(filename))
 {}
 
 xclbin::
 xclbin(const std::vector<char>& data)
-  : detail::pimpl<xclbin_impl>(std::make_shared<xclbin_full>(data))
+  : detail::pimpl<xclbin_impl>(get_xclbin_full(data))
 {}
 
 xclbin::
 xclbin(const axlf* top)
-  : detail::pimpl<xclbin_impl>(std::make_shared<xclbin_full>(top))
+  : detail::pimpl<xclbin_impl>(get_xclbin_full(top))
 {}
 
 std::vector<xclbin::kernel>
@@ -1471,6 +1952,13 @@ load(const std::string& name) const
   return handle->load(name);
 }
 
+xclbin
+xclbin_repository::
+load(const uuid& xid) const
+{
+  return handle->load(xid);
+}
+
 ////////////////////////////////////////////////////////////////
 // xrt::xclbin_repository::iterator
 ////////////////////////////////////////////////////////////////
@@ -1606,6 +2094,12 @@ get_project_name(const xrt::xclbin& xclbin)
   return xclbin.get_handle()->get_project_name();
 }
 
+size_t
+release_payload(const xrt::xclbin& xclbin)
+{
+  return xclbin.get_handle()->release_payload();
+}
+
 } // xrt_core::xclbin_int
 
 ////////////////////////////////////////////////////////////////
@@ -10,9 +10,14 @@
 #include "core/common/shim/buffer_handle.h"
 #include "core/include/ert.h"
 
-#include <vector>
-#include <utility>
+#include <algorithm>
+#include <iterator>
 #include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #ifdef _WIN32
 # pragma warning( push )
@@ -116,6 +121,222 @@ private:
 
 using bo_cache = bo_cache_t<4096>;
 
+// class bo_slab - Size class allocator of command BO objects
+//
+// Command BOs of a device are allocated in power of two size classes
+// from min_size to max_size.  Each size class has a depot of free BOs
+// shared by all threads and a number of magazines.  A thread always
+// uses the same magazine, so in the steady state alloc and release
+// only touch an uncontended magazine lock.  Magazines are refilled
+// from and flushed to the depot in batches, the driver is called
+// only when the depot is empty or full.
+//
+// The slab can be prefilled with BOs of a size class so that command
+// BOs are not allocated through the driver on the hot path.
+class bo_slab
+{
+public:
+  template <typename CommandType>
+  using cmd_bo = bo_cache::cmd_bo<CommandType>;
+
+  static constexpr size_t min_size = 4096;           // page size, smallest allocation of xocl/zocl
+  static constexpr size_t max_size = 64 * 1024;
+  static constexpr size_t num_classes = 5;           // log2(max_size / min_size) + 1
+
+private:
+  static constexpr size_t num_magazines = 8;
+  static constexpr size_t magazine_size = 16;
+
+  struct magazine
+  {
+    std::mutex mutex;
+    std::vector<cmd_bo<void>> bos[num_classes];
+  };
+
+  struct depot
+  {
+    std::mutex mutex;
+    std::vector<cmd_bo<void>> bos[num_classes];
+  };
+
+  std::shared_ptr<device> m_device;
+  // Maximum number of BOs per size class kept in the depot. Value of
+  // 0 disables caching.
+  const unsigned int m_depot_max_size;
+  magazine m_magazines[num_magazines];
+  depot m_depot;
+
+  static size_t
+  size_class(size_t size)
+  {
+    if (size > max_size)
+      throw std::runtime_error("command BO size (" + std::to_string(size) + ") exceeds max size");
+
+    size_t cls = 0;
+    for (auto sz = min_size; sz < size; sz <<= 1)
+      ++cls;
+    return cls;
+  }
+
+  static size_t
+  class_size(size_t cls)
+  {
+    return min_size << cls;
+  }
+
+  magazine&
+  get_magazine()
+  {
+    static thread_local size_t idx = std::hash<std::thread::id>{}(std::this_thread::get_id()) % num_magazines;
+    return m_magazines[idx];
+  }
+
+  cmd_bo<void>
+  create(size_t cls)
+  {
+    auto execHandle = m_device->alloc_bo(class_size(cls), XCL_BO_FLAGS_EXECBUF);
+    auto map = execHandle->map(buffer_handle::map_type::write);
+    return std::make_pair(std::move(execHandle), map);
+  }
+
+  void
+  destroy(const cmd_bo<void>& bo)
+  {
+    bo.first->unmap(bo.second);
+  }
+
+  cmd_bo<void>
+  alloc_impl(size_t cls)
+  {
+    if (!m_depot_max_size)
+      return create(cls);
+
+    auto& mag = get_magazine();
+    std::lock_guard mlk(mag.mutex);
+    auto& bos = mag.bos[cls];
+    if (bos.empty()) {
+      // Refill half a magazine from depot
+      std::lock_guard dlk(m_depot.mutex);
+      auto& dbos = m_depot.bos[cls];
+      auto count = std::min(dbos.size(), magazine_size / 2);
+      std::move(dbos.end() - count, dbos.end(), std::back_inserter(bos));
+      dbos.resize(dbos.size() - count);
+    }
+
+    if (bos.empty())
+      return create(cls);
+
+    auto bo = std::move(bos.back());
+    bos.pop_back();
+    return bo;
+  }
+
+  void
+  release_impl(size_t cls, cmd_bo<void>&& bo)
+  {
+    if (!m_depot_max_size) {
+      destroy(bo);
+      return;
+    }
+
+    auto& mag = get_magazine();
+    std::lock_guard mlk(mag.mutex);
+    auto& bos = mag.bos[cls];
+    if (bos.size() == magazine_size) {
+      // Flush half a magazine to depot, destroy what doesn't fit
+      std::lock_guard dlk(m_depot.mutex);
+      auto& dbos = m_depot.bos[cls];
+      auto count = magazine_size / 2;
+      for (auto itr = bos.end() - count; itr != bos.end(); ++itr) {
+        if (dbos.size() < m_depot_max_size)
+          dbos.push_back(std::move(*itr));
+        else
+          destroy(*itr);
+      }
+      bos.resize(bos.size() - count);
+    }
+    bos.push_back(std::move(bo));
+  }
+
+public:
+  bo_slab(std::shared_ptr<xrt_core::device> device, unsigned int depot_max_size)
+    : m_device(std::move(device)), m_depot_max_size(depot_max_size)
+  {}
+
+  bo_slab(xclDeviceHandle handle, unsigned int depot_max_size)
+    : m_device(get_userpf_device(handle)), m_depot_max_size(depot_max_size)
+  {}
+
+  ~bo_slab()
+  {
+    for (auto& mag : m_magazines)
+      for (auto& bos : mag.bos)
+        for (auto& bo : bos)
+          destroy(bo);
+
+    for (auto& bos : m_depot.bos)
+      for (auto& bo : bos)
+        destroy(bo);
+  }
+
+  bo_slab(const bo_slab&) = delete;
+  bo_slab(bo_slab&&) = delete;
+  bo_slab& operator=(const bo_slab&) = delete;
+  bo_slab& operator=(bo_slab&&) = delete;
+
+  // Size of BO allocated for a request of @size bytes
+  static size_t
+  alloc_size(size_t size)
+  {
+    return class_size(size_class(size));
+  }
+
+  // Allocate command BO of at least @size bytes
+  template<typename T>
+  cmd_bo<T>
+  alloc(size_t size = min_size)
+  {
+    auto bo = alloc_impl(size_class(size));
+    return std::make_pair(std::move(bo.first), static_cast<T *>(bo.second));
+  }
+
+  // Release command BO allocated with @size bytes
+  template<typename T>
+  void
+  release(cmd_bo<T>&& bo, size_t size = min_size)
+  {
+    release_impl(size_class(size), std::make_pair(std::move(bo.first), static_cast<void *>(bo.second)));
+  }
+
+  // Prefill depot with @count BOs of at least @size bytes.  The depot
+  // is filled up to its max size only.
+  void
+  prefill(size_t size, unsigned int count)
+  {
+    auto cls = size_class(size);
+    std::vector<cmd_bo<void>> bos;
+    {
+      std::lock_guard dlk(m_depot.mutex);
+      auto avail = m_depot_max_size - std::min<size_t>(m_depot_max_size, m_depot.bos[cls].size());
+      count = static_cast<unsigned int>(std::min<size_t>(count, avail));
+    }
+
+    // Allocate without holding the lock
+    bos.reserve(count);
+    for (unsigned int i = 0; i < count; ++i)
+      bos.push_back(create(cls));
+
+    std::lock_guard dlk(m_depot.mutex);
+    auto& dbos = m_depot.bos[cls];
+    for (auto& bo : bos) {
+      if (dbos.size() < m_depot_max_size)
+        dbos.push_back(std::move(bo));
+      else
+        destroy(bo);
+    }
+  }
+};
+
 } // xrt_core
 
 #ifdef _WIN32
@@ -19,11 +19,15 @@
 #include "message.h"
 #include "error.h"
 
+#include <atomic>
 #include <filesystem>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <set>
 #include <mutex>
+#include <unordered_map>
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ini_parser.hpp>
@@ -142,16 +146,58 @@ get_ini_path()
   return full_path;
 }
 
+// Flat immutable snapshot of all "section.key" values of the ini
+// tree.  Lookups are a single hash lookup instead of a ptree path
+// traversal.  A new snapshot is published when the tree changes.
+using settings = std::unordered_map<std::string, std::string>;
+
+static std::shared_ptr<const settings>
+flatten(const boost::property_tree::ptree& pt)
+{
+  auto flat = std::make_shared<settings>();
+  for (const auto& [section, node] : pt) {
+    if (node.empty()) {
+      flat->emplace(section, node.data());
+      continue;
+    }
+    for (const auto& [key, value] : node)
+      flat->emplace(section + "." + key, value.data());
+  }
+  return flat;
+}
+
 struct tree
 {
   boost::property_tree::ptree m_tree;
   const boost::property_tree::ptree null_tree;
+  std::shared_ptr<const settings> m_settings = std::make_shared<settings>();
+
+  std::shared_ptr<const settings>
+  get_settings() const
+  {
+    return std::atomic_load(&m_settings);
+  }
+
+  void
+  publish()
+  {
+    std::atomic_store(&m_settings, flatten(m_tree));
+  }
+
+  // Find raw value of key, nullptr if not present
+  static const std::string*
+  find(const settings& flat, const char* key)
+  {
+    auto itr = flat.find(key);
+    return itr == flat.end() ? nullptr : &itr->second;
+  }
 
   void
   read(const std::string& path)
   {
     try {
       read_ini(path,m_tree);
+      publish();
 
       // inform which .ini was read
       //xrt_core::message::send(xrt_core::message::severity_level::XRT_INFO, "XRT", std::string("Read ") + path);
@@ -205,25 +251,30 @@ get_bool_value(const char* key, bool default_value)
     return is_true(env);
 
   key::lock(key);
-  return tree::instance()->m_tree.get<bool>(key,default_value);
+  auto flat = tree::instance()->get_settings();
+  if (auto str = tree::find(*flat, key)) {
+    if (*str == "true" || *str == "1")
+      return true;
+    if (*str == "false" || *str == "0")
+      return false;
+  }
+  return default_value;
 }
 
 std::string
 get_string_value(const char* key, const std::string& default_value)
 {
   std::string val = default_value;
-  try {
-    val = tree::instance()->m_tree.get<std::string>(key,default_value);
+  auto flat = tree::instance()->get_settings();
+  if (auto str = tree::find(*flat, key)) {
+    val = *str;
     // Although INI file entries are not supposed to have quotes around strings
     // but we want to be cautious
-    if (!val.empty() && (val.front() == '"') && (val.back() == '"')) {
+    if (val.size() > 1 && (val.front() == '"') && (val.back() == '"')) {
       val.erase(0, 1);
       val.erase(val.size()-1);
     }
   }
-  catch( std::exception const&) {
-    // eat the exception, probably bad path
-  }
   key::lock(key);
   return val;
 }
@@ -232,11 +283,17 @@ unsigned int
 get_uint_value(const char* key, unsigned int default_value)
 {
   unsigned int val = default_value;
-  try {
-    val = tree::instance()->m_tree.get<unsigned int>(key,default_value);
-  }
-  catch( std::exception const&) {
-    // eat the exception, probably bad path
+  auto flat = tree::instance()->get_settings();
+  if (auto str = tree::find(*flat, key)) {
+    try {
+      size_t idx = 0;
+      auto v = std::stoul(*str, &idx, 0);
+      if (idx == str->size() && v <= std::numeric_limits<unsigned int>::max())
+        val = static_cast<unsigned int>(v);
+    }
+    catch (const std::exception&) {
+      // eat the exception, not an unsigned value
+    }
   }
   key::lock(key);
   return val;
@@ -266,6 +323,7 @@ set(const std::string& key, const std::string& value)
   }
 
   s_tree->m_tree.put(key, value);
+  s_tree->publish();
 }
 
 std::ostream&
@@ -144,6 +144,31 @@ get_profiling_directory()
   return value ;
 }
 
+// Directory where AIE trace and profile cache the tile configuration
+// resolved for an xclbin, empty disables the cache
+inline std::string
+get_aie_config_cache_dir()
+{
+  static std::string value = detail::get_string_value("Debug.aie_config_cache_dir", "") ;
+  return value ;
+}
+
+// File periodically rewritten with the profiling statistics in
+// Prometheus text format while the application runs
+inline std::string
+get_metrics_export_file()
+{
+  static std::string value = detail::get_string_value("Debug.metrics_export_file", "") ;
+  return value ;
+}
+
+inline unsigned int
+get_metrics_export_interval_ms()
+{
+  static unsigned int value = detail::get_uint_value("Debug.metrics_export_interval_ms", 1000) ;
+  return value ;
+}
+
 inline bool
 get_power_profile()
 {
@@ -225,6 +250,14 @@ get_trace_buffer_offload_interval_ms()
   return value;
 }
 
+// Threads shared by all devices for continuous device trace offload
+inline unsigned int
+get_device_offload_threads()
+{
+  static unsigned int value = detail::get_uint_value("Debug.device_offload_threads", 4);
+  return value;
+}
+
 inline unsigned int
 get_trace_file_dump_interval_s()
 {
@@ -232,6 +265,15 @@ get_trace_file_dump_interval_s()
   return value;
 }
 
+// Number of host trace events buffered in memory that triggers a
+// continuous trace dump before the dump interval expires, 0 disables
+inline unsigned int
+get_trace_host_event_limit()
+{
+  static unsigned int value = detail::get_uint_value("Debug.trace_host_event_limit", 0);
+  return value;
+}
+
 inline std::string
 get_trace_buffer_size()
 {
@@ -253,6 +295,23 @@ get_ml_timeline_buffer_size()
   return value;
 }
 
+// Comma separated record timer IDs to keep in the ML timeline, all
+// records are kept if empty
+inline std::string
+get_ml_timeline_record_ids()
+{
+  static std::string value = detail::get_string_value("Debug.ml_timeline_record_ids", "");
+  return value;
+}
+
+// Keep every Nth record of each record timer ID in the ML timeline
+inline unsigned int
+get_ml_timeline_sample_interval()
+{
+  static unsigned int value = detail::get_uint_value("Debug.ml_timeline_sample_interval", 1);
+  return value;
+}
+
 inline bool
 get_profile_api()
 {
@@ -286,6 +345,15 @@ get_native_xrt_trace()
   return value;
 }
 
+// Trace only every Nth native API call of a thread.  Calls that are
+// not traced are still counted and timed for the profile summary.
+inline unsigned int
+get_native_xrt_trace_sample_interval()
+{
+  static unsigned int value = detail::get_uint_value("Debug.native_xrt_trace_sample_interval", 1);
+  return value;
+}
+
 inline bool
 get_opencl_trace()
 {
@@ -328,6 +396,25 @@ get_pl_deadlock_detection()
   return value;
 }
 
+/**
+ * Interval bounds in ms for polling of the PL deadlock detector.
+ * Polling starts at the min interval and backs off exponentially
+ * to the max interval while no deadlock is detected.
+ */
+inline unsigned int
+get_pl_deadlock_min_poll_ms()
+{
+  static unsigned int value = detail::get_uint_value("Debug.pl_deadlock_min_poll_ms", 100);
+  return value;
+}
+
+inline unsigned int
+get_pl_deadlock_max_poll_ms()
+{
+  static unsigned int value = detail::get_uint_value("Debug.pl_deadlock_max_poll_ms", 2000);
+  return value;
+}
+
 inline bool
 get_api_checks()
 {
@@ -349,6 +436,91 @@ get_logging()
   return value;
 }
 
+/**
+ * Dispatch messages from a background thread.  Messages are queued
+ * in per thread rings and the sending thread does not block on the
+ * log destination.  Messages of severity error and above are always
+ * dispatched synchronously.
+ */
+inline bool
+get_logging_async()
+{
+  static bool value = detail::get_bool_value("Runtime.runtime_log_async", false);
+  return value;
+}
+
+/**
+ * Maximum number of messages per second per message tag, messages
+ * in excess are dropped and counted.  0 disables rate limiting.
+ */
+inline unsigned int
+get_logging_rate_limit()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.runtime_log_rate_limit", 0);
+  return value;
+}
+
+/**
+ * Number of threads probing PCIe functions when devices are
+ * enumerated, 0 uses one thread per cpu and 1 probes serially.
+ */
+inline unsigned int
+get_device_scan_threads()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.device_scan_threads", 0);
+  return value;
+}
+
+/**
+ * Number of released dma-buf imports kept attached per device, so that
+ * importing the same dma-buf again is a lookup.  A cached import holds
+ * a reference on the dma-buf.  0 disables the cache.
+ */
+inline unsigned int
+get_import_cache_size()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.import_cache_size", 0);
+  return value;
+}
+
+/**
+ * Directory where xrt::xclbin_repository keeps an index of the
+ * xclbins in each repository directory.  Indexed xclbins are looked
+ * up by uuid without opening them until their modification time
+ * changes.  Empty disables the persistent index.
+ */
+inline std::string
+get_xclbin_repo_index_dir()
+{
+  static std::string value = detail::get_string_value("Runtime.xclbin_repo_index_dir", "");
+  return value;
+}
+
+/**
+ * Release the resident pages of bitstream, PDI, and AIE partition
+ * sections of a memory mapped xclbin once it is loaded on a device.
+ * The pages are read back from the file if the sections are accessed
+ * again.
+ */
+inline bool
+get_xclbin_release_payload()
+{
+  static bool value = detail::get_bool_value("Runtime.xclbin_release_payload", true);
+  return value;
+}
+
+/**
+ * Write multi-register blocks of CU argument space through a
+ * write-combining mapping of the BAR with wide stores.  Requires
+ * a prefetchable BAR and privileges to map it, otherwise ignored.
+ */
+inline bool
+get_wc_kernel_args()
+{
+  static bool value = detail::get_bool_value("Runtime.wc_kernel_args", false);
+  return value;
+}
+
 inline bool
 get_trace_logging()
 {
@@ -364,6 +536,18 @@ get_usage_metrics_logging()
   return value;
 }
 
+/**
+ * Trace xrt::run executions and xrt::bo syncs into per thread ring
+ * buffers and print per stage latency, overlap, and critical path
+ * of the host pipeline at exit.  Default false.
+ */
+inline bool
+get_pipeline_trace()
+{
+  static bool value = detail::get_bool_value("Runtime.pipeline_trace", false);
+  return value;
+}
+
 inline unsigned int
 get_verbosity()
 {
@@ -379,6 +563,30 @@ get_dma_threads()
   return value;
 }
 
+/**
+ * Comma separated list of cpus to which the task workers of the
+ * OpenCL device are pinned, worker i is pinned to cpu i modulo the
+ * length of the list.  Default no pinning.
+ */
+inline std::string
+get_dma_worker_cpus()
+{
+  static std::string value = detail::get_string_value("Runtime.dma_worker_cpus","");
+  return value;
+}
+
+/**
+ * Comma separated priorities of the read, write, and misc task queues
+ * of the OpenCL device.  Idle workers pick work from the highest
+ * priority queue first.  Default 0,0,0.
+ */
+inline std::string
+get_dma_queue_priorities()
+{
+  static std::string value = detail::get_string_value("Runtime.dma_queue_priorities","");
+  return value;
+}
+
 inline unsigned int
 get_polling_throttle()
 {
@@ -386,6 +594,52 @@ get_polling_throttle()
   return value;
 }
 
+/**
+ * Number of command monitor threads per device used for managed
+ * command execution.  Hardware contexts are sharded across the
+ * threads.
+ */
+inline unsigned int
+get_completion_threads()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.completion_threads",1);
+  return value;
+}
+
+/**
+ * Comma separated list of cpus to which completion threads are
+ * pinned, thread i is pinned to cpu i modulo the length of the list.
+ */
+inline std::string
+get_completion_thread_cpus()
+{
+  static std::string value = detail::get_string_value("Runtime.completion_thread_cpus","");
+  return value;
+}
+
+/**
+ * Spin on command state before blocking in exec_wait when waiting
+ * for an unmanaged run to complete.  The spin is bounded by moving
+ * average of recent completion times of the kernel.
+ */
+inline bool
+get_adaptive_wait()
+{
+  static bool value = detail::get_bool_value("Runtime.adaptive_wait",false);
+  return value;
+}
+
+/**
+ * Upper bound in micro seconds for adaptive wait spin.  Kernels with
+ * longer completion times are not spun on at all.
+ */
+inline unsigned int
+get_adaptive_wait_max_us()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.adaptive_wait_max_us",50);
+  return value;
+}
+
 inline std::string
 get_hal_logging()
 {
@@ -578,6 +832,201 @@ get_noop_completion_delay_us()
   return delay;
 }
 
+/**
+ * Synthetic latency model of the noop shim.  Mean service time in
+ * microseconds of a command on a simulated CU.  Commands targeting
+ * the same CU are serviced one at a time.  Default 0.
+ */
+inline unsigned int
+get_noop_cu_service_us()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.noop_cu_service_us", 0);
+  return value;
+}
+
+/**
+ * Distribution of noop CU service times, one of "fixed", "uniform"
+ * (between 0 and twice the mean), or "exponential".  Default fixed.
+ */
+inline std::string
+get_noop_cu_service_distribution()
+{
+  static std::string value = detail::get_string_value("Runtime.noop_cu_service_distribution", "fixed");
+  return value;
+}
+
+/**
+ * Bandwidth in MB/s of each simulated noop DMA direction used by BO
+ * sync.  Concurrent syncs in the same direction share the bandwidth.
+ * Default 0 completes syncs instantly.
+ */
+inline unsigned int
+get_noop_dma_bandwidth_mbps()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.noop_dma_bandwidth_mbps", 0);
+  return value;
+}
+
+/**
+ * Latency in microseconds from noop CU completion until the command
+ * is marked complete, modelling interrupt delivery.  Default 0.
+ */
+inline unsigned int
+get_noop_irq_latency_us()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.noop_irq_latency_us", 0);
+  return value;
+}
+
+/**
+ * Queue commands in a submission ring shared with the driver instead
+ * of one ioctl per command.  The driver is only notified when it is
+ * not already draining the ring.  Default false.
+ */
+inline bool
+get_submit_ring()
+{
+  static bool value = detail::get_bool_value("Runtime.submit_ring",false);
+  return value;
+}
+
+/**
+ * Open the contexts of all compute units of the xclbin when a
+ * hardware context is created rather than when kernels are
+ * constructed.  The CU contexts remain open for the lifetime of the
+ * hardware context.  Default false.
+ */
+inline bool
+get_hw_context_open_cus()
+{
+  static bool value = detail::get_bool_value("Runtime.hw_context_open_cus",false);
+  return value;
+}
+
+/**
+ * Number of command BOs to allocate up front when a hardware context
+ * is created.  Default 0 allocates command BOs on demand.
+ */
+inline unsigned int
+get_exec_bo_prefill()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.exec_bo_prefill",0);
+  return value;
+}
+
+/**
+ * Number of released hardware contexts kept configured for reuse by
+ * a later context with the same xclbin, configuration, and access
+ * mode.  Default 0 destroys contexts when released.
+ */
+inline unsigned int
+get_hw_context_cache_size()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.hw_context_cache_size",0);
+  return value;
+}
+
+/**
+ * Number of worker threads performing asynchronous BO syncs issued
+ * with xrt::bo::async().  Default 2.
+ */
+inline unsigned int
+get_async_dma_threads()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.async_dma_threads",2);
+  return value;
+}
+
+/**
+ * Number of worker threads running xrt::run completion callbacks.
+ * Default 0, which runs callbacks on the command monitor thread that
+ * observed the completion.  A non zero value hands the callbacks to
+ * a process wide pool of threads so that slow callbacks do not delay
+ * completion processing of other commands.
+ */
+inline unsigned int
+get_callback_threads()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.callback_threads",0);
+  return value;
+}
+
+/**
+ * Time in milliseconds a sensor query result (temperatures, voltages,
+ * currents, power, fan speed) is reused before the sensor is read
+ * again.  Applies to PCIe devices.  Default 200, 0 disables caching.
+ */
+inline unsigned int
+get_sensor_query_ttl_ms()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.sensor_query_ttl_ms",200);
+  return value;
+}
+
+/**
+ * Chunk size in bytes for copy of buffers through host when neither
+ * M2M nor KDMA can be used.  Chunks are synced by the asynchronous
+ * DMA workers (Runtime.async_dma_threads) so that DMA of one chunk
+ * overlaps host copy of another.  Default 4MB.
+ */
+inline unsigned int
+get_host_copy_chunk_size()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.host_copy_chunk_size",4*1024*1024);
+  return value;
+}
+
+/**
+ * Select copy method (M2M, KDMA, or through host) for xrt::bo::copy
+ * per device by measuring bandwidth of each available method on the
+ * first large copies.  When disabled M2M is preferred over KDMA over
+ * host.  Default true.
+ */
+inline bool
+get_bo_copy_probe()
+{
+  static bool value = detail::get_bool_value("Runtime.bo_copy_probe",true);
+  return value;
+}
+
+/**
+ * Place XRT allocated host side buffers on the NUMA node of the device
+ * and pin command completion threads to the cpus of that node, unless
+ * Runtime.completion_thread_cpus is specified.  Default false.
+ */
+inline bool
+get_numa_affinity()
+{
+  static bool value = detail::get_bool_value("Runtime.numa_affinity",false);
+  return value;
+}
+
+/**
+ * Back XRT allocated host side buffers of normal BOs with huge pages.
+ * Value is page size "2M" or "1G", default "" uses regular pages.
+ * Buffers smaller than the huge page size use regular pages, and so
+ * does any buffer for which huge pages cannot be allocated.
+ */
+inline std::string
+get_hbuf_hugepages()
+{
+  static std::string value = detail::get_string_value("Runtime.hbuf_hugepages","");
+  return value;
+}
+
+/**
+ * Carve device only buffers of at most 1/8 of this size in bytes out
+ * of shared device memory slabs of this size, one driver allocation
+ * per slab instead of per buffer.  Default 0 allocates every buffer
+ * from the driver.
+ */
+inline unsigned int
+get_bo_slab_size()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.bo_slab_size",0);
+  return value;
+}
+
 /**
  * Set CMD BO cache size. CUrrently it is only used in xclCopyBO()
  */
@@ -703,6 +1152,16 @@ get_force_program_xclbin()
   return value;
 }
 
+// HIP commands passed the null stream go to a default stream of the
+// calling thread instead of the shared legacy null stream, as if the
+// application had passed hipStreamPerThread.
+inline bool
+get_hip_per_thread_default_stream()
+{
+  static bool value = detail::get_bool_value("Runtime.hip_per_thread_default_stream", false);
+  return value;
+}
+
 inline bool
 get_is_enable_prep_target()
 {
@@ -777,6 +1236,15 @@ get_aie_profile_settings_interval_us()
   return value ;
 }
 
+// Only store samples of counters whose value changed since the
+// previous poll, adequate for counters that accumulate
+inline bool
+get_aie_profile_settings_changed_counters_only()
+{
+  static bool value = detail::get_bool_value("AIE_profile_settings.changed_counters_only", false) ;
+  return value ;
+}
+
 inline std::string
 get_aie_profile_settings_graph_based_aie_metrics()
 {
@@ -8,6 +8,7 @@
 #include "config_reader.h"
 #include "debug.h"
 #include "error.h"
+#include "message.h"
 #include "query_requests.h"
 #include "utils.h"
 #include "xclbin_parser.h"
@@ -84,7 +85,8 @@ get_xclbin_uuid() const
 
   // Emulation mode likely, just return m_xclbin_uuid which reflects
   // the uuid of the xclbin loaded by this process.
-  return m_xclbin ? m_xclbin.get_uuid() : uuid{};
+  auto xclbin = get_current_xclbin();
+  return xclbin ? xclbin.get_uuid() : uuid{};
 }
 
 // Registering an xclbin has one entry point (this one) only.
@@ -114,7 +116,7 @@ record_xclbin(const xrt::xclbin& xclbin)
   // as a temporary 'global'.  This variable is used when
   // update_cu_info() is called and query:kds_cu_info is not
   // implemented
-  m_xclbin = xclbin;
+  set_xclbin(xclbin);
 }
 
 // Unfortunately there are two independent entry points to load an
@@ -123,18 +125,32 @@ record_xclbin(const xrt::xclbin& xclbin)
 // register_axlf() upon successful xclbin loading. It is possible for
 // register_axlf() to be called without the call originating from this
 // function, so special managing of m_xclbin data member is required.
+//
+// Loads on one device are serialized by m_load_mutex, loads on
+// different devices proceed concurrently.  m_xclbin itself is
+// guarded by m_xclbin_mutex, which is never held across calls, since
+// register_axlf() and queries on the device read it while loading.
 void
 device::
 load_xclbin(const xrt::xclbin& xclbin)
 {
+  std::lock_guard load_lk(m_load_mutex);
+  set_xclbin(xclbin);
   try {
-    m_xclbin = xclbin;
     load_axlf(xclbin.get_axlf());
   }
   catch (const std::exception&) {
-    m_xclbin = {};
+    set_xclbin({});
     throw;
   }
+
+  // The device has consumed the bitstream, drop it from memory
+  if (config::get_xclbin_release_payload()) {
+    if (auto released = xclbin_int::release_payload(xclbin))
+      message::send(message::severity_level::info, "XRT",
+                    "Released " + std::to_string(released / 1024) + " KB of xclbin "
+                    + xclbin.get_uuid().to_string() + " payload after load");
+  }
 }
 
 void
@@ -151,13 +167,15 @@ load_xclbin(const uuid& xclbin_id)
     throw error(ENODEV, "no cached xclbin data");
 
   const axlf* top = reinterpret_cast<axlf *>(xclbin_full.data());
+  std::lock_guard load_lk(m_load_mutex);
   try {
     // set before register_axlf is called via load_axlf_meta
-    m_xclbin = xrt::xclbin{top};
-    load_axlf_meta(m_xclbin.get_axlf());
+    xrt::xclbin xclbin{top};
+    set_xclbin(xclbin);
+    load_axlf_meta(xclbin.get_axlf());
   }
   catch (const std::exception&) {
-    m_xclbin = {};
+    set_xclbin({});
     throw;
   }
 #else
@@ -169,18 +187,36 @@ xrt::xclbin
 device::
 get_xclbin(const uuid& xclbin_id) const
 {
+  auto xclbin = get_current_xclbin();
+
   // Allow access to xclbin in process of loading via device::load_xclbin
-  if (xclbin_id && xclbin_id == m_xclbin.get_uuid())
-    return m_xclbin;
+  if (xclbin_id && xclbin_id == xclbin.get_uuid())
+    return xclbin;
   if (xclbin_id) {
     std::lock_guard lk(m_mutex);
     return m_xclbins.get(xclbin_id);
   }
 
   // Single xclbin case
+  return xclbin;
+}
+
+xrt::xclbin
+device::
+get_current_xclbin() const
+{
+  std::lock_guard lk(m_xclbin_mutex);
   return m_xclbin;
 }
 
+void
+device::
+set_xclbin(const xrt::xclbin& xclbin)
+{
+  std::lock_guard lk(m_xclbin_mutex);
+  m_xclbin = xclbin;
+}
+
 // Update cached xclbin data based on data queried from driver. This
 // function can be called by multiple threads. One entry point is
 // via register_axlf, another is through open_context.  For the latter,
@@ -276,12 +312,15 @@ register_axlf(const axlf* top)
   // entry points for xclbin loading.  However, for backwards
   // compatibility m_xclbin represents the last loaded xclbin and
   // will continue to work for single xclbin use-cases.
-  if (!m_xclbin || m_xclbin.get_uuid() != xid)
-    m_xclbin = xrt::xclbin{top};
+  auto xclbin = get_current_xclbin();
+  if (!xclbin || xclbin.get_uuid() != xid) {
+    xclbin = xrt::xclbin{top};
+    set_xclbin(xclbin);
+  }
 
   // Record the xclbin
   std::lock_guard lk(m_mutex);
-  m_xclbins.insert(m_xclbin);
+  m_xclbins.insert(xclbin);
 }
 
 std::pair<const char*, size_t>
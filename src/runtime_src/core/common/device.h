@@ -20,6 +20,8 @@
 
 #include <any>
 #include <cstdint>
+#include <optional>
+#include <tuple>
 #include <vector>
 #include <string>
 #include <map>
@@ -474,6 +476,13 @@ public:
   }
 
  private:
+  // Snapshot and update of m_xclbin under m_xclbin_mutex
+  xrt::xclbin
+  get_current_xclbin() const;
+
+  void
+  set_xclbin(const xrt::xclbin& xclbin);
+
   id_type m_device_id;
   mutable boost::optional<bool> m_nodma = boost::none;
 
@@ -484,6 +493,8 @@ public:
   xrt::xclbin m_xclbin;                       // currently loaded xclbin  (single-slot, default)
   xclbin_map m_xclbins;                       // currently loaded xclbins (multi-slot)
   mutable std::mutex m_mutex;
+  mutable std::mutex m_xclbin_mutex;          // guards m_xclbin only
+  std::mutex m_load_mutex;                    // serializes xclbin loads on this device
   std::shared_ptr<usage_metrics::base_logger> m_usage_logger = usage_metrics::get_usage_metrics_logger();
 };
 
@@ -555,6 +566,50 @@ device_query_default(const std::shared_ptr<device>& device, const typename Query
   }
 }
 
+/**
+ * device_query_optional() - Retrieve query request data if available
+ *
+ * @device : device to retrieve data for
+ * Return: value per QueryRequestType, or empty if the device does not
+ *  support the request or the request failed
+ */
+template <typename QueryRequestType>
+inline std::optional<typename QueryRequestType::result_type>
+device_query_optional(const device* device)
+{
+  try {
+    return device_query<QueryRequestType>(device);
+  }
+  catch (const query::exception&) {
+    return std::nullopt;
+  }
+}
+
+/**
+ * device_query_batch() - Retrieve data for several query requests
+ *
+ * @device : device to retrieve data for
+ * Return: tuple with a value per QueryRequestTypes as returned by
+ *  device_query_optional()
+ *
+ * Query request exceptions are absorbed per request so that a single
+ * call can collect all values a caller is interested in.  Requests
+ * are retrieved in order.
+ */
+template <typename ...QueryRequestTypes>
+inline std::tuple<std::optional<typename QueryRequestTypes::result_type>...>
+device_query_batch(const device* device)
+{
+  return {device_query_optional<QueryRequestTypes>(device)...};
+}
+
+template <typename ...QueryRequestTypes>
+inline std::tuple<std::optional<typename QueryRequestTypes::result_type>...>
+device_query_batch(const std::shared_ptr<device>& device)
+{
+  return device_query_batch<QueryRequestTypes...>(device.get());
+}
+
 template <typename QueryRequestType, typename ...Args>
 inline void
 device_update(const device* device, Args&&... args)
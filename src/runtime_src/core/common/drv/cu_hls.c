@@ -39,7 +39,11 @@
 #define ISR		0xC
 #define ARGS		0x10
 
+/* Number of leading argument registers tracked by the shadow regmap */
+#define CU_HLS_SHADOW_REGS	64
+
 extern int kds_echo;
+extern int kds_arg_shadow;
 
 struct xrt_cu_hls {
 	void __iomem		*vaddr;
@@ -52,6 +56,9 @@ struct xrt_cu_hls {
 	u32			 done;
 	struct list_head	 submitted;
 	struct list_head	 completed;
+	/* Last value written to argument registers, see cu_hls_shadow_match() */
+	u64			 shadow_valid;
+	u32			 shadow[CU_HLS_SHADOW_REGS];
 };
 
 static inline u32 cu_read32(struct xrt_cu_hls *cu, u32 reg)
@@ -80,6 +87,27 @@ static inline void cu_move_to_complete(struct xrt_cu_hls *cu, int status)
 	list_move_tail(&xcmd->list, &cu->completed);
 }
 
+/*
+ * An ap_ctrl_chain CU keeps its argument registers across starts, so back to
+ * back commands only need to write the registers that changed. Return true if
+ * register idx already holds val. The shadow is always kept up to date, but
+ * writes are skipped only when kds_arg_shadow is enabled.
+ */
+static inline bool
+cu_hls_shadow_match(struct xrt_cu_hls *cu, u32 idx, u32 val)
+{
+	if (idx >= CU_HLS_SHADOW_REGS)
+		return false;
+
+	if (kds_arg_shadow && cu->ctrl_chain &&
+	    (cu->shadow_valid & BIT_ULL(idx)) && cu->shadow[idx] == val)
+		return true;
+
+	cu->shadow[idx] = val;
+	cu->shadow_valid |= BIT_ULL(idx);
+	return false;
+}
+
 static int cu_hls_alloc_credit(void *core)
 {
 	struct xrt_cu_hls *cu_hls = core;
@@ -146,8 +174,11 @@ static int cu_hls_configure(void *core, u32 *data, size_t sz, int type)
 	switch (type) {
 	case REGMAP:
 		/* Write register map, starting at base_addr + 0x10 (byte) */
-		for (i = 0; i < num_reg; ++i)
+		for (i = 0; i < num_reg; ++i) {
+			if (cu_hls_shadow_match(cu_hls, i, data[i]))
+				continue;
 			cu_write32(cu_hls, ARGS + i * 4, data[i]);
+		}
 		break;
 	case KEY_VAL:
 		/* Use {offset, value} pairs to configure CU
@@ -156,6 +187,7 @@ static int cu_hls_configure(void *core, u32 *data, size_t sz, int type)
 		 */
 		for (i = 0; i < num_reg; i += 2)
 			cu_write32(cu_hls, data[i], data[i + 1]);
+		cu_hls->shadow_valid = 0;
 		break;
 	case XGQ_CMD:
 		hdr = (struct xgq_cmd_sq_hdr *)data;
@@ -165,6 +197,7 @@ static int cu_hls_configure(void *core, u32 *data, size_t sz, int type)
 			cu_hls_xgq_start_kv(cu_hls, data);
 		else
 			return -EINVAL;
+		cu_hls->shadow_valid = 0;
 		break;
 	}
 	return 0;
@@ -372,6 +405,7 @@ static void cu_hls_reset(void *core)
 {
 	struct xrt_cu_hls *cu_hls = core;
 
+	cu_hls->shadow_valid = 0;
 	cu_write32(cu_hls, CTRL, CU_AP_SW_RESET);
 }
 
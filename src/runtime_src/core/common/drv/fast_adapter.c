@@ -112,27 +112,52 @@ static int cu_fa_configure(void *core, u32 *data, size_t sz, int type)
 static void cu_fa_start(void *core)
 {
 	struct xrt_cu_fa *cu_fa = core;
-	u32 desc_msw = cu_fa->paddr >> 32;
-	u32 desc_lsw = (u32)cu_fa->paddr;
 
 	cu_fa->run_cnts++;
 
 	if (kds_echo || !cu_fa->cmdmem)
 		return;
 
+	/* The descriptor is queued to the adapter on flush, together with
+	 * all descriptors started in the same pass over the run queue.
+	 */
+	if (!cu_fa->pending)
+		cu_fa->pending_slot = cu_fa->head_slot;
+	cu_fa->pending++;
+
+	/* move to next descriptor slot */
+	cu_fa->head_slot += cu_fa->slot_sz;
+	if (cu_fa->head_slot == cu_fa->slot_sz * cu_fa->num_slots)
+		cu_fa->head_slot = 0;
+}
+
+static void cu_fa_flush(void *core)
+{
+	struct xrt_cu_fa *cu_fa = core;
+	u32 desc_msw = cu_fa->paddr >> 32;
+	u32 desc_lsw = (u32)cu_fa->paddr;
+	u32 slot = cu_fa->pending_slot;
+
+	if (!cu_fa->pending)
+		return;
+
 	/* The MSW of descriptor is fixed */
 	if (desc_msw != cu_fa->desc_msw) {
 		cu_write32(cu_fa, MSWR, desc_msw);
 		cu_fa->desc_msw = desc_msw;
 	}
 
-	/* Write LSW would kick off CU */
-	cu_write32(cu_fa, LSWR, desc_lsw + cu_fa->head_slot);
-
-	/* move to next descriptor slot */
-	cu_fa->head_slot += cu_fa->slot_sz;
-	if (cu_fa->head_slot == cu_fa->slot_sz * cu_fa->num_slots)
-		cu_fa->head_slot = 0;
+	/* Each write of LSW pushes one descriptor into the adapter task
+	 * FIFO and would kick off CU. The writes are posted, so the burst
+	 * costs about the same as a single write.
+	 */
+	while (cu_fa->pending) {
+		cu_write32(cu_fa, LSWR, desc_lsw + slot);
+		slot += cu_fa->slot_sz;
+		if (slot == cu_fa->slot_sz * cu_fa->num_slots)
+			slot = 0;
+		cu_fa->pending--;
+	}
 }
 
 static void cu_fa_check(void *core, struct xcu_status *status, bool force)
@@ -155,6 +180,9 @@ static void cu_fa_check(void *core, struct xcu_status *status, bool force)
 	if (!force && !cu_fa->run_cnts)
 		return;
 
+	/* One read of taskCount reports all tasks finished since the last
+	 * check, however many descriptors were queued.
+	 */
 	cu_fa->check_count++;
 	task_count = cu_read32(cu_fa, TCR);
 	/* If taskCount register overflow once, below calculate is still correct.
@@ -258,6 +286,7 @@ static struct xcu_funcs xrt_cu_fa_funcs = {
 	.peek_credit	= cu_fa_peek_credit,
 	.configure	= cu_fa_configure,
 	.start		= cu_fa_start,
+	.flush		= cu_fa_flush,
 	.check		= cu_fa_check,
 	.enable_intr	= cu_fa_enable_intr,
 	.disable_intr	= cu_fa_disable_intr,
@@ -25,6 +25,8 @@
 
 #define EV_ABORT	0x1
 
+struct eventfd_ctx;
+
 /* KDS CU information. */
 struct kds_client_cu_info {
 	u32				cu_idx;
@@ -59,9 +61,11 @@ struct kds_client_cu_refcnt {
  * The client could open multiple contexts to access compute resources.
  *
  * @link: Client is added to list in KDS scheduler
+ * @kds:  KDS scheduler the client belongs to
  * @dev:  Device
  * @pid:  Client process ID
  * @lock: Mutex to protext context related members
+ * @ring_lock: Mutex to serialize draining of submission rings
  * @xclbin_id: UUID of xclbin cache
  * @num_ctx: Number of context that opened
  * @num_scu_ctx: Number of soft kernel context that opened
@@ -70,12 +74,15 @@ struct kds_client_cu_refcnt {
  * @scu_bitmap: bitmap of opening SCU
  * @waitq: Wait queue for poll client
  * @event: Events to notify user client
+ * @evfd: Optional eventfd signaled with each event
  */
 struct kds_client {
 	struct list_head	  link;
+	struct kds_sched	 *kds;
 	struct device	         *dev;
 	struct pid	         *pid;
 	struct mutex		  lock;
+	struct mutex		  ring_lock;
 
 	/* TODO: xocl not suppot multiple xclbin context yet. */
 	struct kds_client_ctx    	*ctx;
@@ -102,6 +109,7 @@ struct kds_client {
 	 */
 	wait_queue_head_t	  waitq ____cacheline_aligned_in_smp;
 	atomic_t		  event;
+	struct eventfd_ctx	 *evfd;
 };
 
 /* Macros to operates client statistics */
@@ -23,6 +23,11 @@
 #define KEY_VAL 1
 #define XGQ_CMD 2
 
+/* Payload bytes stored inline in a slab allocated command. This covers the
+ * register map of the common kernels; larger payloads are allocated apart.
+ */
+#define KDS_CMD_INLINE_SIZE 512
+
 enum kds_opcode {
 	OP_NONE = 0,
 	OP_CONFIG,
@@ -77,6 +82,13 @@ struct in_kernel_cb {
  * @hw_ctx_id: This command specific to this hw context
  * @type:   type of the command. Use this to determin controller
  */
+/* Priority class of a command, see process_rq() */
+enum kds_priority {
+	KDS_PRIORITY_NORMAL = 0,
+	KDS_PRIORITY_HIGH,
+	KDS_PRIORITY_NUM,
+};
+
 struct kds_command {
 	struct kds_client	*client;
 	enum kds_status		 status;
@@ -98,6 +110,10 @@ struct kds_command {
 	unsigned int		 tick;
 	u32			 timestamp_enabled;
 	u64			 timestamp[KDS_STAT_MAX];
+	/* ERT clock counter at CU start and done, see xgq_cmd_resp_cuidx */
+	u32			 fw_timestamp_enabled;
+	u32			 fw_cu_start;
+	u32			 fw_cu_done;
 
 	/* TODO: may rethink if we should have cu bit mask here
 	 * or move it to info.
@@ -105,6 +121,8 @@ struct kds_command {
 	 */
 	u32			 cu_mask[4];
 	u32			 num_mask;
+	/* xrt_cu_fast_ns() when queued to and started on CU */
+	u64			 queued;
 	u64			 start;
 
 	/* execbuf is used to update the header
@@ -116,6 +134,19 @@ struct kds_command {
 	u32			 exec_bo_handle;
 	/* to notify inkernel exec completion */
 	struct in_kernel_cb	*inkern_cb;
+	/* CU thread wakes the client once per completion batch */
+	u32			 defer_wake;
+	/* enum kds_priority, from the hw context of the command */
+	u32			 priority;
+	/* hw context of the command, NULL if not found */
+	struct kds_client_hw_ctx *hw_ctx;
+	/* Fair share flow of the command on its CU, see process_rq() */
+	u32			 flow;
+
+	/* Slab cache the command came from, NULL if kzalloc'ed */
+	struct kmem_cache	*cache;
+	/* Inline payload, only present in slab allocated commands */
+	u8			 payload[] __aligned(8);
 };
 
 void set_xcmd_timestamp(struct kds_command *xcmd, enum kds_status s);
@@ -75,6 +75,8 @@ enum kds_cu_domain {
  */
 #define MAX_SLOT 32
 #define MAX_CU_STAT_LINE_LENGTH  128
+/* Two latency histograms of 20 digits counters */
+#define MAX_CU_LAT_LINE_LENGTH   (32 + 2 * CU_LAT_HIST_BUCKETS * 21)
 #define DEFAULT_HW_CTX_ID	0
 
 enum kds_type {
@@ -100,6 +102,17 @@ struct kds_cu_mgmt {
 	u32			  cu_refs[MAX_CUS];
 	struct cu_stats __percpu *cu_stats;
 	int			  rw_shared;
+	/* Device wide CU selection policy, enum kds_cu_policy */
+	u32			  cu_policy;
+	/* Open CU contexts of hw contexts with KDS_INTR_MOD_OFF */
+	u32			  intr_mod_off[MAX_CUS];
+};
+
+/* Completion interrupt moderation of a hw context */
+enum kds_intr_mod {
+	KDS_INTR_MOD_DEFAULT = 0,	/* device setting, sysfs kds_intr_coalesce */
+	KDS_INTR_MOD_OFF,		/* interrupt per completion */
+	KDS_INTR_MOD_NUM,
 };
 
 #define cu_stat_read(cu_mgmt, field) \
@@ -173,6 +186,16 @@ struct kds_sched {
 	bool			ert_disable;
 	bool                    force_polling;
 	u32			cu_intr;
+	/* ERT stamps CU start and done, applied on next xclbin load */
+	bool			cu_timestamp;
+	/* CUs with a larger register map in bytes are not scheduled by ERT */
+	u32			host_cu_regmap;
+	/* ERT CU completion interrupt moderation, see xgq_cmd_cu_intr_mod */
+	u32			intr_count;
+	u32			intr_cycles;
+	/* Send moderation of a CU to ERT, NULL if not supported */
+	int (*set_cu_intr_mod)(struct kds_sched *kds, u32 cu_idx, u32 count, u32 cycles);
+	struct mutex		intr_mod_lock;
 
 	/* APU Timestamp Set Flag */
 	bool			timestamp_set;
@@ -184,6 +207,11 @@ struct kds_sched {
 	int			polling_start;
 	int			polling_stop;
 	u32			interval;
+	/* Completion wakeup coalescing window in microseconds */
+	u32			wake_window;
+
+	/* Command objects with inline payload */
+	struct kmem_cache      *cmd_cache;
 };
 
 int kds_init_sched(struct kds_sched *kds);
@@ -230,8 +258,15 @@ int kds_ip_layout2scu_info(struct ip_layout *ip_layout, struct xrt_cu_info cu_in
 int store_kds_echo(struct kds_sched *kds, const char *buf, size_t count,
 		   int *echo);
 ssize_t show_kds_stat(struct kds_sched *kds, char *buf);
+const char *kds_cu_policy_name(u32 policy);
+int kds_parse_cu_policy(const char *buf);
+void kds_set_wake_window(struct kds_sched *kds, u32 window);
+void kds_set_intr_mod(struct kds_sched *kds, u32 count, u32 cycles);
 ssize_t show_kds_custat_raw(struct kds_sched *kds, char *buf, size_t buf_size, loff_t offset);
 ssize_t show_kds_scustat_raw(struct kds_sched *kds, char *buf, size_t buf_size, loff_t offset);
+ssize_t show_kds_culat_raw(struct kds_sched *kds, char *buf, size_t buf_size, loff_t offset);
+ssize_t show_kds_cubusy_raw(struct kds_sched *kds, char *buf, size_t buf_size, loff_t offset);
+ssize_t show_kds_client_stat_raw(struct kds_sched *kds, char *buf, size_t buf_size, loff_t offset);
 ssize_t kds_create_cu_string(struct xrt_cu *xcu, char (*buf)[MAX_CU_STAT_LINE_LENGTH],
                 int slot, int idx, u64 usage_count, enum kds_type type);
 #endif
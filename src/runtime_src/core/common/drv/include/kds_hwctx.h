@@ -14,6 +14,7 @@
 #define _KDS_HWCTX_H
 
 #include <linux/list.h>
+#include <linux/wait.h>
 
 #include "kds_client.h"
 
@@ -48,8 +49,37 @@ struct kds_client_hw_ctx {
 	 * 2. do not need to worry about cache false share
 	 */
 	struct client_stats __percpu	*stats;
+
+	/* CU selection policy of this context, enum kds_cu_policy */
+	u32				cu_policy;
+	/* Priority of commands of this context, enum kds_priority */
+	u32				priority;
+	/* Completion interrupt moderation, enum kds_intr_mod */
+	u32				intr_mod;
+
+	/* Fair share weight of this context on a shared CU, see process_rq() */
+	u32				weight;
+	/* Max outstanding CU commands, 0 for unlimited */
+	u32				max_outstanding;
+	atomic_t			outstanding;
+	wait_queue_head_t		depth_wq;
+	/* Longest wait of a command in CU run queue */
+	u64				max_wait_ns;
 };
 
+/* Default fair share weight of a hw context */
+#define KDS_DEFAULT_WEIGHT	1
+
+/* Release the queue depth taken by kds_cu_dispatch() */
+static inline void kds_hw_ctx_put_depth(struct kds_client_hw_ctx *hw_ctx)
+{
+	if (!hw_ctx || !hw_ctx->max_outstanding)
+		return;
+
+	atomic_dec(&hw_ctx->outstanding);
+	wake_up(&hw_ctx->depth_wq);
+}
+
 struct kds_sched;
 
 struct kds_client_cu_ctx *
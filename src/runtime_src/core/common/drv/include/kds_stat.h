@@ -36,10 +36,31 @@ struct client_stats {
 	unsigned long		scu_s_cnt[MAX_CUS];
 	/* Per soft CU counter that counts when a command is completed or error */
 	unsigned long		scu_c_cnt[MAX_CUS];
+	/* Total time commands waited in CU run queues */
+	u64			wait_ns;
+	/* Commands blocked by the queue depth cap of the context */
+	unsigned long		throttled;
+};
+
+/*
+ * CU selection policies, see acquire_cu_idx().
+ * KDS_CU_POLICY_DEFAULT means "use the device wide policy".
+ */
+enum kds_cu_policy {
+	KDS_CU_POLICY_DEFAULT = 0,
+	/* CU with the least number of commands ever dispatched (legacy) */
+	KDS_CU_POLICY_USAGE,
+	/* CU with the least number of outstanding commands */
+	KDS_CU_POLICY_QUEUE,
+	/* CU with the least expected wait, based on EWMA of service time */
+	KDS_CU_POLICY_EWMA,
+	KDS_CU_POLICY_NUM,
 };
 
 struct cu_stats {
 	u64		  usage[MAX_CUS];
+	/* Per policy counter of multi-CU selections */
+	u64		  policy_dispatch[KDS_CU_POLICY_NUM];
 };
 
 /*
@@ -58,6 +79,9 @@ struct cu_stats {
 #define this_stat_dec(statp, field) \
 	this_cpu_add((statp)->field, -1)
 
+#define this_stat_add(statp, field, val) \
+	this_cpu_add((statp)->field, val)
+
 #define stat_read(statp, field)					\
 ({								\
 	typeof((statp)->field) res = 0;				\
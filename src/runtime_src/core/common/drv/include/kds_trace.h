@@ -0,0 +1,99 @@
+/* SPDX-License-Identifier: GPL-2.0 OR Apache-2.0 */
+/*
+ * Xilinx Kernel Driver Scheduler tracepoints
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * This file is dual-licensed; you may select either the GNU General Public
+ * License version 2 or Apache License, Version 2.0.
+ *
+ * The tracepoints follow a command from kds_add_command() through the
+ * CU run, submitted and completed queues.  Commands are identified by
+ * the kds_command pointer and the exec BO handle, the latter matches
+ * the xclExecBuf USDT probe in userspace.  E.g.
+ *
+ *   bpftrace -e 'tracepoint:xrt:kds_add_command { @s[args->cmd] = nsecs; }
+ *     tracepoint:xrt:xrt_cu_cq /@s[args->cmd]/ {
+ *       @us = hist((nsecs - @s[args->cmd]) / 1000); delete(@s[args->cmd]); }'
+ */
+
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM xrt
+
+#if !defined(_KDS_TRACE_H) || defined(TRACE_HEADER_MULTI_READ)
+#define _KDS_TRACE_H
+
+#include <linux/tracepoint.h>
+#include "kds_command.h"
+#include "xrt_cu.h"
+
+TRACE_EVENT(kds_add_command,
+	TP_PROTO(struct kds_command *xcmd),
+	TP_ARGS(xcmd),
+	TP_STRUCT__entry(
+		__field(u64, cmd)
+		__field(u32, exec_bo)
+		__field(u32, hw_ctx_id)
+		__field(u32, type)
+		__field(u32, opcode)
+	),
+	TP_fast_assign(
+		__entry->cmd = (uintptr_t)xcmd;
+		__entry->exec_bo = xcmd->exec_bo_handle;
+		__entry->hw_ctx_id = xcmd->hw_ctx_id;
+		__entry->type = xcmd->type;
+		__entry->opcode = xcmd->opcode;
+	),
+	TP_printk("cmd=0x%llx exec_bo=%u hw_ctx=%u type=%u opcode=%u",
+		  __entry->cmd, __entry->exec_bo, __entry->hw_ctx_id,
+		  __entry->type, __entry->opcode)
+);
+
+DECLARE_EVENT_CLASS(xrt_cu_cmd,
+	TP_PROTO(struct xrt_cu *xcu, struct kds_command *xcmd),
+	TP_ARGS(xcu, xcmd),
+	TP_STRUCT__entry(
+		__field(u64, cmd)
+		__field(u32, exec_bo)
+		__field(u32, slot)
+		__field(int, cu_idx)
+		__field(u32, status)
+	),
+	TP_fast_assign(
+		__entry->cmd = (uintptr_t)xcmd;
+		__entry->exec_bo = xcmd->exec_bo_handle;
+		__entry->slot = xcu->info.slot_idx;
+		__entry->cu_idx = xcu->info.cu_idx;
+		__entry->status = xcmd->status;
+	),
+	TP_printk("cmd=0x%llx exec_bo=%u slot=%u cu=%d status=%u",
+		  __entry->cmd, __entry->exec_bo, __entry->slot,
+		  __entry->cu_idx, __entry->status)
+);
+
+/* Command started on the CU */
+DEFINE_EVENT(xrt_cu_cmd, xrt_cu_rq,
+	TP_PROTO(struct xrt_cu *xcu, struct kds_command *xcmd),
+	TP_ARGS(xcu, xcmd)
+);
+
+/* CU reported the command done */
+DEFINE_EVENT(xrt_cu_cmd, xrt_cu_sq,
+	TP_PROTO(struct xrt_cu *xcu, struct kds_command *xcmd),
+	TP_ARGS(xcu, xcmd)
+);
+
+/* Host is about to be notified */
+DEFINE_EVENT(xrt_cu_cmd, xrt_cu_cq,
+	TP_PROTO(struct xrt_cu *xcu, struct kds_command *xcmd),
+	TP_ARGS(xcu, xcmd)
+);
+
+#endif /* _KDS_TRACE_H */
+
+/* Found through the common/drv/include search path of the modules */
+#undef TRACE_INCLUDE_PATH
+#define TRACE_INCLUDE_PATH .
+#undef TRACE_INCLUDE_FILE
+#define TRACE_INCLUDE_FILE kds_trace
+#include <trace/define_trace.h>
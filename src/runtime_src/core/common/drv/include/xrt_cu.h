@@ -32,14 +32,33 @@
  * Small value leads to lower performance on APU.
  */
 #define MAX_CU_LOOP 300
+/* Default prio_weight, see process_rq() */
+#define CU_DEFAULT_PRIO_WEIGHT 4
+/* Max distinct clients of one completion batch, see process_cq() */
+#define XCU_MAX_WAKE_CLIENTS 8
+/* Fair share flows tracked per CU, more hw contexts share the first one */
+#define CU_MAX_FLOWS 16
+/* Interrupt wakeups on another CPU before the CU irq follows the thread */
+#define CU_IRQ_STEER_MISS 32
 
 /* If poll count reach this threashold, switch to interrupt mode */
 #if defined(CONFIG_ARM64)
 #define CU_DEFAULT_POLL_THRESHOLD 30 /* About 60 us on APU */
+#define CU_POLL_LOOP_NS 2000
 #else
 #define CU_DEFAULT_POLL_THRESHOLD 300 /* About 75 us on host */
+#define CU_POLL_LOOP_NS 250
 #endif
 
+/* Adaptive polling, see xrt_cu_adaptive_threshold() */
+/* Expected wait longer than this is better served by interrupt */
+#define CU_ADAPTIVE_MAX_POLL_NS \
+	(4ULL * CU_DEFAULT_POLL_THRESHOLD * CU_POLL_LOOP_NS)
+/* Do not bother sleeping the KDS polling thread for shorter */
+#define CU_ADAPTIVE_MIN_SLEEP_NS 10000
+/* log2 microsecond buckets of command latency, last one is open */
+#define CU_LAT_HIST_BUCKETS 16
+
 /* The normal CU in ip_layout would assign a interrupt
  * ID in range 0 to 127. Use 128 for m2m cu could ensure
  * m2m CU is at the end of the CU, which is compatible with
@@ -156,6 +175,15 @@ struct xcu_funcs {
 	 */
 	void (*start)(void *core);
 
+	/**
+	 * @flush:
+	 *
+	 * Optional. Called once no more commands could be started, for CU
+	 * that batches started commands (e.g. a single doorbell for several
+	 * XGQ entries).
+	 */
+	void (*flush)(void *core);
+
 	/**
 	 * @check:
 	 *
@@ -316,6 +344,34 @@ struct xrt_cu_stats {
 
 };
 
+/*
+ * Commands of one hw context in the CU run queue. Flows are served in
+ * deficit round robin order, see process_rq().
+ */
+struct xrt_cu_flow {
+	void			 *key;
+	u32			  weight;
+	u32			  deficit;
+	u32			  num;
+};
+
+struct xrt_cu_lat_hist {
+	u64			   bucket[CU_LAT_HIST_BUCKETS];
+};
+
+/*
+ * Timestamp for always-on statistics. Fast clock could be off by a few
+ * ns across CPUs, which does not matter in microsecond buckets.
+ */
+static inline u64 xrt_cu_fast_ns(void)
+{
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(3, 17, 0)
+	return ktime_get_mono_fast_ns();
+#else
+	return ktime_to_ns(ktime_get());
+#endif
+}
+
 /* Supported event type */
 struct xrt_cu {
 	struct device		 *dev;
@@ -326,8 +382,11 @@ struct xrt_cu {
 	struct xrt_cu_range	  read_regs;
 	/* pending queue */
 	struct list_head	  pq;
+	/* high priority class commands, counted in num_pq */
+	struct list_head	  ppq;
 	spinlock_t		  pq_lock;
 	u32			  num_pq;
+	u32			  num_ppq;
 	/* high priority queue */
 	struct list_head	  hpq;
 	spinlock_t		  hpq_lock;
@@ -342,6 +401,16 @@ struct xrt_cu {
 	/* run queue */
 	struct list_head	  rq ____cacheline_aligned_in_smp;
 	u32			  num_rq;
+	/* high priority class run queue, counted in num_rq */
+	struct list_head	  prq;
+	u32			  num_prq;
+	/* Start this many priority commands in a row before a normal one */
+	u32			  prio_weight;
+	u32			  prio_streak;
+	/* Fair share of run queue across hw contexts */
+	struct xrt_cu_flow	  flows[CU_MAX_FLOWS];
+	u32			  num_flows;
+	u32			  flow_cur;
 	/* submitted queue */
 	u32			  num_sq;
 	/* completed queue */
@@ -369,6 +438,29 @@ struct xrt_cu {
 	u32			  start_tick;
 	u32			  force_intr;
 
+	/* EWMA of command execution time, used by KDS_CU_POLICY_EWMA */
+	u64			  ewma_service_ns;
+
+	/* Clients having completions but not woken yet. Only touched by
+	 * the thread completing commands.
+	 */
+	struct kds_client	 *wake_clients[XCU_MAX_WAKE_CLIENTS];
+	u32			  num_wake;
+	u64			  wake_deadline;
+	/* Hold wakeups up to this long while polling, 0 means per batch */
+	u64			  wake_window_ns;
+
+	/* Adaptive polling and its statistics */
+	u32			  adaptive_poll;
+	u64			  next_poll_ns;
+	u64			  poll_ns;
+
+	/* Always-on latency statistics, updated by process_cq() */
+	struct xrt_cu_lat_hist	  queue_hist;	/* submitted to started */
+	struct xrt_cu_lat_hist	  exec_hist;	/* started to completed */
+	/* Total execution time of completed commands */
+	u64			  exec_ns;
+
 	struct xrt_cu_stats        stats;
 	/**
 	 * @funcs:
@@ -393,6 +485,10 @@ struct xrt_cu {
 	atomic_t		   ucu_event;
 	int (* user_manage_irq)(struct xrt_cu *xcu, bool user_manage);
 	int (* configure_irq)(struct xrt_cu *xcu, bool enable);
+	/* Optional, move the CU irq to cpu. See xrt_cu_steer_irq() */
+	int (* steer_irq)(struct xrt_cu *xcu, int cpu);
+	int			   irq_cpu;
+	u32			   irq_cpu_miss;
 
 	/* For debug/analysis */
 	char			   debug;
@@ -440,6 +536,12 @@ static inline void xrt_cu_start(struct xrt_cu *xcu)
 	xcu->funcs->start(xcu->core);
 }
 
+static inline void xrt_cu_flush(struct xrt_cu *xcu)
+{
+	if (xcu->funcs->flush)
+		xcu->funcs->flush(xcu->core);
+}
+
 static inline int xrt_cu_submit_config(struct xrt_cu *xcu, struct kds_command *xcmd)
 {
 	if (!xcu->funcs->submit_config)
@@ -561,6 +663,10 @@ int  xrt_cu_init(struct xrt_cu *xcu);
 void xrt_cu_fini(struct xrt_cu *xcu);
 
 ssize_t show_cu_stat(struct xrt_cu *xcu, char *buf);
+ssize_t show_cu_poll_stat(struct xrt_cu *xcu, char *buf);
+ssize_t show_cu_lat_hist(struct xrt_cu *xcu, char *buf);
+void xrt_cu_set_adaptive_poll(struct xrt_cu *xcu, bool enable);
+u64 xrt_cu_poll_deadline(struct xrt_cu *xcu);
 ssize_t show_cu_info(struct xrt_cu *xcu, char *buf);
 ssize_t show_formatted_cu_stat(struct xrt_cu *xcu, char *buf);
 ssize_t show_stats_begin(struct xrt_cu *xcu, char *buf);
@@ -603,6 +709,8 @@ struct xrt_cu_fa {
 	u32			 slot_sz;
 	u32			 num_slots;
 	u32			 head_slot;
+	u32			 pending_slot;	/* first started, not yet queued */
+	u32			 pending;	/* started descriptors to queue on flush */
 	u32			 desc_msw;
 	u32			 task_cnt;
 	int			 max_credits;
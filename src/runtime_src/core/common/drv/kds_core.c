@@ -19,8 +19,12 @@
 #include <linux/fs.h>
 #include <linux/poll.h>
 #include <linux/anon_inodes.h>
+#include <linux/math64.h>
 #include "kds_core.h"
 
+#define CREATE_TRACE_POINTS
+#include "kds_trace.h"
+
 /* for sysfs */
 int store_kds_echo(struct kds_sched *kds, const char *buf, size_t count,
 		   int *echo)
@@ -138,6 +142,65 @@ ssize_t show_kds_custat_raw(struct kds_sched *kds, char *buf, size_t buf_size, l
 	return sz;
 }
 
+static ssize_t kds_create_cu_lat_string(struct xrt_cu *xcu, char *buf,
+					size_t buf_size, int slot, int idx)
+{
+	ssize_t sz = 0;
+	int i;
+
+	/* Each line is a CU, format:
+	 * "slot,cu_idx,queue buckets,execute buckets"
+	 * Buckets are space separated log2 microsecond histogram.
+	 */
+	sz += scnprintf(buf+sz, buf_size - sz, "%d,%d,", slot,
+			set_domain(DOMAIN_PL, idx));
+	for (i = 0; i < CU_LAT_HIST_BUCKETS; i++)
+		sz += scnprintf(buf+sz, buf_size - sz, "%s%llu", i ? " " : "",
+				xcu->queue_hist.bucket[i]);
+	sz += scnprintf(buf+sz, buf_size - sz, ",");
+	for (i = 0; i < CU_LAT_HIST_BUCKETS; i++)
+		sz += scnprintf(buf+sz, buf_size - sz, "%s%llu", i ? " " : "",
+				xcu->exec_hist.bucket[i]);
+	sz += scnprintf(buf+sz, buf_size - sz, "\n");
+
+	return sz;
+}
+
+ssize_t show_kds_culat_raw(struct kds_sched *kds, char *buf, size_t buf_size, loff_t offset)
+{
+	struct kds_cu_mgmt *cu_mgmt = &kds->cu_mgmt;
+	char cu_buf[MAX_CU_LAT_LINE_LENGTH];
+	struct xrt_cu *xcu = NULL;
+	ssize_t all_cu_sz = 0;
+	ssize_t cu_sz = 0;
+	ssize_t sz = 0;
+	int i = 0;
+	int j = 0;
+
+	mutex_lock(&cu_mgmt->lock);
+	for (j = 0; j < MAX_SLOT; ++j) {
+		for (i = 0; i < MAX_CUS; ++i) {
+			xcu = cu_mgmt->xcus[i];
+			if (!xcu || xcu->info.slot_idx != j)
+				continue;
+
+			cu_sz = kds_create_cu_lat_string(xcu, cu_buf,
+							 sizeof(cu_buf), j, i);
+			all_cu_sz += cu_sz;
+			/* Same offset handling as kds_populate_cu_buf() */
+			if (all_cu_sz > offset) {
+				if (sz + cu_sz > buf_size)
+					goto out;
+				sz += scnprintf(buf+sz, buf_size - sz, "%s", cu_buf);
+			}
+		}
+	}
+out:
+	mutex_unlock(&cu_mgmt->lock);
+
+	return sz;
+}
+
 ssize_t show_kds_scustat_raw(struct kds_sched *kds, char *buf, size_t buf_size, loff_t offset)
 {
 	struct kds_cu_mgmt *scu_mgmt = &kds->scu_mgmt;
@@ -150,12 +213,257 @@ ssize_t show_kds_scustat_raw(struct kds_sched *kds, char *buf, size_t buf_size,
 	return sz;
 }
 
+ssize_t show_kds_cubusy_raw(struct kds_sched *kds, char *buf, size_t buf_size, loff_t offset)
+{
+	struct kds_cu_mgmt *cu_mgmt = &kds->cu_mgmt;
+	char cu_buf[MAX_CU_STAT_LINE_LENGTH];
+	struct xrt_cu *xcu = NULL;
+	ssize_t all_cu_sz = 0;
+	ssize_t cu_sz = 0;
+	ssize_t sz = 0;
+	u32 queued;
+	int i = 0;
+	int j = 0;
+
+	mutex_lock(&cu_mgmt->lock);
+	for (j = 0; j < MAX_SLOT; ++j) {
+		for (i = 0; i < MAX_CUS; ++i) {
+			xcu = cu_mgmt->xcus[i];
+			if (!xcu || xcu->info.slot_idx != j)
+				continue;
+
+			/* Each line is a CU, format:
+			 * "slot,cu_idx,exec_ns,queued"
+			 * exec_ns is the total execution time of completed
+			 * commands, queued the commands not completed yet.
+			 */
+			queued = READ_ONCE(xcu->num_pq) + READ_ONCE(xcu->num_rq) +
+				 READ_ONCE(xcu->num_sq);
+			cu_sz = scnprintf(cu_buf, sizeof(cu_buf), "%d,%d,%llu,%u\n",
+					  j, set_domain(DOMAIN_PL, i),
+					  READ_ONCE(xcu->exec_ns), queued);
+			all_cu_sz += cu_sz;
+			/* Same offset handling as kds_populate_cu_buf() */
+			if (all_cu_sz > offset) {
+				if (sz + cu_sz > buf_size)
+					goto out;
+				sz += scnprintf(buf+sz, buf_size - sz, "%s", cu_buf);
+			}
+		}
+	}
+out:
+	mutex_unlock(&cu_mgmt->lock);
+
+	return sz;
+}
+
+ssize_t show_kds_client_stat_raw(struct kds_sched *kds, char *buf, size_t buf_size, loff_t offset)
+{
+	struct kds_client_hw_ctx *curr;
+	struct kds_client *client;
+	unsigned long started, completed;
+	ssize_t all_sz = 0;
+	ssize_t line_sz;
+	ssize_t sz = 0;
+	char *line;
+	int i;
+
+	line = kmalloc(PAGE_SIZE, GFP_KERNEL);
+	if (!line)
+		return -ENOMEM;
+
+	mutex_lock(&kds->lock);
+	list_for_each_entry(client, &kds->clients, link) {
+		list_for_each_entry(curr, &client->hw_ctx_list, link) {
+			/* Each line is a hw context, format:
+			 * "pid,ctx,outstanding,cu_idx:started:completed ..."
+			 * Only CUs the context has used are listed.
+			 */
+			line_sz = scnprintf(line, PAGE_SIZE, "%d,%d,%d,",
+					    pid_nr(client->pid), curr->hw_ctx_idx,
+					    atomic_read(&curr->outstanding));
+			for (i = 0; i < MAX_CUS; ++i) {
+				started = stat_read(curr->stats, s_cnt[i]);
+				if (!started)
+					continue;
+				completed = stat_read(curr->stats, c_cnt[i]);
+				line_sz += scnprintf(line + line_sz, PAGE_SIZE - line_sz,
+						     "%d:%lu:%lu ", set_domain(DOMAIN_PL, i),
+						     started, completed);
+			}
+			line_sz += scnprintf(line + line_sz, PAGE_SIZE - line_sz, "\n");
+
+			all_sz += line_sz;
+			/* Same offset handling as kds_populate_cu_buf() */
+			if (all_sz > offset) {
+				if (sz + line_sz > buf_size)
+					goto out;
+				sz += scnprintf(buf+sz, buf_size - sz, "%s", line);
+			}
+		}
+	}
+out:
+	mutex_unlock(&kds->lock);
+	kfree(line);
+
+	return sz;
+}
+
+static const char *kds_cu_policy_names[KDS_CU_POLICY_NUM] = {
+	[KDS_CU_POLICY_DEFAULT]	= "default",
+	[KDS_CU_POLICY_USAGE]	= "usage",
+	[KDS_CU_POLICY_QUEUE]	= "queue",
+	[KDS_CU_POLICY_EWMA]	= "ewma",
+};
+
+const char *kds_cu_policy_name(u32 policy)
+{
+	if (policy >= KDS_CU_POLICY_NUM)
+		return "unknown";
+	return kds_cu_policy_names[policy];
+}
+
+int kds_parse_cu_policy(const char *buf)
+{
+	int i;
+
+	for (i = KDS_CU_POLICY_USAGE; i < KDS_CU_POLICY_NUM; i++) {
+		if (sysfs_streq(buf, kds_cu_policy_names[i]))
+			return i;
+	}
+	return -EINVAL;
+}
+
+/**
+ * kds_set_wake_window - Set completion wakeup coalescing window
+ *
+ * @kds: KDS
+ * @window: Window in microseconds, 0 to wake once per completion batch
+ */
+void kds_set_wake_window(struct kds_sched *kds, u32 window)
+{
+	struct kds_cu_mgmt *mgmts[] = { &kds->cu_mgmt, &kds->scu_mgmt };
+	struct kds_cu_mgmt *cu_mgmt;
+	int i, j;
+
+	kds->wake_window = window;
+	for (j = 0; j < ARRAY_SIZE(mgmts); j++) {
+		cu_mgmt = mgmts[j];
+		mutex_lock(&cu_mgmt->lock);
+		for (i = 0; i < MAX_CUS; i++) {
+			if (!cu_mgmt->xcus[i])
+				continue;
+			WRITE_ONCE(cu_mgmt->xcus[i]->wake_window_ns,
+				   (u64)window * NSEC_PER_USEC);
+		}
+		mutex_unlock(&cu_mgmt->lock);
+	}
+}
+
+/* Moderation is off for a CU while a context that opted out has it open */
+static void kds_apply_cu_intr_mod(struct kds_sched *kds, u32 cu_idx)
+{
+	u32 count = kds->intr_count;
+	u32 cycles = kds->intr_cycles;
+
+	if (!kds->xgq_enable || !kds->set_cu_intr_mod)
+		return;
+
+	mutex_lock(&kds->intr_mod_lock);
+	if (READ_ONCE(kds->cu_mgmt.intr_mod_off[cu_idx]))
+		count = cycles = 0;
+	kds->set_cu_intr_mod(kds, cu_idx, count, cycles);
+	mutex_unlock(&kds->intr_mod_lock);
+}
+
+static void kds_cu_intr_mod_ref(struct kds_sched *kds,
+				struct kds_client_cu_ctx *cu_ctx, bool get)
+{
+	struct kds_cu_mgmt *cu_mgmt = &kds->cu_mgmt;
+	u32 cu_idx = cu_ctx->cu_idx;
+	bool changed;
+
+	if (cu_ctx->cu_domain != DOMAIN_PL || !cu_ctx->hw_ctx ||
+	    cu_ctx->hw_ctx->intr_mod != KDS_INTR_MOD_OFF)
+		return;
+
+	mutex_lock(&cu_mgmt->lock);
+	if (get)
+		changed = (cu_mgmt->intr_mod_off[cu_idx]++ == 0);
+	else
+		changed = (--cu_mgmt->intr_mod_off[cu_idx] == 0);
+	mutex_unlock(&cu_mgmt->lock);
+
+	if (changed)
+		kds_apply_cu_intr_mod(kds, cu_idx);
+}
+
+/**
+ * kds_set_intr_mod - Set ERT CU completion interrupt moderation
+ *
+ * @kds: KDS
+ * @count: Completions per interrupt, 0 or 1 to disable
+ * @cycles: ERT clock cycles a completion may wait for its interrupt
+ *
+ * Applies to all CUs now and to CUs of later xclbins.
+ */
+void kds_set_intr_mod(struct kds_sched *kds, u32 count, u32 cycles)
+{
+	int i;
+
+	kds->intr_count = count;
+	kds->intr_cycles = cycles;
+	for (i = 0; i < MAX_CUS; i++) {
+		if (kds->cu_mgmt.xcus[i])
+			kds_apply_cu_intr_mod(kds, i);
+	}
+}
+
+/* Fair share settings and CU run queue wait of each hw context */
+static ssize_t
+kds_show_client_wait(struct kds_sched *kds, char *buf, size_t buf_size)
+{
+	char *fmt = "  pid(%d) ctx(%d) weight(%d) depth(%d/%d) started(%llu) "
+		    "wait avg(%lluns) max(%lluns) throttled(%lu)\n";
+	struct kds_client_hw_ctx *curr;
+	struct kds_client *client;
+	unsigned long started;
+	u64 wait;
+	ssize_t sz = 0;
+	int i;
+
+	mutex_lock(&kds->lock);
+	sz += scnprintf(buf+sz, buf_size - sz, "Number of clients: %d\n",
+			kds->num_client);
+	list_for_each_entry(client, &kds->clients, link) {
+		list_for_each_entry(curr, &client->hw_ctx_list, link) {
+			started = 0;
+			for (i = 0; i < MAX_CUS; ++i)
+				started += stat_read(curr->stats, s_cnt[i]);
+			wait = stat_read(curr->stats, wait_ns);
+			sz += scnprintf(buf+sz, buf_size - sz, fmt,
+					pid_nr(client->pid), curr->hw_ctx_idx,
+					curr->weight,
+					atomic_read(&curr->outstanding),
+					curr->max_outstanding, (u64)started,
+					(started) ? div64_u64(wait, started) : 0,
+					READ_ONCE(curr->max_wait_ns),
+					stat_read(curr->stats, throttled));
+		}
+	}
+	mutex_unlock(&kds->lock);
+
+	return sz;
+}
+
 ssize_t show_kds_stat(struct kds_sched *kds, char *buf)
 {
 	struct kds_cu_mgmt *cu_mgmt = &kds->cu_mgmt;
-	char *cu_fmt = "  CU[%d] usage(%llu) shared(%d) refcnt(%d) intr(%s)\n";
+	char *cu_fmt = "  CU[%d] usage(%llu) shared(%d) refcnt(%d) intr(%s) path(%s)\n";
+	u64 path_usage[2] = {0};
 	ssize_t sz = 0;
 	bool shared;
+	bool ert;
 	int ref;
 	int i;
 
@@ -163,6 +471,12 @@ ssize_t show_kds_stat(struct kds_sched *kds, char *buf)
 	sz += scnprintf(buf+sz, PAGE_SIZE - sz,
 			"CU to host interrupt capability: %d\n",
 			kds->cu_intr_cap);
+	sz += scnprintf(buf+sz, PAGE_SIZE - sz,
+			"CU policy: %s dispatch usage(%llu) queue(%llu) ewma(%llu)\n",
+			kds_cu_policy_name(cu_mgmt->cu_policy),
+			cu_stat_read(cu_mgmt, policy_dispatch[KDS_CU_POLICY_USAGE]),
+			cu_stat_read(cu_mgmt, policy_dispatch[KDS_CU_POLICY_QUEUE]),
+			cu_stat_read(cu_mgmt, policy_dispatch[KDS_CU_POLICY_EWMA]));
 	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "Interrupt mode: %s\n",
 			(KDS_SETTING(kds->cu_intr))? "cu" : "ert");
 	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "Number of CUs: %d\n",
@@ -173,10 +487,15 @@ ssize_t show_kds_stat(struct kds_sched *kds, char *buf)
 
 		shared = !(cu_mgmt->cu_refs[i] & CU_EXCLU_MASK);
 		ref = cu_mgmt->cu_refs[i] & ~CU_EXCLU_MASK;
+		ert = (cu_mgmt->xcus[i]->info.model == XCU_XGQ);
+		path_usage[ert] += cu_stat_read(cu_mgmt, usage[i]);
 		sz += scnprintf(buf+sz, PAGE_SIZE - sz, cu_fmt, i,
 				cu_stat_read(cu_mgmt, usage[i]), shared, ref,
-				(cu_mgmt->cu_intr[i])? "enable" : "disable");
+				(cu_mgmt->cu_intr[i])? "enable" : "disable",
+				ert ? "ert" : "host");
 	}
+	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "CU usage by path: ert(%llu) host(%llu)\n",
+			path_usage[1], path_usage[0]);
 	mutex_unlock(&cu_mgmt->lock);
 
 	/* Populate the SCUs information */
@@ -198,6 +517,8 @@ ssize_t show_kds_stat(struct kds_sched *kds, char *buf)
 
 	mutex_unlock(&cu_mgmt->lock);
 
+	sz += kds_show_client_wait(kds, buf + sz, PAGE_SIZE - sz);
+
 	return sz;
 }
 /* sysfs end */
@@ -220,25 +541,67 @@ static int kds_polling_thread(void *data)
 {
 	struct kds_sched *kds = (struct kds_sched *)data;
 	int busy_cnt = 0;
+	int ready_cnt = 0;
 	int loop_cnt = 0;
 
 	while (!kds->polling_stop) {
 		struct xrt_cu *xcu;
+		u64 earliest = U64_MAX;
+		u64 deadline;
+		u64 begin;
+		u64 now;
+		int ret;
 		busy_cnt = 0;
+		/* Busy CUs that need to be looked at right away */
+		ready_cnt = 0;
 
+		now = ktime_get_ns();
 		list_for_each_entry(xcu, &kds->alive_cus, cu) {
 			if (xcu->thread)
 				continue;
 
-			if (xrt_cu_process_queues(xcu) == XCU_BUSY)
+			/* Adaptive CU that can not make progress until its
+			 * next completion is skipped until then.
+			 */
+			if (xcu->next_poll_ns > now) {
+				earliest = min(earliest, xcu->next_poll_ns);
 				busy_cnt += 1;
+				continue;
+			}
+
+			begin = (xcu->adaptive_poll) ? ktime_get_ns() : 0;
+			ret = xrt_cu_process_queues(xcu);
+			if (begin)
+				xcu->poll_ns += ktime_get_ns() - begin;
+
+			if (ret != XCU_BUSY) {
+				xcu->next_poll_ns = 0;
+				continue;
+			}
+
+			busy_cnt += 1;
+			deadline = xrt_cu_poll_deadline(xcu);
+			xcu->next_poll_ns = deadline;
+			if (deadline)
+				earliest = min(earliest, deadline);
+			else
+				ready_cnt += 1;
 		}
 
 		/* If kds->interval is 0, keep poling CU without sleeping.
 		 * If kds->interval is greater than 0, this thread will sleep
 		 * interval to interval + 3 microseconds.
+		 * If every busy CU is waiting for a completion that is not
+		 * expected yet, sleep until the earliest one.
 		 */
-		if (kds->interval > 0)
+		if (busy_cnt && !ready_cnt && earliest != U64_MAX) {
+			/* New command on other CUs still wakes us up */
+			now = ktime_get_ns();
+			if (earliest > now)
+				wait_event_interruptible_hrtimeout(kds->wait_queue,
+					kds_wake_up_poll(kds),
+					ns_to_ktime(earliest - now));
+		} else if (kds->interval > 0)
 			usleep_range(kds->interval, kds->interval + 3);
 
 		/* Avoid large num_rq leads to more 120 sec blocking */
@@ -402,6 +765,68 @@ kds_client_set_cu_refs_zero(struct kds_client *client, int domain)
 	return ret;
 }
 
+/* Lockless like client_stat_inc(), hw context outlives its commands */
+static struct kds_client_hw_ctx *
+kds_find_hw_ctx(struct kds_client *client, u32 hw_ctx)
+{
+	struct kds_client_hw_ctx *curr_ctx;
+
+	list_for_each_entry(curr_ctx, &client->hw_ctx_list, link) {
+		if (curr_ctx->hw_ctx_idx == hw_ctx)
+			return curr_ctx;
+	}
+
+	return NULL;
+}
+
+/**
+ * select_cu_idx - Pick the cheapest CU among valid CUs
+ *
+ * @cu_mgmt: CU management
+ * @policy: CU selection policy
+ * @valid_cus: Candidate CU indexes
+ * @num_valid: Number of candidates
+ *
+ * Returns: Selected CU index
+ */
+static int8_t
+select_cu_idx(struct kds_cu_mgmt *cu_mgmt, u32 policy, uint8_t *valid_cus,
+	      int num_valid)
+{
+	struct xrt_cu *xcu;
+	u64 outstanding;
+	u64 min_cost = U64_MAX;
+	u64 cost;
+	int8_t index = valid_cus[0];
+	int i;
+
+	for (i = 0; i < num_valid; ++i) {
+		xcu = cu_mgmt->xcus[valid_cus[i]];
+		/* Racy read of the queue lengths is fine, it is a hint */
+		outstanding = READ_ONCE(xcu->num_pq) + READ_ONCE(xcu->num_rq) +
+			      READ_ONCE(xcu->num_sq);
+		switch (policy) {
+		case KDS_CU_POLICY_QUEUE:
+			cost = outstanding;
+			break;
+		case KDS_CU_POLICY_EWMA:
+			/* CU without sample yet looks cheap, so it gets one */
+			cost = (outstanding + 1) *
+			       max_t(u64, READ_ONCE(xcu->ewma_service_ns), 1);
+			break;
+		default:
+			cost = cu_stat_read(cu_mgmt, usage[valid_cus[i]]);
+			break;
+		}
+		if (cost < min_cost) {
+			min_cost = cost;
+			index = valid_cus[i];
+		}
+	}
+
+	return index;
+}
+
 /**
  * acquire_cu_idx - Get ready CU index
  *
@@ -420,12 +845,16 @@ acquire_cu_idx(struct kds_cu_mgmt *cu_mgmt, int domain, struct kds_command *xcmd
 	/* After validation */
 	uint8_t valid_cus[MAX_CUS];
 	int num_valid = 0;
+	struct kds_client_hw_ctx *ctx;
 	int8_t index;
-	u64 usage;
-	u64 min_usage;
+	u32 policy;
 	int cu_set;
 	int i;
 
+	ctx = kds_find_hw_ctx(client, hw_ctx);
+	xcmd->hw_ctx = ctx;
+	xcmd->priority = (ctx) ? ctx->priority : KDS_PRIORITY_NORMAL;
+
 	num_marked = cu_mask_to_cu_idx(xcmd, user_cus);
 	if (unlikely(num_marked > cu_mgmt->num_cus)) {
 		kds_err(client, "Too many CUs in CU mask");
@@ -451,13 +880,10 @@ acquire_cu_idx(struct kds_cu_mgmt *cu_mgmt, int domain, struct kds_command *xcmd
 		return -EINVAL;
 	}
 
-	/* Find out the CU with minimum usage */
-	for (i = 1, index = valid_cus[0]; i < num_valid; ++i) {
-		usage = cu_stat_read(cu_mgmt, usage[valid_cus[i]]);
-		min_usage = cu_stat_read(cu_mgmt, usage[index]);
-		if (usage < min_usage)
-			index = valid_cus[i];
-	}
+	policy = (ctx && ctx->cu_policy != KDS_CU_POLICY_DEFAULT) ?
+		ctx->cu_policy : cu_mgmt->cu_policy;
+	index = select_cu_idx(cu_mgmt, policy, valid_cus, num_valid);
+	cu_stat_inc(cu_mgmt, policy_dispatch[policy]);
 
 out:
 	if (xrt_cu_get_protocol(cu_mgmt->xcus[index]) == CTRL_NONE) {
@@ -494,16 +920,47 @@ out:
 	return index;
 }
 
+/**
+ * kds_get_depth - Wait for room under the queue depth cap of hw context
+ *
+ * @ctx: hw context of the command
+ *
+ * Returns: 0 when the command may go, -ERESTARTSYS if interrupted.
+ * Released by kds_hw_ctx_put_depth() when the command completes.
+ */
+static int
+kds_get_depth(struct kds_client_hw_ctx *ctx)
+{
+	if (atomic_add_unless(&ctx->outstanding, 1, ctx->max_outstanding))
+		return 0;
+
+	this_stat_inc(ctx->stats, throttled);
+	return wait_event_interruptible(ctx->depth_wq,
+		atomic_add_unless(&ctx->outstanding, 1, ctx->max_outstanding));
+}
+
 static int
 kds_cu_dispatch(struct kds_cu_mgmt *cu_mgmt, int domain, struct kds_command *xcmd)
 {
+	struct kds_client_hw_ctx *ctx;
 	int cu_idx = 0;
+	int ret;
+
+	/* A tenant flooding a shared CU waits here instead of the others */
+	ctx = kds_find_hw_ctx(xcmd->client, xcmd->hw_ctx_id);
+	if (ctx && ctx->max_outstanding) {
+		ret = kds_get_depth(ctx);
+		if (ret)
+			return ret;
+	}
 
 	do {
 		cu_idx = acquire_cu_idx(cu_mgmt, domain, xcmd);
 	} while (cu_idx == -EAGAIN);
-	if (cu_idx < 0)
+	if (cu_idx < 0) {
+		kds_hw_ctx_put_depth(ctx);
 		return cu_idx;
+	}
 
 	xrt_cu_submit(cu_mgmt->xcus[cu_idx], xcmd);
 	set_xcmd_timestamp(xcmd, KDS_QUEUED);
@@ -960,6 +1417,8 @@ int kds_init_sched(struct kds_sched *kds)
 		kds->cu_mgmt.xcus[i] = NULL;
 		kds->scu_mgmt.xcus[i] = NULL;
 	}
+	kds->cu_mgmt.cu_policy = KDS_CU_POLICY_USAGE;
+	kds->scu_mgmt.cu_policy = KDS_CU_POLICY_USAGE;
 	kds->cu_mgmt.cu_stats = alloc_percpu(struct cu_stats);
 	if (!kds->cu_mgmt.cu_stats)
 		return -ENOMEM;
@@ -968,11 +1427,18 @@ int kds_init_sched(struct kds_sched *kds)
 	if (!kds->scu_mgmt.cu_stats)
 		return -ENOMEM;
 
+	/* Not fatal, commands are kzalloc'ed without the cache */
+	kds->cmd_cache = kmem_cache_create("kds_command",
+					   sizeof(struct kds_command) +
+					   KDS_CMD_INLINE_SIZE,
+					   0, SLAB_HWCACHE_ALIGN, NULL);
+
 	INIT_LIST_HEAD(&kds->clients);
 	INIT_LIST_HEAD(&kds->alive_cus);
 	mutex_init(&kds->lock);
 	mutex_init(&kds->cu_mgmt.lock);
 	mutex_init(&kds->scu_mgmt.lock);
+	mutex_init(&kds->intr_mod_lock);
 	kds->num_client = 0;
 	kds->bad_state = 0;
 	/* At this point, I don't know if ERT subdev exist or not */
@@ -991,16 +1457,32 @@ void kds_fini_sched(struct kds_sched *kds)
 	mutex_destroy(&kds->cu_mgmt.lock);
 
 	free_percpu(kds->cu_mgmt.cu_stats);
+
+	if (kds->cmd_cache) {
+		kmem_cache_destroy(kds->cmd_cache);
+		kds->cmd_cache = NULL;
+	}
 }
 
 struct kds_command *kds_alloc_command(struct kds_client *client, u32 size)
 {
+	struct kmem_cache *cache = NULL;
 	struct kds_command *xcmd;
 
-	xcmd = kzalloc(sizeof(struct kds_command), GFP_KERNEL);
+	if (client && client->kds)
+		cache = client->kds->cmd_cache;
+
+	/* Most payloads are a register map which fits in the inline area.
+	 * Those commands take a single slab object instead of two kzalloc.
+	 */
+	if (cache)
+		xcmd = kmem_cache_zalloc(cache, GFP_KERNEL);
+	else
+		xcmd = kzalloc(sizeof(struct kds_command), GFP_KERNEL);
 	if (!xcmd)
 		return NULL;
 
+	xcmd->cache = cache;
 	xcmd->client = client;
 	xcmd->type = 0;
 	xcmd->cu_idx = NO_INDEX;
@@ -1011,12 +1493,17 @@ struct kds_command *kds_alloc_command(struct kds_client *client, u32 size)
 	if (size == 0)
 		goto done;
 
+	xcmd->isize = size;
+	if (cache && size <= KDS_CMD_INLINE_SIZE) {
+		xcmd->info = xcmd->payload;
+		goto done;
+	}
+
 	xcmd->info = kzalloc(size, GFP_KERNEL);
 	if (!xcmd->info) {
-		kfree(xcmd);
+		kds_free_command(xcmd);
 		return NULL;
 	}
-	xcmd->isize = size;
 	xcmd->payload_alloc = 1;
 
 done:
@@ -1030,7 +1517,10 @@ void kds_free_command(struct kds_command *xcmd)
 
 	if (xcmd->payload_alloc)
 		kfree(xcmd->info);
-	kfree(xcmd);
+	if (xcmd->cache)
+		kmem_cache_free(xcmd->cache, xcmd);
+	else
+		kfree(xcmd);
 }
 
 int kds_add_command(struct kds_sched *kds, struct kds_command *xcmd)
@@ -1041,6 +1531,8 @@ int kds_add_command(struct kds_sched *kds, struct kds_command *xcmd)
 	BUG_ON(!xcmd->cb.notify_host);
 	BUG_ON(!xcmd->cb.free);
 
+	trace_kds_add_command(xcmd);
+
 	/* TODO: Check if command is blocked */
 
 	/* Command is good to submit */
@@ -1102,8 +1594,10 @@ int kds_init_client(struct kds_sched *kds, struct kds_client *client)
 		return -ENOMEM;
 	}
 
+	client->kds = kds;
 	client->pid = get_pid(task_pid(current));
 	mutex_init(&client->lock);
+	mutex_init(&client->ring_lock);
 	mutex_init(&client->refcnt->lock);
 	init_waitqueue_head(&client->waitq);
 	atomic_set(&client->event, 0);
@@ -1186,6 +1680,7 @@ void kds_fini_client(struct kds_sched *kds, struct kds_client *client)
 
 	put_pid(client->pid);
 	mutex_destroy(&client->lock);
+	mutex_destroy(&client->ring_lock);
 
 	mutex_lock(&kds->lock);
 	list_del(&client->link);
@@ -1234,7 +1729,8 @@ int kds_add_context(struct kds_sched *kds, struct kds_client *client,
 		return -EINVAL;
 	}
 
-	++cu_ctx->ref_cnt;
+	if (++cu_ctx->ref_cnt == 1)
+		kds_cu_intr_mod_ref(kds, cu_ctx, true);
 	kds_info(client, "Client pid(%d) add context Domain(%d) CU(0x%x) shared(%s)",
 		 pid_nr(client->pid), cu_domain, cu_idx, shared? "true" : "false");
 	return 0;
@@ -1285,6 +1781,7 @@ int kds_del_context(struct kds_sched *kds, struct kds_client *client,
 		return -EINVAL;
 	}
 
+	kds_cu_intr_mod_ref(kds, cu_ctx, false);
 	kds_info(client, "Client pid(%d) del context Domain(%d) CU(0x%x)",
 		 pid_nr(client->pid), cu_domain, cu_idx);
 	return 0;
@@ -1356,6 +1853,7 @@ static int _kds_add_cu(struct kds_sched *kds, int domain, struct xrt_cu *xcu)
 	/* Get a free slot in kds for this CU */
 	for (i = 0; i < MAX_CUS; i++) {
 		if (cu_mgmt->xcus[i] == NULL) {
+			xcu->wake_window_ns = (u64)kds->wake_window * NSEC_PER_USEC;
 			insert_cu(cu_mgmt, i, xcu);
 			++cu_mgmt->num_cus;
 			list_add_tail(&xcu->cu, &kds->alive_cus);
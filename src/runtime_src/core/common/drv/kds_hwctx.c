@@ -387,6 +387,9 @@ kds_alloc_hw_ctx(struct kds_client *client, uuid_t *xclbin_id, uint32_t slot_id)
 	hw_ctx->hw_ctx_idx = client->next_hw_ctx_id;
 	hw_ctx->slot_idx = slot_id;
 	hw_ctx->xclbin_id = xclbin_id;
+	hw_ctx->weight = KDS_DEFAULT_WEIGHT;
+	atomic_set(&hw_ctx->outstanding, 0);
+	init_waitqueue_head(&hw_ctx->depth_wq);
 	INIT_LIST_HEAD(&hw_ctx->cu_ctx_list);
         list_add_tail(&hw_ctx->link, &client->hw_ctx_list);
 
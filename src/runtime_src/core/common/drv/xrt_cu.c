@@ -14,6 +14,8 @@
 #include <linux/delay.h>
 #include <linux/math64.h>
 #include "kds_client.h"
+#include "kds_hwctx.h"
+#include "kds_trace.h"
 #include "xrt_cu.h"
 
 inline void xrt_cu_circ_produce(struct xrt_cu *xcu, u32 stage, uintptr_t cmd)
@@ -245,16 +247,126 @@ static inline void xrt_cu_idle_end(struct xrt_cu *xcu)
 	}
 	spin_unlock_irqrestore(&xcu->stats.xcs_lock, flags);
 }
+static inline void xrt_cu_hist_add(struct xrt_cu_lat_hist *hist, u64 ns)
+{
+	/* ns >> 10 is close enough to microseconds for a histogram */
+	int bucket = min_t(int, fls64(ns >> 10), CU_LAT_HIST_BUCKETS - 1);
+
+	hist->bucket[bucket]++;
+}
+
+/* Called on completion of a command which has been started on the CU */
+static inline void xrt_cu_update_latency(struct xrt_cu *xcu,
+					 struct kds_command *xcmd)
+{
+	u64 exec = xrt_cu_fast_ns() - xcmd->start;
+	u64 ewma = xcu->ewma_service_ns;
+
+	/* EWMA with weight 1/8 on the newest sample */
+	WRITE_ONCE(xcu->ewma_service_ns, ewma - (ewma >> 3) + (exec >> 3));
+	xrt_cu_hist_add(&xcu->exec_hist, exec);
+	WRITE_ONCE(xcu->exec_ns, xcu->exec_ns + exec);
+	if (xcmd->queued)
+		xrt_cu_hist_add(&xcu->queue_hist, xcmd->start - xcmd->queued);
+}
+
+/**
+ * xrt_cu_expected_wait() - Expected time until next completion
+ * @xcu: Target XRT CU
+ *
+ * Commands of a CU with hardware queue complete in turn, so with more
+ * submitted commands the next completion comes sooner.
+ *
+ * Return: wait in ns, 0 if there is no sample yet.
+ */
+static inline u64 xrt_cu_expected_wait(struct xrt_cu *xcu)
+{
+	u64 ewma = READ_ONCE(xcu->ewma_service_ns);
+	u32 running = max_t(u32, READ_ONCE(xcu->num_sq), 1);
+
+	return div_u64(ewma, running);
+}
+
+/**
+ * xrt_cu_adaptive_threshold() - Poll count before switching to interrupt
+ * @xcu: Target XRT CU
+ *
+ * Poll up to twice of the expected wait. Switch to interrupt right away if
+ * the expected wait is long enough that polling is mostly wasted.
+ */
+static inline u32 xrt_cu_adaptive_threshold(struct xrt_cu *xcu)
+{
+	u64 wait = xrt_cu_expected_wait(xcu);
+
+	if (!wait)
+		return CU_DEFAULT_POLL_THRESHOLD;
+
+	if (wait > CU_ADAPTIVE_MAX_POLL_NS)
+		return 0;
+
+	return max_t(u32, div_u64(2 * wait, CU_POLL_LOOP_NS), 1);
+}
+
+/**
+ * xrt_cu_defer_wake() - Remember client to wake at the end of the batch
+ * @xcu: Target XRT CU
+ * @client: Client of a completed command
+ *
+ * Return: true if the wakeup is deferred, false if the table is full and
+ * the notify callback should wake the client right away.
+ */
+static inline bool xrt_cu_defer_wake(struct xrt_cu *xcu, struct kds_client *client)
+{
+	int i;
+
+	for (i = 0; i < xcu->num_wake; i++) {
+		if (xcu->wake_clients[i] == client)
+			return true;
+	}
+
+	if (xcu->num_wake == XCU_MAX_WAKE_CLIENTS)
+		return false;
+
+	if (!xcu->num_wake && xcu->wake_window_ns)
+		xcu->wake_deadline = ktime_get_ns() + xcu->wake_window_ns;
+	xcu->wake_clients[xcu->num_wake++] = client;
+	return true;
+}
+
+/**
+ * xrt_cu_flush_wake() - Wake clients whose completions were deferred
+ * @xcu: Target XRT CU
+ *
+ * Must run before this thread sleeps or handles an abort. Otherwise a
+ * client could wait for a wakeup that never comes, or be gone.
+ */
+static inline void xrt_cu_flush_wake(struct xrt_cu *xcu)
+{
+	int i;
+
+	for (i = 0; i < xcu->num_wake; i++)
+		wake_up_interruptible(&xcu->wake_clients[i]->waitq);
+	xcu->num_wake = 0;
+}
+
 /**
  * process_cq() - Process completed queue
  * @xcu: Target XRT CU
+ *
+ * The completed commands are notified one by one but host is woken up
+ * once per client per batch. With wake_window_ns set, wakeups are held
+ * while there are still submitted commands, up to the window length.
  */
 static inline void process_cq(struct xrt_cu *xcu)
 {
 	struct kds_command *xcmd;
 
-	if (!xcu->num_cq)
+	if (!xcu->num_cq) {
+		if (unlikely(xcu->num_wake) &&
+		    (!xcu->num_sq || ktime_get_ns() >= xcu->wake_deadline))
+			xrt_cu_flush_wake(xcu);
 		return;
+	}
 
 	/* Notify host and free command
 	 *
@@ -266,13 +378,24 @@ static inline void process_cq(struct xrt_cu *xcu)
 		xcmd = list_first_entry(&xcu->cq, struct kds_command, list);
 		set_xcmd_timestamp(xcmd, xcmd->status);
 		xrt_cu_circ_produce(xcu, CU_LOG_STAGE_CQ, (uintptr_t)xcmd);
+		trace_xrt_cu_cq(xcu, xcmd);
 		xcu->bad_state = (xcmd->status == KDS_SKCRASHED);
+		if (xcmd->start)
+			xrt_cu_update_latency(xcu, xcmd);
+		if (!xcmd->inkern_cb)
+			xcmd->defer_wake = xrt_cu_defer_wake(xcu, xcmd->client);
+		/* Host may destroy the hw context once notified */
+		kds_hw_ctx_put_depth(xcmd->hw_ctx);
 		xcmd->cb.notify_host(xcmd, xcmd->status);
 		xrt_cu_incr_ecmd_count(xcu);
 		list_del(&xcmd->list);
 		xcmd->cb.free(xcmd);
 		--xcu->num_cq;
 	}
+
+	if (!xcu->wake_window_ns || !xcu->num_sq ||
+	    ktime_get_ns() >= xcu->wake_deadline)
+		xrt_cu_flush_wake(xcu);
 }
 
 /**
@@ -320,6 +443,7 @@ get_complete_and_out:
 	xcmd = xrt_cu_get_complete(xcu);
 	while (xcmd) {
 		xrt_cu_circ_produce(xcu, CU_LOG_STAGE_SQ, (uintptr_t)xcmd);
+		trace_xrt_cu_sq(xcu, xcmd);
 		move_to_queue(xcmd, &xcu->cq, &xcu->num_cq);
 		--xcu->num_sq;
 		xcmd = xrt_cu_get_complete(xcu);
@@ -348,6 +472,102 @@ static inline void process_sq(struct xrt_cu *xcu)
 	__process_sq(xcu);
 }
 
+/**
+ * xrt_cu_flow_add() - Account a normal command in the flow of its hw context
+ * @xcu: Target XRT CU
+ * @xcmd: Command moving to run queue
+ */
+static inline void xrt_cu_flow_add(struct xrt_cu *xcu, struct kds_command *xcmd)
+{
+	struct kds_client_hw_ctx *hw_ctx = xcmd->hw_ctx;
+	void *key = (hw_ctx) ? (void *)hw_ctx : (void *)xcmd->client;
+	struct xrt_cu_flow *flow;
+	int idle = -1;
+	int i;
+
+	for (i = 0; i < CU_MAX_FLOWS; ++i) {
+		flow = &xcu->flows[i];
+		if (flow->num && flow->key == key)
+			goto out;
+		if (idle < 0 && !flow->num)
+			idle = i;
+	}
+
+	/* Out of flows, the remaining hw contexts share the first one */
+	i = (idle < 0) ? 0 : idle;
+	flow = &xcu->flows[i];
+	if (!flow->num) {
+		flow->key = key;
+		flow->weight = (hw_ctx && hw_ctx->weight) ?
+			       hw_ctx->weight : KDS_DEFAULT_WEIGHT;
+		flow->deficit = 0;
+		++xcu->num_flows;
+	}
+out:
+	++flow->num;
+	xcmd->flow = i;
+}
+
+static inline void xrt_cu_flow_del(struct xrt_cu *xcu, struct kds_command *xcmd)
+{
+	struct xrt_cu_flow *flow = &xcu->flows[xcmd->flow];
+
+	if (--flow->num)
+		return;
+
+	flow->deficit = 0;
+	--xcu->num_flows;
+}
+
+/**
+ * xrt_cu_flow_next() - Next normal command in deficit round robin order
+ * @xcu: Target XRT CU
+ *
+ * Flows of the run queue take turns, each starts up to its weight of
+ * commands per turn. A single flow is served in run queue order.
+ */
+static inline struct kds_command *xrt_cu_flow_next(struct xrt_cu *xcu)
+{
+	struct xrt_cu_flow *flow;
+	struct kds_command *xcmd;
+	int i;
+
+	if (xcu->num_flows <= 1)
+		return list_first_entry(&xcu->rq, struct kds_command, list);
+
+	flow = &xcu->flows[xcu->flow_cur];
+	if (!flow->num || !flow->deficit) {
+		flow->deficit = 0;
+		for (i = 0; i < CU_MAX_FLOWS; ++i) {
+			xcu->flow_cur = (xcu->flow_cur + 1) % CU_MAX_FLOWS;
+			if (xcu->flows[xcu->flow_cur].num)
+				break;
+		}
+		flow = &xcu->flows[xcu->flow_cur];
+		flow->deficit = flow->weight;
+	}
+
+	/* Run queue is bounded by the queue depth caps of the contexts */
+	list_for_each_entry(xcmd, &xcu->rq, list) {
+		if (xcmd->flow == xcu->flow_cur)
+			return xcmd;
+	}
+
+	/* Not reachable while flow counts match the run queue */
+	return list_first_entry(&xcu->rq, struct kds_command, list);
+}
+
+static inline void xrt_cu_account_wait(struct kds_command *xcmd)
+{
+	struct kds_client_hw_ctx *hw_ctx = xcmd->hw_ctx;
+	u64 wait = xcmd->start - xcmd->queued;
+
+	this_stat_add(hw_ctx->stats, wait_ns, wait);
+	/* Racy max is fine, it is a statistic */
+	if (wait > READ_ONCE(hw_ctx->max_wait_ns))
+		WRITE_ONCE(hw_ctx->max_wait_ns, wait);
+}
+
 /**
  * process_rq() - Process run queue
  * @xcu: Target XRT CU
@@ -358,6 +578,7 @@ static inline void process_sq(struct xrt_cu *xcu)
 static inline int process_rq(struct xrt_cu *xcu)
 {
 	struct kds_command *xcmd;
+	bool prio;
 	struct kds_command *tmp;
 	struct kds_client *ev_client;
 	struct list_head *dst_q;
@@ -376,13 +597,32 @@ static inline int process_rq(struct xrt_cu *xcu)
 			xcmd->status = KDS_ABORT;
 			dst_q = &xcu->cq;
 			dst_len = &xcu->num_cq;
+			xrt_cu_flow_del(xcu, xcmd);
 			move_to_queue(xcmd, dst_q, dst_len);
 			--xcu->num_rq;
 		}
+		list_for_each_entry_safe(xcmd, tmp, &xcu->prq, list) {
+			if ((ev_client != xcmd->client) && !xcu->bad_state)
+				continue;
+
+			xcmd->status = KDS_ABORT;
+			move_to_queue(xcmd, &xcu->cq, &xcu->num_cq);
+			--xcu->num_prq;
+			--xcu->num_rq;
+		}
 		return 0;
 	}
 
-	xcmd = list_first_entry(&xcu->rq, struct kds_command, list);
+	/* High priority commands overtake normal ones, but let a normal
+	 * one go after prio_weight of them so bulk work is not starved.
+	 * Normal commands share the CU across hw contexts by weight.
+	 */
+	prio = xcu->num_prq &&
+	       (xcu->prio_streak < xcu->prio_weight || xcu->num_prq == xcu->num_rq);
+	if (prio)
+		xcmd = list_first_entry(&xcu->prq, struct kds_command, list);
+	else
+		xcmd = xrt_cu_flow_next(xcu);
 
 	if (!xrt_cu_get_credit(xcu))
 		return 0;
@@ -395,11 +635,14 @@ static inline int process_rq(struct xrt_cu *xcu)
 	xrt_cu_start(xcu);
 	if (xcu->thread) {
 		xcu->poll_count = 0;
-		if (!xcu->force_intr && xcu->interrupt_used)
+		if (xcu->adaptive_poll)
+			xcu->poll_threshold = xrt_cu_adaptive_threshold(xcu);
+		if (!xcu->force_intr && xcu->interrupt_used && xcu->poll_threshold)
 			xrt_cu_switch_to_poll(xcu);
 	}
 	set_xcmd_timestamp(xcmd, KDS_RUNNING);
 	xrt_cu_circ_produce(xcu, CU_LOG_STAGE_RQ, (uintptr_t)xcmd);
+	trace_xrt_cu_rq(xcu, xcmd);
 
 	/*
 	 * We move submit queue to CU impl level. The xrt_cu.c only need to
@@ -407,15 +650,24 @@ static inline int process_rq(struct xrt_cu *xcu)
 	 */
 	dst_q = NULL;
 	dst_len = &xcu->num_sq;
-	/* ktime_get_* is still heavy. This impact ~20% of IOPS on echo mode.
-	 * For some sort of CU, which usually has a relative long execute time,
-	 * we could hide this overhead and provide timestamp for each command.
-	 * But this implementation is used for general purpose. Please create CU
-	 * specific thread if needed.
+	/* ktime_get() is still heavy. This impact ~20% of IOPS on echo mode.
+	 * The fast clock is cheap enough to timestamp every command for the
+	 * latency statistics.
 	 */
-	//xcmd->start = ktime_get_raw_fast_ns();
+	xcmd->start = xrt_cu_fast_ns();
+	if (xcmd->hw_ctx)
+		xrt_cu_account_wait(xcmd);
 	move_to_queue(xcmd, dst_q, dst_len);
 	--xcu->num_rq;
+	if (prio) {
+		--xcu->num_prq;
+		++xcu->prio_streak;
+	} else {
+		if (xcu->flows[xcmd->flow].deficit)
+			--xcu->flows[xcmd->flow].deficit;
+		xrt_cu_flow_del(xcu, xcmd);
+		xcu->prio_streak = 0;
+	}
 	if (xcu->stats.max_sq_length < xcu->num_sq)
 		xcu->stats.max_sq_length = xcu->num_sq;
 	return 1;
@@ -430,7 +682,9 @@ static inline int process_rq(struct xrt_cu *xcu)
  */
 static inline void process_pq(struct xrt_cu *xcu)
 {
+	struct kds_command *xcmd;
 	unsigned long flags;
+	LIST_HEAD(batch);
 
 	/* Get pending queue command number without lock.
 	 * The idea is to reduce the possibility of conflict on lock.
@@ -442,11 +696,20 @@ static inline void process_pq(struct xrt_cu *xcu)
 	xrt_cu_idle_end(xcu);
 	spin_lock_irqsave(&xcu->pq_lock, flags);
 	if (xcu->num_pq) {
-		list_splice_tail_init(&xcu->pq, &xcu->rq);
+		if (xcu->num_ppq) {
+			list_splice_tail_init(&xcu->ppq, &xcu->prq);
+			xcu->num_prq += xcu->num_ppq;
+			xcu->num_ppq = 0;
+		}
+		list_splice_tail_init(&xcu->pq, &batch);
 		xcu->num_rq += xcu->num_pq;
 		xcu->num_pq = 0;
 	}
 	spin_unlock_irqrestore(&xcu->pq_lock, flags);
+
+	list_for_each_entry(xcmd, &batch, list)
+		xrt_cu_flow_add(xcu, xcmd);
+	list_splice_tail(&batch, &xcu->rq);
 	if (xcu->max_running < xcu->num_rq)
 		xcu->max_running = xcu->num_rq;
 }
@@ -469,11 +732,26 @@ try_abort_cmd(struct xrt_cu *xcu, struct kds_command *abort_cmd)
 
 		xcu_info(xcu, "Abort command(%d) on running queue", handle);
 		xcmd->status = KDS_ABORT;
+		xrt_cu_flow_del(xcu, xcmd);
 		move_to_queue(xcmd, &xcu->cq, &xcu->num_cq);
 		--xcu->num_rq;
 		return;
 	}
 
+	list_for_each_entry_safe(xcmd, tmp, &xcu->prq, list) {
+		if (xcmd->exec_bo_handle != handle)
+			continue;
+
+		abort_cmd->status = KDS_COMPLETED;
+
+		xcu_info(xcu, "Abort command(%d) on priority running queue", handle);
+		xcmd->status = KDS_ABORT;
+		move_to_queue(xcmd, &xcu->cq, &xcu->num_cq);
+		--xcu->num_prq;
+		--xcu->num_rq;
+		return;
+	}
+
 	if (!xcu->num_sq)
 		return;
 
@@ -506,6 +784,9 @@ static inline void process_hpq(struct xrt_cu *xcu)
 	if (!xcu->num_hpq)
 		return;
 
+	/* Abort may release the client, wake it while it is still around */
+	xrt_cu_flush_wake(xcu);
+
 	/* slowpath */
 	spin_lock_irqsave(&xcu->hpq_lock, flags);
 	if (!xcu->num_hpq)
@@ -531,6 +812,7 @@ int xrt_cu_process_queues(struct xrt_cu *xcu)
 
 	/* Make sure to submit as many commands as possible */
 	while (process_rq(xcu));
+	xrt_cu_flush(xcu);
 
 	/* process completed queue before submitted queue, for
 	 * two reasons:
@@ -555,6 +837,35 @@ int xrt_cu_process_queues(struct xrt_cu *xcu)
 	return XCU_IDLE;
 }
 
+/**
+ * xrt_cu_steer_irq() - Keep CU interrupt on the CPU of the CU thread
+ * @xcu: Target XRT CU
+ *
+ * Called after the thread is woken by the CU interrupt. Once the thread
+ * keeps running on another CPU, move the interrupt there so that the
+ * interrupt and the wakeup stay cache local.
+ */
+static inline void xrt_cu_steer_irq(struct xrt_cu *xcu)
+{
+	int cpu = raw_smp_processor_id();
+
+	if (cpu == xcu->irq_cpu) {
+		xcu->irq_cpu_miss = 0;
+		return;
+	}
+
+	if (++xcu->irq_cpu_miss < CU_IRQ_STEER_MISS)
+		return;
+
+	xcu->irq_cpu_miss = 0;
+	if (xcu->steer_irq(xcu, cpu)) {
+		/* Not supported by the shell, stop trying */
+		xcu->steer_irq = NULL;
+		return;
+	}
+	xcu->irq_cpu = cpu;
+}
+
 int xrt_cu_intr_thread(void *data)
 {
 	struct xrt_cu *xcu = (struct xrt_cu *)data;
@@ -575,6 +886,7 @@ int xrt_cu_intr_thread(void *data)
 		 */
 		if (process_rq(xcu))
 			continue;
+		xrt_cu_flush(xcu);
 
 		process_cq(xcu);
 		if (xcu->num_sq || is_zero_credit(xcu)) {
@@ -583,7 +895,14 @@ int xrt_cu_intr_thread(void *data)
 				 * On APU, it takes about 2us on each loop.
 				 *   xrt_cu_circ_produce(xcu, 5, 0);
 				 */
-				process_sq(xcu);
+				if (xcu->adaptive_poll) {
+					u64 begin = ktime_get_ns();
+
+					process_sq(xcu);
+					xcu->poll_ns += ktime_get_ns() - begin;
+				} else {
+					process_sq(xcu);
+				}
 				xcu->poll_count++;
 				/* If poll_count reach threshold, switch to
 				 * interrupt mode.
@@ -593,6 +912,7 @@ int xrt_cu_intr_thread(void *data)
 			} else {
 				xrt_cu_check(xcu);
 				if (!xcu->done_cnt || !xcu->ready_cnt) {
+					xrt_cu_flush_wake(xcu);
 					xcu->sleep_cnt++;
 					/* Don't use down_interruptible() here.
 					 * If CU hang, this thread would keep waiting.
@@ -604,6 +924,8 @@ int xrt_cu_intr_thread(void *data)
 					 */
 					if (down_timeout(&xcu->sem_cu, CU_TIMER))
 						ret = -ERESTARTSYS;
+					else if (xcu->steer_irq)
+						xrt_cu_steer_irq(xcu);
 					xrt_cu_check(xcu);
 				}
 				__process_sq(xcu);
@@ -633,6 +955,7 @@ int xrt_cu_intr_thread(void *data)
 
 		process_pq(xcu);
 	}
+	xrt_cu_flush_wake(xcu);
 	xrt_cu_disable_intr(xcu, CU_INTR_DONE | CU_INTR_READY);
 	del_timer_sync(&xcu->timer);
 
@@ -649,11 +972,18 @@ void xrt_cu_submit(struct xrt_cu *xcu, struct kds_command *xcmd)
 	unsigned long flags;
 	bool first_command = false;
 
+	xcmd->queued = xrt_cu_fast_ns();
+
 	/* Add command to pending queue
 	 * wakeup CU thread if it is the first command
 	 */
 	spin_lock_irqsave(&xcu->pq_lock, flags);
-	list_add_tail(&xcmd->list, &xcu->pq);
+	if (xcmd->priority == KDS_PRIORITY_HIGH) {
+		list_add_tail(&xcmd->list, &xcu->ppq);
+		++xcu->num_ppq;
+	} else {
+		list_add_tail(&xcmd->list, &xcu->pq);
+	}
 	++xcu->num_pq;
 	first_command = (xcu->num_pq == 1);
 	spin_unlock_irqrestore(&xcu->pq_lock, flags);
@@ -853,6 +1183,7 @@ int xrt_fa_cfg_update(struct xrt_cu *xcu, u64 bar, u64 dev, void __iomem *vaddr,
 	struct xrt_cu_fa *cu_fa = xcu->core;
 	u32 slot_size;
 
+	cu_fa->pending = 0;
 	if (bar == 0) {
 		cu_fa->cmdmem = NULL;
 		cu_fa->paddr = 0;
@@ -919,9 +1250,17 @@ int xrt_cu_init(struct xrt_cu *xcu)
 
 	/* Initialize pending queue and lock */
 	INIT_LIST_HEAD(&xcu->pq);
+	INIT_LIST_HEAD(&xcu->ppq);
 	spin_lock_init(&xcu->pq_lock);
 	/* Initialize run queue */
 	INIT_LIST_HEAD(&xcu->rq);
+	INIT_LIST_HEAD(&xcu->prq);
+	xcu->prio_weight = CU_DEFAULT_PRIO_WEIGHT;
+	memset(xcu->flows, 0, sizeof(xcu->flows));
+	xcu->irq_cpu = -1;
+	xcu->irq_cpu_miss = 0;
+	xcu->num_flows = 0;
+	xcu->flow_cur = 0;
 	/* Initialize completed queue */
 	INIT_LIST_HEAD(&xcu->cq);
 
@@ -983,6 +1322,8 @@ ssize_t show_cu_stat(struct xrt_cu *xcu, char *buf)
 			xcu->num_pq);
 	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "Running queue:    %d\n",
 			xcu->num_rq);
+	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "Priority running: %d\n",
+			xcu->num_prq);
 	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "Submitted queue:  %d\n",
 			xcu->num_sq);
 	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "Completed queue:  %d\n",
@@ -1012,6 +1353,84 @@ ssize_t show_cu_stat(struct xrt_cu *xcu, char *buf)
 	return sz;
 }
 
+/**
+ * xrt_cu_set_adaptive_poll() - Turn on/off adaptive polling
+ * @xcu: Target XRT CU
+ * @enable: true to derive polling from observed service time
+ */
+void xrt_cu_set_adaptive_poll(struct xrt_cu *xcu, bool enable)
+{
+	if (!enable)
+		xcu->poll_threshold = CU_DEFAULT_POLL_THRESHOLD;
+	WRITE_ONCE(xcu->adaptive_poll, enable);
+}
+
+/**
+ * xrt_cu_poll_deadline() - When the KDS polling thread should look again
+ * @xcu: Target XRT CU
+ *
+ * A CU without credit can not take new commands, so there is nothing to
+ * do until its next completion. Leave it alone until then.
+ *
+ * Return: Time in ns from ktime_get_ns(), 0 to poll at next loop.
+ */
+u64 xrt_cu_poll_deadline(struct xrt_cu *xcu)
+{
+	u64 wait;
+
+	if (!xcu->adaptive_poll || !xcu->num_sq || !is_zero_credit(xcu))
+		return 0;
+
+	wait = xrt_cu_expected_wait(xcu);
+	if (wait < CU_ADAPTIVE_MIN_SLEEP_NS)
+		return 0;
+
+	/* Wake up a little early rather than late */
+	return ktime_get_ns() + wait - (wait >> 2);
+}
+
+ssize_t show_cu_poll_stat(struct xrt_cu *xcu, char *buf)
+{
+	ssize_t sz = 0;
+
+	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "Adaptive poll:    %d\n",
+			xcu->adaptive_poll);
+	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "Mode:             %s\n",
+			(xcu->interrupt_used) ? "interrupt" : "poll");
+	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "Poll threshold:   %d\n",
+			xcu->poll_threshold);
+	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "Poll time(ns):    %llu\n",
+			xcu->poll_ns);
+	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "EWMA service(ns): %llu\n",
+			xcu->ewma_service_ns);
+
+	return sz;
+}
+
+ssize_t show_cu_lat_hist(struct xrt_cu *xcu, char *buf)
+{
+	ssize_t sz = 0;
+	int i;
+
+	sz += scnprintf(buf+sz, PAGE_SIZE - sz, "%-16s %16s %16s\n",
+			"Latency(us)", "Queue", "Execute");
+	for (i = 0; i < CU_LAT_HIST_BUCKETS; i++) {
+		char range[16];
+
+		if (i < CU_LAT_HIST_BUCKETS - 1)
+			scnprintf(range, sizeof(range), "[%u, %u)",
+				  i ? 1U << (i - 1) : 0, 1U << i);
+		else
+			scnprintf(range, sizeof(range), "[%u, inf)",
+				  1U << (i - 1));
+		sz += scnprintf(buf+sz, PAGE_SIZE - sz, "%-16s %16llu %16llu\n",
+				range, xcu->queue_hist.bucket[i],
+				xcu->exec_hist.bucket[i]);
+	}
+
+	return sz;
+}
+
 ssize_t show_cu_info(struct xrt_cu *xcu, char *buf)
 {
 	struct xrt_cu_info *info = &xcu->info;
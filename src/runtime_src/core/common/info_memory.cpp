@@ -477,12 +477,65 @@ get_ps_kernels(const xrt_core::device* device)
   return ps_kernels;
 }
 
+// Upper bound in us of the bucket holding the given percentile of a
+// log2 us histogram, see xq::kds_cu_latency
+static std::string
+get_percentile_us(const std::vector<uint64_t>& buckets, double percentile)
+{
+  uint64_t total = 0;
+  for (auto count : buckets)
+    total += count;
+  if (!total)
+    return "N/A";
+
+  uint64_t sum = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    sum += buckets[i];
+    if (sum < total * percentile)
+      continue;
+    if (i == buckets.size() - 1)
+      return ">=" + std::to_string(1ULL << (i - 1));
+    return "<" + std::to_string(1ULL << i);
+  }
+  return "N/A";
+}
+
+static ptree_type
+get_cu_latency(const xq::kds_cu_latency::data_type& lat)
+{
+  ptree_type pt;
+  auto add_hist = [&pt](const std::string& name, const std::vector<uint64_t>& buckets) {
+    ptree_type pt_hist;
+    ptree_type pt_buckets;
+    for (auto count : buckets) {
+      ptree_type pt_count;
+      pt_count.put("", count);
+      pt_buckets.push_back(std::make_pair("", pt_count));
+    }
+    pt_hist.put("p50_us", get_percentile_us(buckets, 0.50));
+    pt_hist.put("p99_us", get_percentile_us(buckets, 0.99));
+    pt_hist.add_child("log2_us_buckets", pt_buckets);
+    pt.add_child(name, pt_hist);
+  };
+  add_hist("queue", lat.queue);
+  add_hist("execute", lat.execute);
+  return pt;
+}
+
 ptree_type
 populate_cus(const xrt_core::device* device, const std::vector<xq::kds_cu_info::data_type>& cu_stats, const std::vector<xq::kds_scu_info::data_type>& scu_stats)
 {
   // Tree that holds all ps and pl objects
   ptree_type pt;
 
+  // Latency histograms are optional, older drivers do not have them
+  std::vector<xq::kds_cu_latency::data_type> cu_lats;
+  try {
+    cu_lats = xrt_core::device_query<xq::kds_cu_latency>(device);
+  }
+  catch (const xq::exception&) {
+  }
+
   // Add all CU objects into tree
   for (auto& stat : cu_stats) {
     ptree_type pt_cu;
@@ -491,6 +544,10 @@ populate_cus(const xrt_core::device* device, const std::vector<xq::kds_cu_info::
     pt_cu.put( "usage", stat.usages);
     pt_cu.put( "type", enum_to_str(cu_type::pl));
     pt_cu.add_child( std::string("status"),	get_cu_status(stat.status));
+    for (auto& lat : cu_lats) {
+      if (lat.slot_index == stat.slot_index && lat.index == stat.index)
+        pt_cu.add_child("latency", get_cu_latency(lat));
+    }
     pt.push_back(std::make_pair("", pt_cu));
   }
 
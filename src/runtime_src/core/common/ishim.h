@@ -12,6 +12,7 @@
 #include "core/include/shim_int.h"
 #include "core/include/xdp/counters.h"
 #include "core/common/shim/graph_handle.h"
+#include "core/common/shim/stream_handle.h"
 
 #include "xrt/xrt_aie.h"
 #include "xrt/xrt_bo.h"
@@ -23,6 +24,7 @@
 
 #include <stdexcept>
 #include <condition_variable>
+#include <vector>
 
 // Internal shim function forward declarations
 int xclUpdateSchedulerStat(xclDeviceHandle handle);
@@ -66,6 +68,14 @@ struct ishim
   virtual void
   xread(enum xclAddressSpace addr_space, uint64_t offset, void* buffer, size_t size) const = 0;
 
+  // Map the register space of an IP into host address space for
+  // direct access.  The mapping is owned by the shim and remains
+  // valid while the device is open.  @size is set to the size of the
+  // mapped register space.
+  virtual volatile uint32_t*
+  map_cu_registers(uint32_t /*ipidx*/, size_t& /*size*/)
+  { throw not_supported_error{__func__}; }
+
   virtual void
   xwrite(enum xclAddressSpace addr_space, uint64_t offset, const void* buffer, size_t size) = 0;
 
@@ -75,6 +85,23 @@ struct ishim
   virtual void
   unmgd_pwrite(const void* buffer, size_t size, uint64_t offset) = 0;
 
+  // Vectored unmanaged read and write of scattered device memory.
+  // Shims with driver support transfer all segments with a single
+  // request, the default transfers one segment at a time.
+  virtual void
+  unmgd_preadv(const std::vector<xrt::shim_int::unmgd_segment>& segs)
+  {
+    for (const auto& seg : segs)
+      unmgd_pread(seg.buffer, seg.size, seg.paddr);
+  }
+
+  virtual void
+  unmgd_pwritev(const std::vector<xrt::shim_int::unmgd_segment>& segs)
+  {
+    for (const auto& seg : segs)
+      unmgd_pwrite(seg.buffer, seg.size, seg.paddr);
+  }
+
   virtual void
   exec_buf(buffer_handle* boh) = 0;
 
@@ -131,6 +158,13 @@ struct ishim
   import_bo(pid_t, shared_handle::export_handle)
   { throw not_supported_error{__func__}; }
 
+  // Sync multiple buffers in one direction with a single driver
+  // request.  Shims without batched sync throw not_supported_error
+  // and the caller must sync each buffer.
+  virtual void
+  sync_bos(buffer_handle::direction, const std::vector<buffer_handle::sync_range>&)
+  { throw not_supported_error{__func__}; }
+
   ////////////////////////////////////////////////////////////////
   // Interfaces for fence handling
   ////////////////////////////////////////////////////////////////
@@ -141,6 +175,15 @@ struct ishim
   virtual std::unique_ptr<fence_handle>
   import_fence(pid_t, shared_handle::export_handle)
   { throw not_supported_error{__func__}; }
+
+  ////////////////////////////////////////////////////////////////
+  // Interfaces for streaming queues
+  // 2024.2: Only supported for Alveo Linux with QDMA
+  ////////////////////////////////////////////////////////////////
+  virtual std::unique_ptr<stream_handle>
+  create_stream(xrt::stream::direction, uint64_t /*route*/, uint64_t /*flow*/,
+                const xrt::stream::config&)
+  { throw not_supported_error{__func__}; }
   ////////////////////////////////////////////////////////////////
   // Interfaces for hw context handling
   // Implemented explicitly by concrete shim device class
@@ -170,6 +213,28 @@ struct ishim
   { throw not_supported_error{__func__}; }
   ////////////////////////////////////////////////////////////////
 
+  ////////////////////////////////////////////////////////////////
+  // Interface for shared virtual memory
+  // Implemented explicitly by concrete shim device class
+  // Pin a user range so that kernels can access it through its
+  // virtual address.  Pinning an already pinned range is cheap.
+  // 2024.2: Only supported for edge with PL behind an IOMMU
+  virtual void
+  pin_svm_range(const void* /*addr*/, size_t /*size*/)
+  { throw not_supported_error{__func__}; }
+
+  virtual void
+  unpin_svm_range(const void* /*addr*/, size_t /*size*/)
+  { throw not_supported_error{__func__}; }
+
+  // Get pollable file descriptor signaled on command completion.
+  // The descriptor is owned by the shim.
+  // 2024.2: Only supported for edge
+  virtual int
+  get_completion_fd()
+  { throw not_supported_error{__func__}; }
+  ////////////////////////////////////////////////////////////////
+
   ////////////////////////////////////////////////////////////////
   // Interfaces for custom IP interrupt handling
   // Implemented explicitly by concrete shim device class
@@ -227,6 +292,18 @@ struct ishim
   wait_gmio(const char *gmioName)
   { throw not_supported_error{__func__}; }
 
+  // Token identifying the BD most recently enqueued on a GMIO port
+  // by sync_aie_bo_nb.  A return value of 0 means BDs are not
+  // tracked individually and waits apply to all BDs of the port.
+  virtual uint64_t
+  get_gmio_bd_token(const char*)
+  { return 0; }
+
+  // Wait for one BD enqueued by sync_aie_bo_nb to complete
+  virtual void
+  wait_gmio(const char *gmioName, uint64_t)
+  { wait_gmio(gmioName); }
+
   virtual int
   start_profiling(int option, const char* port1Name, const char* port2Name, uint32_t value)
   { throw not_supported_error{__func__}; }
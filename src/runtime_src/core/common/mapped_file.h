@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef xrtcore_mapped_file_h_
+#define xrtcore_mapped_file_h_
+
+#ifndef _WIN32
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+# include <cstddef>
+# include <stdexcept>
+# include <string>
+
+namespace xrt_core {
+
+// class mapped_file - Read only private mapping of a file
+//
+// Large files such as xclbins and ELFs are mapped rather than read,
+// pages of the file are brought in only when accessed.
+class mapped_file
+{
+  void* m_addr = MAP_FAILED;
+  size_t m_size = 0;
+
+public:
+  explicit
+  mapped_file(const std::string& fnm)
+  {
+    auto fd = ::open(fnm.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      throw std::runtime_error("Failed to open file '" + fnm + "' for reading");
+
+    struct stat st = {};
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      m_size = static_cast<size_t>(st.st_size);
+      m_addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+
+    if (m_addr == MAP_FAILED)
+      throw std::runtime_error("Failed to map file '" + fnm + "'");
+  }
+
+  ~mapped_file()
+  {
+    ::munmap(m_addr, m_size);
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file(mapped_file&&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+  mapped_file& operator=(mapped_file&&) = delete;
+
+  const char*
+  data() const
+  {
+    return static_cast<const char*>(m_addr);
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+};
+
+} // xrt_core
+
+#endif // _WIN32
+
+#endif
@@ -20,10 +20,20 @@
 #include "memaccess.h"
 
 // System includes
+#include <atomic>
+#include <exception>
+#include <fstream>
 #include <iostream>
+#include <mutex>
 #include <numeric>
+#include <thread>
 #include <vector>
 
+#ifdef __linux__
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
 // Local includes
 #include "memalign.h"
 #include "query_requests.h"
@@ -126,12 +136,27 @@ enum class operation_type {
   write
 };
 
+// Transfers are split into chunks of this size and spread over up to
+// max_transfer_threads workers, so that concurrent requests can use
+// the multiple DMA channels of the device.
+constexpr uint64_t transfer_chunk_size = 64 * 1024 * 1024;
+constexpr unsigned int max_transfer_threads = 4;
+
+// A contiguous piece of a memory operation within one memory bank
+struct mem_segment
+{
+  uint64_t m_address;  // device address
+  uint64_t m_offset;   // offset from start of the operation
+  uint64_t m_size;
+  const mem_bank_t* m_bank;
+};
+
 // Ensure safe access into a device's memory banks based on memory
-// bank boundary and if the bank is in use
-static void 
-perform_memory_action(xrt_core::device* device, xrt_core::aligned_ptr_type& buf, const uint64_t start_addr, const uint64_t size, operation_type action)
+// bank boundary and if the bank is in use.  Returns the segments to
+// access, each within one bank and no larger than transfer_chunk_size.
+static std::vector<mem_segment>
+get_segments(std::vector<mem_bank_t>& vec_banks, const uint64_t start_addr, const uint64_t size)
 {
-  auto vec_banks = get_ddr_banks(device);
   auto validated_start_addr = get_starting_address(vec_banks, start_addr);
   auto start_bank = get_starting_bank(vec_banks, validated_start_addr);
   auto available_size = get_available_memory_size(vec_banks, start_bank, validated_start_addr);
@@ -142,14 +167,10 @@ perform_memory_action(xrt_core::device* device, xrt_core::aligned_ptr_type& buf,
     throw xrt_core::error(std::errc::operation_canceled, err_msg.str());
   }
 
-  auto validated_size = size;
-  // If no size is specified for the read. Read all available memory
-  if ((size == 0) && (action == operation_type::read))
-    validated_size = available_size;
-
+  std::vector<mem_segment> segments;
   uint64_t current_addr = validated_start_addr;
-  size_t remaining_bytes_to_see = size;
-  size_t bytes_seen = 0;
+  uint64_t remaining_bytes_to_see = size;
+  uint64_t bytes_seen = 0;
 
   // continue to operate as long as there are bytes left to see or we run out of banks
   for (auto it = start_bank; (it != vec_banks.end()) && (remaining_bytes_to_see > 0); ++it) {
@@ -159,44 +180,177 @@ perform_memory_action(xrt_core::device* device, xrt_core::aligned_ptr_type& buf,
       current_addr = it->m_base_address;
       available_bank_size = it->m_size;
     }
-    else 
+    else
       available_bank_size = it->m_size - (current_addr - it->m_base_address);
 
-    // If the available bank size is less than the source buffer see what bytes we are able to and move to the next bank
-    uint64_t bytes_to_edit = std::min(available_bank_size, validated_size);
-
-    // Update the buffer index based on how far we have read
-    void* current_buffer_location = static_cast<char *>(buf.get()) + bytes_seen;
-    boost::format err_fmt("%s: Code : %d - %s %u bytes from %s(0x%x)");
-    err_fmt % __func__;
-    switch (action) {
-      case operation_type::read:
-        try {
-          device->unmgd_pread(current_buffer_location, bytes_to_edit, validated_start_addr);
-        } catch (const std::exception&) {
-          const auto err_msg = err_fmt % errno % "reading" % bytes_to_edit % it->m_tag % current_addr;
-          throw xrt_core::error(std::errc::operation_canceled, err_msg.str());
-        }
-        break;
-      case operation_type::write:
-        try {
-          device->unmgd_pwrite(current_buffer_location, bytes_to_edit, validated_start_addr);
-        } catch (const std::exception&) {
-          const auto err_msg = err_fmt % errno % "writing" % bytes_to_edit % it->m_tag % current_addr;
-          throw xrt_core::error(std::errc::operation_canceled, err_msg.str());
-        }
-        break;
+    // If the available bank size is less than the remaining bytes see what bytes we are able to and move to the next bank
+    uint64_t bank_bytes = std::min(available_bank_size, remaining_bytes_to_see);
+    for (uint64_t done = 0; done < bank_bytes; ) {
+      auto chunk = std::min(bank_bytes - done, transfer_chunk_size);
+      segments.push_back({current_addr + done, bytes_seen + done, chunk, &(*it)});
+      done += chunk;
     }
-    remaining_bytes_to_see -= bytes_to_edit;
-    bytes_seen += bytes_to_edit;
+    remaining_bytes_to_see -= bank_bytes;
+    bytes_seen += bank_bytes;
   }
 
   if (remaining_bytes_to_see > 0) {
     auto err_msg = boost::format("Warning: Saw %llu bytes. Requested %llu bytes") % bytes_seen % size;
     throw std::runtime_error(err_msg.str());
   }
+
+  return segments;
+}
+
+// Access one segment of device memory through buf
+static void
+transfer_segment(xrt_core::device* device, void* buf, const mem_segment& seg, operation_type action)
+{
+  boost::format err_fmt("%s: Code : %d - %s %u bytes from %s(0x%x)");
+  err_fmt % __func__;
+  switch (action) {
+    case operation_type::read:
+      try {
+        device->unmgd_pread(buf, seg.m_size, seg.m_address);
+      } catch (const std::exception&) {
+        const auto err_msg = err_fmt % errno % "reading" % seg.m_size % seg.m_bank->m_tag % seg.m_address;
+        throw xrt_core::error(std::errc::operation_canceled, err_msg.str());
+      }
+      break;
+    case operation_type::write:
+      try {
+        device->unmgd_pwrite(buf, seg.m_size, seg.m_address);
+      } catch (const std::exception&) {
+        const auto err_msg = err_fmt % errno % "writing" % seg.m_size % seg.m_bank->m_tag % seg.m_address;
+        throw xrt_core::error(std::errc::operation_canceled, err_msg.str());
+      }
+      break;
+  }
 }
 
+// Run func(worker, segment) for all segments on parallel workers.
+// Each worker picks the next unprocessed segment until all are done.
+// The first exception stops all workers and is rethrown.
+static void
+for_each_segment(const std::vector<mem_segment>& segments,
+                 const std::function<void(unsigned int, const mem_segment&)>& func)
+{
+  auto threads = std::min<size_t>(std::max(1u, std::min(max_transfer_threads, std::thread::hardware_concurrency())), segments.size());
+
+  std::atomic<size_t> next {0};
+  std::mutex mutex;
+  std::exception_ptr eptr;
+  auto worker = [&](unsigned int idx) {
+    for (size_t i = next++; i < segments.size(); i = next++) {
+      try {
+        func(idx, segments[i]);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lk(mutex);
+        if (!eptr)
+          eptr = std::current_exception();
+        next = segments.size();
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned int idx = 1; idx < threads; ++idx)
+    workers.emplace_back(worker, idx);
+  worker(0);
+  for (auto& t : workers)
+    t.join();
+
+  if (eptr)
+    std::rethrow_exception(eptr);
+}
+
+static void
+perform_memory_action(xrt_core::device* device, xrt_core::aligned_ptr_type& buf, const uint64_t start_addr, const uint64_t size, operation_type action)
+{
+  auto vec_banks = get_ddr_banks(device);
+  auto segments = get_segments(vec_banks, start_addr, size);
+
+  for_each_segment(segments, [device, &buf, action](unsigned int, const mem_segment& seg) {
+    transfer_segment(device, static_cast<char*>(buf.get()) + seg.m_offset, seg, action);
+  });
+}
+
+// Output file written at arbitrary offsets from multiple threads.  On
+// Linux block aligned writes bypass the page cache with O_DIRECT, other
+// writes go through a regular descriptor for the same file.
+class output_file
+{
+  std::string m_name;
+#ifdef __linux__
+  int m_fd = -1;
+  int m_direct_fd = -1;
+#else
+  std::mutex m_mutex;
+  std::fstream m_stream;
+#endif
+  uint64_t m_base = 0;
+
+public:
+  static constexpr uint64_t direct_alignment = 4096;
+
+  explicit
+  output_file(const std::string& name)
+    : m_name(name)
+  {
+#ifdef __linux__
+    m_fd = ::open(name.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (m_fd < 0)
+      throw xrt_core::system_error(errno, "Cannot open " + name);
+    m_direct_fd = ::open(name.c_str(), O_WRONLY | O_DIRECT);
+    auto end = ::lseek(m_fd, 0, SEEK_END);
+    m_base = end > 0 ? static_cast<uint64_t>(end) : 0;
+#else
+    { std::ofstream create(name, std::ios::binary | std::ios::app); }
+    m_stream.open(name, std::ios::binary | std::ios::in | std::ios::out | std::ios::ate);
+    if (!m_stream)
+      throw xrt_core::error("Cannot open " + name);
+    m_base = static_cast<uint64_t>(m_stream.tellp());
+#endif
+  }
+
+  ~output_file()
+  {
+#ifdef __linux__
+    if (m_direct_fd >= 0)
+      ::close(m_direct_fd);
+    ::close(m_fd);
+#endif
+  }
+
+  // Write data at offset from end of file content at time of opening
+  void
+  write(uint64_t offset, const char* data, uint64_t size)
+  {
+    auto pos = m_base + offset;
+#ifdef __linux__
+    bool direct = (m_direct_fd >= 0) && (pos % direct_alignment == 0) && (size % direct_alignment == 0);
+    int fd = direct ? m_direct_fd : m_fd;
+    while (size) {
+      auto ret = ::pwrite(fd, data, size, static_cast<off_t>(pos));
+      if (ret < 0 && errno == EINTR)
+        continue;
+      if (ret < 0)
+        throw xrt_core::system_error(errno, "Error writing to " + m_name);
+      data += ret;
+      pos += ret;
+      size -= ret;
+    }
+#else
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_stream.seekp(pos);
+    m_stream.write(data, size);
+    if (!m_stream)
+      throw xrt_core::error("Error writing to " + m_name);
+#endif
+  }
+};
+
 } // Empty namespace
 
 namespace xrt_core {
@@ -219,6 +373,37 @@ device_mem_read(device* device, const uint64_t start_addr, const uint64_t size)
   return data;
 }
 
+void
+device_mem_read(device* device, const uint64_t start_addr, const uint64_t size, const std::string& file,
+                const std::function<void(uint64_t)>& progress)
+{
+  auto vec_banks = get_ddr_banks(device);
+  auto segments = get_segments(vec_banks, start_addr, size);
+  output_file out(file);
+
+  // One page aligned staging buffer per worker, reused for all its chunks
+  std::vector<xrt_core::aligned_ptr_type> staging(max_transfer_threads);
+  std::mutex progress_mutex;
+  uint64_t bytes_done = 0;
+
+  for_each_segment(segments, [&](unsigned int worker, const mem_segment& seg) {
+    auto& buf = staging[worker];
+    if (!buf) {
+      buf = xrt_core::aligned_alloc(output_file::direct_alignment, transfer_chunk_size);
+      if (!buf)
+        throw std::runtime_error("read_banks: Failed to allocate aligned buffer");
+    }
+    transfer_segment(device, buf.get(), seg, operation_type::read);
+    out.write(seg.m_offset, static_cast<const char*>(buf.get()), seg.m_size);
+
+    if (progress) {
+      std::lock_guard<std::mutex> lk(progress_mutex);
+      bytes_done += seg.m_size;
+      progress(bytes_done);
+    }
+  });
+}
+
 void
 device_mem_write(device* device, const uint64_t start_addr, const std::vector<char>& src) 
 {
@@ -23,6 +23,7 @@
 #include "core/common/device.h"
 
 // System includes
+#include <functional>
 #include <string>
 namespace xrt_core {
 
@@ -35,6 +36,16 @@ XRT_CORE_COMMON_EXPORT
 std::vector<char>
 device_mem_read(device* device, const uint64_t start_addr, const uint64_t size);
 
+// Same as above but streams the data read to the end of file without
+// holding all of it in host memory.  Memory is read in large chunks by
+// multiple threads in parallel and written with O_DIRECT when possible.
+// The optional progress callback is called with the number of bytes
+// completed so far, calls are serialized.
+XRT_CORE_COMMON_EXPORT
+void
+device_mem_read(device* device, const uint64_t start_addr, const uint64_t size, const std::string& file,
+                const std::function<void(uint64_t)>& progress = nullptr);
+
 // This function safely writes to a device's memory banks. It will
 // ensure that the write attempts start/end on memory bank borders
 // when applicable. This prevents writing to an unused bank or
@@ -27,8 +27,15 @@
 #include <thread>
 #include <mutex>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdarg>
+#include <cstdlib>
 #include <climits>
+#include <ctime>
+#include <memory>
 #ifdef __linux__
 # include <syslog.h>
 # include <linux/limits.h>
@@ -66,6 +73,16 @@ get_exe_path()
 
 using severity_level = xrt_core::message::severity_level;
 
+// Message captured by the sending thread for deferred dispatch
+struct message_record
+{
+  severity_level level = severity_level::debug;
+  std::string tag;
+  std::string msg;
+  std::time_t time = 0;
+  std::thread::id tid;
+};
+
 //--
 class message_dispatch
 {
@@ -75,6 +92,11 @@ public:
   static message_dispatch* make_dispatcher(const std::string& choice);
 public:
   virtual void send(severity_level l, const char* tag, const char* msg) = 0;
+
+  // Dispatch a deferred message, destinations that record time or
+  // thread of a message use the values captured by the sender
+  virtual void send_record(const message_record& r)
+  { send(r.level, r.tag.c_str(), r.msg.c_str()); }
 };
 
 //--
@@ -142,7 +164,9 @@ public:
   file_dispatch(const std::string& file);
   virtual ~file_dispatch();
   virtual void send(severity_level l, const char* tag, const char* msg) override;
+  virtual void send_record(const message_record& r) override;
 private:
+  std::mutex mutex;
   std::ofstream handle;
   std::map<severity_level, const char*> severityMap = {
     { severity_level::emergency, "EMERGENCY: "},
@@ -156,6 +180,302 @@ private:
   };
 };
 
+//--
+// Per tag rate limiting of messages.  Not thread safe, callers
+// serialize access.
+class rate_limiter
+{
+  using clock = std::chrono::steady_clock;
+
+  struct window
+  {
+    clock::time_point start;
+    unsigned int count = 0;
+    uint64_t dropped = 0;
+  };
+
+  unsigned int m_limit;
+  std::map<std::string, window, std::less<>> m_windows;
+
+public:
+  explicit
+  rate_limiter(unsigned int limit)
+    : m_limit(limit)
+  {}
+
+  // Returns true if a message with tag can be dispatched.  When a
+  // new one second window starts, dropped is set to the number of
+  // messages dropped in the previous window.
+  bool
+  admit(const std::string_view& tag, uint64_t& dropped)
+  {
+    dropped = 0;
+    if (!m_limit)
+      return true;
+
+    auto now = clock::now();
+    auto itr = m_windows.find(tag);
+    if (itr == m_windows.end())
+      itr = m_windows.emplace(std::string(tag), window{now}).first;
+    auto& w = itr->second;
+    if (now - w.start >= std::chrono::seconds(1)) {
+      dropped = w.dropped;
+      w = window{now};
+    }
+    if (w.count < m_limit) {
+      ++w.count;
+      return true;
+    }
+    ++w.dropped;
+    return false;
+  }
+};
+
+//--
+// Single producer single consumer ring of messages.  The producer is
+// the thread owning the ring, the consumer is whoever holds the sink
+// lock of the async_dispatch.
+class message_ring
+{
+  static constexpr size_t capacity = 256;
+  std::array<message_record, capacity> m_records;
+  std::atomic<size_t> m_head {0};      // next slot to write
+  std::atomic<size_t> m_tail {0};      // next slot to read
+  std::atomic<uint64_t> m_overflow {0};
+
+public:
+  std::atomic<bool> orphaned {false}; // owning thread has exited
+
+  bool
+  push(message_record&& r)
+  {
+    auto head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) == capacity) {
+      m_overflow.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    m_records[head % capacity] = std::move(r);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename Callable>
+  void
+  drain(Callable&& f)
+  {
+    auto tail = m_tail.load(std::memory_order_relaxed);
+    auto head = m_head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail)
+      f(m_records[tail % capacity]);
+    m_tail.store(tail, std::memory_order_release);
+  }
+
+  bool
+  empty() const
+  {
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+  }
+
+  uint64_t
+  take_overflow()
+  {
+    return m_overflow.exchange(0, std::memory_order_relaxed);
+  }
+};
+
+//--
+// Asynchronous dispatch to another message_dispatch.
+//
+// Sending threads push messages into their own ring without taking
+// any lock, a flusher thread drains the rings into the destination.
+// Messages of severity error and above are dispatched synchronously
+// after draining the queued messages so they are not lost if the
+// process terminates abnormally.  Messages are dropped and counted
+// if a ring is full.
+class async_dispatch : public message_dispatch
+{
+  static constexpr auto flush_interval = std::chrono::milliseconds(10);
+
+  std::unique_ptr<message_dispatch> m_sink;
+  rate_limiter m_limiter;
+
+  // Serializes all dispatch to sink and is the consumer side of rings
+  std::mutex m_sink_mutex;
+
+  std::mutex m_rings_mutex;
+  std::vector<std::shared_ptr<message_ring>> m_rings;
+
+  std::mutex m_stop_mutex;
+  std::condition_variable m_stop_cv;
+  bool m_stop = false;
+  std::thread m_flusher;
+
+  struct ring_holder
+  {
+    std::shared_ptr<message_ring> ring;
+    ~ring_holder() { if (ring) ring->orphaned = true; }
+  };
+
+  message_ring*
+  get_ring()
+  {
+    thread_local ring_holder holder;
+    if (!holder.ring) {
+      holder.ring = std::make_shared<message_ring>();
+      std::lock_guard lk(m_rings_mutex);
+      m_rings.push_back(holder.ring);
+    }
+    return holder.ring.get();
+  }
+
+  void
+  dispatch(const message_record& r)
+  {
+    uint64_t dropped = 0;
+    auto admit = m_limiter.admit(r.tag, dropped);
+    if (dropped)
+      m_sink->send(severity_level::warning, r.tag.c_str(),
+                   (std::to_string(dropped) + " messages dropped by rate limit").c_str());
+    if (admit)
+      m_sink->send_record(r);
+  }
+
+  // Must be called with m_sink_mutex held
+  void
+  drain()
+  {
+    std::vector<std::shared_ptr<message_ring>> rings;
+    {
+      std::lock_guard lk(m_rings_mutex);
+      // Remove rings of exited threads that have been fully drained
+      m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+                                   [](const auto& ring) { return ring->orphaned && ring->empty(); }),
+                    m_rings.end());
+      rings = m_rings;
+    }
+
+    for (auto& ring : rings) {
+      ring->drain([this](message_record& r) { dispatch(r); });
+      if (auto overflow = ring->take_overflow())
+        m_sink->send(severity_level::warning, "XRT",
+                     (std::to_string(overflow) + " messages dropped, message queue full").c_str());
+    }
+  }
+
+  void
+  flusher()
+  {
+    std::unique_lock slk(m_stop_mutex);
+    while (!m_stop_cv.wait_for(slk, flush_interval, [this] { return m_stop; })) {
+      std::lock_guard lk(m_sink_mutex);
+      drain();
+    }
+  }
+
+public:
+  async_dispatch(message_dispatch* sink, unsigned int rate_limit)
+    : m_sink(sink)
+    , m_limiter(rate_limit)
+    , m_flusher([this] { flusher(); })
+  {}
+
+  // Stop flusher and dispatch remaining messages, called at exit
+  void
+  stop()
+  {
+    {
+      std::lock_guard lk(m_stop_mutex);
+      m_stop = true;
+    }
+    m_stop_cv.notify_all();
+#ifndef _WIN32
+    if (m_flusher.joinable())
+      m_flusher.join();
+#else
+    // Threads cannot be joined during dll unload
+    if (m_flusher.joinable())
+      m_flusher.detach();
+#endif
+    std::lock_guard lk(m_sink_mutex);
+    drain();
+  }
+
+  virtual void
+  send(severity_level l, const char* tag, const char* msg) override
+  {
+    message_record r {l, tag, msg, std::time(nullptr), std::this_thread::get_id()};
+    if (l <= severity_level::error) {
+      std::lock_guard lk(m_sink_mutex);
+      drain();
+      dispatch(r);
+      return;
+    }
+
+    get_ring()->push(std::move(r));
+  }
+};
+
+//--
+// Synchronous dispatch with per tag rate limiting
+class rate_limit_dispatch : public message_dispatch
+{
+  std::unique_ptr<message_dispatch> m_sink;
+  rate_limiter m_limiter;
+  std::mutex m_mutex;
+
+public:
+  rate_limit_dispatch(message_dispatch* sink, unsigned int rate_limit)
+    : m_sink(sink)
+    , m_limiter(rate_limit)
+  {}
+
+  virtual void
+  send(severity_level l, const char* tag, const char* msg) override
+  {
+    uint64_t dropped = 0;
+    bool admit = false;
+    {
+      std::lock_guard lk(m_mutex);
+      admit = m_limiter.admit(tag, dropped);
+    }
+    if (dropped)
+      m_sink->send(severity_level::warning, tag,
+                   (std::to_string(dropped) + " messages dropped by rate limit").c_str());
+    if (admit)
+      m_sink->send(l, tag, msg);
+  }
+};
+
+static async_dispatch* async_dispatcher = nullptr;
+
+static void
+stop_async_dispatch()
+{
+  if (async_dispatcher)
+    async_dispatcher->stop();
+}
+
+// Wrap the configured destination per async and rate limit settings
+static message_dispatch*
+make_configured_dispatcher(const std::string& choice)
+{
+  auto dispatcher = message_dispatch::make_dispatcher(choice);
+  if (dynamic_cast<null_dispatch*>(dispatcher))
+    return dispatcher;
+
+  auto rate_limit = xrt_core::config::get_logging_rate_limit();
+  if (xrt_core::config::get_logging_async()) {
+    async_dispatcher = new async_dispatch(dispatcher, rate_limit);
+    std::atexit(stop_async_dispatch);
+    return async_dispatcher;
+  }
+
+  if (rate_limit)
+    return new rate_limit_dispatch(dispatcher, rate_limit);
+
+  return dispatcher;
+}
+
 //-------
 message_dispatch*
 message_dispatch::
@@ -208,13 +528,22 @@ void
 file_dispatch::
 send(severity_level l, const char* tag, const char* msg)
 {
-  static std::mutex mutex;
   std::lock_guard<std::mutex> lk(mutex);
   handle << "[" << xrt_core::timestamp() <<"] [" << tag << "] Tid: "
          << std::this_thread::get_id() << ", " << " " << severityMap[l]
          << msg << std::endl;
 }
 
+void
+file_dispatch::
+send_record(const message_record& r)
+{
+  std::lock_guard<std::mutex> lk(mutex);
+  handle << "[" << xrt_core::timestamp(static_cast<uint64_t>(r.time)) <<"] [" << r.tag << "] Tid: "
+         << r.tid << ", " << " " << severityMap[r.level]
+         << r.msg << '\n';
+}
+
 //console ops
 console_dispatch::
 console_dispatch()
@@ -248,11 +577,9 @@ void
 send(severity_level l, const char* tag, const char* msg)
 {
   static const std::string logger =  xrt_core::config::get_logging();
-  int ver = xrt_core::config::get_verbosity();
-  int lev = static_cast<int>(l);
 
-  if(ver >= lev) {
-    static message_dispatch* dispatcher = message_dispatch::make_dispatcher(logger);
+  if (enabled(l)) {
+    static message_dispatch* dispatcher = make_configured_dispatcher(logger);
     dispatcher->send(l, tag, msg);
   }
 }
@@ -260,8 +587,7 @@ send(severity_level l, const char* tag, const char* msg)
 void
 sendv(severity_level l, const char* tag, const char* format, va_list args)
 {
-  static auto verbosity = xrt_core::config::get_verbosity();
-  if (l > (xrt_core::message::severity_level)verbosity)
+  if (!enabled(l))
     return;
 
   va_list args_bak;
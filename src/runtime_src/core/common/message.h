@@ -28,6 +28,18 @@ namespace xrt_core { namespace message {
 
 using severity_level = xrt::message::level;
 
+/**
+ * enabled() - Check if messages of severity level are dispatched
+ *
+ * Use to avoid formatting of messages that are filtered out by
+ * the configured verbosity.
+ */
+inline bool
+enabled(severity_level l)
+{
+  return static_cast<int>(l) <= static_cast<int>(xrt_core::config::get_verbosity());
+}
+
 XRT_CORE_COMMON_EXPORT
 void
 send(severity_level l, const char* tag, const char* msg);
@@ -45,10 +57,7 @@ template <typename ...Args>
 void
 send(severity_level l, const char* tag, const char* format, Args ... args)
 {
-  int ver = xrt_core::config::get_verbosity();
-  int lev = static_cast<int>(l);
-
-  if (ver >= lev) {
+  if (enabled(l)) {
     auto sz = snprintf(nullptr, 0, format, args ...);
     if (sz < 0) {
       send(severity_level::error, tag, "Illegal arguments in log format string");
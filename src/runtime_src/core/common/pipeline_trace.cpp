@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#define XRT_CORE_COMMON_SOURCE
+#include "pipeline_trace.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+using xrt_core::pipeline_trace::stage_id;
+
+struct entry
+{
+  stage_id stage;
+  uint64_t start;
+  uint64_t end;
+  uint64_t wait;
+};
+
+// Ring buffer of trace entries written by one thread.  When full the
+// oldest entries are overwritten.
+struct ring
+{
+  static constexpr size_t capacity = 1 << 15;
+  std::array<entry, capacity> entries;
+  std::atomic<uint64_t> head {0};
+
+  void
+  push(const entry& e)
+  {
+    auto h = head.load(std::memory_order_relaxed);
+    entries[h % capacity] = e;
+    head.store(h + 1, std::memory_order_release);
+  }
+
+  template <typename Function>
+  void
+  for_each(Function&& f) const
+  {
+    auto h = head.load(std::memory_order_acquire);
+    for (auto i = (h > capacity) ? h - capacity : 0; i < h; ++i)
+      f(entries[i % capacity]);
+  }
+};
+
+// Process wide registry of stages and thread rings
+class registry
+{
+  std::mutex m_mutex;
+  std::vector<std::string> m_stages;
+  std::map<std::string, stage_id> m_stage_ids;
+  std::vector<std::shared_ptr<ring>> m_rings;
+
+  struct stage_stats
+  {
+    uint64_t count = 0;
+    uint64_t total = 0;
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+    uint64_t wait = 0;
+    uint64_t exclusive = 0;  // time stage was the only one active
+  };
+
+public:
+  stage_id
+  get_stage(const std::string& name)
+  {
+    std::lock_guard lk(m_mutex);
+    auto itr = m_stage_ids.find(name);
+    if (itr != m_stage_ids.end())
+      return itr->second;
+    auto id = static_cast<stage_id>(m_stages.size());
+    m_stages.push_back(name);
+    m_stage_ids.emplace(name, id);
+    return id;
+  }
+
+  void
+  add_ring(std::shared_ptr<ring> r)
+  {
+    std::lock_guard lk(m_mutex);
+    m_rings.push_back(std::move(r));
+  }
+
+  void
+  report(std::ostream& ostr);
+};
+
+void
+registry::
+report(std::ostream& ostr)
+{
+  std::lock_guard lk(m_mutex);
+
+  std::vector<entry> entries;
+  for (auto& r : m_rings)
+    r->for_each([&entries](const entry& e) { entries.push_back(e); });
+
+  if (entries.empty())
+    return;
+
+  std::vector<stage_stats> stats(m_stages.size());
+  // Sweep line events, +1 at start and -1 at end of each execution
+  std::vector<std::tuple<uint64_t, int, stage_id>> events;
+  for (auto& e : entries) {
+    auto& s = stats[e.stage];
+    auto latency = e.end - e.start;
+    ++s.count;
+    s.total += latency;
+    s.min = std::min(s.min, latency);
+    s.max = std::max(s.max, latency);
+    s.wait += e.wait;
+    events.emplace_back(e.start, 1, e.stage);
+    events.emplace_back(e.end, -1, e.stage);
+  }
+  std::sort(events.begin(), events.end());
+
+  uint64_t busy = 0;     // time at least one stage is active
+  uint64_t overlap = 0;  // time at least two executions are active
+  std::vector<int> active_per_stage(m_stages.size(), 0);
+  int active = 0;
+  uint64_t last = std::get<0>(events.front());
+  for (auto& [time, delta, stage] : events) {
+    auto dt = time - last;
+    if (active >= 1)
+      busy += dt;
+    if (active >= 2)
+      overlap += dt;
+    if (active == 1) {
+      auto itr = std::find_if(active_per_stage.begin(), active_per_stage.end(), [](int n) { return n > 0; });
+      stats[std::distance(active_per_stage.begin(), itr)].exclusive += dt;
+    }
+    active += delta;
+    active_per_stage[stage] += delta;
+    last = time;
+  }
+
+  auto span = std::get<0>(events.back()) - std::get<0>(events.front());
+  ostr << "XRT pipeline trace (" << entries.size() << " events, "
+       << std::fixed << std::setprecision(3) << span * 1e-6 << " ms)\n";
+  ostr << std::left << std::setw(32) << "stage" << std::right
+       << std::setw(10) << "count"
+       << std::setw(14) << "mean (us)"
+       << std::setw(14) << "min (us)"
+       << std::setw(14) << "max (us)"
+       << std::setw(14) << "wait (us)" << "\n";
+  for (stage_id id = 0; id < m_stages.size(); ++id) {
+    auto& s = stats[id];
+    if (!s.count)
+      continue;
+    ostr << std::left << std::setw(32) << m_stages[id] << std::right
+         << std::setw(10) << s.count
+         << std::setw(14) << s.total * 1e-3 / s.count
+         << std::setw(14) << s.min * 1e-3
+         << std::setw(14) << s.max * 1e-3
+         << std::setw(14) << s.wait * 1e-3 / s.count << "\n";
+  }
+
+  ostr << "busy: " << busy * 1e-6 << " ms (" << (span ? 100.0 * busy / span : 0.0) << "% of trace)"
+       << ", overlap: " << (busy ? 100.0 * overlap / busy : 0.0) << "% of busy\n";
+
+  // The critical path is made up of the stages that run alone; time
+  // spent there is not hidden by any other stage
+  std::vector<stage_id> order;
+  for (stage_id id = 0; id < m_stages.size(); ++id)
+    if (stats[id].exclusive)
+      order.push_back(id);
+  std::sort(order.begin(), order.end(), [&stats](stage_id a, stage_id b) {
+    return stats[a].exclusive > stats[b].exclusive;
+  });
+  ostr << "critical path:";
+  for (auto id : order)
+    ostr << " " << m_stages[id] << " (" << 100.0 * stats[id].exclusive / busy << "%)";
+  ostr << "\n";
+}
+
+static std::shared_ptr<registry>
+get_registry()
+{
+  static auto reg = std::make_shared<registry>();
+  return reg;
+}
+
+// Prints the report at exit
+struct reporter
+{
+  std::shared_ptr<registry> reg = get_registry();
+
+  ~reporter()
+  {
+    try {
+      reg->report(std::cout);
+    }
+    catch (...) {
+    }
+  }
+};
+
+static ring&
+local_ring()
+{
+  static reporter rep;
+  static thread_local std::shared_ptr<ring> r = [] {
+    auto rng = std::make_shared<ring>();
+    get_registry()->add_ring(rng);
+    return rng;
+  }();
+  return *r;
+}
+
+} // namespace
+
+namespace xrt_core::pipeline_trace {
+
+stage_id
+get_stage(const std::string& name)
+{
+  return get_registry()->get_stage(name);
+}
+
+void
+record(stage_id stage, uint64_t start, uint64_t end, uint64_t wait)
+{
+  if (stage == no_stage)
+    return;
+  local_ring().push({stage, start, end, wait});
+}
+
+} // xrt_core::pipeline_trace
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_CORE_PIPELINE_TRACE_H
+#define XRT_CORE_PIPELINE_TRACE_H
+
+#include "core/common/config.h"
+#include "core/common/config_reader.h"
+
+#include <cstdint>
+#include <string>
+
+////////////////////////////////////////////////////////////////
+// namespace xrt_core::pipeline_trace
+//
+// Lightweight tracer of host pipelines built from xrt::run and
+// xrt::bo::sync calls, for example sync -> run A -> run B -> sync.
+//
+// Run start and completion times (kernel command state transitions),
+// BO sync begin and end times, and the time a run spends being
+// submitted to the hardware queue are recorded into a per thread
+// ring buffer.  At exit a report with per stage latency, the
+// percentage of time stages overlap, and the stages that make up
+// the critical path is printed.  Device trace is not required.
+//
+// % cat xrt.ini
+// [Runtime]
+// pipeline_trace = true
+////////////////////////////////////////////////////////////////
+namespace xrt_core::pipeline_trace {
+
+// Identifies a pipeline stage, e.g. a kernel or sync direction
+using stage_id = uint32_t;
+constexpr stage_id no_stage = UINT32_MAX;
+
+// enabled() - Check if pipeline tracing is enabled
+//
+// Single branch check for hot paths to skip tracing altogether
+inline bool
+enabled()
+{
+  static const bool value = xrt_core::config::get_pipeline_trace();
+  return value;
+}
+
+// get_stage() - Get id of named stage, the stage is created if needed
+XRT_CORE_COMMON_EXPORT
+stage_id
+get_stage(const std::string& name);
+
+// record() - Record one execution of a stage in calling thread's ring
+//
+// @stage:  stage that executed
+// @start:  time_ns() when the stage started (submitted)
+// @end:    time_ns() when the stage completed
+// @wait:   ns of the stage spent waiting to be submitted to hardware
+XRT_CORE_COMMON_EXPORT
+void
+record(stage_id stage, uint64_t start, uint64_t end, uint64_t wait = 0);
+
+} // xrt_core::pipeline_trace
+
+#endif
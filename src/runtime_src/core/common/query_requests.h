@@ -51,6 +51,7 @@ enum class key_type
   pcie_express_lane_width_max,
   pcie_bdf,
   pcie_id,
+  numa_node,
 
   instance,
   edge_vendor,
@@ -82,6 +83,9 @@ enum class key_type
   kds_cu_info,
   sdm_sensor_info,
   kds_scu_info,
+  kds_cu_latency,
+  kds_cu_busy,
+  kds_client_stat,
   ps_kernel,
   hw_context_info,
   hw_context_memory_info,
@@ -228,6 +232,7 @@ enum class key_type
   firewall_status,
   firewall_time_sec,
   power_microwatts,
+  power_sensors,
   host_mem_addr,
   host_mem_size,
   kds_numcdmas,
@@ -282,6 +287,7 @@ enum class key_type
   asm_counter,
   lapc_status,
   spc_status,
+  debug_ip_counters,
   accel_deadlock_status,
   xclbin_slots,
   aie_get_freq,
@@ -324,6 +330,7 @@ enum class key_type
   kernel_max_bandwidth_mbps,
   sub_device_path,
   read_trace_data,
+  run_wait_stats,
   noop
 };
 
@@ -505,6 +512,26 @@ struct pcie_id : request
   }
 };
 
+/**
+ * Return NUMA node the device is attached to, -1 if unknown or if
+ * the host is not NUMA.
+ */
+struct numa_node : request
+{
+  using result_type = int32_t;
+  static const key_type key = key_type::numa_node;
+  static const char* name() { return "numa_node"; }
+
+  virtual std::any
+  get(const device*) const = 0;
+
+  static std::string
+  to_string(result_type val)
+  {
+    return std::to_string(val);
+  }
+};
+
 struct edge_vendor : request
 {
   using result_type = uint16_t;
@@ -1108,6 +1135,80 @@ struct kds_scu_info : request
   get(const device*) const = 0;
 };
 
+/**
+ * Return per PL compute unit latency histograms kept by KDS
+ *
+ * Bucket 0 counts latencies below 1us, bucket i counts [2^(i-1), 2^i)
+ * us and the last bucket is open ended.  Histograms are cumulative
+ * since the xclbin was loaded.
+ */
+struct kds_cu_latency : request
+{
+  struct data {
+    uint32_t slot_index;
+    uint32_t index;
+    std::vector<uint64_t> queue;    // queued to started
+    std::vector<uint64_t> execute;  // started to completed
+  };
+  using result_type = std::vector<data>;
+  using data_type = struct data;
+  static const key_type key = key_type::kds_cu_latency;
+
+  virtual std::any
+  get(const device*) const = 0;
+};
+
+/**
+ * Return per PL compute unit busy time kept by KDS
+ *
+ * exec_ns is the total execution time of commands completed on the CU
+ * since the xclbin was loaded, queued is the number of commands that
+ * are submitted to the CU and not completed yet.
+ */
+struct kds_cu_busy : request
+{
+  struct data {
+    uint32_t slot_index;
+    uint32_t index;
+    uint64_t exec_ns;
+    uint32_t queued;
+  };
+  using result_type = std::vector<data>;
+  using data_type = struct data;
+  static const key_type key = key_type::kds_cu_busy;
+
+  virtual std::any
+  get(const device*) const = 0;
+};
+
+/**
+ * Return per hardware context command counts kept by KDS
+ *
+ * Counts are cumulative per PL compute unit used by the context,
+ * outstanding is the number of commands of the context not completed
+ * yet.
+ */
+struct kds_client_stat : request
+{
+  struct cu_count {
+    uint32_t index;
+    uint64_t started;
+    uint64_t completed;
+  };
+  struct data {
+    uint32_t pid;
+    uint32_t hw_ctx;
+    uint32_t outstanding;
+    std::vector<cu_count> cus;
+  };
+  using result_type = std::vector<data>;
+  using data_type = struct data;
+  static const key_type key = key_type::kds_client_stat;
+
+  virtual std::any
+  get(const device*) const = 0;
+};
+
 /**
  * Return all hardware contexts within a device
  */
@@ -2822,6 +2923,23 @@ struct power_microwatts : request
   }
 };
 
+// All rails and temperatures sampled by power profiling, read in one
+// go.  Values are in the order of the individual sensor queries
+// v12v_aux_milliamps, v12v_aux_millivolts, v12v_pex_milliamps,
+// v12v_pex_millivolts, int_vcc_milliamps, int_vcc_millivolts,
+// v3v3_pex_milliamps, v3v3_pex_millivolts, cage_temp_0..3,
+// dimm_temp_0..3, fan_trigger_critical_temp, temp_fpga, hbm_temp,
+// temp_card_top_front, temp_card_top_rear, temp_card_bottom_front,
+// int_vcc_temp, fan_speed_rpm
+struct power_sensors : request
+{
+  using result_type = std::vector<uint64_t>;
+  static const key_type key = key_type::power_sensors;
+
+  virtual std::any
+  get(const device*) const = 0;
+};
+
 struct power_warning : request
 {
   using result_type = bool;
@@ -3385,6 +3503,19 @@ struct spc_status : request
   get(const xrt_core::device* device, const std::any& dbg_ip_data) const = 0;
 };
 
+// Counters and status of all debug monitors read at once, keyed by
+// monitor base address.  Each entry holds the same values, in the
+// same order, as the per monitor request (aim_counter, am_counter,
+// asm_counter, lapc_status, spc_status) for that monitor.
+struct debug_ip_counters : request
+{
+  using result_type = std::map<uint64_t, std::vector<uint64_t>>;
+  static const key_type key = key_type::debug_ip_counters;
+
+  virtual std::any
+  get(const device*) const = 0;
+};
+
 struct accel_deadlock_status : request
 {
   using result_type = uint32_t;
@@ -3819,6 +3950,24 @@ struct read_trace_data : request
   virtual std::any
   get(const device*, const std::any&) const = 0;
 };
+// Adaptive run wait statistics of kernels opened on the device.
+// Only populated when xrt.ini Runtime.adaptive_wait is enabled.
+struct run_wait_stats : request
+{
+  struct data {
+    std::string name;      // kernel name
+    uint64_t ewma_ns;      // moving average of completion time
+    uint64_t budget_ns;    // current spin budget
+    uint64_t hits;         // waits satisfied by spinning
+    uint64_t misses;       // waits that fell back to exec_wait
+  };
+  using result_type = std::vector<data>;
+  using data_type = struct data;
+  static const key_type key = key_type::run_wait_stats;
+
+  virtual std::any
+  get(const device*) const = 0;
+};
 } // query
 
 } // xrt_core
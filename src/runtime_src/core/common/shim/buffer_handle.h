@@ -30,6 +30,14 @@ public:
     device2host = XCL_BO_SYNC_BO_FROM_DEVICE,
   };
 
+  // sync_range - range of a buffer in a batched sync
+  struct sync_range
+  {
+    buffer_handle* handle;
+    size_t size;
+    size_t offset;
+  };
+
   // properties - buffer details
   struct properties
   {
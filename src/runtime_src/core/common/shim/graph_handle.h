@@ -4,6 +4,10 @@
 #ifndef XRT_CORE_GRAPH_HANDLE_H
 #define XRT_CORE_GRAPH_HANDLE_H
 
+#include "xrt/xrt_graph.h"
+
+#include <vector>
+
 namespace xrt_core {
 class graph_handle
 {
@@ -39,6 +43,24 @@ public:
 
   virtual void
   read_graph_rtp(const char* port, char* buffer, size_t size) = 0;
+
+  // Update a list of RTPs.  Shims that can validate the ports up
+  // front or batch the register writes should override the default,
+  // which updates the ports one at a time.
+  virtual void
+  update_graph_rtps(const std::vector<xrt::graph::rtp_update>& rtps)
+  {
+    for (const auto& rtp : rtps)
+      update_graph_rtp(rtp.port_name.c_str(), static_cast<const char*>(rtp.value), rtp.bytes);
+  }
+
+  // Read a list of RTPs
+  virtual void
+  read_graph_rtps(const std::vector<xrt::graph::rtp_read>& rtps)
+  {
+    for (const auto& rtp : rtps)
+      read_graph_rtp(rtp.port_name.c_str(), static_cast<char*>(rtp.value), rtp.bytes);
+  }
 };
 
 } // xrt_core
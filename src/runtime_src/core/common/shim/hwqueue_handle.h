@@ -60,11 +60,14 @@ public:
   }
 
   // Submit list of waits.  The fences prevents the hardware queue from
-  // proceeding until they are all signaled.
+  // proceeding until they are all signaled.  Shims that can submit
+  // the list as one operation should override the default, which
+  // submits the waits one at a time.
   virtual void
-  submit_wait(const std::vector<fence_handle*>&)
+  submit_wait(const std::vector<fence_handle*>& fences)
   {
-    throw std::runtime_error("not supported");
+    for (auto fence : fences)
+      submit_wait(fence);
   }
 
   // Submit signal on a fence.  The fence is signaled when the hardware
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_CORE_STREAM_HANDLE_H
+#define XRT_CORE_STREAM_HANDLE_H
+
+#include "experimental/xrt_stream.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace xrt_core {
+
+// class stream_handle - shim base class for streaming queues
+//
+// Shim level implementation derives off this class to support
+// xrt::stream.  A stream handle owns one hardware queue, the queue
+// is destroyed along with the handle.
+class stream_handle
+{
+public:
+  using buffer = xrt::stream::buffer;
+  using completion = xrt::stream::completion;
+  using direction = xrt::stream::direction;
+  using config = xrt::stream::config;
+
+  // Request flags, values match the legacy XCL_QUEUE_REQ_* flags
+  enum flags : uint32_t
+  {
+    eot         = 1 << 0,
+    nonblocking = 1 << 2,
+  };
+
+public:
+  virtual ~stream_handle()
+  {}
+
+  // Read or write, depending on direction of the queue, the buffers
+  // in one request.  A blocking request returns the number of bytes
+  // transferred, a nonblocking request returns once the buffers are
+  // queued.  Throws on error.
+  virtual size_t
+  transfer(const buffer* bufs, size_t count, uint32_t flags, void* user_data) = 0;
+
+  // Wait for at least min and at most max completions of nonblocking
+  // requests.  A timeout_ms of 0 waits forever.  Returns number of
+  // completions stored in comps.
+  virtual size_t
+  poll(completion* comps, size_t min, size_t max, uint32_t timeout_ms) = 0;
+};
+
+} // xrt_core
+#endif
@@ -21,10 +21,17 @@
 #include "debug.h"
 #include "config_reader.h"
 
+#include <algorithm>
+#include <atomic>
 #include <future>
 #include <functional>
 #include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <queue>
+#include <thread>
+#include <vector>
 #include <mutex>
 #include <condition_variable>
 #include <iostream>
@@ -233,7 +240,199 @@ public:
   }
 };
 
+/**
+ * Bounded lock-free multiple producer / multiple consumer queue
+ *
+ * Drop-in alternative to mpmcqueue based on Dmitry Vyukov's bounded
+ * MPMC queue.  Each slot carries a sequence number that tells
+ * producers and consumers whether the slot is free or filled for the
+ * current lap of the ring, so addWork and getWork claim a slot with a
+ * single compare-and-swap and never take a lock when work or space
+ * is available.
+ *
+ * A consumer that finds the queue empty, or a producer that finds it
+ * full, spins for a while before parking on a condition variable.
+ * The mutex guarding the condition variable is only taken when some
+ * thread is parked, so the uncontended path is lock-free.
+ *
+ * Capacity is rounded up to a power of two.  Unlike mpmcqueue,
+ * addWork blocks while the queue is full.
+ */
+template <typename Task>
+class lockfree_mpmcqueue
+{
+  struct cell
+  {
+    std::atomic<size_t> seq;
+    Task task;
+  };
+
+  static constexpr unsigned int spin_count = 256;
+
+  std::vector<cell> m_cells;
+  size_t m_mask;
+
+  // Producer and consumer positions on separate cache lines
+  alignas(64) std::atomic<size_t> m_enqueue_pos {0};
+  alignas(64) std::atomic<size_t> m_dequeue_pos {0};
+
+  alignas(64) std::atomic<bool> m_stop {false};
+  std::atomic<unsigned int> m_parked_consumers {0};
+  std::atomic<unsigned int> m_parked_producers {0};
+  std::mutex m_mutex;
+  std::condition_variable m_work;
+  std::condition_variable m_space;
+
+  static size_t
+  round_up(size_t capacity)
+  {
+    size_t sz = 2;
+    while (sz < capacity)
+      sz <<= 1;
+    return sz;
+  }
+
+  bool
+  try_push(Task& t)
+  {
+    auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      auto& c = m_cells[pos & m_mask];
+      auto seq = c.seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          c.task = std::move(t);
+          c.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+        return false;  // full
+      else
+        pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+
+  bool
+  try_pop(Task& t)
+  {
+    auto pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      auto& c = m_cells[pos & m_mask];
+      auto seq = c.seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          t = std::move(c.task);
+          c.seq.store(pos + m_mask + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+        return false;  // empty
+      else
+        pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Wake a parked thread if any.  The fence pairs with the fence in
+  // park() such that either the parked thread sees the state change
+  // or this thread sees the parked thread.
+  void
+  wake(std::atomic<unsigned int>& parked, std::condition_variable& cv)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!parked.load(std::memory_order_relaxed))
+      return;
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+    }
+    cv.notify_one();
+  }
+
+  // Spin then park until op() succeeds or queue is stopped
+  template <typename Op>
+  bool
+  wait(Op&& op, std::atomic<unsigned int>& parked, std::condition_variable& cv)
+  {
+    for (unsigned int i = 0; i < spin_count; ++i) {
+      if (m_stop.load(std::memory_order_relaxed))
+        return false;
+      if (op())
+        return true;
+      std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lk(m_mutex);
+    ++parked;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool done = false;
+    while (!(done = op()) && !m_stop.load(std::memory_order_relaxed))
+      cv.wait(lk);
+    --parked;
+    return done;
+  }
+
+public:
+  explicit
+  lockfree_mpmcqueue(size_t capacity = 1024)
+    : m_cells(round_up(capacity))
+    , m_mask(m_cells.size() - 1)
+  {
+    for (size_t i = 0; i < m_cells.size(); ++i)
+      m_cells[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  lockfree_mpmcqueue(const lockfree_mpmcqueue&) = delete;
+  lockfree_mpmcqueue& operator=(const lockfree_mpmcqueue&) = delete;
+
+  void
+  addWork(Task&& t)
+  {
+    if (!try_push(t) && !wait([this, &t] { return try_push(t); }, m_parked_producers, m_space))
+      return; // stopped
+    wake(m_parked_consumers, m_work);
+  }
+
+  Task
+  getWork()
+  {
+    Task task {};
+    if (m_stop.load(std::memory_order_relaxed))
+      return task;
+    if (!try_pop(task) && !wait([this, &task] { return try_pop(task); }, m_parked_consumers, m_work))
+      return Task {};
+    wake(m_parked_producers, m_space);
+    return task;
+  }
+
+  size_t
+  size() const
+  {
+    auto enq = m_enqueue_pos.load(std::memory_order_relaxed);
+    auto deq = m_dequeue_pos.load(std::memory_order_relaxed);
+    return enq > deq ? enq - deq : 0;
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_cells.size();
+  }
+
+  void
+  stop()
+  {
+    m_stop = true;
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_work.notify_all();
+    m_space.notify_all();
+  }
+};
+
 using queue = mpmcqueue<task>;
+using lockfree_queue = lockfree_mpmcqueue<task>;
 
 /**
  * event class wraps std::future<RT>
@@ -339,8 +538,9 @@ createM(Q& q, F&& f, C& c, Args&&... args)
 
 // A task worker is a thread function getting work off a task queue.
 // The worker runs until the queue is stopped.
+template <typename Q>
 inline void
-worker_debug(queue& q,const std::string& id)
+worker_debug(Q& q,const std::string& id)
 {
   unsigned long loops = 0;
   unsigned long worktime = 0;
@@ -369,8 +569,9 @@ worker_debug(queue& q,const std::string& id)
             ,", waitime (ms): ",waittime*1e-6,"\n");
 }
 
+template <typename Q>
 inline void
-worker_ndebug(queue& q)
+worker_ndebug(Q& q)
 {
   while (true) {
     auto t = q.getWork();
@@ -394,6 +595,276 @@ worker(queue& q)
 {
   return worker2(q,"");
 }
+
+inline void
+lockfree_worker(lockfree_queue& q, const std::string& id="")
+{
+  if (xrt_core::config::get_xrt_debug())
+    return worker_debug(q,id);
+  else
+    return worker_ndebug(q);
+}
+
+/**
+ * Work stealing executor
+ *
+ * A fixed number of task queues (lanes) served by a shared pool of
+ * workers.  Each worker has a home lane, but picks work from any
+ * lane that has work, so a burst of work on one lane is not limited
+ * to the workers that happen to be assigned to that lane.
+ *
+ * A worker always services the highest priority non-empty lane,
+ * among lanes of equal priority the worker prefers its home lane.
+ * A task executed by a worker other than one homed on the task's
+ * lane is counted as stolen.
+ *
+ * Each lane keeps counters of executed and stolen tasks, the time
+ * spent executing its tasks, and the number of times a lock on the
+ * lane was contended.  The counters are printed when the executor
+ * is stopped with Debug.xrt_debug enabled.
+ *
+ * The executor does not own its worker threads.  Threads must call
+ * worker() with their home lane and are joined by the owner of the
+ * executor after stop().
+ */
+class executor
+{
+public:
+  struct stats
+  {
+    unsigned long executed = 0;   // tasks executed from the lane
+    unsigned long stolen = 0;     // tasks executed by foreign worker
+    unsigned long contention = 0; // contended lane locks
+    unsigned long busytime = 0;   // ns spent executing tasks
+  };
+
+  /**
+   * A lane is a task queue that can be used with createF and createM
+   */
+  class lane
+  {
+    friend class executor;
+
+    executor* m_executor;
+    size_t m_idx;
+    int m_priority = 0;
+    std::deque<task> m_tasks;
+    std::mutex m_mutex;
+
+    std::atomic<unsigned long> m_executed {0};
+    std::atomic<unsigned long> m_stolen {0};
+    std::atomic<unsigned long> m_contention {0};
+    std::atomic<unsigned long> m_busytime {0};
+
+    std::unique_lock<std::mutex>
+    lock()
+    {
+      std::unique_lock<std::mutex> lk(m_mutex, std::try_to_lock);
+      if (!lk.owns_lock()) {
+        ++m_contention;
+        lk.lock();
+      }
+      return lk;
+    }
+
+    bool
+    pop(task& t)
+    {
+      auto lk = lock();
+      if (m_tasks.empty())
+        return false;
+      t = std::move(m_tasks.front());
+      m_tasks.pop_front();
+      return true;
+    }
+
+  public:
+    lane(executor* exec, size_t idx)
+      : m_executor(exec), m_idx(idx)
+    {}
+
+    void
+    addWork(task&& t)
+    {
+      {
+        auto lk = lock();
+        m_tasks.push_back(std::move(t));
+      }
+      m_executor->notify();
+    }
+
+    size_t
+    size()
+    {
+      auto lk = lock();
+      return m_tasks.size();
+    }
+
+    int
+    get_priority() const
+    {
+      return m_priority;
+    }
+
+    stats
+    get_stats() const
+    {
+      stats s;
+      s.executed = m_executed;
+      s.stolen = m_stolen;
+      s.contention = m_contention;
+      s.busytime = m_busytime;
+      return s;
+    }
+  };
+
+private:
+  std::vector<std::unique_ptr<lane>> m_lanes;
+  std::mutex m_mutex;
+  std::condition_variable m_work;
+  size_t m_pending = 0;  // tasks added but not yet picked up
+  bool m_stop = false;
+  std::atomic<unsigned long> m_idletime {0};
+
+  void
+  notify()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      ++m_pending;
+    }
+    m_work.notify_one();
+  }
+
+  // Lanes in the order a worker homed on lane 'home' visits them
+  std::vector<lane*>
+  visit_order(size_t home) const
+  {
+    std::vector<lane*> order;
+    for (auto& l : m_lanes)
+      order.push_back(l.get());
+    std::stable_sort(order.begin(), order.end(), [home](lane* l1, lane* l2) {
+      if (l1->m_priority != l2->m_priority)
+        return l1->m_priority > l2->m_priority;
+      return l1->m_idx == home && l2->m_idx != home;
+    });
+    return order;
+  }
+
+  // Wait for work, return false if the executor is stopped
+  bool
+  wait()
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (!m_stop && !m_pending)
+      m_work.wait(lk);
+    if (m_stop)
+      return false;
+    --m_pending;
+    return true;
+  }
+
+public:
+  explicit
+  executor(size_t lanes)
+  {
+    for (size_t idx = 0; idx < lanes; ++idx)
+      m_lanes.emplace_back(std::make_unique<lane>(this, idx));
+  }
+
+  lane&
+  get_lane(size_t idx)
+  {
+    return *m_lanes.at(idx);
+  }
+
+  size_t
+  size() const
+  {
+    return m_lanes.size();
+  }
+
+  /**
+   * Set the priority of a lane, higher values are serviced first.
+   * Must be called before workers are started.
+   */
+  void
+  set_priority(size_t idx, int priority)
+  {
+    m_lanes.at(idx)->m_priority = priority;
+  }
+
+  /**
+   * Accumulated time in ns workers have been idle waiting for work
+   */
+  unsigned long
+  get_idletime() const
+  {
+    return m_idletime;
+  }
+
+  /**
+   * Worker thread function, runs until the executor is stopped.
+   * Work remaining in the lanes when stopped is discarded.
+   */
+  void
+  worker(size_t home)
+  {
+    auto order = visit_order(home);
+    unsigned long idletime = 0;
+    while (true) {
+      auto timepoint = time_ns();
+      if (!wait())
+        break;
+      auto start = time_ns();
+      idletime += start - timepoint;
+
+      // A pending count was consumed so some lane has a task, but
+      // another worker may have taken it from under us, scan until found
+      task t;
+      lane* src = nullptr;
+      while (!src) {
+        for (auto l : order) {
+          if (l->pop(t)) {
+            src = l;
+            break;
+          }
+        }
+      }
+
+      t();
+      ++src->m_executed;
+      if (src->m_idx != home)
+        ++src->m_stolen;
+      src->m_busytime += time_ns() - start;
+    }
+    m_idletime += idletime;
+  }
+
+  void
+  stop()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_stop = true;
+    }
+    m_work.notify_all();
+
+    if (!xrt_core::config::get_xrt_debug())
+      return;
+
+    for (auto& l : m_lanes) {
+      auto s = l->get_stats();
+      XRT_PRINT(std::cout,"task executor lane (",l->m_idx,")"
+                ,", priority: ",l->m_priority
+                ,", executed: ",s.executed
+                ,", stolen: ",s.stolen
+                ,", contention: ",s.contention
+                ,", busytime (ms): ",s.busytime*1e-6,"\n");
+    }
+  }
+};
+
 }} // task,xrt_core
 
 #ifdef _WIN32
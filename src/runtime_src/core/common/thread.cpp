@@ -19,6 +19,7 @@
 #include "message.h"
 #include "config_reader.h"
 
+#include <fstream>
 #include <thread>
 #include <iostream>
 
@@ -132,6 +133,56 @@ set_cpu_affinity(std::thread& thread)
   }
 }
 
+static void
+set_cpu_affinity(std::thread& thread, unsigned int cpu)
+{
+  if (cpu >= std::thread::hardware_concurrency()) {
+    xrt_core::message::send(xrt_core::message::severity_level::warning,"XRT", "Ignoring cpu affinity since cpu #" + std::to_string(cpu) + " is out of range\n");
+    return;
+  }
+
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu,&cpuset);
+  if (pthread_setaffinity_np(thread.native_handle(),sizeof(cpu_set_t),&cpuset)) {
+    throw std::runtime_error("error calling pthread_setaffinity_np");
+  }
+}
+
+// Pin thread to cpus of NUMA node per /sys/devices/system/node
+static void
+set_numa_affinity(std::thread& thread, int node)
+{
+  if (node < 0)
+    return;
+
+  std::ifstream ifs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+  std::string cpus;
+  if (!std::getline(ifs, cpus) || cpus.empty())
+    return;
+
+  // cpulist is a comma separated list of cpus and cpu ranges, e.g. 0-7,16-23
+  using tokenizer=boost::tokenizer<boost::char_separator<char> >;
+  boost::char_separator<char> sep(",");
+  auto max_cpus = std::thread::hardware_concurrency();
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (auto& tok : tokenizer(cpus,sep)) {
+    auto dash = tok.find('-');
+    auto first = std::stoul(tok.substr(0, dash));
+    auto last = (dash == std::string::npos) ? first : std::stoul(tok.substr(dash + 1));
+    for (auto cpu = first; cpu <= last && cpu < max_cpus; ++cpu)
+      CPU_SET(cpu,&cpuset);
+  }
+
+  if (!CPU_COUNT(&cpuset))
+    return;
+
+  if (pthread_setaffinity_np(thread.native_handle(),sizeof(cpu_set_t),&cpuset)) {
+    throw std::runtime_error("error calling pthread_setaffinity_np");
+  }
+}
+
 #else
 
 static void
@@ -139,11 +190,21 @@ set_thread_policy(std::thread&)
 {
 }
 
+static void
+set_numa_affinity(std::thread&, int)
+{
+}
+
 static void
 set_cpu_affinity(std::thread&)
 {
 }
 
+static void
+set_cpu_affinity(std::thread&, unsigned int)
+{
+}
+
 #endif
 
 } // platform_specific
@@ -164,6 +225,16 @@ void set_cpu_affinity(std::thread& thread)
   ::platform_specific::set_cpu_affinity(thread);
 }
 
+void set_cpu_affinity(std::thread& thread, unsigned int cpu)
+{
+  ::platform_specific::set_cpu_affinity(thread, cpu);
+}
+
+void set_numa_affinity(std::thread& thread, int node)
+{
+  ::platform_specific::set_numa_affinity(thread, node);
+}
+
 } // detail
 
 } // xrt_core
@@ -41,6 +41,18 @@ XRT_CORE_COMMON_EXPORT
 void
 set_cpu_affinity(std::thread& thread);
 
+/**
+ * Pin a thread to a single cpu, overriding sdaccel.ini affinity
+ */
+XRT_CORE_COMMON_EXPORT
+void
+set_cpu_affinity(std::thread& thread, unsigned int cpu);
+
+// Pin thread to the cpus of a NUMA node, no-op if node is negative
+XRT_CORE_COMMON_EXPORT
+void
+set_numa_affinity(std::thread& thread, int node);
+
 }
 
 /**
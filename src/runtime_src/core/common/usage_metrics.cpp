@@ -17,15 +17,18 @@
 #include "core/include/xrt/xrt_uuid.h"
 
 #include <algorithm>
-#include <atomic>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include <chrono>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #ifdef _WIN32
 # pragma warning ( disable : 4996 )
@@ -34,24 +37,8 @@
 namespace bpt = boost::property_tree;
 
 namespace {
-// global variables
-static std::mutex m;
-static std::atomic<uint32_t> thread_count {0};
 
-template <typename MetType, typename FindType>
-static MetType*
-get_metrics(std::vector<MetType>& metrics_vec, const FindType& finder)
-{
-  auto it = std::find_if(metrics_vec.begin(), metrics_vec.end(), 
-                        [finder](const auto& met) 
-                        {
-                          return met.handle == finder;
-                        }
-                        );
-  return it == metrics_vec.end()
-    ? nullptr
-    : &(*it);
-}
+using clock_type = std::chrono::high_resolution_clock;
 
 struct bo_metrics
 {
@@ -60,107 +47,169 @@ struct bo_metrics
   size_t   peak_size_in_bytes = 0;
   size_t   bytes_synced_to_device = 0;
   size_t   bytes_synced_from_device = 0;
-};
 
-struct kernel_metrics
-{
-  using tp = std::chrono::time_point<std::chrono::high_resolution_clock>;
-  struct timestamp
+  void
+  merge(const bo_metrics& other)
   {
-    tp start_time;
-    bool is_valid = false;
-  };
+    total_count += other.total_count;
+    total_size_in_bytes += other.total_size_in_bytes;
+    peak_size_in_bytes = std::max(peak_size_in_bytes, other.peak_size_in_bytes);
+    bytes_synced_to_device += other.bytes_synced_to_device;
+    bytes_synced_from_device += other.bytes_synced_from_device;
+  }
+};
 
-  std::string handle; // kernel name is used as handle for identifying kernel
-  std::vector<uint32_t> cu_index_vec;
+struct run_metrics
+{
   uint32_t total_runs = 0;
   std::chrono::microseconds total_time = {};
-  std::unordered_map<const xrt::run_impl*, timestamp> exec_times; // run handle ptr is used for indexing
-  size_t num_args;
 
   void
-  log_kernel_exec_time(const xrt::run_impl* run_hdl, const tp& tp_now, ert_cmd_state state)
+  merge(const run_metrics& other)
   {
-    // state ERT_CMD_STATE_NEW indicates kernel start is called
-    if (state == ERT_CMD_STATE_NEW) {
-      // record start everytime because previous run may be finished, timeout, aborted or stopped
-      exec_times[run_hdl].start_time = tp_now;
-      exec_times[run_hdl].is_valid = true;
-    }
-    else {
-      // make start time invalid so we can record for next run, add duration to total time and increment total runs
-      if (exec_times[run_hdl].is_valid && state == ERT_CMD_STATE_COMPLETED) {
-        // valid run increament run
-        total_runs++;
-        total_time += std::chrono::duration_cast<std::chrono::microseconds>(tp_now - exec_times[run_hdl].start_time);
-
-        // invalidate start time, run may be finished, aborted or timed out
-        exec_times[run_hdl].is_valid = false;
-      }
-    }
+    total_runs += other.total_runs;
+    total_time += other.total_time;
   }
 };
 
-struct hw_ctx_metrics
+// Counters are keyed by device and hw context handle (nullptr for
+// global buffers), kernels by hw context handle and kernel name
+using bo_key = std::pair<device_id, const xrt_core::hwctx_handle*>;
+using kernel_key = std::pair<const xrt_core::hwctx_handle*, std::string>;
+
+// struct thread_metrics - usage counters of one thread
+//
+// Updated only by the owning thread without any locking.  Merged
+// into the process totals when the thread exits or when the report
+// is generated.
+struct thread_metrics
 {
-  const xrt_core::hwctx_handle* handle;  // using hw_ctx handle ptr as unique identifier for logging
-  xrt::uuid xclbin_uuid;
-  bo_metrics bos_met;
-  std::vector<kernel_metrics> kernel_metrics_vec;
+  std::map<bo_key, bo_metrics> bos;
+  std::map<device_id, uint32_t> bo_active_count;
+  std::map<kernel_key, run_metrics> kernels;
+
+  // Start time of runs started by this thread.  A run that is waited
+  // on by another thread than the one starting it is not timed.
+  std::unordered_map<const xrt::run_impl*, clock_type::time_point> run_start;
 
   void
-  log_kernel(const std::string& name, size_t args)
+  merge(const thread_metrics& other)
   {
-    kernel_metrics k;
-    k.handle = name;
-    k.num_args = args;
-    kernel_metrics_vec.emplace_back(k);
+    for (const auto& [key, met] : other.bos)
+      bos[key].merge(met);
+    for (const auto& [key, count] : other.bo_active_count)
+      bo_active_count[key] += count;
+    for (const auto& [key, met] : other.kernels)
+      kernels[key].merge(met);
   }
 };
 
-struct device_metrics
+// Entities registered with the logger.  Registration is infrequent
+// compared to counter updates and is done under a lock.
+struct kernel_info
 {
-  std::string bdf = "";
-  bo_metrics global_bos_met;
-  uint32_t bo_active_count = 0;
-  uint32_t bo_peak_count = 0;
-  std::vector<hw_ctx_metrics> hw_ctx_vec;
+  std::string name;
+  size_t num_args;
+};
+
+struct hw_ctx_info
+{
+  const xrt_core::hwctx_handle* handle;  // using hw_ctx handle ptr as unique identifier for logging
+  xrt::uuid xclbin_uuid;
+  std::vector<kernel_info> kernels;
+};
+
+struct device_info
+{
+  std::string bdf;
+  std::vector<hw_ctx_info> hw_ctx_vec;
+};
+
+// class registry - process wide usage metrics state
+//
+// Owns the registered entities, the counters of live threads and
+// the merged counters of exited threads.
+class registry
+{
+  std::mutex m_mutex;
+  std::map<device_id, device_info> m_devices;
+  std::vector<std::shared_ptr<thread_metrics>> m_threads;
+  thread_metrics m_merged;
 
+public:
   void
-  log_hw_ctx(const xrt_core::hwctx_handle* handle, const xrt::uuid& uuid)
+  add_thread(std::shared_ptr<thread_metrics> tm)
   {
-    hw_ctx_vec.emplace_back(hw_ctx_metrics{handle, uuid, {}, {}});
+    std::lock_guard lk(m_mutex);
+    m_threads.push_back(std::move(tm));
   }
-};
 
-using metrics_map = std::map<std::thread::id, std::map<device_id, device_metrics>>;
-using device_metrics_map = std::map<device_id, device_metrics>;
-// Global map to store usage metrics of all threads
-static auto usage_metrics_map = std::make_shared<metrics_map>();
+  void
+  remove_thread(const thread_metrics* tm)
+  {
+    std::lock_guard lk(m_mutex);
+    auto itr = std::find_if(m_threads.begin(), m_threads.end(), [tm](const auto& t) { return t.get() == tm; });
+    if (itr == m_threads.end())
+      return;
+    m_merged.merge(**itr);
+    m_threads.erase(itr);
+  }
 
-// Helper functions to get metrics
-static device_metrics*
-get_device_metrics(device_metrics_map& dev_map, device_id dev_id)
-{
-  auto map_it = dev_map.find(dev_id);
-  return map_it == dev_map.end()
-    ? nullptr
-    : &(*map_it).second;
-}
+  void
+  add_device(device_id dev_id, const std::function<std::string()>& get_bdf)
+  {
+    std::lock_guard lk(m_mutex);
+    if (m_devices.count(dev_id))
+      return;
+    auto& dev = m_devices[dev_id];
+    try {
+      dev.bdf = get_bdf();
+    }
+    catch (...) {}
+  }
 
-static bo_metrics*
-get_buffer_metrics(device_metrics* dev_metrics, const xrt_core::hwctx_handle* handle)
-{
-  if (!handle) {
-    // global bo
-    return &dev_metrics->global_bos_met;
+  void
+  add_hw_ctx(device_id dev_id, const xrt_core::hwctx_handle* handle, const xrt::uuid& uuid)
+  {
+    std::lock_guard lk(m_mutex);
+    auto dev = m_devices.find(dev_id);
+    // dont log if device didn't match
+    if (dev == m_devices.end())
+      return;
+
+    auto& ctxs = dev->second.hw_ctx_vec;
+    if (std::none_of(ctxs.begin(), ctxs.end(), [handle](const auto& ctx) { return ctx.handle == handle; }))
+      ctxs.push_back({handle, uuid, {}});
   }
-  else {
-    auto hw_ctx_met = get_metrics(dev_metrics->hw_ctx_vec, handle);
-    if (hw_ctx_met != nullptr)
-      return &hw_ctx_met->bos_met;
+
+  void
+  add_kernel(device_id dev_id, const xrt_core::hwctx_handle* handle, const std::string& name, size_t args)
+  {
+    std::lock_guard lk(m_mutex);
+    auto dev = m_devices.find(dev_id);
+    if (dev == m_devices.end())
+      return;
+
+    auto& ctxs = dev->second.hw_ctx_vec;
+    auto ctx = std::find_if(ctxs.begin(), ctxs.end(), [handle](const auto& c) { return c.handle == handle; });
+    // dont log if hw ctx didn't match existing ones
+    if (ctx == ctxs.end())
+      return;
+
+    auto& kernels = ctx->kernels;
+    if (std::none_of(kernels.begin(), kernels.end(), [&name](const auto& k) { return k.name == name; }))
+      kernels.push_back({name, args});
   }
-  return nullptr;
+
+  bpt::ptree
+  report();
+};
+
+static std::shared_ptr<registry>
+get_registry()
+{
+  static auto reg = std::make_shared<registry>();
+  return reg;
 }
 
 // Helper functions to print usage metrics as json
@@ -209,18 +258,21 @@ get_bos_ptree(const bo_metrics& bo_met)
 }
 
 static bpt::ptree
-get_kernels_ptree(const std::vector<kernel_metrics>& kernels_vec)
+get_kernels_ptree(const hw_ctx_info& ctx, const thread_metrics& totals)
 {
   bpt::ptree kernel_array;
 
-  for (const auto& kernel : kernels_vec) {
+  for (const auto& kernel : ctx.kernels) {
     bpt::ptree kernel_tree;
+    run_metrics runs;
+    if (auto itr = totals.kernels.find({ctx.handle, kernel.name}); itr != totals.kernels.end())
+      runs = itr->second;
 
-    kernel_tree.put("name", kernel.handle);
+    kernel_tree.put("name", kernel.name);
     kernel_tree.put("num_of_args", kernel.num_args);
-    kernel_tree.put("num_total_runs", std::to_string(kernel.total_runs));
+    kernel_tree.put("num_total_runs", std::to_string(runs.total_runs));
 
-    auto avg_run_time = (kernel.total_runs > 0) ? (kernel.total_time.count() / kernel.total_runs) : 0;
+    auto avg_run_time = (runs.total_runs > 0) ? (runs.total_time.count() / runs.total_runs) : 0;
     kernel_tree.put("avg_run_time", std::to_string(avg_run_time) + " us");
 
     kernel_array.push_back(std::make_pair("", kernel_tree));
@@ -229,8 +281,15 @@ get_kernels_ptree(const std::vector<kernel_metrics>& kernels_vec)
   return kernel_array; 
 }
 
+static bo_metrics
+get_bo_metrics(const thread_metrics& totals, device_id dev_id, const xrt_core::hwctx_handle* handle)
+{
+  auto itr = totals.bos.find({dev_id, handle});
+  return itr == totals.bos.end() ? bo_metrics{} : itr->second;
+}
+
 static bpt::ptree
-get_hw_ctx_ptree(const std::vector<hw_ctx_metrics>& hw_ctx_vec)
+get_hw_ctx_ptree(device_id dev_id, const std::vector<hw_ctx_info>& hw_ctx_vec, const thread_metrics& totals)
 {
   bpt::ptree hw_ctx_array;
 
@@ -241,10 +300,10 @@ get_hw_ctx_ptree(const std::vector<hw_ctx_metrics>& hw_ctx_vec)
     hw_ctx.put("xclbin_uuid", ctx.xclbin_uuid.to_string());
 
     // add buffer info
-    hw_ctx.add_child("bos", get_bos_ptree(ctx.bos_met));
+    hw_ctx.add_child("bos", get_bos_ptree(get_bo_metrics(totals, dev_id, ctx.handle)));
 
     // add kernel info
-    hw_ctx.add_child("kernels", get_kernels_ptree(ctx.kernel_metrics_vec));
+    hw_ctx.add_child("kernels", get_kernels_ptree(ctx, totals));
 
     hw_ctx_array.push_back(std::make_pair("", hw_ctx));
     ctx_count++;
@@ -253,49 +312,74 @@ get_hw_ctx_ptree(const std::vector<hw_ctx_metrics>& hw_ctx_vec)
   return hw_ctx_array;
 }
 
-static void
-print_usage_metrics()
+// Build report from merged counters of exited and live threads
+bpt::ptree
+registry::
+report()
 {
-  bpt::ptree thread_array;
-
-  uint32_t t_count = 0;
-  // iterate over all threads
-  for (const auto& [thread_id, dev_metrics_map] : *usage_metrics_map) {
-    bpt::ptree dev_array;
-    // iterate over all devices
-    for (const auto& [dev_id, dev_metrics] : dev_metrics_map) {
-      bpt::ptree dev;
-      dev.put("device_index", std::to_string(dev_id));
-      dev.put("bdf", dev_metrics.bdf);
-      dev.put("bos_peak_count", std::to_string(dev_metrics.bo_peak_count));
-
-      // add global bos
-      dev.add_child("global_bos", get_bos_ptree(dev_metrics.global_bos_met));
-
-      // add hw ctx info
-      dev.add_child("hw_context", get_hw_ctx_ptree(dev_metrics.hw_ctx_vec));
-
-      dev_array.push_back(std::make_pair("device", dev));
-    }
-
-    thread_array.add_child("thread " + std::to_string(t_count), dev_array);
-    t_count++;
+  std::lock_guard lk(m_mutex);
+  thread_metrics totals = m_merged;
+  for (const auto& tm : m_threads)
+    totals.merge(*tm);
+
+  bpt::ptree dev_array;
+  // iterate over all devices
+  for (const auto& [dev_id, dev_info] : m_devices) {
+    bpt::ptree dev;
+    dev.put("device_index", std::to_string(dev_id));
+    dev.put("bdf", dev_info.bdf);
+    auto active = totals.bo_active_count.find(dev_id);
+    dev.put("bos_peak_count", std::to_string(active == totals.bo_active_count.end() ? 0 : active->second));
+
+    // add global bos
+    dev.add_child("global_bos", get_bos_ptree(get_bo_metrics(totals, dev_id, nullptr)));
+
+    // add hw ctx info
+    dev.add_child("hw_context", get_hw_ctx_ptree(dev_id, dev_info.hw_ctx_vec, totals));
+
+    dev_array.push_back(std::make_pair("device", dev));
   }
 
-  print_json(thread_array);
+  return dev_array;
 }
 
 // class usage_metrics_logger - class for logging usage metrics
 //
-// Logging objects are created per thread 
-//
-// This class collects metrics from all threads using XRT
-// The metrics are collected in a thread safe manner.
+// A single logger object is shared by all threads.  Counters are
+// updated in thread local state without locking, so logging does
+// not serialize threads.  The per thread state is merged when the
+// report is generated after last reference to the logger is
+// released.
 class usage_metrics_logger : public xrt_core::usage_metrics::base_logger
 {
-public:
-  usage_metrics_logger();
+  // Registers thread local counters with the registry and merges
+  // them into the totals when the thread exits
+  struct thread_holder
+  {
+    std::shared_ptr<registry> reg = get_registry();
+    std::shared_ptr<thread_metrics> metrics = std::make_shared<thread_metrics>();
+
+    thread_holder()
+    {
+      reg->add_thread(metrics);
+    }
+
+    ~thread_holder()
+    {
+      reg->remove_thread(metrics.get());
+    }
+  };
+
+  static thread_metrics&
+  local()
+  {
+    static thread_local thread_holder holder;
+    return *holder.metrics;
+  }
 
+  std::shared_ptr<registry> m_registry = get_registry();
+
+public:
   ~usage_metrics_logger();
 
   void
@@ -318,37 +402,17 @@ public:
 
   void
   log_kernel_run_info(const xrt::kernel_impl*, const xrt::run_impl*, ert_cmd_state) override;
-
-private:
-  device_metrics_map m_dev_map;
-  std::shared_ptr<metrics_map> map_ptr;
 };
 
-usage_metrics_logger::
-usage_metrics_logger() : map_ptr(usage_metrics_map)
-{
-  thread_count++;
-}
-
 usage_metrics_logger::
 ~usage_metrics_logger()
 {
-  thread_count--;
-  {
-    std::lock_guard<std::mutex> lk(m);
-    // push this threads usage metrics to global map
-    // in thread safe manner
-    (*map_ptr)[std::this_thread::get_id()] = std::move(m_dev_map);
+  // print usage metrics log after last reference is released
+  try {
+    print_json(m_registry->report());
   }
-
-  if (thread_count == 0) {
-    // print usage metrics log after all threads are destroyed
-    try {
-      print_usage_metrics();
-    }
-    catch (const std::exception& e) {
-      std::cerr << " Failed to dump Usage metrics, exception occured - " << e.what() << std::endl;
-    }
+  catch (const std::exception& e) {
+    std::cerr << " Failed to dump Usage metrics, exception occured - " << e.what() << std::endl;
   }
 }
 
@@ -356,16 +420,9 @@ void
 usage_metrics_logger::
 log_device_info(const xrt_core::device* dev)
 {
-  auto dev_id = dev->get_device_id();
-  if (!get_device_metrics(m_dev_map, dev_id)) {
-    // initialize map with this device index
-    m_dev_map[dev_id] = {};
-    try {
-      auto bdf = xrt_core::query::pcie_bdf::to_string(xrt_core::device_query<xrt_core::query::pcie_bdf>(dev));
-      m_dev_map[dev_id].bdf = std::move(bdf);
-    }   
-    catch (...) {}
-  }
+  m_registry->add_device(dev->get_device_id(), [dev] {
+    return xrt_core::query::pcie_bdf::to_string(xrt_core::device_query<xrt_core::query::pcie_bdf>(dev));
+  });
 }
 
 void 
@@ -378,16 +435,7 @@ log_hw_ctx_info(const xrt::hw_context_impl* hwctx_impl)
     
     auto hwctx_handle = static_cast<xrt_core::hwctx_handle*>(hw_ctx);
     auto dev_id = xrt_core::hw_context_int::get_core_device(hw_ctx)->get_device_id();
-    auto uuid = hw_ctx.get_xclbin_uuid();
-
-    // dont log if device didn't match
-    auto dev_metrics = get_device_metrics(m_dev_map, dev_id);
-    if (!dev_metrics)
-      return;
-
-    // log if this entry is not logged before
-    if (!get_metrics(dev_metrics->hw_ctx_vec, hwctx_handle))
-      dev_metrics->log_hw_ctx(hwctx_handle, uuid);
+    m_registry->add_hw_ctx(dev_id, hwctx_handle, hw_ctx.get_xclbin_uuid());
   }
   catch(...) {
     // dont log anything
@@ -398,22 +446,13 @@ void
 usage_metrics_logger::
 log_buffer_info_construct(device_id dev_id, size_t sz, const xrt_core::hwctx_handle* handle)
 {
-  auto dev_metrics = get_device_metrics(m_dev_map, dev_id);
-  if (!dev_metrics)
-    return;
-
-  bo_metrics* bo_met = get_buffer_metrics(dev_metrics, handle);
-  // don't log if bo not found
-  if (!bo_met)
-    return;
-
-  bo_met->total_count++;
-  bo_met->total_size_in_bytes += sz;
-  bo_met->peak_size_in_bytes = std::max(bo_met->peak_size_in_bytes, sz);
+  auto& tm = local();
+  auto& bo_met = tm.bos[{dev_id, handle}];
+  bo_met.total_count++;
+  bo_met.total_size_in_bytes += sz;
+  bo_met.peak_size_in_bytes = std::max(bo_met.peak_size_in_bytes, sz);
   // increase active count in case of global or ctx bound bo
-  dev_metrics->bo_active_count++;
-  dev_metrics->bo_peak_count = 
-      std::max(dev_metrics->bo_peak_count, dev_metrics->bo_active_count);
+  tm.bo_active_count[dev_id]++;
 }
 
 void
@@ -429,41 +468,18 @@ void
 usage_metrics_logger::
 log_buffer_sync(device_id dev_id, const xrt_core::hwctx_handle* handle, size_t sz, xclBOSyncDirection dir)
 {
-  auto dev_metrics = get_device_metrics(m_dev_map, dev_id);
-  if (!dev_metrics)
-    return;
-
-  bo_metrics* bo_met = get_buffer_metrics(dev_metrics, handle);
-  // don't log if bo not found
-  if (!bo_met)
-    return;
-
+  auto& bo_met = local().bos[{dev_id, handle}];
   if (dir == XCL_BO_SYNC_BO_TO_DEVICE)
-    bo_met->bytes_synced_to_device += sz;
+    bo_met.bytes_synced_to_device += sz;
   else
-    bo_met->bytes_synced_from_device += sz;
+    bo_met.bytes_synced_from_device += sz;
 }
 
 void
 usage_metrics_logger::
 log_kernel_info(const xrt_core::device* dev, const xrt::hw_context& ctx, const std::string& name, size_t args)
 {
-  auto dev_id = dev->get_device_id();
-  auto hwctx_handle = static_cast<xrt_core::hwctx_handle*>(ctx);
-
-  auto dev_metrics = get_device_metrics(m_dev_map, dev_id);
-  if (!dev_metrics)
-    return;
-
-  auto hw_ctx_met = get_metrics(dev_metrics->hw_ctx_vec, hwctx_handle);
-  // dont log if hw ctx didn't match existing ones
-  if (!hw_ctx_met)
-    return;
-  
-  // log if this entry is not logged before
-  if (!get_metrics(hw_ctx_met->kernel_metrics_vec, name)) {
-    hw_ctx_met->log_kernel(name, args);
-  }
+  m_registry->add_kernel(dev->get_device_id(), static_cast<xrt_core::hwctx_handle*>(ctx), name, args);
 }
 
 void
@@ -471,7 +487,27 @@ usage_metrics_logger::
 log_kernel_run_info(const xrt::kernel_impl* krnl_impl, const xrt::run_impl* run_hdl, ert_cmd_state state)
 {
   // collecting time at start of call as next calls will be overhead
-  auto ts_now = std::chrono::high_resolution_clock::now();
+  auto ts_now = clock_type::now();
+  auto& tm = local();
+
+  // state ERT_CMD_STATE_NEW indicates kernel start is called, record
+  // start everytime because previous run may be finished, timeout,
+  // aborted or stopped
+  if (state == ERT_CMD_STATE_NEW) {
+    tm.run_start[run_hdl] = ts_now;
+    return;
+  }
+
+  auto itr = tm.run_start.find(run_hdl);
+  if (itr == tm.run_start.end())
+    return;
+
+  // invalidate start time, run may be finished, aborted or timed out
+  auto start = itr->second;
+  tm.run_start.erase(itr);
+  if (state != ERT_CMD_STATE_COMPLETED)
+    return;
+
   try {
     auto kernel =
         xrt_core::kernel_int::create_kernel_from_implementation(krnl_impl);
@@ -479,23 +515,10 @@ log_kernel_run_info(const xrt::kernel_impl* krnl_impl, const xrt::run_impl* run_
     auto hw_ctx = xrt_core::kernel_int::get_hw_ctx(kernel);
     auto hwctx_handle = static_cast<xrt_core::hwctx_handle*>(hw_ctx);
 
-    auto dev_id = xrt_core::hw_context_int::get_core_device(hw_ctx)->get_device_id();
-    auto name = kernel.get_name();
-
-    auto dev_metrics = get_device_metrics(m_dev_map, dev_id);
-    if (!dev_metrics)
-      return;
-
-    auto hw_ctx_met = get_metrics(dev_metrics->hw_ctx_vec, hwctx_handle);
-    // dont log if hw ctx didn't match existing ones
-    if (!hw_ctx_met)
-      return;
-  
-    auto kernel_met = get_metrics(hw_ctx_met->kernel_metrics_vec, name);
-    if (!kernel_met)
-      return;
-
-    kernel_met->log_kernel_exec_time(run_hdl, ts_now, state);
+    // valid run increment run count and add duration to total time
+    auto& run_met = tm.kernels[{hwctx_handle, kernel.get_name()}];
+    run_met.total_runs++;
+    run_met.total_time += std::chrono::duration_cast<std::chrono::microseconds>(ts_now - start);
   }
   catch(...) {
     // dont log anything
@@ -506,7 +529,7 @@ log_kernel_run_info(const xrt::kernel_impl* krnl_impl, const xrt::run_impl* run_
 static std::shared_ptr<xrt_core::usage_metrics::base_logger>
 get_logger_object()
 {
-  if (xrt_core::config::get_usage_metrics_logging())
+  if (xrt_core::usage_metrics::enabled())
     return std::make_shared<usage_metrics_logger>();
 
   return std::make_shared<xrt_core::usage_metrics::base_logger>();
@@ -515,11 +538,11 @@ get_logger_object()
 } // namespace
 
 namespace xrt_core::usage_metrics {
-// Per thread logger object  
+// Process wide logger object
 std::shared_ptr<base_logger>
 get_usage_metrics_logger()
 {
-  static thread_local auto usage_logger_object = get_logger_object();
+  static auto usage_logger_object = get_logger_object();
   return usage_logger_object;
 }
 } // xrt_core::usage_metrics
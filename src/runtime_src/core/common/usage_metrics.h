@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <string>
 
+#include "core/common/config_reader.h"
 #include "core/include/xrt.h"
 #include "core/include/xrt/xrt_hw_context.h"
 #include "core/include/xrt/xrt_kernel.h"
@@ -63,9 +64,21 @@ public:
   log_kernel_run_info(const xrt::kernel_impl*, const xrt::run_impl*, ert_cmd_state) {}
 };
 
-// get_usage_metrics_logger() - Return logger object for current thread
+// enabled() - Check if usage metrics logging is enabled
 //
-// Creates the logger object as thread local object.
+// Single branch check for hot paths to skip the logger call
+// altogether when logging is disabled.
+inline bool
+enabled()
+{
+  static const bool value = xrt_core::config::get_usage_metrics_logging();
+  return value;
+}
+
+// get_usage_metrics_logger() - Return logger object
+//
+// The logger object is shared by all threads, logged counters are
+// aggregated per thread without locking and merged for the report.
 // It is undefined behavior to delete the returned object.
 //
 // Access to underlying logger object is to facilitate caching
@@ -20,7 +20,10 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <string_view>
 #include <cstring>
 #include <cstdlib>
 #include <boost/property_tree/ptree.hpp>
@@ -33,6 +36,8 @@
 // This is xclbin parser. Update this file if xclbin format has changed.
 #ifdef _WIN32
 #pragma warning ( disable : 4996 )
+#else
+#include <zlib.h>
 #endif
 
 namespace {
@@ -43,6 +48,49 @@ using kernel_type = xrt_core::xclbin::kernel_properties::kernel_type;
 // NOLINTNEXTLINE
 constexpr size_t operator"" _kb(unsigned long long v)  { return 1024u * v; }
 
+// get_xml_tree() - Parsed XML meta data
+//
+// Loading an xclbin and constructing its kernels query the same
+// EMBEDDED_METADATA many times.  The parsed trees of the most
+// recently used XML meta data are cached and shared by all queries,
+// so the XML is parsed once per xclbin.  Cache entries are keyed by
+// the XML content itself, the XML of different xclbins cannot be
+// confused even when the raw data is at the same address.
+static std::shared_ptr<const pt::ptree>
+get_xml_tree(const char* xml_data, size_t xml_size)
+{
+  struct entry
+  {
+    std::string xml;
+    std::shared_ptr<const pt::ptree> tree;
+  };
+
+  constexpr size_t max_entries = 4;
+  static std::mutex mutex;
+  static std::vector<entry> cache; // most recently used first
+
+  std::string_view xml{xml_data, xml_size};
+  {
+    std::lock_guard lk(mutex);
+    auto itr = std::find_if(cache.begin(), cache.end(), [xml](const auto& e) { return e.xml == xml; });
+    if (itr != cache.end()) {
+      std::rotate(cache.begin(), itr, itr + 1);
+      return cache.front().tree;
+    }
+  }
+
+  auto tree = std::make_shared<pt::ptree>();
+  std::stringstream xml_stream;
+  xml_stream.write(xml_data, xml_size);
+  pt::read_xml(xml_stream, *tree);
+
+  std::lock_guard lk(mutex);
+  if (cache.size() == max_entries)
+    cache.pop_back();
+  cache.insert(cache.begin(), entry{std::string{xml}, tree});
+  return tree;
+}
+
 static size_t
 convert(const std::string& str)
 {
@@ -392,8 +440,26 @@ merge_args(std::vector<xrt_core::xclbin::kernel_argument>& args)
 
 namespace xrt_core { namespace xclbin {
 
+// find_axlf_section() - section of kind, or compressed section of kind
+static const axlf_section_header*
+find_axlf_section(const axlf* top, axlf_section_kind kind, bool compressed)
+{
+  if (auto hdr = ::xclbin::get_axlf_section(top, kind))
+    return hdr;
+
+  if (!compressed)
+    return nullptr;
+
+  auto begin = top->m_sections;
+  auto end = begin + top->m_header.m_numSections;
+  auto itr = std::find_if(begin, end, [kind](const auto& hdr) {
+    return hdr.m_sectionKind == (static_cast<uint32_t>(kind) | AXLF_SECTION_COMPRESSED);
+  });
+  return (itr != end) ? &(*itr) : nullptr;
+}
+
 const axlf_section_header*
-get_axlf_section(const axlf* top, axlf_section_kind kind)
+get_axlf_section(const axlf* top, axlf_section_kind kind, bool compressed)
 {
   // replace group kinds with none group kinds if grouping
   // is disabled per xrt.ini
@@ -403,20 +469,77 @@ get_axlf_section(const axlf* top, axlf_section_kind kind)
   else if (kind == ASK_GROUP_CONNECTIVITY && !use_groups)
     kind = CONNECTIVITY;
 
-  if (auto hdr = ::xclbin::get_axlf_section(top, kind))
+  if (auto hdr = find_axlf_section(top, kind, compressed))
     return hdr;
 
   // hdr is nullptr, check if kind is one of the group sections,
   // which then does not appear in the xclbin and should default to
   // the none group one.
   if (kind == ASK_GROUP_TOPOLOGY)
-    return ::xclbin::get_axlf_section(top, MEM_TOPOLOGY);
+    return find_axlf_section(top, MEM_TOPOLOGY, compressed);
   else if (kind == ASK_GROUP_CONNECTIVITY)
-    return ::xclbin::get_axlf_section(top, CONNECTIVITY);
+    return find_axlf_section(top, CONNECTIVITY, compressed);
 
   return nullptr;
 }
 
+const axlf_section_header*
+get_axlf_section(const axlf* top, axlf_section_kind kind)
+{
+  return get_axlf_section(top, kind, false);
+}
+
+std::vector<char>
+decompress_section(const char* data, size_t size)
+{
+#ifndef _WIN32
+  if (size < sizeof(axlf_compressed_section))
+    throw std::runtime_error("Invalid compressed xclbin section");
+
+  auto hdr = reinterpret_cast<const axlf_compressed_section*>(data);
+  if (hdr->m_compression != AXLF_COMPRESSION_ZLIB)
+    throw std::runtime_error("Unsupported xclbin section compression: " + std::to_string(hdr->m_compression));
+
+  z_stream stream = {};
+  if (inflateInit(&stream) != Z_OK)
+    throw std::runtime_error("Failed to initialize xclbin section decompression");
+
+  // Decode straight into the uncompressed section, the z_stream
+  // counts are 32 bit so input and output are fed in chunks
+  std::vector<char> section(hdr->m_uncompressedSize);
+  constexpr size_t chunk_size = std::numeric_limits<uInt>::max();
+  size_t in_left = size - sizeof(axlf_compressed_section);
+  size_t out_left = section.size();
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data + sizeof(axlf_compressed_section))); // NOLINT
+  stream.next_out = reinterpret_cast<Bytef*>(section.data());
+
+  int ret = Z_OK;
+  while (ret == Z_OK) {
+    if (stream.avail_in == 0) {
+      auto count = std::min(in_left, chunk_size);
+      stream.avail_in = static_cast<uInt>(count);
+      in_left -= count;
+    }
+    if (stream.avail_out == 0) {
+      auto count = std::min(out_left, chunk_size);
+      stream.avail_out = static_cast<uInt>(count);
+      out_left -= count;
+    }
+    ret = inflate(&stream, Z_NO_FLUSH);
+  }
+  inflateEnd(&stream);
+
+  if (ret != Z_STREAM_END || out_left != 0 || stream.avail_out != 0)
+    throw std::runtime_error("Corrupted compressed xclbin section");
+
+  return section;
+#else
+  (void)data;
+  (void)size;
+  throw std::runtime_error("Compressed xclbin sections are not supported on Windows");
+#endif
+}
+
 std::string
 memidx_to_name(const mem_topology* mem_topology,  int32_t midx)
 {
@@ -472,10 +595,8 @@ get_first_used_mem(const axlf* top)
 size_t
 get_max_cu_size(const char* xml_data, size_t xml_size)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
+  auto xml_tree = get_xml_tree(xml_data, xml_size);
+  const auto& xml_project = *xml_tree;
 
   size_t maxsz = 0;
 
@@ -627,10 +748,8 @@ get_cus(const char* xml_data, size_t xml_size, bool)
 {
   std::vector<uint64_t> cus;
 
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data, xml_size);
-  pt::read_xml(xml_stream, xml_project);
+  auto xml_tree = get_xml_tree(xml_data, xml_size);
+  const auto& xml_project = *xml_tree;
 
   for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
     if (xml_kernel.first != "kernel")
@@ -896,10 +1015,8 @@ get_kernel_freq(const axlf* top)
   size_t kernel_clk_freq = default_kernel_clk_freq;
   auto xml = get_xml_section(top);
 
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml.first,xml.second);
-  pt::read_xml(xml_stream,xml_project);
+  auto xml_tree = get_xml_tree(xml.first, xml.second);
+  const auto& xml_project = *xml_tree;
 
   auto clock_child = xml_project.get_child_optional("project.platform.device.core.kernelClocks");
 
@@ -925,60 +1042,107 @@ get_kernel_freq(const axlf* top)
   return kernel_clk_freq;
 }
 
-std::vector<kernel_argument>
-get_kernel_arguments(const char* xml_data, size_t xml_size, const std::string& kname)
+// Arguments of a kernel from its parsed <kernel> element
+static std::vector<kernel_argument>
+get_kernel_arguments(const pt::ptree& xml_kernel)
 {
   std::vector<kernel_argument> args;
+  auto pwmap = get_portname_width_map(xml_kernel);
 
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
+  for (auto& xml_arg : xml_kernel) {
+    if (xml_arg.first != "arg")
+      continue;
+
+    std::string id = xml_arg.second.get<std::string>("<xmlattr>.id");
+    size_t index = id.empty() ? kernel_argument::no_index : convert(id);
+
+    std::string port = xml_arg.second.get<std::string>("<xmlattr>.port", "no-port");
+    auto itr = pwmap.find(port);
+    size_t pwidth = (itr != pwmap.end()) ? (*itr).second : 0;
+
+    args.emplace_back(kernel_argument{
+        xml_arg.second.get<std::string>("<xmlattr>.name")
+       ,xml_arg.second.get<std::string>("<xmlattr>.type", "no-type")
+       ,port
+       ,pwidth
+       ,index
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.offset"))
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.size"))
+       ,convert(xml_arg.second.get<std::string>("<xmlattr>.hostSize"))
+       ,0  // fa_desc_offset post computed if necessary
+       ,kernel_argument::argtype(xml_arg.second.get<size_t>("<xmlattr>.addressQualifier"))
+       ,kernel_argument::direction(kernel_argument::direction::input)
+    });
+  }
 
+  // stable sort to preserve order of multi-component arguments
+  // for example global_size, local_size, etc.
+  std::stable_sort(args.begin(), args.end(), [](auto& a1, auto& a2) { return a1.index < a2.index; });
+
+  // merge args with same index
+  merge_args(args);
+
+  return args;
+}
+
+// Properties of a kernel from its parsed <kernel> element
+static kernel_properties
+get_kernel_properties(const pt::ptree& xml_kernel, const std::string& kname)
+{
+  // Determine features
+  auto mailbox = convert_to_mailbox_type(xml_kernel.get<std::string>("<xmlattr>.mailbox", "none"));
+  if (mailbox == kernel_properties::mailbox_type::none)
+    mailbox = get_mailbox_from_ini(kname);
+  auto restart = convert(xml_kernel.get<std::string>("<xmlattr>.countedAutoRestart", "0"));
+  if (restart == 0)
+    restart = get_restart_from_ini(kname);
+  auto sw_reset = to_bool(xml_kernel.get<std::string>("<xmlattr>.swReset", "false"));
+  if (!sw_reset)
+    sw_reset = get_sw_reset_from_ini(kname);
+
+  auto functional = get_functional(xml_kernel, "extended-data");
+  auto kernel_id = get_kernel_id(xml_kernel, "extended-data");
+
+  return kernel_properties
+    { kname
+    , to_kernel_type(xml_kernel.get<std::string>("<xmlattr>.type", "pl"))
+    , restart
+    , mailbox
+    , get_address_range(xml_kernel)
+    , sw_reset
+    , functional
+    , kernel_id
+
+    , convert(xml_kernel.get<std::string>("<xmlattr>.workGroupSize", "0"))
+    , get_xyz(xml_kernel, "compileWorkGroupSize")
+    , get_xyz(xml_kernel, "maxWorkGroupSize")
+    , get_stringtable(xml_kernel) };
+}
+
+// The <kernel> element of named kernel, or nullptr if no such kernel
+static const pt::ptree*
+get_xml_kernel(const pt::ptree& xml_project, const std::string& kname)
+{
   for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
     if (xml_kernel.first != "kernel")
       continue;
     if (xml_kernel.second.get<std::string>("<xmlattr>.name") != kname)
       continue;
 
-    auto pwmap = get_portname_width_map(xml_kernel.second);
-
-    for (auto& xml_arg : xml_kernel.second) {
-      if (xml_arg.first != "arg")
-        continue;
-
-      std::string id = xml_arg.second.get<std::string>("<xmlattr>.id");
-      size_t index = id.empty() ? kernel_argument::no_index : convert(id);
-
-      std::string port = xml_arg.second.get<std::string>("<xmlattr>.port", "no-port");
-      auto itr = pwmap.find(port);
-      size_t pwidth = (itr != pwmap.end()) ? (*itr).second : 0;
-
-      args.emplace_back(kernel_argument{
-          xml_arg.second.get<std::string>("<xmlattr>.name")
-         ,xml_arg.second.get<std::string>("<xmlattr>.type", "no-type")
-         ,port
-         ,pwidth
-         ,index
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.offset"))
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.size"))
-         ,convert(xml_arg.second.get<std::string>("<xmlattr>.hostSize"))
-         ,0  // fa_desc_offset post computed if necessary
-         ,kernel_argument::argtype(xml_arg.second.get<size_t>("<xmlattr>.addressQualifier"))
-         ,kernel_argument::direction(kernel_argument::direction::input)
-      });
-    }
+    return &xml_kernel.second;
+  }
 
-    // stable sort to preserve order of multi-component arguments
-    // for example global_size, local_size, etc.
-    std::stable_sort(args.begin(), args.end(), [](auto& a1, auto& a2) { return a1.index < a2.index; });
+  return nullptr;
+}
 
-    // merge args with same index
-    merge_args(args);
+std::vector<kernel_argument>
+get_kernel_arguments(const char* xml_data, size_t xml_size, const std::string& kname)
+{
+  auto xml_tree = get_xml_tree(xml_data, xml_size);
+  const auto& xml_project = *xml_tree;
 
-    break;
-  }
-  return args;
+  auto xml_kernel = get_xml_kernel(xml_project, kname);
+  return xml_kernel ? get_kernel_arguments(*xml_kernel) : std::vector<kernel_argument>{};
 }
 
 std::vector<kernel_argument>
@@ -991,49 +1155,11 @@ get_kernel_arguments(const axlf* top, const std::string& kname)
 kernel_properties
 get_kernel_properties(const char* xml_data, size_t xml_size, const std::string& kname)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
-
-  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
-    if (xml_kernel.first != "kernel")
-      continue;
-    if (xml_kernel.second.get<std::string>("<xmlattr>.name") != kname)
-      continue;
+  auto xml_tree = get_xml_tree(xml_data, xml_size);
+  const auto& xml_project = *xml_tree;
 
-    // Determine features
-    auto mailbox = convert_to_mailbox_type(xml_kernel.second.get<std::string>("<xmlattr>.mailbox", "none"));
-    if (mailbox == kernel_properties::mailbox_type::none)
-      mailbox = get_mailbox_from_ini(kname);
-    auto restart = convert(xml_kernel.second.get<std::string>("<xmlattr>.countedAutoRestart", "0"));
-    if (restart == 0)
-      restart = get_restart_from_ini(kname);
-    auto sw_reset = to_bool(xml_kernel.second.get<std::string>("<xmlattr>.swReset", "false"));
-    if (!sw_reset)
-      sw_reset = get_sw_reset_from_ini(kname);
-
-    auto functional = get_functional(xml_kernel.second, "extended-data");
-    auto kernel_id = get_kernel_id(xml_kernel.second, "extended-data");
-
-    return kernel_properties
-      { kname
-      , to_kernel_type(xml_kernel.second.get<std::string>("<xmlattr>.type", "pl"))
-      , restart
-      , mailbox
-      , get_address_range(xml_kernel.second)
-      , sw_reset
-      , functional
-      , kernel_id
-
-      , convert(xml_kernel.second.get<std::string>("<xmlattr>.workGroupSize", "0"))
-      , get_xyz(xml_kernel.second, "compileWorkGroupSize")
-      , get_xyz(xml_kernel.second, "maxWorkGroupSize")
-      , get_stringtable(xml_kernel.second) };
-
-  }
-
-  return kernel_properties{};
+  auto xml_kernel = get_xml_kernel(xml_project, kname);
+  return xml_kernel ? get_kernel_properties(*xml_kernel, kname) : kernel_properties{};
 }
 
 kernel_properties
@@ -1048,10 +1174,8 @@ get_kernel_names(const char *xml_data, size_t xml_size)
 {
   std::vector<std::string> names;
 
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
+  auto xml_tree = get_xml_tree(xml_data, xml_size);
+  const auto& xml_project = *xml_tree;
 
   for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
     if (xml_kernel.first != "kernel")
@@ -1068,14 +1192,23 @@ get_kernels(const char* xml_data, size_t xml_size)
 {
   std::vector<kernel_object> kernels;
 
-  auto knames = get_kernel_names(xml_data, xml_size);
-  for (auto& kname : get_kernel_names(xml_data, xml_size)) {
-    auto kprop = get_kernel_properties(xml_data, xml_size, kname);
+  auto xml_tree = get_xml_tree(xml_data, xml_size);
+  const auto& xml_project = *xml_tree;
+
+  for (auto& xml_kernel : xml_project.get_child("project.platform.device.core")) {
+    if (xml_kernel.first != "kernel")
+      continue;
+
+    auto kname = xml_kernel.second.get<std::string>("<xmlattr>.name");
+    auto kprop = get_kernel_properties(xml_kernel.second, kname);
+    auto range = kprop.address_range;
+    auto sw_reset = kprop.sw_reset;
     kernels.emplace_back(kernel_object{
-        kname
-       ,get_kernel_arguments(xml_data, xml_size, kname)
-       ,kprop.address_range
-       ,kprop.sw_reset
+        std::move(kname)
+       ,get_kernel_arguments(xml_kernel.second)
+       ,range
+       ,sw_reset
+       ,std::move(kprop)
     });
   }
 
@@ -1086,9 +1219,160 @@ std::vector<kernel_object>
 get_kernels(const axlf* top)
 {
   auto xml = get_xml_section(top);
+  if (auto hdr = ::xclbin::get_axlf_section(top, RUNTIME_INDEX)) {
+    auto index_data = reinterpret_cast<const char*>(top) + hdr->m_sectionOffset;
+    if (auto index = get_runtime_index(index_data, hdr->m_sectionSize, xml.first, xml.second))
+      return std::move(index->kernels);
+  }
+
   return get_kernels(xml.first, xml.second);
 }
 
+// FNV-1a 64 bit hash identifying the XML meta data of a RUNTIME_INDEX
+static uint64_t
+get_metadata_hash(const char* data, size_t size)
+{
+  uint64_t hash = 0xcbf29ce484222325; // NOLINT
+  for (size_t idx = 0; idx < size; ++idx) {
+    hash ^= static_cast<unsigned char>(data[idx]);
+    hash *= 0x100000001b3; // NOLINT
+  }
+  return hash;
+}
+
+// class runtime_index_reader - bounds checked access to RUNTIME_INDEX
+//
+// Throws std::runtime_error on any reference outside of the section.
+class runtime_index_reader
+{
+  const char* m_data;
+  size_t m_size;
+
+public:
+  runtime_index_reader(const char* data, size_t size)
+    : m_data(data), m_size(size)
+  {}
+
+  std::string
+  get_string(uint32_t offset) const
+  {
+    if (offset >= m_size)
+      throw std::runtime_error("runtime index string out of range");
+    auto begin = m_data + offset;
+    auto end = static_cast<const char*>(std::memchr(begin, '\0', m_size - offset));
+    if (!end)
+      throw std::runtime_error("runtime index string not terminated");
+    return {begin, end};
+  }
+
+  template <typename ElementType>
+  const ElementType*
+  get_array(const array_offset& array) const
+  {
+    if (array.offset > m_size || array.size > (m_size - array.offset) / sizeof(ElementType))
+      throw std::runtime_error("runtime index array out of range");
+    return reinterpret_cast<const ElementType*>(m_data + array.offset);
+  }
+};
+
+static kernel_object
+get_kernel_object(const runtime_index_reader& reader, const runtime_index_kernel& xkernel)
+{
+  auto kname = reader.get_string(xkernel.name);
+
+  std::vector<kernel_argument> args;
+  args.reserve(xkernel.args.size);
+  auto xargs = reader.get_array<runtime_index_arg>(xkernel.args);
+  for (uint32_t idx = 0; idx < xkernel.args.size; ++idx) {
+    const auto& xarg = xargs[idx];
+    args.emplace_back(kernel_argument{
+        reader.get_string(xarg.name)
+       ,reader.get_string(xarg.host_type)
+       ,reader.get_string(xarg.port)
+       ,xarg.port_width
+       ,xarg.index == RUNTIME_INDEX_NO_INDEX ? kernel_argument::no_index : xarg.index
+       ,xarg.offset
+       ,xarg.size
+       ,xarg.host_size
+       ,0  // fa_desc_offset post computed if necessary
+       ,kernel_argument::argtype(xarg.address_qualifier)
+       ,kernel_argument::direction(kernel_argument::direction::input)
+    });
+  }
+
+  std::map<uint32_t, std::string> stbl;
+  auto xstrings = reader.get_array<runtime_index_string>(xkernel.string_table);
+  for (uint32_t idx = 0; idx < xkernel.string_table.size; ++idx)
+    stbl.emplace(xstrings[idx].id, reader.get_string(xstrings[idx].value));
+
+  // Same xrt.ini overrides as for properties from the XML
+  auto mailbox = static_cast<kernel_properties::mailbox_type>(xkernel.mailbox);
+  if (mailbox == kernel_properties::mailbox_type::none)
+    mailbox = get_mailbox_from_ini(kname);
+  auto restart = static_cast<kernel_properties::restart_type>(xkernel.counted_auto_restart);
+  if (restart == 0)
+    restart = get_restart_from_ini(kname);
+  bool sw_reset = xkernel.sw_reset != 0;
+  if (!sw_reset)
+    sw_reset = get_sw_reset_from_ini(kname);
+
+  kernel_properties kprop
+    { kname
+    , static_cast<kernel_type>(xkernel.type)
+    , restart
+    , mailbox
+    , xkernel.address_range
+    , sw_reset
+    , xkernel.functional
+    , xkernel.kernel_id
+
+    , xkernel.workgroup_size
+    , {xkernel.compile_workgroup_size[0], xkernel.compile_workgroup_size[1], xkernel.compile_workgroup_size[2]}
+    , {xkernel.max_workgroup_size[0], xkernel.max_workgroup_size[1], xkernel.max_workgroup_size[2]}
+    , std::move(stbl) };
+
+  auto range = kprop.address_range;
+  return kernel_object{
+      std::move(kname)
+     ,std::move(args)
+     ,range
+     ,sw_reset
+     ,std::move(kprop)
+  };
+}
+
+std::optional<runtime_index_object>
+get_runtime_index(const char* index_data, size_t index_size, const char* xml_data, size_t xml_size)
+{
+  if (!index_data || !xml_data || index_size < sizeof(runtime_index))
+    return std::nullopt;
+
+  auto xindex = reinterpret_cast<const runtime_index*>(index_data);
+  if (xindex->schema_version != RUNTIME_INDEX_SCHEMA_VERSION)
+    return std::nullopt;
+
+  // An index is stale if the XML was replaced after it was created
+  if (xindex->metadata_size != xml_size || xindex->metadata_hash != get_metadata_hash(xml_data, xml_size))
+    return std::nullopt;
+
+  try {
+    runtime_index_reader reader{index_data, index_size};
+    runtime_index_object index;
+    index.project_name = reader.get_string(xindex->project_name);
+    index.fpga_device_name = reader.get_string(xindex->fpga_device_name);
+
+    auto xkernels = reader.get_array<runtime_index_kernel>(xindex->kernels);
+    index.kernels.reserve(xindex->kernels.size);
+    for (uint32_t idx = 0; idx < xindex->kernels.size; ++idx)
+      index.kernels.emplace_back(get_kernel_object(reader, xkernels[idx]));
+
+    return index;
+  }
+  catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
 // PDI only XCLBIN has PDI section only;
 // Or has AIE_METADATA and PDI sections only
 bool
@@ -1114,10 +1398,8 @@ get_vbnv(const axlf* top)
 std::string
 get_project_name(const char* xml_data, size_t xml_size)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
+  auto xml_tree = get_xml_tree(xml_data, xml_size);
+  const auto& xml_project = *xml_tree;
 
   return xml_project.get<std::string>("project.<xmlattr>.name","");
 }
@@ -1137,10 +1419,8 @@ get_project_name(const axlf* top)
 std::string
 get_fpga_device_name(const char* xml_data, size_t xml_size)
 {
-  pt::ptree xml_project;
-  std::stringstream xml_stream;
-  xml_stream.write(xml_data,xml_size);
-  pt::read_xml(xml_stream,xml_project);
+  auto xml_tree = get_xml_tree(xml_data, xml_size);
+  const auto& xml_project = *xml_tree;
 
   return xml_project.get<std::string>("project.platform.device.<xmlattr>.fpgaDevice","");
 }
@@ -24,6 +24,7 @@
 #include <array>
 #include <limits>
 #include <map>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -79,6 +80,15 @@ struct kernel_object
   std::vector<kernel_argument> args;
   size_t range;
   bool sw_reset;
+  kernel_properties properties;
+};
+
+// struct runtime_index_object - pre-resolved meta data from RUNTIME_INDEX
+struct runtime_index_object
+{
+  std::string project_name;
+  std::string fpga_device_name;
+  std::vector<kernel_object> kernels;
 };
 
 // struct softkernel_object - wrapper for a soft kernel object
@@ -151,6 +161,34 @@ XRT_CORE_COMMON_EXPORT
 const axlf_section_header*
 get_axlf_section(const axlf* top, axlf_section_kind kind);
 
+/**
+ * get_axlf_section() - retrieve axlf section header, possibly compressed
+ *
+ * @top: axlf to retrieve section from
+ * @kind: section kind to retrieve
+ * @compressed: also retrieve a compressed section of @kind
+ *
+ * An uncompressed section takes precedence over a compressed one.  A
+ * compressed section header has AXLF_SECTION_COMPRESSED in its kind
+ * and the section data must be decompressed with decompress_section().
+ */
+XRT_CORE_COMMON_EXPORT
+const axlf_section_header*
+get_axlf_section(const axlf* top, axlf_section_kind kind, bool compressed);
+
+/**
+ * decompress_section() - decompress the data of a compressed section
+ *
+ * @data: section data starting with struct axlf_compressed_section
+ * @size: size of section data
+ * Return: Uncompressed section data
+ *
+ * Throws on unsupported compression or corrupted data.
+ */
+XRT_CORE_COMMON_EXPORT
+std::vector<char>
+decompress_section(const char* data, size_t size);
+
 /**
  * Get specific binary section of the axlf structure
  *
@@ -375,6 +413,8 @@ get_kernel_properties(const axlf* top, const std::string& kname);
 /**
  * get_kernels() - Get meta data for all kernels
  *
+ * The XML meta data is parsed once for all kernels.
+ *
  * Return: List of struct kernel_object
  */
 XRT_CORE_COMMON_EXPORT
@@ -390,6 +430,23 @@ XRT_CORE_COMMON_EXPORT
 std::vector<kernel_object>
 get_kernels(const axlf* top);
 
+/**
+ * get_runtime_index() - Get pre-resolved meta data from RUNTIME_INDEX
+ *
+ * @index_data: RUNTIME_INDEX section data
+ * @index_size: RUNTIME_INDEX section size
+ * @xml_data: EMBEDDED_METADATA section data
+ * @xml_size: EMBEDDED_METADATA section size
+ * Return: Meta data, or std::nullopt if the index is malformed or was
+ *  created from other XML meta data
+ *
+ * The returned kernels are identical to get_kernels() of the XML
+ * meta data, kernel properties overridden by xrt.ini are applied.
+ */
+XRT_CORE_COMMON_EXPORT
+std::optional<runtime_index_object>
+get_runtime_index(const char* index_data, size_t index_size, const char* xml_data, size_t xml_size);
+
 /**
  * is_pdi_only() - If the xclbin has only one section and is PDI
  */
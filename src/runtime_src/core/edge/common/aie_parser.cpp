@@ -18,8 +18,12 @@
 #include "core/common/device.h"
 #include "core/include/xclbin.h"
 
+#include <list>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <iostream>
 
 #include <boost/property_tree/ptree.hpp>
@@ -52,6 +56,36 @@ read_aie_metadata(const char* data, size_t size, pt::ptree& aie_project)
   pt::read_json(aie_stream,aie_project);
 }
 
+// Parsing the AIE metadata json dominates graph and partition setup,
+// most accessors below are called per graph or per GMIO of the same
+// xclbin.  Parsed metadata is cached by section contents, so the same
+// xclbin loaded again or in another context is not parsed again.
+// Comparing the contents is much cheaper than parsing them.
+static std::shared_ptr<const pt::ptree>
+get_aie_metadata(const char* data, size_t size)
+{
+  static constexpr size_t cache_max = 4;
+  static std::mutex mutex;
+  // most recently used first
+  static std::list<std::pair<std::string, std::shared_ptr<const pt::ptree>>> cache;
+
+  std::string_view key{data, size};
+  std::lock_guard lk(mutex);
+  for (auto itr = cache.begin(); itr != cache.end(); ++itr) {
+    if (itr->first == key) {
+      cache.splice(cache.begin(), cache, itr);
+      return itr->second;
+    }
+  }
+
+  auto aie_meta = std::make_shared<pt::ptree>();
+  read_aie_metadata(data, size, *aie_meta);
+  cache.emplace_front(std::string{key}, aie_meta);
+  if (cache.size() > cache_max)
+    cache.pop_back();
+  return aie_meta;
+}
+
 adf::driver_config
 get_driver_config(const pt::ptree& aie_meta)
 {
@@ -493,200 +527,151 @@ get_trace_gmio(const pt::ptree& aie_meta)
 
 namespace xrt_core { namespace edge { namespace aie {
 
-adf::driver_config
-get_driver_config(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
+static std::shared_ptr<const pt::ptree>
+get_aie_metadata(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
 {
   auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
   auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
   if (!data.first || !data.second)
-    return {};
+    return nullptr;
+
+  return ::get_aie_metadata(data.first, data.second);
+}
 
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_driver_config(aie_meta);
+adf::driver_config
+get_driver_config(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
+{
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
+    return {};
+  return ::get_driver_config(*aie_meta);
 }
 
 adf::aiecompiler_options
 get_aiecompiler_options(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return {};
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_aiecompiler_options(aie_meta);
+  return ::get_aiecompiler_options(*aie_meta);
 }
 
 adf::graph_config
 get_graph(const xrt_core::device* device, const std::string& graph_name, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return {};
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_graph(aie_meta, graph_name);
+  return ::get_graph(*aie_meta, graph_name);
 }
 
 int
 get_graph_id(const xrt_core::device* device, const std::string& graph_name, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return -1;
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_graph_id(aie_meta, graph_name);
+  return ::get_graph_id(*aie_meta, graph_name);
 }
 
 std::vector<std::string>
 get_graphs(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return {};
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_graphs(aie_meta);
+  return ::get_graphs(*aie_meta);
 }
 
 std::vector<tile_type>
 get_tiles(const xrt_core::device* device, const std::string& graph_name, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return {};
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_tiles(aie_meta, graph_name);
+  return ::get_tiles(*aie_meta, graph_name);
 }
 
 std::vector<tile_type>
 get_event_tiles(const xrt_core::device* device, const std::string& graph_name,
                     module_type type, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return {};
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_event_tiles(aie_meta, graph_name, type);
+  return ::get_event_tiles(*aie_meta, graph_name, type);
 }
 
 std::unordered_map<std::string, adf::rtp_config>
 get_rtp(const xrt_core::device* device, int graph_id, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return {};
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_rtp(aie_meta, graph_id);
+  return ::get_rtp(*aie_meta, graph_id);
 }
 
 std::unordered_map<std::string, adf::gmio_config>
 get_gmios(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return {};
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_gmios(aie_meta);
+  return ::get_gmios(*aie_meta);
 }
 
 std::unordered_map<std::string, adf::plio_config>
 get_plios(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return {};
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_plios(aie_meta);
+  return ::get_plios(*aie_meta);
 }
 
 double
 get_clock_freq_mhz(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return 1000.0;  // magic
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_clock_freq_mhz(aie_meta);
+  return ::get_clock_freq_mhz(*aie_meta);
 }
 
 std::vector<counter_type>
 get_profile_counters(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return {};
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_profile_counter(aie_meta);
+  return ::get_profile_counter(*aie_meta);
 }
 
 std::vector<gmio_type>
 get_trace_gmios(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return {};
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_trace_gmio(aie_meta);
+  return ::get_trace_gmio(*aie_meta);
 }
 /* hw_gen represents aie version 1.aie, 2.aie-ml etc */
 uint8_t
 get_hw_gen(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return 1; // default is aie-1
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_hw_gen(aie_meta);
+  return ::get_hw_gen(*aie_meta);
 }
 
 uint32_t
 get_partition_id(const xrt_core::device* device, const zynqaie::hwctx_object* hwctx)
 {
-  auto xclbin_uuid = hwctx ? hwctx->get_xclbin_uuid() : uuid();
-  auto data = device->get_axlf_section(AIE_METADATA, xclbin_uuid);
-  if (!data.first || !data.second)
+  auto aie_meta = get_aie_metadata(device, hwctx);
+  if (!aie_meta)
     return 1; 
-
-  pt::ptree aie_meta;
-  read_aie_metadata(data.first, data.second, aie_meta);
-  return ::get_partition_id(aie_meta);
+  return ::get_partition_id(*aie_meta);
 }
 
 }}} // aie, edge, xrt_core
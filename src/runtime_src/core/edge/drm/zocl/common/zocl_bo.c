@@ -57,7 +57,10 @@ void zocl_describe(const struct drm_zocl_bo *obj)
 static inline void
 zocl_bo_describe(const struct drm_zocl_bo *bo, uint64_t *size, uint64_t *paddr)
 {
-	if (bo->flags & (ZOCL_BO_FLAGS_CMA | ZOCL_BO_FLAGS_USERPTR)) {
+	if (bo->flags & ZOCL_BO_FLAGS_SG) {
+		*size = (uint64_t)bo->gem_base.size;
+		*paddr = (uint64_t)sg_dma_address(bo->sgt->sgl);
+	} else if (bo->flags & (ZOCL_BO_FLAGS_CMA | ZOCL_BO_FLAGS_USERPTR)) {
 		*size = (uint64_t)bo->cma_base.base.size;
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 1, 0)
 		*paddr = (uint64_t)bo->cma_base.dma_addr;
@@ -195,6 +198,153 @@ zocl_create_cma_mem(struct drm_device *dev, size_t size)
 	return bo;
 }
 
+/*
+ * SG BOs are used instead of CMA when the device sits behind an SMMU
+ * that is managed by the DMA API. zocl owning the IOMMU domain itself
+ * (SVM) is handled separately.
+ */
+static bool zocl_sg_bo_supported(struct drm_device *dev)
+{
+	struct drm_zocl_dev *zdev = dev->dev_private;
+	struct iommu_domain *domain;
+
+	if (!zocl_sg_bo || zdev->domain)
+		return false;
+
+	domain = iommu_get_domain_for_dev(dev->dev);
+	return domain && domain->type != IOMMU_DOMAIN_IDENTITY;
+}
+
+/*
+ * The PL is cache coherent with the APU when it masters memory through
+ * the HPC or ACP port, which the device tree marks with "dma-coherent".
+ * CPU caches are then snooped and cacheable BOs need no maintenance.
+ */
+static bool zocl_bo_coherent_port(struct drm_device *dev)
+{
+	return zocl_coherent_bo && dev->dev->of_node &&
+	    of_dma_is_coherent(dev->dev->of_node);
+}
+
+/*
+ * This function allocates a BO from non-contiguous pages and maps it
+ * through the SMMU into one contiguous device address range. Physical
+ * contiguity is not needed, so fragmentation of CMA does not matter.
+ *
+ * @param       dev:	drm device structure
+ * @param       size:	requested memory size, page aligned
+ *
+ * @return	bo pointer on success, error code on failure
+ */
+static struct drm_zocl_bo *
+zocl_create_sg_mem(struct drm_device *dev, size_t size)
+{
+	struct drm_zocl_bo *bo;
+	int nents;
+	int err;
+
+	bo = kzalloc(sizeof(*bo), GFP_KERNEL);
+	if (!bo)
+		return ERR_PTR(-ENOMEM);
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 11, 0)
+	bo->gem_base.funcs = &zocl_gem_object_funcs;
+#endif
+	err = drm_gem_object_init(dev, &bo->gem_base, size);
+	if (err) {
+		kfree(bo);
+		return ERR_PTR(err);
+	}
+	bo->flags = ZOCL_BO_FLAGS_SG;
+
+	bo->pages = drm_gem_get_pages(&bo->gem_base);
+	if (IS_ERR(bo->pages)) {
+		err = PTR_ERR(bo->pages);
+		bo->pages = NULL;
+		goto out_free;
+	}
+
+#if LINUX_VERSION_CODE <= KERNEL_VERSION(5, 9, 0)
+	bo->sgt = drm_prime_pages_to_sg(bo->pages, size >> PAGE_SHIFT);
+#else
+	bo->sgt = drm_prime_pages_to_sg(dev, bo->pages, size >> PAGE_SHIFT);
+#endif
+	if (IS_ERR(bo->sgt)) {
+		err = PTR_ERR(bo->sgt);
+		bo->sgt = NULL;
+		goto out_free;
+	}
+
+	nents = dma_map_sg(dev->dev, bo->sgt->sgl, bo->sgt->orig_nents,
+	    DMA_BIDIRECTIONAL);
+	if (!nents) {
+		err = -ENOMEM;
+		goto out_free;
+	}
+	bo->sgt->nents = nents;
+	if (nents != 1) {
+		/* PL kernels need one contiguous device address range */
+		DRM_DEBUG("SG BO is mapped in %d segments\n", nents);
+		err = -EINVAL;
+		goto out_free;
+	}
+
+	bo->vmapping = vmap(bo->pages, size >> PAGE_SHIFT, VM_MAP,
+	    pgprot_writecombine(PAGE_KERNEL));
+	if (!bo->vmapping) {
+		err = -ENOMEM;
+		goto out_free;
+	}
+
+	err = drm_gem_create_mmap_offset(&bo->gem_base);
+	if (err)
+		goto out_free;
+
+	return bo;
+
+out_free:
+	zocl_free_sg_bo(&bo->gem_base);
+	return ERR_PTR(err);
+}
+
+void zocl_free_sg_bo(struct drm_gem_object *gem_obj)
+{
+	struct drm_zocl_bo *bo = to_zocl_bo(gem_obj);
+
+	if (bo->vmapping)
+		vunmap(bo->vmapping);
+	if (bo->sgt) {
+		if (bo->sgt->nents)
+			dma_unmap_sg(gem_obj->dev->dev, bo->sgt->sgl,
+			    bo->sgt->orig_nents, DMA_BIDIRECTIONAL);
+		sg_free_table(bo->sgt);
+		kfree(bo->sgt);
+	}
+	if (bo->pages)
+		drm_gem_put_pages(gem_obj, bo->pages, true, false);
+
+	drm_gem_object_release(gem_obj);
+	kfree(bo);
+}
+
+void zocl_update_alloc_stat(struct drm_zocl_dev *zdev,
+		enum zocl_alloc_type type, ktime_t start, bool failed)
+{
+	u64 ns = ktime_to_ns(ktime_sub(ktime_get(), start));
+	struct zocl_alloc_stat *stat = &zdev->alloc_stat[type];
+
+	write_lock(&zdev->attr_rwlock);
+	if (failed) {
+		stat->failed++;
+	} else {
+		stat->count++;
+		stat->total_ns += ns;
+		if (ns > stat->max_ns)
+			stat->max_ns = ns;
+	}
+	write_unlock(&zdev->attr_rwlock);
+}
+
 /*
  * This function allocates memory from the range allocator.
  * Also try to allocate memory from the similer memory types.
@@ -369,8 +519,23 @@ zocl_create_bo(struct drm_device *dev, uint64_t unaligned_size, u32 user_flags)
 		err = drm_gem_object_init(dev, &bo->gem_base, size);
 		if (err < 0)
 			goto free;
+	} else if (user_flags & ZOCL_BO_FLAGS_SG) {
+		ktime_t start = ktime_get();
+
+		bo = zocl_create_sg_mem(dev, size);
+		zocl_update_alloc_stat(zdev, ZOCL_ALLOC_SG, start, IS_ERR(bo));
+		if (IS_ERR(bo)) {
+			/* Fall back to CMA */
+			start = ktime_get();
+			bo = zocl_create_cma_mem(dev, size);
+			zocl_update_alloc_stat(zdev, ZOCL_ALLOC_CMA, start,
+			    IS_ERR(bo));
+		}
 	} else if (user_flags & ZOCL_BO_FLAGS_CMA) {
+		ktime_t start = ktime_get();
+
 		bo = zocl_create_cma_mem(dev, size);
+		zocl_update_alloc_stat(zdev, ZOCL_ALLOC_CMA, start, IS_ERR(bo));
 	} else {
 		/* We are allocating from a separate mem Index, i.e. PL-DDR or LPDDR */
 		unsigned int mem_index = GET_MEM_INDEX(user_flags);
@@ -381,9 +546,15 @@ zocl_create_bo(struct drm_device *dev, uint64_t unaligned_size, u32 user_flags)
 		if (!mem->zm_used || mem->zm_type != ZOCL_MEM_TYPE_RANGE_ALLOC)
 			return ERR_PTR(-EINVAL);
 
+		ktime_t start = ktime_get();
+
 		bo = zocl_create_range_mem(dev, size, mem);
+		zocl_update_alloc_stat(zdev, ZOCL_ALLOC_RANGE, start, IS_ERR(bo));
 	}
 
+	if (IS_ERR(bo))
+		return bo;
+
 	if (user_flags & ZOCL_BO_FLAGS_EXECBUF) {
 		bo->flags = ZOCL_BO_FLAGS_EXECBUF;
 		bo->metadata.state = DRM_ZOCL_EXECBUF_STATE_ABORT;
@@ -406,6 +577,15 @@ struct sg_table *zocl_gem_prime_get_sg_table(struct drm_gem_object *obj)
 	if (zocl_obj && (zocl_obj->flags & ZOCL_BO_FLAGS_CMA)) {
 		return drm_gem_dma_get_sg_table(&zocl_obj->cma_base);
 	}
+	if (zocl_obj && (zocl_obj->flags & ZOCL_BO_FLAGS_SG)) {
+#if LINUX_VERSION_CODE <= KERNEL_VERSION(5, 9, 0)
+		return drm_prime_pages_to_sg(zocl_obj->pages,
+		    obj->size >> PAGE_SHIFT);
+#else
+		return drm_prime_pages_to_sg(obj->dev, zocl_obj->pages,
+		    obj->size >> PAGE_SHIFT);
+#endif
+	}
         struct drm_device *drm = obj->dev;
         struct sg_table *sgt;
         int ret;
@@ -509,7 +689,10 @@ zocl_create_bo_ioctl(struct drm_device *dev, void *data, struct drm_file *filp)
 	args->flags = zocl_convert_bo_uflags(args->flags);
 
 	if (zdev->domain) {
+		ktime_t start = ktime_get();
+
 		bo = zocl_create_svm_bo(dev, data, filp);
+		zocl_update_alloc_stat(zdev, ZOCL_ALLOC_SVM, start, IS_ERR(bo));
 		if (IS_ERR(bo))
 			return PTR_ERR(bo);
 		bo->user_flags = user_flags;
@@ -551,16 +734,33 @@ zocl_create_bo_ioctl(struct drm_device *dev, void *data, struct drm_file *filp)
 		args->flags &= ~ZOCL_BO_FLAGS_CACHEABLE;
 	}
 
+	/*
+	 * PL kernels only need contiguous device addresses, so take pages
+	 * mapped through the SMMU over CMA when possible. EXECBUF stays
+	 * in CMA, it is accessed by ERT.
+	 */
+	if ((args->flags & ZOCL_BO_FLAGS_CMA) &&
+	    !(args->flags & ZOCL_BO_FLAGS_EXECBUF) && zocl_sg_bo_supported(dev))
+		args->flags |= ZOCL_BO_FLAGS_SG;
+
 	bo = zocl_create_bo(dev, args->size, args->flags);
 	if (IS_ERR(bo)) {
 		DRM_DEBUG("object creation failed\n");
 		return PTR_ERR(bo);
 	}
 
+	/* Unless SG allocation fell back to CMA */
+	if (bo->flags & ZOCL_BO_FLAGS_SG)
+		args->flags &= ~ZOCL_BO_FLAGS_CMA;
+	args->flags &= ~ZOCL_BO_FLAGS_SG;
+
 	bo->mem_index = mem_index;
-	if (args->flags & ZOCL_BO_FLAGS_CACHEABLE)
+	if (args->flags & ZOCL_BO_FLAGS_CACHEABLE) {
 		bo->flags |= ZOCL_BO_FLAGS_CACHEABLE;
-	else
+		/* Keep the cached mapping, but sync becomes a no-op */
+		if (zocl_bo_coherent_port(dev))
+			bo->flags |= ZOCL_BO_FLAGS_COHERENT;
+	} else
 		bo->flags |= ZOCL_BO_FLAGS_COHERENT;
 
 	if (args->flags & ZOCL_BO_FLAGS_CMA) {
@@ -772,6 +972,19 @@ int zocl_sync_bo_ioctl(struct drm_device *dev,
 		goto out;
 	}
 
+	if (bo->flags & ZOCL_BO_FLAGS_SG) {
+		/* Pages are not physically contiguous, sync whole table */
+		if (args->dir == DRM_ZOCL_SYNC_BO_TO_DEVICE)
+			dma_sync_sg_for_device(dev->dev, bo->sgt->sgl,
+			    bo->sgt->orig_nents, DMA_TO_DEVICE);
+		else if (args->dir == DRM_ZOCL_SYNC_BO_FROM_DEVICE)
+			dma_sync_sg_for_cpu(dev->dev, bo->sgt->sgl,
+			    bo->sgt->orig_nents, DMA_FROM_DEVICE);
+		else
+			rc = -EINVAL;
+		goto out;
+	}
+
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 1, 0)
 	cma_obj = to_drm_gem_dma_obj(gem_obj);
 	bus_addr = cma_obj->dma_addr;
@@ -833,7 +1046,7 @@ zocl_can_dma_performed(struct drm_device *dev, struct drm_file *filp,
 	dst_bo = to_zocl_bo(dst_gem_obj);
 	src_bo = to_zocl_bo(src_gem_obj);
 	unsupported_flags = (ZOCL_BO_FLAGS_USERPTR | ZOCL_BO_FLAGS_HOST_BO |
-		ZOCL_BO_FLAGS_SVM);
+		ZOCL_BO_FLAGS_SVM | ZOCL_BO_FLAGS_SG);
 	if ((dst_bo->flags & unsupported_flags) ||
 	    (src_bo->flags & unsupported_flags)) {
 		DRM_ERROR("Failed: Not supported dst flags 0x%x and "
@@ -876,24 +1089,45 @@ out:
 	return rc;
 }
 
+/*
+ * Assign a DMA channel to the handle. On first use, request as many memcpy
+ * capable channels as the platform exposes, up to ZOCL_MAX_DMA_CHAN. Handles
+ * are then assigned to channels round robin, so concurrent copies run on
+ * different channels, while each channel queues several transactions.
+ */
 int zocl_dma_channel_instance(zocl_dma_handle_t *dma_handle,
 			      struct drm_zocl_dev *zdev)
 {
 	dma_cap_mask_t dma_mask;
+	struct dma_chan *chan;
+	int idx;
 
 	if (!dma_handle->dma_chan && ZOCL_PLATFORM_ARM64) {
-		/* If zdev_dma_chan is NULL, we haven't initialized it yet. */
-		if (!zdev->zdev_dma_chan) {
+		mutex_lock(&zdev->zdev_dma_lock);
+		/* If no channel is requested, we haven't initialized it yet. */
+		if (!zdev->zdev_num_dma_chan) {
 			dma_cap_zero(dma_mask);
 			dma_cap_set(DMA_MEMCPY, dma_mask);
-			zdev->zdev_dma_chan =
-			    dma_request_channel(dma_mask, 0, NULL);
-			if (!zdev->zdev_dma_chan) {
+			while (zdev->zdev_num_dma_chan < ZOCL_MAX_DMA_CHAN) {
+				chan = dma_request_channel(dma_mask, 0, NULL);
+				if (!chan)
+					break;
+				zdev->zdev_dma_chan[zdev->zdev_num_dma_chan++] =
+				    chan;
+			}
+			if (!zdev->zdev_num_dma_chan) {
+				mutex_unlock(&zdev->zdev_dma_lock);
 				DRM_WARN("no DMA Channel available.\n");
 				return -EBUSY;
 			}
+			DRM_INFO("Using %d DMA channel(s) for copy BO\n",
+			    zdev->zdev_num_dma_chan);
 		}
-		dma_handle->dma_chan = zdev->zdev_dma_chan;
+		mutex_unlock(&zdev->zdev_dma_lock);
+
+		idx = (unsigned int)atomic_inc_return(&zdev->zdev_dma_next) %
+		    zdev->zdev_num_dma_chan;
+		dma_handle->dma_chan = zdev->zdev_dma_chan[idx];
 	}
 
 	return dma_handle->dma_chan ? 0 : -EINVAL;
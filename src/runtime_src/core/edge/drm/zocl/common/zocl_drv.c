@@ -57,6 +57,14 @@ int enable_xgq_ert = 1;
 module_param(enable_xgq_ert, int, (S_IRUGO|S_IWUSR));
 MODULE_PARM_DESC(enable_xgq_ert, "0 = legacy ERT mode, 1 = XGQ ERT mode (default)");
 
+int zocl_sg_bo = 1;
+module_param(zocl_sg_bo, int, (S_IRUGO|S_IWUSR));
+MODULE_PARM_DESC(zocl_sg_bo, "0 = allocate BOs from CMA, 1 = use scatter gather BOs through SMMU when possible (default)");
+
+int zocl_coherent_bo = 1;
+module_param(zocl_coherent_bo, int, (S_IRUGO|S_IWUSR));
+MODULE_PARM_DESC(zocl_coherent_bo, "0 = always sync cacheable BOs, 1 = skip cache maintenance of cacheable BOs on a dma-coherent port (default)");
+
 extern struct platform_driver zocl_ctrl_ert_driver;
 
 static const struct vm_operations_struct reg_physical_vm_ops = {
@@ -584,6 +592,11 @@ void zocl_free_bo(struct drm_gem_object *obj)
 		zocl_describe(zocl_obj);
 		if (zocl_obj->flags & ZOCL_BO_FLAGS_USERPTR)
 			zocl_free_userptr_bo(obj);
+		else if (zocl_obj->flags & ZOCL_BO_FLAGS_SG) {
+			zocl_update_mem_stat(zdev, obj->size, -1,
+			    zocl_obj->mem_index);
+			zocl_free_sg_bo(obj);
+		}
 		else if (zocl_obj->flags & ZOCL_BO_FLAGS_HOST_BO)
 			zocl_free_host_bo(obj);
 		else if (zocl_obj->flags & ZOCL_BO_FLAGS_CMA) {
@@ -708,6 +721,16 @@ zocl_gem_mmap(struct file *filp, struct vm_area_struct *vma)
 		 */
 		vma->vm_page_prot = prot;
 
+	if (bo->flags & ZOCL_BO_FLAGS_SG) {
+		/* Pages are not contiguous, insert them on fault */
+#if LINUX_VERSION_CODE < KERNEL_VERSION(6, 3, 0)
+		vma->vm_flags |= VM_MIXEDMAP;
+#else
+		vm_flags_set(vma, VM_MIXEDMAP);
+#endif
+		return 0;
+	}
+
 	if (bo->flags & ZOCL_BO_FLAGS_CMA) {
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 1, 0)
 		dma_obj = to_drm_gem_dma_obj(gem_obj);
@@ -844,7 +867,7 @@ static vm_fault_t zocl_bo_fault(struct vm_fault *vmf)
 	pgoff_t offset;
 	int err;
 
-	if (!zdev->domain)
+	if (!zdev->domain && !(bo->flags & ZOCL_BO_FLAGS_SG))
 		return 0;
 
 	if (!bo->pages)
@@ -893,6 +916,9 @@ static int zocl_client_open(struct drm_device *dev, struct drm_file *filp)
  */
 static void zocl_client_release(struct drm_device *dev, struct drm_file *filp)
 {
+	struct drm_zocl_dev *zdev = dev->dev_private;
+
+	zocl_svm_release(zdev, filp);
 	return zocl_destroy_client(filp->driver_priv);
 }
 
@@ -1002,6 +1028,10 @@ static const struct drm_ioctl_desc zocl_ioctls[] = {
 			DRM_AUTH|DRM_UNLOCKED|DRM_RENDER_ALLOW),
 	DRM_IOCTL_DEF_DRV(ZOCL_SET_CU_READONLY_RANGE, zocl_set_cu_read_only_range_ioctl,
 			DRM_AUTH|DRM_UNLOCKED|DRM_RENDER_ALLOW),
+	DRM_IOCTL_DEF_DRV(ZOCL_SVM_PIN, zocl_svm_pin_ioctl,
+			DRM_AUTH|DRM_UNLOCKED|DRM_RENDER_ALLOW),
+	DRM_IOCTL_DEF_DRV(ZOCL_EVENTFD, zocl_eventfd_ioctl,
+			DRM_AUTH|DRM_UNLOCKED|DRM_RENDER_ALLOW),
 };
 
 static const struct file_operations zocl_driver_fops = {
@@ -1271,7 +1301,10 @@ static int zocl_drm_platform_probe(struct platform_device *pdev)
 		goto err_sysfs;
 
 	/* During attach, we don't request dma channel */
-	zdev->zdev_dma_chan = NULL;
+	mutex_init(&zdev->zdev_dma_lock);
+	zocl_svm_init(zdev);
+	zdev->zdev_num_dma_chan = 0;
+	atomic_set(&zdev->zdev_dma_next, 0);
 
 	/* doen with zdev initialization */
 	drm->dev_private = zdev;
@@ -1324,6 +1357,7 @@ static int zocl_drm_platform_remove(struct platform_device *pdev)
 {
 	struct drm_zocl_dev *zdev = platform_get_drvdata(pdev);
 	struct drm_device *drm = zdev->ddev;
+	int i;
 
 	/* Cleanup of iommu domain, if exists */
 	if (zdev->domain) {
@@ -1331,11 +1365,12 @@ static int zocl_drm_platform_remove(struct platform_device *pdev)
 		iommu_domain_free(zdev->domain);
 	}
 
-	/* If dma channel has been requested, make sure it is released */
-	if (zdev->zdev_dma_chan) {
-		dma_release_channel(zdev->zdev_dma_chan);
-		zdev->zdev_dma_chan = NULL;
+	/* If dma channels have been requested, make sure they are released */
+	for (i = 0; i < zdev->zdev_num_dma_chan; i++) {
+		dma_release_channel(zdev->zdev_dma_chan[i]);
+		zdev->zdev_dma_chan[i] = NULL;
 	}
+	zdev->zdev_num_dma_chan = 0;
 
 	if (zdev->fpga_mgr)
 		fpga_mgr_put(zdev->fpga_mgr);
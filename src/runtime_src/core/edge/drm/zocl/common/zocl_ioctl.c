@@ -14,6 +14,7 @@
  */
 
 #include <drm/drm_file.h>
+#include <linux/eventfd.h>
 #include "zocl_drv.h"
 #include "zocl_xclbin.h"
 #include "zocl_error.h"
@@ -150,3 +151,32 @@ zocl_set_cu_read_only_range_ioctl(struct drm_device *dev, void *data,
 	ret = zocl_kds_set_cu_read_range(zdev, info->cu_index, info->start, info->size);
 	return ret;
 }
+
+/*
+ * Register an eventfd signaled on each command completion of the client.
+ * The eventfd is only released with the client, after all its commands
+ * completed, so completion never races with its release.
+ */
+int
+zocl_eventfd_ioctl(struct drm_device *dev, void *data, struct drm_file *filp)
+{
+	struct kds_client *client = filp->driver_priv;
+	struct drm_zocl_eventfd *args = data;
+	struct eventfd_ctx *evfd;
+	int ret = 0;
+
+	evfd = eventfd_ctx_fdget(args->fd);
+	if (IS_ERR(evfd))
+		return PTR_ERR(evfd);
+
+	mutex_lock(&client->lock);
+	if (client->evfd)
+		ret = -EBUSY;
+	else
+		smp_store_release(&client->evfd, evfd);
+	mutex_unlock(&client->lock);
+
+	if (ret)
+		eventfd_ctx_put(evfd);
+	return ret;
+}
@@ -10,6 +10,7 @@
  * License version 2 or Apache License, Version 2.0.
  */
 
+#include <linux/eventfd.h>
 #include <linux/sched/signal.h>
 #include "zocl_drv.h"
 #include "zocl_util.h"
@@ -29,6 +30,7 @@ do {\
 } while(0)
 
 int kds_echo = 0;
+int kds_arg_shadow = 0;
 /*
  * Remove the client context and free all the memeory.
  * This function is also unlock the bitstrean for the slot associated with
@@ -331,6 +333,9 @@ void zocl_destroy_client(void *client_hdl)
 		vfree(curr);
 	}
 
+	if (client->evfd)
+		eventfd_ctx_put(client->evfd);
+
 	zocl_info(client->dev, "client exits pid(%d)\n", pid);
 	kfree(client);
 }
@@ -209,6 +209,35 @@ static ssize_t zocl_get_memstat(struct device *dev, char *buf, bool raw)
 	return size;
 }
 
+static ssize_t alloc_stat_show(struct device *dev,
+	struct device_attribute *attr, char *buf)
+{
+	static const char * const names[ZOCL_ALLOC_MAX] = {
+		"cma", "sg", "range", "svm"
+	};
+	struct drm_zocl_dev *zdev = dev_get_drvdata(dev);
+	struct zocl_alloc_stat *stat;
+	ssize_t size = 0;
+	int i;
+
+	if (!zdev)
+		return 0;
+
+	read_lock(&zdev->attr_rwlock);
+	for (i = 0; i < ZOCL_ALLOC_MAX; i++) {
+		stat = &zdev->alloc_stat[i];
+		size += sprintf(buf + size,
+		    "%s: %llu allocs, %llu failed, avg %lluus, max %lluus\n",
+		    names[i], stat->count, stat->failed,
+		    stat->count ? div64_u64(stat->total_ns, stat->count) / 1000 : 0,
+		    div64_u64(stat->max_ns, 1000));
+	}
+	read_unlock(&zdev->attr_rwlock);
+
+	return size;
+}
+static DEVICE_ATTR_RO(alloc_stat);
+
 static ssize_t graph_status_show(struct device *dev,
 				 struct device_attribute *attr, char *buf)
 {
@@ -408,6 +437,7 @@ static struct attribute *zocl_attrs[] = {
 	&dev_attr_kds_interval.attr,
 	&dev_attr_memstat.attr,
 	&dev_attr_memstat_raw.attr,
+	&dev_attr_alloc_stat.attr,
 	&dev_attr_errors.attr,
 	&dev_attr_graph_status.attr,
 	&dev_attr_dtbo_path.attr,
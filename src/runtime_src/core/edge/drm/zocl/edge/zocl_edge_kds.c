@@ -10,6 +10,7 @@
  * License version 2 or Apache License, Version 2.0.
  */
 
+#include <linux/eventfd.h>
 #include <linux/sched/signal.h>
 #include "zocl_drv.h"
 #include "zocl_util.h"
@@ -74,8 +75,10 @@ static int copybo_ecmd2xcmd(struct drm_zocl_dev *zdev, struct drm_file *filp,
 	memset(dma_handle, 0, sizeof(zocl_dma_handle_t));
 
 	ret = zocl_dma_channel_instance(dma_handle, zdev);
-	if (ret)
+	if (ret) {
+		kfree(dma_handle);
 		return ret;
+	}
 
 	/* We must set up callback for async dma operations. */
 	dma_handle->dma_func = zocl_kds_dma_complete;
@@ -83,6 +86,10 @@ static int copybo_ecmd2xcmd(struct drm_zocl_dev *zdev, struct drm_file *filp,
 	xcmd->priv = dma_handle;
 
 	ret = zocl_copy_bo_async(dev, filp, dma_handle, &args);
+	if (ret) {
+		xcmd->priv = NULL;
+		kfree(dma_handle);
+	}
 	return ret;
 }
 
@@ -385,6 +392,7 @@ static void notify_execbuf(struct kds_command *xcmd, enum kds_status status)
 {
 	struct kds_client *client = xcmd->client;
 	struct ert_packet *ecmd = (struct ert_packet *)xcmd->execbuf;
+	struct eventfd_ctx *evfd;
 
 	ecmd->state = kds_ert_table[status];
 
@@ -407,7 +415,16 @@ static void notify_execbuf(struct kds_command *xcmd, enum kds_status status)
 		client_stat_inc(client, xcmd->hw_ctx_id, c_cnt[xcmd->cu_idx]);
 
 	atomic_inc(&client->event);
-	wake_up_interruptible(&client->waitq);
+	if (!xcmd->defer_wake)
+		wake_up_interruptible(&client->waitq);
+
+	evfd = smp_load_acquire(&client->evfd);
+	if (evfd)
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 8, 0)
+		eventfd_signal(evfd);
+#else
+		eventfd_signal(evfd, 1);
+#endif
 }
 
 /* Every CU is associated with a slot. And a client can open only one
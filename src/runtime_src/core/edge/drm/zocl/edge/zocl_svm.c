@@ -0,0 +1,259 @@
+/* SPDX-License-Identifier: GPL-2.0 OR Apache-2.0 */
+/*
+ * A GEM style (optionally CMA backed) device manager for ZynQ based
+ * OpenCL accelerators.
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * This file is dual-licensed; you may select either the GNU General Public
+ * License version 2 or Apache License, Version 2.0.
+ */
+
+#include <linux/iommu.h>
+#include <linux/mm.h>
+#include <linux/slab.h>
+#include <drm/drm_prime.h>
+
+#include "zocl_drv.h"
+#include "zocl_svm.h"
+
+/*
+ * A pinned user range [it.start, it.last], mapped into the IOMMU domain
+ * of the device at the same virtual address.
+ */
+struct zocl_svm_range {
+	struct interval_tree_node	it;
+	struct drm_file			*filp;
+	struct page			**pages;
+	unsigned long			npages;
+	struct sg_table			*sgt;
+};
+
+static void zocl_svm_unpin_pages(struct page **pages, unsigned long npages)
+{
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
+	unpin_user_pages_dirty_lock(pages, npages, true);
+#else
+	unsigned long i;
+
+	for (i = 0; i < npages; i++) {
+		set_page_dirty_lock(pages[i]);
+		put_page(pages[i]);
+	}
+#endif
+}
+
+static void zocl_svm_free_range(struct drm_zocl_dev *zdev,
+		struct zocl_svm_range *range)
+{
+	size_t size = range->npages << PAGE_SHIFT;
+
+	iommu_unmap(zdev->domain, range->it.start, size);
+	sg_free_table(range->sgt);
+	kfree(range->sgt);
+	zocl_svm_unpin_pages(range->pages, range->npages);
+	kvfree(range->pages);
+	kfree(range);
+}
+
+/*
+ * Pin npages starting at page aligned user address start and map them
+ * into the IOMMU at the same address. Called with svm lock held.
+ */
+static int zocl_svm_map_range(struct drm_device *dev, struct drm_file *filp,
+		unsigned long start, unsigned long npages)
+{
+	struct drm_zocl_dev *zdev = dev->dev_private;
+	struct zocl_svm *svm = &zdev->zdev_svm;
+	int prot = IOMMU_READ | IOMMU_WRITE;
+	struct zocl_svm_range *range;
+	ssize_t err;
+	long pinned;
+
+	range = kzalloc(sizeof(*range), GFP_KERNEL);
+	if (!range)
+		return -ENOMEM;
+
+	range->pages = kvmalloc_array(npages, sizeof(*range->pages),
+	    GFP_KERNEL);
+	if (!range->pages) {
+		kfree(range);
+		return -ENOMEM;
+	}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
+	pinned = pin_user_pages_fast(start, npages, FOLL_WRITE | FOLL_LONGTERM,
+	    range->pages);
+#else
+	pinned = get_user_pages_fast(start, npages, 1, range->pages);
+#endif
+	if (pinned < 0 || pinned != npages) {
+		DRM_ERROR("Unable to pin user pages @0x%lx\n", start);
+		if (pinned > 0)
+			zocl_svm_unpin_pages(range->pages, pinned);
+		err = pinned < 0 ? pinned : -EFAULT;
+		goto out_free;
+	}
+	range->npages = npages;
+
+#if LINUX_VERSION_CODE <= KERNEL_VERSION(5, 9, 0)
+	range->sgt = drm_prime_pages_to_sg(range->pages, npages);
+#else
+	range->sgt = drm_prime_pages_to_sg(dev, range->pages, npages);
+#endif
+	if (IS_ERR(range->sgt)) {
+		err = PTR_ERR(range->sgt);
+		goto out_unpin;
+	}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 3, 0)
+	err = iommu_map_sg(zdev->domain, start, range->sgt->sgl,
+	    range->sgt->nents, prot, GFP_KERNEL);
+#else
+	err = iommu_map_sg(zdev->domain, start, range->sgt->sgl,
+	    range->sgt->nents, prot);
+#endif
+	if (err < 0) {
+		DRM_ERROR("Failed to map user range through IOMMU: %zd\n", err);
+		goto out_sgt;
+	}
+
+	range->filp = filp;
+	range->it.start = start;
+	range->it.last = start + (npages << PAGE_SHIFT) - 1;
+	interval_tree_insert(&range->it, &svm->ranges);
+	return 0;
+
+out_sgt:
+	sg_free_table(range->sgt);
+	kfree(range->sgt);
+out_unpin:
+	zocl_svm_unpin_pages(range->pages, npages);
+out_free:
+	kvfree(range->pages);
+	kfree(range);
+	return err;
+}
+
+/*
+ * Make sure [start, last] is pinned and mapped. Parts already in the cache
+ * are reused, only gaps between cached ranges are pinned.
+ */
+static int zocl_svm_pin(struct drm_device *dev, struct drm_file *filp,
+		unsigned long start, unsigned long last)
+{
+	struct drm_zocl_dev *zdev = dev->dev_private;
+	struct zocl_svm *svm = &zdev->zdev_svm;
+	struct interval_tree_node *node;
+	unsigned long cur = start;
+	bool miss = false;
+	int ret = 0;
+
+	mutex_lock(&svm->lock);
+	for (node = interval_tree_iter_first(&svm->ranges, start, last); node;
+	     node = interval_tree_iter_next(node, start, last)) {
+		struct zocl_svm_range *range =
+		    container_of(node, struct zocl_svm_range, it);
+
+		/* IOMMU domain is shared, VA can be mapped by one owner only */
+		if (range->filp != filp) {
+			ret = -EBUSY;
+			goto out;
+		}
+
+		if (node->start > cur) {
+			ret = zocl_svm_map_range(dev, filp, cur,
+			    (node->start - cur) >> PAGE_SHIFT);
+			if (ret)
+				goto out;
+			miss = true;
+		}
+		cur = node->last + 1;
+		if (cur > last)
+			break;
+	}
+
+	if (cur <= last) {
+		ret = zocl_svm_map_range(dev, filp, cur,
+		    (last + 1 - cur) >> PAGE_SHIFT);
+		if (ret)
+			goto out;
+		miss = true;
+	}
+
+	if (miss)
+		svm->misses++;
+	else
+		svm->hits++;
+out:
+	mutex_unlock(&svm->lock);
+	return ret;
+}
+
+/*
+ * Unpin all ranges of filp that overlap [start, last]. Overlapping
+ * ranges are removed entirely.
+ */
+static void zocl_svm_unpin(struct drm_zocl_dev *zdev, struct drm_file *filp,
+		unsigned long start, unsigned long last)
+{
+	struct zocl_svm *svm = &zdev->zdev_svm;
+	struct interval_tree_node *node, *next;
+
+	mutex_lock(&svm->lock);
+	node = interval_tree_iter_first(&svm->ranges, start, last);
+	while (node) {
+		struct zocl_svm_range *range =
+		    container_of(node, struct zocl_svm_range, it);
+
+		next = interval_tree_iter_next(node, start, last);
+		if (range->filp == filp) {
+			interval_tree_remove(node, &svm->ranges);
+			zocl_svm_free_range(zdev, range);
+		}
+		node = next;
+	}
+	mutex_unlock(&svm->lock);
+}
+
+void zocl_svm_init(struct drm_zocl_dev *zdev)
+{
+	mutex_init(&zdev->zdev_svm.lock);
+	zdev->zdev_svm.ranges = RB_ROOT_CACHED;
+	zdev->zdev_svm.hits = 0;
+	zdev->zdev_svm.misses = 0;
+}
+
+void zocl_svm_release(struct drm_zocl_dev *zdev, struct drm_file *filp)
+{
+	if (!zdev->domain)
+		return;
+
+	zocl_svm_unpin(zdev, filp, 0, ULONG_MAX);
+}
+
+int zocl_svm_pin_ioctl(struct drm_device *dev, void *data,
+		struct drm_file *filp)
+{
+	struct drm_zocl_dev *zdev = dev->dev_private;
+	struct drm_zocl_svm_pin *args = data;
+	unsigned long start, last;
+
+	if (!zdev->domain) {
+		DRM_ERROR("SVM requires the PL to be behind an IOMMU\n");
+		return -EOPNOTSUPP;
+	}
+
+	if (!args->size || args->addr + args->size < args->addr)
+		return -EINVAL;
+
+	start = args->addr & PAGE_MASK;
+	last = PAGE_ALIGN(args->addr + args->size) - 1;
+
+	if (args->flags & DRM_ZOCL_SVM_UNPIN) {
+		zocl_svm_unpin(zdev, filp, start, last);
+		return 0;
+	}
+
+	return zocl_svm_pin(dev, filp, start, last);
+}
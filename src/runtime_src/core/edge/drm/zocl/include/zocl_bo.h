@@ -30,6 +30,8 @@
  * will be removed when we implement BO BO BO project at edge
  * side.
  */
+/* Driver internal, scatter gather BO mapped contiguously through SMMU */
+#define ZOCL_BO_FLAGS_SG		(1 << 23)
 #define ZOCL_BO_FLAGS_CACHEABLE		(1 << 24)
 #define ZOCL_BO_FLAGS_HOST_BO		(1 << 25)
 #define ZOCL_BO_FLAGS_COHERENT		(1 << 26)
@@ -252,6 +252,9 @@ void zocl_free_host_bo(struct drm_gem_object *obj);
 int zocl_iommu_map_bo(struct drm_device *dev, struct drm_zocl_bo *bo);
 int zocl_iommu_unmap_bo(struct drm_device *dev, struct drm_zocl_bo *bo);
 
+extern int zocl_sg_bo;
+extern int zocl_coherent_bo;
+
 int zocl_init_sysfs(struct device *dev);
 void zocl_fini_sysfs(struct device *dev);
 void zocl_free_sections(struct drm_zocl_dev *dev, struct drm_zocl_slot *slot);
@@ -261,6 +264,9 @@ struct drm_zocl_bo *zocl_drm_create_bo(struct drm_device *dev,
 		uint64_t unaligned_size, unsigned user_flags);
 void zocl_update_mem_stat(struct drm_zocl_dev *zdev, u64 size,
 		int count, uint32_t bank);
+void zocl_update_alloc_stat(struct drm_zocl_dev *zdev,
+		enum zocl_alloc_type type, ktime_t start, bool failed);
+void zocl_free_sg_bo(struct drm_gem_object *obj);
 void zocl_init_mem(struct drm_zocl_dev *zdev, struct drm_zocl_slot *slot);
 void zocl_clear_mem(struct drm_zocl_dev *zdev);
 void zocl_clear_mem_slot(struct drm_zocl_dev *zdev, u32 slot_idx);
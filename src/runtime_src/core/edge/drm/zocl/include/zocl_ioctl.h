@@ -61,4 +61,6 @@ int zocl_aie_freqscale_ioctl(struct drm_device *dev, void *data,
 		struct drm_file *filp);
 int zocl_set_cu_read_only_range_ioctl(struct drm_device *dev, void *data,
 		struct drm_file *filp);
+int zocl_eventfd_ioctl(struct drm_device *dev, void *data,
+		struct drm_file *filp);
 #endif
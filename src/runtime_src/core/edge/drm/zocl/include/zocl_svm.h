@@ -0,0 +1,55 @@
+/* SPDX-License-Identifier: GPL-2.0 OR Apache-2.0 */
+/*
+ * A GEM style (optionally CMA backed) device manager for ZynQ based
+ * OpenCL accelerators.
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * This file is dual-licensed; you may select either the GNU General Public
+ * License version 2 or Apache License, Version 2.0.
+ */
+
+#ifndef _ZOCL_SVM_H_
+#define _ZOCL_SVM_H_
+
+#include <linux/interval_tree.h>
+#include <linux/mutex.h>
+
+/**
+ * DOC: Shared virtual memory for PL kernels
+ *
+ * When the PL sits behind an SMMU shared with the APU, a user range can be
+ * pinned and mapped into the device IOMMU domain at its own virtual address.
+ * Kernels then dereference user pointers directly, without a BO.
+ *
+ * Pinned ranges are kept in an interval tree, which serves as translation
+ * cache: pinning an already mapped range is a lookup only, and only the parts
+ * not yet mapped are pinned. Ranges stay mapped until unpinned or until the
+ * owning file is closed.
+ */
+
+/**
+ * struct zocl_svm - Per device SVM state
+ *
+ * @lock: protects @ranges
+ * @ranges: interval tree of pinned user ranges
+ * @hits: pin requests fully served from the cache
+ * @misses: pin requests that pinned at least one new range
+ */
+struct zocl_svm {
+	struct mutex		lock;
+	struct rb_root_cached	ranges;
+	u64			hits;
+	u64			misses;
+};
+
+struct drm_device;
+struct drm_file;
+struct drm_zocl_dev;
+
+void zocl_svm_init(struct drm_zocl_dev *zdev);
+void zocl_svm_release(struct drm_zocl_dev *zdev, struct drm_file *filp);
+int zocl_svm_pin_ioctl(struct drm_device *dev, void *data,
+		struct drm_file *filp);
+
+#endif /* _ZOCL_SVM_H_ */
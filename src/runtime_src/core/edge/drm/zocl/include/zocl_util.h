@@ -16,6 +16,7 @@
 #include "zocl_lib.h"
 #include "kds_core.h"
 #include "zocl_error.h"
+#include "zocl_svm.h"
 #include "zynq_ioctl.h"
 
 #define _4KB	0x1000
@@ -23,6 +24,7 @@
 #define _64KB	0x10000
 
 #define MAX_PR_SLOT_NUM	32
+#define ZOCL_MAX_DMA_CHAN	4
 #define MAX_CU_NUM     128
 /* Apertures contains both ip and debug ip information */
 #define MAX_APT_NUM		2*MAX_CU_NUM
@@ -155,6 +157,22 @@ struct zocl_cu_subdev {
 	struct mutex		 lock;
 };
 
+/* BO allocation paths with latency statistics */
+enum zocl_alloc_type {
+	ZOCL_ALLOC_CMA = 0,
+	ZOCL_ALLOC_SG,
+	ZOCL_ALLOC_RANGE,
+	ZOCL_ALLOC_SVM,
+	ZOCL_ALLOC_MAX,
+};
+
+struct zocl_alloc_stat {
+	u64			 count;
+	u64			 failed;
+	u64			 total_ns;
+	u64			 max_ns;
+};
+
 struct drm_zocl_dev {
 	struct drm_device       *ddev;
 	struct fpga_manager     *fpga_mgr;
@@ -186,13 +204,19 @@ struct drm_zocl_dev {
 	 * touch those attributes should hold write lock.
 	 */
 	rwlock_t		attr_rwlock;
+	struct zocl_alloc_stat	 alloc_stat[ZOCL_ALLOC_MAX];
 
 	struct soft_krnl	*soft_kernel;
 	struct aie_info		*aie_information;
-	struct dma_chan		*zdev_dma_chan;
+	/* DMA channels used for copy BO, assigned round robin */
+	struct mutex		 zdev_dma_lock;
+	struct dma_chan		*zdev_dma_chan[ZOCL_MAX_DMA_CHAN];
+	int			 zdev_num_dma_chan;
+	atomic_t		 zdev_dma_next;
 	struct mailbox		*zdev_mailbox;
 	const struct zdev_data	*zdev_data_info;
 	struct zocl_error	 zdev_error;
+	struct zocl_svm		 zdev_svm;
 	struct zocl_aie		*aie;
 
 	int			 num_pr_slot;
@@ -124,6 +124,10 @@ enum drm_zocl_ops {
 	DRM_ZOCL_AIE_FREQSCALE,
 	/* Set CU read-only range */
 	DRM_ZOCL_SET_CU_READONLY_RANGE,
+	/* Pin and map user range for shared virtual memory */
+	DRM_ZOCL_SVM_PIN,
+	/* Register completion eventfd */
+	DRM_ZOCL_EVENTFD,
 	DRM_ZOCL_NUM_IOCTLS
 };
 
@@ -243,6 +247,43 @@ struct drm_zocl_set_cu_range {
 	uint32_t    size;
 };
 
+#define DRM_ZOCL_SVM_UNPIN	(0x1 << 0)
+
+/**
+ * struct drm_zocl_svm_pin - Pin user range for shared virtual memory
+ * used with DRM_IOCTL_ZOCL_SVM_PIN
+ *
+ * The range is pinned and mapped into the device IOMMU at its user virtual
+ * address, so that kernels can access it by pointer.
+ *
+ * @addr:     Start of the user range
+ * @size:     Size of the range in bytes
+ * @flags:    DRM_ZOCL_SVM_UNPIN to release the range
+ */
+struct drm_zocl_svm_pin {
+	uint64_t    addr;
+	uint64_t    size;
+	uint32_t    flags;
+};
+
+/**
+ * struct drm_zocl_eventfd - Register eventfd signaled on command completion
+ * used with DRM_IOCTL_ZOCL_EVENTFD
+ *
+ * The eventfd is signaled each time a command of the client completes,
+ * in addition to the wakeup of poll() on the device file.  Unlike the
+ * device file it can be added to any number of epoll sets without the
+ * waiters consuming each other's events.  One eventfd can be registered
+ * per client; it is released when the device file is closed.
+ *
+ * @fd:       File descriptor of an eventfd
+ * @pad:      Padding
+ */
+struct drm_zocl_eventfd {
+	int32_t     fd;
+	uint32_t    pad;
+};
+
 /**
  * struct drm_zocl_pwrite_bo - Update bo with user's data
  * used with DRM_IOCTL_ZOCL_PWRITE_BO ioctl
@@ -596,4 +637,8 @@ struct drm_zocl_error_inject {
 				       DRM_ZOCL_AIE_FREQSCALE, struct drm_zocl_aie_freq_scale)
 #define DRM_IOCTL_ZOCL_SET_CU_READONLY_RANGE   DRM_IOWR(DRM_COMMAND_BASE + \
 					       DRM_ZOCL_SET_CU_READONLY_RANGE, struct drm_zocl_set_cu_range)
+#define DRM_IOCTL_ZOCL_SVM_PIN   DRM_IOWR(DRM_COMMAND_BASE + \
+				 DRM_ZOCL_SVM_PIN, struct drm_zocl_svm_pin)
+#define DRM_IOCTL_ZOCL_EVENTFD   DRM_IOWR(DRM_COMMAND_BASE + \
+				 DRM_ZOCL_EVENTFD, struct drm_zocl_eventfd)
 #endif
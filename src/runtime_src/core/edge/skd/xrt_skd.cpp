@@ -17,6 +17,8 @@
 
 #include "xrt_skd.h"
 
+#include "core/common/config_reader.h"
+
 using ms_t = std::chrono::microseconds;
 using clockc = std::chrono::high_resolution_clock;
 
@@ -178,6 +180,7 @@ namespace xrt {
     for(const auto &i : m_kernel_args) {
       m_ffi_args.emplace_back(convert_to_ffitype(i));
     }
+    m_last_bo.assign(m_kernel_args.size(), m_bo_cache.end());
 
     // Expect PS kernels to return POSIX return code 
     if(ffi_prep_cif(&m_cif,FFI_DEFAULT_ABI, m_kernel_args.size(), &ffi_type_uint32, m_ffi_args.data()) != FFI_OK) {
@@ -191,17 +194,109 @@ namespace xrt {
     return 0;
   }
 
+  // Returns the location of the mapped address of a host buffer,
+  // the location remains valid until the buffer is trimmed from the
+  // cache.
+  void**
+  skd::get_buffer_arg(size_t argidx, uint64_t paddr, uint64_t size)
+  {
+    bo_key key{paddr, size};
+    auto& last = m_last_bo[argidx];
+    if (last != m_bo_cache.end() && last->first == key)
+      return &last->second.vaddr;
+
+    auto itr = m_bo_cache.find(key);
+    if (itr != m_bo_cache.end()) {
+      last = itr;
+      return &itr->second.vaddr;
+    }
+
+    // Overlapped mappings may still be referenced by other arguments
+    // of this command, they are released by trim_buffer_cache()
+    for (const auto& it : m_bo_cache) {
+      if (it.first.first < paddr + size && paddr < it.first.first + it.first.second)
+        m_bo_cache_stale.push_back(it.first);
+    }
+
+    ps_arg p;
+    p.paddr = paddr;
+    p.psize = size;
+#ifdef SKD_MAP_BIG_BO
+    p.bo_offset = paddr - m_mem_start_paddr;
+    p.vaddr = static_cast<char*>(m_mem_start_vaddr) + p.bo_offset;
+#else
+    p.bo_offset = 0;
+    unsigned int handle = xclGetHostBO(m_devhdl, paddr, size);
+    p.bo_handle = xrt::shim_int::get_buffer_handle(m_devhdl, handle);
+    p.vaddr = p.bo_handle->map(xrt_core::buffer_handle::map_type::write);
+#endif
+    itr = m_bo_cache.emplace(key, std::move(p)).first;
+    m_bo_cache_order.push_back(key);
+    last = itr;
+    return &itr->second.vaddr;
+  }
+
+  void
+  skd::erase_buffer(const bo_key& key)
+  {
+    auto itr = m_bo_cache.find(key);
+    if (itr == m_bo_cache.end())
+      return;
+
+    if (itr->second.bo_handle)
+      itr->second.bo_handle->unmap(itr->second.vaddr);
+    m_bo_cache.erase(itr);
+    m_bo_cache_order.erase(std::find(m_bo_cache_order.begin(), m_bo_cache_order.end(), key));
+  }
+
+  // Release invalidated mappings and the oldest mappings beyond the
+  // cache limit, only called between commands when no argument
+  // refers to the cache
+  void
+  skd::trim_buffer_cache()
+  {
+    if (m_bo_cache_stale.empty() && m_bo_cache_order.size() <= bo_cache_max)
+      return;
+
+    for (const auto& key : m_bo_cache_stale)
+      erase_buffer(key);
+    m_bo_cache_stale.clear();
+
+    while (m_bo_cache_order.size() > bo_cache_max)
+      erase_buffer(m_bo_cache_order.front());
+
+    std::fill(m_last_bo.begin(), m_last_bo.end(), m_bo_cache.end());
+  }
+
+  void
+  skd::clear_buffer_cache()
+  {
+    for (auto& it : m_bo_cache) {
+      if (it.second.bo_handle)
+        it.second.bo_handle->unmap(it.second.vaddr);
+    }
+    m_bo_cache.clear();
+    m_bo_cache_order.clear();
+    m_bo_cache_stale.clear();
+    std::fill(m_last_bo.begin(), m_last_bo.end(), m_bo_cache.end());
+  }
+
   XCL_DRIVER_DLLESPEC
   void
   skd::run() {
     ffi_arg kernel_return = 0;
     std::vector<void*> ffi_arg_values(m_kernel_args.size());
-    std::vector<ps_arg> bo_args;
     clockc::time_point start;
     clockc::time_point end;
     clockc::time_point cmd_start;
     clockc::time_point cmd_end;
 
+    // Per command timing messages are formatted only when they are
+    // going to be logged, formatting is a noticeable part of the
+    // dispatch latency of short PS kernels
+    static const bool log_timing =
+      xrt_core::config::get_verbosity() >= static_cast<unsigned int>(severity_level::info);
+
     while (true) {
       int ret = wait_next_cmd();
       if (ret && (signal==SIGTERM)) {
@@ -211,8 +306,9 @@ namespace xrt {
 	break;
       }
 
-      cmd_start = clockc::now();
-      if(cmd_end < cmd_start) {
+      if (log_timing)
+	cmd_start = clockc::now();
+      if(log_timing && cmd_end < cmd_start) {
 	  const auto msg = boost::format("PS Kernel Command interval = %s") % std::to_string((std::chrono::duration_cast<ms_t>(cmd_start - cmd_end)).count());
 	  xrt_core::message::send(severity_level::info, "SKD", msg.str());
       }
@@ -239,43 +335,29 @@ namespace xrt {
 	  auto buf_size_ptr = reinterpret_cast<uint64_t *>(&m_args_from_host[arg_offset + 2]);
 	  auto buf_size = reinterpret_cast<uint64_t>(*buf_size_ptr);
 
-	  ps_arg p;
-	  p.paddr = buf_addr;
-	  p.psize = buf_size;
-#ifdef SKD_MAP_BIG_BO
-	  p.bo_offset = buf_addr - mem_start_paddr;
-	  p.vaddr = mem_start_vaddr + p.bo_offset;
-#else
-	  p.bo_offset = 0;
-    unsigned int handle = xclGetHostBO(m_devhdl, buf_addr, buf_size);
-	  p.bo_handle = xrt::shim_int::get_buffer_handle(m_devhdl, handle);
-	  p.vaddr = p.bo_handle->map(xrt_core::buffer_handle::map_type::write);
-	  bo_args.emplace_back(std::move(p));
-#endif
-	  ffi_arg_values[i] = &bo_args.back().vaddr;
+	  ffi_arg_values[i] = get_buffer_arg(i, buf_addr, buf_size);
 	} else {
 	  ffi_arg_values[i] = &m_args_from_host[arg_offset];
 	}
       }
 
-      start = clockc::now();
+      if (log_timing)
+	start = clockc::now();
       ffi_call(&m_cif,FFI_FN(m_kernel), &kernel_return, ffi_arg_values.data());
-      end = clockc::now();
+      if (log_timing)
+	end = clockc::now();
       m_args_from_host[m_return_offset] = static_cast<uint32_t>(kernel_return);  // FFI return type is define as ffi_type_uint32
 
+      // Buffers stay mapped for the next command, only release
+      // mappings beyond the cache limit
+      trim_buffer_cache();
+
+      if (!log_timing)
+	continue;
+
       const auto msg = boost::format("PS Kernel duration = %s") % std::to_string((std::chrono::duration_cast<ms_t>(end - start)).count());
       xrt_core::message::send(severity_level::info, "SKD", msg.str());
 
-#ifdef SKD_MAP_BIG_BO
-#else
-      // Unmap Buffers
-      for (auto& it : bo_args) {
-        it.bo_handle->unmap(it.vaddr);
-        it.bo_handle = nullptr;
-      }
-      bo_args.clear();
-#endif
-
       cmd_end = clockc::now();
       const auto msg2 = boost::format("PS Kernel Command duration = %s, Preproc = %s, Postproc = %s")
 	% std::to_string((std::chrono::duration_cast<ms_t>(cmd_end - cmd_start)).count())
@@ -293,6 +375,7 @@ namespace xrt {
     if((m_args_from_host[0] & 0x1) == 1) {
       report_crash();  // Function to report crash to kernel - not implemented yet in kernel space
     }
+    clear_buffer_cache();
 #ifdef SKD_MAP_BIG_BO
     // Unmap mem BO
     m_parent_bo_handle->unmap(m_mem_start_vaddr);
@@ -18,6 +18,7 @@
 #ifndef _XRT_SKD_H_
 #define _XRT_SKD_H_
 
+#include <algorithm>
 #include <boost/format.hpp>
 #include <chrono>
 #include <cstdarg>
@@ -26,8 +27,10 @@
 #include <execinfo.h>
 #include <filesystem>
 #include <fstream>
+#include <deque>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <stdio.h>
 #include <string.h>
@@ -155,7 +158,29 @@ class skd
     ffi_cif m_cif = {};
     bool m_pass_xrtHandles = false;
     int m_return_offset = 1;
-    
+
+    // Mapped host buffers by physical address and size.  Commands
+    // typically pass the same buffers over and over, so buffers are
+    // kept mapped across commands rather than imported and mapped per
+    // command.  The oldest mapping is released when the cache is full.
+    // A mapping is invalidated when a buffer overlapping it is passed,
+    // which means the cached buffer was freed and its memory reused.
+    static constexpr size_t bo_cache_max = 32;
+    using bo_key = std::pair<size_t, size_t>;
+    using bo_cache_type = std::map<bo_key, ps_arg>;
+    bo_cache_type m_bo_cache;
+    std::deque<bo_key> m_bo_cache_order;
+    std::vector<bo_key> m_bo_cache_stale;
+
+    // Buffer passed to each argument by the previous command, so an
+    // unchanged argument is a compare rather than a cache lookup
+    std::vector<bo_cache_type::iterator> m_last_bo;
+
+    void** get_buffer_arg(size_t argidx, uint64_t paddr, uint64_t size);
+    void erase_buffer(const bo_key& key);
+    void trim_buffer_cache();
+    void clear_buffer_cache();
+
     int wait_next_cmd() const;
     int create_softkernelfile(xrtDeviceHandle handle, buf_hdl& bohdl) const;
     int delete_softkernelfile() const;
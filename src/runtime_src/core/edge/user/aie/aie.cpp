@@ -194,6 +194,35 @@ wait_gmio(const std::string& gmioName)
   gmio_itr->second->wait();
 }
 
+void
+Aie::
+wait_gmio(const std::string& gmioName, uint64_t bd_token)
+{
+  if (!devInst)
+    throw xrt_core::error(-EINVAL, "Can't wait GMIO: AIE is not initialized");
+
+  if (access_mode == xrt::aie::access_mode::shared)
+    throw xrt_core::error(-EPERM, "Shared AIE context can't wait gmio");
+
+  auto gmio_itr = gmio_apis.find(gmioName);
+  if (gmio_itr == gmio_apis.end())
+    throw xrt_core::error(-EINVAL, "Can't wait GMIO: GMIO name not found");
+
+  if (gmio_itr->second->wait(bd_token) != adf::err_code::ok)
+    throw xrt_core::error(-EIO, "Can't wait GMIO: wait for BD failed");
+}
+
+uint64_t
+Aie::
+get_gmio_bd_token(const std::string& gmioName) const
+{
+  auto gmio_itr = gmio_apis.find(gmioName);
+  if (gmio_itr == gmio_apis.end())
+    throw xrt_core::error(-EINVAL, "Can't get GMIO BD: GMIO name not found");
+
+  return gmio_itr->second->getLastBDToken();
+}
+
 void
 Aie::
 submit_sync_bo(xrt::bo& bo, std::shared_ptr<adf::gmio_api>& gmio_api, adf::gmio_config& gmio_config, enum xclBOSyncDirection dir, size_t size, size_t offset)
@@ -107,6 +107,15 @@ public:
     void
     wait_gmio(const std::string& gmioName);
 
+    // Wait for the BD identified by bd_token to complete, BDs
+    // enqueued after it remain queued
+    void
+    wait_gmio(const std::string& gmioName, uint64_t bd_token);
+
+    // Token of the BD most recently enqueued by sync_bo_nb
+    uint64_t
+    get_gmio_bd_token(const std::string& gmioName) const;
+
     void
     reset(const xrt_core::device* device);
 
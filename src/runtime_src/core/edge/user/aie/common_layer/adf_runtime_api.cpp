@@ -635,18 +635,7 @@ err_code gmio_api::enqueueBD(uint64_t address, size_t size)
 
     //wait for available BD
     while (availableBDs.empty())
-    {
-        u8 numPendingBDs = 0;
-        driverStatus |= XAie_DmaGetPendingBdCount(config_manager::s_pDevInst, gmioTileLoc, convertLogicalToPhysicalDMAChNum(pGMIOConfig->channelNum), (pGMIOConfig->type == gmio_config::gm2aie ? DMA_MM2S : DMA_S2MM), &numPendingBDs);
-
-        int numBDCompleted = dmaStartQMaxSize - numPendingBDs;
-        //move completed BDs from enqueuedBDs to availableBDs
-        for (int i = 0; i < numBDCompleted; i++)
-        {
-            size_t bdNumber = frontAndPop(enqueuedBDs);
-            availableBDs.push(bdNumber);
-        }
-    }
+        driverStatus |= reclaimCompletedBDs();
 
     //get an available BD
     size_t bdNumber = frontAndPop(availableBDs);
@@ -671,6 +660,7 @@ err_code gmio_api::enqueueBD(uint64_t address, size_t size)
     //enqueue BD
     driverStatus |= XAie_DmaChannelPushBdToQueue(config_manager::s_pDevInst, gmioTileLoc, convertLogicalToPhysicalDMAChNum(pGMIOConfig->channelNum), (pGMIOConfig->type == gmio_config::gm2aie ? DMA_MM2S : DMA_S2MM), bdNumber);
     enqueuedBDs.push(bdNumber);
+    ++numSubmittedBDs;
 
 #ifndef __AIESIM__
     debugMsg(static_cast<std::stringstream &&>(std::stringstream() << "gmio_api::enqueueBD: (id "
@@ -706,10 +696,51 @@ err_code gmio_api::wait()
         size_t bdNumber = frontAndPop(enqueuedBDs);
         availableBDs.push(bdNumber);
     }
+    numCompletedBDs = numSubmittedBDs;
+
+    return err_code::ok;
+}
+
+err_code gmio_api::wait(uint64_t bdToken)
+{
+    if (!isConfigured)
+        return errorMsg(err_code::internal_error, "ERROR: adf::gmio_api::wait: GMIO is not configured.");
+
+    if (pGMIOConfig->type == gmio_config::gm2pl || pGMIOConfig->type == gmio_config::pl2gm)
+        return errorMsg(err_code::user_error, "ERROR: GMIO::wait can only be used by GMIO objects connecting to AIE, not PL.");
+
+    if (bdToken > numSubmittedBDs)
+        return errorMsg(err_code::user_error, "ERROR: adf::gmio_api::wait: BD token was not enqueued.");
+
+    // BDs complete in order, so the BD is done once the number of
+    // completed BDs reaches its token.  BDs enqueued after the one
+    // waited for remain in the DMA queue.
+    int driverStatus = XAIE_OK; //0
+    while (numCompletedBDs < bdToken && driverStatus == XAIE_OK)
+        driverStatus |= reclaimCompletedBDs();
+
+    if (driverStatus != AieRC::XAIE_OK)
+        return errorMsg(err_code::aie_driver_error, "ERROR: adf::gmio_api::wait: AIE driver error.");
 
     return err_code::ok;
 }
 
+int gmio_api::reclaimCompletedBDs()
+{
+    u8 numPendingBDs = 0;
+    int driverStatus = XAie_DmaGetPendingBdCount(config_manager::s_pDevInst, gmioTileLoc, convertLogicalToPhysicalDMAChNum(pGMIOConfig->channelNum), (pGMIOConfig->type == gmio_config::gm2aie ? DMA_MM2S : DMA_S2MM), &numPendingBDs);
+
+    //move completed BDs from enqueuedBDs to availableBDs
+    while (enqueuedBDs.size() > numPendingBDs)
+    {
+        size_t bdNumber = frontAndPop(enqueuedBDs);
+        availableBDs.push(bdNumber);
+        ++numCompletedBDs;
+    }
+
+    return driverStatus;
+}
+
 /************************************ dma_api ************************************/
 
 static uint8_t relativeToAbsoluteRow(int tileType, uint8_t row)
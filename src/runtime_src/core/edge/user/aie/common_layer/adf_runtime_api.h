@@ -84,8 +84,15 @@ public:
     err_code enqueueBD(uint64_t address, size_t size);
 #endif
     err_code wait();
+    err_code wait(uint64_t bdToken);
     err_code enqueueTask(std::vector<dma_api::buffer_descriptor> bdParams, uint32_t repeatCount, bool enableTaskCompleteToken);
+
+    /// Token of the most recently enqueued BD, BDs complete in order of their tokens
+    uint64_t getLastBDToken() const { return numSubmittedBDs; }
 private:
+    /// Move BDs completed by the shim DMA from enqueuedBDs to availableBDs, returns AIE driver status
+    int reclaimCompletedBDs();
+
     /// GMIO shim DMA physical configuration compiled by the AIE compiler
     const gmio_config* pGMIOConfig;
 
@@ -97,6 +104,10 @@ private:
     uint8_t dmaStartQMaxSize;
     std::queue<size_t> enqueuedBDs;
     std::queue<size_t> availableBDs;
+
+    /// Number of BDs enqueued and completed since configuration
+    uint64_t numSubmittedBDs = 0;
+    uint64_t numCompletedBDs = 0;
 };
 
 err_code checkRTPConfigForUpdate(const rtp_config* pRTPConfig, const graph_config* pGraphConfig, size_t numBytes, bool isRunning = false);
@@ -3,7 +3,10 @@
 
 #include "graph_object.h"
 #include "core/common/system.h"
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <thread>
 #include "core/edge/user/shim.h"
 
 namespace zynqaie {
@@ -137,28 +140,33 @@ namespace zynqaie {
       auto begin = std::chrono::high_resolution_clock::now();
 
       /*
-       * We are using busy waiting here. Until every tile in the graph
-       * is done, we keep polling each tile.
+       * There is no completion interrupt for a graph, so every tile in
+       * the graph is polled until it is done.  The done bit of a core
+       * stays set until the core is disabled, so a tile found done is
+       * not read again and each pass starts at the first pending tile.
+       * Short graphs complete within the first few passes, for longer
+       * graphs the pause between passes grows so the wait does not keep
+       * a CPU busy.
        */
+      size_t pending = 0;
+      auto pause = std::chrono::microseconds(0);
+      static constexpr auto max_pause = std::chrono::microseconds(100);
       while (1)
       {
-        uint8_t done;
-        for (int i = 0; i < graph_config.coreColumns.size(); i++)
+        for (; pending < graph_config.coreColumns.size(); pending++)
         {
           /* Skip multi-rate core */
-          if (graph_config.triggered[i])
-          {
-            done = 1;
+          if (graph_config.triggered[pending])
             continue;
-          }
 
-          XAie_LocType coreTile = XAie_TileLoc(graph_config.coreColumns[i], graph_config.coreRows[i] + adf::config_manager::s_num_reserved_rows + 1);
+          uint8_t done = 0;
+          XAie_LocType coreTile = XAie_TileLoc(graph_config.coreColumns[pending], graph_config.coreRows[pending] + adf::config_manager::s_num_reserved_rows + 1);
           XAie_CoreReadDoneBit(aieArray->getDevInst(), coreTile, &done);
           if (!done)
             break;
         }
 
-        if (done)
+        if (pending == graph_config.coreColumns.size())
         {
           state = graph_state::stop;
           for (int i = 0; i < graph_config.coreColumns.size(); i++)
@@ -177,6 +185,14 @@ namespace zynqaie {
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(dur).count();
         if (timeout_ms >= 0 && timeout_ms < ms)
           throw xrt_core::error(-ETIME, "Wait graph '" + name + "' timeout.");
+
+        // Spin for the first passes, then back off exponentially
+        if (pause.count() == 0)
+          std::this_thread::yield();
+        else
+          std::this_thread::sleep_for(pause);
+        if (dur > std::chrono::microseconds(50))
+          pause = std::min(std::max(pause * 2, std::chrono::microseconds(1)), max_pause);
       }
       return -1;
   }
@@ -271,8 +287,8 @@ namespace zynqaie {
       }
   }
 
-  void
-  graph_object::update_graph_rtp(const char* port, const char* buffer, size_t size)
+  const adf::rtp_config*
+  graph_object::get_rtp_for_update(const char* port) const
   {
       auto it = rtps.find(port);
       if (it == rtps.end())
@@ -285,11 +301,11 @@ namespace zynqaie {
       if (rtp.isPL)
         throw xrt_core::error(-EINVAL, "Can't update graph '" + name + "': RTP port '" + port + "' is not AIE RTP");
 
-      aie_config_api->update(&rtp, (const void*)buffer, size);
+      return &rtp;
   }
 
-  void
-  graph_object::read_graph_rtp(const char* port, char* buffer, size_t size)
+  const adf::rtp_config*
+  graph_object::get_rtp_for_read(const char* port) const
   {
       auto it = rtps.find(port);
       if (it == rtps.end())
@@ -299,6 +315,44 @@ namespace zynqaie {
       if (rtp.isPL)
         throw xrt_core::error(-EINVAL, "Can't read graph '" + name + "': RTP port '" + port + "' is not AIE RTP");
 
-      aie_config_api->read(&rtp, (void*)buffer, size);
+      return &rtp;
+  }
+
+  void
+  graph_object::update_graph_rtp(const char* port, const char* buffer, size_t size)
+  {
+      aie_config_api->update(get_rtp_for_update(port), (const void*)buffer, size);
+  }
+
+  void
+  graph_object::read_graph_rtp(const char* port, char* buffer, size_t size)
+  {
+      aie_config_api->read(get_rtp_for_read(port), (void*)buffer, size);
+  }
+
+  void
+  graph_object::update_graph_rtps(const std::vector<xrt::graph::rtp_update>& updates)
+  {
+      // Resolve all ports before writing any, so that an invalid port
+      // leaves the graph untouched
+      std::vector<const adf::rtp_config*> configs;
+      configs.reserve(updates.size());
+      for (const auto& update : updates)
+        configs.push_back(get_rtp_for_update(update.port_name.c_str()));
+
+      for (size_t i = 0; i < updates.size(); ++i)
+        aie_config_api->update(configs[i], updates[i].value, updates[i].bytes);
+  }
+
+  void
+  graph_object::read_graph_rtps(const std::vector<xrt::graph::rtp_read>& reads)
+  {
+      std::vector<const adf::rtp_config*> configs;
+      configs.reserve(reads.size());
+      for (const auto& read : reads)
+        configs.push_back(get_rtp_for_read(read.port_name.c_str()));
+
+      for (size_t i = 0; i < reads.size(); ++i)
+        aie_config_api->read(configs[i], reads[i].value, reads[i].bytes);
   }
 }
@@ -13,6 +13,7 @@
 #include "xrt/xrt_graph.h"
 
 #include <memory>
+#include <vector>
 
 namespace ZYNQ {
 	class shim;
@@ -94,6 +95,19 @@ namespace zynqaie {
 
     void
     read_graph_rtp(const char* port, char* buffer, size_t size) override;
+
+    void
+    update_graph_rtps(const std::vector<xrt::graph::rtp_update>& rtps) override;
+
+    void
+    read_graph_rtps(const std::vector<xrt::graph::rtp_read>& rtps) override;
+
+  private:
+    const adf::rtp_config*
+    get_rtp_for_update(const char* port) const;
+
+    const adf::rtp_config*
+    get_rtp_for_read(const char* port) const;
   }; // graph_object
 }
 #endif  //_ZYNQ_GRAPH_OBJECT_H_
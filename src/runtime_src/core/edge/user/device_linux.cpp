@@ -8,6 +8,7 @@
 
 #include "core/common/debug_ip.h"
 #include "core/common/query_requests.h"
+#include "core/common/api/kernel_int.h"
 #include "core/common/xrt_profiling.h"
 #include "shim.h"
 #ifdef XRT_ENABLE_AIE
@@ -378,6 +379,17 @@ struct xclbin_uuid
   }
 };
 
+struct run_wait_stats
+{
+  using result_type = query::run_wait_stats::result_type;
+
+  static result_type
+  get(const xrt_core::device* device, key_type)
+  {
+    return xrt_core::kernel_int::get_run_wait_stats(device);
+  }
+};
+
 struct xclbin_slots
 {
   using result_type = query::xclbin_slots::result_type;
@@ -1034,6 +1046,7 @@ initialize_query_table()
   emplace_func0_request<query::kds_cu_info,             kds_cu_info>();
   emplace_func0_request<query::instance,                instance>();
   emplace_func0_request<query::xclbin_slots,            xclbin_slots>();
+  emplace_func0_request<query::run_wait_stats,          run_wait_stats>();
 
   emplace_func4_request<query::aim_counter,             aim_counter>();
   emplace_func4_request<query::am_counter,              am_counter>();
@@ -1132,6 +1145,35 @@ set_cu_read_range(cuidx_type cuidx, uint32_t start, uint32_t size)
     throw xrt_core::error(ret, "failed to set cu read range");
 }
 
+void
+device_linux::
+pin_svm_range(const void* addr, size_t size)
+{
+  auto shim = static_cast<ZYNQ::shim*>(get_device_handle());
+  if (auto ret = shim->xclSVMPin(addr, size, false))
+    throw xrt_core::error(ret, "failed to pin svm range");
+}
+
+void
+device_linux::
+unpin_svm_range(const void* addr, size_t size)
+{
+  auto shim = static_cast<ZYNQ::shim*>(get_device_handle());
+  if (auto ret = shim->xclSVMPin(addr, size, true))
+    throw xrt_core::error(ret, "failed to unpin svm range");
+}
+
+int
+device_linux::
+get_completion_fd()
+{
+  auto shim = static_cast<ZYNQ::shim*>(get_device_handle());
+  auto fd = shim->xclGetCompletionFD();
+  if (fd < 0)
+    throw xrt_core::error(fd, "failed to register completion eventfd");
+  return fd;
+}
+
 std::unique_ptr<xrt_core::graph_handle>
 device_linux::
 open_graph_handle(const xrt::uuid& xclbin_id, const char* name, xrt::graph::access_mode am)
@@ -1217,6 +1259,30 @@ wait_gmio(const char *gmioName)
     throw system_error(ret, "fail to wait gmio");
 }
 
+// The BD token and the per BD wait are valid only after a prior
+// sync_aie_bo_nb, which has opened the AIE context
+uint64_t
+device_linux::
+get_gmio_bd_token(const char *gmioName)
+{
+  auto drv = ZYNQ::shim::handleCheck(get_device_handle());
+  if (!drv->isAieRegistered())
+    throw xrt_core::error(-EINVAL, "No AIE presented");
+
+  return drv->getAieArray()->get_gmio_bd_token(gmioName);
+}
+
+void
+device_linux::
+wait_gmio(const char *gmioName, uint64_t bd_token)
+{
+  auto drv = ZYNQ::shim::handleCheck(get_device_handle());
+  if (!drv->isAieRegistered())
+    throw xrt_core::error(-EINVAL, "No AIE presented");
+
+  drv->getAieArray()->wait_gmio(gmioName, bd_token);
+}
+
 int
 device_linux::
 start_profiling(int option, const char* port1Name, const char* port2Name, uint32_t value)
@@ -36,6 +36,15 @@ public:
   void
   set_cu_read_range(cuidx_type ip_index, uint32_t start, uint32_t size) override;
 
+  void
+  pin_svm_range(const void* addr, size_t size) override;
+
+  void
+  unpin_svm_range(const void* addr, size_t size) override;
+
+  int
+  get_completion_fd() override;
+
   std::unique_ptr<xrt_core::graph_handle>
   open_graph_handle(const xrt::uuid& xclbin_id, const char* name, xrt::graph::access_mode am) override;
 
@@ -61,6 +70,12 @@ public:
   void
   wait_gmio(const char *gmioName) override;
 
+  uint64_t
+  get_gmio_bd_token(const char *gmioName) override;
+
+  void
+  wait_gmio(const char *gmioName, uint64_t bd_token) override;
+
   int
   start_profiling(int option, const char* port1Name, const char* port2Name, uint32_t value) override;
 
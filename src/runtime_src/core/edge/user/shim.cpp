@@ -24,6 +24,7 @@
 #include "core/common/scheduler.h"
 #include "core/common/xclbin_parser.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cerrno>
 #include <chrono>
@@ -40,6 +41,7 @@
 #include <fcntl.h>
 #include <poll.h>
 #include <unistd.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 
@@ -145,6 +147,9 @@ shim::
     close(mKernelFD);
   }
 
+  if (mCompletionFD >= 0)
+    close(mCompletionFD);
+
   for (auto p : mCuMaps) {
     if (p)
       (void) munmap(p, mCuMapSize);
@@ -465,29 +470,49 @@ xclCopyBO(unsigned int dst_boHandle, unsigned int src_boHandle, size_t size,
 {
   int ret = -EOPNOTSUPP;
 #ifdef __aarch64__
-  auto bo = mCmdBOCache->alloc<ert_start_copybo_cmd>();
-  ert_fill_copybo_cmd(bo.second, src_boHandle, dst_boHandle,
-                      src_offset, dst_offset, size);
-
-  auto boh = static_cast<buffer_object*>(bo.first.get());
-  ret = xclExecBuf(boh->get_handle());
-  if (ret) {
-    mCmdBOCache->release(std::move(bo));
-    return ret;
-  }
-
-  do {
-    ret = xclExecWait(1000);
-    if (ret == -1)
+  // Large copies are split into several copy commands that are all in
+  // flight at once.  zocl assigns each command a DMA channel round
+  // robin, so the pieces are copied by multiple channels in parallel.
+  constexpr size_t copy_chunk_min = 4 * 1024 * 1024;
+  constexpr size_t copy_chunk_max = 1ULL << 30;  // fits ert 32-bit size
+  constexpr size_t max_copy_cmds = 4;
+  size_t chunk = std::max(copy_chunk_min, (size + max_copy_cmds - 1) / max_copy_cmds);
+  chunk = std::min((chunk + 4095) & ~size_t(4095), copy_chunk_max);
+
+  std::vector<xrt_core::bo_cache::cmd_bo<ert_start_copybo_cmd>> cmds;
+  ret = 0;
+  for (size_t off = 0; off < size; off += chunk) {
+    auto len = std::min(chunk, size - off);
+    auto bo = mCmdBOCache->alloc<ert_start_copybo_cmd>();
+    ert_fill_copybo_cmd(bo.second, src_boHandle, dst_boHandle,
+                        src_offset + off, dst_offset + off, static_cast<uint32_t>(len));
+
+    auto boh = static_cast<buffer_object*>(bo.first.get());
+    ret = xclExecBuf(boh->get_handle());
+    if (ret) {
+      mCmdBOCache->release(std::move(bo));
       break;
+    }
+    cmds.push_back(std::move(bo));
   }
-  while (bo.second->state < ERT_CMD_STATE_COMPLETED);
 
-  ret = (ret == -1) ? -errno : 0;
-  if (!ret && (bo.second->state != ERT_CMD_STATE_COMPLETED))
-    ret = -EINVAL;
+  // Wait for all submitted commands, also on submission error
+  auto pending = [&cmds] {
+    return std::any_of(cmds.begin(), cmds.end(),
+                       [](const auto& bo) { return bo.second->state < ERT_CMD_STATE_COMPLETED; });
+  };
+  int wret = 0;
+  while (wret != -1 && pending())
+    wret = xclExecWait(1000);
 
-  mCmdBOCache->release(std::move(bo));
+  if (!ret)
+    ret = (wret == -1) ? -errno : 0;
+
+  for (auto& bo : cmds) {
+    if (!ret && (bo.second->state != ERT_CMD_STATE_COMPLETED))
+      ret = -EINVAL;
+    mCmdBOCache->release(std::move(bo));
+  }
 #endif
   xclLog(XRT_INFO, "%s: return %d", __func__, ret);
   return ret;
@@ -1255,6 +1280,42 @@ xclIPSetReadRange(uint32_t ipIndex, uint32_t start, uint32_t size)
     return ret ? -errno : ret;
 }
 
+int
+shim::
+xclSVMPin(const void* addr, size_t size, bool unpin)
+{
+  drm_zocl_svm_pin pin = {reinterpret_cast<uint64_t>(addr), size, unpin ? DRM_ZOCL_SVM_UNPIN : 0U};
+
+  int ret = ioctl(mKernelFD, DRM_IOCTL_ZOCL_SVM_PIN, &pin);
+  return ret ? -errno : ret;
+}
+
+// Eventfd signaled by zocl on each command completion of this process.
+// Unlike mKernelFD it can be waited on by any number of threads and
+// epoll sets without taking events from xclExecWait.
+int
+shim::
+xclGetCompletionFD()
+{
+  std::lock_guard<std::mutex> lk(mCompletionFDLock);
+  if (mCompletionFD >= 0)
+    return mCompletionFD;
+
+  int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (fd < 0)
+    return -errno;
+
+  drm_zocl_eventfd info = {fd, 0};
+  if (ioctl(mKernelFD, DRM_IOCTL_ZOCL_EVENTFD, &info)) {
+    int ret = -errno;
+    close(fd);
+    return ret;
+  }
+
+  mCompletionFD = fd;
+  return mCompletionFD;
+}
+
 int
 shim::
 xclOpenIPInterruptNotify(uint32_t ipIndex, unsigned int flags)
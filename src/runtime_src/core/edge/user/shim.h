@@ -250,6 +250,8 @@ public:
   static shim *handleCheck(void *handle, bool checkDrmFd = true);
   int xclIPName2Index(const char *name);
   int xclIPSetReadRange(uint32_t ipIndex, uint32_t start, uint32_t size);
+  int xclSVMPin(const void* addr, size_t size, bool unpin);
+  int xclGetCompletionFD();
 
   // Application debug path functionality for xbutil
   size_t xclDebugReadCheckers(xdp::LAPCCounterResults* aCheckerResults);
@@ -301,6 +303,8 @@ private:
   std::vector<uint32_t*> mCuMaps;
   const size_t mCuMapSize = 64 * 1024;
   std::mutex mCuMapLock;
+  int mCompletionFD = -1;
+  std::mutex mCompletionFDLock;
   int xclRegRW(bool rd, uint32_t cu_index, uint32_t offset, uint32_t *datap);
 
 #ifdef XRT_ENABLE_AIE
@@ -118,6 +118,10 @@ struct ert_packet {
  * @stat_enabled:    [4]     enabled driver to record timestamp for various
  *                           states cmd has gone through. The stat data
  *                           is appended after cmd data.
+ * @fw_stat_enabled: [5]     with stat_enabled, also record ERT clock counter
+ *                           when CU was started and done. The data is
+ *                           appended after the stat data. Requires ERT
+ *                           firmware and driver support, else zero.
  * @extra_cu_masks:  [11-10] extra CU masks in addition to mandatory mask
  * @count:           [22-12] number of words following header for cmd data. Not
  *                           include stat data.
@@ -136,7 +140,8 @@ struct ert_start_kernel_cmd {
     struct {
       uint32_t state:4;          /* [3-0]   */
       uint32_t stat_enabled:1;   /* [4]     */
-      uint32_t unused:5;         /* [9-5]   */
+      uint32_t fw_stat_enabled:1;/* [5]     */
+      uint32_t unused:4;         /* [9-6]   */
       uint32_t extra_cu_masks:2; /* [11-10] */
       uint32_t count:11;         /* [22-12] */
       uint32_t opcode:5;         /* [27-23] */
@@ -606,6 +611,15 @@ struct cu_cmd_state_timestamps {
   uint64_t skc_timestamps[ERT_CMD_STATE_MAX]; // In nano-second
 };
 
+/*
+ * ERT clock counter when CU was started and done. Convert to host time
+ * with ERT_CLK_CALIB. Both are zero if ERT did not record them.
+ */
+struct cu_cmd_fw_timestamps {
+  uint32_t cu_start;
+  uint32_t cu_done;
+};
+
 /**
  * Opcode types for commands
  *
@@ -1142,6 +1156,12 @@ ert_start_kernel_timestamps(struct ert_start_kernel_cmd *pkt)
     ((char *)pkt + P2ROUNDUP(offset, sizeof(uint64_t)));
 }
 
+static inline struct cu_cmd_fw_timestamps *
+ert_start_kernel_fw_timestamps(struct ert_start_kernel_cmd *pkt)
+{
+  return (struct cu_cmd_fw_timestamps *)(ert_start_kernel_timestamps(pkt) + 1);
+}
+
 /* Return 0 if this pkt doesn't support timestamp or disabled */
 static inline int
 get_size_with_timestamps_or_zero(struct ert_packet *pkt)
@@ -1158,6 +1178,8 @@ get_size_with_timestamps_or_zero(struct ert_packet *pkt)
     if (skcmd->stat_enabled) {
       size = (char *)ert_start_kernel_timestamps(skcmd) - (char *)pkt;
       size += sizeof(struct cu_cmd_state_timestamps);
+      if (skcmd->fw_stat_enabled)
+        size += sizeof(struct cu_cmd_fw_timestamps);
     }
   }
 
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_COLLECTIVE_H_
+#define XRT_COLLECTIVE_H_
+
+#include "xrt/detail/config.h"
+#include "xrt/xrt_bo.h"
+
+#ifdef __cplusplus
+# include <cstddef>
+# include <vector>
+#endif
+
+#ifdef __cplusplus
+namespace xrt::collective {
+
+/*!
+ * @struct options
+ *
+ * @brief
+ * Schedule of a collective operation
+ *
+ * @details
+ * Collectives move buffer content between devices with xrt::bo::copy,
+ * which is a direct card to card DMA when the devices are P2P peers
+ * and otherwise goes through buffer export and import.
+ *
+ * A ring schedule forwards the data device to device and pipelines
+ * it in chunks, so every link carries the data once.  A tree schedule
+ * doubles the number of devices holding the data each round, which
+ * takes fewer steps for small buffers.  The automatic schedule picks
+ * a tree for buffers smaller than two chunks and a ring otherwise.
+ */
+struct options
+{
+  enum class schedule { automatic, ring, tree };
+
+  schedule sched = schedule::automatic;
+  size_t chunk_size = 4 * 1024 * 1024;  // bytes per pipelined copy
+};
+
+/**
+ * broadcast() - Copy a buffer to buffers on other devices
+ *
+ * @param src
+ *  Buffer to broadcast
+ * @param dsts
+ *  Destination buffers, at least src.size() bytes each, typically
+ *  one per device
+ * @param opt
+ *  Schedule options
+ *
+ * All destination buffers receive the first src.size() bytes of src.
+ * Ring order follows the order of dsts.
+ */
+XRT_API_EXPORT
+void
+broadcast(const xrt::bo& src, const std::vector<xrt::bo>& dsts, const options& opt = {});
+
+/**
+ * scatter() - Split a buffer across buffers on other devices
+ *
+ * @param src
+ *  Buffer to scatter, at least the combined size of dsts
+ * @param dsts
+ *  Destination buffers, dsts[i] receives dsts[i].size() bytes of
+ *  src starting after the bytes that went to dsts[0..i-1]
+ * @param opt
+ *  Schedule options
+ *
+ * Slices are disjoint and are copied from src in parallel, the
+ * schedule options do not apply.
+ */
+XRT_API_EXPORT
+void
+scatter(const xrt::bo& src, const std::vector<xrt::bo>& dsts, const options& opt = {});
+
+/**
+ * gather() - Concatenate buffers from other devices into a buffer
+ *
+ * @param srcs
+ *  Source buffers, srcs[i] is placed after srcs[0..i-1] in dst
+ * @param dst
+ *  Destination buffer, at least the combined size of srcs
+ * @param opt
+ *  Schedule options
+ *
+ * Slices are disjoint and are copied into dst in parallel, the
+ * schedule options do not apply.
+ */
+XRT_API_EXPORT
+void
+gather(const std::vector<xrt::bo>& srcs, const xrt::bo& dst, const options& opt = {});
+
+/**
+ * all_gather() - Gather the buffers of all devices on every device
+ *
+ * @param srcs
+ *  Source buffers of equal size, one per device
+ * @param dsts
+ *  Destination buffers, one per device in the same order as srcs,
+ *  each at least srcs.size() * srcs[0].size() bytes
+ * @param opt
+ *  Schedule options
+ *
+ * On return every dsts[j] holds the concatenation of all srcs.
+ * Always uses a ring schedule where each step forwards one slice
+ * to the next device in order, the schedule options do not apply.
+ */
+XRT_API_EXPORT
+void
+all_gather(const std::vector<xrt::bo>& srcs, const std::vector<xrt::bo>& dsts, const options& opt = {});
+
+} // xrt::collective
+
+#endif // __cplusplus
+
+#endif
@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_CORO_H_
+#define XRT_CORO_H_
+
+// C++20 coroutine support for XRT asynchronous operations
+// These extensions are experimental
+//
+// The awaitables are header only and built on the completion
+// notifications of xrt::run::start(done) and
+// xrt::bo::async_handle::set_callback(), so XRT itself is not
+// required to be compiled as C++20.
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_kernel.h"
+
+#if defined(__cplusplus) && defined(__cpp_impl_coroutine)
+# include <coroutine>
+# include <exception>
+# include <functional>
+# include <utility>
+
+namespace xrt::coro {
+
+/**
+ * executor - Function that resumes a suspended coroutine
+ *
+ * A coroutine awaiting an XRT operation is resumed by the thread
+ * that observes the completion, which is an XRT internal thread.  An
+ * executor is used to hand the resumption off to a thread of the
+ * application's choosing, e.g. by posting the coroutine handle to a
+ * thread pool or event loop.  The executor must not block.
+ *
+ * An empty executor resumes the coroutine directly from the XRT
+ * completion thread.
+ */
+using executor = std::function<void(std::coroutine_handle<>)>;
+
+namespace detail {
+
+inline void
+resume(const executor& ex, std::coroutine_handle<> h)
+{
+  if (ex)
+    ex(h);
+  else
+    h.resume();
+}
+
+} // detail
+
+/**
+ * class run_awaitable - Awaitable execution of an xrt::run
+ *
+ * Starts the run when awaited and resumes the awaiting coroutine
+ * when the run completes.  The result of the co_await expression is
+ * the final state of the run.
+ */
+class run_awaitable
+{
+  xrt::run m_run;
+  executor m_executor;
+  ert_cmd_state m_state = ERT_CMD_STATE_NEW;
+
+public:
+  run_awaitable(xrt::run run, executor ex)
+    : m_run(std::move(run))
+    , m_executor(std::move(ex))
+  {}
+
+  bool
+  await_ready() const noexcept
+  {
+    return false;
+  }
+
+  // The completion may resume the coroutine before start() returns,
+  // this object must not be accessed after the run is started.
+  void
+  await_suspend(std::coroutine_handle<> h)
+  {
+    m_run.start([this, h](ert_cmd_state state) {
+      m_state = state;
+      detail::resume(m_executor, h);
+    });
+  }
+
+  ert_cmd_state
+  await_resume() const noexcept
+  {
+    return m_state;
+  }
+};
+
+/**
+ * class bo_sync_awaitable - Awaitable asynchronous sync of an xrt::bo
+ *
+ * Starts the sync when awaited and resumes the awaiting coroutine
+ * when the sync completes.  The co_await expression rethrows any
+ * error from the sync.
+ */
+class bo_sync_awaitable
+{
+  xrt::bo m_bo;
+  xclBOSyncDirection m_dir;
+  size_t m_size;
+  size_t m_offset;
+  executor m_executor;
+  std::exception_ptr m_error;
+
+public:
+  bo_sync_awaitable(xrt::bo bo, xclBOSyncDirection dir, size_t sz, size_t offset, executor ex)
+    : m_bo(std::move(bo))
+    , m_dir(dir)
+    , m_size(sz)
+    , m_offset(offset)
+    , m_executor(std::move(ex))
+  {}
+
+  bool
+  await_ready() const noexcept
+  {
+    return false;
+  }
+
+  // The completion may resume the coroutine before set_callback()
+  // returns, this object must not be accessed after the callback is
+  // set.
+  void
+  await_suspend(std::coroutine_handle<> h)
+  {
+    auto handle = m_bo.async(m_dir, m_size, m_offset);
+    handle.set_callback([this, h](std::exception_ptr eptr) {
+      m_error = std::move(eptr);
+      detail::resume(m_executor, h);
+    });
+  }
+
+  void
+  await_resume() const
+  {
+    if (m_error)
+      std::rethrow_exception(m_error);
+  }
+};
+
+/**
+ * start_async() - Start a run asynchronously
+ *
+ * @param run
+ *   Run object with arguments set, the run must not be started
+ * @param ex
+ *   Executor resuming the awaiting coroutine, empty to resume
+ *   from the XRT completion thread
+ * @return
+ *   Awaitable producing the final state of the run
+ *
+ * Usage:
+ *   auto state = co_await xrt::coro::start_async(run, ex);
+ */
+inline run_awaitable
+start_async(const xrt::run& run, executor ex = {})
+{
+  return {run, std::move(ex)};
+}
+
+/**
+ * sync_async() - Sync buffer object asynchronously
+ *
+ * @param bo
+ *   Buffer object to sync
+ * @param dir
+ *   Direction of sync
+ * @param sz
+ *   Size of data to sync
+ * @param offset
+ *   Offset within the BO of data to sync
+ * @param ex
+ *   Executor resuming the awaiting coroutine, empty to resume
+ *   from the XRT completion thread
+ * @return
+ *   Awaitable that completes when the sync completes
+ *
+ * Usage:
+ *   co_await xrt::coro::sync_async(bo, XCL_BO_SYNC_BO_TO_DEVICE, bo.size(), 0, ex);
+ */
+inline bo_sync_awaitable
+sync_async(const xrt::bo& bo, xclBOSyncDirection dir, size_t sz, size_t offset, executor ex = {})
+{
+  return {bo, dir, sz, offset, std::move(ex)};
+}
+
+/**
+ * sync_async() - Sync entire buffer object asynchronously
+ */
+inline bo_sync_awaitable
+sync_async(const xrt::bo& bo, xclBOSyncDirection dir, executor ex = {})
+{
+  return {bo, dir, bo.size(), 0, std::move(ex)};
+}
+
+} // xrt::coro
+
+#endif // __cpp_impl_coroutine
+
+#endif
@@ -8,12 +8,14 @@
 
 #include "xrt/detail/config.h"
 #include "xrt/detail/bitmask.h"
+#include "xrt/detail/pimpl.h"
 #include "xrt/xrt_bo.h"
 #include "xrt/xrt_hw_context.h"
 #include "xrt/xrt_kernel.h"
 #include "experimental/xrt_module.h"
 
 #ifdef __cplusplus
+# include <cstddef>
 # include <cstdint>
 #endif
 
@@ -232,6 +234,125 @@ public:
 };
 
 
+/*!
+ * @class striped_bo
+ *
+ * @brief
+ * Host buffer striped across the pseudo channels of an HBM memory group
+ *
+ * @details
+ * A memory group of an HBM platform spans several pseudo channels,
+ * but a buffer allocated in the group occupies one contiguous address
+ * range and is mostly served by one pseudo channel.  A striped buffer
+ * instead allocates one buffer per pseudo channel of the group and
+ * distributes the host buffer round robin over them in units of the
+ * stripe granularity: granule k of the host buffer is at offset
+ * (k / stripes()) * granularity() of stripe(k % stripes()).
+ *
+ * The pseudo channels of the group are the used memory banks of the
+ * memory topology whose address range lies within the group.  Each
+ * stripe is a regular xrt::bo allocated in one of those banks, so it
+ * passes the connectivity check of kernel arguments connected to the
+ * group and can be set as argument of a kernel that reads or writes
+ * the stripes through separate ports.
+ *
+ * The host buffer is synchronized with the stripes by sync(), which
+ * transfers all stripes concurrently.
+ */
+class striped_bo_impl;
+class striped_bo : public detail::pimpl<striped_bo_impl>
+{
+public:
+  /**
+   * striped_bo() - Construct empty striped buffer
+   */
+  striped_bo() = default;
+
+  /**
+   * striped_bo() - Allocate a striped buffer in a memory group
+   *
+   * @param device
+   *  The device on which to allocate the buffer
+   * @param sz
+   *  Size of the host buffer, a multiple of granularity
+   * @param grp
+   *  Memory group spanning the pseudo channels, typically the group
+   *  of the kernel argument from `xrt::kernel::group_id()`
+   * @param stripes
+   *  Number of pseudo channels to stripe over, 0 for all pseudo
+   *  channels of the group
+   * @param granularity
+   *  Bytes per stripe unit, a multiple of the page size
+   *
+   * Throws if the group has fewer pseudo channels than requested.
+   */
+  XRT_API_EXPORT
+  striped_bo(const xrt::device& device, size_t sz, xrt::memory_group grp,
+             size_t stripes, size_t granularity);
+
+  /**
+   * size() - Size of the host buffer
+   */
+  XRT_API_EXPORT
+  size_t
+  size() const;
+
+  /**
+   * stripes() - Number of stripes
+   */
+  XRT_API_EXPORT
+  size_t
+  stripes() const;
+
+  /**
+   * granularity() - Bytes per stripe unit
+   */
+  XRT_API_EXPORT
+  size_t
+  granularity() const;
+
+  /**
+   * stripe() - Buffer of a stripe
+   *
+   * @param idx
+   *  Index of stripe
+   * @return
+   *  Buffer allocated in the pseudo channel of the stripe
+   */
+  XRT_API_EXPORT
+  xrt::bo
+  stripe(size_t idx) const;
+
+  /**
+   * map() - Host buffer in unstriped layout
+   */
+  XRT_API_EXPORT
+  void*
+  map();
+
+  /**
+   * map() - Host buffer in unstriped layout
+   */
+  template <typename MapType>
+  MapType
+  map()
+  {
+    return reinterpret_cast<MapType>(map());
+  }
+
+  /**
+   * sync() - Synchronize the host buffer with the stripes
+   *
+   * @param dir
+   *  To device distributes the host buffer over the stripes, from
+   *  device collects the stripes into the host buffer
+   */
+  XRT_API_EXPORT
+  void
+  sync(xclBOSyncDirection dir);
+};
+
+
 class kernel : public xrt::kernel
 {
 public:
@@ -178,6 +178,63 @@ public:
   uint32_t
   read_register(uint32_t offset) const;
 
+  /**
+   * write_registers() - Write consecutive registers of an ip
+   *
+   * @param offset
+   *  Offset in register space of first register to write
+   * @param data
+   *  Values to write
+   * @param count
+   *  Number of 32-bit registers to write
+   *
+   * Registers are written in order of increasing offset.  If the
+   * register space has been mapped with map_registers(), the writes
+   * go directly through the mapping.
+   *
+   * Throws std::out_or_range if offset is not 32-bit aligned or if
+   * any register is outside the ip address space
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  write_registers(uint32_t offset, const uint32_t* data, size_t count);
+
+  /**
+   * read_registers() - Read consecutive registers of an ip
+   *
+   * @param offset
+   *  Offset in register space of first register to read
+   * @param data
+   *  Buffer receiving the values read
+   * @param count
+   *  Number of 32-bit registers to read
+   *
+   * Throws std::out_or_range if offset is not 32-bit aligned or if
+   * any register is outside the ip address space
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  read_registers(uint32_t offset, uint32_t* data, size_t count) const;
+
+  /**
+   * map_registers() - Map the ip register space for direct access
+   *
+   * @return
+   *  Pointer to the first register of the ip register space
+   *
+   * The mapping allows the application to access registers without
+   * a driver call or a lock per access.  It is valid for the lifetime
+   * of the ip object.  Accesses through the mapping must be 32-bit
+   * aligned and within the ip address range, no checking is done.
+   *
+   * Throws if the ip was not opened with exclusive access, if the ip
+   * has a read range, or if the platform does not support mapping of
+   * ip register space.
+   */
+  XCL_DRIVER_DLLESPEC
+  volatile uint32_t*
+  map_registers();
+
   /**
    * create_interrupt_notify() - Create xrt::ip::interrupt object
    *
@@ -10,8 +10,14 @@
 
 #ifdef __cplusplus
 # include "xrt/detail/pimpl.h"
+# include <array>
 # include <chrono>
 # include <condition_variable>
+# include <stdexcept>
+# include <string>
+# include <type_traits>
+# include <utility>
+# include <vector>
 #endif
 
 #ifdef __cplusplus
@@ -143,7 +149,9 @@ public:
    *
    * The runlist is submitted for execution. The run objects in the
    * list are executed atomically in the order they were added to the
-   * list.
+   * list.  A list of run objects of module based (DPU/NPU) kernels is
+   * submitted as a single command when it holds up to about a thousand
+   * run objects.
    *
    * Executing an empty runlist is a no-op.
    *
@@ -219,6 +227,407 @@ public:
   XRT_API_EXPORT
   void
   reset();
+
+  /**
+   * append() - Append a run object for streaming execution
+   *
+   * @param run
+   *  Run object to append
+   * @return
+   *  Stream index of the run object.  Indices increase monotonically
+   *  from 0 until the runlist is reset.
+   *
+   * A streaming runlist submits run objects in chains as soon as a
+   * chain is full, while earlier chains are still executing.  Chains
+   * that have completed are recycled automatically, which releases
+   * their run objects so they can be appended again.  Use flush() to
+   * submit a partially filled chain.
+   *
+   * A runlist is either streaming or built with add() and execute(),
+   * the two modes cannot be mixed without calling reset().
+   *
+   * Throws if the run object is still part of an executing chain or
+   * if a completed chain failed, in which case the exception carries
+   * the first failed run object.
+   */
+  XRT_API_EXPORT
+  size_t
+  append(const xrt::run& run);
+
+  /**
+   * flush() - Submit any appended run objects not yet submitted
+   */
+  XRT_API_EXPORT
+  void
+  flush();
+
+  /**
+   * wait() - Wait for a streamed run object to complete
+   *
+   * @param index
+   *  Stream index as returned by append()
+   * @param timeout
+   *  Timeout for wait.  A value of 0, implies block until run object
+   *  at index has completed.
+   * @return
+   *  std::cv_status::no_timeout if run object has completed,
+   *  std::cv_status::timeout if the timeout expired first.
+   *
+   * The chain containing the run object is submitted if necessary.
+   * Throws `xrt::runlist::command_error` if a completed chain failed.
+   */
+  XRT_API_EXPORT
+  std::cv_status
+  wait(size_t index, const std::chrono::milliseconds& timeout) const;
+};
+
+/**
+ * class run_template - Pre-encoded run object for repeated launch
+ *
+ * @brief
+ * A run template captures the fully encoded command of a run object
+ * whose arguments have been set.  Instantiating the template returns
+ * a run object with only the specified buffer arguments patched.
+ *
+ * @details
+ * Applications that launch the same kernel many times while changing
+ * only a few buffer arguments can use a run template to avoid
+ * re-encoding and re-validating the full register map per launch.
+ *
+ * The buffer argument indices that vary between instances are
+ * specified when the template is constructed.  All other arguments
+ * retain the values of the run object from which the template was
+ * created.
+ *
+ * Run objects returned by instantiate() are recycled by the template
+ * once they have completed and the application has released them.
+ * Such run objects should be used for start() and wait() only;
+ * setting arguments on an instance other than through instantiate()
+ * is undefined behavior.
+ */
+class run_template_impl;
+class run_template : public detail::pimpl<run_template_impl>
+{
+public:
+  /**
+   * run_template() - Construct empty run template object
+   */
+  run_template() = default;
+
+  /**
+   * run_template() - Construct from a run object
+   *
+   * @param run
+   *  Run object with all arguments set.  The command is copied, the
+   *  run object itself is not modified.
+   * @param bo_indices
+   *  Indices of global buffer arguments that are specified per
+   *  instantiation.
+   *
+   * Throws if any index is not a global memory argument of the
+   * kernel.
+   */
+  XRT_API_EXPORT
+  run_template(const xrt::run& run, const std::vector<int>& bo_indices);
+
+  /**
+   * instantiate() - Get a run object with specified buffer arguments
+   *
+   * @param bos
+   *  Pointers to buffers for the indices specified at construction
+   *  in the same order.
+   * @param count
+   *  Number of buffers, must match the number of indices.
+   * @return
+   *  A run object ready to be started.
+   *
+   * A buffer argument is validated for CU connectivity only if its
+   * memory bank differs from the bank of the buffer previously used
+   * with the returned run object.
+   */
+  XRT_API_EXPORT
+  xrt::run
+  instantiate(const xrt::bo* const* bos, size_t count);
+
+  /**
+   * instantiate() - Get a run object with specified buffer arguments
+   *
+   * @param bos
+   *  Buffers for the indices specified at construction in the same
+   *  order.
+   * @return
+   *  A run object ready to be started.
+   */
+  template <typename ...Args>
+  xrt::run
+  instantiate(const Args&... bos)
+  {
+    std::array<const xrt::bo*, sizeof...(Args)> arr {&bos...};
+    return instantiate(arr.data(), arr.size());
+  }
+};
+
+/**
+ * class run_ring - Ring of run objects restarted on completion
+ *
+ * @brief
+ * A run ring keeps a fixed set of run objects with bound arguments
+ * executing back to back.  When a run object in the ring completes,
+ * it is started again from the completion notification without
+ * returning to the application.
+ *
+ * @details
+ * Starting the ring starts all run objects in the order they were
+ * specified, each completion then restarts the completed run object
+ * until the requested number of starts have been made or the ring is
+ * stopped.  The ring stops on the first run object that fails.
+ *
+ * The run objects must not be started, have arguments changed, or
+ * have callbacks added while part of the ring.  The completion
+ * notification runs on the command monitor thread unless xrt.ini
+ * Runtime.callback_threads is set.
+ */
+class run_ring_impl;
+class run_ring : public detail::pimpl<run_ring_impl>
+{
+public:
+  /**
+   * run_ring() - Construct empty run ring object
+   */
+  run_ring() = default;
+
+  /**
+   * run_ring() - Construct from run objects
+   *
+   * @param runs
+   *  Run objects with all arguments set.  The run objects must not be
+   *  running and must be distinct.
+   *
+   * The ring is destroyed when the last copy of the ring object goes
+   * out of scope.  The destructor stops the ring and waits for the
+   * run objects in flight to complete.
+   */
+  XRT_API_EXPORT
+  explicit
+  run_ring(const std::vector<xrt::run>& runs);
+
+  /**
+   * start() - Start the ring
+   *
+   * @param iterations
+   *  Total number of run object starts, 0 to run until stopped.
+   *
+   * Throws if the ring is already running.
+   */
+  XRT_API_EXPORT
+  void
+  start(size_t iterations = 0);
+
+  /**
+   * stop() - Stop restarting run objects
+   *
+   * Run objects in flight are not aborted, use wait() to wait for
+   * their completion.
+   */
+  XRT_API_EXPORT
+  void
+  stop();
+
+  /**
+   * wait() - Wait for the ring to finish
+   *
+   * @param timeout
+   *  Timeout for wait.  A value of 0, implies block until the ring
+   *  has finished.
+   * @return
+   *  std::cv_status::no_timeout if all starts have completed after
+   *  the ring reached its iteration count or was stopped,
+   *  std::cv_status::timeout if the timeout expired first.
+   *
+   * Throws xrt::run::command_error if a run object failed, or the
+   * error that prevented a run object from being started.
+   */
+  XRT_API_EXPORT
+  std::cv_status
+  wait(const std::chrono::milliseconds& timeout) const;
+
+  /**
+   * wait() - Wait for the ring to finish
+   */
+  void
+  wait() const
+  {
+    wait(std::chrono::milliseconds(0));
+  }
+
+  /**
+   * completed() - Number of run object completions
+   *
+   * @return
+   *  Completions since the ring was last started.
+   */
+  XRT_API_EXPORT
+  size_t
+  completed() const;
+};
+
+/**
+ * class typed_kernel - Kernel with argument types fixed at compile time
+ *
+ * @brief
+ * A typed kernel wraps an xrt::kernel whose argument list is known
+ * to the application and checks it against the xclbin meta data
+ * once, when the typed kernel is constructed.
+ *
+ * @details
+ * Each template argument is the host type of the kernel argument at
+ * the same index.  An xrt::bo is a global memory argument; any other
+ * type is a scalar passed by value and must be trivially copyable
+ * with the size recorded in the xclbin for the argument.  The
+ * number of template arguments must match the number of kernel
+ * arguments.
+ *
+ * Since the signature is validated up front, arguments are set by
+ * index with no name lookup, and a mismatch between application and
+ * xclbin is reported at construction instead of at first use.
+ */
+template <typename ...Args>
+class typed_kernel
+{
+  static_assert(((std::is_same_v<Args, xrt::bo> || std::is_trivially_copyable_v<Args>) && ...),
+                "typed_kernel arguments must be xrt::bo or trivially copyable scalars");
+  static_assert(((!std::is_pointer_v<Args>) && ...),
+                "typed_kernel scalar arguments are passed by value");
+
+  xrt::kernel m_kernel;
+
+  template <typename ArgType>
+  static void
+  validate_arg(const xrt::xclbin::arg& arg, size_t idx)
+  {
+    auto host_type = arg.get_host_type();
+    bool global = !host_type.empty() && host_type.back() == '*';
+    if constexpr (std::is_same_v<ArgType, xrt::bo>) {
+      if (!global)
+        throw std::runtime_error("typed_kernel argument " + std::to_string(idx)
+                                 + " (" + arg.get_name() + ") is not a global memory argument");
+    }
+    else {
+      if (global)
+        throw std::runtime_error("typed_kernel argument " + std::to_string(idx)
+                                 + " (" + arg.get_name() + ") is a global memory argument");
+      if (arg.get_size() != sizeof(ArgType))
+        throw std::runtime_error("typed_kernel argument " + std::to_string(idx)
+                                 + " (" + arg.get_name() + ") size mismatch, xclbin size is "
+                                 + std::to_string(arg.get_size()) + " bytes, host type size is "
+                                 + std::to_string(sizeof(ArgType)) + " bytes");
+    }
+  }
+
+  template <size_t ...Idx>
+  static void
+  validate(const std::vector<xrt::xclbin::arg>& args, std::index_sequence<Idx...>)
+  {
+    (validate_arg<Args>(args[Idx], Idx), ...);
+  }
+
+  void
+  validate() const
+  {
+    auto xkernel = m_kernel.get_xclbin().get_kernel(m_kernel.get_name());
+    if (!xkernel)
+      throw std::runtime_error("typed_kernel no xclbin meta data for kernel " + m_kernel.get_name());
+
+    auto args = xkernel.get_args();
+    if (args.size() != sizeof...(Args))
+      throw std::runtime_error("typed_kernel " + m_kernel.get_name() + " expects "
+                               + std::to_string(sizeof...(Args)) + " arguments, xclbin has "
+                               + std::to_string(args.size()));
+
+    validate(args, std::index_sequence_for<Args...>{});
+  }
+
+  template <size_t ...Idx>
+  static void
+  set_args(xrt::run& run, std::index_sequence<Idx...>, const Args&... args)
+  {
+    (run.set_arg(static_cast<int>(Idx), args), ...);
+  }
+
+public:
+  /**
+   * typed_kernel() - Construct empty typed kernel object
+   */
+  typed_kernel() = default;
+
+  /**
+   * typed_kernel() - Construct from a kernel object
+   *
+   * @param kernel
+   *  Kernel whose arguments must match Args
+   *
+   * Throws if the kernel signature in the xclbin does not match.
+   */
+  explicit
+  typed_kernel(xrt::kernel kernel)
+    : m_kernel(std::move(kernel))
+  {
+    validate();
+  }
+
+  /**
+   * typed_kernel() - Construct kernel in a hardware context
+   *
+   * @param ctx
+   *  Hardware context with the kernel
+   * @param name
+   *  Name of kernel to construct
+   *
+   * Throws if the kernel signature in the xclbin does not match.
+   */
+  typed_kernel(const xrt::hw_context& ctx, const std::string& name)
+    : typed_kernel(xrt::kernel{ctx, name})
+  {}
+
+  /**
+   * set_args() - Set all arguments of a run object
+   *
+   * @param run
+   *  Run object of this kernel
+   * @param args
+   *  Kernel arguments
+   */
+  void
+  set_args(xrt::run& run, const Args&... args) const
+  {
+    set_args(run, std::index_sequence_for<Args...>{}, args...);
+  }
+
+  /**
+   * operator() - Start the kernel with specified arguments
+   *
+   * @param args
+   *  Kernel arguments
+   * @return
+   *  Run object that was started
+   */
+  xrt::run
+  operator() (const Args&... args) const
+  {
+    xrt::run run{m_kernel};
+    set_args(run, args...);
+    run.start();
+    return run;
+  }
+
+  /**
+   * get_kernel() - Underlying kernel object
+   */
+  const xrt::kernel&
+  get_kernel() const
+  {
+    return m_kernel;
+  }
 };
 
 } // namespace xrt
@@ -10,6 +10,7 @@
 # include <algorithm>
 # include <future>
 # include <memory>
+# include <vector>
 #endif
 
 #ifdef __cplusplus
@@ -21,8 +22,11 @@ namespace xrt {
  *
  * Used for sequencing operations in order of enqueuing.
  *
- * A queue has exactly one consumer which is a separate thread created
- * when the queue is constructed.
+ * The tasks of all queues are executed by worker threads shared
+ * by the process.  By default a queue executes its tasks one at a
+ * time in order of enqueuing.  An out of order queue executes its
+ * tasks concurrently, ordering is then expressed with explicit
+ * dependencies.
  *
  * When an opeation is enqueued on the queue an event is returned to
  * the caller.  This event can be enqueued in a different queue, which
@@ -171,13 +175,31 @@ private:
 
 public:
   /**
-   * queue() - Constructor for queue object
+   * enum class order - Execution order of tasks in a queue
    *
-   * The queue is constructed with one consumer thread.
+   * @var in_order
+   *   Tasks are executed one at a time in order of enqueuing
+   * @var out_of_order
+   *   Tasks are executed concurrently in any order
+   */
+  enum class order { in_order, out_of_order };
+
+  /**
+   * queue() - Constructor for in order queue object
    */
   XRT_API_EXPORT
   queue();
 
+  /**
+   * queue() - Constructor for queue object
+   *
+   * @param o
+   *   Execution order of tasks enqueued to this queue
+   */
+  XRT_API_EXPORT
+  explicit
+  queue(order o);
+
   /**
    * enqueue() - Enqueue a callable
    *
@@ -204,6 +226,31 @@ public:
     return f;
   }
 
+  /**
+   * enqueue() - Enqueue a callable that depends on other operations
+   *
+   * @param c
+   *   Callable function, typically a lambda
+   * @param deps
+   *   Events of operations that must complete before the callable
+   *   is executed
+   * @return
+   *   Future result of the function (std::future)
+   *
+   * Used with out of order queues to order a task after specific
+   * operations in this or other queues.
+   */
+  template <typename Callable>
+  auto
+  enqueue(Callable&& c, std::vector<xrt::queue::event> deps)
+  {
+    return enqueue([cc = std::move(c), evs = std::move(deps)] {
+      for (const auto& ev : evs)
+        ev.wait();
+      return cc();
+    });
+  }
+
   /**
    * enqueue() - Enqueue the future of an enqueued operation
    *
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_STREAM_H_
+#define XRT_STREAM_H_
+
+#include "xrt/detail/config.h"
+#include "xrt/detail/pimpl.h"
+#include "xrt/xrt_device.h"
+
+#ifdef __cplusplus
+# include <chrono>
+# include <cstddef>
+# include <cstdint>
+#endif
+
+#ifdef __cplusplus
+// Opaque handle to internal use
+namespace xrt_core {
+class stream_handle;
+}
+
+namespace xrt {
+
+/*!
+ * @class stream
+ *
+ * @brief
+ * Host to kernel AXI4-Stream queue
+ *
+ * @details
+ * A stream object is one QDMA streaming queue connecting the host to
+ * a kernel stream port, identified by the route and flow id of the
+ * stream connection in the xclbin.  Data moves directly between the
+ * caller's host buffers and the kernel without staging in device
+ * memory.
+ *
+ * Buffers are transferred zero-copy, the driver pins and maps the
+ * host pages for the duration of the request.  Several buffers can
+ * be passed in a single call, each buffer is one packet on the
+ * stream.
+ *
+ * Requests can be blocking or asynchronous.  Asynchronous requests
+ * return as soon as they are queued to the descriptor ring of the
+ * stream, their completion is retrieved with poll().  The buffers of
+ * an asynchronous request must stay valid until it completes.
+ */
+class stream_impl;
+class stream : public detail::pimpl<stream_impl>
+{
+public:
+  /**
+   * @enum direction - direction of data movement
+   *
+   * @var host_to_device
+   *   Host writes to a kernel input stream
+   * @var device_to_host
+   *   Host reads from a kernel output stream
+   */
+  enum class direction : uint8_t { host_to_device, device_to_host };
+
+  /**
+   * @struct buffer - one host buffer of a request
+   */
+  struct buffer
+  {
+    void* data;
+    size_t size;
+  };
+
+  /**
+   * @struct completion - completion of an asynchronous request
+   *
+   * @var user_data
+   *   Value passed with the request to submit()
+   * @var bytes
+   *   Number of bytes transferred
+   * @var error
+   *   0 on success, otherwise negative errno of the failed request
+   */
+  struct completion
+  {
+    void* user_data;
+    size_t bytes;
+    int error;
+  };
+
+  /**
+   * @struct config - optional stream configuration
+   *
+   * @var ring_size
+   *   Number of descriptors in the QDMA ring of the stream, 0 uses
+   *   the driver default.  Descriptors are allocated once when the
+   *   stream is created and recycled as requests complete.
+   * @var max_inflight
+   *   Maximum number of outstanding asynchronous requests, 0 uses
+   *   the implementation default
+   * @var batch_bytes
+   *   Accumulate asynchronous requests until this many bytes are
+   *   queued before handing them to the driver, 0 disables
+   * @var batch_packets
+   *   Accumulate asynchronous requests until this many buffers are
+   *   queued before handing them to the driver, 0 disables
+   */
+  struct config
+  {
+    uint32_t ring_size = 0;
+    uint32_t max_inflight = 0;
+    uint32_t batch_bytes = 0;
+    uint32_t batch_packets = 0;
+  };
+
+public:
+  /**
+   * stream() - Default constructor
+   *
+   * Constructs an empty stream object that converts to false in
+   * boolean comparisons.
+   */
+  stream() = default;
+
+  /**
+   * stream() - Create a stream queue on a device
+   *
+   * @param device
+   *  The device with the kernel stream port
+   * @param dir
+   *  Direction of the stream
+   * @param route
+   *  Route id of the stream connection from the xclbin
+   * @param flow
+   *  Flow id of the stream connection from the xclbin
+   * @param cfg
+   *  Optional configuration
+   *
+   * Throws if the device has no streaming DMA engine.
+   */
+  XRT_API_EXPORT
+  stream(const xrt::device& device, direction dir, uint64_t route, uint64_t flow,
+         const config& cfg);
+
+  stream(const xrt::device& device, direction dir, uint64_t route, uint64_t flow)
+    : stream(device, dir, route, flow, config{})
+  {}
+
+  /**
+   * writev() - Blocking write of one or more buffers
+   *
+   * @param bufs
+   *  Array of buffers, each buffer is one packet
+   * @param count
+   *  Number of buffers in array
+   * @param eot
+   *  Mark end of transfer on the last buffer
+   * @return
+   *  Number of bytes written
+   *
+   * Only valid for host_to_device streams.  Throws on error.
+   */
+  XRT_API_EXPORT
+  size_t
+  writev(const buffer* bufs, size_t count, bool eot = true);
+
+  /**
+   * readv() - Blocking read into one or more buffers
+   *
+   * @param bufs
+   *  Array of buffers to fill
+   * @param count
+   *  Number of buffers in array
+   * @return
+   *  Number of bytes read
+   *
+   * Only valid for device_to_host streams.  Throws on error.
+   */
+  XRT_API_EXPORT
+  size_t
+  readv(const buffer* bufs, size_t count);
+
+  /**
+   * submit() - Queue an asynchronous request
+   *
+   * @param bufs
+   *  Array of buffers, each buffer is one packet
+   * @param count
+   *  Number of buffers in array
+   * @param user_data
+   *  Value returned in the completion of each buffer
+   * @param eot
+   *  Mark end of transfer on the last buffer, ignored for
+   *  device_to_host streams
+   *
+   * The request is read or write depending on direction of the
+   * stream.  Completion of each buffer is reported by poll().
+   * Throws on error.
+   */
+  XRT_API_EXPORT
+  void
+  submit(const buffer* bufs, size_t count, void* user_data, bool eot = true);
+
+  /**
+   * poll() - Retrieve completions of asynchronous requests
+   *
+   * @param comps
+   *  Array to receive completions
+   * @param min
+   *  Minimum number of completions to wait for
+   * @param max
+   *  Size of completion array
+   * @param timeout
+   *  Timeout for wait, 0 blocks until min completions are available
+   * @return
+   *  Number of completions stored in array, can be less than min
+   *  if the wait timed out
+   */
+  XRT_API_EXPORT
+  size_t
+  poll(completion* comps, size_t min, size_t max, const std::chrono::milliseconds& timeout);
+
+  /**
+   * get_direction() - Direction of the stream
+   */
+  XRT_API_EXPORT
+  direction
+  get_direction() const;
+};
+
+} // namespace xrt
+
+#else
+# error xrt::stream is only implemented for C++
+#endif // __cplusplus
+
+#endif
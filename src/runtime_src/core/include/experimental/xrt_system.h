@@ -1,5 +1,6 @@
 /*
  * Copyright (C) 2021-2022 Xilinx, Inc
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  */
 
@@ -8,6 +9,11 @@
 
 #include "xrt.h"
 
+#ifdef __cplusplus
+# include "xrt/xrt_device.h"
+# include <vector>
+#endif
+
 #ifdef __cplusplus
 
 /*!
@@ -28,6 +34,25 @@ XCL_DRIVER_DLLESPEC
 unsigned int
 enumerate_devices();
 
+/**
+ * load_xclbin_all() - Load an xclbin on multiple devices in parallel
+ *
+ * @param devices
+ *  Devices to program
+ * @param xclbin
+ *  Parsed xclbin to load on every device
+ *
+ * The xclbin is parsed once by the caller and shared by all devices.
+ * Each device is programmed on its own thread, so the total time is
+ * that of the slowest device rather than the sum.  The function
+ * returns when all loads have completed and throws the first error
+ * in device order if any load failed; devices that loaded
+ * successfully keep the xclbin.
+ */
+XCL_DRIVER_DLLESPEC
+void
+load_xclbin_all(const std::vector<xrt::device>& devices, const xrt::xclbin& xclbin);
+
 }}
 
 #endif // __cplusplus
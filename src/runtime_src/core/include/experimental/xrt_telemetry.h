@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef XRT_TELEMETRY_H_
+#define XRT_TELEMETRY_H_
+
+#include "xrt/detail/config.h"
+#include "xrt/detail/pimpl.h"
+#include "xrt/xrt_device.h"
+
+#ifdef __cplusplus
+# include <chrono>
+# include <cstdint>
+# include <functional>
+# include <limits>
+#endif
+
+#ifdef __cplusplus
+namespace xrt::telemetry {
+
+/*!
+ * @struct snapshot
+ *
+ * @brief
+ * Fixed layout sample of device sensors and firmware telemetry
+ *
+ * @details
+ * A snapshot is a plain struct that is filled in without any
+ * property tree or JSON construction, which makes it suitable for
+ * frequent sampling by fleet collectors.  A value that the device
+ * does not provide is set to `unavailable`.
+ *
+ * Sensor values are gauges.  Firmware telemetry values (interrupt,
+ * rtos, opcode, stream buffer and aie column counts) are counters
+ * that increase monotonically while the device is up.
+ */
+struct snapshot
+{
+  static constexpr uint64_t unavailable = std::numeric_limits<uint64_t>::max();
+  static constexpr uint32_t max_rtos_tasks = 16;
+  static constexpr uint32_t max_opcodes = 32;
+  static constexpr uint32_t max_stream_buffers = 16;
+  static constexpr uint32_t max_aie_columns = 16;
+
+  uint64_t sequence = 0;         // sample number, starting with 0
+  uint64_t timestamp_ns = 0;     // steady clock time of sample
+
+  // Sensors
+  uint64_t temp_fpga_c = unavailable;
+  uint64_t temp_card_top_front_c = unavailable;
+  uint64_t temp_hbm_c = unavailable;
+  uint64_t power_microwatts = unavailable;
+  uint64_t fan_speed_rpm = unavailable;
+  uint64_t v12v_pex_millivolts = unavailable;
+  uint64_t v12v_pex_milliamps = unavailable;
+  uint64_t int_vcc_millivolts = unavailable;
+  uint64_t int_vcc_milliamps = unavailable;
+
+  // Firmware telemetry counters
+  uint64_t l1_interrupts = unavailable;
+
+  struct rtos_task {
+    uint64_t context_starts;
+    uint64_t schedules;
+    uint64_t syscalls;
+    uint64_t dma_access;
+    uint64_t resource_acquisition;
+  };
+  uint32_t rtos_task_count = 0;
+  rtos_task rtos_tasks[max_rtos_tasks] = {};
+
+  uint32_t opcode_count = 0;
+  uint64_t opcodes[max_opcodes] = {};
+
+  uint32_t stream_buffer_count = 0;
+  uint64_t stream_buffer_tokens[max_stream_buffers] = {};
+
+  uint32_t aie_column_count = 0;
+  uint64_t aie_deep_sleep_count[max_aie_columns] = {};
+};
+
+/**
+ * sample() - Take a single telemetry snapshot of a device
+ *
+ * @param device
+ *  Device to sample
+ * @return
+ *  Snapshot of sensors and telemetry counters
+ */
+XRT_API_EXPORT
+snapshot
+sample(const xrt::device& device);
+
+/**
+ * delta() - Difference between two snapshots
+ *
+ * @param previous
+ *  Earlier snapshot of the device
+ * @param current
+ *  Later snapshot of the device
+ * @return
+ *  Snapshot with counters set to the increase since previous and
+ *  gauges set to the current value
+ *
+ * A counter that is unavailable in either snapshot, or that
+ * decreased because the device was reset, is reported as its
+ * current value.
+ */
+XRT_API_EXPORT
+snapshot
+delta(const snapshot& previous, const snapshot& current);
+
+/*!
+ * @class subscription
+ *
+ * @brief
+ * Periodic sampling of device telemetry
+ *
+ * @details
+ * A subscription samples the device at a fixed interval from a
+ * background thread and calls a user callback with the current
+ * snapshot and the delta to the previous snapshot.  For the first
+ * sample the delta is the sample itself.
+ *
+ * The callback is invoked from the sampling thread, a slow
+ * callback delays the next sample.  Exceptions thrown from the
+ * callback are reported as XRT messages and sampling continues.
+ *
+ * Sampling stops when the last copy of the subscription object is
+ * destructed or when stop() is called.  The subscription must not be
+ * stopped or destructed from within the callback.
+ */
+class subscription_impl;
+class subscription : public detail::pimpl<subscription_impl>
+{
+public:
+  /**
+   * callback_type - Type of function called for each sample
+   */
+  using callback_type = std::function<void(const snapshot& current, const snapshot& delta)>;
+
+  /**
+   * subscription() - Construct empty subscription object
+   */
+  subscription() = default;
+
+  /**
+   * subscription() - Start sampling a device
+   *
+   * @param device
+   *  Device to sample
+   * @param interval
+   *  Time between samples
+   * @param callback
+   *  Function called with each sample
+   */
+  XRT_API_EXPORT
+  subscription(const xrt::device& device, std::chrono::milliseconds interval, callback_type callback);
+
+  /**
+   * stop() - Stop sampling
+   *
+   * Blocks until an in progress callback has returned.  Must not be
+   * called from within the callback.
+   */
+  XRT_API_EXPORT
+  void
+  stop();
+};
+
+} // xrt::telemetry
+
+namespace xrt {
+
+/**
+ * telemetry_subscribe() - Start periodic sampling of device telemetry
+ *
+ * @param device
+ *  Device to sample
+ * @param interval
+ *  Time between samples
+ * @param callback
+ *  Function called with each sample
+ * @return
+ *  Subscription object, sampling stops when it is destructed
+ */
+inline telemetry::subscription
+telemetry_subscribe(const xrt::device& device, std::chrono::milliseconds interval,
+                    telemetry::subscription::callback_type callback)
+{
+  return {device, interval, std::move(callback)};
+}
+
+} // xrt
+
+#endif // __cplusplus
+
+#endif
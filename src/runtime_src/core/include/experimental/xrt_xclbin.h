@@ -975,6 +975,17 @@ public:
   XRT_API_EXPORT
   xclbin
   load(const std::string& name) const;
+
+  /**
+   * load() - Load xclbin with specified uuid from repository
+   *
+   * The xclbin is found through an index of the repository, which is
+   * persisted between processes when Runtime.xclbin_repo_index_dir
+   * is configured in xrt.ini.
+   */
+  XRT_API_EXPORT
+  xclbin
+  load(const uuid& xid) const;
 };
 
 } // namespace xrt
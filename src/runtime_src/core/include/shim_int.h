@@ -12,8 +12,10 @@
 #include "core/common/shim/hwctx_handle.h"
 #include "core/common/shim/hwqueue_handle.h"
 #include "core/common/shim/shared_handle.h"
+#include "core/common/shim/stream_handle.h"
 
 #include <string>
+#include <vector>
 
 namespace xrt {
 
@@ -68,6 +70,37 @@ alloc_bo(xclDeviceHandle, void* userptr, size_t size, unsigned int flags);
 std::unique_ptr<xrt_core::buffer_handle>
 import_bo(xclDeviceHandle, xrt_core::shared_handle::export_handle);
 
+// sync_bos() - sync multiple buffers in one direction
+void
+sync_bos(xclDeviceHandle, xrt_core::buffer_handle::direction,
+         const std::vector<xrt_core::buffer_handle::sync_range>&);
+
+// unmgd_segment - host buffer and device address of one segment of
+// a vectored unmanaged read or write
+struct unmgd_segment
+{
+  void* buffer;
+  size_t size;
+  uint64_t paddr;
+};
+
+// unmgd_preadv() - read scattered device memory segments
+void
+unmgd_preadv(xclDeviceHandle, const std::vector<unmgd_segment>&);
+
+// unmgd_pwritev() - write scattered device memory segments
+void
+unmgd_pwritev(xclDeviceHandle, const std::vector<unmgd_segment>&);
+
+// map_cu_registers() - map register space of CU for direct access
+volatile uint32_t*
+map_cu_registers(xclDeviceHandle, uint32_t ipidx, size_t& size);
+
+// create_stream() - Create a streaming queue
+std::unique_ptr<xrt_core::stream_handle>
+create_stream(xclDeviceHandle handle, xrt::stream::direction dir, uint64_t route, uint64_t flow,
+              const xrt::stream::config& cfg);
+
 // create_hw_context() -
 std::unique_ptr<xrt_core::hwctx_handle>
 create_hw_context(xclDeviceHandle handle,
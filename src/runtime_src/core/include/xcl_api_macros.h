@@ -226,6 +226,38 @@ std::lock_guard<std::mutex> socketlk{mtx};
     xclWriteAddrKernelCtrl_SET_PROTO_RESPONSE(); \
     xclWriteAddrKernelCtrl_RETURN();
 
+// Same as above, offers xclWriteAddrKernelCtrlBatch when offer is
+// true and sets accepted if the device process supports it
+#define xclWriteAddrKernelCtrl_OFFER_BATCH_RPC_CALL(func_name,address_space,address,data,size,kernelArgsInfo,pf_id,bar_id,offer,accepted) \
+    RPC_PROLOGUE(func_name); \
+    xclWriteAddrKernelCtrl_SET_PROTOMESSAGE(func_name,address_space,address,data,size,kernelArgsInfo,pf_id,bar_id); \
+    if (offer) \
+      c_msg.set_batch_offer(true); \
+    SERIALIZE_AND_SEND_MSG(func_name)\
+    xclWriteAddrKernelCtrl_SET_PROTO_RESPONSE(); \
+    if (r_msg.has_batch_ack() && r_msg.batch_ack()) \
+      accepted = true;
+
+//--------------------xclWriteAddrKernelCtrlBatch--------------------------------
+// writes is a sequence of (address, data) pairs
+#define xclWriteAddrKernelCtrlBatch_SET_PROTOMESSAGE(func_name,writes,pf_id,bar_id) \
+    for (const auto& w : writes) { \
+      auto op = c_msg.add_writes(); \
+      op->set_addr(w.first); \
+      op->set_data(w.second); \
+    } \
+    c_msg.set_pf_id(pf_id); \
+    c_msg.set_bar_id(bar_id);
+
+#define xclWriteAddrKernelCtrlBatch_SET_PROTO_RESPONSE(valid) \
+    valid = r_msg.valid();
+
+#define xclWriteAddrKernelCtrlBatch_RPC_CALL(func_name,writes,pf_id,bar_id,valid) \
+    RPC_PROLOGUE(func_name); \
+    xclWriteAddrKernelCtrlBatch_SET_PROTOMESSAGE(func_name,writes,pf_id,bar_id); \
+    SERIALIZE_AND_SEND_MSG(func_name)\
+    xclWriteAddrKernelCtrlBatch_SET_PROTO_RESPONSE(valid);
+
 //--------------------xclRegWrite--------------------------------
 //Generate call and info message
 #define xclRegWrite_SET_PROTOMESSAGE(func_name,baseaddress,offset,data,pf_id,bar_id) \
@@ -390,6 +422,62 @@ std::lock_guard<std::mutex> socketlk{mtx};
     xclCopyBufferDevice2Host_RETURN();
 
 
+//-----------xclCopyBuffer over shared memory data plane-----------------
+// Same as the calls above, the payload goes through the data plane
+// (xclemulation::shm_data_plane) once the device process accepted it.
+// The data plane is offered with the first call.
+#define xclCopyBuffer_OFFER_SHM(data_plane) \
+    if (data_plane && data_plane->offer()) { \
+      c_msg.set_shm_path(data_plane->path()); \
+      c_msg.set_shm_size(data_plane->size()); \
+    }
+
+#define xclCopyBuffer_ACCEPT_SHM(data_plane) \
+    if (data_plane && r_msg.has_shm_ack() && r_msg.shm_ack()) \
+      data_plane->accept();
+
+#define xclCopyBufferHost2Device_SHM_RPC_CALL(func_name,dev_handle,dest,src,size,seek,space,data_plane) \
+    RPC_PROLOGUE(func_name); \
+    if (data_plane && data_plane->usable(size)) { \
+      std::memcpy(data_plane->data(), src, size); \
+      c_msg.set_xcldevicehandle((char*)dev_handle); \
+      c_msg.set_dest(dest); \
+      c_msg.set_src(std::string()); \
+      c_msg.set_size(size); \
+      c_msg.set_seek(seek); \
+      c_msg.set_space(space); \
+      c_msg.set_shm(true); \
+    } \
+    else { \
+      xclCopyBufferHost2Device_SET_PROTOMESSAGE(func_name,dev_handle,dest,src,size,seek,space); \
+      xclCopyBuffer_OFFER_SHM(data_plane); \
+    } \
+    SERIALIZE_AND_SEND_MSG(func_name)\
+    xclCopyBuffer_ACCEPT_SHM(data_plane);
+
+#define xclCopyBufferDevice2Host_SHM_RPC_CALL(func_name,dev_handle,dest,src,size,skip,space,data_plane) \
+    RPC_PROLOGUE(func_name); \
+    bool use_shm = data_plane && data_plane->usable(size); \
+    if (use_shm) { \
+      c_msg.set_xcldevicehandle((char*)dev_handle); \
+      c_msg.set_dest(std::string()); \
+      c_msg.set_src(src); \
+      c_msg.set_size(size); \
+      c_msg.set_skip(skip); \
+      c_msg.set_space(space); \
+      c_msg.set_shm(true); \
+    } \
+    else { \
+      xclCopyBufferDevice2Host_SET_PROTOMESSAGE(func_name,dev_handle,dest,src,size,skip,space); \
+      xclCopyBuffer_OFFER_SHM(data_plane); \
+    } \
+    SERIALIZE_AND_SEND_MSG(func_name)\
+    if (use_shm) \
+      std::memcpy(dest, data_plane->data(), std::min<uint64_t>(r_msg.size(), data_plane->size())); \
+    else \
+      std::memcpy(dest, r_msg.dest().c_str(), r_msg.size()); \
+    xclCopyBuffer_ACCEPT_SHM(data_plane);
+
 //----------xclPerfMonReadCounters------------
 //----------xclPerfMonReadCounters------------
 #define xclPerfMonReadCounters_SET_PROTOMESSAGE() \
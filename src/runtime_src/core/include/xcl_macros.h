@@ -83,5 +83,6 @@
 #define xclRegWrite_n 51
 #define xclRegRead_n 52
 #define swemuDriverVersion_n 53
+#define xclWriteAddrKernelCtrlBatch_n 54
 
 #endif
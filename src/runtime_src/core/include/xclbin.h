@@ -185,6 +185,7 @@ extern "C" {
         AIE_PARTITION          = 32,
         IP_METADATA            = 33,
 	AIE_RESOURCES_BIN      = 34,
+        RUNTIME_INDEX          = 35,
     };
 
     enum MEM_TYPE {
@@ -225,6 +226,23 @@ extern "C" {
     };
     XCLBIN_STATIC_ASSERT(sizeof(struct axlf_section_header) == 40, "axlf_section_header structure no longer is 40 bytes in size");
 
+    /* A compressed section has AXLF_SECTION_COMPRESSED or'ed into its
+     * m_sectionKind, readers unaware of compression do not match the
+     * kind and ignore the section.  The section data starts with
+     * struct axlf_compressed_section followed by the compressed data. */
+    #define AXLF_SECTION_COMPRESSED 0x80000000
+
+    enum AXLF_COMPRESSION {
+        AXLF_COMPRESSION_ZLIB = 1           /* zlib (deflate) stream */
+    };
+
+    struct axlf_compressed_section {
+        uint32_t m_compression;             /* AXLF_COMPRESSION */
+        uint32_t m_reserved;                /* Reserved, must be 0 */
+        uint64_t m_uncompressedSize;        /* Size of the uncompressed section data */
+    };
+    XCLBIN_STATIC_ASSERT(sizeof(struct axlf_compressed_section) == 16, "axlf_compressed_section structure no longer is 16 bytes in size");
+
     struct axlf_header {
         uint64_t m_length;                  /* Total size of the xclbin file */
         uint64_t m_timeStamp;               /* Number of seconds since epoch when xclbin was created */
@@ -628,6 +646,70 @@ extern "C" {
     XCLBIN_STATIC_ASSERT(sizeof(struct aie_partition) == 184, "aie_partition structure no longer is 184 bytes in size");
     XCLBIN_STATIC_ASSERT(sizeof(struct aie_partition) % sizeof(uint64_t) == 0, "aie_partition structure needs to be 64-bit word aligned");
 
+    /**** RUNTIME_INDEX section ****/
+    // Kernel meta data pre-resolved from EMBEDDED_METADATA, consumed
+    // by the runtime instead of parsing the XML.  The index is valid
+    // only for the EMBEDDED_METADATA it was created from, identified
+    // by its size and FNV-1a 64 bit hash.  Strings are offsets of null
+    // terminated strings, arrays are array_offset, both relative to
+    // the start of the section.
+    #define RUNTIME_INDEX_SCHEMA_VERSION 1
+    #define RUNTIME_INDEX_NO_INDEX 0xffffffff
+
+    struct runtime_index_arg {
+        uint32_t name;                      // Argument name
+        uint32_t host_type;                 // Argument host type
+        uint32_t port;                      // Port name
+        uint32_t index;                     // Argument index (RUNTIME_INDEX_NO_INDEX if none)
+        uint64_t port_width;                // Port data width
+        uint64_t offset;                    // Argument offset
+        uint64_t size;                      // Argument size
+        uint64_t host_size;                 // Argument host size
+        uint8_t address_qualifier;          // 0 scalar, 1 global, 2 constant, 3 local, 4 stream
+        uint8_t padding[7];                 // Byte alignment
+    };
+    XCLBIN_STATIC_ASSERT(sizeof(struct runtime_index_arg) == 56, "runtime_index_arg structure no longer is 56 bytes in size");
+    XCLBIN_STATIC_ASSERT(sizeof(struct runtime_index_arg) % sizeof(uint64_t) == 0, "runtime_index_arg structure needs to be 64-bit word aligned");
+
+    struct runtime_index_string {
+        uint32_t id;                        // String table id
+        uint32_t value;                     // String table value
+    };
+    XCLBIN_STATIC_ASSERT(sizeof(struct runtime_index_string) == 8, "runtime_index_string structure no longer is 8 bytes in size");
+
+    struct runtime_index_kernel {
+        uint32_t name;                      // Kernel name
+        uint8_t type;                       // 0 none, 1 pl, 2 ps, 3 dpu
+        uint8_t mailbox;                    // 0 none, 1 in, 2 out, 3 inout
+        uint8_t sw_reset;                   // Software reset supported
+        uint8_t padding0[1];                // Byte alignment
+        uint64_t counted_auto_restart;      // Counted auto restart
+        uint64_t address_range;             // Address range of a compute unit
+        uint64_t functional;                // Functional type
+        uint64_t kernel_id;                 // DPU kernel id
+        uint64_t workgroup_size;            // OpenCL work group size
+        uint64_t compile_workgroup_size[3]; // OpenCL compile work group size
+        uint64_t max_workgroup_size[3];     // OpenCL max work group size
+        struct array_offset args;           // Array of arguments (runtime_index_arg)
+        struct array_offset string_table;   // Array of strings (runtime_index_string)
+        uint8_t reserved[16];               // Reserved
+    };
+    XCLBIN_STATIC_ASSERT(sizeof(struct runtime_index_kernel) == 128, "runtime_index_kernel structure no longer is 128 bytes in size");
+    XCLBIN_STATIC_ASSERT(sizeof(struct runtime_index_kernel) % sizeof(uint64_t) == 0, "runtime_index_kernel structure needs to be 64-bit word aligned");
+
+    struct runtime_index {
+        uint8_t schema_version;             // Schema version (RUNTIME_INDEX_SCHEMA_VERSION)
+        uint8_t padding0[7];                // Byte alignment
+        uint64_t metadata_size;             // Size of the indexed EMBEDDED_METADATA
+        uint64_t metadata_hash;             // FNV-1a hash of the indexed EMBEDDED_METADATA
+        uint32_t project_name;              // <project name="">
+        uint32_t fpga_device_name;          // <device fpgaDevice="">
+        struct array_offset kernels;        // Array of kernels (runtime_index_kernel)
+        uint8_t reserved[24];               // Reserved
+    };
+    XCLBIN_STATIC_ASSERT(sizeof(struct runtime_index) == 64, "runtime_index structure no longer is 64 bytes in size");
+    XCLBIN_STATIC_ASSERT(sizeof(struct runtime_index) % sizeof(uint64_t) == 0, "runtime_index structure needs to be 64-bit word aligned");
+
     /**** END : Xilinx internal section *****/
 
 # if defined(__cplusplus) && !defined(__KERNEL__) && !defined(_KERNEL_MODE) 
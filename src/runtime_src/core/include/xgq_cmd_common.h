@@ -113,6 +113,7 @@ enum xgq_cmd_opcode {
 	XGQ_CMD_OP_EXIT             	= 0x10f,
 	XGQ_CMD_OP_UNCFG_CU	        = 0x110,
 	XGQ_CMD_OP_QUERY_MEM	        = 0x111,
+	XGQ_CMD_OP_CU_INTR_MOD	        = 0x112,
 
 	/* Common command type */
 	XGQ_CMD_OP_BARRIER		= 0x200,
@@ -76,6 +76,25 @@ struct xgq_cmd_start_cuidx_kv {
 	uint32_t data[1]; // NOLINT
 };
 
+/**
+ * struct xgq_cmd_resp_cuidx: start CU by index command response
+ *
+ * @hdr:	CQ header, specific is set when the timestamps are valid
+ * @cu_start:	ERT clock counter when the CU was started
+ * @cu_done:	ERT clock counter when the CU was seen done
+ * @rcode:	POSIX error return code
+ *
+ * ERT only stamps the CU timestamps if it was configured with ts set in
+ * struct xgq_cmd_config_start. Otherwise the entry has no payload.
+ */
+struct xgq_cmd_resp_cuidx {
+	struct xgq_cmd_cq_hdr hdr;
+	uint32_t cu_start;
+	uint32_t cu_done;
+	uint32_t rcode;
+};
+XGQ_STATIC_ASSERT(sizeof(struct xgq_cmd_resp_cuidx) == 16, "xgq_cmd_resp_cuidx structure no longer is 16 bytes in size");
+
 /**
  * struct xgq_cmd_init_cuidx: init CU by index command
  *
@@ -121,6 +140,7 @@ struct xgq_cmd_init_cuidx_kv {
  * @i2h: ERT interrupt to host enable
  * @i2e: Host interrupt to ERT enable
  * @cui: CU interrupt to ERT enable
+ * @ts: stamp CU start and done in CU command completion
  *
  * This command would let ERT goes into configure state
  */
@@ -135,7 +155,8 @@ struct xgq_cmd_config_start {
 	uint32_t mode:2;
 	uint32_t echo:1;
 	uint32_t verbose:1;
-	uint32_t resvd:12;
+	uint32_t ts:1;
+	uint32_t resvd:11;
 
 	/* word 3 */
 	uint32_t num_scus:32;
@@ -183,6 +204,7 @@ struct xgq_cmd_data_integrity {
  * @i2e: Host interrupt to ERT enable
  * @cui: CU interrupt to ERT enable
  * @ob:  device supports out of band memory
+ * @ts:  CU command completions carry timestamps
  *
  * The response of start configure command.
  */
@@ -193,7 +215,8 @@ struct xgq_cmd_resp_config_start {
 	uint32_t i2e:1;
 	uint32_t cui:1;
 	uint32_t ob:1;
-	uint32_t rsvd:28;
+	uint32_t ts:1;
+	uint32_t rsvd:27;
 	uint32_t resvd;
 	uint32_t rcode;
 };
@@ -223,7 +246,11 @@ struct xgq_cmd_config_end {
  * @uuid: UUID of the XCLBIN of the CU
  *
  * Configure PL/PS CUs.
+ *
+ * If XGQ_IP_CTRL_ARG_SHADOW is set in @ip_ctrl of an ap_ctrl_chain CU, ERT
+ * only writes CU arguments that changed since the previous start.
  */
+#define XGQ_IP_CTRL_ARG_SHADOW	0x80
 struct xgq_cmd_config_cu {
 	struct xgq_cmd_sq_hdr hdr;
 
@@ -259,6 +286,31 @@ struct xgq_cmd_uncfg_cu {
 	uint32_t rsvd2:15;
 };
 
+/**
+ * struct xgq_cmd_cu_intr_mod: CU completion interrupt moderation command
+ *
+ * @cu_idx:	CU index
+ * @count:	completions per host interrupt, 0 or 1 for no moderation
+ * @cycles:	ERT clock cycles a completion may wait for its interrupt
+ *
+ * ERT interrupts host once count completions of the CU are pending or
+ * the oldest of them waited cycles. It interrupts right away when the
+ * CU has no command running, as host is waiting for that completion.
+ * Completions are visible in the CQ before the interrupt, host reaps all
+ * of them per interrupt.
+ */
+struct xgq_cmd_cu_intr_mod {
+	struct xgq_cmd_sq_hdr hdr;
+
+	/* word 2 */
+	uint32_t cu_idx:12;
+	uint32_t count:8;
+	uint32_t resvd:12;
+
+	/* word 3 */
+	uint32_t cycles;
+};
+
 /**
  * struct xgq_cmd_query_cu: query CU command
  *
@@ -10,7 +10,12 @@
 #include "xrt/detail/pimpl.h"
 
 #ifdef __cplusplus
+# include <array>
+# include <exception>
+# include <functional>
 # include <memory>
+# include <stdexcept>
+# include <vector>
 #endif
 
 /**
@@ -90,9 +95,42 @@ public:
       : detail::pimpl<async_handle_impl>(std::move(handle))
     {}
 
+    /**
+     * wait() - Wait for the asynchronous operation to complete
+     *
+     * Throws if the operation failed.
+     */
     XCL_DRIVER_DLLESPEC
     void
     wait();
+
+    /**
+     * ready() - Check if the asynchronous operation has completed
+     *
+     * @return
+     *  True if operation has completed and wait() will not block
+     */
+    XCL_DRIVER_DLLESPEC
+    bool
+    ready() const;
+
+    /**
+     * set_callback() - Set function to call when operation completes
+     *
+     * @param fcn
+     *  Function called once when the operation completes.  The
+     *  argument is the exception that failed the operation or
+     *  nullptr if the operation succeeded.
+     *
+     * The function is called from the thread that completes the
+     * operation, or immediately from the calling thread if the
+     * operation has already completed.  The function must not
+     * block.  Setting a callback replaces any previously set
+     * callback that has not yet been called.
+     */
+    XCL_DRIVER_DLLESPEC
+    void
+    set_callback(std::function<void(std::exception_ptr)> fcn);
   };
 
 public:
@@ -586,6 +624,86 @@ public:
     sync(dir, size(), 0);
   }
 
+  /**
+   * sync_many() - Synchronize content of many buffers with device side
+   *
+   * @param bos
+   *  Buffers to synchronize
+   * @param dir
+   *  To device or from device
+   *
+   * Sync entire buffer content of all buffers in specified direction.
+   * Where supported by the driver, buffers allocated on the same device
+   * are synced with one request, which amortizes the per sync overhead
+   * when transferring many small buffers.
+   */
+  XCL_DRIVER_DLLESPEC
+  static void
+  sync_many(const std::vector<bo>& bos, xclBOSyncDirection dir);
+
+  /**
+   * load_from_file() - Load buffer content from a file
+   *
+   * @param fd
+   *  Descriptor of file opened for reading
+   * @param offset
+   *  Offset in file of content to load
+   * @param size
+   *  Number of bytes to load to start of buffer
+   *
+   * The content is loaded and synced to device in chunks, with file
+   * reads of some chunks overlapping the sync of others.  For P2P
+   * buffers the file is read directly into device memory, with
+   * O_DIRECT where offset, size, and alignment permit.  The file
+   * position of fd is not changed.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  load_from_file(int fd, uint64_t offset, size_t size);
+
+  /**
+   * store_to_file() - Store buffer content to a file
+   *
+   * @param fd
+   *  Descriptor of file opened for writing
+   * @param offset
+   *  Offset in file at which to store content
+   * @param size
+   *  Number of bytes to store from start of buffer
+   *
+   * Counterpart of load_from_file(), the buffer is synced from
+   * device and written in chunks.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  store_to_file(int fd, uint64_t offset, size_t size);
+
+  /**
+   * sync_rect() - Synchronize a rectangular region with device side
+   *
+   * @param dir
+   *  To device or from device
+   * @param origin
+   *  Offset of region in bytes, rows, and slices
+   * @param region
+   *  Width of region in bytes, height in rows, and depth in slices
+   * @param row_pitch
+   *  Bytes between rows, 0 for rows of width region[0]
+   * @param slice_pitch
+   *  Bytes between slices, 0 for slices of row_pitch * region[1]
+   *
+   * Sync the rows of a 2D or 3D region of the buffer.  Contiguous
+   * rows are merged, and the remaining rows are synced with one
+   * request where supported by the driver, rather than with one
+   * request per row.  Bytes between rows are not transferred.
+   *
+   * Throws if the region is empty or extends past the buffer size.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  sync_rect(xclBOSyncDirection dir, const std::array<size_t, 3>& origin,
+            const std::array<size_t, 3>& region, size_t row_pitch, size_t slice_pitch);
+
   /**
    * map() - Map the host side buffer into application
    *
@@ -723,6 +841,29 @@ public:
     copy(src, src.size());
   }
 
+  /**
+   * fill() - Fill BO content with a repeated pattern
+   *
+   * @param pattern
+   *  Pointer to pattern to repeat
+   * @param pattern_size
+   *  Size of pattern in bytes
+   * @param sz
+   *  Size of data to fill
+   * @param offset
+   *  Offset into this buffer to fill from
+   *
+   * The device content is filled, no explicit sync is required.
+   * When the device supports buffer copy, only a small part of the
+   * range is transferred from host and the remainder is replicated
+   * on device.  A trailing partial pattern is truncated.
+   *
+   * Throws if pattern_size is 0 or sz + offset is out of bounds.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  fill(const void* pattern, size_t pattern_size, size_t sz, size_t offset=0);
+
   /**
    * ~bo() - Destructor for bo object
    */
@@ -750,6 +891,102 @@ private:
   std::shared_ptr<bo_impl> handle;
 };
 
+/*!
+ * @class bo_view
+ *
+ * @brief
+ * Non-owning view of a region of a buffer object
+ *
+ * @details
+ * A view refers to a parent buffer object, an offset, and a size.
+ * Unlike a sub-buffer, constructing a view neither allocates memory
+ * nor calls the driver, so views are suited for passing many
+ * transient regions of one buffer as kernel arguments.  The device
+ * address of a view is the parent address plus the offset.
+ *
+ * The parent buffer must outlive the view.
+ */
+class bo_view
+{
+public:
+  /**
+   * bo_view() - Constructor for view of region of buffer
+   *
+   * @param parent
+   *  Parent buffer object
+   * @param size
+   *  Size of the region in bytes
+   * @param offset
+   *  Offset of the region in the parent buffer
+   *
+   * Throws std::out_of_range if the region exceeds the parent.
+   */
+  bo_view(bo& parent, size_t size, size_t offset)
+    : m_parent(&parent)
+    , m_size(size)
+    , m_offset(offset)
+  {
+    if (offset > parent.size() || size > parent.size() - offset)
+      throw std::out_of_range("bo_view region exceeds parent buffer");
+  }
+
+  // The view cannot refer to a temporary
+  bo_view(bo&&, size_t, size_t) = delete;
+
+  /**
+   * get_parent() - Get the parent buffer object
+   */
+  bo&
+  get_parent() const
+  {
+    return *m_parent;
+  }
+
+  /**
+   * size() - Get the size of the region
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  /**
+   * offset() - Get the offset of the region in the parent
+   */
+  size_t
+  offset() const
+  {
+    return m_offset;
+  }
+
+  /**
+   * address() - Get the device address of the region
+   */
+  uint64_t
+  address() const
+  {
+    return m_parent->address() + m_offset;
+  }
+
+  /**
+   * sync() - Synchronize the region with device side buffer
+   *
+   * @param dir
+   *  To device or from device
+   */
+  void
+  sync(xclBOSyncDirection dir)
+  {
+    m_parent->sync(dir, m_size, m_offset);
+  }
+
+private:
+  bo* m_parent;
+  size_t m_size;
+  size_t m_offset;
+};
+
 } // namespace xrt
 
 /// @cond
@@ -370,6 +370,40 @@ public:
     return reinterpret_cast<SectionType>(get_xclbin_section(section, uuid).first);
   }
 
+  /**
+   * register_host_memory() - Register host memory with the device
+   *
+   * @param ptr
+   *  Start of host memory range
+   * @param size
+   *  Size of host memory range in bytes
+   *
+   * A buffer object constructed from a user pointer within a
+   * registered range shares the pinned pages of the range rather
+   * than pinning its memory again.  The range is pinned when the
+   * first such buffer is constructed for a memory group and flags.
+   * User pointers within a registered range need not be aligned.
+   *
+   * The memory must remain valid until it is unregistered and all
+   * buffers within it are destroyed.  Ranges must not overlap.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  register_host_memory(void* ptr, size_t size);
+
+  /**
+   * unregister_host_memory() - Unregister host memory range
+   *
+   * @param ptr
+   *  Address within a registered range
+   *
+   * Buffers constructed within the range remain valid and keep
+   * their pages pinned until destroyed.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  unregister_host_memory(void* ptr);
+
 public:
   /// @cond
   /**
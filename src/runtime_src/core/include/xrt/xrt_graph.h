@@ -28,6 +28,7 @@
 # include <chrono>
 # include <string>
 # include <cstdint>
+# include <vector>
 # include "xrt/xrt_hw_context.h"
 #endif
 
@@ -67,6 +68,40 @@ public:
    */
   enum class access_mode : uint8_t { exclusive = 0, primary = 1, shared = 2 };
 
+  /**
+   * @struct rtp_update - value for one RTP port in update_ports()
+   *
+   * @var port_name
+   *  Hierarchical name of RTP port
+   * @var value
+   *  Pointer to value to write
+   * @var bytes
+   *  Size of value in bytes
+   */
+  struct rtp_update
+  {
+    std::string port_name;
+    const void* value;
+    size_t bytes;
+  };
+
+  /**
+   * @struct rtp_read - destination for one RTP port in read_ports()
+   *
+   * @var port_name
+   *  Hierarchical name of RTP port
+   * @var value
+   *  Pointer to memory the value is read into
+   * @var bytes
+   *  Size of value in bytes
+   */
+  struct rtp_read
+  {
+    std::string port_name;
+    void* value;
+    size_t bytes;
+  };
+
   /**
    * graph() - Constructor from a device, xclbin and graph name
    *
@@ -227,6 +262,31 @@ public:
     read_port(port_name, &arg, sizeof(arg));
   }
 
+  /**
+   * update_ports() - Update several graph Run Time Parameters
+   *
+   * @param rtps
+   *  Ports and values to update
+   *
+   * All ports are resolved and validated before any port is
+   * updated, an invalid port fails the call without updating any
+   * RTP.  Synchronous and asynchronous RTPs can be mixed, ports are
+   * updated in order of the list.
+   */
+  void
+  update_ports(const std::vector<rtp_update>& rtps);
+
+  /**
+   * read_ports() - Read several graph Run Time Parameters
+   *
+   * @param rtps
+   *  Ports to read and memory to read the values into
+   *
+   * All ports are resolved and validated before any port is read.
+   */
+  void
+  read_ports(const std::vector<rtp_read>& rtps);
+
 private:
   std::shared_ptr<graph_impl> handle;
 
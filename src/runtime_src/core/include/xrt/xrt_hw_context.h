@@ -44,9 +44,13 @@ public:
    *  - dma_bandwidth          // gigabytes per second
    *  - latency                // ??
    *  - frame_execution_time   // ??
-   *  - priority               // ??
+   *  - priority               // 0: normal, 1: high, high overtakes normal on a CU
    *  - enable_isp_channel     // toggle isp communication
    *  - enable_acp_channel     // toggle acp communication
+   *  - cu_policy              // CU selection, 1: usage, 2: queue depth, 3: ewma
+   *  - weight                 // fair share of a CU shared with other contexts, 1-15
+   *  - queue_depth            // max outstanding commands, submission blocks at cap
+   *  - intr_moderation        // 0: device setting, 1: interrupt per CU completion
    *
    * Currently ignored for legacy platforms
    */
@@ -184,6 +188,26 @@ public:
   access_mode
   get_mode() const;
 
+  /**
+   * get_completion_fd() - File descriptor signaled on command completion
+   *
+   * @return
+   *  Pollable file descriptor owned by the device
+   *
+   * The descriptor becomes readable when a command submitted through
+   * this context may have completed.  It can be added to an epoll set
+   * together with descriptors of other contexts and devices, so one
+   * thread can wait on all of them.  After wakeup, the application must
+   * read the descriptor to reset it and check its runs for completion.
+   * The descriptor can be shared by contexts of the same device, and
+   * must not be closed by the application.
+   *
+   * Throws if the platform does not support completion descriptors.
+   */
+  XRT_API_EXPORT
+  int
+  get_completion_fd() const;
+
 public:
   /// @cond
   // Undocumented internal access to low level context handle
@@ -204,6 +204,21 @@ public:
   void
   start(const autostart& iterations);
 
+  /**
+   * start() - Start one execution of a run with completion notification
+   *
+   * @param done
+   *   Function called once when this execution completes
+   *
+   * The function is passed the final state of the run.  It is called
+   * from the thread that observes the completion and must not block.
+   * The notification is used to resume asynchronous waiters without
+   * a blocking ``wait()`` per run, see experimental/xrt_coro.h.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  start(std::function<void(ert_cmd_state)> done);
+
   /**
    * stop() - Stop kernel run object at next safe iteration
    *
@@ -486,11 +501,52 @@ public:
     set_arg_at_index(index, boh);
   }
 
+  /**
+   * set_arg() - Set a kernel global argument to a view of a buffer
+   *
+   * @param index
+   *  Index of kernel argument to set
+   * @param view
+   *  The region of a buffer to pass as argument
+   *
+   * The argument is set to the device address of the region without
+   * creating a sub-buffer.  As with buffer arguments, the parent
+   * buffer must remain valid while the kernel runs.
+   */
+  void
+  set_arg(int index, xrt::bo_view& view)
+  {
+    set_arg_at_index(index, view);
+  }
+
+  /**
+   * set_arg - xrt::bo_view variant for const lvalue
+   */
+  void
+  set_arg(int index, const xrt::bo_view& view)
+  {
+    set_arg_at_index(index, view);
+  }
+
+  /**
+   * set_arg - xrt::bo_view variant for rvalue
+   */
+  void
+  set_arg(int index, xrt::bo_view&& view)
+  {
+    set_arg_at_index(index, view);
+  }
+
   ///@cond
   /// Experimental in 2023.2
   XCL_DRIVER_DLLESPEC
   void
   submit_wait(const xrt::fence& fence);
+
+  // Submit waits on all fences as one dependency
+  XCL_DRIVER_DLLESPEC
+  void
+  submit_wait(const std::vector<xrt::fence>& fences);
   
   XCL_DRIVER_DLLESPEC
   void
@@ -651,6 +707,10 @@ private:
   void
   set_arg_at_index(int index, const xrt::bo&);
 
+  XCL_DRIVER_DLLESPEC
+  void
+  set_arg_at_index(int index, const xrt::bo_view&);
+
   XCL_DRIVER_DLLESPEC
   void
   update_arg_at_index(int index, const void* value, size_t bytes);
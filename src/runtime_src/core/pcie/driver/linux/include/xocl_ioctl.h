@@ -51,6 +51,7 @@
  * "xocl" driver allows user land to perform mmap on multiple entities distinguished by offset:
  * - page offset == 0: whole user BAR is mapped
  * - page offset > 0 and <= 128: one CU reg space is mapped, offset is used as CU index
+ * - page offset == XOCL_CU_STAT_PGOFF: read only CU status page is mapped, see xocl_cu_stat_page
  * - page offset >= (4G >> PAGE_SHIFT): one BO is mapped, offset should be obtained from drm_xocl_map_bo()
  *
  * *xocl* driver functionality is described in the following table. All the APIs are multi-threading and
@@ -97,6 +98,7 @@
  * 23   Allocate buffer on host memory         DRM_IOCTL_XOCL_ALLOC_CMA       drm_xocl_alloc_cma_info
  * 24   Free host memory buffer                DRM_IOCTL_XOCL_FREE_CMA        N/A
  * 25   Copy bo buffers                        DRM_IOCTL_XOCL_COPY_BO         drm_xocl_copy_bo
+ * 26   Submit commands of a submission ring   DRM_IOCTL_XOCL_SUBMIT_RING     drm_xocl_submit_ring
  * ==== ====================================== ============================== ==================================
  */
 
@@ -187,6 +189,12 @@ enum drm_xocl_ops {
 	DRM_XOCL_COPY_BO,
 	/* Set CU read-only range */
 	DRM_XOCL_SET_CU_READONLY_RANGE,
+	/* Sync multiple buffers in one direction by using DMA */
+	DRM_XOCL_SYNC_BO_BATCH,
+	/* Submit commands queued in a user-mapped submission ring */
+	DRM_XOCL_SUBMIT_RING,
+	/* Unprotected read or write of multiple device memory segments */
+	DRM_XOCL_UNMGD_VEC,
 
 	/* The following IOCTLs can only be called from linux kernel space
 	 * WARNING: INTERNAL USE ONLY. NOT FOR PUBLIC CONSUMPTION.
@@ -308,6 +316,26 @@ struct drm_xocl_sync_bo {
 	enum drm_xocl_sync_bo_dir dir;
 };
 
+#define XOCL_SYNC_BO_BATCH_MAX	1024
+
+/**
+ * struct drm_xocl_sync_bo_batch - Synchronize multiple buffers in the
+ * requested direction between device and host
+ * used with DRM_IOCTL_XOCL_SYNC_BO_BATCH ioctl
+ *
+ * @count:	Number of entries in @syncs, at most XOCL_SYNC_BO_BATCH_MAX
+ * @dir:	DRM_XOCL_SYNC_DIR_XXX, must match dir of every entry
+ * @syncs:	Pointer to array of struct drm_xocl_sync_bo
+ * @error_index: Output, index of the first entry that failed
+ */
+struct drm_xocl_sync_bo_batch {
+	uint32_t count;
+	enum drm_xocl_sync_bo_dir dir;
+	uint64_t syncs;
+	uint32_t error_index;
+	uint32_t pad;
+};
+
 /**
  * struct drm_xocl_sync_bo_cb - Synchronize the buffer in the requested direction
  * between device and host
@@ -467,6 +495,61 @@ enum drm_xocl_axlf_flags {
 	XOCL_AXLF_FORCE_PROGRAM		= (1 << 0)
 };
 
+/*
+ * Bits [11:8] of drm_xocl_create_hw_ctx qos select how KDS picks a CU
+ * among the CUs of a command's CU mask for this context.
+ */
+#define XOCL_QOS_CU_POLICY_SHIFT	8
+#define XOCL_QOS_CU_POLICY_MASK		(0xF << XOCL_QOS_CU_POLICY_SHIFT)
+
+enum drm_xocl_cu_policy {
+	XOCL_CU_POLICY_DEFAULT		= 0,	/* device setting, sysfs kds_cu_policy */
+	XOCL_CU_POLICY_USAGE		= 1,	/* least dispatched CU */
+	XOCL_CU_POLICY_QUEUE		= 2,	/* least outstanding commands */
+	XOCL_CU_POLICY_EWMA		= 3,	/* least expected wait */
+};
+
+/*
+ * Bits [13:12] of drm_xocl_create_hw_ctx qos select the priority class of
+ * commands of this context. High priority commands overtake normal ones
+ * waiting for the same CU.
+ */
+#define XOCL_QOS_PRIORITY_SHIFT		12
+#define XOCL_QOS_PRIORITY_MASK		(0x3 << XOCL_QOS_PRIORITY_SHIFT)
+
+enum drm_xocl_priority {
+	XOCL_PRIORITY_NORMAL		= 0,
+	XOCL_PRIORITY_HIGH		= 1,
+};
+
+/*
+ * Bits [15:14] of drm_xocl_create_hw_ctx qos select the completion
+ * interrupt moderation of the CUs this context opens. Moderation of a CU
+ * is off while any context that turned it off has the CU open.
+ */
+#define XOCL_QOS_INTR_MOD_SHIFT		14
+#define XOCL_QOS_INTR_MOD_MASK		(0x3 << XOCL_QOS_INTR_MOD_SHIFT)
+
+enum drm_xocl_intr_mod {
+	XOCL_INTR_MOD_DEFAULT		= 0,	/* device setting, sysfs kds_intr_coalesce */
+	XOCL_INTR_MOD_OFF		= 1,	/* interrupt per completion */
+};
+
+/*
+ * Bits [19:16] of drm_xocl_create_hw_ctx qos are the fair share weight of
+ * this context. Normal commands of contexts sharing a CU start in deficit
+ * round robin order, weight commands per turn. 0 means weight 1.
+ */
+#define XOCL_QOS_WEIGHT_SHIFT		16
+#define XOCL_QOS_WEIGHT_MASK		(0xF << XOCL_QOS_WEIGHT_SHIFT)
+
+/*
+ * Bits [31:20] of drm_xocl_create_hw_ctx qos cap the number of outstanding
+ * CU commands of this context. Submission blocks at the cap. 0 means no cap.
+ */
+#define XOCL_QOS_DEPTH_SHIFT		20
+#define XOCL_QOS_DEPTH_MASK		(0xFFFU << XOCL_QOS_DEPTH_SHIFT)
+
 /**
  * struct drm_xocl_axlf - load xclbin (AXLF) device image
  * used with DRM_IOCTL_XOCL_READ_AXLF ioctl
@@ -556,7 +639,7 @@ struct drm_xocl_ctx {
  * used with DRM_XOCL_CREATE_HW_CTX ioctl
  *
  * @axlf_ptr:      axlf pointer which need to download
- * @qos:           QOS information
+ * @qos:           QOS information, see XOCL_QOS_CU_POLICY_MASK
  * @hw_context:    Returns Context handle
  */
 struct drm_xocl_create_hw_ctx {
@@ -659,6 +742,41 @@ struct drm_xocl_pread_unmgd {
 	uint64_t data_ptr;
 };
 
+#define XOCL_UNMGD_VEC_MAX	4096
+
+/**
+ * struct drm_xocl_unmgd_seg - one segment of a vectored unprotected
+ * read or write of device memory
+ *
+ * @paddr:	Physical address of the segment in address space 0
+ * @size:	Length of the segment
+ * @data_ptr:	User's pointer to the data of the segment
+ */
+struct drm_xocl_unmgd_seg {
+	uint64_t paddr;
+	uint64_t size;
+	uint64_t data_ptr;
+};
+
+/**
+ * struct drm_xocl_unmgd_vec - unprotected read or write of multiple
+ * device memory segments
+ * used with DRM_IOCTL_XOCL_UNMGD_VEC ioctl
+ *
+ * @count:	Number of entries in @segs, at most XOCL_UNMGD_VEC_MAX
+ * @dir:	DRM_XOCL_SYNC_BO_TO_DEVICE to write device memory,
+ *		DRM_XOCL_SYNC_BO_FROM_DEVICE to read it
+ * @segs:	Pointer to array of struct drm_xocl_unmgd_seg
+ * @error_index: Output, index of the first segment that failed
+ */
+struct drm_xocl_unmgd_vec {
+	uint32_t count;
+	enum drm_xocl_sync_bo_dir dir;
+	uint64_t segs;
+	uint32_t error_index;
+	uint32_t pad;
+};
+
 
 struct drm_xocl_mm_stat {
 	bool 	is_used;
@@ -682,6 +800,76 @@ struct drm_xocl_usage_stat {
 	uint64_t h2c[8];
 	uint64_t c2h[8];
 	struct drm_xocl_mm_stat mm[8];
+	uint64_t dma_map_hits;
+	uint64_t dma_map_misses;
+};
+
+/*
+ * CU status page, mapped read only with mmap() at page offset
+ * XOCL_CU_STAT_PGOFF.  The driver refreshes the page about once per
+ * millisecond (one jiffy at most) while at least one mapping exists.
+ *
+ * The page is updated under a sequence counter.  A reader must load
+ * @seq, retry while it is odd, copy the fields it needs and then check
+ * that @seq is unchanged, otherwise the copy is torn and must be retried:
+ *
+ *	do {
+ *		seq = __atomic_load_n(&page->seq, __ATOMIC_ACQUIRE);
+ *		if (seq & 1)
+ *			continue;
+ *		memcpy(&copy, page->cu, sizeof(copy));
+ *		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+ *	} while (seq & 1 || seq != __atomic_load_n(&page->seq, __ATOMIC_RELAXED));
+ */
+#define XOCL_CU_STAT_PGOFF		129
+#define XOCL_CU_STAT_VERSION		1
+#define XOCL_CU_STAT_MAX_CUS		128
+
+/* xocl_cu_stat_entry.flags */
+#define XOCL_CU_STAT_FLAG_VALID		(1 << 0)
+#define XOCL_CU_STAT_FLAG_IDLE		(1 << 1)
+
+/**
+ * struct xocl_cu_stat_entry - status of one CU
+ *
+ * @usage:	   Number of commands dispatched to the CU
+ * @idle_ns:	   Accumulated idle time, including the current idle period
+ * @num_sq:	   Commands waiting in the submit queue of the CU
+ * @num_rq:	   Commands waiting to be started on the CU
+ * @num_pq:	   Commands running on the CU
+ * @slot_idx:	   Slot (hardware context) the CU belongs to
+ * @flags:	   XOCL_CU_STAT_FLAG_XXX
+ * @reserved:	   Reserved, zero
+ *
+ * Idle time is only accounted when CU statistics are enabled.
+ */
+struct xocl_cu_stat_entry {
+	uint64_t usage;
+	uint64_t idle_ns;
+	uint32_t num_sq;
+	uint32_t num_rq;
+	uint32_t num_pq;
+	uint16_t slot_idx;
+	uint16_t flags;
+	uint64_t reserved;
+};
+
+/**
+ * struct xocl_cu_stat_page - layout of the CU status page
+ *
+ * @seq:	   Sequence counter, odd while an update is in progress
+ * @version:	   XOCL_CU_STAT_VERSION
+ * @num_cus:	   Number of valid entries in @cu, indexed by CU index
+ * @timestamp_ns:  Monotonic time of the last update
+ * @cu:		   Per CU status
+ */
+struct xocl_cu_stat_page {
+	uint32_t seq;
+	uint32_t version;
+	uint32_t num_cus;
+	uint32_t reserved;
+	uint64_t timestamp_ns;
+	struct xocl_cu_stat_entry cu[XOCL_CU_STAT_MAX_CUS];
 };
 
 enum drm_xocl_execbuf_state {
@@ -723,6 +911,61 @@ struct drm_xocl_hw_ctx_execbuf {
 	uint32_t deps[MAX_DEPENT_CMD_BO];
 };
 
+/**
+ * struct xocl_submit_entry - One command in a submission ring
+ *
+ * @hw_ctx_id:      HW Context id, as in drm_xocl_hw_ctx_execbuf
+ * @exec_bo_handle: BO handle of command buffer formatted as ERT command
+ */
+struct xocl_submit_entry {
+	uint32_t hw_ctx_id;
+	uint32_t exec_bo_handle;
+};
+
+/**
+ * struct xocl_submit_ring - Layout of a submission ring
+ *
+ * The ring lives in an exec buf BO of the client, mapped by both the
+ * client and the driver. The client writes an entry at @tail and then
+ * advances @tail. DRM_IOCTL_XOCL_SUBMIT_RING (the doorbell) makes the
+ * driver submit entries up to @tail and advance @head. The doorbell is
+ * not needed while @draining is set; the driver checks @tail again
+ * after clearing @draining.
+ *
+ * A command that fails submission has its ERT state set to
+ * ERT_CMD_STATE_ERROR, so the client waiting for it is not stuck.
+ *
+ * @head:     Written by driver, next entry to submit
+ * @tail:     Written by client, next free entry
+ * @size:     Number of entries, a power of 2
+ * @draining: Written by driver, non zero while submitting entries
+ * @error:    Written by driver, first negative errno since ring creation
+ * @error_handle: exec_bo_handle of the entry that set @error
+ * @entries:  The ring
+ */
+struct xocl_submit_ring {
+	uint32_t head;
+	uint32_t tail;
+	uint32_t size;
+	uint32_t draining;
+	int32_t  error;
+	uint32_t error_handle;
+	uint32_t pad[2];
+	struct xocl_submit_entry entries[];
+};
+
+/**
+ * struct drm_xocl_submit_ring - Ring the doorbell of a submission ring
+ * used with DRM_IOCTL_XOCL_SUBMIT_RING ioctl
+ *
+ * @ring_bo_handle: Exec buf BO holding struct xocl_submit_ring
+ * @submitted:      Output, number of entries submitted by this call
+ */
+struct drm_xocl_submit_ring {
+	uint32_t ring_bo_handle;
+	uint32_t submitted;
+};
+
 /**
  * struct drm_xocl_execbuf_cb - Submit a command buffer for execution on a compute unit
  * used with DRM_IOCTL_XOCL_EXECBUF_CB ioctl with a callback (linux kernel only)
@@ -816,6 +1059,9 @@ struct drm_xocl_alloc_cma_info {
 #define	DRM_IOCTL_XOCL_FREE_CMA		XOCL_IOC(FREE_CMA)
 #define	DRM_IOCTL_XOCL_COPY_BO		XOCL_IOC_ARG(COPY_BO, copy_bo)
 #define	DRM_IOCTL_XOCL_SET_CU_READONLY_RANGE	XOCL_IOC_ARG(SET_CU_READONLY_RANGE, set_cu_range)
+#define	DRM_IOCTL_XOCL_SYNC_BO_BATCH	XOCL_IOC_ARG(SYNC_BO_BATCH, sync_bo_batch)
+#define	DRM_IOCTL_XOCL_SUBMIT_RING	XOCL_IOC_ARG(SUBMIT_RING, submit_ring)
+#define	DRM_IOCTL_XOCL_UNMGD_VEC	XOCL_IOC_ARG(UNMGD_VEC, unmgd_vec)
 
 #define	DRM_IOCTL_XOCL_KINFO_BO		XOCL_IOC_ARG(KINFO_BO, kinfo_bo)
 #define	DRM_IOCTL_XOCL_MAP_KERN_MEM	XOCL_IOC_ARG(MAP_KERN_MEM, map_kern_mem)
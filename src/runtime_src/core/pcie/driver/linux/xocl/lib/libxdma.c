@@ -2540,6 +2540,7 @@ static void irq_msix_user_teardown(struct xdma_dev *xdev)
 		u32 vector = xdev->entry[j].vector;
 #endif
 		dbg_init("user %d, releasing IRQ#%d\n", i, vector);
+		irq_set_affinity_hint(vector, NULL);
 		free_irq(vector, &xdev->user_irq[i]);
 	}
 }
@@ -4282,6 +4283,44 @@ int xdma_user_isr_disable(void *dev_hndl, unsigned int mask)
 	return 0;
 }
 
+int xdma_user_isr_affinity(void *dev_hndl, unsigned int mask, int cpu)
+{
+	struct xdma_dev *xdev = (struct xdma_dev *)dev_hndl;
+	int j = xdev->h2c_channel_max + xdev->c2h_channel_max;
+	int rv = 0;
+	int i;
+
+	if (!dev_hndl)
+		return -EINVAL;
+
+	if (debug_check_dev_hndl(__func__, xdev->pdev, dev_hndl) < 0)
+		return -EINVAL;
+
+	/* User interrupts share one vector without MSI-X */
+	if (!xdev->msix_enabled)
+		return -EOPNOTSUPP;
+
+	for (i = 0; i < xdev->user_max && mask; i++, j++) {
+		unsigned int bit = (1 << i);
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4,12,0)
+		u32 vector = pci_irq_vector(xdev->pdev, j);
+#else
+		u32 vector = xdev->entry[j].vector;
+#endif
+
+		if ((bit & mask) == 0)
+			continue;
+
+		mask &= ~bit;
+		rv = irq_set_affinity_hint(vector,
+				(cpu < 0) ? NULL : cpumask_of(cpu));
+		if (rv)
+			break;
+	}
+
+	return rv;
+}
+
 int xdma_get_userio(void *dev_hndl, void * __iomem *base_addr,
 	u64 *len, u32 *bar_idx)
 {
@@ -4366,6 +4405,7 @@ EXPORT_SYMBOL_GPL(xdma_get_bypassio);
 EXPORT_SYMBOL_GPL(xdma_get_userio);
 EXPORT_SYMBOL_GPL(xdma_user_isr_disable);
 EXPORT_SYMBOL_GPL(xdma_user_isr_enable);
+EXPORT_SYMBOL_GPL(xdma_user_isr_affinity);
 EXPORT_SYMBOL_GPL(xdma_user_isr_register);
 EXPORT_SYMBOL_GPL(xdma_device_restart);
 EXPORT_SYMBOL_GPL(xdma_device_online);
@@ -155,6 +155,14 @@ int xdma_user_isr_register(void *dev_hndl, unsigned int mask,
 int xdma_user_isr_enable(void *dev_hndl, unsigned int mask);
 int xdma_user_isr_disable(void *dev_hndl, unsigned int mask);
 
+/*
+ * xdma_user_isr_affinity - steer MSI-X vectors of user interrupts to a cpu
+ * @mask: bitmask of user interrupts (0 ~ 15)
+ * @cpu: target cpu, negative value to drop the affinity hint
+ * return -EOPNOTSUPP if user interrupts do not have their own vectors
+ */
+int xdma_user_isr_affinity(void *dev_hndl, unsigned int mask, int cpu);
+
 /*
  * xdma_xfer_submit - submit data for dma operation (for both read and write)
  *	This is a blocking call
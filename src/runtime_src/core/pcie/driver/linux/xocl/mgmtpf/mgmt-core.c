@@ -1697,6 +1697,12 @@ static struct pci_driver xclmgmt_driver = {
 	.remove = xclmgmt_remove,
 	/* resume, suspend are optional */
 	.err_handler = &xclmgmt_err_handler,
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 2, 0)
+	/* cards are independent, probe them concurrently */
+	.driver = {
+		.probe_type = PROBE_PREFER_ASYNCHRONOUS,
+	},
+#endif
 };
 
 static int (*drv_reg_funcs[])(void) __initdata = {
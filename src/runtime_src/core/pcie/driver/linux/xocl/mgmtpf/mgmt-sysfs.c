@@ -549,6 +549,15 @@ static ssize_t versal_show(struct device *dev,
 }
 static DEVICE_ATTR_RO(versal);
 
+static ssize_t subdev_probe_us_show(struct device *dev,
+	struct device_attribute *attr, char *buf)
+{
+	struct xclmgmt_dev *lro = dev_get_drvdata(dev);
+
+	return xocl_subdev_probe_times(lro, buf);
+}
+static DEVICE_ATTR_RO(subdev_probe_us);
+
 static struct attribute *mgmt_attrs[] = {
 	&dev_attr_instance.attr,
 	&dev_attr_error.attr,
@@ -580,6 +589,7 @@ static struct attribute *mgmt_attrs[] = {
 	&dev_attr_cache_xclbin.attr,
 	&dev_attr_config_xclbin_change.attr,
 	&dev_attr_versal.attr,
+	&dev_attr_subdev_probe_us.attr,
 	NULL,
 };
 
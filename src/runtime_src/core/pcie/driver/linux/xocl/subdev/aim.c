@@ -442,7 +442,23 @@ static const struct file_operations aim_fops = {
 	.unlocked_ioctl = aim_ioctl,
 };
 
+static ssize_t aim_dbg_name(struct platform_device *pdev, char *buf)
+{
+	return name_show(&pdev->dev, NULL, buf);
+}
+
+static ssize_t aim_dbg_values(struct platform_device *pdev, char *buf)
+{
+	return counters_show(&pdev->dev, NULL, buf);
+}
+
+static struct xocl_dbg_mon_funcs aim_ops = {
+	.name = aim_dbg_name,
+	.values = aim_dbg_values,
+};
+
 struct xocl_drv_private aim_priv = {
+	.ops = &aim_ops,
 	.fops = &aim_fops,
 	.dev = -1,
 };
@@ -434,7 +434,23 @@ static const struct file_operations am_fops = {
 	.unlocked_ioctl = am_ioctl,
 };
 
+static ssize_t am_dbg_name(struct platform_device *pdev, char *buf)
+{
+	return name_show(&pdev->dev, NULL, buf);
+}
+
+static ssize_t am_dbg_values(struct platform_device *pdev, char *buf)
+{
+	return counters_show(&pdev->dev, NULL, buf);
+}
+
+static struct xocl_dbg_mon_funcs am_ops = {
+	.name = am_dbg_name,
+	.values = am_dbg_values,
+};
+
 struct xocl_drv_private am_priv = {
+	.ops = &am_ops,
 	.fops = &am_fops,
 	.dev = -1,
 };
@@ -368,7 +368,23 @@ static const struct file_operations asm_fops = {
 	.unlocked_ioctl = asm_ioctl,
 };
 
+static ssize_t asm_dbg_name(struct platform_device *pdev, char *buf)
+{
+	return name_show(&pdev->dev, NULL, buf);
+}
+
+static ssize_t asm_dbg_values(struct platform_device *pdev, char *buf)
+{
+	return counters_show(&pdev->dev, NULL, buf);
+}
+
+static struct xocl_dbg_mon_funcs asm_ops = {
+	.name = asm_dbg_name,
+	.values = asm_dbg_values,
+};
+
 struct xocl_drv_private asm_priv = {
+	.ops = &asm_ops,
 	.fops = &asm_fops,
 	.dev = -1,
 };
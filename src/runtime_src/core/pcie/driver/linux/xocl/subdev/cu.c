@@ -133,6 +133,78 @@ busy_threshold_store(struct device *dev, struct device_attribute *attr,
 }
 static DEVICE_ATTR_RW(busy_threshold);
 
+static ssize_t
+adaptive_poll_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct platform_device *pdev = to_platform_device(dev);
+	struct xocl_cu *cu = platform_get_drvdata(pdev);
+
+	return sprintf(buf, "%d\n", cu->base.adaptive_poll);
+}
+
+static ssize_t
+adaptive_poll_store(struct device *dev, struct device_attribute *attr,
+		    const char *buf, size_t count)
+{
+	struct platform_device *pdev = to_platform_device(dev);
+	struct xocl_cu *cu = platform_get_drvdata(pdev);
+	u32 enable;
+
+	if (kstrtou32(buf, 10, &enable) == -EINVAL)
+		return -EINVAL;
+
+	xrt_cu_set_adaptive_poll(&cu->base, !!enable);
+
+	return count;
+}
+static DEVICE_ATTR_RW(adaptive_poll);
+
+static ssize_t
+prio_weight_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct platform_device *pdev = to_platform_device(dev);
+	struct xocl_cu *cu = platform_get_drvdata(pdev);
+
+	return sprintf(buf, "%d\n", cu->base.prio_weight);
+}
+
+static ssize_t
+prio_weight_store(struct device *dev, struct device_attribute *attr,
+		  const char *buf, size_t count)
+{
+	struct platform_device *pdev = to_platform_device(dev);
+	struct xocl_cu *cu = platform_get_drvdata(pdev);
+	u32 weight;
+
+	if (kstrtou32(buf, 10, &weight) == -EINVAL)
+		return -EINVAL;
+
+	cu->base.prio_weight = weight;
+
+	return count;
+}
+static DEVICE_ATTR_RW(prio_weight);
+
+static ssize_t
+poll_stat_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct platform_device *pdev = to_platform_device(dev);
+	struct xocl_cu *cu = platform_get_drvdata(pdev);
+
+	return show_cu_poll_stat(&cu->base, buf);
+}
+static DEVICE_ATTR_RO(poll_stat);
+
+static ssize_t
+lat_hist_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct platform_device *pdev = to_platform_device(dev);
+	struct xocl_cu *cu = platform_get_drvdata(pdev);
+
+	return show_cu_lat_hist(&cu->base, buf);
+}
+static DEVICE_ATTR_RO(lat_hist);
+
 static ssize_t
 name_show(struct device *dev, struct device_attribute *attr, char *buf)
 {
@@ -264,6 +336,10 @@ static struct attribute *cu_attrs[] = {
 	&dev_attr_cu_info.attr,
 	&dev_attr_poll_interval.attr,
 	&dev_attr_busy_threshold.attr,
+	&dev_attr_adaptive_poll.attr,
+	&dev_attr_prio_weight.attr,
+	&dev_attr_poll_stat.attr,
+	&dev_attr_lat_hist.attr,
 	&dev_attr_name.attr,
 	&dev_attr_base_paddr.attr,
 	&dev_attr_size.attr,
@@ -359,6 +435,14 @@ static int user_manage_irq(struct xrt_cu *xrt_cu, bool user_manage)
 	return 0;
 }
 
+static int steer_irq(struct xrt_cu *xrt_cu, int cpu)
+{
+	struct xocl_cu *xcu = (struct xocl_cu *)xrt_cu;
+	xdev_handle_t xdev = xocl_get_xdev(xcu->pdev);
+
+	return xocl_intc_cu_affinity(xdev, xrt_cu->info.intr_id, cpu);
+}
+
 static int configure_irq(struct xrt_cu *xrt_cu, bool enable)
 {
 	struct xocl_cu *xcu = (struct xocl_cu *)xrt_cu;
@@ -506,6 +590,7 @@ static int cu_probe(struct platform_device *pdev)
 
 	xcu->base.user_manage_irq = user_manage_irq;
 	xcu->base.configure_irq = configure_irq;
+	xcu->base.steer_irq = steer_irq;
 
 	return 0;
 
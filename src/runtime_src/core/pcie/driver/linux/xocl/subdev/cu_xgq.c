@@ -12,6 +12,9 @@
 #include "xocl_xgq.h"
 #include "../xgq_xocl_plat.h"
 
+/* Max number of XGQ entries written before ringing the doorbell */
+#define CU_XGQ_MAX_BATCH	16
+
 struct xrt_cu_xgq {
 	void __iomem		*vaddr;
 	int			 max_credits;
@@ -23,6 +26,8 @@ struct xrt_cu_xgq {
 	int			 xgq_client_id;
 	int			 cu_idx;
 	int			 cu_domain;
+	/* Entries written to XGQ but the doorbell is not rung yet */
+	int			 pending;
 };
 
 static int cu_xgq_alloc_credit(void *core)
@@ -45,10 +50,30 @@ static int cu_xgq_configure(void *core, u32 *data, size_t sz, int type)
 	return 0;
 }
 
+/*
+ * The doorbell is an MMIO write of the SQ producer pointer plus an
+ * interrupt to ERT. Commands started back to back are published together
+ * by cu_xgq_flush(), or once CU_XGQ_MAX_BATCH of them are pending.
+ */
 static void cu_xgq_start(void *core)
 {
 	struct xrt_cu_xgq *cu_xgq = core;
 
+	if (++cu_xgq->pending < CU_XGQ_MAX_BATCH)
+		return;
+
+	cu_xgq->pending = 0;
+	xocl_xgq_notify(cu_xgq->xgq);
+}
+
+static void cu_xgq_flush(void *core)
+{
+	struct xrt_cu_xgq *cu_xgq = core;
+
+	if (!cu_xgq->pending)
+		return;
+
+	cu_xgq->pending = 0;
 	xocl_xgq_notify(cu_xgq->xgq);
 }
 
@@ -121,6 +146,7 @@ static struct xcu_funcs xrt_cu_xgq_funcs = {
 	.peek_credit	= cu_xgq_peek_credit,
 	.configure	= cu_xgq_configure,
 	.start		= cu_xgq_start,
+	.flush		= cu_xgq_flush,
 	.check		= cu_xgq_check,
 	.enable_intr	= cu_xgq_enable_intr,
 	.disable_intr	= cu_xgq_disable_intr,
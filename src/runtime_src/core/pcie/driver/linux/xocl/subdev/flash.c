@@ -288,6 +288,11 @@ struct xocl_flash {
 	u8 qspi_curr_sector;
 	struct qspi_flash_vendor *vendor;
 	int qspi_curr_slave;
+
+	/* Per write() statistics of delta flashing. */
+	size_t pages_written;
+	size_t pages_skipped;
+	size_t erases_skipped;
 };
 
 static inline const char *reg2name(struct xocl_flash *flash, u32 *reg)
@@ -1092,12 +1097,73 @@ static int flash_kread(struct platform_device *pdev,
 	return flash_do_read(flash, buf, n, off);
 }
 
+/*
+ * NOR flash programming can only clear bits, so an erase is needed
+ * only if some bit is 0 on flash and 1 in new data.
+ */
+static bool flash_need_erase(const u8 *cur, const u8 *buf, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		if ((cur[i] & buf[i]) != buf[i])
+			return true;
+	}
+	return false;
+}
+
+/*
+ * Update len bytes @off with content of kbuf. Erase unit is skipped
+ * if flash already holds the content (delta flashing), and erase is
+ * skipped if content can be programmed on top of existing content.
+ * Programmed data is read back into cur and verified.
+ */
+static int flash_page_update(struct xocl_flash *flash,
+	u8 *kbuf, u8 *cur, loff_t off, size_t len)
+{
+	int ret;
+
+	ret = flash_buf_rdwr(flash, cur, off, len, false);
+	if (ret)
+		return ret;
+
+	if (memcmp(cur, kbuf, len) == 0) {
+		FLASH_DBG(flash, "Skipping 0x%lx bytes @0x%llx, no change",
+			len, off);
+		flash->pages_skipped++;
+		return 0;
+	}
+
+	if (flash_need_erase(cur, kbuf, len)) {
+		ret = flash_page_erase(flash, off, len);
+		if (ret)
+			return ret;
+	} else {
+		flash->erases_skipped++;
+	}
+
+	ret = flash_buf_rdwr(flash, kbuf, off, len, true);
+	if (ret)
+		return ret;
+	flash->pages_written++;
+
+	ret = flash_buf_rdwr(flash, cur, off, len, false);
+	if (ret)
+		return ret;
+	if (memcmp(cur, kbuf, len) != 0) {
+		FLASH_ERR(flash, "Verify failed for 0x%lx bytes @0x%llx",
+			len, off);
+		return -EIO;
+	}
+	return 0;
+}
+
 /*
  * Write a page. Perform read-modify-write as needed.
  * @cnt contains actual bytes copied from user on successful return.
  */
 static int flash_page_rmw(struct xocl_flash *flash,
-	const char __user *ubuf, u8 *kbuf, loff_t off, size_t *cnt)
+	const char __user *ubuf, u8 *kbuf, u8 *cur, loff_t off, size_t *cnt)
 {
 	loff_t thisoff = FLASH_PAGE_ALIGN(off);
 	size_t front = FLASH_PAGE_OFFSET(off);
@@ -1124,12 +1190,8 @@ static int flash_page_rmw(struct xocl_flash *flash,
 			return ret;
 	}
 
-	ret = flash_page_erase(flash, FLASH_PAGE_ALIGN(off), FLASH_PAGE_SIZE);
-	if (ret == 0) {
-		ret = flash_buf_rdwr(flash, kbuf, FLASH_PAGE_ALIGN(off),
-			FLASH_PAGE_SIZE, true);
-	}
-	return ret;
+	return flash_page_update(flash, kbuf, cur, FLASH_PAGE_ALIGN(off),
+		FLASH_PAGE_SIZE);
 }
 
 static inline size_t flash_get_page_io_size(loff_t off, size_t sz)
@@ -1153,7 +1215,7 @@ static inline size_t flash_get_page_io_size(loff_t off, size_t sz)
  * Needs to fallback to RMW, if not possible.
  */
 static int flash_page_wr(struct xocl_flash *flash,
-	const char __user *ubuf, u8 *kbuf, loff_t off, size_t *cnt)
+	const char __user *ubuf, u8 *kbuf, u8 *cur, loff_t off, size_t *cnt)
 {
 	int ret;
 	size_t thislen = flash_get_page_io_size(off, *cnt);
@@ -1166,10 +1228,7 @@ static int flash_page_wr(struct xocl_flash *flash,
 	if (copy_from_user(kbuf, ubuf, thislen) != 0)
 		return -EFAULT;
 
-	ret = flash_page_erase(flash, off, thislen);
-	if (ret == 0)
-		ret = flash_buf_rdwr(flash, kbuf, off, thislen, true);
-	return ret;
+	return flash_page_update(flash, kbuf, cur, off, thislen);
 }
 
 /*
@@ -1180,6 +1239,7 @@ flash_write(struct file *file, const char __user *buf, size_t n, loff_t *off)
 {
 	struct xocl_flash *flash = file->private_data;
 	u8 *page = NULL;
+	u8 *cur = NULL;
 	size_t cnt = 0;
 	int ret = 0;
 	struct qspi_flash_addr faddr;
@@ -1193,10 +1253,17 @@ flash_write(struct file *file, const char __user *buf, size_t n, loff_t *off)
 	n = min(n, flash->flash_size - (size_t)*off);
 
 	page = vmalloc(FLASH_HUGE_PAGE_SIZE);
-	if (page == NULL)
+	cur = vmalloc(FLASH_HUGE_PAGE_SIZE);
+	if (page == NULL || cur == NULL) {
+		vfree(page);
+		vfree(cur);
 		return -ENOMEM;
+	}
 
 	mutex_lock(&flash->io_lock);
+	flash->pages_written = 0;
+	flash->pages_skipped = 0;
+	flash->erases_skipped = 0;
 
 	flash_offset2faddr(*off, &faddr);
 	if (faddr.slave >= flash->num_slaves) {
@@ -1214,11 +1281,12 @@ flash_write(struct file *file, const char __user *buf, size_t n, loff_t *off)
 		size_t thislen = n - cnt;
 
 		/* Try write full page. */
-		ret = flash_page_wr(flash, thisbuf, page, thisoff, &thislen);
+		ret = flash_page_wr(flash, thisbuf, page, cur, thisoff,
+			&thislen);
 		if (ret) {
 			/* Fallback to RMW. */
 			if (ret == -EOPNOTSUPP) {
-				ret = flash_page_rmw(flash, thisbuf, page,
+				ret = flash_page_rmw(flash, thisbuf, page, cur,
 					thisoff, &thislen);
 			}
 			if (ret)
@@ -1227,8 +1295,12 @@ flash_write(struct file *file, const char __user *buf, size_t n, loff_t *off)
 		cnt += thislen;
 	}
 
+	FLASH_INFO(flash, "written %ld pages, skipped %ld unchanged pages and %ld erases",
+		flash->pages_written, flash->pages_skipped,
+		flash->erases_skipped);
 	mutex_unlock(&flash->io_lock);
 
+	vfree(cur);
 	vfree(page);
 	if (ret)
 		return ret;
@@ -27,7 +27,7 @@
 
 #define SYSFS_COUNT_PER_SENSOR          13
 #define SYSFS_NAME_LEN                  30
-#define HWMON_SDM_DEFAULT_EXPIRE_SECS   1
+#define HWMON_SDM_DEFAULT_EXPIRE_MS     1000
 
 #define SDR_BDINFO_ENTRY_LEN_MAX	256
 #define SDR_BDINFO_ENTRY_LEN		32
@@ -103,8 +103,11 @@ struct xocl_hwmon_sdm {
 	struct xocl_sensor_info sinfo[SDR_TYPE_MAX][SENSOR_IDS_MAX];
 
 	struct mutex            sdm_lock;
-	u64                     cache_expire_secs;
+	u64                     cache_expire_ms;
 	ktime_t                 cache_expires[SDR_TYPE_MAX][SENSOR_IDS_MAX];
+	/* Last instantaneous sensors response of each repo */
+	char                    *raw_data[SDR_TYPE_MAX];
+	ktime_t                 raw_expires[SDR_TYPE_MAX];
 };
 
 #define SDM_BUF_IDX_INCR(buf_index, len, buf_len) \
@@ -221,7 +224,7 @@ static void update_cache_expiry_time(struct xocl_hwmon_sdm *sdm, uint8_t repo_id
                                      uint8_t sensor_id)
 {
 	sdm->cache_expires[repo_id][sensor_id] = ktime_add(ktime_get_boottime(),
-                                      ktime_set(sdm->cache_expire_secs, 0));
+                                      ms_to_ktime(sdm->cache_expire_ms));
 }
 
 /*
@@ -356,6 +359,11 @@ abort:
 	return sz;
 }
 
+/*
+ * show_sensors_raw(): Reports all sensors of a repo from one GET_ALL_SENSOR_DATA
+ * request.  The response is kept for cache_expire_ms, reads within that period
+ * are served from it without another request to VMR or to the peer.
+ */
 static int show_sensors_raw(struct xocl_hwmon_sdm *sdm, char *buf,
                             uint8_t repo_id)
 {
@@ -365,14 +373,29 @@ static int show_sensors_raw(struct xocl_hwmon_sdm *sdm, char *buf,
 	char* sdr_buf;
 	int repo_type;
 	uint64_t data_args = 0;
+	ktime_t now = ktime_get_boottime();
+
+	if (repo_id >= SDR_TYPE_MAX)
+		return -EINVAL;
 
 	mutex_lock(&sdm->sdm_lock);
-	sdr_buf = vzalloc(resp_len);
+	if (!sdm->raw_data[repo_id])
+		sdm->raw_data[repo_id] = devm_kzalloc(&sdm->pdev->dev, resp_len, GFP_KERNEL);
+	sdr_buf = sdm->raw_data[repo_id];
 	if (!sdr_buf) {
 		ret = -ENOMEM;
 		goto done;
 	}
 
+	if (ktime_compare(now, sdm->raw_expires[repo_id]) < 0) {
+		ret = parse_inst_sensors_info(sdm, sdr_buf, buf, repo_id);
+		goto done;
+	}
+
+	/* Response is refreshed, it is not valid until parsed successfully */
+	sdm->raw_expires[repo_id] = 0;
+	memset(sdr_buf, 0, resp_len);
+
 	if (sdm->privileged) {
 		ret = xocl_xgq_collect_all_inst_sensors(xdev, sdr_buf, repo_id, RESP_LEN);
 	} else {
@@ -381,18 +404,19 @@ static int show_sensors_raw(struct xocl_hwmon_sdm *sdm, char *buf,
 		if (kind < 0) {
 			xocl_err(&sdm->pdev->dev, "received invalid xcl grp type: %d", kind);
 			ret = -EINVAL;
-			goto free_buf;
+			goto done;
 		}
 		data_args = 0x1 << MBREQ_INST_SENSORS_ENABLE_BIT;
 		ret = hwmon_sdm_read_from_peer(sdm->pdev, repo_type, kind, sdr_buf, resp_len, data_args);
 	}
-	if (!ret)
+	if (!ret) {
 		ret = parse_inst_sensors_info(sdm, sdr_buf, buf, repo_id);
-	else
+		if (ret >= 0)
+			sdm->raw_expires[repo_id] = ktime_add(now, ms_to_ktime(sdm->cache_expire_ms));
+	} else {
 		xocl_err(&sdm->pdev->dev, "inst_sensor request for repo_id is failed with err: %d", ret);
+	}
 
-free_buf:
-	vfree(sdr_buf);
 done:
 	mutex_unlock(&sdm->sdm_lock);
 	return ret;
@@ -437,6 +461,39 @@ temp_sensors_raw_show(struct device *dev, struct device_attribute *attr,
 }
 static DEVICE_ATTR_RO(temp_sensors_raw);
 
+/* Period in ms for which sensor values are served from cache, 0 disables caching */
+static ssize_t
+cache_expire_ms_show(struct device *dev, struct device_attribute *attr,
+                     char *buf)
+{
+	struct xocl_hwmon_sdm *sdm = dev_get_drvdata(dev);
+
+	return sprintf(buf, "%llu\n", sdm->cache_expire_ms);
+}
+
+static ssize_t
+cache_expire_ms_store(struct device *dev, struct device_attribute *attr,
+                      const char *buf, size_t count)
+{
+	struct xocl_hwmon_sdm *sdm = dev_get_drvdata(dev);
+	u64 val;
+	int i;
+
+	if (kstrtou64(buf, 10, &val))
+		return -EINVAL;
+
+	mutex_lock(&sdm->sdm_lock);
+	sdm->cache_expire_ms = val;
+	/* Values cached under the previous period are refreshed on next read */
+	for (i = 0; i < SDR_TYPE_MAX; i++)
+		sdm->raw_expires[i] = 0;
+	memset(sdm->cache_expires, 0, sizeof(sdm->cache_expires));
+	mutex_unlock(&sdm->sdm_lock);
+
+	return count;
+}
+static DEVICE_ATTR_RW(cache_expire_ms);
+
 static ssize_t show_hwmon_name(struct device *dev, struct device_attribute *da,
                                char *buf)
 {
@@ -1393,6 +1450,7 @@ static struct attribute *bdinfo_attrs[] = {
 	&dev_attr_voltage_sensors_raw.attr,
 	&dev_attr_current_sensors_raw.attr,
 	&dev_attr_temp_sensors_raw.attr,
+	&dev_attr_cache_expire_ms.attr,
 	NULL,
 };
 
@@ -1431,7 +1489,7 @@ static int hwmon_sdm_probe(struct platform_device *pdev)
 	platform_set_drvdata(pdev, sdm);
 	sdm->pdev = pdev;
 	sdm->supported = true;
-	sdm->cache_expire_secs = HWMON_SDM_DEFAULT_EXPIRE_SECS;
+	sdm->cache_expire_ms = HWMON_SDM_DEFAULT_EXPIRE_MS;
 	mutex_init(&sdm->sdm_lock);
 
 	if (XGQ_DEV(xdev) == NULL) {
@@ -39,6 +39,28 @@ static xuid_t uuid_null = NULL_UUID_LE;
 
 static struct key *icap_keys = NULL;
 
+/*
+ * Cache of xclbins whose signature has been verified, shared by all
+ * devices. Programming the same signed xclbin on many cards, or again
+ * after a reset, is checked against the cached copy instead of running
+ * pkcs7 verification every time.
+ */
+static int icap_sig_cache_max = 2;
+module_param(icap_sig_cache_max, int, (S_IRUGO|S_IWUSR));
+MODULE_PARM_DESC(icap_sig_cache_max,
+	"Max number of verified xclbins kept for signature reuse (0 = off)");
+
+struct icap_sig_cache_entry {
+	struct list_head	link;
+	xuid_t			uuid;
+	int			sec_level;
+	size_t			len;
+	void			*data;
+};
+static LIST_HEAD(icap_sig_cache);
+static DEFINE_MUTEX(icap_sig_cache_lock);
+static int icap_sig_cache_num;
+
 #define	ICAP_ERR(icap, fmt, arg...)	\
 	xocl_err(&(icap)->icap_pdev->dev, fmt "\n", ##arg)
 #define	ICAP_WARN(icap, fmt, arg...)	\
@@ -719,6 +741,34 @@ static int icap_xclbin_validate_clock_req(struct platform_device *pdev,
 	return err;
 }
 
+/* Maximum frequencies allowed by the xclbin in the PL slot */
+static int icap_ocl_get_freq_max(struct platform_device *pdev,
+	unsigned short *freqs, int num_freqs)
+{
+	struct icap *icap = platform_get_drvdata(pdev);
+	struct islot_info *islot = NULL;
+	uint32_t slot_id = 0;
+	int i, err = -ENOENT;
+
+	mutex_lock(&icap->icap_lock);
+	for (slot_id = 0; slot_id < MAX_SLOT_SUPPORT; slot_id++) {
+		islot = icap->slot_info[slot_id];
+		if (!islot || !islot->pl_slot)
+			continue;
+
+		for (i = 0; i < min(ICAP_MAX_NUM_CLOCKS, num_freqs); i++) {
+			freqs[i] = 0;
+			xclbin_get_ocl_frequency_max_min(icap, i, &freqs[i],
+							 NULL, slot_id);
+		}
+		err = 0;
+		break;
+	}
+	mutex_unlock(&icap->icap_lock);
+
+	return err;
+}
+
 static int icap_ocl_update_clock_freq_topology(struct platform_device *pdev,
 	struct xclmgmt_ioc_freqscaling *freq_obj)
 {
@@ -2291,6 +2341,83 @@ static int icap_calib_and_check(struct platform_device *pdev, uint32_t slot_id)
 	return icap_calibrate_mig(pdev, slot_id);
 }
 
+static void icap_sig_cache_free_entry(struct icap_sig_cache_entry *entry)
+{
+	list_del(&entry->link);
+	icap_sig_cache_num--;
+	vfree(entry->data);
+	kfree(entry);
+}
+
+/* Returns true if exactly this xclbin was verified before at sec_level */
+static bool icap_sig_cache_lookup(struct icap *icap, const struct axlf *xclbin,
+	size_t len)
+{
+	struct icap_sig_cache_entry *entry;
+	bool found = false;
+
+	mutex_lock(&icap_sig_cache_lock);
+	list_for_each_entry(entry, &icap_sig_cache, link) {
+		if (!uuid_equal(&entry->uuid, &xclbin->m_header.uuid) ||
+		    entry->sec_level != icap->sec_level || entry->len != len)
+			continue;
+		found = !memcmp(entry->data, xclbin, len);
+		if (found)
+			list_move(&entry->link, &icap_sig_cache);
+		break;
+	}
+	mutex_unlock(&icap_sig_cache_lock);
+
+	return found;
+}
+
+static void icap_sig_cache_insert(struct icap *icap, const struct axlf *xclbin,
+	size_t len)
+{
+	struct icap_sig_cache_entry *entry, *cur, *next;
+
+	if (icap_sig_cache_max <= 0)
+		return;
+
+	entry = kzalloc(sizeof(*entry), GFP_KERNEL);
+	if (!entry)
+		return;
+	entry->data = vmalloc(len);
+	if (!entry->data) {
+		kfree(entry);
+		return;
+	}
+	memcpy(entry->data, xclbin, len);
+	uuid_copy(&entry->uuid, &xclbin->m_header.uuid);
+	entry->sec_level = icap->sec_level;
+	entry->len = len;
+
+	mutex_lock(&icap_sig_cache_lock);
+	/* Replace older copy of same xclbin, drop least recently used */
+	list_for_each_entry_safe(cur, next, &icap_sig_cache, link) {
+		if (uuid_equal(&cur->uuid, &xclbin->m_header.uuid))
+			icap_sig_cache_free_entry(cur);
+	}
+	while (!list_empty(&icap_sig_cache) &&
+	    icap_sig_cache_num >= icap_sig_cache_max) {
+		icap_sig_cache_free_entry(list_last_entry(&icap_sig_cache,
+		    struct icap_sig_cache_entry, link));
+	}
+	list_add(&entry->link, &icap_sig_cache);
+	icap_sig_cache_num++;
+	mutex_unlock(&icap_sig_cache_lock);
+}
+
+static void icap_sig_cache_fini(void)
+{
+	struct icap_sig_cache_entry *entry, *next;
+
+	mutex_lock(&icap_sig_cache_lock);
+	list_for_each_entry_safe(entry, next, &icap_sig_cache, link)
+		icap_sig_cache_free_entry(entry);
+	mutex_unlock(&icap_sig_cache_lock);
+}
+
 static int icap_verify_signed_signature(struct icap *icap, struct axlf *xclbin)
 {
 	int err = 0;
@@ -2307,10 +2434,17 @@ static int icap_verify_signed_signature(struct icap *icap, struct axlf *xclbin)
 		xclbin->m_signature_length = -1;
 		xclbin->m_header.m_length = origlen;
 
+		if (icap_sig_cache_lookup(icap, xclbin, origlen + siglen)) {
+			ICAP_INFO(icap, "signature verified before, reusing");
+			goto out;
+		}
+
 		err = icap_verify_signature(icap, xclbin, origlen,
 			((char *)xclbin) + origlen, siglen);
 		if (err)
 			goto out;
+		if (icap->sec_level > ICAP_SEC_NONE)
+			icap_sig_cache_insert(icap, xclbin, origlen + siglen);
 	} else if (icap->sec_level > ICAP_SEC_NONE) {
 		ICAP_ERR(icap, "xclbin is not signed, rejected");
 		err = -EKEYREJECTED;
@@ -2530,13 +2664,12 @@ static bool check_mem_topo_and_data_retention(struct icap *icap,
 	size = hdr->m_sectionSize;
 	offset = hdr->m_sectionOffset;
 
-	/* Data retention feature ONLY works if the xclbins have identical mem_topology
-	 * or it will lead to hardware failure.
+	/* Data retention feature ONLY works if the xclbins have the same
+	 * device memory banks or it will lead to hardware failure.
 	 * If the incoming xclbin has different mem_topology, disable data retention feature
 	 */
-
-	if ((size != sizeof_sect(mem_topo, m_mem_data)) ||
-		    memcmp(((char *)xclbin)+offset, mem_topo, size)) {
+	if (!xocl_mem_topo_retainable(mem_topo,
+	    (struct mem_topology *)(((char *)xclbin) + offset), size)) {
 		ICAP_WARN(icap, "Data retention is enabled. "
 			"However, the incoming mem_topology doesn't match, "
 			"data in device memory can not be retained");
@@ -3382,6 +3515,7 @@ static struct xocl_icap_funcs icap_ops = {
 	.download_rp = icap_download_rp,
 	.post_download_rp = icap_post_download_rp,
 	.ocl_get_freq = icap_ocl_get_freqscaling,
+	.ocl_get_freq_max = icap_ocl_get_freq_max,
 	.ocl_update_clock_freq_topology = icap_ocl_update_clock_freq_topology,
 	.xclbin_validate_clock_req = icap_xclbin_validate_clock_req,
 	.ocl_lock_bitstream = icap_lock_bitstream,
@@ -4780,6 +4914,7 @@ err_reg_cdev:
 
 void xocl_fini_icap(void)
 {
+	icap_sig_cache_fini();
 	if (icap_keys)
 		key_put(icap_keys);
 	if (icap_drv_priv.fops && icap_drv_priv.dev != -1)
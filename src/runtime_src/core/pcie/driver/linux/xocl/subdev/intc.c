@@ -38,6 +38,10 @@
  *
  * If current interrupt mode is CU.
  * To determin the interrupt source, read ISR and check which bit is set.
+ *
+ * The shell does not give each CU its own vector, so a CU interrupt is
+ * steered per group of 32 CUs. The vector follows the CPU most of the
+ * group's CU threads run on, see intr_affinity().
  */
 
 #define INTR_NUM  4
@@ -85,6 +89,8 @@ struct intr_info {
 	int   intr_id;
 	void *arg;
 	bool  enabled;
+	/* CPU of the thread handling this source, -1 if unknown */
+	int   cpu;
 };
 
 #define ERT_CSR_TYPE 0
@@ -105,6 +111,8 @@ struct intr_metadata {
 	u32			 blanking;
 	u32			 ienabled;
 	u32			 disabled_state;
+	/* CPU the vector is steered to, -1 if not steered */
+	int			 cpu;
 };
 
 /* The details for intc sub-device.
@@ -118,6 +126,8 @@ struct xocl_intc {
 	void __iomem		*csr_base;
 	/* CU to host interrupt */
 	struct intr_metadata	 cu[INTR_NUM];
+	/* Serialize vector steering */
+	struct mutex		 steer_lock;
 };
 
 static ssize_t
@@ -333,15 +343,18 @@ static int request_intr(struct platform_device *pdev, int id,
 		info->intr_id = id;
 		info->arg = arg;
 		info->enabled = false;
+		info->cpu = -1;
 		data->info[intr_src] = info;
 		return 0;
 	}
 
 	/* unregister handler */
+	mutex_lock(&intc->steer_lock);
 	if (data->info[intr_src]) {
 		kfree(data->info[intr_src]);
 		data->info[intr_src] = NULL;
 	}
+	mutex_unlock(&intc->steer_lock);
 
 	return 0;
 }
@@ -404,6 +417,72 @@ static int config_intr(struct platform_device *pdev, int id, bool en, int mode)
 	return 0;
 }
 
+/* The CPU most enabled sources of the vector are handled on */
+static int intc_vote_cpu(struct intr_metadata *data)
+{
+	int best = -1;
+	int best_cnt = 0;
+	int cnt;
+	int i, j;
+
+	for (i = 0; i < INTR_SRCS; i++) {
+		if (!data->info[i] || !data->info[i]->enabled ||
+		    data->info[i]->cpu < 0)
+			continue;
+
+		cnt = 0;
+		for (j = i; j < INTR_SRCS; j++) {
+			if (data->info[j] && data->info[j]->enabled &&
+			    data->info[j]->cpu == data->info[i]->cpu)
+				cnt++;
+		}
+		if (cnt > best_cnt) {
+			best_cnt = cnt;
+			best = data->info[i]->cpu;
+		}
+	}
+
+	return best;
+}
+
+static int intr_affinity(struct platform_device *pdev, int id, int cpu, int mode)
+{
+	struct xocl_intc *intc = platform_get_drvdata(pdev);
+	xdev_handle_t xdev = xocl_get_xdev(pdev);
+	struct intr_metadata *data;
+	int data_idx = id / INTR_SRCS;
+	int intr_src = id % INTR_SRCS;
+	int ret = 0;
+	int best;
+
+	if (data_idx >= INTR_NUM) {
+		INTC_ERR(intc, "Interrupt ID out-of-range");
+		return -EINVAL;
+	}
+
+	data = (mode == ERT_INTR) ? &intc->ert[data_idx] : &intc->cu[data_idx];
+
+	mutex_lock(&intc->steer_lock);
+	if (!data->info[intr_src]) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	data->info[intr_src]->cpu = cpu;
+	best = intc_vote_cpu(data);
+	if (best < 0 || best == data->cpu)
+		goto out;
+
+	ret = xocl_user_interrupt_affinity(xdev, data->intr, best);
+	if (!ret) {
+		INTC_DBG(intc, "Steer irq %d to CPU %d", data->intr, best);
+		data->cpu = best;
+	}
+out:
+	mutex_unlock(&intc->steer_lock);
+	return ret;
+}
+
 static int csr_read32(struct platform_device *pdev, u32 off)
 {
 	struct xocl_intc *intc = platform_get_drvdata(pdev);
@@ -619,6 +698,7 @@ static int intc_probe(struct platform_device *pdev)
 	struct resource *res;
 	void *hdl;
 	int ret;
+	int i;
 
 	intc = xocl_drvinst_alloc(&pdev->dev, sizeof(*intc));
 	if (!intc)
@@ -626,6 +706,11 @@ static int intc_probe(struct platform_device *pdev)
 
 	platform_set_drvdata(pdev, intc);
 	intc->pdev = pdev;
+	mutex_init(&intc->steer_lock);
+	for (i = 0; i < INTR_NUM; i++) {
+		intc->ert[i].cpu = -1;
+		intc->cu[i].cpu = -1;
+	}
 
 	/* Use ERT to host interrupt by default */
 	intc->mode = ERT_INTR;
@@ -677,6 +762,7 @@ static struct xocl_intc_funcs intc_ops = {
 	.config_intr	= config_intr,
 	.sel_ert_intr	= sel_ert_intr,
 	.get_csr_base	= get_csr_base,
+	.intr_affinity	= intr_affinity,
 	/* Below two ops only used in ERT sub-device polling mode(for debug) */
 	.csr_read32	= csr_read32,
 	.csr_write32	= csr_write32,
@@ -273,7 +273,23 @@ static const struct file_operations lapc_fops = {
 	.unlocked_ioctl = lapc_ioctl,
 };
 
+static ssize_t lapc_dbg_name(struct platform_device *pdev, char *buf)
+{
+	return name_show(&pdev->dev, NULL, buf);
+}
+
+static ssize_t lapc_dbg_values(struct platform_device *pdev, char *buf)
+{
+	return status_show(&pdev->dev, NULL, buf);
+}
+
+static struct xocl_dbg_mon_funcs lapc_ops = {
+	.name = lapc_dbg_name,
+	.values = lapc_dbg_values,
+};
+
 struct xocl_drv_private lapc_priv = {
+	.ops = &lapc_ops,
 	.fops = &lapc_fops,
 	.dev = -1,
 };
@@ -16,6 +16,8 @@
 #include <linux/device.h>
 #include <linux/io.h>
 #include <linux/ioctl.h>
+#include <linux/kthread.h>
+#include <linux/wait.h>
 
 #include "../xocl_drv.h"
 #include "../userpf/common.h"
@@ -53,6 +55,17 @@ struct xocl_m2m {
 	int 			m2m_polling;
 	u32			m2m_intr_base;
 	u32			m2m_intr_num;
+
+	/* Queued copy commands, run one at a time by m2m_thread */
+	spinlock_t		m2m_q_lock;
+	struct list_head	m2m_q_list;
+	struct kds_command	*m2m_q_running;
+	wait_queue_head_t	m2m_q_wq;
+	wait_queue_head_t	m2m_q_done_wq;
+	struct task_struct	*m2m_thread;
+	u32			m2m_q_depth;
+	u64			m2m_q_submitted;
+	u64			m2m_q_completed;
 };
 
 static void  get_host_bank(struct platform_device *pdev, u64 *addr, u64 *size, u8 *used)
@@ -146,6 +159,126 @@ static int copy_bo(struct platform_device *pdev, uint64_t src_paddr,
 	return 0;
 }
 
+static void m2m_complete_cmd(struct xocl_m2m *m2m, struct kds_command *xcmd,
+	enum kds_status status)
+{
+	unsigned long flags;
+
+	xcmd->status = status;
+	xcmd->cb.notify_host(xcmd, status);
+	xcmd->cb.free(xcmd);
+
+	spin_lock_irqsave(&m2m->m2m_q_lock, flags);
+	m2m->m2m_q_running = NULL;
+	m2m->m2m_q_completed++;
+	spin_unlock_irqrestore(&m2m->m2m_q_lock, flags);
+	wake_up_all(&m2m->m2m_q_done_wq);
+}
+
+static struct kds_command *m2m_dequeue_cmd(struct xocl_m2m *m2m)
+{
+	struct kds_command *xcmd = NULL;
+	unsigned long flags;
+
+	spin_lock_irqsave(&m2m->m2m_q_lock, flags);
+	if (!list_empty(&m2m->m2m_q_list)) {
+		xcmd = list_first_entry(&m2m->m2m_q_list,
+		    struct kds_command, list);
+		list_del(&xcmd->list);
+		m2m->m2m_q_depth--;
+		m2m->m2m_q_running = xcmd;
+	}
+	spin_unlock_irqrestore(&m2m->m2m_q_lock, flags);
+
+	return xcmd;
+}
+
+/*
+ * The KDMA engine runs one copy at a time. Copy commands from KDS are
+ * queued and this thread feeds them to the engine in order, so that the
+ * submitter returns as soon as the command is queued and waits for
+ * completion through the normal execbuf wait.
+ */
+static int m2m_thread(void *data)
+{
+	struct xocl_m2m *m2m = data;
+	struct ert_start_copybo_cmd *ecmd;
+	struct kds_command *xcmd;
+	int ret;
+
+	while (!kthread_should_stop()) {
+		wait_event_interruptible(m2m->m2m_q_wq,
+		    !list_empty(&m2m->m2m_q_list) || kthread_should_stop());
+
+		while ((xcmd = m2m_dequeue_cmd(m2m)) != NULL) {
+			ecmd = (struct ert_start_copybo_cmd *)xcmd->execbuf;
+			ret = copy_bo(m2m->m2m_pdev,
+			    ert_copybo_src_offset(ecmd),
+			    ert_copybo_dst_offset(ecmd), 0, 0,
+			    ert_copybo_size(ecmd));
+			m2m_complete_cmd(m2m, xcmd,
+			    ret ? KDS_ERROR : KDS_COMPLETED);
+		}
+	}
+
+	/* Abort whatever is left behind */
+	while ((xcmd = m2m_dequeue_cmd(m2m)) != NULL)
+		m2m_complete_cmd(m2m, xcmd, KDS_ABORT);
+
+	return 0;
+}
+
+/*
+ * Queue a copy command. The execbuf of xcmd must be a copybo command
+ * carrying device physical addresses as offsets. On success, the command
+ * is owned by m2m and is notified and freed once the copy is done.
+ */
+static int queue_copy(struct platform_device *pdev, struct kds_command *xcmd)
+{
+	struct xocl_m2m *m2m = platform_get_drvdata(pdev);
+	unsigned long flags;
+
+	if (!m2m->m2m_thread)
+		return -ENODEV;
+
+	xcmd->status = KDS_QUEUED;
+	spin_lock_irqsave(&m2m->m2m_q_lock, flags);
+	list_add_tail(&xcmd->list, &m2m->m2m_q_list);
+	m2m->m2m_q_depth++;
+	m2m->m2m_q_submitted++;
+	spin_unlock_irqrestore(&m2m->m2m_q_lock, flags);
+	wake_up_interruptible(&m2m->m2m_q_wq);
+
+	return 0;
+}
+
+static bool m2m_client_busy(struct xocl_m2m *m2m, void *client)
+{
+	struct kds_command *xcmd;
+	unsigned long flags;
+	bool busy = false;
+
+	spin_lock_irqsave(&m2m->m2m_q_lock, flags);
+	if (m2m->m2m_q_running && m2m->m2m_q_running->client == client)
+		busy = true;
+	list_for_each_entry(xcmd, &m2m->m2m_q_list, list) {
+		if (busy)
+			break;
+		busy = (xcmd->client == client);
+	}
+	spin_unlock_irqrestore(&m2m->m2m_q_lock, flags);
+
+	return busy;
+}
+
+/* Wait for all queued copy commands of the client to complete */
+static void flush_client(struct platform_device *pdev, void *client)
+{
+	struct xocl_m2m *m2m = platform_get_drvdata(pdev);
+
+	wait_event(m2m->m2m_q_done_wq, !m2m_client_busy(m2m, client));
+}
+
 /* Interrupt handler for m2m subdev */
 static irqreturn_t m2m_irq_handler(int irq, void *arg)
 {
@@ -194,8 +327,26 @@ static ssize_t polling_show(struct device *dev,
 }
 static DEVICE_ATTR(polling, 0644, polling_show, polling_store);
 
+static ssize_t queue_show(struct device *dev,
+	struct device_attribute *attr, char *buf)
+{
+	struct xocl_m2m *m2m = platform_get_drvdata(to_platform_device(dev));
+	unsigned long flags;
+	ssize_t cnt = 0;
+
+	spin_lock_irqsave(&m2m->m2m_q_lock, flags);
+	cnt += sprintf(buf + cnt, "depth: %u\n", m2m->m2m_q_depth);
+	cnt += sprintf(buf + cnt, "submitted: %llu\n", m2m->m2m_q_submitted);
+	cnt += sprintf(buf + cnt, "completed: %llu\n", m2m->m2m_q_completed);
+	spin_unlock_irqrestore(&m2m->m2m_q_lock, flags);
+
+	return cnt;
+}
+static DEVICE_ATTR_RO(queue);
+
 static struct attribute *m2m_attrs[] = {
 	&dev_attr_polling.attr,
+	&dev_attr_queue.attr,
 	NULL,
 };
 
@@ -206,6 +357,8 @@ static struct attribute_group m2m_attr_group = {
 static struct xocl_m2m_funcs m2m_ops = {
 	.copy_bo = copy_bo,
 	.get_host_bank = get_host_bank,
+	.queue_copy = queue_copy,
+	.flush_client = flush_client,
 };
 
 struct xocl_drv_private m2m_priv = {
@@ -228,6 +381,11 @@ static int m2m_remove(struct platform_device *pdev)
 		xocl_err(&pdev->dev, "driver data is NULL");
 		return -EINVAL;
 	}
+
+	if (m2m->m2m_thread) {
+		(void) kthread_stop(m2m->m2m_thread);
+		m2m->m2m_thread = NULL;
+	}
 	
 	if (!m2m->m2m_polling)
 		xrt_cu_disable_intr(&m2m->m2m_cu, CU_INTR_DONE);
@@ -267,6 +425,10 @@ static int m2m_probe(struct platform_device *pdev)
 	platform_set_drvdata(pdev, m2m);
 	m2m->m2m_pdev = pdev;
 	mutex_init(&m2m->m2m_lock);
+	spin_lock_init(&m2m->m2m_q_lock);
+	INIT_LIST_HEAD(&m2m->m2m_q_list);
+	init_waitqueue_head(&m2m->m2m_q_wq);
+	init_waitqueue_head(&m2m->m2m_q_done_wq);
 
 	/* init m2m cu based on iores of kdma */
 	m2m->m2m_cu.dev = XDEV2DEV(xdev);
@@ -311,6 +473,14 @@ static int m2m_probe(struct platform_device *pdev)
 	else
 		xrt_cu_enable_intr(&m2m->m2m_cu, CU_INTR_DONE);
 
+	m2m->m2m_thread = kthread_run(m2m_thread, m2m, "xocl_m2m");
+	if (IS_ERR(m2m->m2m_thread)) {
+		ret = PTR_ERR(m2m->m2m_thread);
+		m2m->m2m_thread = NULL;
+		M2M_ERR(m2m, "create m2m thread failed: %d", ret);
+		goto failed;
+	}
+
 	M2M_INFO(m2m, "Initialized M2M subdev, polling (%d)", m2m->m2m_polling);
 	return 0;
 
@@ -422,6 +422,13 @@ char *mailbox_dbg_type_str[] = {
 /*
  * The mailbox softstate.
  */
+struct mailbox_req_stat {
+	u64			mrs_cnt;
+	u64			mrs_bytes;
+	u64			mrs_total_us;
+	u64			mrs_max_us;
+};
+
 struct mailbox {
 	struct platform_device	*mbx_pdev;
 	struct mailbox_reg	*mbx_regs;
@@ -463,6 +470,10 @@ struct mailbox {
 	size_t			mbx_recv_raw_bytes;
 	size_t			mbx_recv_req[XCL_MAILBOX_REQ_MAX];
 
+	/* send metrics of requests waiting for response */
+	spinlock_t		mbx_send_stat_lock;
+	struct mailbox_req_stat	mbx_send_stat[XCL_MAILBOX_REQ_MAX];
+
 	uint32_t		mbx_prot_ver;
 	uint64_t		mbx_ch_state;
 	uint64_t		mbx_ch_disable;
@@ -1862,6 +1873,37 @@ static ssize_t recv_metrics_show(struct device *dev,
 
 static DEVICE_ATTR_RO(recv_metrics);
 
+static ssize_t send_metrics_show(struct device *dev,
+	struct device_attribute *attr, char *buf)
+{
+	struct platform_device *pdev = to_platform_device(dev);
+	struct mailbox *mbx = platform_get_drvdata(pdev);
+	struct mailbox_req_stat stat;
+	unsigned long flags;
+	ssize_t count = 0;
+	int i;
+
+	for (i = 0; i < XCL_MAILBOX_REQ_MAX; i++) {
+		spin_lock_irqsave(&mbx->mbx_send_stat_lock, flags);
+		stat = mbx->mbx_send_stat[i];
+		spin_unlock_irqrestore(&mbx->mbx_send_stat_lock, flags);
+
+		if (!stat.mrs_cnt)
+			continue;
+		count += sprintf(buf + count,
+			"req[%d] sent: %llu, bytes: %llu, avg latency: %llu us, "
+			"max latency: %llu us, throughput: %llu KB/s\n", i,
+			stat.mrs_cnt, stat.mrs_bytes,
+			div64_u64(stat.mrs_total_us, stat.mrs_cnt),
+			stat.mrs_max_us, stat.mrs_total_us ?
+			div64_u64(stat.mrs_bytes * 1000, stat.mrs_total_us) : 0);
+	}
+
+	return count;
+}
+
+static DEVICE_ATTR_RO(send_metrics);
+
 static void mailbox_send_test_load_xclbin_kaddr(struct mailbox *mbx)
 {
 	struct xcl_mailbox_req *req = NULL;
@@ -2057,6 +2099,7 @@ static struct attribute *mailbox_attrs[] = {
 	&dev_attr_connection.attr,
 	&dev_attr_intr_mode.attr,
 	&dev_attr_recv_metrics.attr,
+	&dev_attr_send_metrics.attr,
 	&dev_attr_msg_send.attr,
 	NULL,
 };
@@ -2281,6 +2324,26 @@ static bool req_is_sw(struct platform_device *pdev, enum xcl_mailbox_request req
 /*
  * Msg will be sent to peer and reply will be received.
  */
+static void mailbox_update_send_stat(struct mailbox *mbx, int req,
+	size_t bytes, ktime_t start)
+{
+	u64 us = ktime_to_us(ktime_sub(ktime_get(), start));
+	struct mailbox_req_stat *stat;
+	unsigned long flags;
+
+	if (req < 0 || req >= XCL_MAILBOX_REQ_MAX)
+		return;
+
+	stat = &mbx->mbx_send_stat[req];
+	spin_lock_irqsave(&mbx->mbx_send_stat_lock, flags);
+	stat->mrs_cnt++;
+	stat->mrs_bytes += bytes;
+	stat->mrs_total_us += us;
+	if (us > stat->mrs_max_us)
+		stat->mrs_max_us = us;
+	spin_unlock_irqrestore(&mbx->mbx_send_stat_lock, flags);
+}
+
 static int _mailbox_request(struct platform_device *pdev, void *req, size_t reqlen,
 	void *resp, size_t *resplen, mailbox_msg_cb_t cb,
 	void *cbarg, u32 resp_ttl, u32 tx_ttl)
@@ -2289,6 +2352,7 @@ static int _mailbox_request(struct platform_device *pdev, void *req, size_t reql
 	struct mailbox *mbx = platform_get_drvdata(pdev);
 	struct mailbox_msg *reqmsg = NULL, *respmsg = NULL;
 	bool sw_ch = req_is_sw(pdev, ((struct xcl_mailbox_req *)req)->req);
+	ktime_t start = ktime_get();
 
 	if (req_is_disabled(pdev, ((struct xcl_mailbox_req *)req)->req)) {
 		MBX_WARN(mbx, "req %d is received on disabled channel, err: %d",
@@ -2353,8 +2417,12 @@ static int _mailbox_request(struct platform_device *pdev, void *req, size_t reql
 
 	wait_for_completion(&respmsg->mbm_complete);
 	rv = respmsg->mbm_error;
-	if (rv == 0)
+	if (rv == 0) {
 		*resplen = respmsg->mbm_len;
+		mailbox_update_send_stat(mbx,
+			((struct xcl_mailbox_req *)req)->req,
+			reqlen + *resplen, start);
+	}
 
 	free_msg(respmsg);
 
@@ -3139,6 +3207,7 @@ static int mailbox_probe(struct platform_device *pdev)
 	init_completion(&mbx->mbx_comp);
 	mutex_init(&mbx->mbx_lock);
 	spin_lock_init(&mbx->mbx_intr_lock);
+	spin_lock_init(&mbx->mbx_send_stat_lock);
 	INIT_LIST_HEAD(&mbx->mbx_req_list);
 
 	res = platform_get_resource(pdev, IORESOURCE_MEM, 0);
@@ -100,6 +100,18 @@ static irqreturn_t msix_xdma_isr(int irq, void *arg)
 	return ret;
 }
 
+static int user_intr_affinity(struct platform_device *pdev, u32 intr, int cpu)
+{
+	struct xocl_msix_xdma *msix_xdma;
+
+	msix_xdma = platform_get_drvdata(pdev);
+
+	if (intr >= msix_xdma->max_user_intr)
+		return -EINVAL;
+
+	return xdma_user_isr_affinity(msix_xdma->dev_handle, 1 << intr, cpu);
+}
+
 static int user_intr_unreg(struct platform_device *pdev, u32 intr)
 {
 	struct xocl_msix_xdma *msix_xdma;
@@ -201,6 +213,7 @@ static struct xocl_msix_funcs msix_xdma_ops = {
 	.user_intr_register = user_intr_register,
 	.user_intr_config = user_intr_config,
 	.user_intr_unreg = user_intr_unreg,
+	.user_intr_affinity = user_intr_affinity,
 };
 
 static int msix_xdma_probe(struct platform_device *pdev)
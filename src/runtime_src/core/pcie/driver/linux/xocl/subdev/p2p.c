@@ -107,6 +107,7 @@ struct remapper_regs {
 #define MAX_BANK_TAG_LEN	64
 
 #define P2P_DEFAULT_BAR_SIZE	(256UL << 20)
+#define P2P_DEFAULT_POOL_RESERVE	XOCL_P2P_CHUNK_SIZE
 
 struct p2p_bank_conf {
 	char bank_tag[MAX_BANK_TAG_LEN];
@@ -128,6 +129,13 @@ struct p2p {
 	ulong			p2p_mem_chunk_num;
 	void			*p2p_mem_chunks;
 	ulong			p2p_mem_chunk_ref;
+	/*
+	 * Unreferenced chunks stay mapped up to pool_reserve bytes so that
+	 * the next reserve skips devm_memremap_pages(). pool_chunks counts
+	 * the chunks currently kept that way.
+	 */
+	ulong			pool_reserve;
+	ulong			pool_chunks;
 
 	ulong			remap_slot_num;
 	ulong			remap_slot_sz;
@@ -157,6 +165,7 @@ struct p2p_mem_chunk {
 	resource_size_t		xpmc_pa;
 	resource_size_t		xpmc_size;
 	int			xpmc_ref;
+	bool			xpmc_pooled;
 
 	/* Used by kernel API */
 	struct percpu_ref	xpmc_percpu_ref;
@@ -279,9 +288,24 @@ static void p2p_mem_chunk_release(struct p2p *p2p, struct p2p_mem_chunk *chk)
 	if (chk->xpmc_ref == 0 && !chk->xpmc_va)
 		return;
 
-	if (chk->xpmc_ref > 0)
+	if (chk->xpmc_ref > 0) {
 		chk->xpmc_ref--;
+		/* Last user gone, keep the mapping if the pool has room */
+		if (chk->xpmc_ref == 0 && !chk->xpmc_pooled &&
+		    (p2p->pool_chunks + 1) * XOCL_P2P_CHUNK_SIZE <=
+		    p2p->pool_reserve) {
+			chk->xpmc_pooled = true;
+			p2p->pool_chunks++;
+			p2p_info(p2p, "pooled P2P mem chunk [0x%llx, 0x%llx)",
+				chk->xpmc_pa, chk->xpmc_pa + chk->xpmc_size);
+			return;
+		}
+	}
 	if (chk->xpmc_ref == 0) {
+		if (chk->xpmc_pooled) {
+			chk->xpmc_pooled = false;
+			p2p->pool_chunks--;
+		}
 		for (addr = chk->xpmc_va; addr < chk->xpmc_va + chk->xpmc_size;
 		    addr += PAGE_SIZE) {
 			page = virt_to_page(addr);
@@ -331,6 +355,11 @@ static int p2p_mem_chunk_reserve(struct p2p *p2p, struct p2p_mem_chunk *chk)
 	if (chk->xpmc_va) {
 		p2p_info(p2p, "reuse P2P mem chunk [0x%llx, 0x%llx)",
 			chk->xpmc_pa, chk->xpmc_pa + chk->xpmc_size);
+		if (chk->xpmc_pooled) {
+			chk->xpmc_pooled = false;
+			p2p->pool_chunks--;
+		}
+		chk->xpmc_ref = 1;
 		goto done;
 	}
 
@@ -535,6 +564,18 @@ static void p2p_read_addr_mgmtpf(struct p2p *p2p)
 }
 
 
+/* Unmap all pooled chunks, caller holds p2p_lock */
+static void p2p_mem_pool_drain(struct p2p *p2p)
+{
+	struct p2p_mem_chunk *chunks = p2p->p2p_mem_chunks;
+	int i;
+
+	for (i = 0; chunks && i < p2p->p2p_mem_chunk_num; i++) {
+		if (chunks[i].xpmc_pooled)
+			p2p_mem_chunk_release(p2p, &chunks[i]);
+	}
+}
+
 static int p2p_mem_fini(struct p2p *p2p, bool free_trunk)
 {
 	struct p2p_mem_chunk *chunks;
@@ -552,6 +593,7 @@ static int p2p_mem_fini(struct p2p *p2p, bool free_trunk)
 			p2p_mem_chunk_release(p2p, &chunks[i]);
 		}
 	}
+	p2p_mem_pool_drain(p2p);
 	p2p->p2p_mem_chunk_ref = 0;
 
 	p2p_ulpmap_release(p2p);
@@ -1433,10 +1475,51 @@ static ssize_t p2p_enable_show(struct device *dev,
 
 static DEVICE_ATTR_RW(p2p_enable);
 
+/*
+ * Bytes of unreferenced P2P chunks kept mapped for reuse by the next
+ * P2P BO. Lowering the value unmaps all currently pooled chunks.
+ */
+static ssize_t pool_reserve_store(struct device *dev,
+	struct device_attribute *da, const char *buf, size_t count)
+{
+	struct p2p *p2p = platform_get_drvdata(to_platform_device(dev));
+	ulong val = 0;
+
+	if (kstrtoul(buf, 0, &val))
+		return -EINVAL;
+
+	mutex_lock(&p2p->p2p_lock);
+	if (val < p2p->pool_reserve) {
+		p2p->pool_reserve = 0;
+		p2p_mem_pool_drain(p2p);
+	}
+	p2p->pool_reserve = val;
+	mutex_unlock(&p2p->p2p_lock);
+
+	return count;
+}
+
+static ssize_t pool_reserve_show(struct device *dev,
+	struct device_attribute *attr, char *buf)
+{
+	struct p2p *p2p = platform_get_drvdata(to_platform_device(dev));
+	ssize_t count;
+
+	mutex_lock(&p2p->p2p_lock);
+	count = sprintf(buf, "%ld %ld\n", p2p->pool_reserve,
+		p2p->pool_chunks * XOCL_P2P_CHUNK_SIZE);
+	mutex_unlock(&p2p->p2p_lock);
+
+	return count;
+}
+
+static DEVICE_ATTR_RW(pool_reserve);
+
 static struct attribute *p2p_attrs[] = {
 	&dev_attr_config.attr,
 	&dev_attr_p2p_enable.attr,
 	&dev_attr_bar_map.attr,
+	&dev_attr_pool_reserve.attr,
 	NULL,
 };
 
@@ -1521,6 +1604,7 @@ static int p2p_probe(struct platform_device *pdev)
 	platform_set_drvdata(pdev, p2p);
 	p2p->pdev = pdev;
 	mutex_init(&p2p->p2p_lock);
+	p2p->pool_reserve = P2P_DEFAULT_POOL_RESERVE;
 
 	p2p->priv_data = XOCL_GET_SUBDEV_PRIV(&pdev->dev);
 	for (res = platform_get_resource(pdev, IORESOURCE_MEM, i); res;
@@ -29,6 +29,7 @@
 #include "../lib/libqdma/QDMA/linux-kernel/driver/libqdma/libqdma_export.h"
 #include "../lib/libqdma/QDMA/linux-kernel/driver/libqdma/qdma_ul_ext.h"
 #include "qdma_ioctl.h"
+#include "../xocl_trace.h"
 
 #define XOCL_FILE_PAGE_OFFSET   0x100000
 #ifndef VM_RESERVED
@@ -370,7 +371,9 @@ static ssize_t qdma_migrate_bo(struct platform_device *pdev,
 	req->sgl = (struct qdma_sw_sg *)(req + 1);
 	fill_qdma_request_sgl(req, sgt);
 
+	trace_xocl_dma_submit(channel, write, paddr, len);
 	ret = qdma_request_submit(qdma->dma_hndl, chan->queue, req);
+	trace_xocl_dma_complete(channel, write, paddr, ret);
 
 	if (ret >= 0) {
 		chan->total_trans_bytes += ret;
@@ -254,7 +254,23 @@ static const struct file_operations spc_fops = {
 	.unlocked_ioctl = spc_ioctl,
 };
 
+static ssize_t spc_dbg_name(struct platform_device *pdev, char *buf)
+{
+	return name_show(&pdev->dev, NULL, buf);
+}
+
+static ssize_t spc_dbg_values(struct platform_device *pdev, char *buf)
+{
+	return status_show(&pdev->dev, NULL, buf);
+}
+
+static struct xocl_dbg_mon_funcs spc_ops = {
+	.name = spc_dbg_name,
+	.values = spc_dbg_values,
+};
+
 struct xocl_drv_private spc_priv = {
+	.ops = &spc_ops,
 	.fops = &spc_fops,
 	.dev = -1,
 };
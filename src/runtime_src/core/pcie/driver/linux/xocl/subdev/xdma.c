@@ -22,6 +22,7 @@
 #include "../xocl_drv.h"
 #include "../xocl_drm.h"
 #include "../lib/libxdma_api.h"
+#include "../xocl_trace.h"
 
 #ifndef VM_RESERVED
 #define VM_RESERVED (VM_DONTEXPAND | VM_DONTDUMP)
@@ -72,8 +73,10 @@ static ssize_t xdma_migrate_bo(struct platform_device *pdev,
 	xdma = platform_get_drvdata(pdev);
 	xocl_dbg(&pdev->dev, "TID %d, Channel:%d, Offset: 0x%llx, Dir: %d",
 		pid, channel, paddr, dir);
+	trace_xocl_dma_submit(channel, dir, paddr, len);
 	ret = xdma_xfer_fastpath(xdma->dma_handle, channel, dir,
 		paddr, sgt, false, 10000);
+	trace_xocl_dma_complete(channel, dir, paddr, ret);
 	if (ret >= 0) {
 		xdma->channel_usage[dir][channel] += ret;
 		return ret;
@@ -93,6 +96,26 @@ static ssize_t xdma_migrate_bo(struct platform_device *pdev,
 	return ret;
 }
 
+/* Same as xdma_migrate_bo() but sgt is already DMA mapped by the caller */
+static ssize_t xdma_migrate_mapped_bo(struct platform_device *pdev,
+	struct sg_table *sgt, u32 dir, u64 paddr, u32 channel, u64 len)
+{
+	struct xocl_xdma *xdma;
+	ssize_t ret;
+
+	xdma = platform_get_drvdata(pdev);
+	trace_xocl_dma_submit(channel, dir, paddr, len);
+	ret = xdma_xfer_fastpath(xdma->dma_handle, channel, dir,
+		paddr, sgt, true, 10000);
+	trace_xocl_dma_complete(channel, dir, paddr, ret);
+	if (ret >= 0)
+		xdma->channel_usage[dir][channel] += ret;
+	else
+		xocl_err(&pdev->dev, "DMA failed, ep addr %llx", paddr);
+
+	return ret;
+}
+
 struct xdma_async_context {
 	void (*callback_fn)(unsigned long data, int err);
 	unsigned long callback_data;
@@ -223,6 +246,34 @@ out:
 	return channel;
 }
 
+/*
+ * Same as acquire_channel() but never sleeps. Returns -EBUSY when all
+ * channels in this direction are taken.
+ */
+static int try_acquire_channel(struct platform_device *pdev, u32 dir)
+{
+	struct xocl_xdma *xdma;
+	int channel = 0;
+	int result = 0;
+
+	xdma = platform_get_drvdata(pdev);
+	if (down_trylock(&xdma->channel_sem[dir]))
+		return -EBUSY;
+
+	for (channel = 0; channel < xdma->channel; channel++) {
+		result = test_and_clear_bit(channel,
+			&xdma->channel_bitmap[dir]);
+		if (result)
+			break;
+	}
+	if (!result) {
+		up(&xdma->channel_sem[dir]);
+		channel = -EIO;
+	}
+
+	return channel;
+}
+
 static void release_channel(struct platform_device *pdev, u32 dir, u32 channel)
 {
 	struct xocl_xdma *xdma;
@@ -304,6 +355,18 @@ static irqreturn_t xdma_isr(int irq, void *arg)
 	return ret;
 }
 
+static int user_intr_affinity(struct platform_device *pdev, u32 intr, int cpu)
+{
+	struct xocl_xdma *xdma;
+
+	xdma = platform_get_drvdata(pdev);
+
+	if (intr >= xdma->max_user_intr)
+		return -EINVAL;
+
+	return xdma_user_isr_affinity(xdma->dma_handle, 1 << intr, cpu);
+}
+
 static int user_intr_unreg(struct platform_device *pdev, u32 intr)
 {
 	struct xocl_xdma *xdma;
@@ -403,13 +466,16 @@ failed:
 static struct xocl_dma_funcs xdma_ops = {
 	.migrate_bo = xdma_migrate_bo,
 	.async_migrate_bo = xdma_async_migrate_bo,
+	.migrate_mapped_bo = xdma_migrate_mapped_bo,
 	.ac_chan = acquire_channel,
+	.try_ac_chan = try_acquire_channel,
 	.rel_chan = release_channel,
 	.get_chan_count = get_channel_count,
 	.get_chan_stat = get_channel_stat,
 	.user_intr_register = user_intr_register,
 	.user_intr_config = user_intr_config,
 	.user_intr_unreg = user_intr_unreg,
+	.user_intr_affinity = user_intr_affinity,
 };
 
 static ssize_t channel_stat_raw_show(struct device *dev,
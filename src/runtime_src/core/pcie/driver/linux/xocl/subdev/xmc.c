@@ -1520,6 +1520,37 @@ static ssize_t xmc_power_show(struct device *dev,
 }
 static DEVICE_ATTR_RO(xmc_power);
 
+/*
+ * Sensors sampled by power profiling in one read, one value per line.
+ * The order matches the columns of the power profile.
+ */
+static ssize_t xmc_power_sensors_show(struct device *dev,
+	struct device_attribute *da, char *buf)
+{
+	static const enum data_kind kinds[] = {
+		CUR_12V_AUX, VOL_12V_AUX, CUR_12V_PEX, VOL_12V_PEX,
+		CUR_VCC_INT, VOL_VCC_INT, CUR_3V3_PEX, VOL_3V3_PEX,
+		CAGE_TEMP0, CAGE_TEMP1, CAGE_TEMP2, CAGE_TEMP3,
+		DIMM0_TEMP, DIMM1_TEMP, DIMM2_TEMP, DIMM3_TEMP,
+		FAN_TEMP, FPGA_TEMP, HBM_TEMP,
+		SE98_TEMP0, SE98_TEMP1, SE98_TEMP2,
+		XMC_VCCINT_TEMP, FAN_RPM,
+	};
+	struct xocl_xmc *xmc = dev_get_drvdata(dev);
+	ssize_t sz = 0;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(kinds); i++) {
+		u32 val = 0;
+
+		xmc_sensor(xmc->pdev, kinds[i], &val, SENSOR_INS);
+		sz += sprintf(buf + sz, "%u\n", val);
+	}
+
+	return sz;
+}
+static DEVICE_ATTR_RO(xmc_power_sensors);
+
 static ssize_t xmc_power_ins_show(struct device *dev,
 	struct device_attribute *da, char *buf)
 {
@@ -1615,7 +1646,8 @@ static DEVICE_ATTR_RO(core_version);
 	&dev_attr_xmc_heartbeat_err_time.attr,				\
 	&dev_attr_xmc_heartbeat_stall.attr,				\
 	&dev_attr_xmc_qspi_status.attr,					\
-	&dev_attr_xmc_power_ins.attr
+	&dev_attr_xmc_power_ins.attr,					\
+	&dev_attr_xmc_power_sensors.attr
 
 /*
  * Defining sysfs nodes for reading some of xmc regisers.
@@ -85,6 +85,27 @@ enum {
 	XOCL_FLAGS_PERSIST_SYSFS_INITIALIZED = (1 << 1),
 };
 
+/*
+ * Kernel clock governor. While enabled it samples CU utilization every
+ * interval_ms and scales the data and kernel clocks between
+ * XOCL_CLK_GOV_MIN_PCT and 100 percent of the xclbin frequencies.
+ * Command submission holds sem for read, a clock change holds it for
+ * write and is only made while all CUs are idle.
+ */
+#define	XOCL_CLK_GOV_UP_PCT	80	/* busy percent to go to max */
+#define	XOCL_CLK_GOV_DOWN_PCT	30	/* busy percent to step down */
+#define	XOCL_CLK_GOV_STEP_PCT	10
+#define	XOCL_CLK_GOV_MIN_PCT	50
+
+struct xocl_clk_gov {
+	struct delayed_work	work;
+	struct rw_semaphore	sem;
+	u32			interval_ms;	/* 0 disables */
+	u32			level;		/* percent of xclbin max */
+	u64			idle_ns;	/* CU idle time at last sample */
+	u64			sample_ns;	/* time of last sample */
+};
+
 struct xocl_dev	{
 	struct xocl_dev_core	core;
 
@@ -111,6 +132,27 @@ struct xocl_dev	{
 	uint64_t		mig_cache_expire_secs;
 	ktime_t			mig_cache_expires;
 
+	/*
+	 * A single sync_bo of at least dma_stripe_threshold bytes is split
+	 * across up to dma_stripe_channels free DMA channels. 0 disables.
+	 */
+	uint64_t		dma_stripe_threshold;
+	u32			dma_stripe_channels;
+
+	/* BO syncs that reused / had to create a cached DMA mapping */
+	atomic64_t		dma_map_hits;
+	atomic64_t		dma_map_misses;
+
+	/*
+	 * Read only CU status page mapped to user space at
+	 * XOCL_CU_STAT_PGOFF, refreshed by cu_stat_work while mapped.
+	 */
+	struct xocl_cu_stat_page *cu_stat_page;
+	struct delayed_work	cu_stat_work;
+	atomic_t		cu_stat_users;
+
+	struct xocl_clk_gov	clk_gov;
+
 	u32			flags;
 	struct xocl_cma_bank	*cma_bank;
 	struct xocl_pci_info	pci_stat;
@@ -149,6 +191,8 @@ int xocl_execbuf_ioctl(struct drm_device *dev, void *data,
 	struct drm_file *filp);
 int xocl_hw_ctx_execbuf_ioctl(struct drm_device *dev, void *data,
 	struct drm_file *filp);
+int xocl_submit_ring_ioctl(struct drm_device *dev, void *data,
+	struct drm_file *filp);
 int xocl_ctx_ioctl(struct drm_device *dev, void *data,
 	struct drm_file *filp);
 int xocl_create_hw_ctx_ioctl(struct drm_device *dev, void *data,
@@ -207,6 +251,7 @@ void get_pcie_link_info(struct xocl_dev	*xdev,
 	unsigned short *link_width, unsigned short *link_speed, bool is_cap);
 uint64_t xocl_get_data(struct xocl_dev *xdev, enum data_kind kind);
 int xocl_reclock(struct xocl_dev *xdev, void *data);
+int xocl_reclock_quiesced(struct xocl_dev *xdev, void *data);
 
 void xocl_update_mig_cache(struct xocl_dev *xdev);
 
@@ -226,6 +271,8 @@ int xocl_read_axlf_helper(struct xocl_drm *drm_p, struct drm_xocl_axlf *axlf_ptr
 /* KDS functions */
 int xocl_init_sched(struct xocl_dev *xdev);
 void xocl_fini_sched(struct xocl_dev *xdev);
+int xocl_cu_stat_mmap(struct xocl_dev *xdev, struct vm_area_struct *vma);
+void xocl_clk_gov_set_interval(struct xocl_dev *xdev, u32 interval_ms);
 int xocl_create_client(struct xocl_dev *xdev, void **priv);
 void xocl_destroy_client(struct xocl_dev *xdev, void **priv);
 int xocl_client_ioctl(struct xocl_dev *xdev, int op, void *data,
@@ -241,6 +288,8 @@ int xocl_open_cu_context(struct xocl_dev *xdev, struct drm_file *filp,
                 struct drm_xocl_open_cu_ctx *drm_cu_args);
 int xocl_close_cu_context(struct xocl_dev *xdev, struct drm_file *filp,
                 struct drm_xocl_close_cu_ctx *drm_cu_args);
+int xocl_submit_ring(struct xocl_dev *xdev, void *data,
+	struct drm_file *filp);
 int xocl_hw_ctx_command(struct xocl_dev *xdev, void *data,
 		      struct drm_file *filp);
 /* End of new hw context support functions */
@@ -25,6 +25,9 @@
 #include <linux/version.h>
 #include "common.h"
 
+#define CREATE_TRACE_POINTS
+#include "../xocl_trace.h"
+
 #ifdef _XOCL_BO_DEBUG
 #define	BO_ENTER(fmt, args...)		\
 	printk(KERN_INFO "[BO] Entering %s:"fmt"\n", __func__, ##args)
@@ -203,6 +206,14 @@ static void xocl_free_bo(struct drm_gem_object *obj)
 		unmap_mapping_range(xobj->dmabuf->file->f_mapping, 0, 0, 1);
 	}
 
+	if (xobj->dma_sgt) {
+		dma_unmap_sg(&xdev->core.pdev->dev, xobj->dma_sgt->sgl,
+			     xobj->dma_sgt->orig_nents, DMA_BIDIRECTIONAL);
+		sg_free_table(xobj->dma_sgt);
+		kfree(xobj->dma_sgt);
+		xobj->dma_sgt = NULL;
+	}
+
 	if (xobj->dma_nsg) {
 		dma_unmap_sg(&xdev->core.pdev->dev, xobj->sgt->sgl,
 			     xobj->dma_nsg, DMA_BIDIRECTIONAL);
@@ -713,6 +724,7 @@ int xocl_userptr_bo_ioctl(
 	int write = 1;
 	uint32_t hw_ctx_id = 0;
 	uint32_t slot_id = 0;
+	ktime_t pin_start;
 
 	if (offset_in_page(args->addr))
 		return -EINVAL;
@@ -755,6 +767,7 @@ int xocl_userptr_bo_ioctl(
 			write = 0;
 	}
 
+	pin_start = ktime_get();
 	while (page_pinned < page_count) {
 		/*
 		 * We pin at most 1G at a time to workaround
@@ -771,6 +784,10 @@ int xocl_userptr_bo_ioctl(
 		page_pinned += nr;
 	}
 
+	/*
+	 * Physically contiguous pages, e.g. when user memory is backed
+	 * by huge pages, are coalesced into one SG entry.
+	 */
 	xobj->sgt = alloc_onetime_sg_table(xobj->pages, 0,
 		page_count << PAGE_SHIFT);
 	if (IS_ERR(xobj->sgt)) {
@@ -778,6 +795,9 @@ int xocl_userptr_bo_ioctl(
 		xobj->sgt = NULL;
 		goto out0;
 	}
+	DRM_DEBUG("userptr BO pinned %llu pages in %lld us, %u SG entries\n",
+		page_count, ktime_us_delta(ktime_get(), pin_start),
+		xobj->sgt->orig_nents);
 
 	/* TODO: resolve the cache issue */
 	xobj->vmapping = vmap(xobj->pages, page_count, VM_MAP, PAGE_KERNEL);
@@ -836,23 +856,180 @@ int xocl_map_bo_ioctl(struct drm_device *dev,
 	return ret;
 }
 
-int xocl_sync_bo_ioctl(struct drm_device *dev,
-		       void *data,
-		       struct drm_file *filp)
+/*
+ * Return the DMA mapped sg table of the whole BO, creating it on first
+ * use. BO pages are pinned until xocl_free_bo(), which is also where the
+ * mapping is dropped, so repeated syncs skip dma_map_sg(). The table is
+ * separate from xobj->sgt because other paths map and unmap that one
+ * per transfer. Returns NULL when the BO cannot be cached.
+ */
+static struct sg_table *xocl_bo_dma_sgt(struct xocl_dev *xdev,
+	struct drm_xocl_bo *xobj)
 {
-	const struct drm_xocl_bo *xobj;
+	struct device *dev = &XDEV(xdev)->pdev->dev;
+	struct sg_table *sgt = READ_ONCE(xobj->dma_sgt);
+	int nents;
+
+	if (sgt) {
+		atomic64_inc(&xdev->dma_map_hits);
+		return sgt;
+	}
+
+	if (!xobj->pages || xocl_bo_import(xobj) || (xobj->flags & XOCL_SGL) ||
+	    !DMA_CB(xdev, migrate_mapped_bo))
+		return NULL;
+
+	atomic64_inc(&xdev->dma_map_misses);
+	sgt = alloc_onetime_sg_table(xobj->pages, 0, xobj->base.size);
+	if (IS_ERR(sgt))
+		return NULL;
+
+	nents = dma_map_sg(dev, sgt->sgl, sgt->orig_nents, DMA_BIDIRECTIONAL);
+	if (!nents)
+		goto free;
+	sgt->nents = nents;
+
+	/* Another sync of the same BO may have won the race */
+	if (!cmpxchg(&xobj->dma_sgt, NULL, sgt))
+		return sgt;
+
+	dma_unmap_sg(dev, sgt->sgl, sgt->orig_nents, DMA_BIDIRECTIONAL);
+free:
+	sg_free_table(sgt);
+	kfree(sgt);
+	return READ_ONCE(xobj->dma_sgt);
+}
+
+#define XOCL_MAX_SYNC_STRIPES	8
+
+struct xocl_sync_stripe {
+	struct work_struct	work;
+	struct xocl_dev		*xdev;
+	struct sg_table		*sgt;
+	u64			paddr;
+	u64			size;
+	u32			dir;
+	int			channel;
+	ssize_t			ret;
+};
+
+static void xocl_sync_stripe_work(struct work_struct *work)
+{
+	struct xocl_sync_stripe *stripe =
+		container_of(work, struct xocl_sync_stripe, work);
+
+	stripe->ret = xocl_migrate_bo(stripe->xdev, stripe->sgt, stripe->dir,
+		stripe->paddr, stripe->channel, stripe->size);
+}
+
+/*
+ * Split one large sync over the caller's channel plus whatever other
+ * channels are free right now. Each extra stripe runs from the unbound
+ * workqueue on its own channel, the first stripe runs in the caller.
+ * Returns -EAGAIN when no extra channel is free, the caller then does a
+ * plain single channel transfer.
+ */
+static int xocl_sync_bo_striped(struct xocl_dev *xdev,
+	const struct drm_xocl_bo *xobj, u32 dir, u64 paddr, u64 offset,
+	u64 size, int channel)
+{
+	struct xocl_sync_stripe *stripes;
+	u32 max_stripes = min_t(u32, xdev->dma_stripe_channels,
+		XOCL_MAX_SYNC_STRIPES);
+	u32 nstripes = 1;
+	u32 used, i;
+	u64 chunk;
+	int ret = 0;
+	int ch;
+
+	max_stripes = min_t(u32, max_stripes, xocl_get_chan_count(xdev));
+	if (max_stripes < 2 || !xobj->pages)
+		return -EAGAIN;
+
+	stripes = kcalloc(max_stripes, sizeof(*stripes), GFP_KERNEL);
+	if (!stripes)
+		return -EAGAIN;
+
+	stripes[0].channel = channel;
+	while (nstripes < max_stripes) {
+		ch = xocl_try_acquire_channel(xdev, dir);
+		if (ch < 0)
+			break;
+		stripes[nstripes++].channel = ch;
+	}
+	if (nstripes == 1) {
+		ret = -EAGAIN;
+		goto out;
+	}
+
+	chunk = PAGE_ALIGN(DIV_ROUND_UP_ULL(size, nstripes));
+	used = DIV_ROUND_UP_ULL(size, chunk);
+	for (i = 0; i < used; i++) {
+		struct xocl_sync_stripe *stripe = &stripes[i];
+		u64 off = chunk * i;
+
+		stripe->xdev = xdev;
+		stripe->dir = dir;
+		stripe->paddr = paddr + off;
+		stripe->size = min_t(u64, chunk, size - off);
+		stripe->sgt = alloc_onetime_sg_table(xobj->pages, offset + off,
+			stripe->size);
+		if (IS_ERR(stripe->sgt)) {
+			ret = PTR_ERR(stripe->sgt);
+			stripe->sgt = NULL;
+			used = i;
+			break;
+		}
+	}
+
+	for (i = 1; i < used; i++) {
+		INIT_WORK(&stripes[i].work, xocl_sync_stripe_work);
+		queue_work(system_unbound_wq, &stripes[i].work);
+	}
+	if (used)
+		xocl_sync_stripe_work(&stripes[0].work);
+	for (i = 1; i < used; i++)
+		flush_work(&stripes[i].work);
+
+	for (i = 0; i < used; i++) {
+		if (!ret && stripes[i].ret < 0)
+			ret = stripes[i].ret;
+		else if (!ret && stripes[i].ret != stripes[i].size)
+			ret = -EIO;
+		sg_free_table(stripes[i].sgt);
+		kfree(stripes[i].sgt);
+	}
+
+out:
+	for (i = 1; i < nstripes; i++)
+		xocl_release_channel(xdev, dir, stripes[i].channel);
+	kfree(stripes);
+	return ret;
+}
+
+/*
+ * Sync one BO. Use the DMA channel passed in if it is not negative,
+ * otherwise a channel is acquired and released for this BO only.
+ */
+static int xocl_sync_bo_channel(struct drm_device *dev,
+		       const struct drm_xocl_sync_bo *args,
+		       struct drm_file *filp, int channel)
+{
+	struct drm_xocl_bo *xobj;
 	struct sg_table *sgt;
+	struct sg_table *dma_sgt = NULL;
 	u64 paddr = 0;
-	int channel = 0;
+	bool own_channel = (channel < 0);
 	ssize_t ret = 0;
-	const struct drm_xocl_sync_bo *args = data;
 	struct xocl_drm *drm_p = dev->dev_private;
 	struct xocl_dev *xdev = drm_p->xdev;
 	struct scatterlist *sg;
 
 	u32 dir = (args->dir == DRM_XOCL_SYNC_BO_TO_DEVICE) ? 1 : 0;
-	struct drm_gem_object *gem_obj = xocl_gem_object_lookup(dev, filp,
-							       args->handle);
+	struct drm_gem_object *gem_obj;
+
+	trace_xocl_sync_bo(args->handle, dir, args->offset, args->size);
+	gem_obj = xocl_gem_object_lookup(dev, filp, args->handle);
 	if (!gem_obj) {
 		DRM_ERROR("Failed to look up GEM BO %d\n", args->handle);
 		return -ENOENT;
@@ -919,18 +1096,43 @@ int xocl_sync_bo_ioctl(struct drm_device *dev,
 	}
 
 	//drm_clflush_sg(sgt);
-	channel = xocl_acquire_channel(xdev, dir);
+	if (own_channel)
+		channel = xocl_acquire_channel(xdev, dir);
 	if (channel < 0) {
 		DRM_ERROR("BO %d request cannot find channel.\n", args->handle);
 		ret = -EINVAL;
 		goto clear;
 	}
 	/* Now perform DMA */
-	ret = xocl_migrate_bo(xdev, sgt, dir, paddr, channel, args->size);
-	if (ret >= 0)
-		ret = (ret == args->size) ? 0 : -EIO;
+	ret = -EAGAIN;
+	if (own_channel && xdev->dma_stripe_threshold &&
+	    args->size >= xdev->dma_stripe_threshold)
+		ret = xocl_sync_bo_striped(xdev, xobj, dir, paddr,
+			args->offset, args->size, channel);
+	if (ret == -EAGAIN && sgt == xobj->sgt)
+		dma_sgt = xocl_bo_dma_sgt(xdev, xobj);
+	if (ret == -EAGAIN && dma_sgt) {
+		struct device *ddev = &XDEV(xdev)->pdev->dev;
+
+		if (dir)
+			dma_sync_sg_for_device(ddev, dma_sgt->sgl,
+				dma_sgt->orig_nents, DMA_BIDIRECTIONAL);
+		ret = xocl_migrate_mapped_bo(xdev, dma_sgt, dir, paddr,
+			channel, args->size);
+		if (!dir && ret >= 0)
+			dma_sync_sg_for_cpu(ddev, dma_sgt->sgl,
+				dma_sgt->orig_nents, DMA_BIDIRECTIONAL);
+		if (ret >= 0)
+			ret = (ret == args->size) ? 0 : -EIO;
+	} else if (ret == -EAGAIN) {
+		ret = xocl_migrate_bo(xdev, sgt, dir, paddr, channel,
+			args->size);
+		if (ret >= 0)
+			ret = (ret == args->size) ? 0 : -EIO;
+	}
 
-	xocl_release_channel(xdev, dir, channel);
+	if (own_channel)
+		xocl_release_channel(xdev, dir, channel);
 clear:
 	if (args->offset || (args->size != xobj->base.size)) {
 		sg_free_table(sgt);
@@ -941,6 +1143,62 @@ out:
 	return ret;
 }
 
+int xocl_sync_bo_ioctl(struct drm_device *dev,
+		       void *data,
+		       struct drm_file *filp)
+{
+	return xocl_sync_bo_channel(dev, data, filp, -1);
+}
+
+/*
+ * Sync a batch of BOs in one direction. The DMA channel is acquired
+ * once and all transfers are queued back to back on it, so per BO cost
+ * is only the descriptor setup in xocl_migrate_bo.
+ */
+int xocl_sync_bo_batch_ioctl(struct drm_device *dev,
+		       void *data,
+		       struct drm_file *filp)
+{
+	struct drm_xocl_sync_bo_batch *args = data;
+	struct drm_xocl_sync_bo __user *syncs = to_user_ptr(args->syncs);
+	struct xocl_drm *drm_p = dev->dev_private;
+	struct xocl_dev *xdev = drm_p->xdev;
+	struct drm_xocl_sync_bo sync;
+	u32 dir = (args->dir == DRM_XOCL_SYNC_BO_TO_DEVICE) ? 1 : 0;
+	int channel;
+	int ret = 0;
+	u32 i;
+
+	if (!args->count || args->count > XOCL_SYNC_BO_BATCH_MAX)
+		return -EINVAL;
+
+	channel = xocl_acquire_channel(xdev, dir);
+	if (channel < 0) {
+		DRM_ERROR("Sync BO batch cannot find channel.\n");
+		return -EINVAL;
+	}
+
+	for (i = 0; i < args->count; i++) {
+		if (copy_from_user(&sync, &syncs[i], sizeof(sync))) {
+			ret = -EFAULT;
+			break;
+		}
+		if (sync.dir != args->dir) {
+			DRM_ERROR("BO %d sync direction differs from batch.\n",
+				sync.handle);
+			ret = -EINVAL;
+			break;
+		}
+		ret = xocl_sync_bo_channel(dev, &sync, filp, channel);
+		if (ret)
+			break;
+	}
+
+	xocl_release_channel(xdev, dir, channel);
+	args->error_index = i;
+	return ret;
+}
+
 int xocl_info_bo_ioctl(struct drm_device *dev,
 		       void *data,
 		       struct drm_file *filp)
@@ -967,9 +1225,9 @@ int xocl_info_bo_ioctl(struct drm_device *dev,
 	return 0;
 }
 
-static int xocl_migrate_unmgd(struct xocl_dev *xdev, uint64_t data_ptr, uint64_t paddr, size_t size, bool dir)
+static int xocl_migrate_unmgd_channel(struct xocl_dev *xdev, uint64_t data_ptr,
+	uint64_t paddr, size_t size, bool dir, int channel)
 {
-	int channel = 0;
 	struct drm_xocl_unmgd unmgd = {0};
 	ssize_t ret = 0;
 
@@ -979,21 +1237,30 @@ static int xocl_migrate_unmgd(struct xocl_dev *xdev, uint64_t data_ptr, uint64_t
 		return ret;
 	}
 
+	/* Now perform DMA */
+	ret = xocl_migrate_bo(xdev, unmgd.sgt, dir, paddr, channel, size);
+	if (ret >= 0)
+		ret = (ret == size) ? 0 : -EIO;
+
+	xocl_finish_unmgd(&unmgd);
+	return ret;
+}
+
+static int xocl_migrate_unmgd(struct xocl_dev *xdev, uint64_t data_ptr, uint64_t paddr, size_t size, bool dir)
+{
+	int channel = 0;
+	int ret = 0;
+
 	channel = xocl_acquire_channel(xdev, dir);
 
 	if (channel < 0) {
 		userpf_err(xdev, "acquire channel failed");
-		ret = -EINVAL;
-		goto clear;
+		return -EINVAL;
 	}
-	/* Now perform DMA */
-	ret = xocl_migrate_bo(xdev, unmgd.sgt, dir, paddr, channel, size);
-	if (ret >= 0)
-		ret = (ret == size) ? 0 : -EIO;
+
+	ret = xocl_migrate_unmgd_channel(xdev, data_ptr, paddr, size, dir, channel);
 
 	xocl_release_channel(xdev, dir, channel);
-clear:
-	xocl_finish_unmgd(&unmgd);
 	return ret;
 }
 
@@ -1532,6 +1799,52 @@ int xocl_pread_unmgd_ioctl(struct drm_device *dev, void *data,
 	return ret;
 }
 
+/*
+ * Read or write a list of scattered device memory segments. The DMA
+ * channel is acquired once and the segments are transferred back to
+ * back on it, so the per segment cost is pinning the user pages and
+ * the descriptor setup in xocl_migrate_bo.
+ */
+int xocl_unmgd_vec_ioctl(struct drm_device *dev, void *data,
+			 struct drm_file *filp)
+{
+	struct drm_xocl_unmgd_vec *args = data;
+	struct drm_xocl_unmgd_seg __user *segs = to_user_ptr(args->segs);
+	struct xocl_drm *drm_p = dev->dev_private;
+	struct xocl_dev *xdev = drm_p->xdev;
+	struct drm_xocl_unmgd_seg seg;
+	u32 dir = (args->dir == DRM_XOCL_SYNC_BO_TO_DEVICE) ? 1 : 0;
+	int channel;
+	int ret = 0;
+	u32 i;
+
+	if (!args->count || args->count > XOCL_UNMGD_VEC_MAX)
+		return -EINVAL;
+
+	channel = xocl_acquire_channel(xdev, dir);
+	if (channel < 0) {
+		userpf_err(xdev, "acquire channel failed");
+		return -EINVAL;
+	}
+
+	for (i = 0; i < args->count; i++) {
+		if (copy_from_user(&seg, &segs[i], sizeof(seg))) {
+			ret = -EFAULT;
+			break;
+		}
+		if (seg.size == 0)
+			continue;
+		ret = xocl_migrate_unmgd_channel(xdev, seg.data_ptr, seg.paddr,
+			seg.size, dir, channel);
+		if (ret)
+			break;
+	}
+
+	xocl_release_channel(xdev, dir, channel);
+	args->error_index = i;
+	return ret;
+}
+
 int xocl_usage_stat_ioctl(struct drm_device *dev, void *data,
 			  struct drm_file *filp)
 {
@@ -1556,6 +1869,9 @@ int xocl_usage_stat_ioctl(struct drm_device *dev, void *data,
 		args->c2h[i] = xocl_get_chan_stat(xdev, i, 0);
 	}
 
+	args->dma_map_hits = atomic64_read(&xdev->dma_map_hits);
+	args->dma_map_misses = atomic64_read(&xdev->dma_map_misses);
+
 	return 0;
 }
 
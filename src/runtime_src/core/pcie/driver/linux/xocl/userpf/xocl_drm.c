@@ -186,11 +186,19 @@ static int xocl_mmap(struct file *filp, struct vm_area_struct *vma)
 	if (likely(vma->vm_pgoff >= XOCL_FILE_PAGE_OFFSET))
 		return xocl_bo_mmap(filp, vma);
 
+	if (vma->vm_pgoff == XOCL_CU_STAT_PGOFF) {
+		struct drm_file *priv = filp->private_data;
+		struct xocl_drm *drm_p = priv->minor->dev->dev_private;
+
+		return xocl_cu_stat_mmap(drm_p->xdev, vma);
+	}
+
 	/*
 	 * Native BAR or CU mmap handling.
 	 * When pgoff is 0, we perform mmap of the PCIE BAR.
 	 * When pgoff is non-zero, we treat it as CU index + 1 and perform
 	 * mmap of that particular CU register space.
+	 * XOCL_CU_STAT_PGOFF maps the read only CU status page.
 	 */
 	return xocl_native_mmap(filp, vma);
 }
@@ -465,6 +473,12 @@ static const struct drm_ioctl_desc xocl_ioctls[] = {
 			  DRM_AUTH|DRM_UNLOCKED|DRM_RENDER_ALLOW),
 	DRM_IOCTL_DEF_DRV(XOCL_SET_CU_READONLY_RANGE, xocl_set_cu_read_only_range_ioctl,
 			  DRM_AUTH|DRM_UNLOCKED|DRM_RENDER_ALLOW),
+	DRM_IOCTL_DEF_DRV(XOCL_SYNC_BO_BATCH, xocl_sync_bo_batch_ioctl,
+			  DRM_AUTH|DRM_UNLOCKED|DRM_RENDER_ALLOW),
+	DRM_IOCTL_DEF_DRV(XOCL_SUBMIT_RING, xocl_submit_ring_ioctl,
+			  DRM_AUTH|DRM_UNLOCKED|DRM_RENDER_ALLOW),
+	DRM_IOCTL_DEF_DRV(XOCL_UNMGD_VEC, xocl_unmgd_vec_ioctl,
+			  DRM_AUTH|DRM_UNLOCKED|DRM_RENDER_ALLOW),
 
 /* LINUX KERNEL-SPACE IOCTLS - The following entries are meant to be
  * accessible only from Linux Kernel and need be grouped to at the end
@@ -42,6 +42,8 @@
 
 #define MAX_DYN_SUBDEV		1024
 #define XDEV_DEFAULT_EXPIRE_SECS	1
+#define XDEV_DEFAULT_STRIPE_THRESHOLD	(64 * 1024 * 1024)
+#define XDEV_DEFAULT_STRIPE_CHANNELS	4
 
 #define MAX_SB_APERTURES		256
 
@@ -198,9 +200,21 @@ static int userpf_intr_register(xdev_handle_t xdev_hdl, u32 intr,
 		xocl_msix_intr_unreg(xdev_hdl, intr);
 }
 
+static int userpf_intr_affinity(xdev_handle_t xdev_hdl, u32 intr, int cpu)
+{
+	int ret;
+
+	ret = xocl_dma_intr_affinity(xdev_hdl, intr, cpu);
+	if (ret != -ENODEV)
+		return ret;
+
+	return xocl_msix_intr_affinity(xdev_hdl, intr, cpu);
+}
+
 struct xocl_pci_funcs userpf_pci_ops = {
 	.intr_config = userpf_intr_config,
 	.intr_register = userpf_intr_register,
+	.intr_affinity = userpf_intr_affinity,
 };
 
 void xocl_reset_notify(struct pci_dev *pdev, bool prepare)
@@ -645,7 +659,7 @@ done:
 	vfree(resp);
 }
 
-int xocl_reclock(struct xocl_dev *xdev, void *data)
+static int __xocl_reclock(struct xocl_dev *xdev, void *data, bool check_clients)
 {
 	int err = 0, i = 0;
 	int msg = -ENODEV;
@@ -675,7 +689,7 @@ int xocl_reclock(struct xocl_dev *xdev, void *data)
 	req->req = XCL_MAILBOX_REQ_RECLOCK;
 	memcpy(req->data, data, data_len);
 
-	if (get_live_clients(xdev, NULL)) {
+	if (check_clients && get_live_clients(xdev, NULL)) {
 		userpf_err(xdev, "device is in use, can't reset");
 		err = -EBUSY;
 	}
@@ -701,6 +715,20 @@ int xocl_reclock(struct xocl_dev *xdev, void *data)
 	return err;
 }
 
+int xocl_reclock(struct xocl_dev *xdev, void *data)
+{
+	return __xocl_reclock(xdev, data, true);
+}
+
+/*
+ * Reclock while clients are attached. The caller must have made sure
+ * no command is running or can be submitted until this returns.
+ */
+int xocl_reclock_quiesced(struct xocl_dev *xdev, void *data)
+{
+	return __xocl_reclock(xdev, data, false);
+}
+
 static void xocl_mailbox_srv(void *arg, void *data, size_t len,
 	u64 msgid, int err, bool sw_ch)
 {
@@ -1798,6 +1826,8 @@ int xocl_userpf_probe(struct pci_dev *pdev,
 	flush_delayed_work(&xdev->core.works[XOCL_WORK_REFRESH_SUBDEV].work);
 
 	xdev->mig_cache_expire_secs = XDEV_DEFAULT_EXPIRE_SECS;
+	xdev->dma_stripe_threshold = XDEV_DEFAULT_STRIPE_THRESHOLD;
+	xdev->dma_stripe_channels = XDEV_DEFAULT_STRIPE_CHANNELS;
 
 	/* store link width & speed stats */
 	store_pcie_link_info(xdev);
@@ -1899,6 +1929,12 @@ static struct pci_driver userpf_driver = {
 	.probe = xocl_userpf_probe,
 	.remove = xocl_userpf_remove,
 	.err_handler = &xocl_err_handler,
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 2, 0)
+	/* cards are independent, probe them concurrently */
+	.driver = {
+		.probe_type = PROBE_PREFER_ASYNCHRONOUS,
+	},
+#endif
 };
 
 /* INIT */
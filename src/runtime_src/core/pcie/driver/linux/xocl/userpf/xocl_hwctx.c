@@ -44,11 +44,35 @@ int xocl_create_hw_context(struct xocl_dev *xdev, struct drm_file *filp,
 	struct kds_client *client = filp->driver_priv;
 	struct kds_client_hw_ctx *hw_ctx = NULL;
 	uuid_t *xclbin_id = NULL;
+	u32 cu_policy;
+	u32 priority;
+	u32 intr_mod;
 	int ret = 0;
 
 	if (!client)
 		return -EINVAL;
 
+	cu_policy = (hw_ctx_args->qos & XOCL_QOS_CU_POLICY_MASK) >>
+		XOCL_QOS_CU_POLICY_SHIFT;
+	if (cu_policy >= KDS_CU_POLICY_NUM) {
+		userpf_err(xdev, "Invalid CU policy %d", cu_policy);
+		return -EINVAL;
+	}
+
+	priority = (hw_ctx_args->qos & XOCL_QOS_PRIORITY_MASK) >>
+		XOCL_QOS_PRIORITY_SHIFT;
+	if (priority >= KDS_PRIORITY_NUM) {
+		userpf_err(xdev, "Invalid priority %d", priority);
+		return -EINVAL;
+	}
+
+	intr_mod = (hw_ctx_args->qos & XOCL_QOS_INTR_MOD_MASK) >>
+		XOCL_QOS_INTR_MOD_SHIFT;
+	if (intr_mod >= KDS_INTR_MOD_NUM) {
+		userpf_err(xdev, "Invalid interrupt moderation %d", intr_mod);
+		return -EINVAL;
+	}
+
 	ret = XOCL_GET_XCLBIN_ID(xdev, xclbin_id, slot_id);
 	if (ret)
 		return ret;
@@ -69,6 +93,15 @@ int xocl_create_hw_context(struct xocl_dev *xdev, struct drm_file *filp,
 		goto error_out;
 	}
 
+	hw_ctx->cu_policy = cu_policy;
+	hw_ctx->priority = priority;
+	hw_ctx->intr_mod = intr_mod;
+	hw_ctx->weight = (hw_ctx_args->qos & XOCL_QOS_WEIGHT_MASK) >>
+		XOCL_QOS_WEIGHT_SHIFT;
+	if (!hw_ctx->weight)
+		hw_ctx->weight = KDS_DEFAULT_WEIGHT;
+	hw_ctx->max_outstanding = (hw_ctx_args->qos & XOCL_QOS_DEPTH_MASK) >>
+		XOCL_QOS_DEPTH_SHIFT;
 	hw_ctx_args->hw_context = hw_ctx->hw_ctx_idx;
 
 error_out:
@@ -269,3 +302,125 @@ int xocl_hw_ctx_command(struct xocl_dev *xdev, void *data,
 
 	return xocl_command_ioctl(xdev, &legacy_args, filp, false);
 }
+
+/* Max number of ring entries submitted by one doorbell before the
+ * ring lock is dropped. Remaining entries are left for the next doorbell.
+ */
+#define XOCL_SUBMIT_RING_BUDGET	1024
+
+/*
+ * Mark the command buffer of a failed ring entry as error and notify the
+ * client, so that it is not waiting for a command that never ran.
+ */
+static void xocl_submit_ring_fail(struct drm_device *ddev,
+		struct drm_file *filp, uint32_t exec_bo_handle)
+{
+	struct kds_client *client = filp->driver_priv;
+	struct drm_gem_object *obj;
+	struct drm_xocl_bo *xobj;
+	struct ert_packet *ecmd;
+
+	obj = xocl_gem_object_lookup(ddev, filp, exec_bo_handle);
+	if (!obj)
+		return;
+
+	xobj = to_xocl_bo(obj);
+	if (xocl_bo_execbuf(xobj) && xobj->vmapping) {
+		ecmd = (struct ert_packet *)xobj->vmapping;
+		ecmd->state = ERT_CMD_STATE_ERROR;
+		atomic_inc(&client->event);
+		wake_up_interruptible(&client->waitq);
+	}
+	XOCL_DRM_GEM_OBJECT_PUT_UNLOCKED(obj);
+}
+
+/*
+ * Submit the entries of a user-mapped submission ring.
+ *
+ * The ring is drained in the caller's context and every entry goes through
+ * the same validation as DRM_IOCTL_XOCL_HW_CTX_EXECBUF. While the ring is
+ * being drained the draining flag is set, so the client could queue more
+ * entries without ringing the doorbell again.
+ */
+int xocl_submit_ring(struct xocl_dev *xdev, void *data,
+	struct drm_file *filp)
+{
+	struct drm_device *ddev = filp->minor->dev;
+	struct kds_client *client = filp->driver_priv;
+	struct drm_xocl_submit_ring *args = data;
+	struct drm_xocl_execbuf legacy_args = {};
+	struct xocl_submit_ring *ring;
+	struct xocl_submit_entry *entry;
+	struct drm_gem_object *obj;
+	struct drm_xocl_bo *xobj;
+	uint32_t head, tail, size, mask;
+	uint32_t budget = XOCL_SUBMIT_RING_BUDGET;
+	int ret = 0;
+
+	args->submitted = 0;
+
+	obj = xocl_gem_object_lookup(ddev, filp, args->ring_bo_handle);
+	if (!obj) {
+		userpf_err(xdev, "Failed to look up ring BO %d\n",
+			   args->ring_bo_handle);
+		return -ENOENT;
+	}
+
+	xobj = to_xocl_bo(obj);
+	if (!xocl_bo_execbuf(xobj) || !xobj->vmapping) {
+		userpf_err(xdev, "Submission ring is not exec buf\n");
+		ret = -EINVAL;
+		goto out;
+	}
+
+	ring = (struct xocl_submit_ring *)xobj->vmapping;
+	size = READ_ONCE(ring->size);
+	mask = size - 1;
+	if (!size || (size & mask) || sizeof(*ring) +
+	    (u64)size * sizeof(*entry) > xobj->base.size) {
+		userpf_err(xdev, "Invalid submission ring size %d\n", size);
+		ret = -EINVAL;
+		goto out;
+	}
+
+	mutex_lock(&client->ring_lock);
+again:
+	WRITE_ONCE(ring->draining, 1);
+	/* Order draining flag before reading tail, pairs with the client */
+	smp_mb();
+	head = READ_ONCE(ring->head);
+	tail = smp_load_acquire(&ring->tail);
+	while (head != tail && budget) {
+		entry = &ring->entries[head & mask];
+		legacy_args.ctx_id = READ_ONCE(entry->hw_ctx_id);
+		legacy_args.exec_bo_handle = READ_ONCE(entry->exec_bo_handle);
+
+		ret = xocl_command_ioctl(xdev, &legacy_args, filp, false);
+		if (ret) {
+			if (!ring->error) {
+				ring->error_handle = legacy_args.exec_bo_handle;
+				WRITE_ONCE(ring->error, ret);
+			}
+			xocl_submit_ring_fail(ddev, filp,
+					      legacy_args.exec_bo_handle);
+			ret = 0;
+		}
+
+		/* Entry is consumed, the client could reuse it */
+		smp_store_release(&ring->head, ++head);
+		args->submitted++;
+		budget--;
+		if (head == tail)
+			tail = smp_load_acquire(&ring->tail);
+	}
+	WRITE_ONCE(ring->draining, 0);
+	/* Client might queue an entry after seeing draining is set */
+	smp_mb();
+	if (budget && READ_ONCE(ring->tail) != head)
+		goto again;
+	mutex_unlock(&client->ring_lock);
+
+out:
+	XOCL_DRM_GEM_OBJECT_PUT_UNLOCKED(obj);
+	return ret;
+}
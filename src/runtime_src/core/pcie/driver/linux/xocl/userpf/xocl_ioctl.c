@@ -74,6 +74,14 @@ int xocl_hw_ctx_execbuf_ioctl(struct drm_device *dev,
 	return ret;
 }
 
+int xocl_submit_ring_ioctl(struct drm_device *dev,
+	void *data, struct drm_file *filp)
+{
+	struct xocl_drm *drm_p = dev->dev_private;
+
+	return xocl_submit_ring(drm_p->xdev, data, filp);
+}
+
 int xocl_execbuf_callback_ioctl(struct drm_device *dev,
 			  void *data,
 			  struct drm_file *filp)
@@ -398,37 +406,6 @@ static bool xclbin_downloaded(struct xocl_dev *xdev, xuid_t *xclbin_id,
 	return ret;
 }
 
-static int xocl_preserve_memcmp(struct mem_topology *new_topo, struct mem_topology *mem_topo, size_t size)
-{
-	int ret = -1;
-	size_t i, j = 0;
-
-	if (mem_topo->m_count != new_topo->m_count)
-		return ret;
-
-	for (i = 0; i < mem_topo->m_count; ++i) {
-		if (convert_mem_tag(mem_topo->m_mem_data[i].m_tag) == MEM_TAG_HOST)
-			continue;
-		for (j = 0; j < new_topo->m_count; ++j) {
-			if (memcmp(mem_topo->m_mem_data[i].m_tag, 
-				new_topo->m_mem_data[j].m_tag, 16))
-				continue;
-			if (memcmp(&mem_topo->m_mem_data[i], &new_topo->m_mem_data[j],
-				 sizeof(struct mem_data))) {
-				ret = -1;
-			} else {
-				ret = 0;
-				break;
-			}
-
-		}
-		if (ret)
-			break;
-	}
-
-	return ret;
-}
-
 static int xocl_preserve_mem(struct xocl_drm *drm_p, struct mem_topology *new_topology, size_t size)
 {
 	int ret = 0;
@@ -451,8 +428,7 @@ static int xocl_preserve_mem(struct xocl_drm *drm_p, struct mem_topology *new_to
 	 */
 	if (xocl_icap_get_data(xdev, DATA_RETAIN) && (topology != NULL) &&
 		drm_p->xocl_mm->mm) {
-		if ((size == sizeof_sect(topology, m_mem_data)) &&
-		    !xocl_preserve_memcmp(new_topology, topology, size)) {
+		if (xocl_mem_topo_retainable(topology, new_topology, size)) {
 			userpf_info(xdev, "preserving mem_topology.");
 			ret = 1;
 		} else {
@@ -38,6 +38,11 @@ do {\
 void xocl_describe(const struct drm_xocl_bo *xobj);
 
 int kds_echo = 0;
+/* Skip unchanged argument writes of ap_ctrl_chain CUs */
+int kds_arg_shadow = 0;
+
+static int xocl_kds_xgq_cu_intr_mod(struct kds_sched *kds, u32 cu_idx,
+				    u32 count, u32 cycles);
 
 static void xocl_kds_fa_clear(struct xocl_dev *xdev)
 {
@@ -87,6 +92,26 @@ get_bo_paddr(struct xocl_dev *xdev, struct drm_file *filp,
 	return 0;
 }
 
+/*
+ * Return values of copybo_ecmd2xcmd() other than 0 (xcmd converted to a
+ * KDMA CU command) and negative errno
+ */
+#define	COPYBO_DONE		1	/* P2P copy is done synchronously */
+#define	COPYBO_QUEUED_M2M	2	/* Copy goes to the m2m subdev queue */
+
+static int xocl_m2m_submit(struct xocl_dev *xdev, struct kds_command *xcmd)
+{
+	int ret;
+
+	ret = xocl_m2m_queue_copy(xdev, xcmd);
+	if (ret) {
+		xcmd->status = KDS_ERROR;
+		xcmd->cb.notify_host(xcmd, xcmd->status);
+		xcmd->cb.free(xcmd);
+	}
+	return ret;
+}
+
 static int copybo_ecmd2xcmd(struct xocl_dev *xdev, struct drm_file *filp,
 			    struct ert_start_copybo_cmd *ecmd,
 			    struct kds_command *xcmd)
@@ -120,12 +145,17 @@ static int copybo_ecmd2xcmd(struct xocl_dev *xdev, struct drm_file *filp,
 	if (ret_src != ret_dst) {
 		/* One of them is not local BO, perform P2P copy */
 		int err = xocl_copy_import_bo(filp->minor->dev, filp, ecmd);
-		return err < 0 ? err : 1;
+		return err < 0 ? err : COPYBO_DONE;
 	}
 
 	/* Both BOs are local, copy via cdma CU */
-	if (cu_mgmt->num_cdma == 0)
-		return -EINVAL;
+	if (cu_mgmt->num_cdma == 0) {
+		if (!M2M_CB(xdev))
+			return -EINVAL;
+		/* No KDMA CU in xclbin, queue the copy to the m2m subdev */
+		ert_fill_copybo_cmd(ecmd, 0, 0, src_addr, dst_addr, sz);
+		return COPYBO_QUEUED_M2M;
+	}
 
 	userpf_info(xdev,"checking alignment requirments for KDMA sz(%lu)",sz);
 	if ((dst_addr + dst_off) % KDMA_BLOCK_SIZE ||
@@ -507,7 +537,8 @@ static void notify_execbuf(struct kds_command *xcmd, enum kds_status status)
 		kfree(xcmd->inkern_cb);
 	} else {
 		atomic_inc(&client->event);
-		wake_up_interruptible(&client->waitq);
+		if (!xcmd->defer_wake)
+			wake_up_interruptible(&client->waitq);
 	}
 }
 
@@ -542,6 +573,14 @@ static void notify_execbuf_xgq(struct kds_command *xcmd, enum kds_status status)
 		ts->skc_timestamps[ERT_CMD_STATE_QUEUED] = xcmd->timestamp[KDS_QUEUED];
 		ts->skc_timestamps[ERT_CMD_STATE_RUNNING] = xcmd->timestamp[KDS_RUNNING];
 		ts->skc_timestamps[ecmd->state] = xcmd->timestamp[status];
+
+		if (scmd->fw_stat_enabled) {
+			struct cu_cmd_fw_timestamps *fw_ts;
+
+			fw_ts = ert_start_kernel_fw_timestamps(scmd);
+			fw_ts->cu_start = xcmd->fw_cu_start;
+			fw_ts->cu_done = xcmd->fw_cu_done;
+		}
 	}
 
 	XOCL_DRM_GEM_OBJECT_PUT_UNLOCKED(xcmd->gem_obj);
@@ -556,7 +595,8 @@ static void notify_execbuf_xgq(struct kds_command *xcmd, enum kds_status status)
 		kfree(xcmd->inkern_cb);
 	} else {
 		atomic_inc(&client->event);
-		wake_up_interruptible(&client->waitq);
+		if (!xcmd->defer_wake)
+			wake_up_interruptible(&client->waitq);
 	}
 }
 
@@ -658,14 +698,18 @@ static int xocl_fill_payload_xgq(struct xocl_dev *xdev, struct kds_command *xcmd
 		break;
 	case ERT_START_CU:
 		kecmd = (struct ert_start_kernel_cmd *)xcmd->execbuf;
-		if (kecmd->stat_enabled)
+		if (kecmd->stat_enabled) {
 			xcmd->timestamp_enabled = 1;
+			xcmd->fw_timestamp_enabled = kecmd->fw_stat_enabled;
+		}
 		xcmd->type = KDS_CU;
 		xcmd->opcode = OP_START;
 		xcmd->cu_mask[0] = kecmd->cu_mask;
 		memcpy(&xcmd->cu_mask[1], kecmd->data, kecmd->extra_cu_masks * sizeof(u32));
 		xcmd->num_mask = 1 + kecmd->extra_cu_masks;
 		xcmd->isize = xgq_exec_convert_start_cu_cmd(xcmd->info, kecmd);
+		/* Host scheduled CUs take the same command */
+		xcmd->payload_type = XGQ_CMD;
 		ret = 1; /* hack */
 		break;
 	case ERT_CLK_CALIB:
@@ -698,19 +742,22 @@ static int xocl_fill_payload_xgq(struct xocl_dev *xdev, struct kds_command *xcmd
 		}
 		print_ecmd_info(ecmd);
 		kecmd = (struct ert_start_kernel_cmd *)xcmd->execbuf;
-		if (kecmd->stat_enabled)
+		if (kecmd->stat_enabled) {
 			xcmd->timestamp_enabled = 1;
+			xcmd->fw_timestamp_enabled = kecmd->fw_stat_enabled;
+		}
 		xcmd->type = KDS_CU;
 		xcmd->opcode = OP_START;
 		xcmd->cu_mask[0] = kecmd->cu_mask;
 		memcpy(&xcmd->cu_mask[1], kecmd->data, kecmd->extra_cu_masks * sizeof(u32));
 		xcmd->num_mask = 1 + kecmd->extra_cu_masks;
 		xcmd->isize = xgq_exec_convert_start_kv_cu_cmd(xcmd->info, kecmd);
+		xcmd->payload_type = XGQ_CMD;
 		ret = 1;
 		break;
 	case ERT_START_COPYBO:
 		ret = copybo_ecmd2xcmd(xdev, filp, to_copybo_pkg(ecmd), xcmd);
-		if (ret > 0) {
+		if (ret == COPYBO_DONE) {
 			xcmd->status = KDS_COMPLETED;
 			xcmd->cb.notify_host(xcmd, xcmd->status);
 			ret = 0;
@@ -852,7 +899,7 @@ int xocl_command_ioctl(struct xocl_dev *xdev, void *data,
 		break;
 	case ERT_START_COPYBO:
 		ret = copybo_ecmd2xcmd(xdev, filp, to_copybo_pkg(ecmd), xcmd);
-		if (ret > 0) {
+		if (ret == COPYBO_DONE) {
 			xcmd->status = KDS_COMPLETED;
 			xcmd->cb.notify_host(xcmd, xcmd->status);
 			ret = 0;
@@ -906,10 +953,18 @@ out2:
 		}
 	}
 
+	/* A copybo command that is still a copybo command at this point is
+	 * not converted to a KDMA CU command and goes to m2m instead.
+	 */
+	if (ecmd->opcode == ERT_START_COPYBO)
+		return xocl_m2m_submit(xdev, xcmd);
+
 	/* If add command returns failed, KDS core would take care of
 	 * xcmd and put gem object while notify host.
 	 */
+	down_read(&xdev->clk_gov.sem);
 	ret = kds_add_command(&XDEV(xdev)->kds, xcmd);
+	up_read(&xdev->clk_gov.sem);
 	return ret;
 
 out1:
@@ -966,6 +1021,8 @@ void xocl_destroy_client(struct xocl_dev *xdev, void **priv)
 	struct kds_client_hw_ctx *next = NULL;
 
 	kds = &XDEV(xdev)->kds;
+	/* Copies queued to m2m are not tracked by KDS */
+	xocl_m2m_flush_client(xdev, client);
 	kds_fini_client(kds, client);
 
 	mutex_lock(&client->lock);
@@ -1034,12 +1091,281 @@ int xocl_client_ioctl(struct xocl_dev *xdev, int op, void *data,
 	return ret;
 }
 
+#define XOCL_CU_STAT_PAGE_SIZE	PAGE_ALIGN(sizeof(struct xocl_cu_stat_page))
+
+static void xocl_cu_stat_update(struct xocl_dev *xdev)
+{
+	struct kds_cu_mgmt *cu_mgmt = &XDEV(xdev)->kds.cu_mgmt;
+	struct xocl_cu_stat_page *page = xdev->cu_stat_page;
+	struct xocl_cu_stat_entry *entry;
+	struct xrt_cu *xcu;
+	unsigned long flags;
+	u64 now = ktime_to_ns(ktime_get());
+	u64 idle_ns;
+	u32 idle;
+	u32 num_cus = 0;
+	int i;
+
+	mutex_lock(&cu_mgmt->lock);
+	WRITE_ONCE(page->seq, page->seq + 1);
+	smp_wmb();
+	for (i = 0; i < XOCL_CU_STAT_MAX_CUS && i < MAX_CUS; i++) {
+		entry = &page->cu[i];
+		xcu = cu_mgmt->xcus[i];
+		if (!xcu) {
+			if (entry->flags)
+				memset(entry, 0, sizeof(*entry));
+			continue;
+		}
+
+		spin_lock_irqsave(&xcu->stats.xcs_lock, flags);
+		idle = xcu->stats.idle;
+		idle_ns = xcu->stats.idle_total;
+		if (idle && now > xcu->stats.idle_start)
+			idle_ns += now - xcu->stats.idle_start;
+		spin_unlock_irqrestore(&xcu->stats.xcs_lock, flags);
+
+		entry->usage = cu_stat_read(cu_mgmt, usage[i]);
+		entry->idle_ns = idle_ns;
+		entry->num_sq = READ_ONCE(xcu->num_sq);
+		entry->num_rq = READ_ONCE(xcu->num_rq);
+		entry->num_pq = READ_ONCE(xcu->num_pq);
+		entry->slot_idx = xcu->info.slot_idx;
+		entry->flags = XOCL_CU_STAT_FLAG_VALID |
+			(idle ? XOCL_CU_STAT_FLAG_IDLE : 0);
+		num_cus = i + 1;
+	}
+	page->num_cus = num_cus;
+	page->timestamp_ns = now;
+	smp_wmb();
+	WRITE_ONCE(page->seq, page->seq + 1);
+	mutex_unlock(&cu_mgmt->lock);
+}
+
+static void xocl_cu_stat_work(struct work_struct *work)
+{
+	struct xocl_dev *xdev = container_of(to_delayed_work(work),
+					     struct xocl_dev, cu_stat_work);
+
+	xocl_cu_stat_update(xdev);
+	if (atomic_read(&xdev->cu_stat_users))
+		schedule_delayed_work(&xdev->cu_stat_work, msecs_to_jiffies(1));
+}
+
+static void xocl_cu_stat_vm_open(struct vm_area_struct *vma)
+{
+	struct xocl_dev *xdev = vma->vm_private_data;
+
+	if (atomic_inc_return(&xdev->cu_stat_users) == 1)
+		mod_delayed_work(system_wq, &xdev->cu_stat_work, 0);
+}
+
+static void xocl_cu_stat_vm_close(struct vm_area_struct *vma)
+{
+	struct xocl_dev *xdev = vma->vm_private_data;
+
+	/* The work stops rescheduling itself once the count drops to 0 */
+	atomic_dec(&xdev->cu_stat_users);
+}
+
+static const struct vm_operations_struct xocl_cu_stat_vm_ops = {
+	.open = xocl_cu_stat_vm_open,
+	.close = xocl_cu_stat_vm_close,
+};
+
+int xocl_cu_stat_mmap(struct xocl_dev *xdev, struct vm_area_struct *vma)
+{
+	unsigned long vsize = vma->vm_end - vma->vm_start;
+	int ret;
+
+	if (!xdev->cu_stat_page)
+		return -ENODEV;
+
+	if (vsize > XOCL_CU_STAT_PAGE_SIZE) {
+		userpf_err(xdev, "bad size (0x%lx) for CU status mmap", vsize);
+		return -EINVAL;
+	}
+
+	if (vma->vm_flags & VM_WRITE)
+		return -EPERM;
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(6, 3, 0)
+	vma->vm_flags &= ~VM_MAYWRITE;
+	vma->vm_flags |= VM_DONTEXPAND | VM_DONTDUMP;
+#else
+	vm_flags_mod(vma, VM_DONTEXPAND | VM_DONTDUMP, VM_MAYWRITE);
+#endif
+
+	ret = remap_pfn_range(vma, vma->vm_start,
+			      virt_to_phys(xdev->cu_stat_page) >> PAGE_SHIFT,
+			      vsize, vma->vm_page_prot);
+	if (ret) {
+		userpf_err(xdev, "CU status remap_pfn_range failed: %d", ret);
+		return ret;
+	}
+
+	vma->vm_private_data = xdev;
+	vma->vm_ops = &xocl_cu_stat_vm_ops;
+	xocl_cu_stat_vm_open(vma);
+	return 0;
+}
+
+/* Percent of time CUs were busy since the last sample, -1 if no CU */
+static int xocl_clk_gov_sample(struct xocl_dev *xdev)
+{
+	struct kds_cu_mgmt *cu_mgmt = &XDEV(xdev)->kds.cu_mgmt;
+	struct xocl_clk_gov *gov = &xdev->clk_gov;
+	struct xrt_cu *xcu;
+	unsigned long flags;
+	u64 now = ktime_to_ns(ktime_get());
+	u64 idle_ns = 0, elapsed, idle;
+	int num_cus = 0;
+	int busy = -1;
+	int i;
+
+	mutex_lock(&cu_mgmt->lock);
+	for (i = 0; i < MAX_CUS; i++) {
+		xcu = cu_mgmt->xcus[i];
+		if (!xcu)
+			continue;
+
+		spin_lock_irqsave(&xcu->stats.xcs_lock, flags);
+		idle_ns += xcu->stats.idle_total;
+		if (xcu->stats.idle && now > xcu->stats.idle_start)
+			idle_ns += now - xcu->stats.idle_start;
+		spin_unlock_irqrestore(&xcu->stats.xcs_lock, flags);
+		num_cus++;
+	}
+	mutex_unlock(&cu_mgmt->lock);
+
+	/* The first sample, or CUs changed under us, only sets the base */
+	elapsed = (now - gov->sample_ns) * num_cus;
+	if (num_cus && gov->sample_ns && idle_ns >= gov->idle_ns && elapsed) {
+		idle = min(idle_ns - gov->idle_ns, elapsed);
+		busy = 100 - (int)div64_u64(idle * 100, elapsed);
+	}
+	gov->idle_ns = idle_ns;
+	gov->sample_ns = now;
+
+	return busy;
+}
+
+static bool xocl_clk_gov_cus_idle(struct xocl_dev *xdev)
+{
+	struct kds_cu_mgmt *cu_mgmt = &XDEV(xdev)->kds.cu_mgmt;
+	struct xrt_cu *xcu;
+	bool idle = true;
+	int i;
+
+	mutex_lock(&cu_mgmt->lock);
+	for (i = 0; i < MAX_CUS && idle; i++) {
+		xcu = cu_mgmt->xcus[i];
+		if (!xcu)
+			continue;
+
+		idle = READ_ONCE(xcu->stats.idle) && !READ_ONCE(xcu->num_sq) &&
+			!READ_ONCE(xcu->num_rq) && !READ_ONCE(xcu->num_pq);
+	}
+	mutex_unlock(&cu_mgmt->lock);
+
+	return idle;
+}
+
+static int xocl_clk_gov_apply(struct xocl_dev *xdev, u32 level)
+{
+	struct xocl_clk_gov *gov = &xdev->clk_gov;
+	struct drm_xocl_reclock_info freqs = { 0 };
+	unsigned short max[DRM_XOCL_NUM_SUPPORTED_CLOCKS] = { 0 };
+	int err, i;
+
+	/* A reclock may reset the CU registers the shadow relies on */
+	if (kds_arg_shadow)
+		return -EPERM;
+
+	err = xocl_icap_ocl_get_freq_max(xdev, max, ARRAY_SIZE(max));
+	if (err)
+		return err;
+
+	/* Only the data (0) and kernel (1) clocks are scaled */
+	for (i = 0; i < 2; i++)
+		freqs.ocl_target_freq[i] = max[i] * level / 100;
+
+	/*
+	 * The clocks are changed behind a frozen AXI gate, so nothing may
+	 * run on the CUs. Block submission and give up if any CU is busy,
+	 * the next sample retries.
+	 */
+	down_write(&gov->sem);
+	if (xocl_clk_gov_cus_idle(xdev))
+		err = xocl_reclock_quiesced(xdev, &freqs);
+	else
+		err = -EBUSY;
+	up_write(&gov->sem);
+
+	if (!err)
+		userpf_info(xdev, "clock governor set %d%%, %d %d MHz", level,
+			freqs.ocl_target_freq[0], freqs.ocl_target_freq[1]);
+	return err;
+}
+
+static void xocl_clk_gov_work(struct work_struct *work)
+{
+	struct xocl_dev *xdev = container_of(to_delayed_work(work),
+					     struct xocl_dev, clk_gov.work);
+	struct xocl_clk_gov *gov = &xdev->clk_gov;
+	u32 interval = READ_ONCE(gov->interval_ms);
+	u32 level = gov->level;
+	int busy;
+
+	if (!interval)
+		return;
+
+	busy = xocl_clk_gov_sample(xdev);
+	if (busy >= XOCL_CLK_GOV_UP_PCT)
+		level = 100;
+	else if (busy >= 0 && busy <= XOCL_CLK_GOV_DOWN_PCT)
+		level = max_t(u32, level - XOCL_CLK_GOV_STEP_PCT,
+			      XOCL_CLK_GOV_MIN_PCT);
+
+	if (level != gov->level && !xocl_clk_gov_apply(xdev, level))
+		gov->level = level;
+
+	schedule_delayed_work(&gov->work, msecs_to_jiffies(interval));
+}
+
+void xocl_clk_gov_set_interval(struct xocl_dev *xdev, u32 interval_ms)
+{
+	struct xocl_clk_gov *gov = &xdev->clk_gov;
+
+	cancel_delayed_work_sync(&gov->work);
+	WRITE_ONCE(gov->interval_ms, interval_ms);
+	if (!interval_ms)
+		return;
+
+	/* Start from the xclbin clocks as loaded */
+	gov->level = 100;
+	gov->sample_ns = 0;
+	schedule_delayed_work(&gov->work, msecs_to_jiffies(interval_ms));
+}
+
 int xocl_init_sched(struct xocl_dev *xdev)
 {
 	int ret;
 	ret = kds_init_sched(&XDEV(xdev)->kds);
 	if (ret)
 		goto out;
+	XDEV(xdev)->kds.set_cu_intr_mod = xocl_kds_xgq_cu_intr_mod;
+
+	/* The CU status page is best effort, mmap fails without it */
+	xdev->cu_stat_page = (struct xocl_cu_stat_page *)
+		__get_free_pages(GFP_KERNEL | __GFP_ZERO,
+				 get_order(XOCL_CU_STAT_PAGE_SIZE));
+	if (xdev->cu_stat_page)
+		xdev->cu_stat_page->version = XOCL_CU_STAT_VERSION;
+	INIT_DELAYED_WORK(&xdev->cu_stat_work, xocl_cu_stat_work);
+	atomic_set(&xdev->cu_stat_users, 0);
+	INIT_DELAYED_WORK(&xdev->clk_gov.work, xocl_clk_gov_work);
+	init_rwsem(&xdev->clk_gov.sem);
 
 	ret = xocl_create_client(xdev, (void **)&XDEV(xdev)->kds.anon_client);
 out:
@@ -1056,6 +1382,14 @@ void xocl_fini_sched(struct xocl_dev *xdev)
 		xocl_drm_free_bo(&bo->base);
 	}
 
+	xocl_clk_gov_set_interval(xdev, 0);
+	cancel_delayed_work_sync(&xdev->cu_stat_work);
+	if (xdev->cu_stat_page) {
+		free_pages((unsigned long)xdev->cu_stat_page,
+			   get_order(XOCL_CU_STAT_PAGE_SIZE));
+		xdev->cu_stat_page = NULL;
+	}
+
 	xocl_destroy_client(xdev, (void **)&XDEV(xdev)->kds.anon_client);
 	kds_fini_sched(&XDEV(xdev)->kds);
 }
@@ -1827,6 +2161,7 @@ xocl_kds_xgq_cfg_start(struct xocl_dev *xdev, struct drm_xocl_kds cfg, int num_c
 	cfg_start->mode = 0;
 	cfg_start->echo = 0;
 	cfg_start->verbose = 0;
+	cfg_start->ts = kds->cu_timestamp;
 	cfg_start->num_scus = num_scus;
 
 	xcmd->cb.notify_host = xocl_kds_xgq_notify;
@@ -1847,6 +2182,9 @@ xocl_kds_xgq_cfg_start(struct xocl_dev *xdev, struct drm_xocl_kds cfg, int num_c
 		return -EINVAL;
 	}
 
+	if (kds->cu_timestamp && !resp.ts)
+		userpf_info(xdev, "ERT does not support CU timestamps\n");
+
 	userpf_info(xdev, "Config start completed, num_cus(%d), num_scus(%d)\n",
 		    num_cus, num_scus);
 	return 0;
@@ -1927,6 +2265,8 @@ xocl_kds_xgq_cfg_cus(struct xocl_dev *xdev, xuid_t *xclbin_id, struct xrt_cu_inf
 		cfg_cu->cu_idx = cu_info[i].inst_idx;
 		cfg_cu->cu_domain = DOMAIN_PL;
 		cfg_cu->ip_ctrl = cu_info[i].protocol;
+		if (kds_arg_shadow && cu_info[i].protocol == CTRL_CHAIN)
+			cfg_cu->ip_ctrl |= XGQ_IP_CTRL_ARG_SHADOW;
 		cfg_cu->intr_id = cu_info[i].intr_id;
 		cfg_cu->intr_enable = cu_info[i].intr_enable;
 		cfg_cu->map_size = cu_info[i].size;
@@ -1944,7 +2284,7 @@ xocl_kds_xgq_cfg_cus(struct xocl_dev *xdev, xuid_t *xclbin_id, struct xrt_cu_inf
 		cfg_cu->payload_size = max_off + max_off_arg_size + sizeof(struct xgq_cmd_sq_hdr);
 		if(cfg_cu->payload_size > MAX_CQ_SLOT_SIZE) {
 			userpf_err(xdev, "CU Argument Size %x > MAX_CQ_SLOT_SIZE!", cfg_cu->payload_size);
-			kfree(xcmd);
+			kds_free_command(xcmd);
 			return -ENOMEM;
 		}
 		/*
@@ -2058,6 +2398,70 @@ xocl_kds_xgq_cfg_scus(struct xocl_dev *xdev, xuid_t *xclbin_id, struct xrt_cu_in
 	return ret;
 }
 
+/*
+ * Writing a large register map from ERT costs more than from host, as
+ * ERT is slow on the CU AXI-lite. Such CUs are scheduled by host.
+ */
+static bool xocl_kds_host_sched_cu(struct xocl_dev *xdev, struct xrt_cu_info *cu_info)
+{
+	u32 threshold = XDEV(xdev)->kds.host_cu_regmap;
+	u32 regmap_size = 0;
+	int i;
+
+	if (!threshold || cu_info->protocol == CTRL_NONE)
+		return false;
+
+	for (i = 0; i < cu_info->num_args; i++)
+		regmap_size = max_t(u32, regmap_size,
+				    cu_info->args[i].offset + cu_info->args[i].size);
+
+	return regmap_size > threshold;
+}
+
+static int
+xocl_kds_xgq_cu_intr_mod(struct kds_sched *kds, u32 cu_idx, u32 count, u32 cycles)
+{
+	struct xocl_dev *xdev = container_of(kds, struct xocl_dev, core.kds);
+	struct xgq_cmd_cu_intr_mod *intr_mod = NULL;
+	struct xgq_com_queue_entry resp = {0};
+	struct kds_command *xcmd = NULL;
+	int ret = 0;
+
+	xcmd = kds_alloc_command(kds->anon_client, sizeof(struct xgq_cmd_cu_intr_mod));
+	if (!xcmd)
+		return -ENOMEM;
+
+	intr_mod = xcmd->info;
+	intr_mod->hdr.opcode = XGQ_CMD_OP_CU_INTR_MOD;
+	intr_mod->hdr.count = sizeof(*intr_mod) - sizeof(intr_mod->hdr);
+	intr_mod->hdr.state = 1;
+
+	intr_mod->cu_idx = cu_idx;
+	intr_mod->count = min_t(u32, count, 0xFF);
+	intr_mod->cycles = cycles;
+
+	xcmd->cb.notify_host = xocl_kds_xgq_notify;
+	xcmd->cb.free = kds_free_command;
+	xcmd->priv = kds;
+	xcmd->type = KDS_ERT;
+	xcmd->opcode = OP_CONFIG;
+	xcmd->response = &resp;
+	xcmd->response_size = sizeof(resp);
+
+	ret = kds_submit_cmd_and_wait(kds, xcmd);
+	if (ret)
+		return ret;
+
+	/* Older ERT does not know the opcode, CU is not moderated */
+	if (resp.hdr.cstate != XGQ_CMD_STATE_COMPLETED || resp.rcode) {
+		userpf_info(xdev, "CU(%d) interrupt moderation not set cstate(%d) rcode(%d)",
+			    cu_idx, resp.hdr.cstate, resp.rcode);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
 static int xocl_kds_xgq_uncfg_cu(struct xocl_dev *xdev, u32 cu_idx, u32 cu_domain, bool full_reset)
 {
 	struct xgq_com_queue_entry resp = {};
@@ -2328,6 +2732,12 @@ static int xocl_kds_update_xgq(struct xocl_dev *xdev, int slot_hdl,
 		struct xgq_cmd_resp_query_cu resp;
 		void *xgq;
 
+		/* ERT knows the CU but never gets a command for it */
+		if (xocl_kds_host_sched_cu(xdev, &cu_info[i])) {
+			userpf_info(xdev, "CU(%d) is scheduled by host\n", cu_info[i].cu_idx);
+			continue;
+		}
+
 		ret = xocl_kds_xgq_query_cu(xdev, cu_info[i].cu_idx, 0, &resp);
 		if (ret)
 			goto create_regular_cu;
@@ -2364,6 +2774,9 @@ static int xocl_kds_update_xgq(struct xocl_dev *xdev, int slot_hdl,
 	xocl_kds_create_scus(xdev, scu_info, num_scus);
 
 	XDEV(xdev)->kds.xgq_enable = (cfg.ert)? true : false;
+	if (XDEV(xdev)->kds.intr_count > 1)
+		kds_set_intr_mod(&XDEV(xdev)->kds, XDEV(xdev)->kds.intr_count,
+				 XDEV(xdev)->kds.intr_cycles);
 	goto out;
 
 create_regular_cu:
@@ -11,6 +11,7 @@
 #include "kds_core.h"
 
 extern int kds_echo;
+extern int kds_arg_shadow;
 
 /* Attributes followed by bin_attributes. */
 /* -Attributes -- */
@@ -263,6 +264,26 @@ kds_echo_store(struct device *dev, struct device_attribute *da,
 }
 static DEVICE_ATTR(kds_echo, 0644, kds_echo_show, kds_echo_store);
 
+/* Only write changed arguments when starting ap_ctrl_chain CUs. CU arguments
+ * must not be written by other means (e.g. xclRegWrite) while enabled.
+ * Firmware picks up the setting on next xclbin download.
+ */
+static ssize_t
+kds_arg_shadow_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	return sprintf(buf, "%d\n", kds_arg_shadow);
+}
+
+static ssize_t
+kds_arg_shadow_store(struct device *dev, struct device_attribute *da,
+		     const char *buf, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+
+	return store_kds_echo(&XDEV(xdev)->kds, buf, count, &kds_arg_shadow);
+}
+static DEVICE_ATTR(kds_arg_shadow, 0644, kds_arg_shadow_show, kds_arg_shadow_store);
+
 static ssize_t
 kds_numcdmas_show(struct device *dev, struct device_attribute *attr, char *buf)
 {
@@ -362,6 +383,73 @@ static struct bin_attribute kds_custat_raw_attr = {
 	.size = 0
 };
 
+static ssize_t
+kds_culat_raw_show(struct file *filp, struct kobject *kobj,
+	struct bin_attribute *attr, char *buffer, loff_t offset, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(container_of(kobj, struct device, kobj));
+	ssize_t ret = 0;
+
+	mutex_lock(&xdev->dev_lock);
+	ret = show_kds_culat_raw(&XDEV(xdev)->kds, buffer, count, offset);
+	mutex_unlock(&xdev->dev_lock);
+
+	return ret;
+}
+
+static struct bin_attribute kds_culat_raw_attr = {
+	.attr = {
+		.name = "kds_culat_raw",
+		.mode = 0444
+	},
+	.read = kds_culat_raw_show,
+	.write = NULL,
+	.size = 0
+};
+
+static ssize_t
+kds_cubusy_raw_show(struct file *filp, struct kobject *kobj,
+	struct bin_attribute *attr, char *buffer, loff_t offset, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(container_of(kobj, struct device, kobj));
+	ssize_t ret = 0;
+
+	mutex_lock(&xdev->dev_lock);
+	ret = show_kds_cubusy_raw(&XDEV(xdev)->kds, buffer, count, offset);
+	mutex_unlock(&xdev->dev_lock);
+
+	return ret;
+}
+
+static struct bin_attribute kds_cubusy_raw_attr = {
+	.attr = {
+		.name = "kds_cubusy_raw",
+		.mode = 0444
+	},
+	.read = kds_cubusy_raw_show,
+	.write = NULL,
+	.size = 0
+};
+
+static ssize_t
+kds_client_stat_raw_show(struct file *filp, struct kobject *kobj,
+	struct bin_attribute *attr, char *buffer, loff_t offset, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(container_of(kobj, struct device, kobj));
+
+	return show_kds_client_stat_raw(&XDEV(xdev)->kds, buffer, count, offset);
+}
+
+static struct bin_attribute kds_client_stat_raw_attr = {
+	.attr = {
+		.name = "kds_client_stat_raw",
+		.mode = 0444
+	},
+	.read = kds_client_stat_raw_show,
+	.write = NULL,
+	.size = 0
+};
+
 static ssize_t
 kds_scustat_raw_show(struct file *filp, struct kobject *kobj,
 	struct bin_attribute *attr, char *buffer, loff_t offset, size_t count)
@@ -500,6 +588,131 @@ kds_interval_show(struct device *dev, struct device_attribute *attr, char *buf)
 }
 static DEVICE_ATTR(kds_interval, 0644, kds_interval_show, kds_interval_store);
 
+static ssize_t
+kds_cu_timestamp_store(struct device *dev, struct device_attribute *da,
+	       const char *buf, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+	bool enable;
+
+	if (kstrtobool(buf, &enable))
+		return -EINVAL;
+
+	XDEV(xdev)->kds.cu_timestamp = enable;
+
+	return count;
+}
+
+static ssize_t
+kds_cu_timestamp_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+
+	return sprintf(buf, "%d\n", XDEV(xdev)->kds.cu_timestamp);
+}
+static DEVICE_ATTR(kds_cu_timestamp, 0644, kds_cu_timestamp_show, kds_cu_timestamp_store);
+
+/* "<count> <cycles>", see struct xgq_cmd_cu_intr_mod. "0 0" disables */
+static ssize_t
+kds_intr_coalesce_store(struct device *dev, struct device_attribute *da,
+	       const char *buf, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+	u32 num, cycles;
+
+	if (sscanf(buf, "%u %u", &num, &cycles) != 2 || num > 0xFF)
+		return -EINVAL;
+
+	kds_set_intr_mod(&XDEV(xdev)->kds, num, cycles);
+
+	return count;
+}
+
+static ssize_t
+kds_intr_coalesce_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+
+	return sprintf(buf, "%u %u\n", XDEV(xdev)->kds.intr_count,
+		       XDEV(xdev)->kds.intr_cycles);
+}
+static DEVICE_ATTR(kds_intr_coalesce, 0644, kds_intr_coalesce_show, kds_intr_coalesce_store);
+
+/* Applied on next xclbin load, 0 lets ERT schedule all CUs */
+static ssize_t
+kds_host_cu_regmap_store(struct device *dev, struct device_attribute *da,
+	       const char *buf, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+	u32 size;
+
+	if (kstrtou32(buf, 10, &size) == -EINVAL)
+		return -EINVAL;
+
+	XDEV(xdev)->kds.host_cu_regmap = size;
+
+	return count;
+}
+
+static ssize_t
+kds_host_cu_regmap_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+
+	return sprintf(buf, "%u\n", XDEV(xdev)->kds.host_cu_regmap);
+}
+static DEVICE_ATTR(kds_host_cu_regmap, 0644, kds_host_cu_regmap_show, kds_host_cu_regmap_store);
+
+static ssize_t
+kds_cu_policy_store(struct device *dev, struct device_attribute *da,
+	       const char *buf, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+	int policy;
+
+	policy = kds_parse_cu_policy(buf);
+	if (policy < 0)
+		return policy;
+
+	WRITE_ONCE(XDEV(xdev)->kds.cu_mgmt.cu_policy, policy);
+
+	return count;
+}
+
+static ssize_t
+kds_cu_policy_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+
+	return sprintf(buf, "%s\n",
+		       kds_cu_policy_name(XDEV(xdev)->kds.cu_mgmt.cu_policy));
+}
+static DEVICE_ATTR(kds_cu_policy, 0644, kds_cu_policy_show, kds_cu_policy_store);
+
+static ssize_t
+kds_wake_window_store(struct device *dev, struct device_attribute *da,
+	       const char *buf, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+	u32 window;
+
+	if (kstrtou32(buf, 10, &window) == -EINVAL)
+		return -EINVAL;
+
+	kds_set_wake_window(&XDEV(xdev)->kds, window);
+
+	return count;
+}
+
+static ssize_t
+kds_wake_window_show(struct device *dev, struct device_attribute *attr, char *buf)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+
+	return sprintf(buf, "%u\n", XDEV(xdev)->kds.wake_window);
+}
+static DEVICE_ATTR(kds_wake_window, 0644, kds_wake_window_show, kds_wake_window_store);
+
 static ssize_t
 ert_disable_show(struct device *dev, struct device_attribute *attr, char *buf)
 {
@@ -625,6 +838,86 @@ static ssize_t dev_hotplug_done_store(struct device *dev,
 }
 static DEVICE_ATTR(dev_hotplug_done, 0644, dev_hotplug_done_show, dev_hotplug_done_store);
 
+/*
+ * Single sync_bo transfers of at least dma_stripe_threshold bytes are
+ * striped over up to dma_stripe_channels free DMA channels. Bytes moved
+ * per channel are reported by the DMA subdevice channel_stat_raw node.
+ */
+static ssize_t dma_stripe_threshold_show(struct device *dev,
+	struct device_attribute *attr, char *buf)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+
+	return sprintf(buf, "%llu\n", xdev->dma_stripe_threshold);
+}
+
+static ssize_t dma_stripe_threshold_store(struct device *dev,
+	struct device_attribute *da, const char *buf, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+	u64 val;
+
+	if (kstrtou64(buf, 0, &val))
+		return -EINVAL;
+
+	xdev->dma_stripe_threshold = val;
+	return count;
+}
+static DEVICE_ATTR(dma_stripe_threshold, 0644, dma_stripe_threshold_show,
+	dma_stripe_threshold_store);
+
+static ssize_t dma_stripe_channels_show(struct device *dev,
+	struct device_attribute *attr, char *buf)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+
+	return sprintf(buf, "%u\n", xdev->dma_stripe_channels);
+}
+
+static ssize_t dma_stripe_channels_store(struct device *dev,
+	struct device_attribute *da, const char *buf, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+	u32 val;
+
+	if (kstrtou32(buf, 10, &val) || val < 1)
+		return -EINVAL;
+
+	xdev->dma_stripe_channels = val;
+	return count;
+}
+static DEVICE_ATTR(dma_stripe_channels, 0644, dma_stripe_channels_show,
+	dma_stripe_channels_store);
+
+/*
+ * Writing a sample interval in ms enables the kernel clock governor,
+ * 0 disables it. Reading returns the interval and the current clock
+ * level in percent of the xclbin frequencies.
+ */
+static ssize_t clock_governor_ms_show(struct device *dev,
+	struct device_attribute *attr, char *buf)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+
+	return sprintf(buf, "%u %u\n", READ_ONCE(xdev->clk_gov.interval_ms),
+		READ_ONCE(xdev->clk_gov.level));
+}
+
+static ssize_t clock_governor_ms_store(struct device *dev,
+	struct device_attribute *da, const char *buf, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+	u32 val;
+
+	if (kstrtou32(buf, 10, &val))
+		return -EINVAL;
+
+	xocl_clk_gov_set_interval(xdev, val);
+	return count;
+}
+static DEVICE_ATTR(clock_governor_ms, 0644, clock_governor_ms_show,
+	clock_governor_ms_store);
+
 static ssize_t mig_calibration_show(struct device *dev,
 		struct device_attribute *attr, char *buf)
 {
@@ -931,6 +1224,15 @@ static ssize_t versal_show(struct device *dev,
 }
 static DEVICE_ATTR_RO(versal);
 
+static ssize_t subdev_probe_us_show(struct device *dev,
+	struct device_attribute *attr, char *buf)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(dev);
+
+	return xocl_subdev_probe_times(xdev, buf);
+}
+static DEVICE_ATTR_RO(subdev_probe_us);
+
 /* - End attributes-- */
 static struct attribute *xocl_attrs[] = {
 	&dev_attr_xclbinuuid.attr,
@@ -941,10 +1243,19 @@ static struct attribute *xocl_attrs[] = {
 	&dev_attr_memstat.attr,
 	&dev_attr_memstat_raw.attr,
 	&dev_attr_kds_echo.attr,
+	&dev_attr_kds_arg_shadow.attr,
+	&dev_attr_dma_stripe_threshold.attr,
+	&dev_attr_dma_stripe_channels.attr,
+	&dev_attr_clock_governor_ms.attr,
 	&dev_attr_kds_numcdmas.attr,
 	&dev_attr_kds_stat.attr,
 	&dev_attr_kds_interrupt.attr,
 	&dev_attr_kds_interval.attr,
+	&dev_attr_kds_cu_timestamp.attr,
+	&dev_attr_kds_intr_coalesce.attr,
+	&dev_attr_kds_host_cu_regmap.attr,
+	&dev_attr_kds_cu_policy.attr,
+	&dev_attr_kds_wake_window.attr,
 	&dev_attr_ert_disable.attr,
 	&dev_attr_dev_offline.attr,
 	&dev_attr_mig_calibration.attr,
@@ -966,6 +1277,7 @@ static struct attribute *xocl_attrs[] = {
 	&dev_attr_host_mem_size.attr,
 	&dev_attr_versal.attr,
 	&dev_attr_device_bad_state.attr,
+	&dev_attr_subdev_probe_us.attr,
 	NULL,
 };
 
@@ -1020,12 +1332,35 @@ static struct bin_attribute fdt_blob_attr = {
 	.size = 0
 };
 
+static ssize_t
+debug_ip_counters_show(struct file *filp, struct kobject *kobj,
+	struct bin_attribute *attr, char *buffer, loff_t offset, size_t count)
+{
+	struct xocl_dev *xdev = dev_get_drvdata(container_of(kobj, struct device, kobj));
+
+	return xocl_subdev_dbg_mon_read(xdev, buffer, count, offset);
+}
+
+static struct bin_attribute debug_ip_counters_attr = {
+	.attr = {
+		.name = "debug_ip_counters",
+		.mode = 0444
+	},
+	.read = debug_ip_counters_show,
+	.write = NULL,
+	.size = 0
+};
+
 static struct bin_attribute  *xocl_bin_attrs[] = {
 	&fdt_blob_attr,
 	&kds_custat_raw_attr,
 	&kds_scustat_raw_attr,
+	&kds_culat_raw_attr,
+	&kds_cubusy_raw_attr,
+	&kds_client_stat_raw_attr,
 	&kds_cuctx_stat_raw_attr,
 	&kds_scuctx_stat_raw_attr,
+	&debug_ip_counters_attr,
 	NULL,
 };
 
@@ -100,6 +100,8 @@ struct drm_xocl_bo {
 	struct dma_buf        *dmabuf;
 	const struct vm_operations_struct *dmabuf_vm_ops;
 	unsigned              dma_nsg;
+	/* DMA mapped copy of sgt kept across syncs, see xocl_bo_dma_sgt() */
+	struct sg_table       *dma_sgt;
 	unsigned              flags;
 	unsigned              mem_idx;
 	unsigned	      user_flags;
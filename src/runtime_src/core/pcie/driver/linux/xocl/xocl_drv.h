@@ -421,6 +421,7 @@ struct xocl_subdev {
 	int				pf;
 	struct cdev			*cdev;
 	bool				hold;
+	u64				probe_ns;
 
 	struct resource			*res;
 	char				*res_name;
@@ -501,6 +502,7 @@ struct xocl_pci_funcs {
 	int (*intr_register)(xdev_handle_t xdev, u32 intr,
 		irq_handler_t handler, void *arg);
 	int (*reset)(xdev_handle_t xdev);
+	int (*intr_affinity)(xdev_handle_t xdev, u32 intr, int cpu);
 };
 
 #define	XDEV(dev)	((struct xocl_dev_core *)(dev))
@@ -510,6 +512,9 @@ struct xocl_pci_funcs {
 	XDEV_PCIOPS(xdev)->intr_config(xdev, intr, en)
 #define	xocl_user_interrupt_reg(xdev, intr, handler, arg)	\
 	XDEV_PCIOPS(xdev)->intr_register(xdev, intr, handler, arg)
+#define	xocl_user_interrupt_affinity(xdev, intr, cpu)	\
+	(XDEV_PCIOPS(xdev)->intr_affinity ?			\
+	XDEV_PCIOPS(xdev)->intr_affinity(xdev, intr, cpu) : -ENODEV)
 #define xocl_reset(xdev)			\
 	(XDEV_PCIOPS(xdev)->reset ? XDEV_PCIOPS(xdev)->reset(xdev) : \
 	-ENODEV)
@@ -694,6 +699,17 @@ struct xocl_subdev_funcs {
 #define offline_cb common_funcs.offline
 #define online_cb common_funcs.online
 
+/*
+ * debug monitor callbacks, implemented by the AIM, AM, ASM, LAPC and
+ * SPC subdevs. Both fill a PAGE_SIZE buffer the same way as the
+ * subdev's name and counters/status sysfs nodes.
+ */
+struct xocl_dbg_mon_funcs {
+	struct xocl_subdev_funcs common_funcs;
+	ssize_t (*name)(struct platform_device *pdev, char *buf);
+	ssize_t (*values)(struct platform_device *pdev, char *buf);
+};
+
 /* rom callbacks */
 struct xocl_rom_funcs {
 	struct xocl_subdev_funcs common_funcs;
@@ -786,6 +802,8 @@ struct xocl_msix_funcs {
 	int (*user_intr_register)(struct platform_device *pdev, u32 intr,
 		irq_handler_t handler, void *arg, int event_fd);
 	int (*user_intr_unreg)(struct platform_device *pdev, u32 intr);
+	int (*user_intr_affinity)(struct platform_device *pdev, u32 intr,
+		int cpu);
 };
 #define MSIX_DEV(xdev)	\
 	(SUBDEV(xdev, XOCL_SUBDEV_MSIX) ? \
@@ -804,6 +822,9 @@ struct xocl_msix_funcs {
 #define xocl_msix_intr_unreg(xdev, irq)				\
 	(MSIX_CB(xdev, user_intr_unreg) ? MSIX_OPS(xdev)->user_intr_unreg(MSIX_DEV(xdev),	\
 	irq) : -ENODEV)
+#define xocl_msix_intr_affinity(xdev, irq, cpu)			\
+	(MSIX_CB(xdev, user_intr_affinity) ? MSIX_OPS(xdev)->user_intr_affinity(MSIX_DEV(xdev), \
+	irq, cpu) : -ENODEV)
 
 /* dma callbacks */
 struct xocl_dma_funcs {
@@ -813,7 +834,10 @@ struct xocl_dma_funcs {
 	ssize_t (*async_migrate_bo)(struct platform_device *pdev,
 		struct sg_table *sgt, u32 dir, u64 paddr, u32 channel, u64 sz,
 		void (*callback_fn)(unsigned long cb_hndl, int err), void *tx_ctx);
+	ssize_t (*migrate_mapped_bo)(struct platform_device *pdev,
+		struct sg_table *sgt, u32 dir, u64 paddr, u32 channel, u64 sz);
 	int (*ac_chan)(struct platform_device *pdev, u32 dir);
+	int (*try_ac_chan)(struct platform_device *pdev, u32 dir);
 	void (*rel_chan)(struct platform_device *pdev, u32 dir, u32 channel);
 	u32 (*get_chan_count)(struct platform_device *pdev);
 	u64 (*get_chan_stat)(struct platform_device *pdev, u32 channel,
@@ -823,6 +847,7 @@ struct xocl_dma_funcs {
 	int (*user_intr_register)(struct platform_device *pdev, u32 intr,
 					irq_handler_t handler, void *arg, int event_fd);
 	int (*user_intr_unreg)(struct platform_device *pdev, u32 intr);
+	int (*user_intr_affinity)(struct platform_device *pdev, u32 intr, int cpu);
 };
 
 #define DMA_DEV(xdev)	\
@@ -836,12 +861,19 @@ struct xocl_dma_funcs {
 #define	xocl_migrate_bo(xdev, sgt, to_dev, paddr, chan, len)	\
 	(DMA_CB(xdev, migrate_bo) ? DMA_OPS(xdev)->migrate_bo(DMA_DEV(xdev), \
 	sgt, to_dev, paddr, chan, len) : 0)
+#define	xocl_migrate_mapped_bo(xdev, sgt, to_dev, paddr, chan, len)	\
+	(DMA_CB(xdev, migrate_mapped_bo) ?				\
+	DMA_OPS(xdev)->migrate_mapped_bo(DMA_DEV(xdev), sgt, to_dev, paddr, \
+	chan, len) : -ENODEV)
 #define	xocl_async_migrate_bo(xdev, sgt, to_dev, paddr, chan, len, cb_fn, ctx_ptr)	\
 	(DMA_CB(xdev, async_migrate_bo) ? DMA_OPS(xdev)->async_migrate_bo(DMA_DEV(xdev), \
 	sgt, to_dev, paddr, chan, len, cb_fn, ctx_ptr) : 0)
 #define	xocl_acquire_channel(xdev, dir)		\
 	(DMA_CB(xdev, ac_chan) ? DMA_OPS(xdev)->ac_chan(DMA_DEV(xdev), dir) : \
 	-ENODEV)
+#define	xocl_try_acquire_channel(xdev, dir)		\
+	(DMA_CB(xdev, try_ac_chan) ? DMA_OPS(xdev)->try_ac_chan(DMA_DEV(xdev), \
+	dir) : -ENODEV)
 #define	xocl_release_channel(xdev, dir, chan)	\
 	(DMA_CB(xdev, rel_chan) ? DMA_OPS(xdev)->rel_chan(DMA_DEV(xdev), dir, \
 	chan) : NULL)
@@ -860,6 +892,9 @@ struct xocl_dma_funcs {
 #define xocl_dma_intr_unreg(xdev, irq)				\
 	(DMA_CB(xdev, user_intr_unreg) ? DMA_OPS(xdev)->user_intr_unreg(DMA_DEV(xdev),	\
 	irq) : -ENODEV)
+#define xocl_dma_intr_affinity(xdev, irq, cpu)			\
+	(DMA_CB(xdev, user_intr_affinity) ? DMA_OPS(xdev)->user_intr_affinity(DMA_DEV(xdev), \
+	irq, cpu) : -ENODEV)
 
 /* sysmon callbacks */
 enum {
@@ -1431,6 +1466,8 @@ struct xocl_icap_funcs {
 		unsigned int region, unsigned short *freqs, int num_freqs);
 	int (*ocl_get_freq)(struct platform_device *pdev,
 		unsigned int region, unsigned short *freqs, int num_freqs);
+	int (*ocl_get_freq_max)(struct platform_device *pdev,
+		unsigned short *freqs, int num_freqs);
 	int (*ocl_update_clock_freq_topology)(struct platform_device *pdev, struct xclmgmt_ioc_freqscaling *freqs);
 	int (*xclbin_validate_clock_req)(struct platform_device *pdev, struct drm_xocl_reclock_info *freqs);
 	int (*ocl_lock_bitstream)(struct platform_device *pdev,
@@ -1488,6 +1525,10 @@ enum {
 	(ICAP_CB(xdev, ocl_get_freq) ?					\
 	ICAP_OPS(xdev)->ocl_get_freq(ICAP_DEV(xdev), region, freqs, num) : \
 	-ENODEV)
+#define	xocl_icap_ocl_get_freq_max(xdev, freqs, num)			\
+	(ICAP_CB(xdev, ocl_get_freq_max) ?				\
+	ICAP_OPS(xdev)->ocl_get_freq_max(ICAP_DEV(xdev), freqs, num) :	\
+	-ENODEV)
 #define	xocl_icap_ocl_update_clock_freq_topology(xdev, freqs)		\
 	(ICAP_CB(xdev, ocl_update_clock_freq_topology) ?		\
 	ICAP_OPS(xdev)->ocl_update_clock_freq_topology(ICAP_DEV(xdev), freqs) :\
@@ -1892,6 +1933,7 @@ struct xocl_intc_funcs {
 	int (*csr_read32)(struct platform_device *pdev, u32 off);
 	void (*csr_write32)(struct platform_device *pdev, u32 val, u32 off);
 	void __iomem *(*get_csr_base)(struct platform_device *pdev);
+	int (*intr_affinity)(struct platform_device *pdev, int id, int cpu, int mode);
 };
 #define	INTC_DEV(xdev)	\
 	(SUBDEV(xdev, XOCL_SUBDEV_INTC) ? \
@@ -1917,6 +1959,10 @@ struct xocl_intc_funcs {
 	(INTC_CB(xdev, config_intr) ? \
 	 INTC_OPS(xdev)->config_intr(INTC_DEV(xdev), id, en, CU_INTR) : \
 	 -ENODEV)
+#define xocl_intc_cu_affinity(xdev, id, cpu) \
+	(INTC_CB(xdev, intr_affinity) ? \
+	 INTC_OPS(xdev)->intr_affinity(INTC_DEV(xdev), id, cpu, CU_INTR) : \
+	 -ENODEV)
 #define xocl_intc_set_mode(xdev, mode) \
 	(INTC_CB(xdev, sel_ert_intr) ? \
 	 INTC_OPS(xdev)->sel_ert_intr(INTC_DEV(xdev), mode) : \
@@ -2389,6 +2435,9 @@ struct xocl_m2m_funcs {
 		uint32_t size);
 	void (*get_host_bank)(struct platform_device *pdev, u64 *addr,
 		u64 *size, u8 *used);
+	int (*queue_copy)(struct platform_device *pdev,
+		struct kds_command *xcmd);
+	void (*flush_client)(struct platform_device *pdev, void *client);
 };
 #define	M2M_DEV(xdev)	\
 	(SUBDEV(xdev, XOCL_SUBDEV_M2M) ? \
@@ -2403,6 +2452,12 @@ struct xocl_m2m_funcs {
 #define xocl_m2m_host_bank(xdev, addr, size, used)				\
 	(M2M_CB(xdev) ? M2M_OPS(xdev)->get_host_bank(M2M_DEV(xdev),	\
 	addr, size, used) : -ENODEV)
+#define	xocl_m2m_queue_copy(xdev, xcmd)					\
+	(M2M_CB(xdev) ? M2M_OPS(xdev)->queue_copy(M2M_DEV(xdev), xcmd) :	\
+	-ENODEV)
+#define	xocl_m2m_flush_client(xdev, client)				\
+	(M2M_CB(xdev) ? M2M_OPS(xdev)->flush_client(M2M_DEV(xdev), client) :\
+	(void)0)
 
 struct xocl_pcie_firewall_funcs {
 	struct xocl_subdev_funcs common_funcs;
@@ -2432,6 +2487,9 @@ int xocl_subdev_reserve(xdev_handle_t xdev_hdl,
 int xocl_subdev_create_by_id(xdev_handle_t xdev_hdl, int id);
 int xocl_subdev_create_by_level(xdev_handle_t xdev_hdl, int level);
 int xocl_subdev_create_all(xdev_handle_t xdev_hdl);
+ssize_t xocl_subdev_probe_times(xdev_handle_t xdev_hdl, char *buf);
+ssize_t xocl_subdev_dbg_mon_read(xdev_handle_t xdev_hdl, char *buf,
+	size_t size, loff_t offset);
 void xocl_subdev_destroy_all(xdev_handle_t xdev_hdl);
 int xocl_subdev_offline_all(xdev_handle_t xdev_hdl);
 int xocl_subdev_offline_by_id(xdev_handle_t xdev_hdl, u32 id);
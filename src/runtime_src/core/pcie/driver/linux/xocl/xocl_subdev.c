@@ -586,6 +586,7 @@ static int __xocl_subdev_create(xdev_handle_t xdev_hdl,
 	struct resource *res = NULL;
 	int i, retval;
 	uint32_t dev_idx = 0;
+	ktime_t start;
 
 	retval = __xocl_subdev_reserve(xdev_hdl, sdev_info, &subdev);
 	if ((retval && retval != -EEXIST) ||
@@ -645,6 +646,7 @@ static int __xocl_subdev_create(xdev_handle_t xdev_hdl,
 	subdev->hold = true;
 	xocl_unlock_xdev(xdev_hdl);
 
+	start = ktime_get();
 	retval = platform_device_add(subdev->pldev);
 	if (retval) {
 		xocl_lock_xdev(xdev_hdl);
@@ -678,6 +680,7 @@ static int __xocl_subdev_create(xdev_handle_t xdev_hdl,
 		subdev->ops = NULL;
 		return -EAGAIN;
 	}
+	subdev->probe_ns = ktime_to_ns(ktime_sub(ktime_get(), start));
 	xocl_drvinst_set_offline(platform_get_drvdata(subdev->pldev), false);
 	xocl_lock_xdev(xdev_hdl);
 	subdev->hold = false;
@@ -1012,6 +1015,111 @@ void xocl_subdev_destroy_all(xdev_handle_t xdev_hdl)
 	xocl_unlock_xdev(xdev_hdl);
 }
 
+/*
+ * Report how long adding and probing (or onlining) each subdev took,
+ * one "name inst usecs" line per subdev. Used to find the subdevs
+ * that dominate driver load and reset recovery time.
+ */
+ssize_t xocl_subdev_probe_times(xdev_handle_t xdev_hdl, char *buf)
+{
+	struct xocl_dev_core *core = (struct xocl_dev_core *)xdev_hdl;
+	struct xocl_subdev *subdev;
+	ssize_t count = 0;
+	int i, j;
+
+	xocl_lock_xdev(xdev_hdl);
+	for (i = 0; i < XOCL_SUBDEV_NUM; i++) {
+		if (!core->subdevs[i])
+			continue;
+		for (j = 0; j < XOCL_SUBDEV_MAX_INST; j++) {
+			subdev = core->subdevs[i][j];
+			if (!subdev || subdev->state < XOCL_SUBDEV_STATE_ADDED)
+				continue;
+			count += scnprintf(buf + count, PAGE_SIZE - count,
+				"%s %d %llu\n", subdev->info.name, subdev->inst,
+				div_u64(subdev->probe_ns, NSEC_PER_USEC));
+		}
+	}
+	xocl_unlock_xdev(xdev_hdl);
+
+	return count;
+}
+
+static ssize_t xocl_dbg_mon_line(struct xocl_subdev *subdev, char *scratch,
+	char *line, size_t size)
+{
+	struct xocl_dbg_mon_funcs *ops = (struct xocl_dbg_mon_funcs *)subdev->ops;
+	ssize_t name_sz, val_sz, i;
+
+	name_sz = ops->name(subdev->pldev, scratch);
+	val_sz = ops->values(subdev->pldev, scratch + PAGE_SIZE);
+	if (name_sz <= 0 || val_sz <= 0)
+		return 0;
+
+	/* one value per line in sysfs, one monitor per line here */
+	for (i = 0; i < val_sz - 1; i++) {
+		if (scratch[PAGE_SIZE + i] == '\n')
+			scratch[PAGE_SIZE + i] = ' ';
+	}
+
+	return scnprintf(line, size, "%.*s %.*s", (int)strcspn(scratch, "\n"),
+		scratch, (int)val_sz, scratch + PAGE_SIZE);
+}
+
+/*
+ * Read the name and counters of all debug monitors in one go, one
+ * "name v0 v1 ..." line per monitor, so that tools need not open two
+ * sysfs nodes per monitor. Same offset handling as
+ * show_kds_culat_raw(), monitors are read again on each call.
+ */
+ssize_t xocl_subdev_dbg_mon_read(xdev_handle_t xdev_hdl, char *buf,
+	size_t size, loff_t offset)
+{
+	static const int mon_ids[] = {
+		XOCL_SUBDEV_AIM,
+		XOCL_SUBDEV_AM,
+		XOCL_SUBDEV_ASM,
+		XOCL_SUBDEV_LAPC,
+		XOCL_SUBDEV_SPC,
+	};
+	struct xocl_dev_core *core = (struct xocl_dev_core *)xdev_hdl;
+	struct xocl_subdev *subdev;
+	char *scratch, *line;
+	ssize_t all_sz = 0, line_sz, sz = 0;
+	int i, j;
+
+	scratch = vzalloc(3 * PAGE_SIZE);
+	if (!scratch)
+		return -ENOMEM;
+	line = scratch + 2 * PAGE_SIZE;
+
+	xocl_lock_xdev(xdev_hdl);
+	for (i = 0; i < ARRAY_SIZE(mon_ids); i++) {
+		if (!core->subdevs[mon_ids[i]])
+			continue;
+		for (j = 0; j < XOCL_SUBDEV_MAX_INST; j++) {
+			subdev = core->subdevs[mon_ids[i]][j];
+			if (!subdev || !subdev->ops ||
+			    subdev->state != XOCL_SUBDEV_STATE_ACTIVE)
+				continue;
+
+			line_sz = xocl_dbg_mon_line(subdev, scratch, line,
+				PAGE_SIZE);
+			all_sz += line_sz;
+			if (all_sz > offset) {
+				if (sz + line_sz > size)
+					goto out;
+				sz += scnprintf(buf + sz, size - sz, "%s", line);
+			}
+		}
+	}
+out:
+	xocl_unlock_xdev(xdev_hdl);
+	vfree(scratch);
+
+	return sz;
+}
+
 void xocl_subdev_destroy_by_level(xdev_handle_t xdev_hdl, int level)
 {
 	struct xocl_dev_core *core = (struct xocl_dev_core *)xdev_hdl;
@@ -1132,6 +1240,7 @@ static int __xocl_subdev_online(xdev_handle_t xdev_hdl,
 {
 	struct xocl_subdev_funcs *subdev_funcs;
 	int ret = 0;
+	ktime_t start;
 
 	BUG_ON(!subdev);
 	/* UNINIT state means subdev does not exist. exist without error in this case */
@@ -1151,6 +1260,7 @@ static int __xocl_subdev_online(xdev_handle_t xdev_hdl,
 	subdev->hold = true;
 	xocl_unlock_xdev(xdev_hdl);
 
+	start = ktime_get();
 	if (subdev_funcs && subdev_funcs->online) {
 		ret = subdev_funcs->online(subdev->pldev);
 		if (ret)
@@ -1186,6 +1296,7 @@ static int __xocl_subdev_online(xdev_handle_t xdev_hdl,
 				goto failed;
 		}
 	}
+	subdev->probe_ns = ktime_to_ns(ktime_sub(ktime_get(), start));
 	xocl_lock_xdev(xdev_hdl);
 	subdev->hold = false;
 
@@ -0,0 +1,84 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Tracepoints for BO sync and DMA transfers of xocl
+ *
+ * Copyright (C) 2024 Advanced Micro Devices, Inc.
+ *
+ * This software is licensed under the terms of the GNU General Public
+ * License version 2, as published by the Free Software Foundation, and
+ * may be copied, distributed, and modified under those terms.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM xocl
+
+#if !defined(_XOCL_TRACE_H) || defined(TRACE_HEADER_MULTI_READ)
+#define _XOCL_TRACE_H
+
+#include <linux/tracepoint.h>
+
+TRACE_EVENT(xocl_sync_bo,
+	TP_PROTO(u32 handle, u32 dir, u64 offset, u64 size),
+	TP_ARGS(handle, dir, offset, size),
+	TP_STRUCT__entry(
+		__field(u32, handle)
+		__field(u32, dir)
+		__field(u64, offset)
+		__field(u64, size)
+	),
+	TP_fast_assign(
+		__entry->handle = handle;
+		__entry->dir = dir;
+		__entry->offset = offset;
+		__entry->size = size;
+	),
+	TP_printk("bo=%u to_dev=%u offset=0x%llx size=%llu",
+		  __entry->handle, __entry->dir, __entry->offset,
+		  __entry->size)
+);
+
+DECLARE_EVENT_CLASS(xocl_dma,
+	TP_PROTO(u32 channel, u32 dir, u64 paddr, s64 len),
+	TP_ARGS(channel, dir, paddr, len),
+	TP_STRUCT__entry(
+		__field(u32, channel)
+		__field(u32, dir)
+		__field(u64, paddr)
+		__field(s64, len)
+	),
+	TP_fast_assign(
+		__entry->channel = channel;
+		__entry->dir = dir;
+		__entry->paddr = paddr;
+		__entry->len = len;
+	),
+	TP_printk("chan=%u to_dev=%u paddr=0x%llx len=%lld",
+		  __entry->channel, __entry->dir, __entry->paddr,
+		  __entry->len)
+);
+
+/* len is the requested transfer size */
+DEFINE_EVENT(xocl_dma, xocl_dma_submit,
+	TP_PROTO(u32 channel, u32 dir, u64 paddr, s64 len),
+	TP_ARGS(channel, dir, paddr, len)
+);
+
+/* len is the transferred size or a negative error */
+DEFINE_EVENT(xocl_dma, xocl_dma_complete,
+	TP_PROTO(u32 channel, u32 dir, u64 paddr, s64 len),
+	TP_ARGS(channel, dir, paddr, len)
+);
+
+#endif /* _XOCL_TRACE_H */
+
+/* Found through the xocl root include path of the modules */
+#undef TRACE_INCLUDE_PATH
+#define TRACE_INCLUDE_PATH .
+#undef TRACE_INCLUDE_FILE
+#define TRACE_INCLUDE_FILE xocl_trace
+#include <trace/define_trace.h>
@@ -292,3 +292,37 @@ enum MEM_TAG convert_mem_tag(const char *name)
 
 	return mem_tag;
 }
+
+/*
+ * Device memory is kept across an xclbin reload only when the incoming
+ * mem_topology describes the same device banks. Host memory entries
+ * may differ, the host buffers are not affected by the reload. The mgmt
+ * PF (which puts DDR in self-refresh) and the user PF (which keeps the
+ * BOs) must use the same test, or BOs survive while their content does
+ * not.
+ */
+bool xocl_mem_topo_retainable(const struct mem_topology *cur,
+	const struct mem_topology *next, size_t next_size)
+{
+	const struct mem_data *mem;
+	int i, j;
+
+	if (!cur || !next || next_size < sizeof_sect(next, m_mem_data) ||
+	    cur->m_count != next->m_count)
+		return false;
+
+	for (i = 0; i < cur->m_count; i++) {
+		mem = &cur->m_mem_data[i];
+		if (convert_mem_tag(mem->m_tag) == MEM_TAG_HOST)
+			continue;
+
+		for (j = 0; j < next->m_count; j++) {
+			if (!memcmp(mem, &next->m_mem_data[j], sizeof(*mem)))
+				break;
+		}
+		if (j == next->m_count)
+			return false;
+	}
+
+	return true;
+}
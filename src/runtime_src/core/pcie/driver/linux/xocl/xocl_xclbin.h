@@ -44,5 +44,7 @@ enum MEM_TAG {
 };
 
 enum MEM_TAG convert_mem_tag(const char *name);
+bool xocl_mem_topo_retainable(const struct mem_topology *cur,
+	const struct mem_topology *next, size_t next_size);
 
 #endif
@@ -140,8 +140,19 @@ static int xocl_xgq_handle_resp(struct xocl_xgq *xgq, int client_id, u64 resp_ad
 	if (client->xxc_prot & XGQ_PROT_NEED_RESP) {
 		xocl_xgq_read_queue((u32 *)&xcmd->rcode, (u32 __iomem *)&resp->rcode, sizeof(xcmd->rcode)/4);
 		xocl_xgq_read_queue((u32 *)&xcmd->status, (u32 __iomem *)&resp->result, sizeof(xcmd->status)/4);
-	} else
+	} else {
 		xcmd->status = KDS_COMPLETED;
+		/* Entry is only read if the command asked for ERT timestamps */
+		if (unlikely(xcmd->fw_timestamp_enabled)) {
+			struct xgq_cmd_resp_cuidx cu_resp;
+
+			xocl_xgq_read_queue((u32 *)&cu_resp, (u32 __iomem *)resp, sizeof(cu_resp)/4);
+			if (cu_resp.hdr.specific) {
+				xcmd->fw_cu_start = cu_resp.cu_start;
+				xcmd->fw_cu_done = cu_resp.cu_done;
+			}
+		}
+	}
 	*status = xcmd->status;
 	list_move_tail(&xcmd->list, &client->xxc_completed);
 	client->xxc_num_submit--;
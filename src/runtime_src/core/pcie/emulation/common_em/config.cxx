@@ -85,6 +85,9 @@ namespace xclemulation{
     mIsPlatformDataAvailable = false;
     mIsDisabledHostBuffer = false;
     mIsFasterNocDDRAccessEnabled = true;
+    mIsShmDataPlaneEnabled = true;
+    mIsKernelCtrlBatchEnabled = true;
+    mCheckpointDir = "";
   }
 
   static bool getBoolValue(std::string& value,bool defaultValue)
@@ -257,6 +260,19 @@ namespace xclemulation{
       {
         mIsFasterNocDDRAccessEnabled = getBoolValue(value, true);
       }
+      else if(name == "shm_data_plane")
+      {
+        mIsShmDataPlaneEnabled = getBoolValue(value, true);
+      }
+      else if(name == "kernel_ctrl_batch")
+      {
+        mIsKernelCtrlBatchEnabled = getBoolValue(value, true);
+      }
+      else if (name == "checkpoint_dir") {
+        // The directory is created on the first save, so it need not exist
+        if (!value.empty())
+          mCheckpointDir = std::filesystem::absolute(value).string();
+      }
       else if(name == "packet_size")
       {
         unsigned int packetSize = strtoll(value.c_str(),NULL,0);
@@ -318,6 +318,9 @@ struct sParseLog
       inline bool getIsPlatformEnabled() { return mIsPlatformDataAvailable;}
       inline bool isDisabledHostBUffer() { return mIsDisabledHostBuffer;}
       inline bool isFastNocDDRAccessEnabled() { return mIsFasterNocDDRAccessEnabled;}
+      inline bool isShmDataPlaneEnabled() const { return mIsShmDataPlaneEnabled;}
+      inline bool isKernelCtrlBatchEnabled() const { return mIsKernelCtrlBatchEnabled;}
+      inline std::string getCheckpointDir() const { return mCheckpointDir;}
       void populateEnvironmentSetup(std::map<std::string,std::string>& mEnvironmentNameValueMap);
 
     private:
@@ -355,6 +358,9 @@ struct sParseLog
       bool mIsPlatformDataAvailable;
       bool mIsDisabledHostBuffer;
       bool mIsFasterNocDDRAccessEnabled;
+      bool mIsShmDataPlaneEnabled;
+      bool mIsKernelCtrlBatchEnabled;
+      std::string mCheckpointDir;
       TIMEOUT_SCALE mTimeOutScale;
       config();
       ~config() { };//empty destructor
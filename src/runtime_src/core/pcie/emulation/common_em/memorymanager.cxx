@@ -19,10 +19,10 @@
 namespace xclemulation {
   MemoryManager::MemoryManager(uint64_t size, uint64_t start,
       unsigned alignment,std::string& tag ) : mSize(size), mStart(start), mAlignment(alignment), mTag(tag),
-  mCoalesceThreshold(4), mFreeSize(0)
+  mFreeSize(0)
   {
     assert(start % alignment == 0);
-    mFreeBufferList.push_back(std::make_pair(mStart, mSize));
+    insertFree(mStart, mSize);
     mFreeSize = mSize;
   }
 
@@ -80,100 +80,78 @@ namespace xclemulation {
 	    }
     }
 
-    for (PairList::iterator i = mFreeBufferList.begin(), e = mFreeBufferList.end(); i != e; ++i) 
-    {
-      if (i->second < size)
-        continue;
-      result = i->first;
-      if (i->second > size) 
-      {
-        // Resize the existing entry in freelist
-        i->first += size;
-        i->second -= size;
-      }
-      else 
-      {
-        // remove the exact match found
-        mFreeBufferList.erase(i);
-      }
-      mBusyBufferList.push_back(std::make_pair(result, size));
-      mFreeSize -= size;
-      break;
+    // Best fit, the smallest free range that holds size, lowest
+    // address among equally sized ranges
+    auto fit = mFreeBySize.lower_bound(std::make_pair(static_cast<uint64_t>(size), static_cast<uint64_t>(0)));
+    if (fit == mFreeBySize.end())
+      return result;
+
+    result = fit->second;
+    const uint64_t freeSize = fit->first;
+    eraseFree(mFreeBufferMap.find(result));
+    if (freeSize > size) {
+      // Return the tail of the range to the free lists, its
+      // neighbours are busy so there is nothing to coalesce
+      mFreeBufferMap.emplace(result + size, freeSize - size);
+      mFreeBySize.emplace(freeSize - size, result + size);
     }
+    mBusyBufferMap.emplace(result, size);
+    mFreeSize -= size;
     return result;
   }
 
   void MemoryManager::free(uint64_t buf)
   {
     std::lock_guard<std::mutex> lock(mMemManagerMutex);
-    PairList::iterator i = find(buf);
-    if (i == mBusyBufferList.end())
+    auto i = mBusyBufferMap.find(buf);
+    if (i == mBusyBufferMap.end())
       return;
     mFreeSize += i->second;
-    mFreeBufferList.push_back(std::make_pair(i->first, i->second));
-    mBusyBufferList.erase(i);
-    if (mFreeBufferList.size() > mCoalesceThreshold) {
-      coalesce();
-    }
+    insertFree(i->first, i->second);
+    mBusyBufferMap.erase(i);
   }
 
-
-  void MemoryManager::coalesce()
+  void MemoryManager::eraseFree(std::map<uint64_t, uint64_t>::iterator itr)
   {
-    // First sort the free buffers and then attempt to coalesce the neighbors
-    mFreeBufferList.sort();
-
-    PairList::iterator curr = mFreeBufferList.begin();
-    PairList::iterator next = curr;
-    ++next;
-    PairList::iterator last = mFreeBufferList.end();
-    while (next != last) {
-      if ((curr->first + curr->second) != next->first) {
-        // Non contiguous blocks
-        curr = next;
-        ++next;
-        continue;
-      }
-      // Coalesce curr and next
-      curr->second += next->second;
-      mFreeBufferList.erase(next);
-      next = curr;
-      ++next;
-    }
+    mFreeBySize.erase(std::make_pair(itr->second, itr->first));
+    mFreeBufferMap.erase(itr);
   }
 
-
-  MemoryManager::PairList::iterator MemoryManager::find(uint64_t buf)
+  // Insert a free range, coalescing it with adjacent free ranges
+  void MemoryManager::insertFree(uint64_t start, uint64_t size)
   {
-#if GCC_VERSION >= 40800
-    PairList::iterator i = std::find_if(mBusyBufferList.begin(), mBusyBufferList.end(), [&] (const PairList::value_type& s)
-        { return s.first == buf; });
-#else
-    PairList::iterator i = mBusyBufferList.begin();
-    PairList::iterator last  = mBusyBufferList.end();
-    while(i != last) {
-      if (i->first == buf)
-        break;
-      ++i;
+    auto next = mFreeBufferMap.lower_bound(start);
+    if (next != mFreeBufferMap.begin()) {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == start) {
+        start = prev->first;
+        size += prev->second;
+        eraseFree(prev);
+      }
     }
-#endif
-    return i;
+    if (next != mFreeBufferMap.end() && start + size == next->first) {
+      size += next->second;
+      eraseFree(next);
+    }
+    mFreeBufferMap.emplace(start, size);
+    mFreeBySize.emplace(size, start);
   }
 
   void MemoryManager::reset()
   {
     std::lock_guard<std::mutex> lock(mMemManagerMutex);
-    mFreeBufferList.clear();
-    mBusyBufferList.clear();
-    mFreeBufferList.push_back(std::make_pair(mStart, mSize));
-    mFreeSize = 0;
+    mFreeBufferMap.clear();
+    mFreeBySize.clear();
+    mBusyBufferMap.clear();
+    insertFree(mStart, mSize);
+    mFreeSize = mSize;
   }
 
   std::pair<uint64_t, uint64_t> MemoryManager::lookup(uint64_t buf)
   {
     std::lock_guard<std::mutex> lock(mMemManagerMutex);
-    PairList::iterator i = find(buf);
-    if (i != mBusyBufferList.end())
+    auto i = mBusyBufferMap.find(buf);
+    if (i != mBusyBufferMap.end())
       return *i;
     // Compiler bug -- Some versions of GCC C++11 compiler do not
     // like mNull directly inside std::make_pair, so capture mNull
@@ -182,4 +160,3 @@ namespace xclemulation {
     return std::make_pair(v, v);
   }
 }
-
@@ -20,6 +20,7 @@
 #include <mutex>
 #include <list>
 #include <map>
+#include <set>
 #include <cassert>
 #include <algorithm>
 
@@ -30,20 +31,27 @@ namespace xclemulation
 {
 static std::map<uint64_t,uint64_t> DEFAULT_MAP;
 static std::string DEFAULT_TAG("");
+    // class MemoryManager - device memory range allocator
+    //
+    // Free ranges are indexed both by address, for coalescing with
+    // the neighbours of a freed range, and by size, for a best fit
+    // allocation.  Busy ranges are indexed by address.  Allocation,
+    // free and lookup are O(log n) in the number of ranges.
     class MemoryManager 
     {
         std::mutex mMemManagerMutex;
-        std::list<std::pair<uint64_t, uint64_t> > mFreeBufferList;
-        std::list<std::pair<uint64_t, uint64_t> > mBusyBufferList;
+        // free ranges, start -> size
+        std::map<uint64_t, uint64_t> mFreeBufferMap;
+        // free ranges ordered by (size, start)
+        std::set<std::pair<uint64_t, uint64_t> > mFreeBySize;
+        // busy ranges, start -> size
+        std::map<uint64_t, uint64_t> mBusyBufferMap;
         uint64_t mSize;
         uint64_t mStart;
         uint64_t mAlignment;
 	std::string mTag;
-        const unsigned mCoalesceThreshold;
         uint64_t mFreeSize;
 
-        typedef std::list<std::pair<uint64_t, uint64_t> > PairList;
-
     public:
 	static const uint64_t mNull = 0xffffffffffffffffull;
 	std::list<MemoryManager*> mChildMemories;
@@ -64,8 +72,8 @@ static std::string DEFAULT_TAG("");
         std::pair<uint64_t, uint64_t>lookup(uint64_t buf);
 
     private:
-        void coalesce();
-        PairList::iterator find(uint64_t buf);
+        void insertFree(uint64_t start, uint64_t size);
+        void eraseFree(std::map<uint64_t, uint64_t>::iterator itr);
     };
 }
 
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#ifndef _WINDOWS
+
+#include "shm_data_plane.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace xclemulation {
+
+shm_data_plane::
+shm_data_plane(size_t size)
+  : m_size(size)
+{
+#ifdef MFD_CLOEXEC
+  m_fd = memfd_create("xrt_em_data_plane", MFD_CLOEXEC);
+#else
+  std::string name = "/xrt_em_data_plane_" + std::to_string(getpid());
+  m_fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (m_fd >= 0)
+    shm_unlink(name.c_str());
+#endif
+  if (m_fd < 0)
+    throw std::runtime_error(std::string("data plane: failed to create shared memory: ") + std::strerror(errno));
+
+  if (ftruncate(m_fd, m_size) == -1) {
+    close(m_fd);
+    throw std::runtime_error(std::string("data plane: ftruncate failed: ") + std::strerror(errno));
+  }
+
+  m_data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (m_data == MAP_FAILED) {
+    close(m_fd);
+    throw std::runtime_error(std::string("data plane: mmap failed: ") + std::strerror(errno));
+  }
+
+  // The descriptor is not inherited, the device process opens the
+  // buffer through the shim's descriptor table
+  m_path = "/proc/" + std::to_string(getpid()) + "/fd/" + std::to_string(m_fd);
+}
+
+shm_data_plane::
+~shm_data_plane()
+{
+  munmap(m_data, m_size);
+  close(m_fd);
+}
+
+std::unique_ptr<shm_data_plane>
+shm_data_plane::
+create(size_t size)
+{
+  try {
+    return std::make_unique<shm_data_plane>(size);
+  }
+  catch (const std::exception&) {
+    return nullptr;
+  }
+}
+
+} // xclemulation
+
+#endif
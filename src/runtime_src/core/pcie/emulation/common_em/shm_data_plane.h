@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#ifndef _XCL_SHM_DATA_PLANE_H_
+#define _XCL_SHM_DATA_PLANE_H_
+
+#ifndef _WINDOWS
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace xclemulation {
+
+// class shm_data_plane - shared memory buffer for bulk copies
+//
+// Buffer copies between the shim and the simulation process carry
+// their payload in a memfd backed shared buffer, the socket only
+// carries the control message.  The buffer is offered to the device
+// process with the first copy message (shm_path, shm_size) which
+// still carries its payload inline.  A device process that supports
+// the data plane maps the buffer and sets shm_ack in its response,
+// from then on copies set shm and leave the inline payload empty.
+// A device process that does not know about the data plane ignores
+// the offer and copies continue to go over the socket.
+//
+// The buffer is a single staging area of at most one packet, access
+// is serialized by the socket mutex of the RPC call.
+class shm_data_plane
+{
+  int m_fd = -1;
+  void* m_data = nullptr;
+  size_t m_size = 0;
+  std::string m_path;
+  bool m_offered = false;
+  bool m_accepted = false;
+
+public:
+  explicit shm_data_plane(size_t size);
+  ~shm_data_plane();
+
+  shm_data_plane(const shm_data_plane&) = delete;
+  shm_data_plane& operator=(const shm_data_plane&) = delete;
+
+  // Create a data plane, returns nullptr if shared memory is not
+  // available in which case copies use the socket
+  static std::unique_ptr<shm_data_plane>
+  create(size_t size);
+
+  void*
+  data() const
+  {
+    return m_data;
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  // Path the device process opens to map the buffer
+  const std::string&
+  path() const
+  {
+    return m_path;
+  }
+
+  // True if the buffer should be offered with the next message
+  bool
+  offer()
+  {
+    if (m_offered)
+      return false;
+    m_offered = true;
+    return true;
+  }
+
+  void
+  accept()
+  {
+    m_accepted = true;
+  }
+
+  // True if a payload of size bytes can go through the buffer
+  bool
+  usable(size_t sz) const
+  {
+    return m_accepted && sz <= m_size;
+  }
+};
+
+} // xclemulation
+
+#endif
+
+#endif
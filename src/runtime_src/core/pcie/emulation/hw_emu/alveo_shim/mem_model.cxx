@@ -16,9 +16,15 @@
 
 #include "mem_model.h"
 
+#include <filesystem>
+
+#include <sys/mman.h>
+
 mem_model::~ mem_model()
 {
   serialize();
+  for (auto& seg : mSegments)
+    munmap(seg.second, SEGMENTSIZE);
 }
 
 mem_model::mem_model(std::string deviceName):
@@ -37,7 +43,7 @@ mem_model::mem_model(std::string deviceName):
       while(written_bytes < size){
           uint64_t src_offset = written_bytes;
 
-          unsigned char* page_ptr  = get_page(addr);
+          unsigned char* page_ptr  = get_page(addr, true);
           uint64_t       page_addr = addr & ~( ~uint64_t(0) << ADDRBITS);
 
           unsigned char* dest_buf_ptr = page_ptr + page_addr;
@@ -84,10 +90,9 @@ mem_model::mem_model(std::string deviceName):
 	  while(read_bytes < size){
 		  uint64_t dest_offset = read_bytes;
 
-		  unsigned char* page_ptr  = get_page(addr);
+		  unsigned char* page_ptr  = get_page(addr, false);
 		  uint64_t       page_addr = addr & ~(~uint64_t(0) << ADDRBITS);
 
-		  unsigned char* src_buf_ptr = page_ptr + page_addr;
 		  unsigned char* dest_buf_ptr  = (unsigned char*)(dest)      + dest_offset;
 
 		  uint64_t remaining_bytes_to_read = size - read_bytes;
@@ -101,7 +106,10 @@ mem_model::mem_model(std::string deviceName):
 		  }else{
 			  buf_size = bytes_upto_next_alignment;
 		  }
-	  memcpy(dest_buf_ptr,src_buf_ptr,buf_size);
+		  if (page_ptr)
+			  memcpy(dest_buf_ptr,page_ptr + page_addr,buf_size);
+		  else
+			  memset(dest_buf_ptr,0,buf_size);
 		  read_bytes += buf_size;
 		  addr += buf_size;
 	  }
@@ -118,63 +126,136 @@ mem_model::mem_model(std::string deviceName):
 
 	  return 0;
   }
-  unsigned char* mem_model::get_page(uint64_t offset) {
+  // Pages are carved from MAP_NORESERVE segments of anonymous memory.
+  // The kernel backs a segment on first touch only, at the granularity
+  // of the host page size, so a large and sparsely used device memory
+  // costs address space rather than host RAM.
+  unsigned char* mem_model::alloc_page(uint64_t page_idx) {
+	  uint64_t seg_idx = page_idx >> (SEGMENTBITS - ADDRBITS);
+	  auto seg = mSegments.find(seg_idx);
+	  if (seg == mSegments.end()) {
+		  void* base = mmap(nullptr, SEGMENTSIZE, PROT_READ | PROT_WRITE,
+				    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		  if (base == MAP_FAILED) {
+			  std::cerr << "Out of Memory. DDR model does not support this much of memory\n";
+			  exit(1);
+		  }
+		  seg = mSegments.emplace(seg_idx, static_cast<unsigned char*>(base)).first;
+	  }
+	  uint64_t page_in_seg = page_idx & ((uint64_t(1) << (SEGMENTBITS - ADDRBITS)) - 1);
+	  unsigned char* page = seg->second + (page_in_seg << ADDRBITS);
+	  pageCache[page_idx] = page;
+	  return page;
+  }
+
+  // Returns nullptr for a page that has never been written when create
+  // is false, the page then reads as zeros without being allocated.
+  unsigned char* mem_model::get_page(uint64_t offset, bool create) {
 	  uint64_t page_idx = offset >> ADDRBITS;
+	  auto itr = pageCache.find(page_idx);
+	  if (itr != pageCache.end())
+		  return itr->second;
+
 	  std::string file_name = get_mem_file_name(page_idx);
-	  if(pageCache.size() > N_1MBARRAYS)
-	  {
-		  std::cerr << "Out of Memory. DDR model does not support this much of memory\n";
-		  exit(1);
-	  } else {
-      FILE* pFile = NULL;
-		  if(pageCache.find(page_idx) != pageCache.end())
+	  FILE* pFile = NULL;
+	  if(((pFile = fopen(file_name.c_str(),"r")) != NULL)) {
+		  int fhandle = fileno(pFile);
+
+		  if (deserialize_msg.ParseFromFileDescriptor(fhandle) == false)
 		  {
-			  return pageCache[page_idx];
-		  } else if(((pFile = fopen(file_name.c_str(),"r")) != NULL)) {
-			  int fhandle = fileno(pFile);
-
-			  if (deserialize_msg.ParseFromFileDescriptor(fhandle) == false)
-        {
-          fclose(pFile);
-          exit(1);
-        }
-			  pageCache[page_idx] = new unsigned char[PAGESIZE];
-
-			  memcpy(pageCache[page_idx],deserialize_msg.data().c_str(),PAGESIZE);
 			  fclose(pFile);
-			  return pageCache[page_idx];
-		  } else {
-			  pageCache[page_idx] = new unsigned char[PAGESIZE];
-			  return pageCache[page_idx];
+			  exit(1);
 		  }
+		  unsigned char* page = alloc_page(page_idx);
+		  memcpy(page,deserialize_msg.data().c_str(),PAGESIZE);
+		  fclose(pFile);
+		  return page;
 	  }
+
+	  return create ? alloc_page(page_idx) : nullptr;
   }
 
 
+  bool mem_model::serialize_page(const std::string& file_name, const unsigned char* page)
+  {
+     FILE* pFile = fopen(file_name.c_str(),"w+");
+     if(!pFile)
+       return false;
+     int fhandle = fileno(pFile);
+     if(fhandle == -1)
+     {
+       fclose(pFile);
+       exit(1);
+     }
+
+     serialize_msg.set_data(reinterpret_cast<const char*>(page),PAGESIZE);
+     if(serialize_msg.SerializeToFileDescriptor(fhandle) == false)
+     {
+       fclose(pFile);
+       exit(1);
+     }
+     fclose(pFile);
+     return true;
+  }
+
   void mem_model::serialize() {
-     FILE *pFile;
-     int fhandle;
      for (pageCacheItr=pageCache.begin(); pageCacheItr != pageCache.end(); ++pageCacheItr)
-     {
-        std::string file_name = get_mem_file_name(pageCacheItr->first);
-        pFile = fopen(file_name.c_str(),"w+");
-        if(!pFile)
-          continue;
-        fhandle = fileno(pFile);
-        if(fhandle == -1)
-        {
-          fclose(pFile);
-          exit(1);
-        }
-
-        serialize_msg.set_data(reinterpret_cast<const char*>(pageCacheItr->second),PAGESIZE);
-        if(serialize_msg.SerializeToFileDescriptor(fhandle) == false)
-        {
-          fclose(pFile);
-          exit(1);
-        }
-        fclose(pFile);
+       serialize_page(get_mem_file_name(pageCacheItr->first), pageCacheItr->second);
+  }
+
+  // The page files are written to a temporary directory that is
+  // renamed into place, so a concurrent process either sees the
+  // complete checkpoint or none.
+  bool mem_model::save_checkpoint(const std::string& dir)
+  {
+     std::error_code ec;
+     auto tmp_dir = dir + ".tmp." + std::to_string(getpid());
+     std::filesystem::remove_all(tmp_dir, ec);
+     if (!std::filesystem::create_directories(tmp_dir, ec))
+       return false;
+
+     for (auto& page : pageCache) {
+       if (!serialize_page(tmp_dir + "/" + module_name + "_" + std::to_string(page.first), page.second)) {
+         std::filesystem::remove_all(tmp_dir, ec);
+         return false;
+       }
+     }
+
+     std::filesystem::rename(tmp_dir, dir, ec);
+     if (ec) {
+       std::filesystem::remove_all(tmp_dir, ec);
+       return false;
+     }
+     return true;
+  }
+
+  bool mem_model::restore_checkpoint(const std::string& dir)
+  {
+     std::error_code ec;
+     auto prefix = module_name + "_";
+     for (auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+       auto file_name = entry.path().filename().string();
+       if (file_name.compare(0, prefix.size(), prefix) != 0)
+         continue;
+
+       char* end = nullptr;
+       uint64_t page_idx = strtoull(file_name.c_str() + prefix.size(), &end, 10);
+       if (end == file_name.c_str() + prefix.size() || *end != '\0')
+         continue;
+       if (pageCache.find(page_idx) != pageCache.end())
+         continue;
+
+       FILE* pFile = fopen(entry.path().c_str(),"r");
+       if (!pFile)
+         return false;
+       bool parsed = deserialize_msg.ParseFromFileDescriptor(fileno(pFile));
+       fclose(pFile);
+       if (!parsed || deserialize_msg.data().size() != PAGESIZE)
+         return false;
+
+       memcpy(alloc_page(page_idx),deserialize_msg.data().c_str(),PAGESIZE);
      }
+     return !ec;
   }
 
  std::string mem_model::get_mem_file_name(uint64_t pageIdx)
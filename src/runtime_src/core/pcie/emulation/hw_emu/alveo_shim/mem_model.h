@@ -33,23 +33,34 @@
 #define ONE_MB (ONE_KB * ONE_KB)
 #define PAGESIZE (ONE_MB)
 #define ADDRBITS (20)
-#define N_1MBARRAYS 4096
+#define SEGMENTBITS (30)
+#define SEGMENTSIZE (uint64_t(1) << SEGMENTBITS)
 
 class mem_model{
 public:
 unsigned int writeDevMem(uint64_t offset, const void* src, unsigned int size);
 unsigned int readDevMem(uint64_t offset, void* dest, unsigned int size);
 
+// Checkpoint of the pages touched so far, a checkpoint saved by one
+// process is restored by later processes loading the same xclbin.
+// The page files have the same format as the serialized model.
+bool save_checkpoint(const std::string& dir);
+bool restore_checkpoint(const std::string& dir);
+
 protected:
 private:
-  unsigned char* get_page(uint64_t offset);
+  unsigned char* get_page(uint64_t offset, bool create);
+  unsigned char* alloc_page(uint64_t page_idx);
   std::string get_mem_file_name(uint64_t pageIdx);
   std::map<uint64_t,unsigned char*> pageCache;
   std::map<uint64_t,unsigned char*>::iterator pageCacheItr;
+  // 1GB segments of reserved address space the pages are carved from
+  std::map<uint64_t,unsigned char*> mSegments;
 
   ddr_mem_msg serialize_msg;
   ddr_mem_msg deserialize_msg;
   void serialize();
+  bool serialize_page(const std::string& file_name, const unsigned char* page);
   std::string mDeviceName;
   std::string module_name;
 public:
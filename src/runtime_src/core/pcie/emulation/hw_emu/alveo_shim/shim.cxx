@@ -445,6 +445,63 @@ namespace xclhwemhal2 {
     return returnValue;
   }
 
+  // The checkpoint of a device is keyed by xclbin uuid and device
+  // name.  The simulator is told through the environment whether to
+  // save its state to or restore its state from the checkpoint; a
+  // simulator without checkpoint support ignores the request and
+  // starts from scratch.  The host side memory model is restored here
+  // and saved by saveCheckpoint() on close.
+  void HwEmShim::setupCheckpoint(const axlf* top)
+  {
+    mCheckpointPath.clear();
+    mCheckpointRestore = false;
+    unsetenv("HWEMU_CHECKPOINT_PATH");
+    unsetenv("HWEMU_CHECKPOINT_MODE");
+
+    auto checkpointDir = xclemulation::config::getInstance()->getCheckpointDir();
+    if (checkpointDir.empty() || !top)
+      return;
+
+    mCheckpointPath = checkpointDir + "/" + xrt::uuid(top->m_header.uuid).to_string() + "/" + deviceName;
+    mCheckpointRestore = std::filesystem::exists(mCheckpointPath + "/mem_model");
+    std::string mode = mCheckpointRestore ? "restore" : "save";
+
+    setenv("HWEMU_CHECKPOINT_PATH", (mCheckpointPath + "/sim").c_str(), true);
+    setenv("HWEMU_CHECKPOINT_MODE", mode.c_str(), true);
+    mEnvironmentNameValueMap["checkpoint_path"] = mCheckpointPath + "/sim";
+    mEnvironmentNameValueMap["checkpoint_mode"] = mode;
+
+    if (mCheckpointRestore) {
+      mMemModel = new mem_model(deviceName);
+      if (!mMemModel->restore_checkpoint(mCheckpointPath + "/mem_model")) {
+        std::string dMsg = "WARNING: [HW-EMU 29] Unable to restore the checkpoint in " + mCheckpointPath + ", starting from scratch";
+        logMessage(dMsg, 0);
+        delete mMemModel;
+        mMemModel = nullptr;
+        mCheckpointRestore = false;
+      }
+    }
+
+    if (mLogStream.is_open())
+      mLogStream << __func__ << " checkpoint " << mCheckpointPath << " mode " << mode << std::endl;
+  }
+
+  void HwEmShim::saveCheckpoint()
+  {
+    if (mCheckpointPath.empty() || mCheckpointRestore)
+      return;
+
+    std::error_code ec;
+    std::filesystem::create_directories(mCheckpointPath, ec);
+    mem_model empty(deviceName);
+    auto model = mMemModel ? mMemModel : &empty;
+    if (!model->save_checkpoint(mCheckpointPath + "/mem_model") && mLogStream.is_open())
+      mLogStream << __func__ << " unable to save checkpoint " << mCheckpointPath << std::endl;
+
+    // Save once per load
+    mCheckpointPath.clear();
+  }
+
   int HwEmShim::xclLoadBitstreamWorker(bitStreamArg args)
   {
     bool is_enable_debug = xrt_core::config::get_is_enable_debug();
@@ -470,6 +527,8 @@ namespace xclhwemhal2 {
       resetProgram();
     }
 
+    setupCheckpoint(args.m_top);
+
     //CR-1116870 changes. Clearing "mOffsetInstanceStreamMap" for each kernel in case of multiple kernels with different xclbin's
     //required for sys_opt/kernel_swap example
     mOffsetInstanceStreamMap.clear();
@@ -1107,6 +1166,13 @@ namespace xclhwemhal2 {
     set_simulator_started(true);
     sock->monitor_socket();
 
+    if (xclemulation::config::getInstance()->isShmDataPlaneEnabled())
+      mDataPlane = xclemulation::shm_data_plane::create(xclemulation::config::getInstance()->getPacketSize());
+
+    // The new device process has to accept the batch call again
+    mKernelCtrlBatchOffered = false;
+    mKernelCtrlBatchAccepted = false;
+
     //Thread to fetch messages from Device to display on host
     if (mMessengerThreadStarted == false) {
       mMessengerThread = std::thread([this]() { messagesThread(); } );
@@ -1264,6 +1330,9 @@ namespace xclhwemhal2 {
          << offset << ", " << hostBuf << ", " << size << std::endl;
      }
      offset = offset | mCuBaseAddress;
+     if (space != XCL_ADDR_KERNEL_CTRL)
+       flushKernelCtrlWrites();
+
      switch (space) {
        case XCL_ADDR_SPACE_DEVICE_RAM:
          {
@@ -1344,8 +1413,17 @@ namespace xclhwemhal2 {
              std::string dMsg ="INFO: [HW-EMU 03-0] Configuring registers for the kernel " + kernelName +" Started";
              logMessage(dMsg,1);
            }
-           //Note: Adding PF and BAR ID valuesas 0, Once original values are avaiaable they get replaced
-           xclWriteAddrKernelCtrl_RPC_CALL(xclWriteAddrKernelCtrl,space,offset,hostBuf,size,offsetArgInfo,0,0);
+           if (mKernelCtrlBatchAccepted) {
+             std::lock_guard<std::mutex> lk(mKernelCtrlBatchMtx);
+             mKernelCtrlBatch.emplace_back(offset, std::string(static_cast<const char*>(hostBuf), size));
+             if ((hostBuf32[0] & CONTROL_AP_START) || mKernelCtrlBatch.size() >= kernel_ctrl_batch_max)
+               flushKernelCtrlWritesLocked();
+           }
+           else {
+             bool offer = !mKernelCtrlBatchOffered.exchange(true) && xclemulation::config::getInstance()->isKernelCtrlBatchEnabled();
+             //Note: Adding PF and BAR ID valuesas 0, Once original values are avaiaable they get replaced
+             xclWriteAddrKernelCtrl_OFFER_BATCH_RPC_CALL(xclWriteAddrKernelCtrl,space,offset,hostBuf,size,offsetArgInfo,0,0,offer,mKernelCtrlBatchAccepted);
+           }
            if(hostBuf32[0] & CONTROL_AP_START)
            {
              std::string dMsg ="INFO: [HW-EMU 04-1] Kernel " + kernelName +" is Started";
@@ -1384,6 +1462,10 @@ namespace xclhwemhal2 {
       mLogStream << __func__ << ", " << std::this_thread::get_id() << ", " << space << ", "
         << offset << ", " << hostBuf << ", " << size << std::endl;
     }
+
+    // A read may depend on queued register writes
+    flushKernelCtrlWrites();
+
     offset = offset | mCuBaseAddress;
     switch (space) {
       case XCL_ADDR_SPACE_DEVICE_RAM:
@@ -1453,6 +1535,30 @@ namespace xclhwemhal2 {
     }
   }
 
+  void HwEmShim::flushKernelCtrlWritesLocked()
+  {
+    if (mKernelCtrlBatch.empty())
+      return;
+
+#ifndef _WINDOWS
+    bool valid = true;
+    //Note: Adding PF and BAR ID valuesas 0, Once original values are avaiaable they get replaced
+    xclWriteAddrKernelCtrlBatch_RPC_CALL(xclWriteAddrKernelCtrlBatch,mKernelCtrlBatch,0,0,valid);
+    if (!valid && mLogStream.is_open())
+      mLogStream << __func__ << ", device process rejected " << mKernelCtrlBatch.size() << " register writes" << std::endl;
+#endif
+    mKernelCtrlBatch.clear();
+  }
+
+  void HwEmShim::flushKernelCtrlWrites()
+  {
+    if (!mKernelCtrlBatchAccepted)
+      return;
+
+    std::lock_guard<std::mutex> lk(mKernelCtrlBatchMtx);
+    flushKernelCtrlWritesLocked();
+  }
+
   uint32_t HwEmShim::getAddressSpace(uint32_t topology)
   {
     if (mMembanks.size() <= topology)
@@ -1470,6 +1576,7 @@ namespace xclhwemhal2 {
 
   size_t HwEmShim::xclCopyBufferHost2Device(uint64_t dest, const void *src, size_t size, size_t seek, uint32_t topology)
   {
+    flushKernelCtrlWrites();
     if (!sock)
     {
       if (!mMemModel)
@@ -1524,7 +1631,7 @@ namespace xclhwemhal2 {
       // TODO: Windows build support
       // *_RPC_CALL uses unix_socket
       uint32_t space = getAddressSpace(topology);
-      xclCopyBufferHost2Device_RPC_CALL(xclCopyBufferHost2Device, handle, c_dest, c_src, c_size, seek, space);
+      xclCopyBufferHost2Device_SHM_RPC_CALL(xclCopyBufferHost2Device, handle, c_dest, c_src, c_size, seek, space, mDataPlane);
 #endif
       processed_bytes += c_size;
     }
@@ -1539,6 +1646,7 @@ namespace xclhwemhal2 {
 
   size_t HwEmShim::xclCopyBufferDevice2Host(void *dest, uint64_t src, size_t size, size_t skip, uint32_t topology)
   {
+    flushKernelCtrlWrites();
     dest = ((unsigned char*)dest) + skip;
     if(!sock)
     {
@@ -1586,7 +1694,7 @@ namespace xclhwemhal2 {
       uint64_t c_src = src + processed_bytes;
 #ifndef _WINDOWS
       uint32_t space = getAddressSpace(topology);
-      xclCopyBufferDevice2Host_RPC_CALL(xclCopyBufferDevice2Host,handle,c_dest,c_src,c_size,skip,space);
+      xclCopyBufferDevice2Host_SHM_RPC_CALL(xclCopyBufferDevice2Host,handle,c_dest,c_src,c_size,skip,space,mDataPlane);
 #endif
 
       processed_bytes += c_size;
@@ -1819,6 +1927,9 @@ namespace xclhwemhal2 {
       mLogStream << __func__ << ", " << std::this_thread::get_id() << std::endl;
     }
 
+    flushKernelCtrlWrites();
+    saveCheckpoint();
+
     // Ensuring parseLog call to xclClose not to call parseLog again. - no recursive call should happen.
     if (!DonotRunParseLog)
         parseLog();
@@ -2050,6 +2161,7 @@ namespace xclhwemhal2 {
     //ProfilerStop();
 
     sock.reset();
+    mDataPlane.reset();
 
     PRINTENDFUNC;
     if(mMBSch && mCore)
@@ -2266,6 +2378,7 @@ namespace xclhwemhal2 {
     last_clk_time = clock();
     mCloseAll = false;
     mMemModel = nullptr;
+    mCheckpointRestore = false;
 
     // Delete detailed kernel trace data mining results file
     // NOTE: do this only if we're going to write a new one
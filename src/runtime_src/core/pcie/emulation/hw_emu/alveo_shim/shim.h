@@ -31,6 +31,7 @@
 #include "xcl_macros.h"
 #include "unix_socket.h"
 #include "nocddr_fastaccess_hwemu.h"
+#include "shm_data_plane.h"
 
 #endif
 
@@ -383,6 +384,8 @@ using addr_type = uint64_t;
       size_t xclRead(xclAddressSpace space, uint64_t offset, void *hostBuf, size_t size);
       size_t xclReadModifyWrite(uint64_t offset, const void *hostBuf, size_t size);
       size_t xclReadSkipCopy(uint64_t offset, void *hostBuf, size_t size);
+      // Send kernel control register writes queued by xclWrite
+      void flushKernelCtrlWrites();
 
       // Buffer management
       uint64_t xclAllocDeviceBuffer(size_t size);
@@ -545,6 +548,17 @@ using addr_type = uint64_t;
 
       //mutex to control parellel RPC calls
       std::mutex mtx;
+
+      // Kernel control register writes are queued and sent in one
+      // xclWriteAddrKernelCtrlBatch message once the device process
+      // accepted the batch call.  The queue is flushed by a write with
+      // CONTROL_AP_START set, by any read, by buffer copies and on close.
+      static constexpr size_t kernel_ctrl_batch_max = 256;
+      std::mutex mKernelCtrlBatchMtx;
+      std::vector<std::pair<uint64_t, std::string>> mKernelCtrlBatch;
+      std::atomic<bool> mKernelCtrlBatchOffered {false};
+      std::atomic<bool> mKernelCtrlBatchAccepted {false};
+      void flushKernelCtrlWritesLocked();
       std::mutex mApiMtx;
       std::vector<Event> list_of_events[xdp::MAX_NUM_AIMS];
       unsigned int tracecount_calls;
@@ -567,12 +581,21 @@ using addr_type = uint64_t;
       unsigned int binaryCounter;
 
       std::shared_ptr<unix_socket> sock;
+      // Shared memory payload buffer for buffer copies, see shm_data_plane.h
+      std::unique_ptr<xclemulation::shm_data_plane> mDataPlane;
       std::string deviceName;
       xclDeviceInfo2 mDeviceInfo;
       unsigned int mDeviceIndex;
       clock_t last_clk_time;
       bool mCloseAll;
       mem_model* mMemModel;
+      // Device state checkpoint for the loaded xclbin, see checkpoint_dir
+      // in xrt.ini.  A checkpoint is saved on close by the first process
+      // and restored by later processes loading the same xclbin.
+      std::string mCheckpointPath;
+      bool mCheckpointRestore;
+      void setupCheckpoint(const axlf* top);
+      void saveCheckpoint();
       bool bUnified;
       bool bXPR;
       //MemTopology topology;
@@ -489,6 +489,8 @@ namespace xclswemuhal2
       }
     }
     sock = new unix_socket("EMULATION_SOCKETID");
+    if (xclemulation::config::getInstance()->isShmDataPlaneEnabled())
+      mDataPlane = xclemulation::shm_data_plane::create(get_messagesize());
     return true;
   }
 
@@ -1135,7 +1137,7 @@ namespace xclswemuhal2
       uint64_t c_dest = dest + processed_bytes;
 #ifndef _WINDOWS
       uint32_t space = 0;
-      xclCopyBufferHost2Device_RPC_CALL(xclCopyBufferHost2Device, handle, c_dest, c_src, c_size, seek, space);
+      xclCopyBufferHost2Device_SHM_RPC_CALL(xclCopyBufferHost2Device, handle, c_dest, c_src, c_size, seek, space, mDataPlane);
 #endif
       processed_bytes += c_size;
     }
@@ -1178,7 +1180,7 @@ namespace xclswemuhal2
       uint64_t c_src = src + processed_bytes;
 #ifndef _WINDOWS
       uint32_t space = 0;
-      xclCopyBufferDevice2Host_RPC_CALL(xclCopyBufferDevice2Host, handle, c_dest, c_src, c_size, skip, space);
+      xclCopyBufferDevice2Host_SHM_RPC_CALL(xclCopyBufferDevice2Host, handle, c_dest, c_src, c_size, skip, space, mDataPlane);
 #endif
 
       processed_bytes += c_size;
@@ -1390,6 +1392,7 @@ namespace xclswemuhal2
     systemUtil::makeSystemCall(socketName, systemUtil::systemOperation::REMOVE);
     delete sock;
     sock = nullptr;
+    mDataPlane.reset();
     PRINTENDFUNC;
     if (mIsKdsSwEmu && mSWSch && mCore)
     {
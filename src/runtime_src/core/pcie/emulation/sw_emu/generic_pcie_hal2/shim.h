@@ -13,6 +13,7 @@
 #include "core/include/xdp/counters.h"
 #include "core/include/xdp/trace.h"
 
+#include "shm_data_plane.h"
 #include "swscheduler.h"
 #include "unix_socket.h"
 #include "xclbin.h"
@@ -788,6 +789,8 @@ namespace xclswemuhal2
     unsigned int binaryCounter;
     unix_socket *sock;
     unix_socket *aiesim_sock;
+    // Shared memory payload buffer for buffer copies, see shm_data_plane.h
+    std::unique_ptr<xclemulation::shm_data_plane> mDataPlane;
 
     uint64_t mRAMSize;
     size_t mCoalesceThreshold;
@@ -992,68 +992,94 @@ namespace xclswemuhal2 {
     pending_cmds.clear();
   }
 
-  void SWScheduler::scheduler_iterate_cmds()
+  bool SWScheduler::scheduler_iterate_cmds()
   {
     //PRINTSTARTFUNC
-     auto end = mScheduler->command_queue.end();
-#ifdef EM_DEBUG_KDS
-     //if(mScheduler->command_queue.size() > 0)
-     //  std::cout<<" command_queue size is "<<mScheduler->command_queue.size()<< std::endl;
-#endif
-     for (auto itr=mScheduler->command_queue.begin(); itr!=end; )
-     {
-       xocl_cmd *xcmd = *itr;
-       if (xcmd->state == ERT_CMD_STATE_QUEUED)
-       {
+    bool progress = false;
+
+    // Start queued commands on all ready CUs before polling any running
+    // command, so commands on independent CUs are started back to back
+    // rather than each start waiting for the status reads of the
+    // commands ahead of it.  Completion is still in order per CU.
+    for (auto xcmd : mScheduler->command_queue)
+    {
+      if (xcmd->state == ERT_CMD_STATE_QUEUED)
+      {
 #ifdef EM_DEBUG_KDS
-         std::cout<<xcmd << " is in QUEUED state  "<< std::endl;
+        std::cout<<xcmd << " is in QUEUED state  "<< std::endl;
 #endif
-         queued_to_running(xcmd);
-       }
-       if (xcmd->state == ERT_CMD_STATE_RUNNING)
-       {
-         running_to_complete(xcmd);
-       }
-
-       if (xcmd->state == ERT_CMD_STATE_COMPLETED)
-       {
+        if (queued_to_running(xcmd))
+          progress = true;
+      }
+    }
+
+    auto end = mScheduler->command_queue.end();
+    for (auto itr=mScheduler->command_queue.begin(); itr!=end; )
+    {
+      xocl_cmd *xcmd = *itr;
+      if (xcmd->state == ERT_CMD_STATE_RUNNING)
+      {
+        running_to_complete(xcmd);
+      }
+
+      if (xcmd->state == ERT_CMD_STATE_COMPLETED)
+      {
 #ifdef EM_DEBUG_KDS
-         std::cout<<xcmd << " is in COMPLETED state  "<< std::endl;
+        std::cout<<xcmd << " is in COMPLETED state  "<< std::endl;
 #endif
-         complete_to_free(xcmd);
-         itr = mScheduler->command_queue.erase(itr);
-         end = mScheduler->command_queue.end();
-       }
-       else {
-         ++itr;
-       }
-     }
+        complete_to_free(xcmd);
+        itr = mScheduler->command_queue.erase(itr);
+        end = mScheduler->command_queue.end();
+        progress = true;
+      }
+      else {
+        ++itr;
+      }
+    }
 
+    return progress;
   }
 
-  void scheduler_loop(xocl_sched *xs)
+  bool scheduler_loop(xocl_sched *xs)
   {
     //PRINTSTARTFUNC
     SWScheduler* pSch = xs->pSch;
-    std::lock_guard<std::mutex> lk(pSch->pending_cmds_mutex);
 
-    if (xs->error) { return; }
+    if (xs->error) { return false; }
 
-    /* queue new pending commands */
-    pSch->scheduler_queue_cmds();
+    /* queue new pending commands, submitters are blocked only for this */
+    {
+      std::lock_guard<std::mutex> lk(pSch->pending_cmds_mutex);
+      pSch->scheduler_queue_cmds();
+    }
 
     /* iterate all commands */
-    pSch->scheduler_iterate_cmds();
+    return pSch->scheduler_iterate_cmds();
   }
 
   void* scheduler(void* data)
   {
     PRINTSTARTFUNC
     xocl_sched *xs = (xocl_sched *)data;
+    SWScheduler* pSch = xs->pSch;
+
+    // Every status poll is a round trip to the device process and
+    // competes with the C-models for the CPU.  Back off while no
+    // command changes state, a new command wakes the scheduler.
+    constexpr std::chrono::microseconds min_backoff {10};
+    constexpr std::chrono::microseconds max_backoff {200};
+    auto backoff = min_backoff;
     while (!xs->stop && !xs->error)
     {
-      scheduler_loop(xs);
-      usleep(10);
+      if (scheduler_loop(xs)) {
+        backoff = min_backoff;
+        usleep(min_backoff.count());
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lk(pSch->pending_cmds_mutex);
+      xs->state_cond.wait_for(lk, backoff, [xs, pSch] { return pSch->num_pending > 0 || xs->stop; });
+      backoff = std::min(backoff * 2, max_backoff);
     }
     return NULL;
   }
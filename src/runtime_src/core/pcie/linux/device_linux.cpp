@@ -4,6 +4,8 @@
 
 #include "device_linux.h"
 
+#include "core/common/api/kernel_int.h"
+#include "core/common/config_reader.h"
 #include "core/common/message.h"
 #include "core/common/query_requests.h"
 #include "core/common/system.h"
@@ -21,12 +23,15 @@
 #include "xrt.h"
 
 #include <array>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <poll.h>
+#include <sstream>
 #include <string>
 #include <sys/syscall.h>
 #include <type_traits>
@@ -514,6 +519,17 @@ struct xclbin_slots
   }
 };
 
+struct run_wait_stats
+{
+  using result_type = query::run_wait_stats::result_type;
+
+  static result_type
+  get(const xrt_core::device* device, key_type)
+  {
+    return xrt_core::kernel_int::get_run_wait_stats(device);
+  }
+};
+
 struct kds_cu_info
 {
   using result_type = query::kds_cu_info::result_type;
@@ -570,6 +586,153 @@ struct kds_cu_info
   }
 };
 
+struct kds_cu_latency
+{
+  using result_type = query::kds_cu_latency::result_type;
+  using data_type = query::kds_cu_latency::data_type;
+
+  static std::vector<uint64_t>
+  to_buckets(const std::string& str)
+  {
+    using tokenizer = boost::tokenizer< boost::char_separator<char> >;
+    boost::char_separator<char> sep(" ");
+    tokenizer tokens(str, sep);
+    std::vector<uint64_t> buckets;
+    for (auto& tok : tokens)
+      buckets.push_back(std::stoull(tok));
+    return buckets;
+  }
+
+  static result_type
+  get(const xrt_core::device* device, key_type)
+  {
+    auto pdev = get_pcidev(device);
+
+    using tokenizer = boost::tokenizer< boost::char_separator<char> >;
+    std::vector<std::string> stats;
+    std::string errmsg;
+
+    // Format: "slot,cu_idx,queue buckets,execute buckets"
+    // Buckets are space separated
+    pdev->sysfs_get("", "kds_culat_raw", errmsg, stats);
+    if (!errmsg.empty())
+      throw xrt_core::query::sysfs_error(errmsg);
+
+    result_type cu_lats;
+    for (auto& line : stats) {
+      boost::char_separator<char> sep(",");
+      tokenizer tokens(line, sep);
+      if (std::distance(tokens.begin(), tokens.end()) != 4)
+        throw xrt_core::query::sysfs_error("CU latency sysfs node corrupted");
+
+      data_type data;
+      tokenizer::iterator tok_it = tokens.begin();
+      data.slot_index = std::stoi(std::string(*tok_it++));
+      data.index      = std::stoi(std::string(*tok_it++));
+      data.queue      = to_buckets(*tok_it++);
+      data.execute    = to_buckets(*tok_it++);
+      cu_lats.push_back(std::move(data));
+    }
+
+    return cu_lats;
+  }
+};
+
+struct kds_cu_busy
+{
+  using result_type = query::kds_cu_busy::result_type;
+  using data_type = query::kds_cu_busy::data_type;
+
+  static result_type
+  get(const xrt_core::device* device, key_type)
+  {
+    auto pdev = get_pcidev(device);
+
+    using tokenizer = boost::tokenizer< boost::char_separator<char> >;
+    std::vector<std::string> stats;
+    std::string errmsg;
+
+    // Format: "slot,cu_idx,exec_ns,queued"
+    pdev->sysfs_get("", "kds_cubusy_raw", errmsg, stats);
+    if (!errmsg.empty())
+      throw xrt_core::query::sysfs_error(errmsg);
+
+    result_type cu_busy;
+    for (auto& line : stats) {
+      boost::char_separator<char> sep(",");
+      tokenizer tokens(line, sep);
+      if (std::distance(tokens.begin(), tokens.end()) != 4)
+        throw xrt_core::query::sysfs_error("CU busy sysfs node corrupted");
+
+      data_type data;
+      tokenizer::iterator tok_it = tokens.begin();
+      data.slot_index = std::stoi(std::string(*tok_it++));
+      data.index      = std::stoi(std::string(*tok_it++));
+      data.exec_ns    = std::stoull(std::string(*tok_it++));
+      data.queued     = std::stoi(std::string(*tok_it++));
+      cu_busy.push_back(std::move(data));
+    }
+
+    return cu_busy;
+  }
+};
+
+struct kds_client_stat
+{
+  using result_type = query::kds_client_stat::result_type;
+  using data_type = query::kds_client_stat::data_type;
+
+  static result_type
+  get(const xrt_core::device* device, key_type)
+  {
+    auto pdev = get_pcidev(device);
+
+    using tokenizer = boost::tokenizer< boost::char_separator<char> >;
+    std::vector<std::string> stats;
+    std::string errmsg;
+
+    // Format: "pid,ctx,outstanding,cu_idx:started:completed ..."
+    // CU counts are space separated
+    pdev->sysfs_get("", "kds_client_stat_raw", errmsg, stats);
+    if (!errmsg.empty())
+      throw xrt_core::query::sysfs_error(errmsg);
+
+    result_type clients;
+    for (auto& line : stats) {
+      boost::char_separator<char> sep(",", "", boost::keep_empty_tokens);
+      tokenizer tokens(line, sep);
+      if (std::distance(tokens.begin(), tokens.end()) != 4)
+        throw xrt_core::query::sysfs_error("KDS client sysfs node corrupted");
+
+      data_type data;
+      tokenizer::iterator tok_it = tokens.begin();
+      data.pid         = std::stoi(std::string(*tok_it++));
+      data.hw_ctx      = std::stoi(std::string(*tok_it++));
+      data.outstanding = std::stoi(std::string(*tok_it++));
+
+      boost::char_separator<char> cu_sep(" ");
+      std::string cus = *tok_it;
+      tokenizer cu_tokens(cus, cu_sep);
+      for (auto& cu : cu_tokens) {
+        boost::char_separator<char> cnt_sep(":");
+        tokenizer cnt_tokens(cu, cnt_sep);
+        if (std::distance(cnt_tokens.begin(), cnt_tokens.end()) != 3)
+          throw xrt_core::query::sysfs_error("KDS client sysfs node corrupted");
+
+        tokenizer::iterator cnt_it = cnt_tokens.begin();
+        query::kds_client_stat::cu_count count {};
+        count.index     = std::stoi(std::string(*cnt_it++));
+        count.started   = std::stoull(std::string(*cnt_it++));
+        count.completed = std::stoull(std::string(*cnt_it++));
+        data.cus.push_back(count);
+      }
+      clients.push_back(std::move(data));
+    }
+
+    return clients;
+  }
+};
+
 struct instance
 {
   using result_type = query::instance::result_type;
@@ -846,6 +1009,27 @@ struct mac_addr_list
   }
 };
 
+/* Note that required return values are NOT in contiguous sequential order
+ * in AIM subdevice file. So, need to read only a few isolated indices in val_buf.
+ */
+static std::vector<uint64_t>
+aim_report_counters(const std::vector<uint64_t>& val_buf)
+{
+  std::vector<uint64_t> retval_buf(xdp::IP::AIM::NUM_COUNTERS_REPORT, 0);
+
+  retval_buf[xdp::IP::AIM::report::WRITE_BYTES] = val_buf[xdp::IP::AIM::sysfs::WRITE_BYTES];
+  retval_buf[xdp::IP::AIM::report::WRITE_TRANX] = val_buf[xdp::IP::AIM::sysfs::WRITE_TRANX];
+  retval_buf[xdp::IP::AIM::report::READ_BYTES] = val_buf[xdp::IP::AIM::sysfs::READ_BYTES];
+  retval_buf[xdp::IP::AIM::report::READ_TRANX] = val_buf[xdp::IP::AIM::sysfs::READ_TRANX];
+  retval_buf[xdp::IP::AIM::report::OUTSTANDING_COUNT] = val_buf[xdp::IP::AIM::sysfs::OUTSTANDING_COUNT];
+  retval_buf[xdp::IP::AIM::report::WRITE_LAST_ADDRESS] = val_buf[xdp::IP::AIM::sysfs::WRITE_LAST_ADDRESS];
+  retval_buf[xdp::IP::AIM::report::WRITE_LAST_DATA] = val_buf[xdp::IP::AIM::sysfs::WRITE_LAST_DATA];
+  retval_buf[xdp::IP::AIM::report::READ_LAST_ADDRESS] = val_buf[xdp::IP::AIM::sysfs::READ_LAST_ADDRESS];
+  retval_buf[xdp::IP::AIM::report::READ_LAST_DATA] = val_buf[xdp::IP::AIM::sysfs::READ_LAST_DATA];
+
+  return retval_buf;
+}
+
 /* AIM counter values
  * In PCIe Linux, access the sysfs file for AIM to retrieve the AIM counter values
  */
@@ -861,24 +1045,8 @@ struct aim_counter
     std::string aim_name("aximm_mon_");
     aim_name += std::to_string(dbg_ip_data->m_base_address);
 
-    result_type retval_buf(xdp::IP::AIM::NUM_COUNTERS_REPORT, 0);
-
-    result_type val_buf = get_counter_status_from_sysfs(aim_name, "counters", xdp::IP::AIM::NUM_COUNTERS, device);
-
-    /* Note that required return values are NOT in contiguous sequential order
-     * in AIM subdevice file. So, need to read only a few isolated indices in val_buf.
-     */
-    retval_buf[xdp::IP::AIM::report::WRITE_BYTES] = val_buf[xdp::IP::AIM::sysfs::WRITE_BYTES];
-    retval_buf[xdp::IP::AIM::report::WRITE_TRANX] = val_buf[xdp::IP::AIM::sysfs::WRITE_TRANX];
-    retval_buf[xdp::IP::AIM::report::READ_BYTES] = val_buf[xdp::IP::AIM::sysfs::READ_BYTES];
-    retval_buf[xdp::IP::AIM::report::READ_TRANX] = val_buf[xdp::IP::AIM::sysfs::READ_TRANX];
-    retval_buf[xdp::IP::AIM::report::OUTSTANDING_COUNT] = val_buf[xdp::IP::AIM::sysfs::OUTSTANDING_COUNT];
-    retval_buf[xdp::IP::AIM::report::WRITE_LAST_ADDRESS] = val_buf[xdp::IP::AIM::sysfs::WRITE_LAST_ADDRESS];
-    retval_buf[xdp::IP::AIM::report::WRITE_LAST_DATA] = val_buf[xdp::IP::AIM::sysfs::WRITE_LAST_DATA];
-    retval_buf[xdp::IP::AIM::report::READ_LAST_ADDRESS] = val_buf[xdp::IP::AIM::sysfs::READ_LAST_ADDRESS];
-    retval_buf[xdp::IP::AIM::report::READ_LAST_DATA] = val_buf[xdp::IP::AIM::sysfs::READ_LAST_DATA];
-
-    return retval_buf;
+    auto val_buf = get_counter_status_from_sysfs(aim_name, "counters", xdp::IP::AIM::NUM_COUNTERS, device);
+    return aim_report_counters(val_buf);
   }
 
 };
@@ -983,6 +1151,55 @@ struct spc_status
 };
 
 
+/* Debug monitor counters and status
+ * In PCIe Linux, all monitors are read through one sysfs file with one
+ * "name v0 v1 ..." line per monitor, where name is the monitor subdev
+ * name, e.g. aximm_mon_<base address>.
+ */
+struct debug_ip_counters
+{
+  using result_type = query::debug_ip_counters::result_type;
+
+  static result_type
+  get(const xrt_core::device* device, key_type)
+  {
+    auto pdev = get_pcidev(device);
+
+    std::vector<std::string> lines;
+    std::string errmsg;
+    pdev->sysfs_get("", "debug_ip_counters", errmsg, lines);
+    if (!errmsg.empty())
+      throw xrt_core::query::sysfs_error(errmsg);
+
+    result_type counters;
+    for (auto& line : lines) {
+      std::istringstream iss(line);
+      std::string name;
+      iss >> name;
+
+      auto pos = name.find_last_of('_');
+      if (pos == std::string::npos)
+        throw xrt_core::query::sysfs_error("Debug IP counters sysfs node corrupted");
+
+      std::vector<uint64_t> val_buf;
+      uint64_t val = 0;
+      while (iss >> val)
+        val_buf.push_back(val);
+
+      auto base_address = std::stoull(name.substr(pos + 1));
+      if (name.rfind("aximm_mon_", 0) == 0) {
+        if (val_buf.size() < xdp::IP::AIM::NUM_COUNTERS)
+          throw xrt_core::query::sysfs_error("Debug IP counters sysfs node corrupted");
+        val_buf = aim_report_counters(val_buf);
+      }
+      counters[base_address] = std::move(val_buf);
+    }
+
+    return counters;
+  }
+};
+
+
 /* Accelerator Deadlock Detector status
  * In PCIe Linux, access the sysfs file for Accelerator Deadlock Detector to retrieve the deadlock status
  */
@@ -1171,6 +1388,59 @@ struct sysfs_get : virtual QueryRequestType
   }
 };
 
+// struct sysfs_cached_get - sysfs query with value cached for a ttl
+//
+// Sensor values are read by the driver from the card management
+// firmware, often through the management PF.  Monitoring tools
+// polling many sensors on many cards at a high rate re-read the same
+// values over and over.  Cached requests return the last value read
+// for a device until the ttl expires.  Queries with a modifier are
+// not cached.
+template <typename QueryRequestType>
+struct sysfs_cached_get : sysfs_get<QueryRequestType>
+{
+  using clock = std::chrono::steady_clock;
+
+  struct entry
+  {
+    clock::time_point time;
+    std::any value;
+  };
+
+  std::chrono::milliseconds ttl;
+  mutable std::mutex mutex;
+  mutable std::map<const xrt_core::pci::dev*, entry> cache;
+
+  sysfs_cached_get(const char* s, const char* e, std::chrono::milliseconds t)
+    : sysfs_get<QueryRequestType>(s, e), ttl(t)
+  {}
+
+  using sysfs_get<QueryRequestType>::get;
+
+  std::any
+  get(const xrt_core::device* device) const
+  {
+    if (!ttl.count())
+      return sysfs_get<QueryRequestType>::get(device);
+
+    // pci::dev objects live for the duration of the process
+    auto pdev = get_pcidev(device);
+    auto now = clock::now();
+    {
+      std::lock_guard lk(mutex);
+      auto itr = cache.find(pdev.get());
+      if (itr != cache.end() && now - itr->second.time < ttl)
+        return itr->second.value;
+    }
+
+    // Errors are not cached, sysfs is not read under lock
+    auto value = sysfs_get<QueryRequestType>::get(device);
+    std::lock_guard lk(mutex);
+    cache[pdev.get()] = {now, value};
+    return value;
+  }
+};
+
 template <typename QueryRequestType>
 struct sysfs_put : virtual QueryRequestType
 {
@@ -1220,14 +1490,36 @@ struct function4_get : virtual QueryRequestType
   }
 };
 
-static std::map<xrt_core::query::key_type, std::unique_ptr<query::request>> query_tbl;
+// Query requests indexed by key_type.  A dense table makes lookup a
+// bounds check and an index instead of a map search on every query.
+static constexpr auto query_tbl_size = static_cast<size_t>(query::key_type::noop) + 1;
+static std::array<std::unique_ptr<query::request>, query_tbl_size> query_tbl;
+
+// First registration of a key wins, same as std::map::emplace
+static void
+emplace_query(query::key_type key, std::unique_ptr<query::request> request)
+{
+  auto& entry = query_tbl[static_cast<size_t>(key)];
+  if (!entry)
+    entry = std::move(request);
+}
 
 template <typename QueryRequestType>
 static void
 emplace_sysfs_get(const char* subdev, const char* entry)
 {
   auto x = QueryRequestType::key;
-  query_tbl.emplace(x, std::make_unique<sysfs_get<QueryRequestType>>(subdev, entry));
+  emplace_query(x, std::make_unique<sysfs_get<QueryRequestType>>(subdev, entry));
+}
+
+// Sensor values are cached per xrt.ini Runtime.sensor_query_ttl_ms
+template <typename QueryRequestType>
+static void
+emplace_sysfs_sensor_get(const char* subdev, const char* entry)
+{
+  static std::chrono::milliseconds ttl{xrt_core::config::get_sensor_query_ttl_ms()};
+  auto x = QueryRequestType::key;
+  emplace_query(x, std::make_unique<sysfs_cached_get<QueryRequestType>>(subdev, entry, ttl));
 }
 
 template <typename QueryRequestType, typename Getter>
@@ -1235,7 +1527,7 @@ static void
 emplace_func0_request()
 {
   auto k = QueryRequestType::key;
-  query_tbl.emplace(k, std::make_unique<function0_get<QueryRequestType, Getter>>());
+  emplace_query(k, std::make_unique<function0_get<QueryRequestType, Getter>>());
 }
 
 template <typename QueryRequestType, typename Getter>
@@ -1243,7 +1535,7 @@ static void
 emplace_func4_request()
 {
   auto k = QueryRequestType::key;
-  query_tbl.emplace(k, std::make_unique<function4_get<QueryRequestType, Getter>>());
+  emplace_query(k, std::make_unique<function4_get<QueryRequestType, Getter>>());
 }
 
 template <typename QueryRequestType>
@@ -1251,7 +1543,7 @@ static void
 emplace_sysfs_put(const char* subdev, const char* entry)
 {
   auto x = QueryRequestType::key;
-  query_tbl.emplace(x, std::make_unique<sysfs_put<QueryRequestType>>(subdev, entry));
+  emplace_query(x, std::make_unique<sysfs_put<QueryRequestType>>(subdev, entry));
 }
 
 template <typename QueryRequestType>
@@ -1259,7 +1551,7 @@ static void
 emplace_sysfs_getput(const char* subdev, const char* entry)
 {
   auto x = QueryRequestType::key;
-  query_tbl.emplace(x, std::make_unique<sysfs_getput<QueryRequestType>>(subdev, entry));
+  emplace_query(x, std::make_unique<sysfs_getput<QueryRequestType>>(subdev, entry));
 }
 
 static void
@@ -1273,6 +1565,7 @@ initialize_query_table()
   emplace_sysfs_get<query::pcie_link_speed_max>                ("", "link_speed_max");
   emplace_sysfs_get<query::pcie_express_lane_width>            ("", "link_width");
   emplace_sysfs_get<query::pcie_express_lane_width_max>        ("", "link_width_max");
+  emplace_sysfs_get<query::numa_node>                          ("", "numa_node");
   emplace_sysfs_get<query::dma_threads_raw>                    ("dma", "channel_stat_raw");
   emplace_sysfs_get<query::rom_vbnv>                           ("rom", "VBNV");
   emplace_sysfs_get<query::rom_ddr_bank_size_gb>               ("rom", "ddr_bank_size");
@@ -1299,7 +1592,7 @@ initialize_query_table()
   emplace_sysfs_get<query::max_shared_host_mem_aperture_bytes> ("icap", "max_host_mem_aperture");
   emplace_sysfs_get<query::status_mig_calibrated>              ("", "mig_calibration");
   emplace_sysfs_getput<query::mig_cache_update>                ("", "mig_cache_update");
-  emplace_sysfs_get<query::temp_by_mem_topology>               ("xmc", "temp_by_mem_topology");
+  emplace_sysfs_sensor_get<query::temp_by_mem_topology>        ("xmc", "temp_by_mem_topology");
   emplace_sysfs_get<query::xmc_version>                        ("xmc", "version");
   emplace_sysfs_get<query::xmc_board_name>                     ("xmc", "bd_name");
   emplace_sysfs_get<query::xmc_serial_num>                     ("xmc", "serial_num");
@@ -1325,65 +1618,65 @@ initialize_query_table()
   emplace_sysfs_get<query::nodma>                              ("", "nodma");
   emplace_sysfs_get<query::dna_serial_num>                     ("dna", "dna");
   emplace_sysfs_get<query::p2p_config>                         ("p2p", "config");
-  emplace_sysfs_get<query::temp_card_top_front>                ("xmc", "xmc_se98_temp0");
-  emplace_sysfs_get<query::temp_card_top_rear>                 ("xmc", "xmc_se98_temp1");
-  emplace_sysfs_get<query::temp_card_bottom_front>             ("xmc", "xmc_se98_temp2");
-  emplace_sysfs_get<query::temp_fpga>                          ("xmc", "xmc_fpga_temp");
-  emplace_sysfs_get<query::fan_trigger_critical_temp>          ("xmc", "xmc_fan_temp");
-  emplace_sysfs_get<query::fan_fan_presence>                   ("xmc", "fan_presence");
-  emplace_sysfs_get<query::fan_speed_rpm>                      ("xmc", "xmc_fan_rpm");
-  emplace_sysfs_get<query::ddr_temp_0>                         ("xmc", "xmc_ddr_temp0");
-  emplace_sysfs_get<query::ddr_temp_1>                         ("xmc", "xmc_ddr_temp1");
-  emplace_sysfs_get<query::ddr_temp_2>                         ("xmc", "xmc_ddr_temp2");
-  emplace_sysfs_get<query::ddr_temp_3>                         ("xmc", "xmc_ddr_temp3");
-  emplace_sysfs_get<query::hbm_temp>                           ("xmc", "xmc_hbm_temp");
-  emplace_sysfs_get<query::cage_temp_0>                        ("xmc", "xmc_cage_temp0");
-  emplace_sysfs_get<query::cage_temp_1>                        ("xmc", "xmc_cage_temp1");
-  emplace_sysfs_get<query::cage_temp_2>                        ("xmc", "xmc_cage_temp2");
-  emplace_sysfs_get<query::cage_temp_3>                        ("xmc", "xmc_cage_temp3");
-  emplace_sysfs_get<query::dimm_temp_0>                        ("xmc", "xmc_dimm_temp0");
-  emplace_sysfs_get<query::dimm_temp_1>                        ("xmc", "xmc_dimm_temp1");
-  emplace_sysfs_get<query::dimm_temp_2>                        ("xmc", "xmc_dimm_temp2");
-  emplace_sysfs_get<query::dimm_temp_3>                        ("xmc", "xmc_dimm_temp3");
-  emplace_sysfs_get<query::v12v_pex_millivolts>                ("xmc", "xmc_12v_pex_vol");
-  emplace_sysfs_get<query::v12v_pex_milliamps>                 ("xmc", "xmc_12v_pex_curr");
-  emplace_sysfs_get<query::v12v_aux_millivolts>                ("xmc", "xmc_12v_aux_vol");
-  emplace_sysfs_get<query::v12v_aux_milliamps>                 ("xmc", "xmc_12v_aux_curr");
-  emplace_sysfs_get<query::v3v3_pex_millivolts>                ("xmc", "xmc_3v3_pex_vol");
-  emplace_sysfs_get<query::v3v3_aux_millivolts>                ("xmc", "xmc_3v3_aux_vol");
-  emplace_sysfs_get<query::v3v3_aux_milliamps>                 ("xmc", "xmc_3v3_aux_cur");
-  emplace_sysfs_get<query::ddr_vpp_bottom_millivolts>          ("xmc", "xmc_ddr_vpp_btm");
-  emplace_sysfs_get<query::ddr_vpp_top_millivolts>             ("xmc", "xmc_ddr_vpp_top");
-
-  emplace_sysfs_get<query::v5v5_system_millivolts>             ("xmc", "xmc_sys_5v5");
-  emplace_sysfs_get<query::v1v2_vcc_top_millivolts>            ("xmc", "xmc_1v2_top");
-  emplace_sysfs_get<query::v1v2_vcc_bottom_millivolts>         ("xmc", "xmc_vcc1v2_btm");
-  emplace_sysfs_get<query::v1v8_millivolts>                    ("xmc", "xmc_1v8");
-  emplace_sysfs_get<query::v0v85_millivolts>                   ("xmc", "xmc_0v85");
-  emplace_sysfs_get<query::v0v9_vcc_millivolts>                ("xmc", "xmc_mgt0v9avcc");
-  emplace_sysfs_get<query::v12v_sw_millivolts>                 ("xmc", "xmc_12v_sw");
-  emplace_sysfs_get<query::mgt_vtt_millivolts>                 ("xmc", "xmc_mgtavtt");
-  emplace_sysfs_get<query::int_vcc_millivolts>                 ("xmc", "xmc_vccint_vol");
-  emplace_sysfs_get<query::int_vcc_milliamps>                  ("xmc", "xmc_vccint_curr");
-  emplace_sysfs_get<query::int_vcc_temp>                       ("xmc", "xmc_vccint_temp");
-
-  emplace_sysfs_get<query::v12_aux1_millivolts>                ("xmc", "xmc_12v_aux1");
-  emplace_sysfs_get<query::vcc1v2_i_milliamps>                 ("xmc", "xmc_vcc1v2_i");
-  emplace_sysfs_get<query::v12_in_i_milliamps>                 ("xmc", "xmc_v12_in_i");
-  emplace_sysfs_get<query::v12_in_aux0_i_milliamps>            ("xmc", "xmc_v12_in_aux0_i");
-  emplace_sysfs_get<query::v12_in_aux1_i_milliamps>            ("xmc", "xmc_v12_in_aux1_i");
-  emplace_sysfs_get<query::vcc_aux_millivolts>                 ("xmc", "xmc_vccaux");
-  emplace_sysfs_get<query::vcc_aux_pmc_millivolts>             ("xmc", "xmc_vccaux_pmc");
-  emplace_sysfs_get<query::vcc_ram_millivolts>                 ("xmc", "xmc_vccram");
-
-  emplace_sysfs_get<query::v3v3_pex_milliamps>                 ("xmc", "xmc_3v3_pex_curr");
-  emplace_sysfs_get<query::v3v3_aux_milliamps>                 ("xmc", "xmc_3v3_aux_cur");
-  emplace_sysfs_get<query::int_vcc_io_milliamps>               ("xmc", "xmc_0v85_curr");
-  emplace_sysfs_get<query::v3v3_vcc_millivolts>                ("xmc", "xmc_3v3_vcc_vol");
-  emplace_sysfs_get<query::hbm_1v2_millivolts>                 ("xmc", "xmc_hbm_1v2_vol");
-  emplace_sysfs_get<query::v2v5_vpp_millivolts>                ("xmc", "xmc_vpp2v5_vol");
-  emplace_sysfs_get<query::int_vcc_io_millivolts>              ("xmc", "xmc_vccint_bram_vol");
-  emplace_sysfs_get<query::v0v9_int_vcc_vcu_millivolts>        ("xmc", "xmc_vccint_vcu_0v9");
+  emplace_sysfs_sensor_get<query::temp_card_top_front>         ("xmc", "xmc_se98_temp0");
+  emplace_sysfs_sensor_get<query::temp_card_top_rear>          ("xmc", "xmc_se98_temp1");
+  emplace_sysfs_sensor_get<query::temp_card_bottom_front>      ("xmc", "xmc_se98_temp2");
+  emplace_sysfs_sensor_get<query::temp_fpga>                   ("xmc", "xmc_fpga_temp");
+  emplace_sysfs_sensor_get<query::fan_trigger_critical_temp>   ("xmc", "xmc_fan_temp");
+  emplace_sysfs_sensor_get<query::fan_fan_presence>            ("xmc", "fan_presence");
+  emplace_sysfs_sensor_get<query::fan_speed_rpm>               ("xmc", "xmc_fan_rpm");
+  emplace_sysfs_sensor_get<query::ddr_temp_0>                  ("xmc", "xmc_ddr_temp0");
+  emplace_sysfs_sensor_get<query::ddr_temp_1>                  ("xmc", "xmc_ddr_temp1");
+  emplace_sysfs_sensor_get<query::ddr_temp_2>                  ("xmc", "xmc_ddr_temp2");
+  emplace_sysfs_sensor_get<query::ddr_temp_3>                  ("xmc", "xmc_ddr_temp3");
+  emplace_sysfs_sensor_get<query::hbm_temp>                    ("xmc", "xmc_hbm_temp");
+  emplace_sysfs_sensor_get<query::cage_temp_0>                 ("xmc", "xmc_cage_temp0");
+  emplace_sysfs_sensor_get<query::cage_temp_1>                 ("xmc", "xmc_cage_temp1");
+  emplace_sysfs_sensor_get<query::cage_temp_2>                 ("xmc", "xmc_cage_temp2");
+  emplace_sysfs_sensor_get<query::cage_temp_3>                 ("xmc", "xmc_cage_temp3");
+  emplace_sysfs_sensor_get<query::dimm_temp_0>                 ("xmc", "xmc_dimm_temp0");
+  emplace_sysfs_sensor_get<query::dimm_temp_1>                 ("xmc", "xmc_dimm_temp1");
+  emplace_sysfs_sensor_get<query::dimm_temp_2>                 ("xmc", "xmc_dimm_temp2");
+  emplace_sysfs_sensor_get<query::dimm_temp_3>                 ("xmc", "xmc_dimm_temp3");
+  emplace_sysfs_sensor_get<query::v12v_pex_millivolts>         ("xmc", "xmc_12v_pex_vol");
+  emplace_sysfs_sensor_get<query::v12v_pex_milliamps>          ("xmc", "xmc_12v_pex_curr");
+  emplace_sysfs_sensor_get<query::v12v_aux_millivolts>         ("xmc", "xmc_12v_aux_vol");
+  emplace_sysfs_sensor_get<query::v12v_aux_milliamps>          ("xmc", "xmc_12v_aux_curr");
+  emplace_sysfs_sensor_get<query::v3v3_pex_millivolts>         ("xmc", "xmc_3v3_pex_vol");
+  emplace_sysfs_sensor_get<query::v3v3_aux_millivolts>         ("xmc", "xmc_3v3_aux_vol");
+  emplace_sysfs_sensor_get<query::v3v3_aux_milliamps>          ("xmc", "xmc_3v3_aux_cur");
+  emplace_sysfs_sensor_get<query::ddr_vpp_bottom_millivolts>   ("xmc", "xmc_ddr_vpp_btm");
+  emplace_sysfs_sensor_get<query::ddr_vpp_top_millivolts>      ("xmc", "xmc_ddr_vpp_top");
+
+  emplace_sysfs_sensor_get<query::v5v5_system_millivolts>      ("xmc", "xmc_sys_5v5");
+  emplace_sysfs_sensor_get<query::v1v2_vcc_top_millivolts>     ("xmc", "xmc_1v2_top");
+  emplace_sysfs_sensor_get<query::v1v2_vcc_bottom_millivolts>  ("xmc", "xmc_vcc1v2_btm");
+  emplace_sysfs_sensor_get<query::v1v8_millivolts>             ("xmc", "xmc_1v8");
+  emplace_sysfs_sensor_get<query::v0v85_millivolts>            ("xmc", "xmc_0v85");
+  emplace_sysfs_sensor_get<query::v0v9_vcc_millivolts>         ("xmc", "xmc_mgt0v9avcc");
+  emplace_sysfs_sensor_get<query::v12v_sw_millivolts>          ("xmc", "xmc_12v_sw");
+  emplace_sysfs_sensor_get<query::mgt_vtt_millivolts>          ("xmc", "xmc_mgtavtt");
+  emplace_sysfs_sensor_get<query::int_vcc_millivolts>          ("xmc", "xmc_vccint_vol");
+  emplace_sysfs_sensor_get<query::int_vcc_milliamps>           ("xmc", "xmc_vccint_curr");
+  emplace_sysfs_sensor_get<query::int_vcc_temp>                ("xmc", "xmc_vccint_temp");
+
+  emplace_sysfs_sensor_get<query::v12_aux1_millivolts>         ("xmc", "xmc_12v_aux1");
+  emplace_sysfs_sensor_get<query::vcc1v2_i_milliamps>          ("xmc", "xmc_vcc1v2_i");
+  emplace_sysfs_sensor_get<query::v12_in_i_milliamps>          ("xmc", "xmc_v12_in_i");
+  emplace_sysfs_sensor_get<query::v12_in_aux0_i_milliamps>     ("xmc", "xmc_v12_in_aux0_i");
+  emplace_sysfs_sensor_get<query::v12_in_aux1_i_milliamps>     ("xmc", "xmc_v12_in_aux1_i");
+  emplace_sysfs_sensor_get<query::vcc_aux_millivolts>          ("xmc", "xmc_vccaux");
+  emplace_sysfs_sensor_get<query::vcc_aux_pmc_millivolts>      ("xmc", "xmc_vccaux_pmc");
+  emplace_sysfs_sensor_get<query::vcc_ram_millivolts>          ("xmc", "xmc_vccram");
+
+  emplace_sysfs_sensor_get<query::v3v3_pex_milliamps>          ("xmc", "xmc_3v3_pex_curr");
+  emplace_sysfs_sensor_get<query::v3v3_aux_milliamps>          ("xmc", "xmc_3v3_aux_cur");
+  emplace_sysfs_sensor_get<query::int_vcc_io_milliamps>        ("xmc", "xmc_0v85_curr");
+  emplace_sysfs_sensor_get<query::v3v3_vcc_millivolts>         ("xmc", "xmc_3v3_vcc_vol");
+  emplace_sysfs_sensor_get<query::hbm_1v2_millivolts>          ("xmc", "xmc_hbm_1v2_vol");
+  emplace_sysfs_sensor_get<query::v2v5_vpp_millivolts>         ("xmc", "xmc_vpp2v5_vol");
+  emplace_sysfs_sensor_get<query::int_vcc_io_millivolts>       ("xmc", "xmc_vccint_bram_vol");
+  emplace_sysfs_sensor_get<query::v0v9_int_vcc_vcu_millivolts> ("xmc", "xmc_vccint_vcu_0v9");
   emplace_sysfs_get<query::mac_contiguous_num>                 ("xmc", "mac_contiguous_num");
   emplace_sysfs_get<query::mac_addr_first>                     ("xmc", "mac_addr_first");
   emplace_sysfs_get<query::oem_id>                             ("xmc", "xmc_oem_id");
@@ -1399,8 +1692,9 @@ initialize_query_table()
   emplace_sysfs_get<query::firewall_status>                    ("firewall", "detected_status");
   emplace_sysfs_get<query::firewall_time_sec>                  ("firewall", "detected_time");
 
-  emplace_sysfs_get<query::power_microwatts>                   ("xmc", "xmc_power");
-  emplace_sysfs_get<query::power_warning>                      ("xmc", "xmc_power_warn");
+  emplace_sysfs_sensor_get<query::power_microwatts>            ("xmc", "xmc_power");
+  emplace_sysfs_get<query::power_sensors>                      ("xmc", "xmc_power_sensors");
+  emplace_sysfs_sensor_get<query::power_warning>               ("xmc", "xmc_power_warn");
   emplace_sysfs_get<query::host_mem_size>                      ("address_translator", "host_mem_size");
 
   emplace_sysfs_get<query::mig_ecc_status>                     ("mig", "ecc_status");
@@ -1442,8 +1736,12 @@ initialize_query_table()
 
   emplace_sysfs_get<query::kds_numcdmas>                       ("", "kds_numcdmas");
   emplace_func0_request<query::kds_cu_info,                    kds_cu_info>();
+  emplace_func0_request<query::kds_cu_latency,                 kds_cu_latency>();
+  emplace_func0_request<query::kds_cu_busy,                    kds_cu_busy>();
+  emplace_func0_request<query::kds_client_stat,                kds_client_stat>();
   emplace_func0_request<query::kds_scu_info,                   kds_scu_info>();
   emplace_func0_request<query::xclbin_slots, 		       xclbin_slots>();
+  emplace_func0_request<query::run_wait_stats,                 run_wait_stats>();
   emplace_sysfs_get<query::ps_kernel>                          ("icap", "ps_kernel");
   emplace_sysfs_get<query::xocl_errors>                        ("", "xocl_errors");
 
@@ -1459,6 +1757,7 @@ initialize_query_table()
   emplace_func4_request<query::asm_counter,                    asm_counter>();
   emplace_func4_request<query::lapc_status,                    lapc_status>();
   emplace_func4_request<query::spc_status,                     spc_status>();
+  emplace_func0_request<query::debug_ip_counters,              debug_ip_counters>();
   emplace_func4_request<query::accel_deadlock_status,          accel_deadlock_status>();
 
   emplace_sysfs_getput<query::boot_partition>                  ("xgq_vmr", "boot_from_backup");
@@ -1506,12 +1805,11 @@ const query::request&
 device_linux::
 lookup_query(query::key_type query_key) const
 {
-  auto it = query_tbl.find(query_key);
-
-  if (it == query_tbl.end())
+  auto idx = static_cast<size_t>(query_key);
+  if (idx >= query_tbl.size() || !query_tbl[idx])
     throw query::no_such_key(query_key);
 
-  return *(it->second);
+  return *query_tbl[idx];
 }
 
 device_linux::
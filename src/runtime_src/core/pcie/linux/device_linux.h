@@ -68,6 +68,37 @@ public:
   std::unique_ptr<buffer_handle>
   import_bo(pid_t pid, shared_handle::export_handle ehdl) override;
 
+  void
+  sync_bos(buffer_handle::direction dir, const std::vector<buffer_handle::sync_range>& ranges) override
+  {
+    xrt::shim_int::sync_bos(get_device_handle(), dir, ranges);
+  }
+
+  void
+  unmgd_preadv(const std::vector<xrt::shim_int::unmgd_segment>& segs) override
+  {
+    xrt::shim_int::unmgd_preadv(get_device_handle(), segs);
+  }
+
+  void
+  unmgd_pwritev(const std::vector<xrt::shim_int::unmgd_segment>& segs) override
+  {
+    xrt::shim_int::unmgd_pwritev(get_device_handle(), segs);
+  }
+
+  volatile uint32_t*
+  map_cu_registers(uint32_t ipidx, size_t& size) override
+  {
+    return xrt::shim_int::map_cu_registers(get_device_handle(), ipidx, size);
+  }
+
+  std::unique_ptr<stream_handle>
+  create_stream(xrt::stream::direction dir, uint64_t route, uint64_t flow,
+                const xrt::stream::config& cfg) override
+  {
+    return xrt::shim_int::create_stream(get_device_handle(), dir, route, flow, cfg);
+  }
+
   std::unique_ptr<hwctx_handle>
   create_hw_context(const xrt::uuid& xclbin_uuid,
                     const xrt::hw_context::cfg_param_type& cfg_param,
@@ -8,6 +8,7 @@
 #include "core/common/utils.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
 #include <dirent.h>
@@ -149,6 +150,45 @@ wordcopy(void *dst, const void* src, size_t bytes)
   return dst;
 }
 
+/*
+ * widecopy()
+ *
+ * Copy to a write-combining mapping with the widest vector stores
+ * available, consecutive stores are merged by the CPU into PCIe
+ * bursts.  Unaligned head and tail are copied by word.  The final
+ * fence drains the write-combining buffers so the data is posted
+ * before any subsequent uncached write, e.g. the CU start bit.
+ */
+inline void
+widecopy(void* dst, const void* src, size_t bytes)
+{
+#if defined(__AVX__)
+  constexpr size_t wide_size = 32;
+#else
+  constexpr size_t wide_size = 16;
+#endif
+  using wide = uint64_t __attribute__((vector_size(wide_size)));
+
+  auto d = reinterpret_cast<char*>(dst);
+  auto s = reinterpret_cast<const char*>(src);
+  auto head = std::min(bytes, (wide_size - reinterpret_cast<uintptr_t>(d) % wide_size) % wide_size);
+  wordcopy(d, s, head);
+  d += head;
+  s += head;
+  bytes -= head;
+
+  volatile auto w = reinterpret_cast<wide*>(d);
+  auto n = bytes / wide_size;
+  for (size_t i=0; i<n; ++i) {
+    wide v;
+    std::memcpy(&v, s + i * wide_size, wide_size);
+    w[i] = v;
+  }
+  wordcopy(d + n * wide_size, s + n * wide_size, bytes - n * wide_size);
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
 } // namespace
 
 namespace xrt_core { namespace pci {
@@ -484,6 +524,8 @@ dev::
 {
   if (m_user_bar_map != MAP_FAILED)
     ::munmap(m_user_bar_map, m_user_bar_size);
+  if (m_user_bar_wc_map != MAP_FAILED)
+    ::munmap(m_user_bar_wc_map, m_user_bar_size);
 }
 
 int
@@ -512,6 +554,35 @@ map_usr_bar() const
   return 0;
 }
 
+// The write-combining mapping goes through the sysfs resource file,
+// which exists only for prefetchable BARs and requires privileges to
+// open.  The mapping is attempted once.
+int
+dev::
+map_usr_bar_wc() const
+{
+  std::lock_guard<std::mutex> l(m_lock);
+
+  if (m_user_bar_wc_map != MAP_FAILED)
+    return 0;
+  if (m_user_bar_wc_tried)
+    return -ENOTSUP;
+  m_user_bar_wc_tried = true;
+
+  auto path = sysfs::dev_root + m_sysfs_name + "/resource" + std::to_string(m_user_bar) + "_wc";
+  int fd = ::open(path.c_str(), O_RDWR | O_SYNC);
+  if (fd < 0)
+    return -ENOTSUP;
+
+  m_user_bar_wc_map = (char *)::mmap(0, m_user_bar_size, PROT_WRITE, MAP_SHARED, fd, 0);
+  (void)::close(fd);
+
+  if (m_user_bar_wc_map == MAP_FAILED)
+    return -ENOTSUP;
+
+  return 0;
+}
+
 void
 dev::
 close(int dev_handle) const
@@ -547,6 +618,19 @@ pcieBarWrite(uint64_t offset, const void* buf, uint64_t len) const
   return 0;
 }
 
+int
+dev::
+pcieBarWriteWC(uint64_t offset, const void* buf, uint64_t len) const
+{
+  if (m_user_bar_wc_map == MAP_FAILED) {
+    int ret = map_usr_bar_wc();
+    if (ret)
+      return ret;
+  }
+  widecopy(m_user_bar_wc_map + offset, buf, len);
+  return 0;
+}
+
 int
 dev::
 ioctl(int dev_handle, unsigned long cmd, void *arg) const
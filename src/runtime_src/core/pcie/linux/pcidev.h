@@ -140,6 +140,13 @@ public:
   virtual int
   pcieBarWrite(uint64_t offset, const void* buf, uint64_t len) const;
 
+  // Write through a write-combining mapping of the user BAR with wide
+  // stores.  Only for registers where stores may be merged, e.g. CU
+  // arguments, never for control bits.  Returns -ENOTSUP when the
+  // BAR cannot be mapped write-combining.
+  virtual int
+  pcieBarWriteWC(uint64_t offset, const void* buf, uint64_t len) const;
+
   virtual int
   open(const std::string& subdev, int flag) const;
 
@@ -187,9 +194,15 @@ private:
   int
   map_usr_bar() const;
 
+  int
+  map_usr_bar_wc() const;
+
   mutable std::mutex m_lock;
   // Virtual address of memory mapped BAR0, mapped on first use, once mapped, never change.
   mutable char *m_user_bar_map = reinterpret_cast<char *>(MAP_FAILED);
+  // Write-combining mapping of the same BAR, mapped on first use if available
+  mutable char *m_user_bar_wc_map = reinterpret_cast<char *>(MAP_FAILED);
+  mutable bool m_user_bar_wc_tried = false;
 
   std::shared_ptr<const drv> m_driver;
 };
@@ -2,7 +2,12 @@
 // Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
 
 #include "pcidrv.h"
+#include "core/common/config_reader.h"
+
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <thread>
 
 namespace xrt_core { namespace pci {
 
@@ -22,24 +27,52 @@ scan_devices(std::vector<std::shared_ptr<dev>>& ready_list,
   std::vector<sfs::path> vec{ sfs::directory_iterator(drvpath), sfs::directory_iterator() };
   std::sort(vec.begin(), vec.end());
 
-  for (auto& path : vec) {
+  // Probe the devices in parallel, each probe reads several sysfs
+  // nodes which adds up on hosts with many cards.  Probed devices
+  // retain the sorted order.
+  std::vector<std::shared_ptr<dev>> probed(vec.size());
+  auto probe = [this, &vec, &probed](size_t idx) {
     try {
-      auto pf = create_pcidev(path.filename().string());
+      auto pf = create_pcidev(vec[idx].filename().string());
 
       // In docker, all host sysfs nodes are available. So, we need to check
       // devnode to make sure the device is really assigned to docker.
-      if (!sfs::exists(pf->get_subdev_path("", -1)))
-        continue;
-
-      // Insert detected device into proper list.
-      if (pf->m_is_ready)
-        ready_list.push_back(std::move(pf));
-      else
-        nonready_list.push_back(std::move(pf));
+      if (sfs::exists(pf->get_subdev_path("", -1)))
+        probed[idx] = std::move(pf);
     }
-    catch (const std::invalid_argument& ex) {
-      continue;
+    catch (const std::invalid_argument&) {
     }
+  };
+
+  auto threads = xrt_core::config::get_device_scan_threads();
+  if (!threads)
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  threads = std::min(threads, static_cast<unsigned int>(vec.size()));
+
+  if (threads <= 1) {
+    for (size_t idx = 0; idx < vec.size(); ++idx)
+      probe(idx);
+  }
+  else {
+    std::atomic<size_t> next {0};
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads; ++t)
+      workers.emplace_back([&next, &vec, &probe] {
+        for (auto idx = next++; idx < vec.size(); idx = next++)
+          probe(idx);
+      });
+    for (auto& worker : workers)
+      worker.join();
+  }
+
+  // Insert detected device into proper list.
+  for (auto& pf : probed) {
+    if (!pf)
+      continue;
+    if (pf->m_is_ready)
+      ready_list.push_back(std::move(pf));
+    else
+      nonready_list.push_back(std::move(pf));
   }
 }
 
@@ -14,6 +14,7 @@
 #include "core/common/shim/hwctx_handle.h"
 #include "core/common/shim/hwqueue_handle.h"
 #include "core/common/shim/shared_handle.h"
+#include "core/common/shim/stream_handle.h"
 #include "core/include/shim_int.h"
 #include "core/include/xdp/fifo.h"
 #include "core/include/xdp/trace.h"
@@ -24,6 +25,7 @@
 #include "core/common/message.h"
 #include "core/common/query_requests.h"
 #include "core/common/scheduler.h"
+#include "core/common/trace.h"
 #include "core/common/xclbin_parser.h"
 #include "core/common/AlignedAllocator.h"
 #include "core/common/api/hw_context_int.h"
@@ -55,6 +57,7 @@
 #include <sys/file.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/syscall.h>
 #include <sys/uio.h>
 #include <asm/mman.h>
@@ -231,6 +234,25 @@ public:
   }
 }; // buffer_object
 
+// Handle is owned by the import cache of the shim
+class imported_buffer_object : public buffer_object
+{
+  xocl::shim* m_shim;
+  ino_t m_ino;
+public:
+  imported_buffer_object(xocl::shim* shim, unsigned int hdl, ino_t ino)
+    : buffer_object(shim, hdl)
+    , m_shim(shim)
+    , m_ino(ino)
+  {}
+
+  ~imported_buffer_object()
+  {
+    detach_handle();
+    m_shim->release_import(m_ino);
+  }
+}; // imported_buffer_object
+
 class hwcontext : public xrt_core::hwctx_handle
 {
   xocl::shim* m_shim;
@@ -745,6 +767,87 @@ public:
 
 }; /* queue_cb */
 
+/*
+ * stream_object: xrt_core::stream_handle on top of a qdma stream queue.
+ * The queue always gets its own aio context so poll() only sees the
+ * completions of this stream. Request and completion arrays are kept
+ * with the object and reused for every call.
+ */
+class stream_object : public xrt_core::stream_handle
+{
+    std::unique_ptr<queue_cb> m_queue;
+    int m_fd;
+    direction m_dir;
+    std::mutex m_mutex;
+    std::vector<xclReqBuffer> m_bufs;
+    std::vector<xclReqCompletion> m_comps;
+
+public:
+    stream_object(struct xocl_qdma_ioc_create_queue *qinfo, direction dir,
+                  const config& cfg)
+        : m_queue(std::make_unique<queue_cb>(qinfo))
+        , m_fd(static_cast<int>(qinfo->handle))
+        , m_dir(dir)
+    {
+        if (m_queue->set_option(STREAM_OPT_AIO_MAX_EVENT, cfg.max_inflight)) {
+            m_queue.reset();
+            close(m_fd);
+            throw xrt_core::system_error(errno, "failed to set up stream aio context");
+        }
+        m_queue->set_option(STREAM_OPT_AIO_BATCH_THRESH_BYTES, cfg.batch_bytes);
+        m_queue->set_option(STREAM_OPT_AIO_BATCH_THRESH_PKTS, cfg.batch_packets);
+    }
+
+    ~stream_object()
+    {
+        m_queue.reset();
+        close(m_fd);
+    }
+
+    size_t
+    transfer(const buffer* bufs, size_t count, uint32_t flags, void* user_data) override
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_bufs.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            m_bufs[i].buf = static_cast<char*>(bufs[i].data);
+            m_bufs[i].len = bufs[i].size;
+            m_bufs[i].buf_hdl = 0;
+        }
+
+        xclQueueRequest wr = {};
+        wr.op_code = (m_dir == direction::host_to_device) ? XCL_QUEUE_WRITE : XCL_QUEUE_READ;
+        wr.bufs = m_bufs.data();
+        wr.buf_num = static_cast<uint32_t>(count);
+        wr.flag = flags;
+        wr.priv_data = user_data;
+
+        auto rc = m_queue->queue_submit_io(&wr, nullptr);
+        if (rc < 0)
+            throw xrt_core::system_error(rc == -1 ? errno : static_cast<int>(rc), "stream request failed");
+
+        return static_cast<size_t>(rc);
+    }
+
+    size_t
+    poll(completion* comps, size_t min, size_t max, uint32_t timeout_ms) override
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_comps.resize(max);
+
+        int actual = 0;
+        auto rc = m_queue->queue_poll_completion(static_cast<int>(min), static_cast<int>(max),
+                                                 m_comps.data(), &actual, static_cast<int>(timeout_ms));
+        if (rc < 0)
+            throw xrt_core::system_error(errno, "stream poll failed");
+
+        for (int i = 0; i < actual; ++i)
+            comps[i] = {m_comps[i].priv_data, m_comps[i].nbytes, m_comps[i].err_code};
+
+        return static_cast<size_t>(actual);
+    }
+};
+
 /*
  * shim()
  */
@@ -861,6 +964,10 @@ shim::~shim()
     // be done before the device is closed.
     mCmdBOCache.reset(nullptr);
 
+    if (mSubmitRing)
+      mSubmitRingBO->unmap(mSubmitRing);
+    mSubmitRingBO.reset(nullptr);
+
     dev_fini();
 
     for (const auto& p : mCuMaps) {
@@ -899,6 +1006,12 @@ size_t shim::xclWrite(xclAddressSpace space, uint64_t offset, const void *hostBu
                 xrt_logmsg(XRT_INFO, "%s: space: %d, offset:0x%x, reg:%d",
                         __func__, space, offset+i, reg[i]);
             }
+            // Control bits are written one register at a time, blocks of
+            // registers are argument space where stores can be merged
+            if (size > sizeof(uint32_t) && xrt_core::config::get_wc_kernel_args()
+                && mDev->pcieBarWriteWC(offset, hostBuf, size) == 0) {
+                return size;
+            }
             if (mDev->pcieBarWrite(offset, hostBuf, size) == 0) {
                 return size;
             }
@@ -1073,6 +1186,41 @@ int shim::xclSyncBO(unsigned int boHandle, xclBOSyncDirection dir, size_t size,
     return ret ? -errno : ret;
 }
 
+/*
+ * sync_bos() - Sync many BOs with one ioctl
+ *
+ * Entries from the first failing one are retried individually so
+ * that errors are reported per BO.  This also covers drivers that
+ * predate DRM_IOCTL_XOCL_SYNC_BO_BATCH.
+ */
+void
+shim::
+sync_bos(xclBOSyncDirection dir, const std::vector<xrt_core::buffer_handle::sync_range>& ranges)
+{
+  drm_xocl_sync_bo_dir drm_dir = (dir == XCL_BO_SYNC_BO_TO_DEVICE) ?
+    DRM_XOCL_SYNC_BO_TO_DEVICE :
+    DRM_XOCL_SYNC_BO_FROM_DEVICE;
+
+  std::vector<drm_xocl_sync_bo> syncs;
+  syncs.reserve(std::min<size_t>(ranges.size(), XOCL_SYNC_BO_BATCH_MAX));
+  for (size_t idx = 0; idx < ranges.size(); idx += syncs.size()) {
+    syncs.clear();
+    auto end = std::min<size_t>(ranges.size(), idx + XOCL_SYNC_BO_BATCH_MAX);
+    for (auto i = idx; i < end; ++i)
+      syncs.push_back({ranges[i].handle->get_xcl_handle(), 0, ranges[i].size, ranges[i].offset, drm_dir});
+
+    drm_xocl_sync_bo_batch batch = {static_cast<uint32_t>(syncs.size()), drm_dir,
+                                    reinterpret_cast<uint64_t>(syncs.data()), 0, 0};
+    if (mDev->ioctl(mUserHandle, DRM_IOCTL_XOCL_SYNC_BO_BATCH, &batch) == 0)
+      continue;
+
+    for (auto i = batch.error_index; i < syncs.size(); ++i) {
+      if (auto ret = xclSyncBO(syncs[i].handle, dir, syncs[i].size, syncs[i].offset))
+        throw xrt_core::system_error(ret, "failed to sync bo " + std::to_string(syncs[i].handle));
+    }
+  }
+}
+
 int
 shim::
 execbufCopyBO(unsigned int dst_bo_handle,
@@ -1894,6 +2042,52 @@ xclImportBO(int fd, unsigned int flags)
   return std::make_unique<xrt_shim::buffer_object>(this, info.handle);
 }
 
+/*
+ * import_bo()
+ */
+std::unique_ptr<xrt_core::buffer_handle>
+shim::
+import_bo(int fd)
+{
+  struct stat st;
+  if (fstat(fd, &st))
+    throw xrt_core::system_error(errno, "failed to import bo");
+
+  std::lock_guard<std::mutex> lk(mImportLock);
+  auto itr = mImports.find(st.st_ino);
+  if (itr == mImports.end()) {
+    drm_prime_handle info = {mNullBO, 0, fd};
+    int result = mDev->ioctl(mUserHandle, DRM_IOCTL_PRIME_FD_TO_HANDLE, &info);
+    if (result)
+      throw xrt_core::system_error(result, "failed to import bo");
+    itr = mImports.emplace(st.st_ino, ImportData{info.handle, 0}).first;
+  }
+  else if (itr->second.refs == 0) {
+    mImportIdle.remove(st.st_ino);
+  }
+
+  ++itr->second.refs;
+  return std::make_unique<xrt_shim::imported_buffer_object>(this, itr->second.handle, st.st_ino);
+}
+
+void
+shim::
+release_import(ino_t ino)
+{
+  std::lock_guard<std::mutex> lk(mImportLock);
+  auto itr = mImports.find(ino);
+  if (itr == mImports.end() || --itr->second.refs)
+    return;
+
+  mImportIdle.push_back(ino);
+  while (mImportIdle.size() > xrt_core::config::get_import_cache_size()) {
+    auto oldest = mImports.find(mImportIdle.front());
+    xclFreeBO(oldest->second.handle);
+    mImports.erase(oldest);
+    mImportIdle.pop_front();
+  }
+}
+
 /*
  * xclGetBOProperties()
  */
@@ -2063,6 +2257,47 @@ ssize_t shim::xclUnmgdPread(unsigned flags, void *buf, size_t count, uint64_t of
     return mDev->ioctl(mUserHandle, DRM_IOCTL_XOCL_PREAD_UNMGD, &unmgd);
 }
 
+/*
+ * unmgd_rwv() - Read or write scattered device memory with one ioctl
+ *
+ * Segments from the first failing one are transferred individually
+ * so that errors are reported per segment.  This also covers drivers
+ * that predate DRM_IOCTL_XOCL_UNMGD_VEC.
+ */
+void
+shim::
+unmgd_rwv(bool write, const std::vector<xrt::shim_int::unmgd_segment>& segs)
+{
+  drm_xocl_sync_bo_dir drm_dir = write ?
+    DRM_XOCL_SYNC_BO_TO_DEVICE :
+    DRM_XOCL_SYNC_BO_FROM_DEVICE;
+
+  std::vector<drm_xocl_unmgd_seg> vec;
+  vec.reserve(std::min<size_t>(segs.size(), XOCL_UNMGD_VEC_MAX));
+  for (size_t idx = 0; idx < segs.size(); idx += vec.size()) {
+    vec.clear();
+    auto end = std::min<size_t>(segs.size(), idx + XOCL_UNMGD_VEC_MAX);
+    for (auto i = idx; i < end; ++i)
+      vec.push_back({segs[i].paddr, segs[i].size, reinterpret_cast<uint64_t>(segs[i].buffer)});
+
+    drm_xocl_unmgd_vec args = {static_cast<uint32_t>(vec.size()), drm_dir,
+                               reinterpret_cast<uint64_t>(vec.data()), 0, 0};
+    if (mDev->ioctl(mUserHandle, DRM_IOCTL_XOCL_UNMGD_VEC, &args) == 0)
+      continue;
+
+    for (auto i = args.error_index; i < vec.size(); ++i) {
+      auto buf = reinterpret_cast<void*>(vec[i].data_ptr);
+      auto ret = write
+        ? xclUnmgdPwrite(0, buf, vec[i].size, vec[i].paddr)
+        : xclUnmgdPread(0, buf, vec[i].size, vec[i].paddr);
+      if (ret)
+        throw xrt_core::system_error(static_cast<int>(ret), "failed to "
+                                     + std::string(write ? "write to" : "read from")
+                                     + " address (" + std::to_string(vec[i].paddr) + ")");
+    }
+  }
+}
+
 /*
  * xclExecBuf()
  */
@@ -2070,6 +2305,7 @@ int shim::xclExecBuf(unsigned int cmdBO)
 {
     int ret;
     xrt_logmsg(XRT_INFO, "%s, cmdBO: %d", __func__, cmdBO);
+    XRT_TRACE_POINT_LOG(xclExecBuf, cmdBO);
     drm_xocl_execbuf exec = {0, cmdBO, 0,0,0,0,0,0,0,0};
     ret = mDev->ioctl(mUserHandle, DRM_IOCTL_XOCL_EXECBUF, &exec);
     return ret ? -errno : ret;
@@ -2082,11 +2318,115 @@ int shim::xclExecBuf(unsigned int cmdBO, xrt_core::hwctx_handle* hwctx_hdl)
 {
     int ret;
     xrt_logmsg(XRT_INFO, "%s, cmdBO: %d", __func__, cmdBO);
+    XRT_TRACE_POINT_LOG(xclExecBuf, cmdBO);
     drm_xocl_hw_ctx_execbuf exec = {hwctx_hdl->get_slotidx(), cmdBO, 0,0,0,0,0,0,0,0};
     ret = mDev->ioctl(mUserHandle, DRM_IOCTL_XOCL_HW_CTX_EXECBUF, &exec);
     return ret ? -errno : ret;
 }
 
+/*
+ * init_submit_ring()
+ *
+ * Allocate the submission ring on first use. The ring is not used if the
+ * driver doesn't support DRM_IOCTL_XOCL_SUBMIT_RING.
+ */
+bool shim::init_submit_ring()
+{
+    if (mSubmitRingInit)
+        return mSubmitRing != nullptr;
+
+    mSubmitRingInit = true;
+    if (!xrt_core::config::get_submit_ring())
+        return false;
+
+    // One page carries the header and 256 entries
+    const size_t size = getpagesize();
+    const uint32_t entries = 256;
+    static_assert(sizeof(xocl_submit_ring) + entries * sizeof(xocl_submit_entry) <= 4096,
+                  "submission ring does not fit in a page");
+
+    try {
+        mSubmitRingBO = xclAllocBO(size, XCL_BO_FLAGS_EXECBUF);
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+
+    auto ring = static_cast<xocl_submit_ring*>
+      (mSubmitRingBO->map(xrt_core::buffer_handle::map_type::write));
+    if (!ring) {
+        mSubmitRingBO.reset(nullptr);
+        return false;
+    }
+
+    std::memset(ring, 0, size);
+    ring->size = entries;
+    mSubmitRing = ring;
+
+    // Probe driver with an empty ring
+    if (ring_submit_ring()) {
+        xrt_logmsg(XRT_INFO, "%s: submission ring not supported, using execbuf ioctl", __func__);
+        mSubmitRingBO->unmap(ring);
+        mSubmitRingBO.reset(nullptr);
+        mSubmitRing = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * ring_submit_ring()
+ *
+ * Doorbell, the driver submits all entries queued in the ring.
+ */
+int shim::ring_submit_ring()
+{
+    drm_xocl_submit_ring args = {mSubmitRingBO->get_xcl_handle(), 0};
+    int ret = mDev->ioctl(mUserHandle, DRM_IOCTL_XOCL_SUBMIT_RING, &args);
+    return ret ? -errno : ret;
+}
+
+/*
+ * submit_ring_exec_buf()
+ *
+ * Queue cmdBO in the submission ring. Returns false if the ring is not
+ * used, in which case the command must be submitted by ioctl.
+ */
+bool shim::submit_ring_exec_buf(unsigned int cmdBO, uint32_t hw_ctx_id)
+{
+    std::lock_guard<std::mutex> lk(mSubmitRingLock);
+    if (!init_submit_ring())
+        return false;
+
+    auto ring = mSubmitRing;
+    if (auto err = __atomic_load_n(&ring->error, __ATOMIC_ACQUIRE))
+        throw xrt_core::system_error(err, "failed to launch execution buffer "
+                                     + std::to_string(ring->error_handle));
+
+    // Wait for a free entry, the doorbell drains the ring if it is full
+    auto tail = ring->tail;
+    while (tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) >= ring->size) {
+        if (auto ret = ring_submit_ring())
+            throw xrt_core::system_error(ret, "failed to drain submission ring");
+    }
+
+    auto& entry = ring->entries[tail & (ring->size - 1)];
+    entry.hw_ctx_id = hw_ctx_id;
+    entry.exec_bo_handle = cmdBO;
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+
+    // Pairs with the driver clearing draining and then reading tail.
+    // If the driver is still draining, it will pick up this entry.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&ring->draining, __ATOMIC_ACQUIRE)) {
+        if (auto ret = ring_submit_ring())
+            throw xrt_core::system_error(ret, "failed to launch execution buffer");
+    }
+
+    return true;
+}
+
 /*
  * xclExecBuf()
  */
@@ -2338,13 +2678,11 @@ int shim::xclGetSysfsPath(const char* subdev, const char* entry, char* sysfsPath
   return 0;
 }
 
-int shim::xclRegRW(bool rd, uint32_t ipIndex, uint32_t offset, uint32_t *datap)
+shim::CuData* shim::getCuMap(uint32_t ipIndex)
 {
-  std::lock_guard<std::mutex> lk(mCuMapLock);
-
   if (ipIndex >= mCuMaps.size()) {
     xrt_logmsg(XRT_ERROR, "%s: invalid CU index: %d", __func__, ipIndex);
-    return -EINVAL;
+    return nullptr;
   }
 
   auto& cumap = mCuMaps[ipIndex];  // {base, size, start, end}
@@ -2354,7 +2692,7 @@ int shim::xclRegRW(bool rd, uint32_t ipIndex, uint32_t offset, uint32_t *datap)
     auto size = xrt_core::device_query<xq::cu_size>(mCoreDevice, xq::request::modifier::subdev, cu_subdev);
     if (size <= 0 || size > 0x10000) {
       xrt_logmsg(XRT_ERROR, "%s: incorrect cu size %d", __func__, size);
-      return -EINVAL;
+      return nullptr;
     }
     auto range_str = xrt_core::device_query<xq::cu_read_range>(mCoreDevice, xq::request::modifier::subdev, cu_subdev);
     auto range = xq::cu_read_range::to_range(range_str);
@@ -2370,10 +2708,23 @@ int shim::xclRegRW(bool rd, uint32_t ipIndex, uint32_t offset, uint32_t *datap)
 
     if (cumap.addr == nullptr) {
       xrt_logmsg(XRT_ERROR, "%s: can't map CU: %d", __func__, ipIndex);
-      return -EINVAL;
+      return nullptr;
     }
   }
 
+  return &cumap;
+}
+
+int shim::xclRegRW(bool rd, uint32_t ipIndex, uint32_t offset, uint32_t *datap)
+{
+  std::lock_guard<std::mutex> lk(mCuMapLock);
+
+  auto cumapp = getCuMap(ipIndex);
+  if (!cumapp)
+    return -EINVAL;
+
+  auto& cumap = *cumapp;
+
   if ((offset & (sizeof(uint32_t) - 1)) != 0) {
     xrt_logmsg(XRT_ERROR, "%s: offset is not aligned in word: %d", __func__, offset);
     return -EINVAL;
@@ -2404,6 +2755,25 @@ int shim::xclRegRW(bool rd, uint32_t ipIndex, uint32_t offset, uint32_t *datap)
   return 0;
 }
 
+// Map of CU register space for direct access.  The mapping is shared
+// with xclRegRW and remains valid until the shim is closed.  A CU with
+// a read range is not mapped since direct writes would bypass the
+// range check.
+volatile uint32_t* shim::map_cu_registers(uint32_t ipIndex, size_t& size)
+{
+  std::lock_guard<std::mutex> lk(mCuMapLock);
+
+  auto cumap = getCuMap(ipIndex);
+  if (!cumap)
+    throw xrt_core::error(-EINVAL, "Failed to map CU(" + std::to_string(ipIndex) + ") registers");
+
+  if (cumap->start)
+    throw xrt_core::error(-EPERM, "Cannot map CU(" + std::to_string(ipIndex) + ") registers with read range");
+
+  size = cumap->size;
+  return cumap->addr;
+}
+
 int shim::xclIPSetReadRange(uint32_t ipIndex, uint32_t start, uint32_t size)
 {
     int ret = 0;
@@ -2554,6 +2924,26 @@ close_cu_context(const xrt_core::hwctx_handle* hwctx_hdl, xrt_core::cuidx_type c
   }
 }
 
+// Create a qdma stream queue between host and a kernel stream port
+std::unique_ptr<xrt_core::stream_handle>
+shim::
+create_stream(xrt::stream::direction dir, uint64_t route, uint64_t flow,
+              const xrt::stream::config& cfg)
+{
+  if (mStreamHandle < 0)
+    throw xrt_core::ishim::not_supported_error(__func__);
+
+  xocl_qdma_ioc_create_queue qinfo = {};
+  qinfo.write = (dir == xrt::stream::direction::host_to_device) ? 1 : 0;
+  qinfo.rid = route;
+  qinfo.flowid = flow;
+  qinfo.qsize = cfg.ring_size;
+  if (mDev->ioctl(mStreamHandle, XOCL_QDMA_IOC_CREATE_QUEUE, &qinfo))
+    throw xrt_core::system_error(errno, "failed to create stream queue");
+
+  return std::make_unique<stream_object>(&qinfo, dir, cfg);
+}
+
 // Assign xclbin with uuid to hardware resources and return a context id
 // The context handle is 1:1 with a slot idx
 std::unique_ptr<xrt_core::hwctx_handle>
@@ -2575,6 +2965,16 @@ create_hw_context(const xrt::uuid& xclbin_uuid,
     auto top = reinterpret_cast<const axlf*>(buffer);
     drm_xocl_create_hw_ctx hw_ctx = {};
     hw_ctx.qos = qos_val;
+    if (auto itr = cfg_param.find("cu_policy"); itr != cfg_param.end())
+      hw_ctx.qos |= (itr->second << XOCL_QOS_CU_POLICY_SHIFT) & XOCL_QOS_CU_POLICY_MASK;
+    if (auto itr = cfg_param.find("priority"); itr != cfg_param.end())
+      hw_ctx.qos |= (itr->second << XOCL_QOS_PRIORITY_SHIFT) & XOCL_QOS_PRIORITY_MASK;
+    if (auto itr = cfg_param.find("weight"); itr != cfg_param.end())
+      hw_ctx.qos |= (itr->second << XOCL_QOS_WEIGHT_SHIFT) & XOCL_QOS_WEIGHT_MASK;
+    if (auto itr = cfg_param.find("queue_depth"); itr != cfg_param.end())
+      hw_ctx.qos |= (itr->second << XOCL_QOS_DEPTH_SHIFT) & XOCL_QOS_DEPTH_MASK;
+    if (auto itr = cfg_param.find("intr_moderation"); itr != cfg_param.end())
+      hw_ctx.qos |= (itr->second << XOCL_QOS_INTR_MOD_SHIFT) & XOCL_QOS_INTR_MOD_MASK;
 
     xrt_logmsg(XRT_INFO, "%s, buffer: %s", __func__, buffer);
     if (auto ret = xclLoadHwAxlf(top, &hw_ctx)) {
@@ -2654,8 +3054,10 @@ void
 shim::
 exec_buf(xclBufferHandle boh, xrt_core::hwctx_handle* hwctx_hdl)
 {
-  // TODO: Implement new function, for now just call legacy xclExecBuf().
   auto hwctx = static_cast<const xrt_shim::hwcontext*>(hwctx_hdl);
+  if (!hwctx->is_null() && submit_ring_exec_buf(boh, hwctx_hdl->get_slotidx()))
+    return;
+
   if (hwctx->is_null()) {
     if (auto ret = xclExecBuf(boh))
       throw xrt_core::system_error(ret, "failed to launch execution buffer");
@@ -2679,6 +3081,14 @@ open_by_bdf(const std::string& bdf)
   return xclOpen(xrt_core::pci::get_device_id_from_bdf(bdf), nullptr, XCL_QUIET);
 }
 
+std::unique_ptr<xrt_core::stream_handle>
+create_stream(xclDeviceHandle handle, xrt::stream::direction dir, uint64_t route, uint64_t flow,
+              const xrt::stream::config& cfg)
+{
+  auto shim = get_shim_object(handle);
+  return shim->create_stream(dir, route, flow, cfg);
+}
+
 std::unique_ptr<xrt_core::hwctx_handle>
 create_hw_context(xclDeviceHandle handle,
                   const xrt::uuid& xclbin_uuid,
@@ -2715,7 +3125,36 @@ std::unique_ptr<xrt_core::buffer_handle>
 import_bo(xclDeviceHandle handle, xrt_core::shared_handle::export_handle ehdl)
 {
   auto shim = get_shim_object(handle);
-  return shim->xclImportBO(ehdl, 0);
+  return shim->import_bo(ehdl);
+}
+
+void
+unmgd_preadv(xclDeviceHandle handle, const std::vector<unmgd_segment>& segs)
+{
+  auto shim = get_shim_object(handle);
+  shim->unmgd_rwv(false, segs);
+}
+
+void
+unmgd_pwritev(xclDeviceHandle handle, const std::vector<unmgd_segment>& segs)
+{
+  auto shim = get_shim_object(handle);
+  shim->unmgd_rwv(true, segs);
+}
+
+void
+sync_bos(xclDeviceHandle handle, xrt_core::buffer_handle::direction dir,
+         const std::vector<xrt_core::buffer_handle::sync_range>& ranges)
+{
+  auto shim = get_shim_object(handle);
+  shim->sync_bos(static_cast<xclBOSyncDirection>(dir), ranges);
+}
+
+volatile uint32_t*
+map_cu_registers(xclDeviceHandle handle, uint32_t ipidx, size_t& size)
+{
+  auto shim = get_shim_object(handle);
+  return shim->map_cu_registers(ipidx, size);
 }
 
 } // xrt::shim_int
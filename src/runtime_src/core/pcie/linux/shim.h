@@ -13,6 +13,7 @@
 #include "core/common/xrt_profiling.h"
 #include "core/common/shim/hwctx_handle.h"
 #include "core/common/shim/hwqueue_handle.h"
+#include "core/common/shim/stream_handle.h"
 #include "core/pcie/driver/linux/include/qdma_ioctl.h"
 #include "core/pcie/driver/linux/include/xocl_ioctl.h"
 
@@ -20,6 +21,7 @@
 #include "core/include/xstream.h" /* for stream_opt_type */
 
 #include <linux/aio_abi.h>
+#include <sys/types.h>
 #include <libdrm/drm.h>
 
 #include <cassert>
@@ -47,6 +49,7 @@ public:
   size_t xclRead(xclAddressSpace space, uint64_t offset, void *hostBuf, size_t size);
   // Restricted read/write on IP register space
   int xclRegWrite(uint32_t ipIndex, uint32_t offset, uint32_t data);
+  volatile uint32_t* map_cu_registers(uint32_t ipIndex, size_t& size);
   int xclRegRead(uint32_t ipIndex, uint32_t offset, uint32_t *datap);
 
   std::unique_ptr<xrt_core::buffer_handle>
@@ -61,6 +64,7 @@ public:
   void *xclMapBO(unsigned int boHandle, bool write);
   int xclUnmapBO(unsigned int boHandle, void* addr);
   int xclSyncBO(unsigned int boHandle, xclBOSyncDirection dir, size_t size, size_t offset);
+  void sync_bos(xclBOSyncDirection dir, const std::vector<xrt_core::buffer_handle::sync_range>& ranges);
   int xclCopyBO(unsigned int dst_boHandle, unsigned int src_boHandle, size_t size,
                 size_t dst_offset, size_t src_offset);
 
@@ -72,6 +76,11 @@ public:
   std::unique_ptr<xrt_core::buffer_handle>
   xclImportBO(int fd, unsigned flags);
 
+  // Import shared by all importers of the same dma-buf
+  std::unique_ptr<xrt_core::buffer_handle>
+  import_bo(int fd);
+  void release_import(ino_t ino);
+
   int xclGetBOProperties(unsigned int boHandle, xclBOProperties *properties);
 
   // Bitstream/bin download
@@ -94,6 +103,7 @@ public:
 
   ssize_t xclUnmgdPwrite(unsigned flags, const void *buf, size_t count, uint64_t offset);
   ssize_t xclUnmgdPread(unsigned flags, void *buf, size_t count, uint64_t offset);
+  void unmgd_rwv(bool write, const std::vector<xrt::shim_int::unmgd_segment>& segs);
 
   int xclGetSectionInfo(void *section_info, size_t *section_size, enum axlf_section_kind, int index);
 
@@ -151,6 +161,10 @@ public:
   void
   close_cu_context(const xrt_core::hwctx_handle* hwctx_hdl, xrt_core::cuidx_type cuidx);
 
+  std::unique_ptr<xrt_core::stream_handle>
+  create_stream(xrt::stream::direction dir, uint64_t route, uint64_t flow,
+                const xrt::stream::config& cfg);
+
   std::unique_ptr<xrt_core::hwctx_handle>
   create_hw_context(const xrt::uuid&, const xrt::hw_context::cfg_param_type&, xrt::hw_context::access_mode);
 
@@ -165,6 +179,11 @@ public:
   void
   exec_buf(xclBufferHandle boh, xrt_core::hwctx_handle* ctxhdl);
 private:
+  // Submission ring shared with driver, see Runtime.submit_ring
+  bool init_submit_ring();
+  int ring_submit_ring();
+  bool submit_ring_exec_buf(unsigned int cmdBO, uint32_t hw_ctx_id);
+
   std::shared_ptr<xrt_core::device> mCoreDevice;
   std::shared_ptr<xrt_core::pci::dev> mDev;
   std::ofstream mLogStream;
@@ -181,6 +200,12 @@ private:
   std::string mDevUserName;
   std::unique_ptr<xrt_core::bo_cache> mCmdBOCache;
 
+  // Submission ring, mSubmitRing is nullptr when ring is not used
+  std::mutex mSubmitRingLock;
+  bool mSubmitRingInit = false;
+  std::unique_ptr<xrt_core::buffer_handle> mSubmitRingBO;
+  xocl_submit_ring* mSubmitRing = nullptr;
+
   /*
    * Mapped CU register space for xclRegRead/Write(). We support at most
    * 128 CUs and each CU map is a pair <address, size>.
@@ -194,6 +219,20 @@ private:
   std::vector<CuData> mCuMaps;
   std::mutex mCuMapLock;
 
+  /*
+   * Imported dma-bufs by dma-buf inode. DRM returns the same GEM handle
+   * for a dma-buf already imported, so the handle is closed only when
+   * the last importer releases it. Released entries are kept attached
+   * up to get_import_cache_size(), least recently used are closed first.
+   */
+  struct ImportData {
+      unsigned int handle;
+      unsigned int refs;
+  };
+  std::map<ino_t, ImportData> mImports;
+  std::list<ino_t> mImportIdle;
+  std::mutex mImportLock;
+
   bool zeroOutDDR();
   bool isXPR() const {
     return ((mDeviceInfo.mSubsystemId >> 12) == 4);
@@ -214,6 +253,7 @@ private:
   int freeAXIGate();
 
   int xclRegRW(bool rd, uint32_t ipIndex, uint32_t offset, uint32_t *datap);
+  CuData* getCuMap(uint32_t ipIndex); // mCuMapLock must be held
 
   bool readPage(unsigned addr, uint8_t readCmd = 0xff);
   bool writePage(unsigned addr, uint8_t writeCmd = 0xff);
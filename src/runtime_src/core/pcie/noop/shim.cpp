@@ -17,17 +17,24 @@
 #include "core/common/device.h"
 #include "core/common/message.h"
 #include "core/common/system.h"
-#include "core/common/task.h"
 #include "core/common/thread.h"
 #include "core/common/shim/buffer_handle.h"
 #include "core/common/shim/hwctx_handle.h"
 
 #include "core/common/api/hw_context_int.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <mutex>
+#include <queue>
+#include <random>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
 namespace { // private implementation details
 
@@ -285,37 +292,102 @@ static std::vector<std::shared_ptr<pl::device>> s_devices;
 
 // Simulate asynchronous command completion.
 //
-// Command handles are added to a producer/consumer queue A worker
-// thread pretends to run the command and marks it complete only if
-// the command was enqueue some constant time before now.
+// Without synthetic latency configured, commands are marked complete
+// when submitted.  Otherwise command completion is simulated per
+// xrt.ini:
+//
+//  Runtime.noop_cu_service_us: mean service time of a command on a CU
+//  Runtime.noop_cu_service_distribution: fixed, uniform, or exponential
+//  Runtime.noop_irq_latency_us: latency from CU done to command complete
+//  Runtime.noop_completion_delay_us: constant delay added to every command
+//
+// A CU services one command at a time, a command is serviced by the
+// CU in its CU mask that is available first.  Completion times are
+// computed at submission and a completer thread marks commands
+// complete in order of completion time.
 namespace cmd {
 
-static unsigned int completion_delay_us = 0;
-static xrt_core::task::queue running_queue;
-static std::thread completer;
-static std::atomic<uint64_t> completion_count {0};
+using clock = std::chrono::steady_clock;
 
-struct cmd_type
+struct pending_type
 {
+  clock::time_point done;
   xclBufferHandle handle;
-  unsigned long queue_time;
-  cmd_type(xclBufferHandle h)
-    : handle(h), queue_time(xrt_core::time_ns())
-  {}
+
+  bool
+  operator>(const pending_type& rhs) const
+  {
+    return done > rhs.done;
+  }
 };
 
+static bool simulate = false;
+static clock::duration completion_delay {0};
+static clock::duration irq_latency {0};
+static clock::duration cu_service {0};
+static std::string cu_service_distribution;
+static std::mt19937_64 rng;  // fixed seed for reproducible runs
+static std::array<clock::time_point, 128> cu_available;
+
+static std::mutex mutex;
+static std::condition_variable work;
+static std::priority_queue<pending_type, std::vector<pending_type>, std::greater<pending_type>> pending;
+static bool stopped = false;
+static std::thread completer;
+static std::atomic<uint64_t> completion_count {0};
+
+static void
+mark_cmd_handle_complete(xclBufferHandle handle)
+{
+  //XRT_PRINTF("handle(%d) is complete\n", handle);
+  auto hbuf = buffer::map(handle);
+  auto cmd = reinterpret_cast<ert_packet*>(hbuf);
+  cmd->state = ERT_CMD_STATE_COMPLETED;
+  ++completion_count;
+}
+
+static void
+complete()
+{
+  std::unique_lock<std::mutex> lk(mutex);
+  while (!stopped) {
+    if (pending.empty()) {
+      work.wait(lk);
+      continue;
+    }
+
+    auto next = pending.top();
+    if (clock::now() < next.done) {
+      work.wait_until(lk, next.done);
+      continue;
+    }
+
+    pending.pop();
+    mark_cmd_handle_complete(next.handle);
+  }
+}
+
 static void
 init()
 {
-  if ( (completion_delay_us = xrt_core::config::get_noop_completion_delay_us()) )
-    completer = std::move(xrt_core::thread(xrt_core::task::worker, std::ref(running_queue)));
+  completion_delay = std::chrono::microseconds(xrt_core::config::get_noop_completion_delay_us());
+  irq_latency = std::chrono::microseconds(xrt_core::config::get_noop_irq_latency_us());
+  cu_service = std::chrono::microseconds(xrt_core::config::get_noop_cu_service_us());
+  cu_service_distribution = xrt_core::config::get_noop_cu_service_distribution();
+  simulate = (completion_delay.count() || irq_latency.count() || cu_service.count());
+  if (simulate)
+    completer = xrt_core::thread(complete);
 }
 
 static void
 stop()
 {
-  if (completion_delay_us) {
-    running_queue.stop();
+  if (simulate) {
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      stopped = true;
+    }
+    work.notify_all();
     completer.join();
   }
 }
@@ -327,30 +399,85 @@ wait()
   --completion_count;
 }
 
-static void
-mark_cmd_handle_complete(xclBufferHandle handle)
+// Service time of one command per configured distribution
+static clock::duration
+sample_service_time()
 {
-  //XRT_PRINTF("handle(%d) is complete\n", handle);
-  auto hbuf = buffer::map(handle);
-  auto cmd = reinterpret_cast<ert_packet*>(hbuf);
-  cmd->state = ERT_CMD_STATE_COMPLETED;
-  ++completion_count;
+  if (!cu_service.count())
+    return clock::duration{0};
+
+  double mean = static_cast<double>(cu_service.count());
+  double ticks = mean;
+  if (cu_service_distribution == "uniform")
+    ticks = std::uniform_real_distribution<double>(0, 2 * mean)(rng);
+  else if (cu_service_distribution == "exponential")
+    ticks = std::exponential_distribution<double>(1 / mean)(rng);
+  return clock::duration{static_cast<clock::rep>(ticks)};
 }
 
-static void
-mark_cmd_complete(cmd_type ct)
+static bool
+is_cu_command(const ert_packet* pkt)
+{
+  switch (pkt->opcode) {
+  case ERT_START_CU:
+  case ERT_EXEC_WRITE:
+  case ERT_START_FA:
+  case ERT_START_KEY_VAL:
+  case ERT_START_DPU:
+  case ERT_START_NPU:
+  case ERT_START_NPU_PREEMPT:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Time at which command completes on the first available CU in
+// its CU mask.  Must be called with mutex locked.
+static clock::time_point
+schedule(const ert_packet* pkt, clock::time_point now)
 {
-  while (xrt_core::time_ns() - ct.queue_time < completion_delay_us * 1000);
-  mark_cmd_handle_complete(ct.handle);
+  if (!is_cu_command(pkt))
+    return now;
+
+  auto kcmd = reinterpret_cast<const ert_start_kernel_cmd*>(pkt);
+  const uint32_t* masks = &kcmd->cu_mask;
+  size_t cu = cu_available.size();
+  for (uint32_t m = 0; m <= kcmd->extra_cu_masks; ++m) {
+    for (uint32_t bit = 0; bit < 32; ++bit) {
+      if (!(masks[m] & (1u << bit)))
+        continue;
+      auto idx = m * 32 + bit;
+      if (cu == cu_available.size() || cu_available[idx] < cu_available[cu])
+        cu = idx;
+    }
+  }
+
+  if (cu == cu_available.size())
+    return now;
+
+  auto start = std::max(now, cu_available[cu]);
+  auto done = start + sample_service_time();
+  cu_available[cu] = done;
+  return done;
 }
 
 static void
 add(xclBufferHandle handle)
 {
-  if (completion_delay_us)
-    xrt_core::task::createF(running_queue, mark_cmd_complete, cmd_type(handle));
-  else
+  if (!simulate) {
     mark_cmd_handle_complete(handle);
+    return;
+  }
+
+  auto pkt = reinterpret_cast<const ert_packet*>(buffer::map(handle));
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    auto now = clock::now();
+    auto done = schedule(pkt, now) + irq_latency + completion_delay;
+    pending.push({done, handle});
+  }
+  work.notify_one();
 }
 
 struct X
@@ -363,6 +490,40 @@ static X x;
 
 } // cmd
 
+// Simulate DMA bandwidth of BO sync per xrt.ini
+// Runtime.noop_dma_bandwidth_mbps.  Each direction is a channel that
+// transfers one buffer at a time, the calling thread blocks until its
+// transfer is done.
+namespace dma {
+
+using clock = std::chrono::steady_clock;
+
+static std::mutex mutex;
+static std::array<clock::time_point, 2> channel_available;
+
+static void
+transfer(xclBOSyncDirection dir, size_t size)
+{
+  static auto mbps = xrt_core::config::get_noop_dma_bandwidth_mbps();
+  if (!mbps)
+    return;
+
+  // MB/s is bytes per us
+  auto duration = std::chrono::duration_cast<clock::duration>
+    (std::chrono::duration<double, std::micro>(static_cast<double>(size) / mbps));
+
+  clock::time_point done;
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    auto& available = channel_available[dir == XCL_BO_SYNC_BO_FROM_DEVICE ? 1 : 0];
+    done = std::max(clock::now(), available) + duration;
+    available = done;
+  }
+  std::this_thread::sleep_until(done);
+}
+
+} // dma
+
 
 struct shim
 {
@@ -582,8 +743,9 @@ public:
   }
 
   int
-  sync_bo(buffer_handle_type, xclBOSyncDirection, size_t, size_t)
+  sync_bo(buffer_handle_type handle, xclBOSyncDirection dir, size_t size, size_t)
   {
+    dma::transfer(dir, size ? size : buffer::get(handle)->size);
     return 0;
   }
 
@@ -63,6 +63,12 @@ public:
     return xrt::shim_int::alloc_bo(get_device_handle(), userptr, size, xcl_bo_flags{flags}.flags);
   }
 
+  void
+  sync_bos(buffer_handle::direction dir, const std::vector<buffer_handle::sync_range>& ranges) override
+  {
+    xrt::shim_int::sync_bos(get_device_handle(), dir, ranges);
+  }
+
   void
   get_device_info(xclDeviceInfo2 *info) override
   {
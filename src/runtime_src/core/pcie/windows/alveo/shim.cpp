@@ -36,15 +36,142 @@
 #include <cstring>
 #include <cstdio>
 #include <ctime>
+#include <future>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <regex>
+#include <thread>
+#include <vector>
 
 #pragma warning(disable : 4100 4996)
 #pragma comment (lib, "Setupapi.lib")
 
 namespace { // private implementation details
 
+// class overlapped_io - Overlapped DeviceIoControl with completion port
+//
+// Handles opened with FILE_FLAG_OVERLAPPED are associated with the
+// completion port of the device.  An ioctl is submitted with an
+// OVERLAPPED embedded in a request object and returns a future that
+// a completion thread fulfils with the Win32 error code when the
+// driver completes the request.  Many requests can be in flight from
+// one thread, and I/O on different overlapped handles is not
+// serialized by the I/O manager as it is for synchronous handles.
+class overlapped_io
+{
+  static constexpr ULONG_PTR stop_key = 1;
+
+  struct request
+  {
+    OVERLAPPED ov = {};
+    std::promise<DWORD> done;
+
+    virtual
+    ~request() = default;
+  };
+
+  // Request with a copy of the ioctl input argument, which must
+  // outlive the request
+  template <typename ArgType>
+  struct arg_request : request
+  {
+    ArgType arg;
+
+    explicit
+    arg_request(const ArgType& a)
+      : arg(a)
+    {}
+  };
+
+  HANDLE m_port;
+  std::thread m_completer;
+
+  void
+  complete()
+  {
+    while (true) {
+      DWORD bytes = 0;
+      ULONG_PTR key = 0;
+      LPOVERLAPPED ov = nullptr;
+      auto ok = GetQueuedCompletionStatus(m_port, &bytes, &key, &ov, INFINITE);
+      if (!ov) {
+        if (!ok || key == stop_key)
+          return;
+        continue;
+      }
+
+      std::unique_ptr<request> req(CONTAINING_RECORD(ov, request, ov));
+      req->done.set_value(ok ? ERROR_SUCCESS : GetLastError());
+    }
+  }
+
+  std::future<DWORD>
+  submit(std::unique_ptr<request> req, HANDLE handle, DWORD code,
+         void* in, DWORD in_size, void* out, DWORD out_size)
+  {
+    auto done = req->done.get_future();
+    if (!DeviceIoControl(handle, code, in, in_size, out, out_size, nullptr, &req->ov)) {
+      auto error = GetLastError();
+      if (error != ERROR_IO_PENDING) {
+        // No completion packet is queued for a failed submission
+        req->done.set_value(error);
+        return done;
+      }
+    }
+
+    // Completion packet is queued also when completed synchronously,
+    // the completion thread takes ownership of the request
+    req.release();
+    return done;
+  }
+
+public:
+  overlapped_io()
+    : m_port(CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1))
+  {
+    if (!m_port)
+      throw xrt_core::system_error(GetLastError(), "CreateIoCompletionPort failed");
+    m_completer = std::thread([this] { complete(); });
+  }
+
+  ~overlapped_io()
+  {
+    PostQueuedCompletionStatus(m_port, 0, stop_key, nullptr);
+    m_completer.join();
+    CloseHandle(m_port);
+  }
+
+  overlapped_io(const overlapped_io&) = delete;
+  overlapped_io& operator=(const overlapped_io&) = delete;
+
+  // Associate a handle opened with FILE_FLAG_OVERLAPPED
+  void
+  associate(HANDLE handle)
+  {
+    if (!CreateIoCompletionPort(handle, m_port, 0, 0))
+      throw xrt_core::system_error(GetLastError(), "CreateIoCompletionPort failed");
+  }
+
+  // Submit ioctl with input argument copied into the request.  The
+  // output buffer, if any, must stay valid until the future is ready.
+  template <typename ArgType>
+  std::future<DWORD>
+  ioctl(HANDLE handle, DWORD code, const ArgType& arg, void* out = nullptr, DWORD out_size = 0)
+  {
+    auto req = std::make_unique<arg_request<ArgType>>(arg);
+    auto in = &req->arg;
+    return submit(std::move(req), handle, code, in, sizeof(ArgType), out, out_size);
+  }
+
+  // Submit ioctl without input argument
+  std::future<DWORD>
+  ioctl_out(HANDLE handle, DWORD code, void* out, DWORD out_size)
+  {
+    return submit(std::make_unique<request>(), handle, code, nullptr, 0, out, out_size);
+  }
+};
+
 struct shim
 {
   using buffer_handle_type = xclBufferHandle; // xrt.h
@@ -52,6 +179,8 @@ struct shim
   XOCL_MAP_BAR_RESULT	mappedBar[3];
   bool m_locked = false;
   HANDLE m_dev;
+  HANDLE m_exec = INVALID_HANDLE_VALUE; // overlapped handle for exec and poll
+  overlapped_io m_io;                   // completion port for buffer and exec I/O
   std::shared_ptr<xrt_core::device> m_core_device;
 
 public:
@@ -260,6 +389,23 @@ public:
       throw std::runtime_error("CreateFile failed with error " + std::to_string(error));
     }
 
+    // Second device handle for overlapped exec and poll, so that a
+    // pending poll does not block command submission nor the
+    // synchronous ioctls on m_dev
+    m_exec = CreateFileW(L"\\\\.\\XOCL_USER-0" XOCL_USER_DEVICE_DEVICE_NAMESPACE,
+                         GENERIC_READ | GENERIC_WRITE,
+                         0,
+                         0,
+                         OPEN_EXISTING,
+                         FILE_FLAG_OVERLAPPED,
+                         0);
+    if (m_exec == INVALID_HANDLE_VALUE) {
+      auto error = GetLastError();
+      CloseHandle(m_dev);
+      throw xrt_core::system_error(error, "CreateFile (overlapped) failed");
+    }
+    m_io.associate(m_exec);
+
     DWORD bytesRead;
     XOCL_MAP_BAR_ARGS mapBar = { 0 };
     XOCL_MAP_BAR_RESULT mapBarResult = { 0 };
@@ -316,6 +462,7 @@ public:
   ~shim()
   {
     // close the device
+    CloseHandle(m_exec);
     CloseHandle(m_dev);
   }
 
@@ -327,31 +474,25 @@ public:
                               0,
                               0,
                               OPEN_EXISTING,
-                              0,
+                              FILE_FLAG_OVERLAPPED,
                               0);
 
     // If this call fails, check to figure out what the error is and report it.
     if (bufferHandle == INVALID_HANDLE_VALUE)
       throw xrt_core::system_error(GetLastError(), "CreateFileW failed");
 
+    associate_bo(bufferHandle);
+
     XOCL_CREATE_BO_ARGS createBOArgs;
-    DWORD bytesWritten;
 
     //'size' needs to be multiple of 4K
     createBOArgs.Size = ((size % 4096) == 0) ? size : (((4096 + size) / 4096) * 4096);
     createBOArgs.BankNumber = flags & 0xFFFFFFLL;
     createBOArgs.BufferType = (flags & XCL_BO_FLAGS_P2P) ? XOCL_BUFFER_TYPE_P2P : XOCL_BUFFER_TYPE_NORMAL;
 
-    if (!DeviceIoControl(bufferHandle,
-                         IOCTL_XOCL_CREATE_BO,
-                         &createBOArgs,
-                         sizeof(XOCL_CREATE_BO_ARGS),
-                         0,
-                         0,
-                         &bytesWritten,
-                         nullptr)) {
+    if (auto error = m_io.ioctl(bufferHandle, IOCTL_XOCL_CREATE_BO, createBOArgs).get()) {
       CloseHandle(bufferHandle);
-      throw xrt_core::system_error(GetLastError(), "IOCTL_XOCL_CREATE_BO failed");
+      throw xrt_core::system_error(error, "IOCTL_XOCL_CREATE_BO failed");
     }
 
     return std::make_unique<buffer_object>(this, bufferHandle);
@@ -365,7 +506,7 @@ public:
                                0,
                                0,
                                OPEN_EXISTING,
-                               0,
+                               FILE_FLAG_OVERLAPPED,
                                0);
 
     //
@@ -374,24 +515,18 @@ public:
     if (bufferHandle == INVALID_HANDLE_VALUE)
       throw xrt_core::system_error(GetLastError(), "CreateFileW failed");
 
+    associate_bo(bufferHandle);
+
     XOCL_USERPTR_BO_ARGS userPtrBO;
-    DWORD bytesWritten;
 
     userPtrBO.Address = userptr;
     userPtrBO.Size = ((size % 4096) == 0) ? size : (((4096 + size) / 4096) * 4096);
     userPtrBO.BankNumber = flags & 0xFFFFFFLL;
     userPtrBO.BufferType = XOCL_BUFFER_TYPE_USERPTR;
 
-    if (!DeviceIoControl(bufferHandle,
-                         IOCTL_XOCL_USERPTR_BO,
-                         &userPtrBO,
-                         sizeof(XOCL_USERPTR_BO_ARGS),
-                         0,
-                         0,
-                         &bytesWritten,
-                         nullptr)) {
+    if (auto error = m_io.ioctl(bufferHandle, IOCTL_XOCL_USERPTR_BO, userPtrBO).get()) {
       CloseHandle(bufferHandle);
-      throw xrt_core::system_error(GetLastError(), "IOCTL_XOCL_USERPTR_BO failed");
+      throw xrt_core::system_error(error, "IOCTL_XOCL_USERPTR_BO failed");
     }
 
     return std::make_unique<buffer_object>(this, bufferHandle);
@@ -401,9 +536,7 @@ public:
   void*
   map_bo(buffer_handle_type handle, bool write)
   {
-    DWORD bytesWritten;
     XOCL_MAP_BO_RESULT mapBO;
-    DWORD  code;
 
     if (handle)
       xrt_core::message::
@@ -414,17 +547,7 @@ public:
       return nullptr;
     }
 
-    if (!DeviceIoControl(handle,
-                         IOCTL_XOCL_MAP_BO,
-                         0,
-                         0,
-                         &mapBO,
-                         sizeof(XOCL_MAP_BO_RESULT),
-                         &bytesWritten,
-                         nullptr)) {
-
-      code = GetLastError();
-
+    if (auto code = m_io.ioctl_out(handle, IOCTL_XOCL_MAP_BO, &mapBO, sizeof(XOCL_MAP_BO_RESULT)).get()) {
       xrt_core::message::
         send(xrt_core::message::severity_level::error, "XRT", "DeviceIoControl 3 failed with error %d", code);
       return nullptr;
@@ -453,6 +576,20 @@ public:
     return 0;
   }
 
+  // Buffer handles are opened for overlapped I/O, all ioctls on
+  // them go through the completion port
+  void
+  associate_bo(HANDLE handle)
+  {
+    try {
+      m_io.associate(handle);
+    }
+    catch (...) {
+      CloseHandle(handle);
+      throw;
+    }
+  }
+
   void
   free_bo(buffer_handle_type handle)
   {
@@ -461,28 +598,23 @@ public:
       CloseHandle(handle);
   }
 
-  int
-  sync_bo(buffer_handle_type handle, xclBOSyncDirection dir, size_t size, size_t offset)
+  // Start a sync, the returned future holds the error code
+  std::future<DWORD>
+  sync_bo_async(buffer_handle_type handle, xclBOSyncDirection dir, size_t size, size_t offset)
   {
-    DWORD bytesWritten;
-    DWORD  error;
     XOCL_SYNC_BO_ARGS syncBo = { 0 };
 
     syncBo.Direction = (dir == XCL_BO_SYNC_BO_TO_DEVICE) ? XOCL_BUFFER_DIRECTION_TO_DEVICE : XOCL_BUFFER_DIRECTION_FROM_DEVICE;
     syncBo.Offset = offset;
     syncBo.Size = size;
 
-    if (!DeviceIoControl(handle,
-                         IOCTL_XOCL_SYNC_BO,
-                         &syncBo,
-                         sizeof(XOCL_SYNC_BO_ARGS),
-                         nullptr,
-                         0,
-                         &bytesWritten,
-                         nullptr)) {
-
-      error = GetLastError();
+    return m_io.ioctl(handle, IOCTL_XOCL_SYNC_BO, syncBo);
+  }
 
+  int
+  sync_bo(buffer_handle_type handle, xclBOSyncDirection dir, size_t size, size_t offset)
+  {
+    if (auto error = sync_bo_async(handle, dir, size, offset).get()) {
       xrt_core::message::
         send(xrt_core::message::severity_level::error, "XRT", "Sync write failed with error %d", error);
 
@@ -492,6 +624,27 @@ public:
     return 0;
   }
 
+  // Sync many buffers with all transfers in flight at once.  All
+  // transfers are waited for before the first error is thrown.
+  void
+  sync_bos(xclBOSyncDirection dir, const std::vector<xrt_core::buffer_handle::sync_range>& ranges)
+  {
+    std::vector<std::future<DWORD>> syncs;
+    syncs.reserve(ranges.size());
+    for (const auto& range : ranges)
+      syncs.push_back(sync_bo_async(range.handle->get_xcl_handle(), dir, range.size, range.offset));
+
+    DWORD error = 0;
+    for (auto& sync : syncs) {
+      auto ret = sync.get();
+      if (ret && !error)
+        error = ret;
+    }
+
+    if (error)
+      throw xrt_core::system_error(error, "failed to sync buffers");
+  }
+
   // {D8E1267B-5041-BA45-A8AC-D93D3CCA1378}
  // unsigned char GUID_VALIDATE_XCLBIN[16]	  {0xD8,0xE1,0x26,0x7B, 0x50,0x41, 0xBA,0x45, 0xA8, 0xAC, 0xD9, 0x3D, 0x3C, 0xCA, 0x13, 0x78};
 
@@ -559,25 +712,14 @@ public:
   int
   exec_buf(buffer_handle_type handle)
   {
-    HANDLE deviceHandle = m_dev;
     XOCL_EXECBUF_ARGS execArgs = { 0 };
-    DWORD bytesRet;
     execArgs.ExecBO = handle;
 
-    if (!DeviceIoControl(deviceHandle,
-                         IOCTL_XOCL_EXECBUF,
-                         &execArgs,
-                         sizeof(XOCL_EXECBUF_ARGS),
-                         NULL,
-                         0,
-                         &bytesRet,
-                         NULL)) {
-
-      auto error = GetLastError();
+    if (auto error = m_io.ioctl(m_exec, IOCTL_XOCL_EXECBUF, execArgs).get()) {
       xrt_core::message::
         send(xrt_core::message::severity_level::error, "XRT", "CTX failed with error %d", error);
 
-      if (GetLastError() == ERROR_BAD_COMMAND) {
+      if (error == ERROR_BAD_COMMAND) {
 
         //
         // Device is already configured, not really a problem...
@@ -596,28 +738,16 @@ public:
   int
   exec_wait(int msec)
   {
-    HANDLE deviceHandle = m_dev;
     BOOLEAN workToDo;
     XOCL_EXECPOLL_ARGS pollArgs;
-    DWORD error;
-    DWORD commandsCompleted;
 
     workToDo = FALSE;
-    commandsCompleted = 0;
 
     pollArgs.DelayInMS = msec;
 
-    if (!DeviceIoControl(deviceHandle,
-                         IOCTL_XOCL_EXECPOLL,
-                         &pollArgs,
-                         sizeof(XOCL_EXECPOLL_ARGS),
-                         NULL,
-                         0,
-                         &commandsCompleted,
-                         NULL)) {
-
-      error = GetLastError();
-
+    // Poll is pending on the overlapped exec handle, commands can be
+    // submitted by other threads while this thread waits
+    if (auto error = m_io.ioctl(m_exec, IOCTL_XOCL_EXECPOLL, pollArgs).get()) {
       xrt_core::message::
         send(xrt_core::message::severity_level::error, "XRT"
              ,"DeviceIoControl IOCTL_XOCL_EXECPOLL failed with error %d", error);
@@ -637,19 +767,8 @@ public:
   get_bo_properties(buffer_handle_type handle, struct xclBOProperties* properties)
   {
     XOCL_INFO_BO_RESULT infoBo = { 0 };
-    DWORD error;
-    DWORD bytesRet;
-
-    if (!DeviceIoControl(handle,
-                         IOCTL_XOCL_INFO_BO,
-                         NULL,
-                         0,
-                         &infoBo,
-                         sizeof(XOCL_INFO_BO_RESULT),
-                         &bytesRet,
-                         NULL)) {
 
-      error = GetLastError();
+    if (auto error = m_io.ioctl_out(handle, IOCTL_XOCL_INFO_BO, &infoBo, sizeof(XOCL_INFO_BO_RESULT)).get()) {
       xrt_core::message::
         send(xrt_core::message::severity_level::error, "XRT"
              ,"get_bo_Properties - DeviceIoControl failed with error %d", error);
@@ -969,22 +1088,10 @@ public:
   write_bo(xclBufferHandle boHandle, const void *src, size_t size, size_t seek)
   {
       XOCL_PWRITE_BO_ARGS pwriteBO;
-      DWORD  code;
-      DWORD bytesWritten;
 
       pwriteBO.Offset = seek;
 
-      if (!DeviceIoControl(boHandle,
-          IOCTL_XOCL_PWRITE_BO,
-          &pwriteBO,
-          sizeof(XOCL_PWRITE_BO_ARGS),
-          (void *)src,
-          (DWORD)size,
-          &bytesWritten,
-          nullptr)) {
-
-          code = GetLastError();
-
+      if (auto code = m_io.ioctl(boHandle, IOCTL_XOCL_PWRITE_BO, pwriteBO, const_cast<void*>(src), (DWORD)size).get()) {
           xrt_core::message::
               send(xrt_core::message::severity_level::error, "XRT", "DeviceIoControl PWRITE failed with error %d", code);
           return code;
@@ -997,21 +1104,10 @@ public:
   read_bo(xclBufferHandle boHandle, void *dst, size_t size, size_t skip)
   {
       XOCL_PREAD_BO_ARGS preadBO;
-      DWORD  code;
-      DWORD bytesRead;
 
       preadBO.Offset = skip;
 
-      if (!DeviceIoControl(boHandle,
-          IOCTL_XOCL_PREAD_BO,
-          &preadBO,
-          sizeof(XOCL_PREAD_BO_ARGS),
-          dst,
-          (DWORD)size,
-          &bytesRead,
-          nullptr)) {
-
-          code = GetLastError();
+      if (auto code = m_io.ioctl(boHandle, IOCTL_XOCL_PREAD_BO, preadBO, dst, (DWORD)size).get()) {
           xrt_core::message::
               send(xrt_core::message::severity_level::error, "XRT", "DeviceIoControl PREAD failed with error %d", code);
           return code;
@@ -1718,6 +1814,14 @@ alloc_bo(xclDeviceHandle handle, void* userptr, size_t size, unsigned int flags)
   return shim->alloc_user_ptr_bo(userptr, size, flags);
 }
 
+void
+sync_bos(xclDeviceHandle handle, xrt_core::buffer_handle::direction dir,
+         const std::vector<xrt_core::buffer_handle::sync_range>& ranges)
+{
+  auto shim = get_shim_object(handle);
+  shim->sync_bos(static_cast<xclBOSyncDirection>(dir), ranges);
+}
+
 } // namespace xrt::shim_int
 ////////////////////////////////////////////////////////////////
 
@@ -40,6 +40,7 @@ namespace EscapeCodes {
       std::string up() const { return std::string("\033[1A"); };
       std::string prev_line() const { return std::string("\r") + up(); };  // Note: "\033[1F" is not ANSI
       std::string clear_line() const { return std::string("\033[2K"); };
+      std::string clear_screen() const { return std::string("\033[2J\033[H"); };
       static const std::string reset() { return "\033[39m"; };
   };
   
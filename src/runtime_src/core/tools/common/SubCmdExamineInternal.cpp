@@ -6,6 +6,7 @@
 #include "SubCmdExamineInternal.h"
 #include "JSONConfigurable.h"
 #include "core/common/error.h"
+#include "core/common/query_requests.h"
 
 // Utilities
 #include "tools/common/XBHelpMenusCore.h"
@@ -25,6 +26,7 @@ namespace po = boost::program_options;
 #include <fstream>
 #include <iostream>
 #include <regex>
+#include <set>
 
 static ReportCollection fullReportCollection = {};
 static boost::program_options::options_description common_options;
@@ -64,7 +66,7 @@ SubCmdExamineInternal::SubCmdExamineInternal(bool _isHidden, bool _isDepricated,
   static const std::string reportOptionValues = XBU::create_suboption_list_map("", jsonOptions, common_reports);
   static const std::string formatOptionValues = XBU::create_suboption_list_string(Report::getSchemaDescriptionVector());
   common_options.add_options()
-    ("device,d", boost::program_options::value<decltype(m_device)>(&m_device), "The Bus:Device.Function (e.g., 0000:d8:00.0) device of interest")
+    ("device,d", boost::program_options::value<decltype(m_device)>(&m_device), "The Bus:Device.Function (e.g., 0000:d8:00.0) device of interest, or 'all' to examine all devices")
     ("format,f", boost::program_options::value<decltype(m_format)>(&m_format), (std::string("Report output format. Valid values are:\n") + formatOptionValues).c_str() )
     ("output,o", boost::program_options::value<decltype(m_output)>(&m_output), "Direct the output to the given file")
     ("help", boost::program_options::bool_switch(&m_help), "Help to use this sub-command")
@@ -145,8 +147,17 @@ SubCmdExamineInternal::execute(const SubCmdOptions& _options) const
   // -- Process the options --------------------------------------------
   ReportCollection reportsToProcess;            // Reports of interest
 
+  // With '--device all' the reports are produced for every device
+  const bool all_devices = boost::iequals(m_device, "all");
+  xrt_core::device_collection devices;
+  if (all_devices)
+    XBU::collect_devices(std::set<std::string>{"_all_"}, m_isUserDomain, devices);
+
   // Filter out reports that are not compatible for the device
-  const std::string deviceClass = XBU::get_device_class(m_device, m_isUserDomain);
+  std::string deviceBDF = m_device;
+  if (all_devices)
+    deviceBDF = devices.empty() ? "" : xrt_core::query::pcie_bdf::to_string(xrt_core::device_query<xrt_core::query::pcie_bdf>(devices.front()));
+  const std::string deviceClass = XBU::get_device_class(deviceBDF, m_isUserDomain);
   ReportCollection runnableReports = validateConfigurables<Report>(deviceClass, std::string("report"), fullReportCollection);
 
   // Collect the reports to be processed
@@ -156,8 +167,14 @@ SubCmdExamineInternal::execute(const SubCmdOptions& _options) const
   std::shared_ptr<xrt_core::device> device;
   
   try {
-    if(reportsToProcess.size() > 1 || reportsToRun.front().compare("host") != 0)
+    if (all_devices) {
+      if (!devices.empty())
+        device = devices.front();
+    }
+    else if(reportsToProcess.size() > 1 || reportsToRun.front().compare("host") != 0) {
       device = XBU::get_device(boost::algorithm::to_lower_copy(m_device), m_isUserDomain /*inUserDomain*/);
+      devices.push_back(device);
+    }
   } catch (const std::runtime_error& e) {
     // Catch only the exceptions that we have generated earlier
     std::cerr << boost::format("ERROR: %s\n") % e.what();
@@ -195,7 +212,7 @@ SubCmdExamineInternal::execute(const SubCmdOptions& _options) const
   // Create the report
   std::ostringstream oSchemaOutput;
   try {
-    XBU::produce_reports(device, reportsToProcess, schemaVersion, m_elementsFilter, std::cout, oSchemaOutput);
+    XBU::produce_reports(devices, reportsToProcess, schemaVersion, m_elementsFilter, std::cout, oSchemaOutput);
   } catch (const std::exception&) {
     // Exception is thrown at the end of this function to allow for report writing
     is_report_output_valid = false;
@@ -68,33 +68,18 @@ program_xclbin(const std::shared_ptr<xrt_core::device>& device, const std::strin
     XBUtilities::throw_cancel(boost::format("Could not program device %s : %s") % bdf % e.what());
   }
 }
-} //end anonymous namespace
-
-// ----- C L A S S   M E T H O D S -------------------------------------------
 
-TestRunner::TestRunner (const std::string & test_name,
-                        const std::string & description,
-                        const std::string & xclbin,
-                        bool is_explicit)
-    : m_xclbin(xclbin)
-    , m_name(test_name)
-    , m_description(description) 
-    , m_explicit(is_explicit)
+static boost::property_tree::ptree
+startTestInternal(std::shared_ptr<xrt_core::device> dev, TestRunner* test, std::ostream& progress)
 {
-  //Empty
-}
-
-boost::property_tree::ptree
-TestRunner::startTest(std::shared_ptr<xrt_core::device> dev)
-{
-  XBUtilities::BusyBar busy_bar("Running Test", std::cout);
+  XBUtilities::BusyBar busy_bar("Running Test", progress);
   busy_bar.start(XBUtilities::is_escape_codes_disabled());
   bool is_thread_running = true;
 
   boost::property_tree::ptree result;
 
   // Start the test process
-  std::thread test_thread([&] { runTestInternal(dev, result, this, is_thread_running); });
+  std::thread test_thread([&] { runTestInternal(dev, result, test, is_thread_running); });
   // Wait for the test process to finish
   while (is_thread_running) {
     std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -111,6 +96,36 @@ TestRunner::startTest(std::shared_ptr<xrt_core::device> dev)
   return result;
 }
 
+} //end anonymous namespace
+
+// ----- C L A S S   M E T H O D S -------------------------------------------
+
+TestRunner::TestRunner (const std::string & test_name,
+                        const std::string & description,
+                        const std::string & xclbin,
+                        bool is_explicit)
+    : m_xclbin(xclbin)
+    , m_name(test_name)
+    , m_description(description) 
+    , m_explicit(is_explicit)
+{
+  //Empty
+}
+
+boost::property_tree::ptree
+TestRunner::startTest(std::shared_ptr<xrt_core::device> dev)
+{
+  return startTestInternal(std::move(dev), this, std::cout);
+}
+
+boost::property_tree::ptree
+TestRunner::startTestQuiet(std::shared_ptr<xrt_core::device> dev)
+{
+  // Stream without buffer discards the busy bar output
+  std::ostream null_stream(nullptr);
+  return startTestInternal(std::move(dev), this, null_stream);
+}
+
 /*
  * mini logger to log errors, warnings and details produced by the test cases
  */
@@ -20,8 +20,10 @@ namespace po = boost::program_options;
 
 // System - Include Files
 #include <algorithm>
+#include <future>
 #include <iostream>
 #include <numeric>
+#include <sstream>
 
 // ------ N A M E S P A C E ---------------------------------------------------
 using namespace XBUtilities;
@@ -239,6 +241,103 @@ XBUtilities::collect_and_validate_reports( const ReportCollection &allReportsAva
 }
 
 
+// Produce the reports of one device into ptDevice, returns false if
+// any report failed to generate
+static bool
+produce_device_reports( const std::shared_ptr<xrt_core::device>& device,
+                        const ReportCollection & reportsToProcess,
+                        const Report::SchemaVersion schemaVersion,
+                        const std::vector<std::string> & elementFilter,
+                        std::ostream & consoleStream,
+                        boost::property_tree::ptree & ptDevice)
+{
+  bool is_report_output_valid = true;
+  auto bdf = xrt_core::device_query<xrt_core::query::pcie_bdf>(device);
+  ptDevice.put("interface_type", "pcie");
+  ptDevice.put("device_id", xrt_core::query::pcie_bdf::to_string(bdf));
+
+  switch (xrt_core::device_query_default<xrt_core::query::device_class>(device, xrt_core::query::device_class::type::alveo)) {
+  case xrt_core::query::device_class::type::alveo:
+  {
+    const auto device_status = xrt_core::device_query_default<xrt_core::query::device_status>(device, 2);
+    ptDevice.put("device_status", xrt_core::query::device_status::parse_status(device_status));
+    break;
+  }
+  case xrt_core::query::device_class::type::ryzen:
+    // Ryzen devices do not have a concept of device status. They work or they dont.
+    break;
+  }
+
+  bool is_mfg = false;
+  try {
+    is_mfg = xrt_core::device_query<xrt_core::query::is_mfg>(device);
+  } 
+  catch (const xrt_core::query::exception&) {
+    is_mfg = false;
+  }
+
+  //if factory mode
+  std::string platform;
+  try {
+    if (is_mfg) {
+      platform = "xilinx_" + xrt_core::device_query<xrt_core::query::board_name>(device) + "_GOLDEN";
+    }
+    else {
+      platform = xrt_core::device_query<xrt_core::query::rom_vbnv>(device);
+    }
+  } 
+  catch (const xrt_core::query::exception&) {
+    // proceed even if the platform name is not available
+    platform = "<not defined>";
+  }
+  // Bound the device description on top and bottom with '-' characters
+  const std::string dev_desc = (boost::format("[%s] : %s\n") % ptDevice.get<std::string>("device_id") % platform).str();
+  consoleStream << std::endl;
+  consoleStream << std::string(dev_desc.length(), '-') << std::endl;
+  consoleStream << dev_desc;
+  consoleStream << std::string(dev_desc.length(), '-') << std::endl;
+
+  const auto is_ready = xrt_core::device_query_default<xrt_core::query::is_ready>(device, true);
+  bool is_recovery = false;
+  try {
+    is_recovery = xrt_core::device_query<xrt_core::query::is_recovery>(device);
+  }
+  catch(const xrt_core::query::exception&) { 
+    is_recovery = false;
+  }
+
+  // Process the tests that require a device
+  // If the device is either of the following, most tests cannot be completed fully:
+  // 1. Is in factory mode and is not in recovery mode
+  // 2. Is not ready and is not in recovery mode
+  if ((is_mfg || !is_ready) && !is_recovery)
+    consoleStream << "Warning: Device is not ready - Limited functionality available with XRT tools.\n";
+
+  for (auto &report : reportsToProcess) {
+    if (!report->isDeviceRequired())
+      continue;
+
+    boost::property_tree::ptree ptReport;
+    try {
+      report->getFormattedReport(device.get(), schemaVersion, elementFilter, consoleStream, ptReport);
+    } catch (const std::exception&) {
+      is_report_output_valid = false;
+    }
+
+    // Only support 1 node on the root
+    if (ptReport.size() > 1)
+      throw xrt_core::error((boost::format("Invalid JSON - The report '%s' has too many root nodes.") % Report::getSchemaDescription(schemaVersion).optionName).str());
+
+    // We have 1 node, copy the child to the root property tree
+    if (ptReport.size() == 1) {
+      for (const auto & ptChild : ptReport)
+        ptDevice.add_child(ptChild.first, ptChild.second);
+    }
+  }
+
+  return is_report_output_valid;
+}
+
 void 
 XBUtilities::produce_reports( const std::shared_ptr<xrt_core::device>& device, 
                               const ReportCollection & reportsToProcess, 
@@ -246,6 +345,21 @@ XBUtilities::produce_reports( const std::shared_ptr<xrt_core::device>& device,
                               const std::vector<std::string> & elementFilter,
                               std::ostream & consoleStream,
                               std::ostream & schemaStream)
+{
+  xrt_core::device_collection devices;
+  if (device)
+    devices.push_back(device);
+
+  produce_reports(devices, reportsToProcess, schemaVersion, elementFilter, consoleStream, schemaStream);
+}
+
+void 
+XBUtilities::produce_reports( const xrt_core::device_collection& devices, 
+                              const ReportCollection & reportsToProcess, 
+                              const Report::SchemaVersion schemaVersion, 
+                              const std::vector<std::string> & elementFilter,
+                              std::ostream & consoleStream,
+                              std::ostream & schemaStream)
 {
   // Some simple DRCs
   if (reportsToProcess.empty()) {
@@ -307,97 +421,49 @@ XBUtilities::produce_reports( const std::shared_ptr<xrt_core::device>& device,
     return false;
   };
 
-  if(dev_report()) {
-    // -- Process reports that work on a device
-    boost::property_tree::ptree ptDevice;
-    auto bdf = xrt_core::device_query<xrt_core::query::pcie_bdf>(device);
-    ptDevice.put("interface_type", "pcie");
-    ptDevice.put("device_id", xrt_core::query::pcie_bdf::to_string(bdf));
-
-    switch (xrt_core::device_query_default<xrt_core::query::device_class>(device, xrt_core::query::device_class::type::alveo)) {
-    case xrt_core::query::device_class::type::alveo:
-    {
-      const auto device_status = xrt_core::device_query_default<xrt_core::query::device_status>(device, 2);
-      ptDevice.put("device_status", xrt_core::query::device_status::parse_status(device_status));
-      break;
-    }
-    case xrt_core::query::device_class::type::ryzen:
-      // Ryzen devices do not have a concept of device status. They work or they dont.
-      break;
-    }
+  if (dev_report() && !devices.empty()) {
+    boost::property_tree::ptree ptDevices;
 
-    bool is_mfg = false;
-    try {
-      is_mfg = xrt_core::device_query<xrt_core::query::is_mfg>(device);
-    } 
-    catch (const xrt_core::query::exception&) {
-      is_mfg = false;
-    }
-
-    //if factory mode
-    std::string platform;
-    try {
-      if (is_mfg) {
-        platform = "xilinx_" + xrt_core::device_query<xrt_core::query::board_name>(device) + "_GOLDEN";
-      }
-      else {
-        platform = xrt_core::device_query<xrt_core::query::rom_vbnv>(device);
-      }
-    } 
-    catch (const xrt_core::query::exception&) {
-      // proceed even if the platform name is not available
-      platform = "<not defined>";
-    }
-    // Bound the device description on top and bottom with '-' characters
-    const std::string dev_desc = (boost::format("[%s] : %s\n") % ptDevice.get<std::string>("device_id") % platform).str();
-    consoleStream << std::endl;
-    consoleStream << std::string(dev_desc.length(), '-') << std::endl;
-    consoleStream << dev_desc;
-    consoleStream << std::string(dev_desc.length(), '-') << std::endl;
-
-    const auto is_ready = xrt_core::device_query_default<xrt_core::query::is_ready>(device, true);
-    bool is_recovery = false;
-    try {
-      is_recovery = xrt_core::device_query<xrt_core::query::is_recovery>(device);
-    }
-    catch(const xrt_core::query::exception&) { 
-      is_recovery = false;
-    }
-
-    // Process the tests that require a device
-    // If the device is either of the following, most tests cannot be completed fully:
-    // 1. Is in factory mode and is not in recovery mode
-    // 2. Is not ready and is not in recovery mode
-    if ((is_mfg || !is_ready) && !is_recovery)
-      std::cout << "Warning: Device is not ready - Limited functionality available with XRT tools.\n";
-
-    for (auto &report : reportsToProcess) {
-      if (!report->isDeviceRequired())
-        continue;
-
-      boost::property_tree::ptree ptReport;
-      try {
-        report->getFormattedReport(device.get(), schemaVersion, elementFilter, consoleStream, ptReport);
-      } catch (const std::exception&) {
+    if (devices.size() == 1) {
+      boost::property_tree::ptree ptDevice;
+      if (!produce_device_reports(devices.front(), reportsToProcess, schemaVersion, elementFilter, consoleStream, ptDevice))
         is_report_output_valid = false;
+      if (!ptDevice.empty())
+        ptDevices.push_back(std::make_pair("", ptDevice));
+    }
+    else {
+      // Reports of different devices are produced concurrently.  The
+      // console output of each device is buffered and written in
+      // device order, so output is the same as if the devices were
+      // processed one by one.
+      struct device_result
+      {
+        std::ostringstream console;
+        boost::property_tree::ptree pt;
+        std::future<bool> valid;
+      };
+      std::vector<device_result> results(devices.size());
+      for (size_t idx = 0; idx < devices.size(); ++idx) {
+        results[idx].valid = std::async(std::launch::async, [&, idx] {
+          auto& result = results[idx];
+          return produce_device_reports(devices[idx], reportsToProcess, schemaVersion, elementFilter, result.console, result.pt);
+        });
       }
 
-      // Only support 1 node on the root
-      if (ptReport.size() > 1)
-        throw xrt_core::error((boost::format("Invalid JSON - The report '%s' has too many root nodes.") % Report::getSchemaDescription(schemaVersion).optionName).str());
+      for (auto& result : results)
+        result.valid.wait();
 
-      // We have 1 node, copy the child to the root property tree
-      if (ptReport.size() == 1) {
-        for (const auto & ptChild : ptReport)
-          ptDevice.add_child(ptChild.first, ptChild.second);
+      for (auto& result : results) {
+        consoleStream << result.console.str();
+        if (!result.valid.get())
+          is_report_output_valid = false;
+        if (!result.pt.empty())
+          ptDevices.push_back(std::make_pair("", result.pt));
       }
     }
 
-    if (!ptDevice.empty()) {
-      boost::property_tree::ptree ptDevices;
-      ptDevices.push_back(std::make_pair("", ptDevice));
+    if (!ptDevices.empty())
       ptRoot.add_child("devices", ptDevices);
-    }
   }
 
   // -- Write the formatted output 
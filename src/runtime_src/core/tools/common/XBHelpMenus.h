@@ -44,6 +44,16 @@ namespace XBUtilities {
                       const std::vector<std::string> & elementFilter,
                       std::ostream & consoleStream,
                       std::ostream & schemaStream);
+
+  // Reports of multiple devices are produced concurrently, output is
+  // written in collection order
+  void
+     produce_reports( const xrt_core::device_collection& devices,
+                      const ReportCollection & reportsToProcess,
+                      const Report::SchemaVersion schema,
+                      const std::vector<std::string> & elementFilter,
+                      std::ostream & consoleStream,
+                      std::ostream & schemaStream);
 };
 
 #endif
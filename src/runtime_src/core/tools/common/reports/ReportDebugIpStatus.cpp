@@ -94,6 +94,9 @@ class DebugIpStatusCollector
   xdp::SPCCounterResults  spcResults;
   xdp::ADDCounterResults  accelDeadlockResults;
 
+  // Counters of all monitors read at once, keyed by base address
+  xrt_core::query::debug_ip_counters::result_type batchCounters;
+
 public :
   DebugIpStatusCollector(xclDeviceHandle h, const xrt_core::device* d);
   ~DebugIpStatusCollector() {}
@@ -118,6 +121,10 @@ private :
   void readSPChecker(debug_ip_data*);
   void readAccelDeadlockDetector(debug_ip_data*);
 
+  template <typename QueryRequestType>
+  typename QueryRequestType::result_type
+  readCounters(debug_ip_data*);
+
   void populateAIMResults(boost::property_tree::ptree &_pt);
   void populateAMResults(boost::property_tree::ptree &_pt);
   void populateASMResults(boost::property_tree::ptree &_pt);
@@ -182,6 +189,10 @@ DebugIpStatusCollector::getDebugIpData()
   // reset debugIpNum to zero
   std::memset((char*)debugIpNum, 0, sizeof(debugIpNum));
 
+  // Read all monitors in one go where the platform supports it, each
+  // monitor is otherwise queried on its own
+  batchCounters = xrt_core::device_query_default<xrt_core::query::debug_ip_counters>(device, {});
+
   for(uint64_t i = 0; i < dbgIpLayout->m_count; i++) {
     switch(dbgIpLayout->m_debug_ip_data[i].m_type)
     {
@@ -301,6 +312,18 @@ DebugIpStatusCollector::getStreamName(uint8_t dbgIpType,
 }
 
 
+template <typename QueryRequestType>
+typename QueryRequestType::result_type
+DebugIpStatusCollector::readCounters(debug_ip_data* dbgIpInfo)
+{
+  auto itr = batchCounters.find(dbgIpInfo->m_base_address);
+  if (itr == batchCounters.end())
+    return xrt_core::device_query<QueryRequestType>(device, dbgIpInfo);
+
+  return {itr->second.begin(), itr->second.end()};
+}
+
+
 void 
 DebugIpStatusCollector::readAIMCounter(debug_ip_data* dbgIpInfo)
 {
@@ -327,7 +350,7 @@ DebugIpStatusCollector::readAIMCounter(debug_ip_data* dbgIpInfo)
   ++debugIpNum[AXI_MM_MONITOR];
   aimResults.NumSlots = (unsigned int)debugIpNum[AXI_MM_MONITOR];
 
-  std::vector<uint64_t> valBuf = xrt_core::device_query<xrt_core::query::aim_counter>(device, dbgIpInfo);
+  std::vector<uint64_t> valBuf = readCounters<xrt_core::query::aim_counter>(dbgIpInfo);
   aimResults.WriteBytes[index]    = valBuf[xdp::IP::AIM::report::WRITE_BYTES];
   aimResults.WriteTranx[index]    = valBuf[xdp::IP::AIM::report::WRITE_TRANX];
   aimResults.ReadBytes[index]     = valBuf[xdp::IP::AIM::report::READ_BYTES];
@@ -368,7 +391,7 @@ DebugIpStatusCollector::readAMCounter(debug_ip_data* dbgIpInfo)
 
   // The result comes back "as if" we read from sysfs, even though the
   // actual implementation may be different.
-  std::vector<uint64_t> valBuf = xrt_core::device_query<xrt_core::query::am_counter>(device, dbgIpInfo);
+  std::vector<uint64_t> valBuf = readCounters<xrt_core::query::am_counter>(dbgIpInfo);
   amResults.CuExecCount[index] = valBuf[xdp::IP::AM::sysfs::EXECUTION_COUNT];
   amResults.CuStartCount[index] = valBuf[xdp::IP::AM::sysfs::TOTAL_CU_START];
   amResults.CuExecCycles[index] = valBuf[xdp::IP::AM::sysfs::EXECUTION_CYCLES];
@@ -413,7 +436,7 @@ DebugIpStatusCollector::readASMCounter(debug_ip_data* dbgIpInfo)
 
   // This vector comes back as if we got it from sysfs, but the implementation
   // might be different
-  std::vector<uint64_t> valBuf = xrt_core::device_query<xrt_core::query::asm_counter>(device, dbgIpInfo);
+  std::vector<uint64_t> valBuf = readCounters<xrt_core::query::asm_counter>(dbgIpInfo);
   asmResults.StrNumTranx[index]     = valBuf[xdp::IP::ASM::sysfs::NUM_TRANX];
   asmResults.StrDataBytes[index]    = valBuf[xdp::IP::ASM::sysfs::DATA_BYTES];
   asmResults.StrBusyCycles[index]   = valBuf[xdp::IP::ASM::sysfs::BUSY_CYCLES];
@@ -449,7 +472,7 @@ DebugIpStatusCollector::readLAPChecker(debug_ip_data* dbgIpInfo)
   ++debugIpNum[LAPC];
   lapcResults.NumSlots = (unsigned int)debugIpNum[LAPC];
 
-  std::vector<uint32_t> valBuf = xrt_core::device_query<xrt_core::query::lapc_status>(device, dbgIpInfo);
+  std::vector<uint32_t> valBuf = readCounters<xrt_core::query::lapc_status>(dbgIpInfo);
   lapcResults.OverallStatus[index] = valBuf[xdp::IP::LAPC::sysfs::STATUS];
 
   lapcResults.CumulativeStatus[index][0] = valBuf[xdp::IP::LAPC::sysfs::CUMULATIVE_STATUS_0];
@@ -491,7 +514,7 @@ DebugIpStatusCollector::readSPChecker(debug_ip_data* dbgIpInfo)
   ++debugIpNum[AXI_STREAM_PROTOCOL_CHECKER];
   spcResults.NumSlots = (unsigned int)debugIpNum[AXI_STREAM_PROTOCOL_CHECKER];
 
-  std::vector<uint32_t> valBuf = xrt_core::device_query<xrt_core::query::spc_status>(device, dbgIpInfo);
+  std::vector<uint32_t> valBuf = readCounters<xrt_core::query::spc_status>(dbgIpInfo);
 
   spcResults.PCAsserted[index] = valBuf[xdp::IP::SPC::sysfs::PC_ASSERTED];
   spcResults.CurrentPC[index]  = valBuf[xdp::IP::SPC::sysfs::CURRENT_PC];
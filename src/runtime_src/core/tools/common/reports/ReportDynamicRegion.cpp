@@ -75,6 +75,15 @@ ReportDynamicRegion::writeReport( const xrt_core::device* _pDevice,
       {"Status", Table2D::Justification::left}
     };
     Table2D ps_table(ps_table_headers);
+    const std::vector<Table2D::HeaderData> lat_table_headers = {
+      {"Index", Table2D::Justification::left},
+      {"Name", Table2D::Justification::left},
+      {"Queue p50", Table2D::Justification::left},
+      {"Queue p99", Table2D::Justification::left},
+      {"Execute p50", Table2D::Justification::left},
+      {"Execute p99", Table2D::Justification::left}
+    };
+    Table2D lat_table(lat_table_headers);
 
     const boost::property_tree::ptree& pt_cu = dfx.get_child("compute_units", empty_ptree);
     // Sort compute units into PL and PS groups
@@ -88,6 +97,14 @@ ReportDynamicRegion::writeReport( const xrt_core::device* _pDevice,
         if(boost::iequals(cu.get<std::string>("type"), "PL")) {
           const std::vector<std::string> entry_data = {std::to_string(index++), cu.get<std::string>("name"), cu.get<std::string>("base_address") , cu.get<std::string>("usage"), xrt_core::utils::parse_cu_status(status_val)};
           pl_table.addEntry(entry_data);
+
+          const auto& lat = cu.get_child("latency", empty_ptree);
+          if (!lat.empty()) {
+            const std::vector<std::string> lat_data = {entry_data[0], entry_data[1],
+              lat.get<std::string>("queue.p50_us"), lat.get<std::string>("queue.p99_us"),
+              lat.get<std::string>("execute.p50_us"), lat.get<std::string>("execute.p99_us")};
+            lat_table.addEntry(lat_data);
+          }
         }
         else if(boost::iequals(cu.get<std::string>("type"), "PS")) {
           const std::vector<std::string> entry_data = {std::to_string(index++), cu.get<std::string>("name"), cu.get<std::string>("usage"), xrt_core::utils::parse_cu_status(status_val)};
@@ -104,6 +121,11 @@ ReportDynamicRegion::writeReport( const xrt_core::device* _pDevice,
       _output << pl_table.toString("      ") << "\n";
     }
 
+    if (!lat_table.empty()) {
+      _output << "    PL Compute Unit Latency (us)\n";
+      _output << lat_table.toString("      ") << "\n";
+    }
+
     if (!ps_table.empty()) {
       _output << "    PS Compute Units\n";
       _output << ps_table.toString("      ") << "\n";
@@ -10,19 +10,39 @@
 #include "xrt/xrt_hw_context.h"
 #include "xrt/xrt_kernel.h"
 #include <experimental/xrt_kernel.h>
+#include "xrt_iops_util/xilutil.hpp"
 namespace XBU = XBUtilities;
 
+#include <algorithm>
 #include <filesystem>
 
 static constexpr size_t buffer_size = 20;
-static constexpr int itr_count = 10;
-static constexpr int run_count = 1000;
 
 // ----- C L A S S   M E T H O D S -------------------------------------------
 TestCmdChainLatency::TestCmdChainLatency()
   : TestRunner("cmd-chain-latency", "Run end-to-end latency test using command chaining")
 {}
 
+/*
+ * Pass in custom parameters for cmd-chain-latency test
+ */
+void
+TestCmdChainLatency::set_param(const std::string key, const std::string value)
+{
+  try {
+    if (key == "chain-length")
+      m_chain_lengths = parse_sweep(value);
+    else if (key == "iterations")
+      m_iterations = parse_sweep(value).front();
+  }
+  catch (const std::exception&) {
+    std::cerr << boost::format(
+      "ERROR: The parameter '%s' value '%s' is invalid for the test '%s'. Please specify a comma separated list of positive integers.\n")
+      % key % value % "cmd-chain-latency";
+    throw xrt_core::error(std::errc::operation_canceled);
+  }
+}
+
 boost::property_tree::ptree
 TestCmdChainLatency::run(std::shared_ptr<xrt_core::device> dev)
 {
@@ -98,6 +118,7 @@ TestCmdChainLatency::run(std::shared_ptr<xrt_core::device> dev)
   std::vector<xrt::bo> global_args;
   std::vector<xrt::run> runs;
 
+  const int run_count = *std::max_element(m_chain_lengths.begin(), m_chain_lengths.end());
   for (int i=0; i < run_count; ++i) {
     auto run = xrt::run(testker);
     for (const auto& arg : cu.get_args()) {
@@ -123,40 +144,56 @@ TestCmdChainLatency::run(std::shared_ptr<xrt_core::device> dev)
   }
 
   //Log
-  if(XBU::getVerbose()) {
+  if(XBU::getVerbose())
     logger(ptree, "Details", boost::str(boost::format("Instruction size: '%f' bytes") % buffer_size));
-    logger(ptree, "Details", boost::str(boost::format("No. of commands: '%f'") % (itr_count*run_count)));
-  }
 
-  // Start via runlist
+  // Start via runlist, one sweep point per chain length.  The latency
+  // distribution is recorded per chain execution, the average latency
+  // is per command.
   xrt::runlist runlist{hwctx};
-  for (auto& run : runs)
-    runlist.add(run);
-
-  auto start = std::chrono::high_resolution_clock::now();
-  for (int i = 0; i < itr_count; ++i) {
-    try {
-      runlist.execute();
-    }
-    catch (const std::exception& ex) {
-      logger(ptree, "Error", ex.what());
-      ptree.put("status", test_token_failed);
-    }
-
-    try {
-      runlist.wait();
-    }
-    catch (const std::exception& ex) {
-      logger(ptree, "Error", ex.what());
-      ptree.put("status", test_token_failed);
+  boost::property_tree::ptree pt_sweep;
+  for (auto chain_length : m_chain_lengths) {
+    runlist.reset();
+    for (int i = 0; i < chain_length; ++i)
+      runlist.add(runs[i]);
+
+    if(XBU::getVerbose())
+      logger(ptree, "Details", boost::str(boost::format("No. of commands: '%d'") % (m_iterations*chain_length)));
+
+    latency_histogram latency;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < m_iterations; ++i) {
+      auto chain_start = std::chrono::high_resolution_clock::now();
+      try {
+        runlist.execute();
+        runlist.wait();
+      }
+      catch (const std::exception& ex) {
+        logger(ptree, "Error", ex.what());
+        ptree.put("status", test_token_failed);
+        return ptree;
+      }
+      auto chain_end = std::chrono::high_resolution_clock::now();
+      latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(chain_end - chain_start).count());
     }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsedSecs = std::chrono::duration_cast<std::chrono::duration<float>>(end-start).count();
+
+    // Calculate end-to-end latency of one job execution
+    const float latency_us = (elapsedSecs / (m_iterations*chain_length)) * 1000000; //convert s to us
+    logger(ptree, "Details", boost::str(boost::format("Chain length: %d, Average latency: '%.1f' us") % chain_length % latency_us));
+    logger(ptree, "Details", "Chain latency: " + latency.to_string_us());
+
+    boost::property_tree::ptree pt_point;
+    pt_point.put("chain_length", chain_length);
+    pt_point.put("iterations", m_iterations);
+    pt_point.put("average_latency_us", latency_us);
+    pt_point.add_child("chain_latency_us", latency.to_ptree_us());
+    pt_sweep.push_back(std::make_pair("", pt_point));
   }
-  auto end = std::chrono::high_resolution_clock::now();
-  auto elapsedSecs = std::chrono::duration_cast<std::chrono::duration<float>>(end-start).count();
+  runlist.reset();
 
-  // Calculate end-to-end latency of one job execution
-  const float latency = (elapsedSecs / (itr_count*run_count)) * 1000000; //convert s to us
-  logger(ptree, "Details", boost::str(boost::format("Average latency: '%.1f' us") % latency));
+  ptree.add_child("benchmark", pt_sweep);
   ptree.put("status", test_token_passed);
   return ptree;
 }
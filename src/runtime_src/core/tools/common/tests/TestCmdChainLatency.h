@@ -7,12 +7,20 @@
 #include "tools/common/TestRunner.h"
 #include "xrt/xrt_device.h"
 
+#include <vector>
+
 class TestCmdChainLatency : public TestRunner {
   public:
     boost::property_tree::ptree run(std::shared_ptr<xrt_core::device> dev);
+    void set_param(const std::string key, const std::string value);
 
   public:
     TestCmdChainLatency();
+
+  private:
+    // Sweep of commands per chain, each point is executed m_iterations times
+    std::vector<int> m_chain_lengths = {1000};
+    int m_iterations = 10;
 };
 
 #endif
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// ------ I N C L U D E   F I L E S -------------------------------------------
+// Local - Include Files
+#include "TestDMASweep.h"
+#include "core/common/utils.h"
+#include "tools/common/XBUtilities.h"
+#include "xrt_iops_util/xilutil.hpp"
+namespace XBU = XBUtilities;
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using Clock = std::chrono::high_resolution_clock;
+
+namespace {
+
+// Buffers per thread, async mode keeps all of them in flight
+static constexpr size_t buffers_per_thread = 2;
+
+struct bo_type_info {
+  const char* name;
+  xrt::bo::flags flags;
+};
+
+static const std::vector<bo_type_info> bo_types = {
+  {"normal",    xrt::bo::flags::normal},
+  {"cacheable", xrt::bo::flags::cacheable},
+  {"host_only", xrt::bo::flags::host_only},
+  {"p2p",       xrt::bo::flags::p2p},
+};
+
+static const std::vector<std::string> directions = {"h2d", "d2h", "bidir"};
+static const std::vector<std::string> modes = {"sync", "async"};
+
+struct worker {
+  std::vector<xrt::bo> bos;
+  xclBOSyncDirection dir;
+  size_t count;                 // transfers to issue
+  latency_histogram latency;    // per transfer (ns)
+  std::exception_ptr error;
+};
+
+static void
+run_worker(worker& w, bool async, barrier& barrier)
+{
+  barrier.wait();
+  try {
+    size_t issued = 0;
+    if (!async) {
+      while (issued < w.count) {
+        auto& bo = w.bos[issued++ % w.bos.size()];
+        auto start = Clock::now();
+        bo.sync(w.dir);
+        w.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+      }
+    }
+    else {
+      std::vector<xrt::bo::async_handle> handles;
+      std::vector<Clock::time_point> starts;
+      while (issued < w.count) {
+        handles.clear();
+        starts.clear();
+        for (auto& bo : w.bos) {
+          if (issued++ == w.count)
+            break;
+          starts.push_back(Clock::now());
+          handles.push_back(bo.async(w.dir));
+        }
+        for (size_t i = 0; i < handles.size(); ++i) {
+          handles[i].wait();
+          w.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - starts[i]).count());
+        }
+      }
+    }
+  }
+  catch (...) {
+    w.error = std::current_exception();
+  }
+  barrier.wait();
+}
+
+static std::vector<std::string>
+split_list(const std::string& value, const std::vector<std::string>& valid)
+{
+  std::vector<std::string> values;
+  boost::split(values, value, boost::is_any_of(","));
+  for (const auto& v : values)
+    if (std::find(valid.begin(), valid.end(), v) == valid.end())
+      throw std::invalid_argument(v);
+  return values;
+}
+
+} // namespace
+
+// ----- C L A S S   M E T H O D S -------------------------------------------
+TestDMASweep::TestDMASweep()
+  : TestRunner("dma-sweep",
+                "Run host to device bandwidth sweep over size, threads, buffer type and direction",
+                "bandwidth.xclbin", true){}
+
+/*
+ * Pass in custom parameters for dma-sweep test
+ */
+void
+TestDMASweep::set_param(const std::string key, const std::string value)
+{
+  try {
+    if (key == "sizes") {
+      m_sizes.clear();
+      for (auto size : parse_sweep(value))
+        m_sizes.push_back(static_cast<size_t>(size));
+    }
+    else if (key == "threads")
+      m_threads = parse_sweep(value);
+    else if (key == "bo-types") {
+      std::vector<std::string> valid;
+      for (const auto& type : bo_types)
+        valid.push_back(type.name);
+      m_bo_types = split_list(value, valid);
+    }
+    else if (key == "directions")
+      m_directions = split_list(value, directions);
+    else if (key == "modes")
+      m_modes = split_list(value, modes);
+  }
+  catch (const std::exception&) {
+    std::cerr << boost::format(
+      "ERROR: The parameter '%s' value '%s' is invalid for the test '%s'.\n")
+      % key % value % "dma-sweep";
+    throw xrt_core::error(std::errc::operation_canceled);
+  }
+}
+
+boost::property_tree::ptree
+TestDMASweep::run(std::shared_ptr<xrt_core::device> dev)
+{
+  boost::property_tree::ptree ptree = get_test_header();
+
+  ptree.put("status", test_token_skipped);
+  if (!search_and_program_xclbin(dev, ptree))
+    return ptree;
+
+  // Sweep the first used device memory bank
+  auto membuf = xrt_core::device_query<xrt_core::query::mem_topology_raw>(dev);
+  auto mem_topo = reinterpret_cast<const mem_topology*>(membuf.data());
+  int midx = -1;
+  for (int i = 0; i < mem_topo->m_count; ++i) {
+    const auto& mem = mem_topo->m_mem_data[i];
+    if (!mem.m_used || mem.m_type == MEM_STREAMING)
+      continue;
+    if (std::string(reinterpret_cast<const char*>(mem.m_tag)).compare(0, 4, "HOST") == 0)
+      continue;
+    midx = i;
+    break;
+  }
+  if (midx < 0) {
+    logger(ptree, "Details", "No device memory bank to transfer to");
+    return ptree;
+  }
+
+  const auto& mem = mem_topo->m_mem_data[midx];
+  logger(ptree, "Details", (boost::format("Memory Tag - '%s'") % mem.m_tag).str());
+
+  xrt::device device(dev);
+  boost::property_tree::ptree pt_sweep;
+  bool failed = false;
+
+  for (const auto& bo_type_name : m_bo_types) {
+    auto type = std::find_if(bo_types.begin(), bo_types.end(),
+                             [&bo_type_name](const bo_type_info& t) { return bo_type_name == t.name; });
+    for (auto size : m_sizes) {
+      for (auto threads : m_threads) {
+        for (const auto& direction : m_directions) {
+          const bool bidir = (direction == "bidir");
+          const size_t workers_count = bidir ? 2 * threads : threads;
+
+          // m_size is in KB
+          if (mem.m_size * 1024 < workers_count * buffers_per_thread * size) {
+            logger(ptree, "Details", boost::str(boost::format(
+              "Skipping size '%s' with %d threads, the bank does not have enough memory")
+              % xrt_core::utils::unit_convert(size) % threads));
+            continue;
+          }
+
+          std::vector<worker> workers(workers_count);
+          try {
+            for (size_t i = 0; i < workers_count; ++i) {
+              auto& w = workers[i];
+              w.dir = (direction == "d2h" || (bidir && i % 2))
+                ? XCL_BO_SYNC_BO_FROM_DEVICE
+                : XCL_BO_SYNC_BO_TO_DEVICE;
+              w.count = std::max<size_t>(m_total / size / threads, 1);
+              for (size_t b = 0; b < buffers_per_thread; ++b)
+                w.bos.emplace_back(device, size, type->flags, static_cast<xrt::memory_group>(midx));
+            }
+          }
+          catch (const std::exception& ex) {
+            logger(ptree, "Details", boost::str(boost::format("Skipping buffer type '%s': %s")
+                                                % bo_type_name % ex.what()));
+            continue;
+          }
+
+          for (const auto& mode : m_modes) {
+            barrier barrier;
+            barrier.init(static_cast<unsigned int>(workers_count + 1));
+            std::vector<std::thread> thrs;
+            for (auto& w : workers) {
+              w.latency = latency_histogram();
+              thrs.emplace_back(run_worker, std::ref(w), mode == "async", std::ref(barrier));
+            }
+
+            barrier.wait();
+            auto start = Clock::now();
+            barrier.wait();
+            auto end = Clock::now();
+            for (auto& t : thrs)
+              t.join();
+
+            latency_histogram latency;
+            size_t bytes = 0;
+            std::string error;
+            for (auto& w : workers) {
+              if (w.error) {
+                try {
+                  std::rethrow_exception(w.error);
+                }
+                catch (const std::exception& ex) {
+                  error = ex.what();
+                }
+                w.error = nullptr;
+              }
+              latency.add(w.latency);
+              bytes += w.count * size;
+            }
+
+            if (!error.empty()) {
+              logger(ptree, "Error", boost::str(boost::format("%s %s %s %d threads %s: %s")
+                                                % bo_type_name % xrt_core::utils::unit_convert(size)
+                                                % direction % threads % mode % error));
+              failed = true;
+              continue;
+            }
+
+            const double usec = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+            const double mbps = usec > 0 ? bytes / usec : 0; // bytes per us == MB/s
+            logger(ptree, "Details", boost::str(boost::format("%s, %s, %d threads, %s, %s: %.1f MB/s, latency %s")
+                                                % bo_type_name % xrt_core::utils::unit_convert(size) % threads
+                                                % direction % mode % mbps % latency.to_string_us()));
+
+            boost::property_tree::ptree pt_point;
+            pt_point.put("bo_type", bo_type_name);
+            pt_point.put("size", size);
+            pt_point.put("threads", threads);
+            pt_point.put("direction", direction);
+            pt_point.put("mode", mode);
+            pt_point.put("bandwidth_mbps", mbps);
+            pt_point.add_child("latency_us", latency.to_ptree_us());
+            pt_sweep.push_back(std::make_pair("", pt_point));
+          }
+        }
+      }
+    }
+  }
+
+  ptree.add_child("benchmark", pt_sweep);
+  ptree.put("status", failed ? test_token_failed : test_token_passed);
+  return ptree;
+}
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#ifndef __TestDMASweep_h_
+#define __TestDMASweep_h_
+
+#include "tools/common/TestRunner.h"
+
+#include <string>
+#include <vector>
+
+class TestDMASweep : public TestRunner {
+  public:
+    boost::property_tree::ptree run(std::shared_ptr<xrt_core::device> dev);
+    void set_param(const std::string key, const std::string value);
+
+  public:
+    TestDMASweep();
+
+  private:
+    // Every combination of the sweep dimensions is measured
+    std::vector<size_t> m_sizes = {4 * 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024};
+    std::vector<int> m_threads = {1, 2, 4};
+    std::vector<std::string> m_bo_types = {"normal", "host_only"};
+    std::vector<std::string> m_directions = {"h2d", "d2h", "bidir"};
+    std::vector<std::string> m_modes = {"sync", "async"};
+    size_t m_total = 256 * 1024 * 1024; // bytes per direction per sweep point
+};
+
+#endif
@@ -28,17 +28,9 @@ typedef struct task_args {
   unsigned int total;
   Clock::time_point start;
   Clock::time_point end;
+  latency_histogram latency;   // per command start to wait return (ns)
 } arg_t;
 
-struct krnl_info {
-  std::string     name;
-  bool            new_style;
-};
-
-static bool verbose = false;
-static barrier barrier;
-static struct krnl_info krnl = {"hello", false};
-
 // ----- C L A S S   M E T H O D S -------------------------------------------
 TestIOPS::TestIOPS()
   : TestRunner("iops", 
@@ -53,14 +45,38 @@ TestIOPS::run(std::shared_ptr<xrt_core::device> dev)
   return ptree;
 }
 
+/*
+ * Pass in custom parameters for iops test
+ */
+void
+TestIOPS::set_param(const std::string key, const std::string value)
+{
+  try {
+    if (key == "threads")
+      m_threads = parse_sweep(value);
+    else if (key == "queue-depth")
+      m_queue_depths = parse_sweep(value);
+    else if (key == "commands")
+      m_total = static_cast<unsigned int>(parse_sweep(value).front());
+  }
+  catch (const std::exception&) {
+    std::cerr << boost::format(
+      "ERROR: The parameter '%s' value '%s' is invalid for the test '%s'. Please specify a comma separated list of positive integers.\n")
+      % key % value % "iops";
+    throw xrt_core::error(std::errc::operation_canceled);
+  }
+}
+
 static double 
 runThread(std::vector<xrt::run>& cmds, unsigned int total, arg_t &arg)
 {
   int i = 0;
   unsigned int issued = 0, completed = 0;
+  std::vector<Clock::time_point> issue_time(cmds.size());
   arg.start = Clock::now();
 
   for (auto& cmd : cmds) {
+    issue_time[issued] = Clock::now();
     cmd.start();
     if (++issued == total)
       break;
@@ -68,9 +84,12 @@ runThread(std::vector<xrt::run>& cmds, unsigned int total, arg_t &arg)
 
   while (completed < total) {
     cmds[i].wait();
+    auto now = Clock::now();
+    arg.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(now - issue_time[i]).count());
 
     completed++;
     if (issued < total) {
+      issue_time[i] = Clock::now();
       cmds[i].start();
       issued++;
     }
@@ -84,7 +103,7 @@ runThread(std::vector<xrt::run>& cmds, unsigned int total, arg_t &arg)
   return static_cast<double>((std::chrono::duration_cast<ms_t>(arg.end - arg.start)).count());
 }
 
-static void runTestThread(const xrt::device& device, const xrt::kernel& hello, arg_t& arg)
+static void runTestThread(const xrt::device& device, const xrt::kernel& hello, barrier& barrier, arg_t& arg)
 {
   std::vector<xrt::run> cmds;
 
@@ -101,28 +120,12 @@ static void runTestThread(const xrt::device& device, const xrt::kernel& hello, a
 }
 
 void 
-TestIOPS::testMultiThreads(const std::string &dev, const std::string &xclbin_fn, 
+TestIOPS::testMultiThreads(const xrt::device& device, const xrt::kernel& hello, const std::string& krnl_name,
                           int threadNumber, int queueLength, unsigned int total, boost::property_tree::ptree& ptree)
 {
   std::vector<std::thread> threads(threadNumber);
   std::vector<arg_t> arg(threadNumber);
-
-  xrt::device device(dev);
-  auto uuid = device.load_xclbin(xclbin_fn);
-  xrt::kernel hello;
-  try {
-    hello = xrt::kernel(device, uuid.get(), krnl.name);
-  } catch (const std::exception&) {
-    krnl.name = "hello";
-    krnl.new_style = false;
-    try {
-      hello = xrt::kernel(device, uuid.get(), krnl.name);
-    } catch (const std::exception&) {
-      logger(ptree, "Error", "Kernel could not be found.");
-      ptree.put("status", test_token_failed);
-      return;
-    }
-  }
+  barrier barrier;
 
   barrier.init(threadNumber + 1);
 
@@ -130,7 +133,7 @@ TestIOPS::testMultiThreads(const std::string &dev, const std::string &xclbin_fn,
     arg[i].thread_id = i;
     arg[i].queueLength = queueLength;
     arg[i].total = total;
-    threads[i] = std::thread([&](int i){ runTestThread(device, hello, arg[i]); }, i);
+    threads[i] = std::thread([&](int i){ runTestThread(device, hello, barrier, arg[i]); }, i);
   }
 
   /* Wait threads to prepare to start */
@@ -145,21 +148,36 @@ TestIOPS::testMultiThreads(const std::string &dev, const std::string &xclbin_fn,
     threads[i].join();
 
   /* calculate performance */
-  int overallCommands = 0;
+  unsigned int overallCommands = 0;
+  latency_histogram latency;
   double duration;
   for (int i = 0; i < threadNumber; i++) {
-    if (verbose) {
+    if (XBU::getVerbose()) {
       duration = static_cast<double>((std::chrono::duration_cast<ms_t>(arg[i].end - arg[i].start)).count());
       logger(ptree, boost::str(boost::format("Details for Thread %d") % arg[i].thread_id), 
                     boost::str(boost::format("Commands: %d IOPS: %f") % total % boost::io::group(std::setprecision(0), std::fixed, (total * 1000000.0 / duration))));
     }
     overallCommands += total;
+    latency.add(arg[i].latency);
   }
 
   duration = static_cast<double>((std::chrono::duration_cast<ms_t>(end - start)).count());
-  logger(ptree, "Details", boost::str(boost::format("Overall Commands: %d, IOPS: %f (%s)")
-                % total % boost::io::group(std::setprecision(0), std::fixed, (overallCommands * 1000000.0 / duration)) % krnl.name));
-  ptree.put("status", test_token_passed);
+  const double iops = overallCommands * 1000000.0 / duration;
+  logger(ptree, "Details", boost::str(boost::format("Threads: %d, Queue depth: %d, Overall Commands: %d, IOPS: %f (%s)")
+                % threadNumber % queueLength % overallCommands % boost::io::group(std::setprecision(0), std::fixed, iops) % krnl_name));
+  logger(ptree, "Details", "Latency: " + latency.to_string_us());
+
+  // Sweep point for json output
+  boost::property_tree::ptree pt_point;
+  pt_point.put("threads", threadNumber);
+  pt_point.put("queue_depth", queueLength);
+  pt_point.put("commands", overallCommands);
+  pt_point.put("iops", static_cast<uint64_t>(iops));
+  pt_point.add_child("latency_us", latency.to_ptree_us());
+  auto& pt_sweep = ptree.get_child_optional("benchmark")
+    ? ptree.get_child("benchmark")
+    : ptree.add_child("benchmark", boost::property_tree::ptree());
+  pt_sweep.push_back(std::make_pair("", pt_point));
 }
 
 void
@@ -167,9 +185,6 @@ TestIOPS::runTest(std::shared_ptr<xrt_core::device> dev, boost::property_tree::p
 {
   const std::string test_path = findPlatformPath(dev, ptree);
   std::string b_file = findXclbinPath(dev, ptree); // verify.xclbin
-  const int threadNumber = 2;
-  const int queueLength = 128;
-  const int total = 50000;
 
   if (b_file.empty()) {
     if (test_path.empty()) {
@@ -180,9 +195,6 @@ TestIOPS::runTest(std::shared_ptr<xrt_core::device> dev, boost::property_tree::p
     b_file = (std::filesystem::path(test_path) / "verify.xclbin").string();
   }
 
-  krnl.name = "verify";
-  krnl.new_style = true;
-
   const std::string xclbin_fn = b_file;
   auto retVal = validate_binary_file(xclbin_fn);
   if (retVal == EOPNOTSUPP) {
@@ -193,7 +205,28 @@ TestIOPS::runTest(std::shared_ptr<xrt_core::device> dev, boost::property_tree::p
   const auto bdf_tuple = xrt_core::device_query<xrt_core::query::pcie_bdf>(dev);
   const std::string bdf = xrt_core::query::pcie_bdf::to_string(bdf_tuple);
   try {
-    testMultiThreads(bdf, xclbin_fn, threadNumber, queueLength, total, ptree);
+    xrt::device device(bdf);
+    auto uuid = device.load_xclbin(xclbin_fn);
+    std::string krnl_name = "verify";
+    xrt::kernel hello;
+    try {
+      hello = xrt::kernel(device, uuid.get(), krnl_name);
+    } catch (const std::exception&) {
+      krnl_name = "hello";
+      try {
+        hello = xrt::kernel(device, uuid.get(), krnl_name);
+      } catch (const std::exception&) {
+        logger(ptree, "Error", "Kernel could not be found.");
+        ptree.put("status", test_token_failed);
+        return;
+      }
+    }
+
+    for (auto threadNumber : m_threads)
+      for (auto queueLength : m_queue_depths)
+        testMultiThreads(device, hello, krnl_name, threadNumber, queueLength, m_total, ptree);
+
+    ptree.put("status", test_token_passed);
     return;
   }
   catch (const std::exception& ex) {
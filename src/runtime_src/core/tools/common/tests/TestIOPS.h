@@ -5,15 +5,26 @@
 #define __TestIOPS_h_
 
 #include "tools/common/TestRunner.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+
+#include <vector>
 
 class TestIOPS : public TestRunner {
   public:
     boost::property_tree::ptree run(std::shared_ptr<xrt_core::device> dev);
     void runTest(std::shared_ptr<xrt_core::device> dev, boost::property_tree::ptree& ptree);
+    void set_param(const std::string key, const std::string value);
     TestIOPS();
 
   private:
-    void testMultiThreads(const std::string& dev, const std::string& xclbin_fn, int threadNumber, int queueLength, unsigned int total, boost::property_tree::ptree& ptree);
+    void testMultiThreads(const xrt::device& device, const xrt::kernel& hello, const std::string& krnl_name,
+                          int threadNumber, int queueLength, unsigned int total, boost::property_tree::ptree& ptree);
+
+    // Sweep points, every combination of thread count and queue depth is run
+    std::vector<int> m_threads = {2};
+    std::vector<int> m_queue_depths = {128};
+    unsigned int m_total = 50000;
 };
 
 #endif
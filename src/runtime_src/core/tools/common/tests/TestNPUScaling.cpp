@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// ------ I N C L U D E   F I L E S -------------------------------------------
+// Local - Include Files
+#include "TestNPUScaling.h"
+#include "tools/common/XBUtilities.h"
+#include "xrt_iops_util/xilutil.hpp"
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+namespace XBU = XBUtilities;
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#ifdef _WIN32
+# define WIN32_LEAN_AND_MEAN
+# include <windows.h>
+#else
+# include <sys/resource.h>
+#endif
+
+using Clock = std::chrono::high_resolution_clock;
+
+namespace {
+
+static constexpr size_t host_app = 1; //opcode
+static constexpr size_t buffer_size = 20;
+
+// One hardware context with the DPU kernel and its NOP arguments
+struct context {
+  xrt::hw_context hwctx;
+  xrt::kernel kernel;
+  std::vector<xrt::bo> bos;  // ifm, param, ofm, inter, instr, mc
+};
+
+struct worker {
+  const context* ctx;
+  int depth;                  // runs kept in flight
+  int count;                  // runs to complete
+  latency_histogram latency;  // start to completion per run (ns)
+  std::exception_ptr error;
+};
+
+static context
+create_context(const xrt::device& device, const xrt::uuid& uuid, const std::string& kernel_name)
+{
+  context ctx;
+  ctx.hwctx = xrt::hw_context(device, uuid);
+  ctx.kernel = xrt::kernel(ctx.hwctx, kernel_name);
+
+  //Create BOs, the values are not initialized as they are not really used by this special test running on the device
+  int argno = 1;
+  for (auto flags : {XRT_BO_FLAGS_HOST_ONLY, XRT_BO_FLAGS_HOST_ONLY, XRT_BO_FLAGS_HOST_ONLY,
+                     XRT_BO_FLAGS_HOST_ONLY, XCL_BO_FLAGS_CACHEABLE}) {
+    ctx.bos.emplace_back(device, buffer_size, flags, ctx.kernel.group_id(argno++));
+  }
+  argno++;
+  ctx.bos.emplace_back(device, buffer_size, XRT_BO_FLAGS_HOST_ONLY, ctx.kernel.group_id(argno++));
+
+  //Create ctrlcode with NOPs
+  std::memset(ctx.bos[4].map<char*>(), 0, buffer_size);
+  for (auto& bo : ctx.bos)
+    bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+
+  return ctx;
+}
+
+static xrt::run
+create_run(const context& ctx)
+{
+  xrt::run run(ctx.kernel);
+  run.set_arg(0, host_app);
+  for (int i = 0; i < 5; ++i)
+    run.set_arg(i + 1, ctx.bos[i]);
+  run.set_arg(6, buffer_size);
+  run.set_arg(7, ctx.bos[5]);
+  return run;
+}
+
+// Keep depth runs in flight, restart each run as soon as it completes
+static void
+run_worker(worker& w, barrier& barrier)
+{
+  std::vector<xrt::run> runs;
+  std::vector<Clock::time_point> starts(w.depth);
+  try {
+    for (int i = 0; i < w.depth; ++i)
+      runs.push_back(create_run(*w.ctx));
+  }
+  catch (...) {
+    w.error = std::current_exception();
+  }
+
+  barrier.wait();
+  try {
+    int issued = 0;
+    for (int i = 0; !w.error && i < w.depth && issued < w.count; ++i, ++issued) {
+      starts[i] = Clock::now();
+      runs[i].start();
+    }
+
+    for (int done = 0, i = 0; !w.error && done < issued; ++done, i = (i + 1) % w.depth) {
+      runs[i].wait2();
+      w.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - starts[i]).count());
+      if (issued < w.count) {
+        starts[i] = Clock::now();
+        runs[i].start();
+        ++issued;
+      }
+    }
+  }
+  catch (...) {
+    w.error = std::current_exception();
+  }
+  barrier.wait();
+}
+
+// User plus system CPU time of this process
+static double
+process_cpu_seconds()
+{
+#ifdef _WIN32
+  FILETIME create, exit, kernel, user;
+  if (!GetProcessTimes(GetCurrentProcess(), &create, &exit, &kernel, &user))
+    return 0;
+  auto ticks = [](const FILETIME& ft) {
+    return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+  };
+  return static_cast<double>(ticks(kernel) + ticks(user)) / 1e7; // 100 ns ticks
+#else
+  struct rusage ru = {};
+  getrusage(RUSAGE_SELF, &ru);
+  auto secs = [](const timeval& tv) {
+    return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+  };
+  return secs(ru.ru_utime) + secs(ru.ru_stime);
+#endif
+}
+
+} // namespace
+
+// ----- C L A S S   M E T H O D S -------------------------------------------
+TestNPUScaling::TestNPUScaling()
+  : TestRunner("npu-scaling", "Run throughput and latency sweep over hardware contexts, threads and queue depth")
+{}
+
+/*
+ * Pass in custom parameters for npu-scaling test
+ */
+void
+TestNPUScaling::set_param(const std::string key, const std::string value)
+{
+  try {
+    if (key == "contexts")
+      m_contexts = parse_sweep(value);
+    else if (key == "threads")
+      m_threads = parse_sweep(value);
+    else if (key == "queue-depths")
+      m_queue_depths = parse_sweep(value);
+    else if (key == "runs")
+      m_runs = parse_sweep(value).front();
+  }
+  catch (const std::exception&) {
+    std::cerr << boost::format(
+      "ERROR: The parameter '%s' value '%s' is invalid for the test '%s'.\n")
+      % key % value % "npu-scaling";
+    throw xrt_core::error(std::errc::operation_canceled);
+  }
+}
+
+boost::property_tree::ptree
+TestNPUScaling::run(std::shared_ptr<xrt_core::device> dev)
+{
+  boost::property_tree::ptree ptree = get_test_header();
+
+  const auto xclbin_name = xrt_core::device_query<xrt_core::query::xclbin_name>(dev, xrt_core::query::xclbin_name::type::validate);
+  auto xclbin_path = findPlatformFile(xclbin_name, ptree);
+  if (!std::filesystem::exists(xclbin_path))
+    return ptree;
+
+  logger(ptree, "Xclbin", xclbin_path);
+
+  xrt::xclbin xclbin;
+  try {
+    xclbin = xrt::xclbin(xclbin_path);
+  }
+  catch (const std::runtime_error& ex) {
+    logger(ptree, "Error", ex.what());
+    ptree.put("status", test_token_failed);
+    return ptree;
+  }
+
+  // Determine The DPU Kernel Name
+  auto xkernels = xclbin.get_kernels();
+  auto itr = std::find_if(xkernels.begin(), xkernels.end(), [](xrt::xclbin::kernel& k) {
+    return k.get_name().rfind("DPU",0) == 0; // Starts with "DPU"
+  });
+  if (itr == xkernels.end()) {
+    logger(ptree, "Error", "No kernel with `DPU` found in the xclbin");
+    ptree.put("status", test_token_failed);
+    return ptree;
+  }
+  auto kernelName = itr->get_name();
+
+  auto working_dev = xrt::device(dev);
+  working_dev.register_xclbin(xclbin);
+
+  boost::property_tree::ptree pt_sweep;
+  bool failed = false;
+
+  for (auto num_contexts : m_contexts) {
+    // Contexts are independent NPU partitions, the device limits how
+    // many can be open at once
+    std::vector<context> contexts;
+    try {
+      for (int i = 0; i < num_contexts; ++i)
+        contexts.push_back(create_context(working_dev, xclbin.get_uuid(), kernelName));
+    }
+    catch (const std::exception& ex) {
+      logger(ptree, "Details", boost::str(boost::format("Skipping %d contexts: %s") % num_contexts % ex.what()));
+      break;
+    }
+
+    for (auto threads : m_threads) {
+      for (auto depth : m_queue_depths) {
+        std::vector<worker> workers(static_cast<size_t>(num_contexts) * threads);
+        for (size_t i = 0; i < workers.size(); ++i)
+          workers[i] = {&contexts[i % contexts.size()], depth, m_runs, latency_histogram(), nullptr};
+
+        barrier barrier;
+        barrier.init(static_cast<unsigned int>(workers.size() + 1));
+        std::vector<std::thread> thrs;
+        for (auto& w : workers)
+          thrs.emplace_back(run_worker, std::ref(w), std::ref(barrier));
+
+        barrier.wait();
+        auto cpu_start = process_cpu_seconds();
+        auto start = Clock::now();
+        barrier.wait();
+        auto end = Clock::now();
+        auto cpu_secs = process_cpu_seconds() - cpu_start;
+        for (auto& t : thrs)
+          t.join();
+
+        latency_histogram latency;
+        std::string error;
+        for (auto& w : workers) {
+          if (w.error) {
+            try {
+              std::rethrow_exception(w.error);
+            }
+            catch (const std::exception& ex) {
+              error = ex.what();
+            }
+          }
+          latency.add(w.latency);
+        }
+
+        if (!error.empty()) {
+          logger(ptree, "Error", boost::str(boost::format("%d contexts, %d threads, depth %d: %s")
+                                            % num_contexts % threads % depth % error));
+          failed = true;
+          continue;
+        }
+
+        const auto runs = latency.count();
+        const double secs = std::chrono::duration<double>(end - start).count();
+        const double throughput = secs > 0 ? runs / secs : 0;
+        const double cpu_us_per_run = runs ? cpu_secs * 1e6 / runs : 0;
+        logger(ptree, "Details", boost::str(boost::format("%d contexts, %d threads, depth %d: %.1f ops, host CPU %.1f us/op, latency %s")
+                                            % num_contexts % threads % depth % throughput % cpu_us_per_run
+                                            % latency.to_string_us()));
+
+        boost::property_tree::ptree pt_point;
+        pt_point.put("contexts", num_contexts);
+        pt_point.put("threads", threads);
+        pt_point.put("queue_depth", depth);
+        pt_point.put("runs", runs);
+        pt_point.put("throughput_ops", throughput);
+        pt_point.put("host_cpu_us_per_op", cpu_us_per_run);
+        pt_point.add_child("latency_us", latency.to_ptree_us());
+        pt_sweep.push_back(std::make_pair("", pt_point));
+      }
+    }
+  }
+
+  ptree.add_child("benchmark", pt_sweep);
+  ptree.put("status", failed ? test_token_failed : test_token_passed);
+  return ptree;
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#ifndef __TestNPUScaling_h_
+#define __TestNPUScaling_h_
+
+#include "tools/common/TestRunner.h"
+#include "xrt/xrt_device.h"
+
+#include <vector>
+
+class TestNPUScaling : public TestRunner {
+  public:
+    boost::property_tree::ptree run(std::shared_ptr<xrt_core::device> dev);
+    void set_param(const std::string key, const std::string value);
+
+  public:
+    TestNPUScaling();
+
+  private:
+    // Every combination of the sweep dimensions is measured
+    std::vector<int> m_contexts = {1, 2, 4};
+    std::vector<int> m_threads = {1, 2};
+    std::vector<int> m_queue_depths = {1, 4, 16};
+    int m_runs = 1000; // runs per thread per sweep point
+};
+
+#endif
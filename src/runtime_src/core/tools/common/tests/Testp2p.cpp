@@ -7,6 +7,8 @@
 #include "core/common/memalign.h"
 #include "tools/common/XBUtilities.h"
 #include "tools/common/XBUtilitiesCore.h"
+
+#include <chrono>
 namespace XBU = XBUtilities;
 
 // ------ L O C A L   F U N C T I O N S ---------------------------------------
@@ -129,6 +131,22 @@ p2ptest_chunk_no_dma(xrt::device& device, xrt::bo bo_p2p, size_t bo_size, int ba
   return true;
 }
 
+// Time create/free of short lived p2p buffers, the pattern used when
+// staging NVMe to FPGA transfers.  Returns average microseconds per
+// create/free pair.
+static double
+p2ptest_alloc_bench(xrt::device& device, size_t bo_size, int bank)
+{
+  const int iterations = 64;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < iterations; i++)
+    xrt::bo(device, bo_size, XCL_BO_FLAGS_P2P, bank);
+  auto end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
 } //end anonymous namespace
 
 // ----- C L A S S   M E T H O D S -------------------------------------------
@@ -222,6 +240,13 @@ Testp2p::p2ptest_bank(xrt_core::device* device, boost::property_tree::ptree& ptr
       }
     }
   }
+
+  // Verbose only, timing depends on the P2P pool_reserve setting
+  if (XBU::getVerbose()) {
+    auto usec = p2ptest_alloc_bench(xrt_device, chunk_size, mem_idx);
+    logger(ptree, "Details", boost::str(boost::format("P2P BO create/free on memory index %d: %.1f us") % mem_idx % usec));
+  }
+
   ptree.put("status", test_token_passed);
   return true;
 }
\ No newline at end of file
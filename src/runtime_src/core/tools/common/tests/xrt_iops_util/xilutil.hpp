@@ -5,6 +5,13 @@
 
 #include <mutex>
 #include <condition_variable>
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 /* std::barrier can be used since c++20
  * Thanks boost library. Modified a little bit with pure c++11 code
@@ -58,4 +65,120 @@ class barrier
     unsigned int m_count_reset_val;
 };
 
+/* Log-linear latency histogram in the style of HdrHistogram.
+ * Values below sub_count are recorded exactly, larger values go to
+ * buckets whose width doubles with each power of two, so a reported
+ * percentile is within 1/64 of the recorded value.  Recording is a
+ * few integer operations so it can be done per command.
+ */
+class latency_histogram
+{
+    static constexpr unsigned int sub_bits = 7;
+    static constexpr uint64_t sub_count = 1ull << sub_bits;
+    static constexpr uint64_t half_count = sub_count / 2;
+    static constexpr size_t bucket_count = sub_count + (64 - sub_bits) * half_count;
+
+    static size_t index(uint64_t value) {
+        if (value < sub_count)
+            return static_cast<size_t>(value);
+        unsigned int power = 0;
+        while ((value >> power) >= sub_count)
+            ++power;
+        return static_cast<size_t>(sub_count + (power - 1) * half_count + ((value >> power) - half_count));
+    }
+
+    // Highest value recorded in the bucket at idx
+    static uint64_t highest(size_t idx) {
+        if (idx < sub_count)
+            return idx;
+        auto k = idx - sub_count;
+        auto power = k / half_count + 1;
+        auto sub = k % half_count + half_count;
+        return ((sub + 1) << power) - 1;
+    }
+
+    public:
+    latency_histogram()
+        : m_counts(bucket_count, 0)
+    {}
+
+    void record(uint64_t value) {
+        ++m_counts[index(value)];
+        ++m_total;
+        m_max = std::max(m_max, value);
+    }
+
+    void add(const latency_histogram& other) {
+        for (size_t i = 0; i < bucket_count; ++i)
+            m_counts[i] += other.m_counts[i];
+        m_total += other.m_total;
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    uint64_t count() const { return m_total; }
+    uint64_t max() const { return m_max; }
+
+    // Value at or below which pct percent of the recorded values fall
+    uint64_t percentile(double pct) const {
+        if (!m_total)
+            return 0;
+        auto target = static_cast<uint64_t>(pct / 100.0 * static_cast<double>(m_total) + 0.5);
+        target = std::max<uint64_t>(target, 1);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < bucket_count; ++i) {
+            seen += m_counts[i];
+            if (seen >= target)
+                return std::min(highest(i), m_max);
+        }
+        return m_max;
+    }
+
+    // Percentiles as property tree in microseconds, values recorded in ns
+    boost::property_tree::ptree to_ptree_us() const {
+        boost::property_tree::ptree pt;
+        pt.put("p50", static_cast<double>(percentile(50.0)) / 1000.0);
+        pt.put("p99", static_cast<double>(percentile(99.0)) / 1000.0);
+        pt.put("p99_9", static_cast<double>(percentile(99.9)) / 1000.0);
+        pt.put("max", static_cast<double>(max()) / 1000.0);
+        return pt;
+    }
+
+    // Percentiles in microseconds for the test log
+    std::string to_string_us() const {
+        std::ostringstream os;
+        os.setf(std::ios::fixed);
+        os.precision(1);
+        os << "p50 " << static_cast<double>(percentile(50.0)) / 1000.0
+           << " us, p99 " << static_cast<double>(percentile(99.0)) / 1000.0
+           << " us, p99.9 " << static_cast<double>(percentile(99.9)) / 1000.0
+           << " us, max " << static_cast<double>(max()) / 1000.0 << " us";
+        return os.str();
+    }
+
+    private:
+    std::vector<uint64_t> m_counts;
+    uint64_t m_total = 0;
+    uint64_t m_max = 0;
+};
+
+/* Parse a comma separated list of positive integers, e.g. "1,8,32"
+ * as used for test parameter sweeps.  Throws std::invalid_argument.
+ */
+inline std::vector<int>
+parse_sweep(const std::string& value)
+{
+    std::vector<int> values;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        auto v = std::stoi(item, nullptr, 0);
+        if (v <= 0)
+            throw std::invalid_argument(item);
+        values.push_back(v);
+    }
+    if (values.empty())
+        throw std::invalid_argument(value);
+    return values;
+}
+
 #endif
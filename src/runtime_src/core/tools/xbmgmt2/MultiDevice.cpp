@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+
+// ------ I N C L U D E   F I L E S -------------------------------------------
+#include "MultiDevice.h"
+
+// XRT - Include Files
+#include "core/common/error.h"
+#include "core/common/query_requests.h"
+#include "tools/common/ProgressBar.h"
+#include "tools/common/XBUtilities.h"
+#include "tools/common/XBUtilitiesCore.h"
+namespace XBU = XBUtilities;
+
+// 3rd Party Library - Include Files
+#include <boost/format.hpp>
+
+// System - Include Files
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Stream buffer keeping a separate log per thread so that workers
+// printing progress to std::cout do not interleave their output.
+class per_thread_buf : public std::streambuf
+{
+  std::mutex m_mutex;
+  std::map<std::thread::id, std::string> m_logs;
+
+protected:
+  int_type
+  overflow(int_type ch) override
+  {
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+      return traits_type::not_eof(ch);
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_logs[std::this_thread::get_id()].push_back(traits_type::to_char_type(ch));
+    return ch;
+  }
+
+  std::streamsize
+  xsputn(const char* s, std::streamsize n) override
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_logs[std::this_thread::get_id()].append(s, static_cast<size_t>(n));
+    return n;
+  }
+
+public:
+  std::string
+  take(std::thread::id id)
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    auto itr = m_logs.find(id);
+    if (itr == m_logs.end())
+      return "";
+
+    auto log = std::move(itr->second);
+    m_logs.erase(itr);
+    return log;
+  }
+};
+
+// Restore std::cout stream buffer when going out of scope
+struct cout_redirect
+{
+  std::streambuf* m_old;
+
+  explicit
+  cout_redirect(std::streambuf* buf)
+    : m_old(std::cout.rdbuf(buf))
+  {}
+
+  ~cout_redirect()
+  {
+    std::cout.rdbuf(m_old);
+  }
+};
+
+struct device_result
+{
+  std::string bdf;
+  std::string log;
+  std::string error;
+};
+
+} // namespace
+
+xrt_core::device_collection
+get_all_mgmt_devices()
+{
+  xrt_core::device_collection devices;
+  XBU::collect_devices(std::set<std::string>{"_all_"}, false /*inUserDomain*/, devices);
+  if (devices.empty())
+    throw xrt_core::error("No devices found");
+  return devices;
+}
+
+void
+run_on_all_devices(const std::string& op_name,
+                   const xrt_core::device_collection& devices,
+                   const std::function<void(const std::shared_ptr<xrt_core::device>&)>& op)
+{
+  std::vector<device_result> results(devices.size());
+  for (size_t i = 0; i < devices.size(); ++i)
+    results[i].bdf = xrt_core::query::pcie_bdf::to_string(xrt_core::device_query<xrt_core::query::pcie_bdf>(devices[i]));
+
+  // Progress goes directly to the console, worker output is captured
+  std::ostream console(std::cout.rdbuf());
+  per_thread_buf capture;
+  std::atomic<unsigned int> done(0);
+  {
+    cout_redirect redirect(&capture);
+    XBU::ProgressBar progress(boost::str(boost::format("%s on %d devices") % op_name % devices.size()),
+                              static_cast<unsigned int>(devices.size()),
+                              XBU::is_escape_codes_disabled(), console);
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < devices.size(); ++i) {
+      workers.emplace_back([&, i] {
+        try {
+          op(devices[i]);
+        }
+        catch (const std::exception& e) {
+          results[i].error = e.what();
+        }
+        results[i].log = capture.take(std::this_thread::get_id());
+        ++done;
+      });
+    }
+
+    while (done < devices.size()) {
+      progress.update(done);
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+
+    for (auto& worker : workers)
+      worker.join();
+
+    bool success = true;
+    for (const auto& result : results)
+      success = success && result.error.empty();
+    progress.finish(success, success ? "All devices completed successfully" : "One or more devices failed");
+  }
+
+  // Print captured output device by device
+  std::stringstream error_stream;
+  for (const auto& result : results) {
+    std::cout << "----------------------------------------------------\n";
+    std::cout << boost::format("Device [%s]\n") % result.bdf;
+    std::cout << result.log;
+    if (!result.error.empty())
+      error_stream << boost::format("  [%s] : %s\n") % result.bdf % result.error;
+  }
+  std::cout << "----------------------------------------------------\n";
+
+  if (!error_stream.str().empty()) {
+    std::cerr << "ERROR: Operation failed on device(s):\n" << error_stream.str();
+    throw xrt_core::error(std::errc::operation_canceled);
+  }
+}
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2023 Advanced Micro Devices, Inc. All rights reserved.
+
+#ifndef __MultiDevice_h_
+#define __MultiDevice_h_
+
+#include "core/common/device.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+// Run an operation on all devices concurrently, one worker thread per
+// device.  Console output of each worker is captured and printed per
+// device once all workers are done, while overall progress is reported
+// with a ProgressBar.  Throws operation_canceled if any device failed.
+void
+run_on_all_devices(const std::string& op_name,
+                   const xrt_core::device_collection& devices,
+                   const std::function<void(const std::shared_ptr<xrt_core::device>&)>& op);
+
+// Collect all management devices, throws if there are none
+xrt_core::device_collection
+get_all_mgmt_devices();
+
+#endif
@@ -8,6 +8,7 @@
 #include "core/common/info_vmr.h"
 #include "core/common/message.h"
 #include "flash/flasher.h"
+#include "MultiDevice.h"
 #include "ReportPlatform.h"
 #include "tools/common/ProgressBar.h"
 #include "tools/common/XBUtilitiesCore.h"
@@ -460,7 +461,7 @@ update_default_only(xrt_core::device* device, bool value)
 // Update shell and sc firmware on the device automatically
 // Refactor code to support only 1 device.
 static void
-auto_flash(std::shared_ptr<xrt_core::device> & device, Flasher::E_FlasherType flashType, const std::string& image = "")
+auto_flash(const std::shared_ptr<xrt_core::device>& device, Flasher::E_FlasherType flashType, const std::string& image = "", bool prompt = true)
 {
   // Get platform information
   boost::property_tree::ptree pt;
@@ -540,7 +541,7 @@ auto_flash(std::shared_ptr<xrt_core::device> & device, Flasher::E_FlasherType fl
   std::stringstream report_stream;
 
   // Prompt user about what boards will be updated and ask for permission.
-  if (!XBU::can_proceed(XBU::getForce()))
+  if (prompt && !XBU::can_proceed(XBU::getForce()))
     return;
 
   // Perform DSA and BMC updating
@@ -649,6 +650,75 @@ find_flash_image_paths(const std::vector<std::string>& image_list)
   return path_list;
 }
 
+// Map the requested images to primary and secondary image paths.  An
+// empty map selects the installed image automatically.
+static std::map<std::string, std::string>
+get_image_map(const std::string& update, const std::vector<std::string>& images)
+{
+  std::map<std::string, std::string> validated_image_map;
+
+  // User did not provide an image for all. Select image automatically.
+  if (images.empty() && ((update.compare("all") == 0) || (update.compare("no-backup") == 0)))
+    return validated_image_map;
+
+  // All other cases have a specified image
+  // Get a list of images known exist
+  const auto validated_images = find_flash_image_paths(images);
+  // Fail early here to reduce additional conditions below
+  // Technically validated_images will never be empty as: if image is not empty but has a bad
+  // path or bad shell name find_flash_image_paths exits early. This statement can be removed
+  // or left here as a precaution.
+  if (validated_images.empty())
+    throw xrt_core::error("Please provide a valid xsabin file or specify the type of base to flash");
+
+  switch (validated_images.size()) {
+    case 2:
+      validated_image_map["primary"] = validated_images[0];
+      validated_image_map["secondary"] = validated_images[1];
+      break;
+    case 1:
+      validated_image_map["primary"] = validated_images[0];
+      break;
+    default:
+      break;
+  }
+  return validated_image_map;
+}
+
+// Update the base images of one device
+static void
+program_base(const std::shared_ptr<xrt_core::device>& device, const std::string& update,
+             std::map<std::string, std::string> validated_image_map, const std::string& flash_type_str,
+             bool prompt)
+{
+  Flasher working_flasher(device->get_device_id());
+  auto flash_type = working_flasher.getFlashType(flash_type_str);
+
+  if (update.compare("all") == 0) {
+    update_default_only(device.get(), false);
+    auto_flash(device, flash_type, validated_image_map["primary"], prompt);
+  }
+  // For the following two if conditions regarding the validated images portion
+  // The user may have provided an image, but, it may not exist or the shell name is wrong
+  else if (update.compare("sc") == 0) {
+    update_SC(device.get()->get_device_id(), validated_image_map["primary"]);
+  }
+  else if (update.compare("shell") == 0) {
+    update_default_only(device.get(), false);
+    update_shell(device.get()->get_device_id(), validated_image_map, flash_type);
+    std::cout << "****************************************************\n";
+    std::cout << "Cold reboot machine to load the new image on device.\n";
+    std::cout << "****************************************************\n";
+  }
+  else if (update.compare("no-backup") == 0) {
+    update_default_only(device.get(), true);
+    auto_flash(device, flash_type, validated_image_map["primary"], prompt);
+  }
+  else
+    throw xrt_core::error("Usage: xbmgmt program --device='0000:00:00.0' --base [all|sc|shell]"
+                          " --image=['/path/to/flash_image'|'shell name']");
+}
+
 OO_UpdateBase::OO_UpdateBase(const std::string& _longName, const std::string& _shortName, bool _isHidden)
     : OptionOptions(_longName,
                     _shortName,
@@ -667,7 +737,7 @@ OO_UpdateBase::OO_UpdateBase(const std::string& _longName, const std::string& _s
     , m_help(false)
 {
   m_optionsDescription.add_options()
-    ("device,d", po::value<decltype(m_device)>(&m_device), "The Bus:Device.Function (e.g., 0000:d8:00.0) device of interest")
+    ("device,d", po::value<decltype(m_device)>(&m_device), "The Bus:Device.Function (e.g., 0000:d8:00.0) device of interest, or 'all' to program every device concurrently")
     ("image", boost::program_options::value<decltype(m_image)>(&m_image)->multitoken(),  "Specifies an image to use used to update the persistent device.  Valid values:\n"
                                                                     "  Name (and path) to the mcs image on disk\n"
                                                                     "  Name (and path) to the xsabin image on disk")
@@ -708,17 +778,6 @@ OO_UpdateBase::execute(const SubCmdOptions& _options) const
   // -- Now process the subcommand --------------------------------------------
   XBU::verbose(boost::str(boost::format("  Base: %s") % m_update));
 
-  // -- process "device" option -----------------------------------------------
-  // Find device of interest
-  std::shared_ptr<xrt_core::device> device;
-  try {
-    device = XBU::get_device(boost::algorithm::to_lower_copy(m_device), false /*inUserDomain*/);
-  } catch (const std::runtime_error& e) {
-    // Catch only the exceptions that we have generated earlier
-    std::cerr << boost::format("ERROR: %s\n") % e.what();
-    throw xrt_core::error(std::errc::operation_canceled);
-  }
-
   // Only two images options are supported
   if (m_image.size() > 2)
     throw xrt_core::error("Multiple flash images provided. Please specify either 1 or 2 flash images.");
@@ -728,74 +787,38 @@ OO_UpdateBase::execute(const SubCmdOptions& _options) const
       xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",
         "Overriding flash mode is not recommended.\nYou may damage your device with this option.");
   }
-  Flasher working_flasher(device->get_device_id());
-  auto flash_type = working_flasher.getFlashType(m_flashType);
 
-  XBU::verbose("Sub command: --base");
-  XBU::sudo_or_throw("Root privileges are required to update the devices flash image");
-  // User did not provide an image for all. Select image automatically.
-  if (m_update.compare("all") == 0) {
-    update_default_only(device.get(), false);
-    if (m_image.empty()) {
-      auto_flash(device, flash_type);
-      return;
-    }
-  }
-  else if (m_update.compare("no-backup") == 0) {
-    if (m_image.empty()) {
-      update_default_only(device.get(), true);
-      auto_flash(device, flash_type);
+  // -- process "device" option -----------------------------------------------
+  // Program all devices concurrently
+  if (boost::iequals(m_device, "all")) {
+    auto devices = get_all_mgmt_devices();
+    XBU::verbose("Sub command: --base");
+    XBU::sudo_or_throw("Root privileges are required to update the devices flash image");
+    const auto image_map = get_image_map(m_update, m_image);
+
+    std::cout << "Base image(s) will be updated on the following devices:\n";
+    for (const auto& device : devices)
+      std::cout << boost::format("  [%s]\n") % xrt_core::query::pcie_bdf::to_string(xrt_core::device_query<xrt_core::query::pcie_bdf>(device));
+    if (!XBU::can_proceed(XBU::getForce()))
       return;
-    }
-  }
-
-  // All other cases have a specified image
-  // Get a list of images known exist
 
-  const auto validated_images = find_flash_image_paths(m_image);
-  // Fail early here to reduce additional conditions below
-  // Technically validated_images will never be empty as: if image is not empty but has a bad
-  // path or bad shell name find_flash_image_paths exits early. This statement can be removed
-  // or left here as a precaution.
-  if (validated_images.empty())
-    throw xrt_core::error("Please provide a valid xsabin file or specify the type of base to flash");
-
-  std::map<std::string, std::string> validated_image_map;
-  switch (validated_images.size()) {
-    case 2:
-      validated_image_map["primary"] = validated_images[0];
-      validated_image_map["secondary"] = validated_images[1];
-      break;
-    case 1:
-      validated_image_map["primary"] = validated_images[0];
-      break;
-    default:
-      break;
+    run_on_all_devices("Programming base", devices, [this, &image_map](const std::shared_ptr<xrt_core::device>& device) {
+      program_base(device, m_update, image_map, m_flashType, false /*prompt*/);
+    });
+    return;
   }
 
-  if (m_update.compare("all") == 0) {
-      update_default_only(device.get(), false);
-      auto_flash(device, flash_type, validated_image_map["primary"]);
-  }
-  // For the following two if conditions regarding the validated images portion
-  // The user may have provided an image, but, it may not exist or the shell name is wrong
-  else if (m_update.compare("sc") == 0) {
-    update_SC(device.get()->get_device_id(), validated_image_map["primary"]);
-  }
-  else if (m_update.compare("shell") == 0) {
-    update_default_only(device.get(), false);
-    update_shell(device.get()->get_device_id(), validated_image_map, flash_type);
-    std::cout << "****************************************************\n";
-    std::cout << "Cold reboot machine to load the new image on device.\n";
-    std::cout << "****************************************************\n";
-  }
-  else if (m_update.compare("no-backup") == 0) {
-    update_default_only(device.get(), true);
-    auto_flash(device, flash_type, validated_image_map["primary"]);
+  // Find device of interest
+  std::shared_ptr<xrt_core::device> device;
+  try {
+    device = XBU::get_device(boost::algorithm::to_lower_copy(m_device), false /*inUserDomain*/);
+  } catch (const std::runtime_error& e) {
+    // Catch only the exceptions that we have generated earlier
+    std::cerr << boost::format("ERROR: %s\n") % e.what();
+    throw xrt_core::error(std::errc::operation_canceled);
   }
-  else
-    throw xrt_core::error("Usage: xbmgmt program --device='0000:00:00.0' --base [all|sc|shell]"
-                          " --image=['/path/to/flash_image'|'shell name']");
 
-  return;
+  XBU::verbose("Sub command: --base");
+  XBU::sudo_or_throw("Root privileges are required to update the devices flash image");
+  program_base(device, m_update, get_image_map(m_update, m_image), m_flashType, true /*prompt*/);
 }
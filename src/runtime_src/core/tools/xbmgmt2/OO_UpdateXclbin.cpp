@@ -4,6 +4,7 @@
 // ------ I N C L U D E   F I L E S -------------------------------------------
 // Local - Include Files
 #include "OO_UpdateXclbin.h"
+#include "MultiDevice.h"
 
 // XRT - Include Files
 #include "core/common/query_requests.h"
@@ -21,6 +22,36 @@ namespace po = boost::program_options;
 #include <iostream>
 #include <vector>
 
+static std::vector<char>
+read_xclbin(const std::string& xclbin)
+{
+  std::ifstream stream(xclbin, std::ios::binary);
+  if (!stream)
+    throw xrt_core::error(boost::str(boost::format("Could not open %s for reading") % xclbin));
+
+  stream.seekg(0,stream.end);
+  ssize_t size = stream.tellg();
+  stream.seekg(0,stream.beg);
+
+  std::vector<char> xclbin_buffer(size);
+  stream.read(xclbin_buffer.data(), size);
+  return xclbin_buffer;
+}
+
+static void
+load_xclbin(const std::shared_ptr<xrt_core::device>& device, const std::vector<char>& xclbin_buffer)
+{
+  auto bdf = xrt_core::query::pcie_bdf::to_string(xrt_core::device_query<xrt_core::query::pcie_bdf>(device));
+  std::cout << "Downloading xclbin on device [" << bdf << "]..." << std::endl;
+  try {
+    device->xclmgmt_load_xclbin(xclbin_buffer.data());
+  } catch (xrt_core::error& e) {
+    std::cout << "ERROR: " << e.what() << std::endl;
+    throw xrt_core::error(std::errc::operation_canceled);
+  }
+  std::cout << boost::format("INFO: Successfully downloaded xclbin \n") << std::endl;
+}
+
 OO_UpdateXclbin::OO_UpdateXclbin(const std::string& _longName, const std::string& _shortName, bool _isHidden)
     : OptionOptions(_longName,
                     _shortName,
@@ -33,7 +64,7 @@ OO_UpdateXclbin::OO_UpdateXclbin(const std::string& _longName, const std::string
     , m_xclbin("")
 {
   m_optionsDescription.add_options()
-    ("device,d", po::value<decltype(m_device)>(&m_device), "The Bus:Device.Function (e.g., 0000:d8:00.0) device of interest")
+    ("device,d", po::value<decltype(m_device)>(&m_device), "The Bus:Device.Function (e.g., 0000:d8:00.0) device of interest, or 'all' to program every device concurrently")
     ("help", po::bool_switch(&m_help), "Help to use this sub-command")
   ;
 }
@@ -61,6 +92,20 @@ OO_UpdateXclbin::execute(const SubCmdOptions& _options) const
   }
 
   // -- process "device" option -----------------------------------------------
+  // Download xclbin to all devices concurrently
+  if (boost::iequals(m_device, "all") && !m_xclbin.empty()) {
+    auto devices = get_all_mgmt_devices();
+    XBU::verbose(boost::str(boost::format("  xclbin: %s") % m_xclbin));
+    XBU::sudo_or_throw("Root privileges are required to download xclbin");
+
+    // Read once, shared by all workers
+    const auto xclbin_buffer = read_xclbin(m_xclbin);
+    run_on_all_devices("Downloading xclbin", devices, [&xclbin_buffer](const std::shared_ptr<xrt_core::device>& device) {
+      load_xclbin(device, xclbin_buffer);
+    });
+    return;
+  }
+
   // Find device of interest
   std::shared_ptr<xrt_core::device> device;
   try {
@@ -76,26 +121,7 @@ OO_UpdateXclbin::execute(const SubCmdOptions& _options) const
     XBU::verbose(boost::str(boost::format("  xclbin: %s") % m_xclbin));
     XBU::sudo_or_throw("Root privileges are required to download xclbin");
 
-    std::ifstream stream(m_xclbin, std::ios::binary);
-    if (!stream)
-      throw xrt_core::error(boost::str(boost::format("Could not open %s for reading") % m_xclbin));
-
-    stream.seekg(0,stream.end);
-    ssize_t size = stream.tellg();
-    stream.seekg(0,stream.beg);
-
-    std::vector<char> xclbin_buffer(size);
-    stream.read(xclbin_buffer.data(), size);
-
-    auto bdf = xrt_core::query::pcie_bdf::to_string(xrt_core::device_query<xrt_core::query::pcie_bdf>(device));
-    std::cout << "Downloading xclbin on device [" << bdf << "]..." << std::endl;
-    try {
-      device->xclmgmt_load_xclbin(xclbin_buffer.data());
-    } catch (xrt_core::error& e) {
-      std::cout << "ERROR: " << e.what() << std::endl;
-      throw xrt_core::error(std::errc::operation_canceled);
-    }
-    std::cout << boost::format("INFO: Successfully downloaded xclbin \n") << std::endl;
+    load_xclbin(device, read_xclbin(m_xclbin));
     return;
   }
 
@@ -30,7 +30,9 @@
 #include <algorithm>
 #include <climits>
 #include <iomanip>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <cstdint>
 #include <cstring>
 #include <vector>
@@ -559,18 +561,19 @@ remove_xsabin_section(void * xsabin_buffer, enum axlf_section_kind section_to_re
   }
 }
 
-firmwareImage::firmwareImage(const std::string& file, imageType type) :
-    mType(type), mBuf(nullptr)
+// Extract the image of given type from file.  Returns nullptr on failure.
+static std::shared_ptr<const std::vector<char>>
+load_image(const std::string& file, imageType type)
 {
     std::ifstream in_file(file, std::ios::binary | std::ios::ate);
     if (!in_file.is_open())
     {
-        this->setstate(failbit);
         std::cout << "Can't open " << file << std::endl;
-        return;
+        return nullptr;
     }
     auto bufsize = in_file.tellg();
     in_file.seekg(0);
+    auto buf = std::make_shared<std::vector<char>>();
 
     std::string fn(file);
     if ((fn.find("." XSABIN_FILE_SUFFIX) != std::string::npos) ||
@@ -582,16 +585,15 @@ firmwareImage::firmwareImage(const std::string& file, imageType type) :
         in_file.read(reinterpret_cast<char *>(&a), sz);
         if (!in_file.good())
         {
-            this->setstate(failbit);
             std::cout << "Can't read axlf from "<< file << std::endl;
-            return;
+            return nullptr;
         }
 
         // Reread axlf from dsabin file, including all section headers.
 
         // Sanity check for number of sections coming from user input file
         if (a.m_header.m_numSections > 10000)
-            return;
+            return buf;
 
         in_file.seekg(0);
         sz = sizeof (axlf) + sizeof (axlf_section_header) * (a.m_header.m_numSections - 1);
@@ -599,9 +601,8 @@ firmwareImage::firmwareImage(const std::string& file, imageType type) :
         in_file.read(top.data(), sz);
         if (!in_file.good())
         {
-            this->setstate(failbit);
             std::cout << "Can't read axlf and section headers from "<< file << std::endl;
-            return;
+            return nullptr;
         }
 
         const axlf *ap = reinterpret_cast<const axlf *>(top.data());
@@ -611,9 +612,8 @@ firmwareImage::firmwareImage(const std::string& file, imageType type) :
             const axlf_section_header* bmcSection = xclbin::get_axlf_section(ap, BMC);
             if (bmcSection == nullptr)
             {
-                this->setstate(failbit);
                 std::cout << "Can't find SC section in "<< file << std::endl;
-                return;
+                return nullptr;
             }
             // Load entire BMC section.
             std::shared_ptr<char> bmcbuf(new char[bmcSection->m_sectionSize]);
@@ -621,16 +621,15 @@ firmwareImage::firmwareImage(const std::string& file, imageType type) :
             in_file.read(bmcbuf.get(), bmcSection->m_sectionSize);
             if (!in_file.good())
             {
-                this->setstate(failbit);
                 std::cout << "Can't read SC section from "<< file << std::endl;
-                return;
+                return nullptr;
             }
             const struct bmc *bmc = reinterpret_cast<const struct bmc *>(bmcbuf.get());
             // Load data into stream.
             bufsize = bmc->m_size;
-            mBuf = new char[bufsize];
+            buf->resize(bufsize);
             in_file.seekg(bmcSection->m_sectionOffset + bmc->m_offset);
-            in_file.read(mBuf, bufsize);
+            in_file.read(buf->data(), bufsize);
         }
         else if (type == STRIPPED_FIRMWARE)
         {
@@ -644,15 +643,14 @@ firmwareImage::firmwareImage(const std::string& file, imageType type) :
                 remove_xsabin_section(full.data(), MCS);
                 remove_xsabin_mirror(full.data());
             } catch (const std::exception &e) {
-                this->setstate(failbit);
                 std::cout << "failed to remove section from "<< file << ": "
                     << e.what() << std::endl;
-                return;
+                return nullptr;
             }
             // Load data into stream.
             bufsize = fp->m_header.m_length;
-            mBuf = new char[bufsize];
-            std::memcpy(mBuf, full.data(), bufsize);
+            buf->resize(bufsize);
+            std::memcpy(buf->data(), full.data(), bufsize);
         }
         else
         {
@@ -669,8 +667,7 @@ firmwareImage::firmwareImage(const std::string& file, imageType type) :
 
                 if (type != MCS_FIRMWARE_PRIMARY)
                 {
-                    this->setstate(failbit);
-                    return;
+                    return nullptr;
                 }
 
                 //load 'struct flash'
@@ -679,23 +676,21 @@ firmwareImage::firmwareImage(const std::string& file, imageType type) :
                 in_file.read(reinterpret_cast<char *>(&flashMeta), sizeof(flashMeta));
                 if (!in_file.good() || flashMeta.m_flash_type != FLT_BIN_PRIMARY)
                 {
-                    this->setstate(failbit);
                     std::cout << "Can't read FLASH section from "<< file << std::endl;
-                    return;
+                    return nullptr;
                 }
                 // Load data into stream.
                 bufsize = flashMeta.m_image_size;
-                mBuf = new char[bufsize];
+                buf->resize(bufsize);
                 in_file.seekg(flashSection->m_sectionOffset + flashMeta.m_image_offset);
-                in_file.read(mBuf, bufsize);
+                in_file.read(buf->data(), bufsize);
             }
             else if (pdiSection) {
                 if (type != MCS_FIRMWARE_PRIMARY)
                 {
-                    this->setstate(failbit);
                     std::cout << "PDI dsabin supports only primary bitstream: "
                         << file << std::endl;
-                    return;
+                    return nullptr;
                 }
 
                 /*
@@ -703,17 +698,16 @@ firmwareImage::firmwareImage(const std::string& file, imageType type) :
 		 * For legacy ospiversal type, the Flasher class will trim to PDI.
 		 * For new ospi_xgq type, the Flasher will take entire xsabin.
                  */
-                mBuf = new char[bufsize];
+                buf->resize(bufsize);
                 in_file.seekg(0);
-                in_file.read(mBuf, bufsize);
+                in_file.read(buf->data(), bufsize);
             } else {
                 // Obtain MCS section header.
                 const axlf_section_header* mcsSection = xclbin::get_axlf_section(ap, MCS);
                 if (mcsSection == nullptr)
                 {
-                    this->setstate(failbit);
                     std::cout << "Can't find MCS section in "<< file << std::endl;
-                    return;
+                    return nullptr;
                 }
                 // Load entire MCS section.
                 std::shared_ptr<char> mcsbuf(new char[mcsSection->m_sectionSize]);
@@ -721,9 +715,8 @@ firmwareImage::firmwareImage(const std::string& file, imageType type) :
                 in_file.read(mcsbuf.get(), mcsSection->m_sectionSize);
                 if (!in_file.good())
                 {
-                    this->setstate(failbit);
                     std::cout << "Can't read MCS section from "<< file << std::endl;
-                    return;
+                    return nullptr;
                 }
                 const struct mcs *mcs = reinterpret_cast<const struct mcs *>(mcsbuf.get());
                 // Only two types of MCS supported today
@@ -739,14 +732,13 @@ firmwareImage::firmwareImage(const std::string& file, imageType type) :
                 }
                 if (c == nullptr)
                 {
-                    this->setstate(failbit);
-                    return;
+                    return nullptr;
                 }
                 // Load data into stream.
                 bufsize = c->m_size;
-                mBuf = new char[bufsize];
+                buf->resize(bufsize);
                 in_file.seekg(mcsSection->m_sectionOffset + c->m_offset);
-                in_file.read(mBuf, bufsize);
+                in_file.read(buf->data(), bufsize);
             }
         }
 
@@ -755,15 +747,45 @@ firmwareImage::firmwareImage(const std::string& file, imageType type) :
     {
         if ((type != BMC_FIRMWARE) && (type != MCS_FIRMWARE_PRIMARY))
         {
-            this->setstate(failbit);
             std::cout << "non-dsabin supports only primary bitstream: " << file << std::endl;
-            return;
+            return nullptr;
         }
         // For non-dsabin file, the entire file is the image.
-        mBuf = new char[bufsize];
+        buf->resize(bufsize);
         in_file.seekg(0);
-        in_file.read(mBuf, bufsize);
+        in_file.read(buf->data(), bufsize);
+    }
+
+    return buf;
+}
+
+// Images are cached per process, so programming several devices with the
+// same file reads and extracts each image only once.
+static std::shared_ptr<const std::vector<char>>
+get_image(const std::string& file, imageType type)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<std::string, int>, std::shared_ptr<const std::vector<char>>> cache;
+
+    std::lock_guard<std::mutex> lk(mutex);
+    auto& image = cache[{file, type}];
+    if (!image)
+        image = load_image(file, type);
+    return image;
+}
+
+firmwareImage::firmwareImage(const std::string& file, imageType type) :
+    mType(type), mBuf(nullptr)
+{
+    auto image = get_image(file, type);
+    if (!image)
+    {
+        this->setstate(failbit);
+        return;
     }
+    auto bufsize = image->size();
+    mBuf = new char[bufsize];
+    std::memcpy(mBuf, image->data(), bufsize);
 
 // rdbuf doesn't work on windows and str() doesn't work for ospi_versal on linux
 #ifdef __linux__
@@ -27,6 +27,7 @@
 #include <vector>
 #include <limits>
 #include <array>
+#include <future>
 #include <fcntl.h>
 
 
@@ -2060,7 +2061,7 @@ static bool mcsStreamIsGolden(std::istream& mcsStream)
 }
 
 static int mcsStreamToBin(std::istream& mcsStream, unsigned int& currentAddr,
-    std::vector<unsigned char>& buf, unsigned int& nextAddr)
+    std::vector<unsigned char>& buf, unsigned int& nextAddr, bool progress = true)
 {
     bool done = false;
     size_t cnt = 0;
@@ -2122,13 +2123,16 @@ static int mcsStreamToBin(std::istream& mcsStream, unsigned int& currentAddr,
         }
 
         if (cnt >= pagesz) {
-            std::cout << "." << std::flush;
+            if (progress)
+                std::cout << "." << std::flush;
             cnt = 0;
         }
     }
-    if (cnt) // print the last "."
+    if (progress) {
+        if (cnt) // print the last "."
             std::cout << "." << std::flush;
-    std::cout << std::endl;
+        std::cout << std::endl;
+    }
 
     if (buf.size() > UINT_MAX) {
         std::cout << "MCS bitstream is too large: 0x" << std::hex << buf.size()
@@ -2158,36 +2162,58 @@ static int writeBitstream(std::FILE *flashDev, int index, unsigned int addr,
     return ret;
 }
 
-static int programXSpiDrv(xrt_core::device *dev, std::FILE *mFlashDev, std::istream& mcsStream,
-    int index, uint32_t addressShift)
+namespace {
+
+struct mcsChunk
 {
-    // Parse MCS data and write each contiguous chunk to flash.
     std::vector<unsigned char> buf;
-    unsigned int curAddr = UINT_MAX;
+    unsigned int addr = UINT_MAX;
     unsigned int nextAddr = 0;
+    int ret = 0;
+};
+
+}
+
+static int programXSpiDrv(xrt_core::device *dev, std::FILE *mFlashDev, std::istream& mcsStream,
+    int index, uint32_t addressShift)
+{
+    // Parse MCS data and write each contiguous chunk to flash. Parsing of
+    // the next chunk overlaps with writing of the current one, so flash is
+    // kept busy while the host converts MCS text to binary.
+    auto parse = [&mcsStream](unsigned int addr, bool progress) {
+        mcsChunk chunk;
+        chunk.addr = addr;
+        chunk.ret = mcsStreamToBin(mcsStream, chunk.addr, chunk.buf, chunk.nextAddr, progress);
+        return chunk;
+    };
     unsigned int startAddr = 0;
-    int ret;
     bool store = true;
 
-    while (nextAddr != UINT_MAX) {
-        std::cout << "Extracting bitstream from MCS data:" << std::endl;
-        ret = mcsStreamToBin(mcsStream, curAddr, buf, nextAddr);
-        if (ret)
-            return ret;
-        assert(nextAddr == UINT_MAX || pageOffset(nextAddr) == 0);
-        std::cout << "Extracted " << buf.size() << " bytes from bitstream @0x"
-            << std::hex << curAddr << std::dec << std::endl;
+    std::cout << "Extracting bitstream from MCS data:" << std::endl;
+    auto chunk = parse(UINT_MAX, true);
+    while (true) {
+        if (chunk.ret)
+            return chunk.ret;
+        assert(chunk.nextAddr == UINT_MAX || pageOffset(chunk.nextAddr) == 0);
+        std::cout << "Extracted " << chunk.buf.size() << " bytes from bitstream @0x"
+            << std::hex << chunk.addr << std::dec << std::endl;
 
         if (store) {
-          startAddr = curAddr;
+          startAddr = chunk.addr;
           store = false;
         }
 
+        std::future<mcsChunk> next;
+        if (chunk.nextAddr != UINT_MAX)
+            next = std::async(std::launch::async, parse, chunk.nextAddr, false);
+
         std::cout << "Writing bitstream to flash " << index << ":" << std::endl;
-        ret = writeBitstream(mFlashDev, index, curAddr + addressShift, buf);
+        int ret = writeBitstream(mFlashDev, index, chunk.addr + addressShift, chunk.buf);
         if (ret)
-            return ret;
-        curAddr = nextAddr;
+            return ret;   // pending parse is joined by future destructor
+        if (!next.valid())
+            break;
+        chunk = next.get();
     }
 
     // provide flash controller information to icap controller for webstar flow. Required only for U.2
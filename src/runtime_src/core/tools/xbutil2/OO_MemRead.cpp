@@ -9,6 +9,7 @@
 #include "core/common/memaccess.h"
 #include "core/common/query_requests.h"
 #include "core/common/system.h"
+#include "tools/common/ProgressBar.h"
 #include "tools/common/XBUtilitiesCore.h"
 #include "tools/common/XBUtilities.h"
 namespace XBU = XBUtilities;
@@ -114,20 +115,20 @@ OO_MemRead::execute(const SubCmdOptions& _options) const
   //read mem
   XBU::xclbin_lock xclbin_lock(device.get());
 
-  // Open the output file and write the data as we receive it
-  std::ofstream out_file(m_outputFile, std::ofstream::out | std::ofstream::binary | std::ofstream::app);
-  for(decltype(m_count) running_count = 0; running_count < m_count; running_count++) {
-    XBU::verbose(boost::str(boost::format("[%d / %d] Reading from Address: %s, Size: %s bytes") % running_count % m_count % addr % size));
-    // Get the output from the device
-    std::vector<char> data = xrt_core::device_mem_read(device.get(), addr, size);
-    // Write output to the given file
-    out_file.write(data.data(), data.size());
-    if ((out_file.rdstate() & std::ifstream::failbit) != 0)
-      throw std::runtime_error("Error writing to output file");
-    // increment the starting address by the number of bytes read
-    addr += data.size();
-  }
-  out_file.close();
-
+  // Stream all blocks directly into the output file.  The blocks are
+  // contiguous so they are read as a single range, which lets the
+  // transfer use all DMA channels of the device.
+  const uint64_t total_size = m_count * size;
+  XBU::ProgressBar progress_reporter("Reading device memory", 100, XBU::is_escape_codes_disabled(), std::cout);
+  XBU::Timer timer;
+  xrt_core::device_mem_read(device.get(), addr, total_size, m_outputFile,
+    [&progress_reporter, total_size](uint64_t bytes_done) {
+      progress_reporter.update(static_cast<unsigned int>(bytes_done * 100 / total_size));
+    });
+  const auto elapsed = timer.get_elapsed_time().count();
+  progress_reporter.finish(true, "Memory read complete");
+
+  const double mbytes = static_cast<double>(total_size) / (1024 * 1024);
+  std::cout << boost::format("Read %.1f MB in %.2f s (%.1f MB/s)\n") % mbytes % elapsed % (elapsed > 0 ? mbytes / elapsed : 0.0);
   std::cout << "Memory read succeeded" << std::endl;
 }
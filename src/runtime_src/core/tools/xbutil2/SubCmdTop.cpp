@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// ------ I N C L U D E   F I L E S -------------------------------------------
+// Local - Include Files
+#include "SubCmdTop.h"
+#include "core/common/error.h"
+#include "core/common/query_requests.h"
+#include "tools/common/EscapeCodes.h"
+#include "tools/common/Table2D.h"
+#include "tools/common/XBUtilitiesCore.h"
+#include "tools/common/XBUtilities.h"
+namespace XBU = XBUtilities;
+
+// 3rd Party Library - Include Files
+#include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+// System - Include Files
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+// ------ L O C A L   F U N C T I O N S ---------------------------------------
+namespace {
+
+namespace qr = xrt_core::query;
+using clock_type = std::chrono::steady_clock;
+
+// One reading of the device counters, rates are computed from two
+struct sample
+{
+  clock_type::time_point time;
+  qr::kds_cu_info::result_type cus;
+  qr::kds_cu_busy::result_type busy;
+  qr::kds_client_stat::result_type clients;
+  std::vector<std::pair<uint64_t, uint64_t>> dma;  // c2h, h2c bytes
+  uint64_t power_uw = 0;
+};
+
+// Queries missing on a platform are skipped so that the view shows
+// whatever the device supports
+static sample
+take_sample(const xrt_core::device* device)
+{
+  sample s;
+  s.time = clock_type::now();
+  s.cus = xrt_core::device_query_default<qr::kds_cu_info>(device, {});
+  s.busy = xrt_core::device_query_default<qr::kds_cu_busy>(device, {});
+  s.clients = xrt_core::device_query_default<qr::kds_client_stat>(device, {});
+  s.power_uw = xrt_core::device_query_default<qr::power_microwatts>(device, 0);
+
+  for (auto& line : xrt_core::device_query_default<qr::dma_threads_raw>(device, {})) {
+    std::istringstream iss(line);
+    uint64_t c2h = 0, h2c = 0;
+    iss >> c2h >> h2c;
+    s.dma.emplace_back(c2h, h2c);
+  }
+  return s;
+}
+
+static std::string
+rate(uint64_t prev, uint64_t curr, double secs)
+{
+  return std::to_string(static_cast<uint64_t>((curr >= prev ? curr - prev : 0) / secs));
+}
+
+static std::string
+cu_view(const sample& prev, const sample& curr, double secs)
+{
+  std::map<uint32_t, const qr::kds_cu_info::data_type*> prev_cus;
+  for (auto& cu : prev.cus)
+    prev_cus[cu.index] = &cu;
+
+  std::map<uint32_t, std::pair<uint64_t, uint64_t>> busy;  // prev, curr exec_ns
+  std::map<uint32_t, uint32_t> queued;
+  for (auto& cu : prev.busy)
+    busy[cu.index].first = cu.exec_ns;
+  for (auto& cu : curr.busy) {
+    busy[cu.index].second = cu.exec_ns;
+    queued[cu.index] = cu.queued;
+  }
+
+  const std::vector<Table2D::HeaderData> headers = {
+    {"Index", Table2D::Justification::left},
+    {"Name", Table2D::Justification::left},
+    {"Cmds/s", Table2D::Justification::right},
+    {"Busy", Table2D::Justification::right},
+    {"Queued", Table2D::Justification::right}
+  };
+  Table2D table(headers);
+
+  for (auto& cu : curr.cus) {
+    auto itr = prev_cus.find(cu.index);
+    auto usage = (itr == prev_cus.end()) ? cu.usages : itr->second->usages;
+
+    // Commands run concurrently on some CUs, busy time is capped
+    std::string busy_pct = "N/A";
+    auto bitr = busy.find(cu.index);
+    if (bitr != busy.end() && bitr->second.second >= bitr->second.first) {
+      auto pct = (bitr->second.second - bitr->second.first) / (secs * 1e7);
+      busy_pct = boost::str(boost::format("%.1f%%") % std::min(pct, 100.0));
+    }
+    auto qitr = queued.find(cu.index);
+
+    table.addEntry({std::to_string(cu.index), cu.name, rate(usage, cu.usages, secs), busy_pct,
+                    qitr == queued.end() ? "N/A" : std::to_string(qitr->second)});
+  }
+
+  return table.empty() ? "  No compute units\n" : table.toString("  ");
+}
+
+static std::string
+client_view(const sample& prev, const sample& curr, double secs)
+{
+  std::map<uint32_t, std::string> cu_names;
+  std::map<uint32_t, uint64_t> cu_completed;
+  for (auto& cu : curr.cus)
+    cu_names[cu.index] = cu.name;
+
+  // Completions in this interval of each context on each CU
+  std::map<std::tuple<uint32_t, uint32_t, uint32_t>, uint64_t> prev_completed;
+  for (auto& client : prev.clients)
+    for (auto& cu : client.cus)
+      prev_completed[{client.pid, client.hw_ctx, cu.index}] = cu.completed;
+
+  struct row { const qr::kds_client_stat::data_type* client; uint32_t cu; uint64_t done; };
+  std::vector<row> rows;
+  for (auto& client : curr.clients) {
+    for (auto& cu : client.cus) {
+      auto itr = prev_completed.find({client.pid, client.hw_ctx, cu.index});
+      auto base = (itr == prev_completed.end()) ? 0 : itr->second;
+      auto done = cu.completed >= base ? cu.completed - base : 0;
+      cu_completed[cu.index] += done;
+      rows.push_back({&client, cu.index, done});
+    }
+  }
+
+  const std::vector<Table2D::HeaderData> headers = {
+    {"PID", Table2D::Justification::left},
+    {"Context", Table2D::Justification::left},
+    {"Outstanding", Table2D::Justification::right},
+    {"CU", Table2D::Justification::left},
+    {"Cmds/s", Table2D::Justification::right},
+    {"CU Share", Table2D::Justification::right}
+  };
+  Table2D table(headers);
+
+  for (auto& r : rows) {
+    auto total = cu_completed[r.cu];
+    auto share = total ? boost::str(boost::format("%.1f%%") % (100.0 * r.done / total)) : "0.0%";
+    auto name = cu_names.count(r.cu) ? cu_names[r.cu] : std::to_string(r.cu);
+    table.addEntry({std::to_string(r.client->pid), std::to_string(r.client->hw_ctx),
+                    std::to_string(r.client->outstanding), name,
+                    std::to_string(static_cast<uint64_t>(r.done / secs)), share});
+  }
+
+  return table.empty() ? "  No active contexts\n" : table.toString("  ");
+}
+
+static std::string
+dma_view(const sample& prev, const sample& curr, double secs)
+{
+  const std::vector<Table2D::HeaderData> headers = {
+    {"Channel", Table2D::Justification::left},
+    {"H2C Bytes/s", Table2D::Justification::right},
+    {"C2H Bytes/s", Table2D::Justification::right}
+  };
+  Table2D table(headers);
+
+  for (size_t i = 0; i < curr.dma.size() && i < prev.dma.size(); ++i)
+    table.addEntry({std::to_string(i), rate(prev.dma[i].second, curr.dma[i].second, secs),
+                    rate(prev.dma[i].first, curr.dma[i].first, secs)});
+
+  return table.empty() ? "  No DMA channels\n" : table.toString("  ");
+}
+
+static std::string
+render(const std::string& bdf, const sample& prev, const sample& curr)
+{
+  auto secs = std::chrono::duration<double>(curr.time - prev.time).count();
+  std::stringstream ss;
+
+  ss << boost::format("Device [%s]  Interval: %.0f ms  Power: %.2f W\n\n")
+        % bdf % (secs * 1000) % (curr.power_uw / 1e6);
+  ss << "Compute Units\n" << cu_view(prev, curr, secs) << "\n";
+  ss << "Hardware Contexts\n" << client_view(prev, curr, secs) << "\n";
+  ss << "DMA\n" << dma_view(prev, curr, secs);
+  return ss.str();
+}
+
+} // namespace
+
+// ----- C L A S S   M E T H O D S -------------------------------------------
+
+SubCmdTop::SubCmdTop(bool _isHidden, bool _isDepricated, bool _isPreliminary)
+    : SubCmd("top",
+             "Live view of compute unit, process and DMA activity")
+    , m_device("")
+    , m_interval(100)
+    , m_iterations(0)
+    , m_help(false)
+{
+  const std::string longDescription = "Samples the given device at a fixed interval and shows, "
+                                      "for the last interval, the command rate, busy time and queue "
+                                      "depth of each compute unit, the commands each process context "
+                                      "completed on each compute unit, DMA throughput and power.";
+  setLongDescription(longDescription);
+  setExampleSyntax("");
+  setIsHidden(_isHidden);
+  setIsDeprecated(_isDepricated);
+  setIsPreliminary(_isPreliminary);
+
+  m_commonOptions.add_options()
+    ("device,d", boost::program_options::value<decltype(m_device)>(&m_device), "The Bus:Device.Function (e.g., 0000:d8:00.0) device of interest.")
+    ("interval,i", boost::program_options::value<decltype(m_interval)>(&m_interval), "Sampling interval in milliseconds (default 100)")
+    ("count,n", boost::program_options::value<decltype(m_iterations)>(&m_iterations), "Number of updates before exiting, 0 to run until interrupted (default 0)")
+    ("help", boost::program_options::bool_switch(&m_help), "Help to use this sub-command")
+  ;
+}
+
+void
+SubCmdTop::execute(const SubCmdOptions& _options) const
+{
+  XBU::verbose("SubCommand: top");
+
+  // Parse sub-command ...
+  po::variables_map vm;
+  process_arguments(vm, _options);
+
+  // Check to see if help was requested or no command was found
+  if (m_help) {
+    printHelp();
+    return;
+  }
+
+  if (m_interval == 0) {
+    std::cerr << "ERROR: Sampling interval must be greater than 0\n";
+    throw xrt_core::error(std::errc::operation_canceled);
+  }
+
+  // -- Now process the subcommand --------------------------------------------
+  // Find device of interest
+  std::shared_ptr<xrt_core::device> device;
+  try {
+    device = XBU::get_device(boost::algorithm::to_lower_copy(m_device), true /*inUserDomain*/);
+  } catch (const std::runtime_error& e) {
+    // Catch only the exceptions that we have generated earlier
+    std::cerr << boost::format("ERROR: %s\n") % e.what();
+    throw xrt_core::error(std::errc::operation_canceled);
+  }
+
+  const auto bdf = qr::pcie_bdf::to_string(xrt_core::device_query<qr::pcie_bdf>(device));
+  const auto interval = std::chrono::milliseconds(m_interval);
+  const EscapeCodes::cursor cursor;
+
+  auto prev = take_sample(device.get());
+  for (unsigned int i = 0; m_iterations == 0 || i < m_iterations; ++i) {
+    std::this_thread::sleep_until(prev.time + interval);
+    auto curr = take_sample(device.get());
+
+    // Frame is written in one go to avoid flicker
+    auto frame = render(bdf, prev, curr);
+    if (XBU::is_escape_codes_disabled())
+      frame += "\n";
+    else
+      frame = cursor.clear_screen() + frame;
+    std::cout << frame << std::flush;
+    prev = std::move(curr);
+  }
+}
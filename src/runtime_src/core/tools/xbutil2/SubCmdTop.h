@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#ifndef __SubCmdTop_h_
+#define __SubCmdTop_h_
+
+#include "tools/common/SubCmd.h"
+
+class SubCmdTop : public SubCmd {
+ public:
+  virtual void execute(const SubCmdOptions &_options) const;
+
+ public:
+  SubCmdTop(bool _isHidden, bool _isDepricated, bool _isPreliminary);
+
+ private:
+  std::string m_device;
+  unsigned int m_interval;
+  unsigned int m_iterations;
+  bool        m_help;
+};
+
+#endif
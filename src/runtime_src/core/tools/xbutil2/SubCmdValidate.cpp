@@ -21,6 +21,7 @@
 #include "tools/common/tests/TestSCVersion.h"
 #include "tools/common/tests/TestVerify.h"
 #include "tools/common/tests/TestDMA.h"
+#include "tools/common/tests/TestDMASweep.h"
 #include "tools/common/tests/TestIOPS.h"
 #include "tools/common/tests/TestBandwidthKernel.h"
 #include "tools/common/tests/Testp2p.h"
@@ -37,6 +38,7 @@
 #include "tools/common/tests/TestTCTOneColumn.h"
 #include "tools/common/tests/TestTCTAllColumn.h"
 #include "tools/common/tests/TestGemm.h"
+#include "tools/common/tests/TestNPUScaling.h"
 #include "tools/common/tests/TestNPUThroughput.h"
 #include "tools/common/tests/TestNPULatency.h"
 #include "tools/common/tests/TestCmdChainLatency.h"
@@ -52,6 +54,9 @@ namespace po = boost::program_options;
 // System - Include Files
 #include <algorithm>
 #include <filesystem>
+#include <future>
+#include <set>
+#include <sstream>
 #ifdef __linux__
 #include <sys/mman.h> //munmap
 #endif
@@ -93,6 +98,7 @@ std::vector<std::shared_ptr<TestRunner>> testSuite = {
   std::make_shared<TestSCVersion>(),
   std::make_shared<TestVerify>(),
   std::make_shared<TestDMA>(),
+  std::make_shared<TestDMASweep>(),
   std::make_shared<TestIOPS>(),
   std::make_shared<TestBandwidthKernel>(),
   std::make_shared<Testp2p>(),
@@ -111,6 +117,7 @@ std::vector<std::shared_ptr<TestRunner>> testSuite = {
   std::make_shared<TestGemm>(),
   std::make_shared<TestNPUThroughput>(),
   std::make_shared<TestNPULatency>(),
+  std::make_shared<TestNPUScaling>(),
   std::make_shared<TestCmdChainLatency>(),
   std::make_shared<TestCmdChainThroughput>()
 };
@@ -134,7 +141,7 @@ pretty_print_test_desc(const boost::property_tree::ptree& test, int& test_idx,
   }
   else if (XBU::getVerbose()) {
     std::string test_desc = boost::str(boost::format("Test %d [%s]") % ++test_idx % bdf);
-    XBU::message(boost::str(boost::format("%-26s: %s \n") % test_desc % test.get<std::string>("name")));
+    XBU::message(boost::str(boost::format("%-26s: %s \n") % test_desc % test.get<std::string>("name")), false, _ostream);
     XBU::message(boost::str(boost::format("    %-22s: %s\n") % "Description" % test.get<std::string>("description")), false, _ostream);
   }
 
@@ -295,38 +302,34 @@ get_platform_info(const std::shared_ptr<xrt_core::device>& device,
 static test_status
 run_test_suite_device( const std::shared_ptr<xrt_core::device>& device,
                        Report::SchemaVersion schemaVersion,
-                       std::vector<std::shared_ptr<TestRunner>>& testObjectsToRun,
-                       boost::property_tree::ptree& ptDevCollectionTestSuite)
+                       const std::vector<std::shared_ptr<TestRunner>>& testObjectsToRun,
+                       boost::property_tree::ptree& ptDevCollectionTestSuite,
+                       std::ostream& output,
+                       bool quiet)
 {
   boost::property_tree::ptree ptDeviceTestSuite;
   boost::property_tree::ptree ptDeviceInfo;
   test_status status = test_status::passed;
 
-  if (testObjectsToRun.empty())
-    throw std::runtime_error("No test given to validate against.");
-
-  get_platform_info(device, ptDeviceInfo, schemaVersion, std::cout);
-  std::cout << "-------------------------------------------------------------------------------" << std::endl;
+  get_platform_info(device, ptDeviceInfo, schemaVersion, output);
+  output << "-------------------------------------------------------------------------------" << std::endl;
 
   int test_idx = 0;
 
-  if (testObjectsToRun.size() == 1)
-    XBU::setVerbose(true);// setting verbose true for single_case.
-
   for (std::shared_ptr<TestRunner> testPtr : testObjectsToRun) {
     auto bdf = xrt_core::device_query<xrt_core::query::pcie_bdf>(device);
 
     boost::property_tree::ptree ptTest;
     try {
-      ptTest = testPtr->startTest(device);
+      ptTest = quiet ? testPtr->startTestQuiet(device) : testPtr->startTest(device);
     } catch (const std::exception&) {
       ptTest = testPtr->get_test_header();
       ptTest.put("status", test_token_failed);
     }
     ptDeviceTestSuite.push_back( std::make_pair("", ptTest) );
 
-    pretty_print_test_desc(ptTest, test_idx, std::cout, xrt_core::query::pcie_bdf::to_string(bdf));
-    pretty_print_test_run(ptTest, status, std::cout);
+    pretty_print_test_desc(ptTest, test_idx, output, xrt_core::query::pcie_bdf::to_string(bdf));
+    pretty_print_test_run(ptTest, status, output);
 
     // If a test fails, don't test the remaining ones
     if (status == test_status::failed) {
@@ -334,7 +337,7 @@ run_test_suite_device( const std::shared_ptr<xrt_core::device>& device,
     }
   }
 
-  print_status(status, std::cout);
+  print_status(status, output);
 
   ptDeviceInfo.put_child("tests", ptDeviceTestSuite);
   ptDevCollectionTestSuite.push_back( std::make_pair("", ptDeviceInfo) );
@@ -342,10 +345,70 @@ run_test_suite_device( const std::shared_ptr<xrt_core::device>& device,
   return status;
 }
 
+/*
+ * Collect the tests of interest from the tests available for a device
+ */
+static std::vector<std::shared_ptr<TestRunner>>
+collect_tests(std::vector<std::shared_ptr<TestRunner>>& testOptions,
+              const std::vector<std::string>& validatedTests,
+              const std::vector<std::string>& param,
+              const std::string& validateXclbinPath)
+{
+  std::vector<std::shared_ptr<TestRunner>> testObjectsToRun;
+  for (size_t index = 0; index < testOptions.size(); ++index) {
+    std::string testSuiteName = testOptions[index]->get_name();
+    // The all option enqueues all test suites not marked explicit
+    if (validatedTests[0] == "all") {
+      // Do not queue test suites that must be explicitly passed in
+      if (testOptions[index]->is_explicit())
+        continue;
+      testObjectsToRun.push_back(testOptions[index]);
+      // add custom param to the ptree if available
+      if (!param.empty() && boost::equals(param[0], testSuiteName)) {
+        testOptions[index]->set_param(param[1], param[2]);
+      }
+      if (!validateXclbinPath.empty())
+        testOptions[index]->set_xclbin_path(validateXclbinPath);
+      continue;
+    }
+
+    // The quick test option enqueues only the first three test suites
+    if (validatedTests[0] == "quick") {
+      testObjectsToRun.push_back(testOptions[index]);
+      if (!validateXclbinPath.empty())
+        testOptions[index]->set_xclbin_path(validateXclbinPath);
+      if (index == 3)
+        break;
+    }
+
+    // Logic for individually defined tests
+    // Enqueue the matching test suites to be executed
+    for (const auto & testName : validatedTests) {
+      if (boost::equals(testName, testSuiteName)) {
+        testObjectsToRun.push_back(testOptions[index]);
+        // add custom param to the ptree if available
+        if (!param.empty() && boost::equals(param[0], testSuiteName)) {
+          testOptions[index]->set_param(param[1], param[2]);
+        }
+        if (!validateXclbinPath.empty())
+          testOptions[index]->set_xclbin_path(validateXclbinPath);
+        break;
+      }
+    }
+  }
+
+  return testObjectsToRun;
+}
+
+// Devices are validated concurrently when more than one device is
+// tested.  The console output of each device is buffered and written
+// in device order, and the test data of each device is collected in
+// device order, so output does not depend on which device finishes
+// first.
 static bool
-run_tests_on_devices( std::shared_ptr<xrt_core::device> &device,
+run_tests_on_devices( const xrt_core::device_collection& devices,
                       Report::SchemaVersion schemaVersion,
-                      std::vector<std::shared_ptr<TestRunner>>& testObjectsToRun,
+                      const std::vector<std::vector<std::shared_ptr<TestRunner>>>& testObjectsToRun,
                       std::ostream & output)
 {
   // -- Root property tree
@@ -353,7 +416,37 @@ run_tests_on_devices( std::shared_ptr<xrt_core::device> &device,
 
   // -- Run the various tests and collect the test data
   boost::property_tree::ptree ptDeviceTested;
-  auto has_failures = (run_test_suite_device(device, schemaVersion, testObjectsToRun, ptDeviceTested) == test_status::failed);
+  bool has_failures = false;
+  if (devices.size() == 1) {
+    auto status = run_test_suite_device(devices.front(), schemaVersion, testObjectsToRun.front(), ptDeviceTested, std::cout, false);
+    has_failures = (status == test_status::failed);
+  }
+  else {
+    struct device_result
+    {
+      std::ostringstream console;
+      boost::property_tree::ptree pt;
+      std::future<test_status> status;
+    };
+    std::vector<device_result> results(devices.size());
+    for (size_t idx = 0; idx < devices.size(); ++idx) {
+      results[idx].status = std::async(std::launch::async, [&, idx] {
+        auto& result = results[idx];
+        return run_test_suite_device(devices[idx], schemaVersion, testObjectsToRun[idx], result.pt, result.console, true);
+      });
+    }
+
+    for (auto& result : results)
+      result.status.wait();
+
+    for (auto& result : results) {
+      std::cout << result.console.str();
+      if (result.status.get() == test_status::failed)
+        has_failures = true;
+      for (auto& pt : result.pt)
+        ptDeviceTested.push_back(pt);
+    }
+  }
 
   ptDevCollectionTestSuite.put_child("logical_devices", ptDeviceTested);
 
@@ -389,7 +482,8 @@ SubCmdValidate::getTestNameDescriptions(const bool addAdditionOptions) const
 
   const auto& configs = JSONConfigurable::parse_configuration_tree(m_commandConfig);
   const auto& testOptionsMap = JSONConfigurable::extract_subcmd_config<TestRunner, TestRunner>(testSuite, configs, getConfigName(), std::string("test"));
-  const std::string& deviceClass = XBU::get_device_class(m_device, true);
+  // All devices are assumed to be of a class, fall back to full test suite
+  const std::string& deviceClass = boost::iequals(m_device, "all") ? "" : XBU::get_device_class(m_device, true);
   const auto it = testOptionsMap.find(deviceClass);
   const std::vector<std::shared_ptr<TestRunner>>& testOptions = (it == testOptionsMap.end()) ? testSuite : it->second;
 
@@ -439,7 +533,7 @@ SubCmdValidate::SubCmdValidate(bool _isHidden, bool _isDepricated, bool _isPreli
   static const auto formatRunValues = XBU::create_suboption_list_map("", jsonOptions, common_tests);
 
   common_options.add_options()
-    ("device,d", boost::program_options::value<decltype(m_device)>(&m_device), "The Bus:Device.Function (e.g., 0000:d8:00.0) device of interest")
+    ("device,d", boost::program_options::value<decltype(m_device)>(&m_device), "The Bus:Device.Function (e.g., 0000:d8:00.0) device of interest, or 'all' to validate all devices")
     ("format,f", boost::program_options::value<decltype(m_format)>(&m_format), (std::string("Report output format. Valid values are:\n") + formatOptionValues).c_str() )
     ("output,o", boost::program_options::value<decltype(m_output)>(&m_output), "Direct the output to the given file")
     ("param", boost::program_options::value<decltype(m_param)>(&m_param), "Extended parameter for a given test. Format: <test-name>:<key>:<value>")
@@ -463,7 +557,21 @@ struct ExtendedKeysStruct {
 };
 
 static std::vector<ExtendedKeysStruct>  extendedKeysCollection = {
-  {"dma", "block-size", "Memory transfer size (bytes)"}
+  {"dma", "block-size", "Memory transfer size (bytes)"},
+  {"iops", "threads", "Comma separated list of host thread counts to sweep"},
+  {"iops", "queue-depth", "Comma separated list of in-flight commands per thread to sweep"},
+  {"iops", "commands", "Commands issued per thread for each sweep point"},
+  {"cmd-chain-latency", "chain-length", "Comma separated list of commands per chain to sweep"},
+  {"cmd-chain-latency", "iterations", "Chain executions for each sweep point"},
+  {"dma-sweep", "sizes", "Comma separated list of transfer sizes (bytes)"},
+  {"dma-sweep", "threads", "Comma separated list of host thread counts per direction"},
+  {"dma-sweep", "bo-types", "Comma separated list of normal, cacheable, host_only, p2p"},
+  {"dma-sweep", "directions", "Comma separated list of h2d, d2h, bidir"},
+  {"dma-sweep", "modes", "Comma separated list of sync, async"},
+  {"npu-scaling", "contexts", "Comma separated list of hardware context counts"},
+  {"npu-scaling", "threads", "Comma separated list of host thread counts per context"},
+  {"npu-scaling", "queue-depths", "Comma separated list of in-flight runs per thread"},
+  {"npu-scaling", "runs", "Runs per thread for each sweep point"}
 };
 
 std::string
@@ -602,10 +710,16 @@ SubCmdValidate::execute(const SubCmdOptions& _options) const
   }
 
 
-  // Find device of interest
-  std::shared_ptr<xrt_core::device> device;
+  // Find devices of interest
+  xrt_core::device_collection devices;
   try {
-    device = XBU::get_device(boost::algorithm::to_lower_copy(m_device), true /*inUserDomain*/);
+    if (boost::iequals(m_device, "all")) {
+      XBU::collect_devices(std::set<std::string>{"_all_"}, true /*inUserDomain*/, devices);
+      if (devices.empty())
+        throw std::runtime_error("No devices found");
+    }
+    else
+      devices.push_back(XBU::get_device(boost::algorithm::to_lower_copy(m_device), true /*inUserDomain*/));
   } catch (const std::runtime_error& e) {
     // Catch only the exceptions that we have generated earlier
     std::cerr << boost::format("ERROR: %s\n") % e.what();
@@ -614,59 +728,30 @@ SubCmdValidate::execute(const SubCmdOptions& _options) const
 
   const auto& configs = JSONConfigurable::parse_configuration_tree(m_commandConfig);
   auto testOptionsMap = JSONConfigurable::extract_subcmd_config<TestRunner, TestRunner>(testSuite, configs, getConfigName(), std::string("test"));
-  const std::string& deviceClass = XBU::get_device_class(m_device, true);
-  auto it = testOptionsMap.find(deviceClass);
-  if (it == testOptionsMap.end())
-    XBU::throw_cancel(boost::format("Invalid device class %s. Device: %s") % deviceClass % m_device);
-  std::vector<std::shared_ptr<TestRunner>>& testOptions = it->second;
-
-  // Collect all of the tests of interests
-  std::vector<std::shared_ptr<TestRunner>> testObjectsToRun;
-  for (size_t index = 0; index < testOptions.size(); ++index) {
-    std::string testSuiteName = testOptions[index]->get_name();
-    // The all option enqueues all test suites not marked explicit
-    if (validatedTests[0] == "all") {
-      // Do not queue test suites that must be explicitly passed in
-      if (testOptions[index]->is_explicit())
-        continue;
-      testObjectsToRun.push_back(testOptions[index]);
-      // add custom param to the ptree if available
-      if (!param.empty() && boost::equals(param[0], testSuiteName)) {
-        testOptions[index]->set_param(param[1], param[2]);
-      }
-      if (!validateXclbinPath.empty())
-        testOptions[index]->set_xclbin_path(validateXclbinPath);
-      continue;
-    }
 
-    // The quick test option enqueues only the first three test suites
-    if (validatedTests[0] == "quick") {
-      testObjectsToRun.push_back(testOptions[index]);
-      if (!validateXclbinPath.empty())
-        testOptions[index]->set_xclbin_path(validateXclbinPath);
-      if (index == 3)
-        break;
-    }
-
-    // Logic for individually defined tests
-    // Enqueue the matching test suites to be executed
-    for (const auto & testName : validatedTests) {
-      if (boost::equals(testName, testSuiteName)) {
-        testObjectsToRun.push_back(testOptions[index]);
-        // add custom param to the ptree if available
-        if (!param.empty() && boost::equals(param[0], testSuiteName)) {
-          testOptions[index]->set_param(param[1], param[2]);
-        }
-        if (!validateXclbinPath.empty())
-          testOptions[index]->set_xclbin_path(validateXclbinPath);
-        break;
-      }
-    }
+  // Collect the tests of interest for each device
+  std::vector<std::vector<std::shared_ptr<TestRunner>>> testObjectsToRun;
+  for (const auto& device : devices) {
+    const auto bdf = (devices.size() == 1)
+      ? m_device
+      : xrt_core::query::pcie_bdf::to_string(xrt_core::device_query<xrt_core::query::pcie_bdf>(device));
+    const std::string& deviceClass = XBU::get_device_class(bdf, true);
+    auto it = testOptionsMap.find(deviceClass);
+    if (it == testOptionsMap.end())
+      XBU::throw_cancel(boost::format("Invalid device class %s. Device: %s") % deviceClass % bdf);
+
+    testObjectsToRun.push_back(collect_tests(it->second, validatedTests, param, validateXclbinPath));
+    if (testObjectsToRun.back().empty())
+      throw std::runtime_error("No test given to validate against.");
   }
 
+  // Setting verbose true for single_case.
+  if (testObjectsToRun.front().size() == 1)
+    XBU::setVerbose(true);
+
   // -- Run the tests --------------------------------------------------
   std::ostringstream oSchemaOutput;
-  bool has_failures = run_tests_on_devices(device, schemaVersion, testObjectsToRun, oSchemaOutput);
+  bool has_failures = run_tests_on_devices(devices, schemaVersion, testObjectsToRun, oSchemaOutput);
 
   // -- Write output file ----------------------------------------------
   if (!m_output.empty()) {
@@ -8,6 +8,7 @@
 #include "SubCmdExamine.h"
 #include "SubCmdProgram.h"
 #include "SubCmdReset.h"
+#include "SubCmdTop.h"
 #include "SubCmdValidate.h"
 
 // Supporting tools
@@ -44,7 +45,7 @@ R"(
     }]
   },{
     "validate": [{
-      "test": ["aux-connection", "pcie-link", "sc-version", "verify", "dma", "iops", "mem-bw", "p2p", "m2m", "hostmem-bw", "bist", "vcu", "aie", "ps-aie", "ps-pl-verify", "ps-verify", "ps-iops"]
+      "test": ["aux-connection", "pcie-link", "sc-version", "verify", "dma", "dma-sweep", "iops", "mem-bw", "p2p", "m2m", "hostmem-bw", "bist", "vcu", "aie", "ps-aie", "ps-pl-verify", "ps-verify", "ps-iops"]
     }]
   },{
     "reset": [{}]
@@ -66,7 +67,7 @@ R"(
     }]
   },{
     "validate": [{
-      "test": ["latency", "throughput", "cmd-chain-latency", "cmd-chain-throughput", "df-bw", "tct-one-col", "tct-all-col", "gemm"]
+      "test": ["latency", "throughput", "npu-scaling", "cmd-chain-latency", "cmd-chain-throughput", "df-bw", "tct-one-col", "tct-all-col", "gemm"]
     }]
   }]
 }]
@@ -89,6 +90,7 @@ int main( int argc, char** argv )
     subCommands.emplace_back(std::make_shared<  SubCmdProgram  >(false, false, false));
     subCommands.emplace_back(std::make_shared<    SubCmdReset  >(false, false, false));
     subCommands.emplace_back(std::make_shared< SubCmdConfigure >(false, false, false, configTree));
+    subCommands.emplace_back(std::make_shared<      SubCmdTop  >(false, false, false));
 
     // Parse sub commands from json files
     populateSubCommandsFromJSON(subCommands, executable);
@@ -52,6 +52,7 @@
 #define SCRATCH_MODE                (1<<17)
 #define ECHO_MODE                   (1<<18)
 #define DMSG_ENABLE                 (1<<19)
+#define CU_TIMESTAMP                (1<<20)
 
 inline void
 exit(int32_t val)
@@ -143,10 +144,12 @@ static size_type num_cus         = 0;    // actual number of cus
 #define XGQ_CU_CMD_LOW_ADDR        0x10
 #define XGQ_CU_CMD_HIGH_ADDR       0x14
 #define XGQ_CU_CMD_SLOT_SZ_OFFSET  0x18
+#define XGQ_CU_INTR_CYCLES_OFFSET  0xC
 
 
 #define XGQ_CU_IDX(features)    (features & MASK_BIT_32(12))
-#define XGQ_IP_CTRL(features)   ((features & MASK_BIT_32(8)) >> 16)
+#define XGQ_IP_CTRL(features)   ((features >> 16) & MASK_BIT_32(8))
+#define XGQ_INTR_COUNT(features) ((features >> 12) & MASK_BIT_32(8))
 #define XGQ_NUM_CUS(features)   ((features & MASK_BIT_32(13)))
 #define XGQ_OFFSET(xgq)         (xgq->xq_header_addr-ERT_CQ_BASE_ADDR)
 
@@ -186,6 +189,9 @@ static value_type dmsg                   = 0;
  */
 value_type echo                          = 0;
 
+/* Stamp CU start and done cycles into CU command completions */
+static value_type cu_ts                  = 0;
+
 static value_type cmd_queue_mode         = 0;
 
 static value_type scratch_mode           = 0;
@@ -306,7 +312,7 @@ setup_cu_queue()
          cu_xgq->xgq_id = cu_idx;
          cu_xgq->csr_reg = STATUS_REGISTER_ADDR[cu_idx>>5];
 
-         xgq_cu_init(cu_xgq, xgq, cu);
+         xgq_cu_init(cu_xgq, xgq, cu, cu_ts);
       }
     }
   }
@@ -361,6 +367,8 @@ configure_mb(struct sched_cmd *cmd)
 
   echo = (features & ECHO_MODE) != 0;
 
+  cu_ts = (features & CU_TIMESTAMP) != 0;
+
   cmd_queue_mode = (features & CMD_QUEUE_MODE) != 0;
 
   scratch_mode = (features & SCRATCH_MODE) != 0;
@@ -377,6 +385,7 @@ configure_mb(struct sched_cmd *cmd)
   resp_cmd.i2e = 0;
   resp_cmd.cui = 0;
   resp_cmd.ob = 0;
+  resp_cmd.ts = 1;
 
   resp_cmd.rcode = ret;
    
@@ -437,6 +446,8 @@ save_cfg_cu(struct sched_cmd *cmd)
 
 
   cu_set_addr(sched_cu, (((uint64_t)addr_hi) << 32) + addr_lo);
+  cu_set_shadow(sched_cu, (cu->ip_ctrl & XGQ_IP_CTRL_ARG_SHADOW) &&
+                ((cu->ip_ctrl & ~XGQ_IP_CTRL_ARG_SHADOW) == AP_CTRL_CHAIN));
 
   CTRL_DEBUGF(" cu->ip_ctrl %d \r\n", cu->ip_ctrl);
   CTRL_DEBUGF(" cu->slot_size %d \r\n", cu->slot_size);
@@ -494,6 +505,32 @@ query_cu(struct sched_cmd *cmd)
   return ret;
 }
 
+static int32_t
+cu_intr_mod(struct sched_cmd *cmd)
+{
+  addr_type queue_addr = cmd->cc_addr;
+  value_type features = read_reg(queue_addr+XGQ_CMD_FEATURE_OFFSET), cu_idx = XGQ_CU_IDX(features);
+  struct xgq_com_queue_entry resp_cmd = {0};
+  int ret = 0;
+
+  // Only per CU XGQs have their own completion interrupt
+  if (cu_idx >= num_cus || flatten_queue)
+    ret = -EINVAL;
+  else
+    xgq_cu_set_intr_mod(&cu_xgqs[cu_idx], XGQ_INTR_COUNT(features),
+                        read_reg(queue_addr+XGQ_CU_INTR_CYCLES_OFFSET));
+
+#ifdef XGQ_CMD_DEBUG
+  resp_cmd.hdr.cid = cmd->cc_header.hdr.cid;
+#endif
+  resp_cmd.rcode = ret;
+
+  xgq_ctrl_response(&ctrl_xgq, &resp_cmd, sizeof(struct xgq_com_queue_entry));
+
+  CTRL_DEBUGF("<------- cu_intr_mod cu_idx %d ret %d\r\n", cu_idx, ret);
+  return ret;
+}
+
 static inline int32_t
 get_clk_counter(struct sched_cmd *cmd)
 {
@@ -710,6 +747,9 @@ process_ctrl_command()
   case XGQ_CMD_OP_QUERY_CU:
     ret = query_cu(cmd);
     break;
+  case XGQ_CMD_OP_CU_INTR_MOD:
+    ret = cu_intr_mod(cmd);
+    break;
   case XGQ_CMD_OP_CLOCK_CALIB:
     ret = get_clk_counter(cmd);
     break;
@@ -785,11 +825,19 @@ _scheduler_loop()
 #endif
     while(!process_ctrl_command());
     if (cfg_complete) {
+      // One CSR write per 32 CUs for all completions of this pass
+      bitmask_type intr_mask[4] = {0};
+
       for (slot_idx=0; slot_idx<num_cus; ++slot_idx) {
         while(!xgq_cu_process(&cu_xgqs[slot_idx])) {
           continue;
         }
+        if (xgq_cu_flush(&cu_xgqs[slot_idx]))
+          intr_mask[slot_idx>>5] |= (1 << (slot_idx & 0x1F));
       }
+      for (size_type w=0; w<4; ++w)
+        if (intr_mask[w])
+          write_reg(STATUS_REGISTER_ADDR[w], intr_mask[w]);
     }
   } // while
 }
@@ -19,10 +19,18 @@
 #include "sched_cmd.h"
 #include "sched_print.h"
 
+/* Number of leading CU argument registers shadowed per CU. */
+#define SCHED_CU_SHADOW_REGS	16
+
 /* One CU. */
 struct sched_cu {
 	uint64_t cu_addr;
 	uint32_t cu_status;
+	/* Skip writing unchanged arguments on start, see cu_shadow_match(). */
+	uint32_t cu_shadow_enabled;
+	/* Bitmask of valid cu_shadow entries. */
+	uint32_t cu_shadow_valid;
+	uint32_t cu_shadow[SCHED_CU_SHADOW_REGS];
 };
 
 /* CU status bits in header. */
@@ -65,6 +73,33 @@ static inline int cu_has_status(struct sched_cu *cu, uint32_t flags)
 static inline void cu_set_addr(struct sched_cu *cu, uint64_t addr)
 {
 	cu->cu_addr = addr;
+	cu->cu_shadow_valid = 0;
+}
+
+static inline void cu_set_shadow(struct sched_cu *cu, uint32_t enable)
+{
+	cu->cu_shadow_enabled = enable;
+	cu->cu_shadow_valid = 0;
+}
+
+/*
+ * Record argument register value written to CU and return true if the
+ * register already holds this value, in which case the write could be
+ * skipped. An ap_ctrl_chain CU keeps its argument registers across
+ * starts, so back to back commands only need to write what changed.
+ */
+static inline int cu_shadow_match(struct sched_cu *cu, uint32_t idx, uint32_t val)
+{
+	if (idx >= SCHED_CU_SHADOW_REGS)
+		return 0;
+
+	if (cu->cu_shadow_enabled && (cu->cu_shadow_valid & (1 << idx)) &&
+	    cu->cu_shadow[idx] == val)
+		return 1;
+
+	cu->cu_shadow[idx] = val;
+	cu->cu_shadow_valid |= (1 << idx);
+	return 0;
 }
 
 /* Read status from HW and cache them. Expensive! */
@@ -87,6 +122,7 @@ static inline void cu_init(struct sched_cu *cu, uint64_t cu_addr)
 {
 	cu->cu_addr = cu_addr;
 	cu->cu_status = 0;
+	cu->cu_shadow_valid = 0;
 	cu_load_status(cu);
 	/* TODO: assert CU must be idle. */
 }
@@ -106,8 +142,13 @@ static inline int cu_start(struct sched_cu *cu, struct sched_cmd *cu_cmd)
 		return -EINVAL;
 
 	/* Save CU args. */
-	for (i = 0; i < arg_sz; i += sizeof(uint32_t))
-		reg_write(dst + i, reg_read(src + i));
+	for (i = 0; i < arg_sz; i += sizeof(uint32_t)) {
+		uint32_t val = reg_read(src + i);
+
+		if (cu_shadow_match(cu, i / sizeof(uint32_t), val))
+			continue;
+		reg_write(dst + i, val);
+	}
 
 	/* Kick off CU. */
 	reg_write(cu->cu_addr, SCHED_AP_START);
@@ -136,8 +177,15 @@ static inline int cu_init_kv(struct sched_cu *cu, struct sched_cmd *cu_cmd)
      * reg_read(src + i) -> offset
      * reg_read(src + i + sizeof(uint32_t)) -> value
      */
-	for (i = 0; i < arg_sz; i += (2 * sizeof(uint32_t)))
-		reg_write(dst + reg_read(src + i), reg_read(src + i + sizeof(uint32_t)));
+	for (i = 0; i < arg_sz; i += (2 * sizeof(uint32_t))) {
+		uint32_t off = reg_read(src + i);
+		uint32_t val = reg_read(src + i + sizeof(uint32_t));
+
+		reg_write(dst + off, val);
+		/* Keep shadow in sync, the register now holds val. */
+		if (off >= SCHED_CU_ARG_OFFSET && !(off & (sizeof(uint32_t) - 1)))
+			(void)cu_shadow_match(cu, (off - SCHED_CU_ARG_OFFSET) / sizeof(uint32_t), val);
+	}
 
 	return 0;
 }
@@ -250,6 +250,25 @@ static bitset_type slot_submitted;
 
 // Bitmask for interrupt enabled CUs.  (0) no interrupt (1) enabled
 static bitset_type cu_interrupt_mask;
+
+// Fixed sized map from cu_idx -> bitmask of queued slots waiting for CU.
+// A CU that completes is restarted right away with the lowest queued
+// slot without waiting for the next pass over all command slots.
+static bitset_type cu_ready[max_cus];
+
+// Bitmask of CUs with at least one queued slot
+static bitset_type cu_ready_mask;
+
+// Scheduler counters, reported by cu_stat
+// Number of passes over the command slots
+static value_type sched_passes;
+
+// Number of slot visits in a pass that found nothing to do
+static value_type sched_idle_visits;
+
+// Fixed sized map from cu_idx -> number of starts issued directly on
+// completion of the previous command (no idle gap)
+static size_type cu_chained_starts[max_cus];
 #ifndef ERT_HW_EMU
 /**
  * Utility to read a 32 bit value from any axi-lite peripheral
@@ -476,11 +495,16 @@ setup()
 
   cu_status.reset();
   slot_submitted.reset();
+  cu_ready_mask.reset();
+  sched_passes = 0;
+  sched_idle_visits = 0;
 
   // Initialize cu_slot_usage
   for (size_type i=0; i<num_cus; ++i) {
     cu_slot_usage[i] = no_index;
     cu_usage[i] = 0;
+    cu_ready[i].reset();
+    cu_chained_starts[i] = 0;
   }
 
   // Set slot size (4K)
@@ -738,6 +762,53 @@ start_cu(size_type slot_idx)
   return cu_idx;
 }
 
+/**
+ * Start a CU with the lowest queued slot that waits for it
+ *
+ * Must be called with interrupts disabled or from interrupt handler.
+ *
+ * @param cu_idx
+ *  Index of CU to start
+ * @return
+ *  True if a slot was transitioned from queued to running
+ */
+inline bool
+start_ready_cu(size_type cu_idx)
+{
+  auto& ready = cu_ready[cu_idx];
+  size_type slot_idx = ready._Find_first();
+  if (slot_idx >= ready.size())
+    return false;
+
+  if (start_cu(slot_idx) == no_index)
+    return false;
+
+  ready.reset(slot_idx);
+  if (ready.none())
+    cu_ready_mask.reset(cu_idx);
+
+  auto& slot = command_slots[slot_idx];
+  slot.header_value |= 0x1;       // running (0x2->0x3)
+  ERT_DEBUGF("slot(%d) [queued -> running]\n",slot_idx);
+
+#ifdef DEBUG_SLOT_STATE
+  write_reg(slot.slot_addr,slot.header_value);
+#endif
+  return true;
+}
+
+/**
+ * Restart a CU that just completed if it has queued slots
+ *
+ * Must be called with interrupts disabled or from interrupt handler.
+ */
+inline void
+chain_cu(size_type cu_idx)
+{
+  if (cu_ready_mask[cu_idx] && start_ready_cu(cu_idx))
+    ++cu_chained_starts[cu_idx];
+}
+
 /**
  * Check command status
  *
@@ -900,6 +971,9 @@ exit_mb(size_type slot_idx)
 // [#numcus]  : cu execution stats (number of executions)
 // [#numcus]  : cu status (1: running, 0: idle)
 // [#slots]   : command queue slot status
+// [1  ]      : number of scheduler passes over command slots
+// [1  ]      : number of slot visits that found nothing to do
+// [#numcus]  : cu starts chained to completion of previous command
 static bool
 cu_stat(size_type slot_idx)
 {
@@ -942,6 +1016,14 @@ cu_stat(size_type slot_idx)
     write_reg(slot.slot_addr + (pkt_idx++ << 2),s.header_value & 0XF);
   }
 
+  // scheduler counters
+  if (pkt_idx < max_idx)
+    write_reg(slot.slot_addr + (pkt_idx++ << 2),sched_passes);
+  if (pkt_idx < max_idx)
+    write_reg(slot.slot_addr + (pkt_idx++ << 2),sched_idle_visits);
+  for (size_type i=0; pkt_idx<max_idx && i<num_cus; ++i)
+    write_reg(slot.slot_addr + (pkt_idx++ << 2),cu_chained_starts[i]);
+
 #if 0
   // payload count
   auto mask = 0X7FF << 12;  // [22-12]
@@ -974,6 +1056,7 @@ abort_mb(size_type slot_idx)
   check_command(sidx,cu_idx);
   cu_slot_usage[cu_idx] = no_index;
   cu_status[cu_idx] = !cu_status[cu_idx];
+  chain_cu(cu_idx);
   notify_host(slot_idx);
   return true;
 }
@@ -1052,6 +1135,12 @@ new_to_queued(size_type slot_idx)
   slot.regmap_size = regmap_size(slot.header_value);
   slot.header_value = (slot.header_value & ~0xF) | 0x2; // queued
 
+  {
+    disable_interrupt_guard guard;
+    cu_ready[slot.cu_idx].set(slot_idx);
+    cu_ready_mask.set(slot.cu_idx);
+  }
+
   ERT_DEBUGF("slot(%d) [new -> queued]\n",slot_idx);
 
 #ifdef DEBUG_SLOT_STATE
@@ -1071,21 +1160,20 @@ inline bool
 queued_to_running(size_type slot_idx)
 {
   auto& slot = command_slots[slot_idx];
-  ERT_ASSERT((slot.header_value & 0xF)==0x2,"slot is not queued\n");
 
   // disable CU interrupts while starting command
   disable_interrupt_guard guard;
-  // queued command, start if cu is ready
-  if (start_cu(slot_idx) == no_index)
-    return false;
 
-  slot.header_value |= 0x1;       // running (0x2->0x3)
-  ERT_DEBUGF("slot(%d) [queued -> running]\n",slot_idx);
+  // slot may have been started by interrupt handler on completion
+  // of previous command on same CU
+  if ((slot.header_value & 0xF) != 0x2)
+    return true;
 
-#ifdef DEBUG_SLOT_STATE
-  write_reg(slot.slot_addr,slot.header_value);
-#endif
-  return true;
+  // queued command, start lowest queued slot if cu is ready
+  if (!start_ready_cu(slot.cu_idx))
+    return false;
+
+  return (slot.header_value & 0xF) == 0x3;
 }
 
 /**
@@ -1104,6 +1192,7 @@ running_to_free(size_type slot_idx)
   if (!check_cu(slot.cu_idx))
     return false;
 
+  auto cu_idx = slot.cu_idx;
   notify_host(slot_idx);
   slot.header_value = (slot.header_value & ~0xF) | 0x4; // free
   ERT_DEBUGF("slot(%d) [running -> free]\n",slot_idx);
@@ -1111,6 +1200,10 @@ running_to_free(size_type slot_idx)
 #ifdef DEBUG_SLOT_STATE
   write_reg(slot.slot_addr,slot.header_value);
 #endif
+
+  // start next command for this cu, no need to wait for next pass
+  disable_interrupt_guard guard;
+  chain_cu(cu_idx);
   return true;
 }
 static inline void
@@ -1212,6 +1305,7 @@ scheduler_loop()
   setup();
 
   while (1) {
+    ++sched_passes;
     for (size_type slot_idx=0; slot_idx<num_slots; ++slot_idx) {
       auto& slot = command_slots[slot_idx];
 
@@ -1273,9 +1367,11 @@ scheduler_loop()
         continue;
       }
 
-      if (!cq_status_enabled && ((slot.header_value & 0xF) == 0x4)) { // free
-        if (!free_to_new(slot_idx))
+      if ((slot.header_value & 0xF) == 0x4) { // free
+        if (cq_status_enabled || !free_to_new(slot_idx)) {
+          ++sched_idle_visits;
           continue;
+        }
       }
 
       if ((slot.header_value & 0xF) == 0x1) { // new
@@ -1289,8 +1385,10 @@ scheduler_loop()
       }
 
       if (!cu_interrupt_enabled && ((slot.header_value & 0xF) == 0x3)) { // running
-        if (!running_to_free(slot_idx))
+        if (!running_to_free(slot_idx)) {
+          ++sched_idle_visits;
           continue;
+        }
       }
     }
   } // while
@@ -1319,6 +1417,7 @@ cu_interrupt_handler()
           check_command(cu_slot_usage[cu_idx],cu_idx);
           cu_slot_usage[cu_idx] = no_index; // reset slot index
           cu_status[cu_idx] = !cu_status[cu_idx]; // toggle status of completed cus
+          chain_cu(cu_idx); // start next queued command for this cu
         }
       }
     }
@@ -1346,6 +1445,7 @@ cu_interrupt_handler()
     // Reset cdma (1) read status to clear it, (2) reset isr at base + 0xC
     ERT_UNUSED volatile auto val = read_reg(cu_idx_to_addr(cu_idx));
     write_reg(cu_idx_to_addr(cu_idx) + 0xC,1);
+    chain_cu(cu_idx); // start next queued copy after cdma reset
   }
 
   // Acknowledge interrupts
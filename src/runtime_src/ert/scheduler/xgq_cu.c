@@ -13,6 +13,7 @@
  * License for the specific language governing permissions and limitations
  * under the License.
  */
+#include "core/include/ert.h"
 #include "xgq_mb_plat.h"
 #include "xgq_impl.h"
 #include "xgq_cu.h"
@@ -27,29 +28,115 @@ static inline void xgq_cu_interrupt_trigger(struct xgq_cu *xc, uint32_t xgq_id)
 	reg_write(xc->csr_reg, (1<<xgq_id));
 }
 
-inline void xgq_cu_init(struct xgq_cu *xc, struct xgq *q, struct sched_cu *cu)
+static inline uint32_t xgq_cu_clk(void)
+{
+	return reg_read(ERT_CLK_COUNTER_ADDR);
+}
+
+inline void xgq_cu_init(struct xgq_cu *xc, struct xgq *q, struct sched_cu *cu, uint32_t ts)
 {
 	struct sched_cmd *cmd = &xc->xc_cmd;
 
 	xc->xc_q = q;
 	xc->xc_cu = cu;
 	xc->xc_cmd_running = 0;
+	xc->xc_cq_pending = 0;
+	xc->xc_ts = ts;
+	xc->xc_ts_head = 0;
+	xc->xc_ts_tail = 0;
+	xc->xc_intr_count = 0;
+	xc->xc_intr_cycles = 0;
+	xc->xc_intr_pending = 0;
 	cmd_set_addr(cmd, 0);
 	cmd_clear_header(cmd, 0);
     cu_verify_ctrl(cu, 0xC, "CU initial status is not idle/ready");
 	cu_set_status(cu, SCHED_AP_IDLE);
 }
 
-static inline void xgq_cu_complete_cmd(struct xgq_cu *xc, int err)
+inline void xgq_cu_set_intr_mod(struct xgq_cu *xc, uint32_t count, uint32_t cycles)
 {
-	uint64_t slot_addr;
+	xc->xc_intr_count = count;
+	xc->xc_intr_cycles = cycles;
+}
 
-	while(xgq_produce(xc->xc_q, &slot_addr))
-		continue;
+static inline void xgq_cu_publish(struct xgq_cu *xc)
+{
+	if (!xc->xc_cq_pending)
+		return;
 
 	xgq_notify_peer_produced(xc->xc_q);
-	xgq_cu_interrupt_trigger(xc, xc->xgq_id);
+	if (!xc->xc_intr_pending && xc->xc_intr_count > 1)
+		xc->xc_intr_first = xgq_cu_clk();
+	xc->xc_intr_pending += xc->xc_cq_pending;
+	xc->xc_cq_pending = 0;
+}
+
+/*
+ * Publish pending completions to host. Return non zero if host needs to
+ * be interrupted. Caller could merge interrupts of several CUs into one
+ * CSR write.
+ *
+ * With moderation the interrupt is held back while the CU is still busy,
+ * until enough completions are pending or the oldest waited long enough.
+ * This is called every scheduler pass, also when nothing completed, so
+ * the time limit is honored.
+ */
+inline int xgq_cu_flush(struct xgq_cu *xc)
+{
+	xgq_cu_publish(xc);
+	if (!xc->xc_intr_pending)
+		return 0;
+
+	if (xc->xc_intr_count > 1 && xc->xc_cmd_running &&
+	    xc->xc_intr_pending < xc->xc_intr_count &&
+	    xgq_cu_clk() - xc->xc_intr_first < xc->xc_intr_cycles)
+		return 0;
+
+	xc->xc_intr_pending = 0;
+	return 1;
+}
 
+/*
+ * Completions are published to host by xgq_cu_flush() once all commands
+ * that could be processed in this pass are done. This saves a producer
+ * pointer and a CSR write per command.
+ *
+ * The entry is only written when timestamps are enabled, otherwise host
+ * does not look at it. A command that failed to start has no start stamp.
+ */
+static inline void xgq_cu_complete_cmd(struct xgq_cu *xc, int err, int started)
+{
+	struct xgq_cmd_resp_cuidx resp = {0};
+	uint64_t slot_addr;
+
+	if (xc->xc_ts && started) {
+		resp.cu_done = xgq_cu_clk();
+		resp.cu_start = xc->xc_ts_start[xc->xc_ts_tail];
+		xc->xc_ts_tail = (xc->xc_ts_tail + 1) & (XGQ_CU_MAX_RUNNING - 1);
+		resp.hdr.specific = 1;
+	}
+
+	while(xgq_produce(xc->xc_q, &slot_addr)) {
+		/*
+		 * CQ is full, host can only make room after it sees them.
+		 * Interrupt regardless of moderation.
+		 */
+		xgq_cu_publish(xc);
+		if (xc->xc_intr_pending) {
+			xc->xc_intr_pending = 0;
+			xgq_cu_interrupt_trigger(xc, xc->xgq_id);
+		}
+	}
+
+	if (xc->xc_ts) {
+		resp.rcode = err;
+		reg_write(slot_addr, resp.hdr.header[0]);
+		reg_write(slot_addr + 4, resp.cu_start);
+		reg_write(slot_addr + 8, resp.cu_done);
+		reg_write(slot_addr + 12, resp.rcode);
+	}
+
+	xc->xc_cq_pending++;
 	xc->xc_cmd_running--;
 }
 
@@ -99,7 +186,7 @@ inline int xgq_cu_process(struct xgq_cu *xc)
 #else
 			cu_done(cu);
 #endif
-			xgq_cu_complete_cmd(xc, 0);
+			xgq_cu_complete_cmd(xc, 0, 1);
 		}
 
 	}
@@ -149,9 +236,13 @@ inline int xgq_cu_process(struct xgq_cu *xc)
 	xgq_notify_peer_consumed(q);
 	cmd_clear_header(cmd, 0);
 
-	if (likely(!rc))
+	if (likely(!rc)) {
+		if (xc->xc_ts) {
+			xc->xc_ts_start[xc->xc_ts_head] = xgq_cu_clk();
+			xc->xc_ts_head = (xc->xc_ts_head + 1) & (XGQ_CU_MAX_RUNNING - 1);
+		}
 		xc->xc_cmd_running++;
-	else
-		xgq_cu_complete_cmd(xc, rc);
+	} else
+		xgq_cu_complete_cmd(xc, rc, 0);
 	return rc;
 }
@@ -20,6 +20,9 @@
 #include "sched_cu.h"
 #include "sched_cmd.h"
 
+/* Commands a CU may have started but not completed, power of 2. */
+#define XGQ_CU_MAX_RUNNING	8
+
 /*
  * One XGQ for every CU.
  * Used when we have enough space on CQ to alloc per CU XGQ.
@@ -29,12 +32,31 @@ struct xgq_cu {
 	struct sched_cu *xc_cu;
 	struct sched_cmd xc_cmd;
 	uint32_t xc_cmd_running;
+	/* Completions produced but not yet published to host. */
+	uint32_t xc_cq_pending;
+	/*
+	 * Stamp CU start and done into completions, see
+	 * struct xgq_cmd_resp_cuidx. CUs complete in start order, so the
+	 * start stamps of running commands are kept in a FIFO.
+	 */
+	uint32_t xc_ts;
+	uint32_t xc_ts_head;
+	uint32_t xc_ts_tail;
+	uint32_t xc_ts_start[XGQ_CU_MAX_RUNNING];
+	/* Interrupt moderation, see struct xgq_cmd_cu_intr_mod. */
+	uint32_t xc_intr_count;
+	uint32_t xc_intr_cycles;
+	/* Completions published but not yet signalled, and since when. */
+	uint32_t xc_intr_pending;
+	uint32_t xc_intr_first;
 	uint32_t offset;
 	uint32_t xgq_id;
 	uint32_t csr_reg;
 };
 
-extern void xgq_cu_init(struct xgq_cu *xc, struct xgq *q, struct sched_cu *cu);
+extern void xgq_cu_init(struct xgq_cu *xc, struct xgq *q, struct sched_cu *cu, uint32_t ts);
 extern int xgq_cu_process(struct xgq_cu *xc);
+extern int xgq_cu_flush(struct xgq_cu *xc);
+extern void xgq_cu_set_intr_mod(struct xgq_cu *xc, uint32_t count, uint32_t cycles);
 
 #endif /* __XGQ_CU_H__ */
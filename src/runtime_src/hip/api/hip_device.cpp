@@ -5,6 +5,7 @@
 
 #include "hip/core/common.h"
 #include "hip/core/device.h"
+#include "hip/core/stream.h"
 
 #include <cstring>
 #include <mutex>
@@ -263,3 +264,20 @@ hipDeviceGetAttribute(int* pi, hipDeviceAttribute_t attr, int device)
   }
   return hipErrorUnknown;
 }
+
+hipError_t
+hipDeviceSynchronize()
+{
+  try {
+    xrt::core::hip::synchronize_device();
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
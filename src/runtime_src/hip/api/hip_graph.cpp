@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#include "core/common/error.h"
+
+#include "hip/config.h"
+#include "hip/hip_runtime_api.h"
+
+#include "hip/core/common.h"
+#include "hip/core/graph.h"
+#include "hip/core/stream.h"
+
+namespace xrt::core::hip {
+
+static void
+hip_graph_destroy(hipGraph_t graph)
+{
+  throw_invalid_value_if(!graph, "graph passed is nullptr");
+  throw_invalid_value_if(!graph_cache.count(graph), "graph passed is invalid");
+  graph_cache.remove(graph);
+}
+
+static graph_exec_handle
+hip_graph_instantiate(hipGraph_t graph)
+{
+  throw_invalid_value_if(!graph, "graph passed is nullptr");
+  auto hip_graph = graph_cache.get(graph);
+  throw_invalid_value_if(!hip_graph, "graph passed is invalid");
+
+  return insert_in_map(graph_exec_cache, std::make_shared<graph_exec>(*hip_graph));
+}
+
+static void
+hip_graph_exec_destroy(hipGraphExec_t graph_exec)
+{
+  throw_invalid_value_if(!graph_exec, "graph exec passed is nullptr");
+  auto hip_graph_exec = graph_exec_cache.get(graph_exec);
+  throw_invalid_value_if(!hip_graph_exec, "graph exec passed is invalid");
+
+  // destroying an executable graph waits for its launch in progress
+  hip_graph_exec->finish();
+  graph_exec_cache.remove(graph_exec);
+}
+
+static void
+hip_graph_launch(hipGraphExec_t graph_exec, hipStream_t stream)
+{
+  throw_invalid_value_if(!graph_exec, "graph exec passed is nullptr");
+  auto hip_graph_exec = graph_exec_cache.get(graph_exec);
+  throw_invalid_value_if(!hip_graph_exec, "graph exec passed is invalid");
+
+  auto hip_stream = get_stream(stream);
+  throw_invalid_handle_if(!hip_stream, "stream is invalid");
+
+  auto s_hdl = hip_stream.get();
+  auto cmd_hdl = insert_in_map(command_cache,
+                               std::make_shared<graph_launch>(hip_stream, hip_graph_exec));
+  s_hdl->enqueue(command_cache.get(cmd_hdl));
+}
+} // xrt::core::hip
+
+// =========================================================================
+// Graph related apis implementation
+hipError_t
+hipGraphDestroy(hipGraph_t graph)
+{
+  try {
+    xrt::core::hip::hip_graph_destroy(graph);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipGraphInstantiate(hipGraphExec_t* pGraphExec, hipGraph_t graph, hipGraphNode_t* pErrorNode,
+                    char* pLogBuffer, size_t bufferSize)
+{
+  try {
+    throw_invalid_value_if(!pGraphExec, "graph exec passed is nullptr");
+    if (pErrorNode)
+      *pErrorNode = nullptr;
+    if (pLogBuffer && bufferSize)
+      pLogBuffer[0] = '\0';
+
+    auto handle = xrt::core::hip::hip_graph_instantiate(graph);
+    *pGraphExec = reinterpret_cast<hipGraphExec_t>(handle);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipGraphExecDestroy(hipGraphExec_t graphExec)
+{
+  try {
+    xrt::core::hip::hip_graph_exec_destroy(graphExec);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipGraphLaunch(hipGraphExec_t graphExec, hipStream_t stream)
+{
+  try {
+    xrt::core::hip::hip_graph_launch(graphExec, stream);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
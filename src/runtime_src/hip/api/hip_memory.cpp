@@ -3,14 +3,13 @@
 
 #include <string>
 #include "core/common/error.h"
-#include "core/common/memalign.h"
-#include "core/common/unistd.h"
 #include "core/common/utils.h"
 #include "hip/config.h"
 #include "hip/core/device.h"
 #include "hip/core/context.h"
 #include "hip/core/event.h"
 #include "hip/core/memory.h"
+#include "hip/core/memory_pool.h"
 #include "hip/core/stream.h"
 #include "hip/hip_runtime_api.h"
 
@@ -35,6 +34,43 @@ namespace xrt::core::hip
     *ptr = reinterpret_cast<void* >(address);
   }
 
+  // Allocate memory on the device from the pool of a stream.
+  static void
+  hip_malloc_async(void** ptr, size_t size, hipStream_t stream)
+  {
+    throw_invalid_value_if(!ptr, "ptr is nullptr.");
+    throw_invalid_value_if(size == 0, "size is 0.");
+
+    auto hip_stream = get_stream(stream);
+    throw_invalid_value_if(!hip_stream, "Invalid stream handle.");
+
+    *ptr = nullptr;
+    auto hip_mem = hip_stream->get_mem_pool()->allocate(size);
+    auto address = hip_mem->get_address();
+    throw_if(!address, hipErrorOutOfMemory, "Error allocating memory using hipMallocAsync!");
+
+    memory_database::instance().insert(reinterpret_cast<uint64_t>(address), hip_mem->get_size(), hip_mem);
+    *ptr = address;
+  }
+
+  // Free memory allocated by hipMallocAsync() in stream order.  The
+  // memory is recycled by later allocations on the same stream.
+  static void
+  hip_free_async(void* ptr, hipStream_t stream)
+  {
+    auto hip_mem = memory_database::instance().get_hip_mem_from_addr(ptr).first;
+    throw_invalid_handle_if(!hip_mem || hip_mem->get_type() != memory_type::device, "Invalid handle.");
+
+    auto hip_stream = get_stream(stream);
+    throw_invalid_value_if(!hip_stream, "Invalid stream handle.");
+
+    memory_database::instance().remove(reinterpret_cast<uint64_t>(ptr));
+
+    // memory not allocated from the pool of this stream is released as
+    // with hipFree
+    hip_stream->get_mem_pool()->free(ptr);
+  }
+
   // Allocates device accessible host memory.
   static void
   hip_host_malloc(void** ptr, size_t size, unsigned int flags)
@@ -203,10 +239,8 @@ namespace xrt::core::hip
     assert(hip_mem_dst->get_type() != xrt::core::hip::memory_type::invalid);
     throw_invalid_value_if(offset + size > hip_mem_dst->get_size(), "dst out of bound.");
 
-    auto host_src = xrt_core::aligned_alloc(xrt_core::getpagesize(), size);
-    memset(host_src.get(), value, size);
-
-    hip_mem_dst->write(host_src.get(), size, 0, offset);
+    auto pattern = static_cast<unsigned char>(value);
+    hip_mem_dst->fill(&pattern, sizeof(pattern), size, offset);
   }
 
   static void
@@ -244,15 +278,12 @@ namespace xrt::core::hip
     throw_invalid_value_if((element_size != 1 && element_size != 2 && element_size != 4), "Invalid element type.");
     throw_invalid_value_if(size % element_size != 0, "Invalid size.");
 
-    auto element_count = size / element_size;
-    std::vector<T> host_vec(element_count, value);
-
     auto hip_stream = get_stream(stream);
     throw_invalid_value_if(!hip_stream, "Invalid stream handle.");
 
     auto s_hdl = hip_stream.get();
     auto cmd_hdl = insert_in_map(command_cache,
-                                std::make_shared<copy_from_host_buffer_command<T>>(hip_stream, XCL_BO_SYNC_BO_TO_DEVICE, hip_mem_dst, std::move(host_vec), size, offset));
+                                std::make_shared<fill_buffer_command>(hip_stream, hip_mem_dst, &value, element_size, size, offset));
     s_hdl->enqueue(command_cache.get(cmd_hdl));
   }
 } // xrt::core::hip
@@ -334,6 +365,18 @@ hipHostGetDevicePointer(void** device_ptr, void* host_ptr, unsigned int flags)
 }
 
 // Copy data from src to dst.
+hipError_t
+hipMallocAsync(void** ptr, size_t size, hipStream_t stream)
+{
+  return handle_hip_memory_error([&] { xrt::core::hip::hip_malloc_async(ptr, size, stream); });
+}
+
+hipError_t
+hipFreeAsync(void* ptr, hipStream_t stream)
+{
+  return handle_hip_memory_error([&] { xrt::core::hip::hip_free_async(ptr, stream); });
+}
+
 hipError_t
 hipMemcpy(void* dst, const void* src, size_t size, hipMemcpyKind kind)
 {
@@ -3,6 +3,7 @@
 
 #include "hip/core/common.h"
 #include "hip/core/event.h"
+#include "hip/core/graph.h"
 #include "hip/core/stream.h"
 
 namespace xrt::core::hip {
@@ -45,6 +46,8 @@ namespace xrt::core::hip {
  * Null stream waits on all Blocking, Per Thread default streams in that context
  * Streams created with Default flag wait on Null stream of that context
  * Per thread stream is created per thread per context
+ * Setting Runtime.hip_per_thread_default_stream in xrt.ini makes the null
+ * stream passed by the application use the per thread stream
  * At present stream synchronization is done only when hipStreamSynchronize api
  * is explicitly called.
  * TODO : Add it at the time of command enqueue also
@@ -112,6 +115,34 @@ hip_stream_wait_event(hipStream_t stream, hipEvent_t ev, unsigned int flags)
     wait_stream->record_top_event(dummy_event_hdl);
   }
 }
+
+// Commands enqueued to a capturing stream are recorded in a graph.
+// Capture is local to the stream, all capture modes behave as
+// hipStreamCaptureModeRelaxed.
+static void
+hip_stream_begin_capture(hipStream_t stream, hipStreamCaptureMode /*mode*/)
+{
+  auto hip_stream = get_stream(stream);
+  throw_invalid_handle_if(!hip_stream, "stream is invalid");
+  throw_if(hip_stream->is_null(), hipErrorStreamCaptureUnsupported, "null stream can't be captured");
+  hip_stream->begin_capture();
+}
+
+static graph_handle
+hip_stream_end_capture(hipStream_t stream)
+{
+  auto hip_stream = get_stream(stream);
+  throw_invalid_handle_if(!hip_stream, "stream is invalid");
+  return insert_in_map(graph_cache, hip_stream->end_capture());
+}
+
+static hipStreamCaptureStatus
+hip_stream_is_capturing(hipStream_t stream)
+{
+  auto hip_stream = get_stream(stream);
+  throw_invalid_handle_if(!hip_stream, "stream is invalid");
+  return hip_stream->is_capturing() ? hipStreamCaptureStatusActive : hipStreamCaptureStatusNone;
+}
 } // // xrt::core::hip
 
 // =========================================================================
@@ -187,3 +218,59 @@ hipStreamWaitEvent(hipStream_t stream, hipEvent_t event, unsigned int flags)
   return hipErrorUnknown;
 }
 
+
+hipError_t
+hipStreamBeginCapture(hipStream_t stream, hipStreamCaptureMode mode)
+{
+  try {
+    xrt::core::hip::hip_stream_begin_capture(stream, mode);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipStreamEndCapture(hipStream_t stream, hipGraph_t* pGraph)
+{
+  try {
+    throw_invalid_value_if(!pGraph, "graph passed is nullptr");
+
+    auto handle = xrt::core::hip::hip_stream_end_capture(stream);
+    *pGraph = reinterpret_cast<hipGraph_t>(handle);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
+
+hipError_t
+hipStreamIsCapturing(hipStream_t stream, hipStreamCaptureStatus* pCaptureStatus)
+{
+  try {
+    throw_invalid_value_if(!pCaptureStatus, "capture status passed is nullptr");
+
+    *pCaptureStatus = xrt::core::hip::hip_stream_is_capturing(stream);
+    return hipSuccess;
+  }
+  catch (const xrt_core::system_error& ex) {
+    xrt_core::send_exception_message(std::string(__func__) +  " - " + ex.what());
+    return static_cast<hipError_t>(ex.value());
+  }
+  catch (const std::exception& ex) {
+    xrt_core::send_exception_message(ex.what());
+  }
+  return hipErrorUnknown;
+}
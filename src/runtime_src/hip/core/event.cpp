@@ -4,6 +4,8 @@
 #include "event.h"
 #include "memory.h"
 
+#include <algorithm>
+
 namespace xrt::core::hip {
 event::event()
   : command(type::event)
@@ -99,23 +101,34 @@ void event::add_dependency(std::shared_ptr<command> cmd)
 kernel_start::kernel_start(std::shared_ptr<stream> s, std::shared_ptr<function> f, void** args)
   : command(type::kernel_start, std::move(s))
   , func{std::move(f)}
+  , slot{func->acquire_run()}
 {
-  auto k = func->get_kernel();
+  const auto& k = func->get_kernel();
+  const auto& kargs = xrt_core::kernel_int::get_args(k);
+  auto& r = slot.run;
 
-  // create run object and set args
-  r = xrt::run(k);
+  // a recycled run has the arguments of its previous launch, only
+  // arguments that differ are set again
+  slot.scalars.resize(kargs.size());
+  slot.globals.resize(kargs.size());
 
   using karg = xrt_core::xclbin::kernel_argument;
   int idx = 0;
-  for (const auto& arg : xrt_core::kernel_int::get_args(k)) {
+  for (const auto& arg : kargs) {
     // non index args are not supported, this condition will not hit in case of HIP
     if (arg->index == karg::no_index)
       throw std::runtime_error("function has invalid argument");
 
     switch (arg->type) {
-      case karg::argtype::scalar :
+      case karg::argtype::scalar : {
+        auto& prev = slot.scalars[idx];
+        auto value = static_cast<const char*>(args[idx]);
+        if (prev.size() == arg->size && std::equal(prev.begin(), prev.end(), value))
+          break;
         xrt_core::kernel_int::set_arg_at_index(r, arg->index, args[idx], arg->size);
+        prev.assign(value, value + arg->size);
         break;
+      }
 
       case karg::argtype::global: {
         if (!args[idx])
@@ -125,9 +138,17 @@ kernel_start::kernel_start(std::shared_ptr<stream> s, std::shared_ptr<function>
           throw std::runtime_error("failed to get memory from arg at index - " + std::to_string(idx));
 
         // NPU device is not coherent. We need to sync the buffer objects before launching kernel
-        if (hip_mem->get_type() != memory_type::device)
+        if (hip_mem->get_type() != memory_type::device) {
           hip_mem->sync(xclBOSyncDirection::XCL_BO_SYNC_BO_TO_DEVICE);
+          host_bufs.push_back(hip_mem);
+        }
+        // owner comparison of the weak pointer is not fooled by a new
+        // memory object allocated at the address of a freed one
+        auto& prev = slot.globals[idx];
+        if (!prev.owner_before(hip_mem) && !hip_mem.owner_before(prev) && !prev.expired())
+          break;
         r.set_arg(arg->index, hip_mem->get_xrt_bo());
+        prev = hip_mem;
         break;
       }
       case karg::argtype::constant :
@@ -140,12 +161,20 @@ kernel_start::kernel_start(std::shared_ptr<stream> s, std::shared_ptr<function>
   }
 }
 
+kernel_start::~kernel_start()
+{
+  // a run that may still be executing is not reused
+  auto kernel_start_state = get_state();
+  if (kernel_start_state == state::init || kernel_start_state == state::completed)
+    func->release_run(std::move(slot));
+}
+
 bool kernel_start::submit()
 {
   state kernel_start_state = get_state();
   if (kernel_start_state == state::init)
   {
-    r.start();
+    slot.run.start();
     set_state(state::running);
     return true;
   }
@@ -160,7 +189,7 @@ bool kernel_start::wait()
   state kernel_start_state = get_state();
   if (kernel_start_state == state::running)
   {
-    r.wait();
+    slot.run.wait();
     set_state(state::completed);
     return true;
   }
@@ -175,11 +204,11 @@ bool copy_buffer::submit()
   switch(cdirection)
   {
     case XCL_BO_SYNC_BO_TO_DEVICE:
-      handle = std::async(std::launch::async, &memory::write, buffer, host_buffer, copy_size, 0, dev_offset);
+      handle = buffer->write_async(host_buffer, copy_size, dev_offset);
       break;
 
     case XCL_BO_SYNC_BO_FROM_DEVICE:
-      handle = std::async(std::launch::async, &memory::read, buffer, host_buffer, copy_size, dev_offset, 0);
+      handle = buffer->sync_async(XCL_BO_SYNC_BO_FROM_DEVICE, copy_size, dev_offset);
       break;
 
     default:
@@ -191,7 +220,13 @@ bool copy_buffer::submit()
 
 bool copy_buffer::wait()
 {
-  handle.wait();
+  if (handle) {
+    handle.wait();
+    handle = xrt::bo::async_handle{nullptr};
+    // data synced from device is in the host side of the buffer
+    if (cdirection == XCL_BO_SYNC_BO_FROM_DEVICE)
+      buffer->read_host(host_buffer, copy_size, dev_offset);
+  }
   set_state(state::completed);
   return true;
 }
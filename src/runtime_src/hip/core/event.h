@@ -12,7 +12,7 @@
 #include "core/common/api/kernel_int.h"
 
 #include <condition_variable>
-#include <future>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -39,7 +39,8 @@ public:
   {
     event,
     buffer_copy,
-    kernel_start
+    kernel_start,
+    graph_launch
   };
 
 protected:
@@ -120,12 +121,38 @@ class kernel_start : public command
 {
 private:
   std::shared_ptr<function> func;
-  xrt::run r;
+  function::run_slot slot; // run recycled through func
+  std::vector<std::shared_ptr<memory>> host_bufs; // synced before each start
 
 public:
   kernel_start(std::shared_ptr<stream> s, std::shared_ptr<function> f, void** args);
+  ~kernel_start() override;
+  kernel_start(const kernel_start&) = delete;
+  kernel_start(kernel_start&&) = delete;
+  kernel_start& operator=(const kernel_start&) = delete;
+  kernel_start& operator=(kernel_start&&) = delete;
   bool submit() override;
   bool wait() override;
+
+  const std::shared_ptr<function>&
+  get_function() const
+  {
+    return func;
+  }
+
+  const xrt::run&
+  get_run() const
+  {
+    return slot.run;
+  }
+
+  // buffers that are not device memory and must be synced to the
+  // device every time the kernel is started
+  const std::vector<std::shared_ptr<memory>>&
+  get_host_buffers() const
+  {
+    return host_bufs;
+  }
 };
 
 // copy command for copying data from/to host buffer of type void*
@@ -144,40 +171,31 @@ protected:
   void* host_buffer; // host buffer copy source/destination
   size_t copy_size;
   size_t dev_offset; // offset for device memory
-  std::future<void> handle;
+  xrt::bo::async_handle handle{nullptr}; // sync running on XRT DMA workers
 };
 
-// copy command for copying data from a source only bost buffer of type std::vector<uint8|uint16|uint32>
-template<class T>
-class copy_from_host_buffer_command : public copy_buffer
+// fill command for setting device memory to a repeated pattern of
+// 1, 2 or 4 bytes
+class fill_buffer_command : public copy_buffer
 {
 public:
-  copy_from_host_buffer_command(std::shared_ptr<stream> s, xclBOSyncDirection direction, std::shared_ptr<memory> buf, std::vector<T>&& vec, size_t size, size_t offset)
-    : copy_buffer(s, direction, buf, nullptr, size, offset), host_vec(std::move(vec))
+  fill_buffer_command(std::shared_ptr<stream> s, std::shared_ptr<memory> buf, const void* pattern, size_t pattern_size, size_t size, size_t offset)
+    : copy_buffer(std::move(s), XCL_BO_SYNC_BO_TO_DEVICE, std::move(buf), nullptr, size, offset), fill_pattern_size(pattern_size)
   {
+    if (pattern_size > sizeof(fill_pattern))
+      throw std::runtime_error("fill pattern is too large");
+    std::memcpy(&fill_pattern, pattern, pattern_size);
   }
 
   bool submit() override
   {
-    switch (cdirection)
-    {
-    case XCL_BO_SYNC_BO_TO_DEVICE:
-      handle = std::async(std::launch::async, &memory::write, buffer, host_vec.data(), copy_size, 0, dev_offset);
-      break;
-
-    case XCL_BO_SYNC_BO_FROM_DEVICE:
-      throw std::runtime_error("host_buffer is an invalid destination");
-      break;
-
-    default:
-      break;
-    };
-
+    handle = buffer->fill_async(&fill_pattern, fill_pattern_size, copy_size, dev_offset);
     return true;
   }
 
 private:
-  std::vector<T> host_vec; // host buffer (source only, not valid as destination)
+  uint32_t fill_pattern = 0;
+  size_t fill_pattern_size;
 };
 
 // Global map of commands
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#include "graph.h"
+#include "module.h"
+
+namespace xrt::core::hip {
+
+void
+graph::
+add_node(std::shared_ptr<command> cmd)
+{
+  std::lock_guard lock(m_lock);
+  m_nodes.push_back(std::move(cmd));
+}
+
+std::vector<std::shared_ptr<command>>
+graph::
+get_nodes() const
+{
+  std::lock_guard lock(m_lock);
+  return m_nodes;
+}
+
+graph_exec::
+graph_exec(const graph& g)
+{
+  for (const auto& node : g.get_nodes()) {
+    if (node->get_type() != command::type::kernel_start) {
+      m_steps.push_back({{}, node, {}, nullptr});
+      continue;
+    }
+
+    auto ks = std::dynamic_pointer_cast<kernel_start>(node);
+    auto module = ks->get_function()->get_module();
+
+    // start a new runlist unless previous step is a runlist on the
+    // same hardware context
+    if (m_steps.empty() || m_steps.back().copy || m_steps.back().module != module)
+      m_steps.push_back({xrt::runlist{module->get_hw_context()}, nullptr, {}, module});
+
+    auto& s = m_steps.back();
+    s.kernels.add(xrt_core::kernel_int::clone(ks->get_run()));
+    const auto& bufs = ks->get_host_buffers();
+    s.syncs.insert(s.syncs.end(), bufs.begin(), bufs.end());
+  }
+}
+
+void
+graph_exec::
+submit_step(step& s)
+{
+  if (s.copy) {
+    s.copy->submit();
+    return;
+  }
+
+  // NPU device is not coherent, host buffers used by the kernels
+  // must be synced before every launch
+  for (const auto& buf : s.syncs)
+    buf->sync(xclBOSyncDirection::XCL_BO_SYNC_BO_TO_DEVICE);
+  s.kernels.execute();
+}
+
+void
+graph_exec::
+wait_step(step& s)
+{
+  if (s.copy)
+    s.copy->wait();
+  else
+    s.kernels.wait();
+}
+
+void
+graph_exec::
+finish_no_lock()
+{
+  if (!m_running)
+    return;
+
+  // steps depend on each other in capture order, so each step is
+  // submitted only when the previous step has completed
+  m_running = false;
+  wait_step(m_steps[m_current]);
+  while (++m_current < m_steps.size()) {
+    submit_step(m_steps[m_current]);
+    wait_step(m_steps[m_current]);
+  }
+}
+
+void
+graph_exec::
+start()
+{
+  std::lock_guard lock(m_lock);
+  finish_no_lock();
+
+  if (m_steps.empty())
+    return;
+
+  m_current = 0;
+  submit_step(m_steps[m_current]);
+  m_running = true;
+}
+
+void
+graph_exec::
+finish()
+{
+  std::lock_guard lock(m_lock);
+  finish_no_lock();
+}
+
+bool
+graph_launch::
+submit()
+{
+  state launch_state = get_state();
+  if (launch_state == state::init) {
+    m_exec->start();
+    set_state(state::running);
+    return true;
+  }
+  else if (launch_state == state::running)
+    return true;
+
+  return false;
+}
+
+bool
+graph_launch::
+wait()
+{
+  state launch_state = get_state();
+  if (launch_state == state::running) {
+    m_exec->finish();
+    set_state(state::completed);
+    return true;
+  }
+  else if (launch_state == state::completed)
+    return true;
+
+  return false;
+}
+
+// Global map of graphs
+//we should override clang-tidy warning by adding NOLINT since graph_cache is non-const parameter
+xrt_core::handle_map<graph_handle, std::shared_ptr<graph>> graph_cache; //NOLINT
+
+// Global map of executable graphs
+//we should override clang-tidy warning by adding NOLINT since graph_exec_cache is non-const parameter
+xrt_core::handle_map<graph_exec_handle, std::shared_ptr<graph_exec>> graph_exec_cache; //NOLINT
+
+} // xrt::core::hip
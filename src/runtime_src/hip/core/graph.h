@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef xrthip_graph_h
+#define xrthip_graph_h
+
+#include "common.h"
+#include "event.h"
+#include "experimental/xrt_kernel.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace xrt::core::hip {
+
+// graph_handle - opaque graph handle
+using graph_handle = void*;
+
+// graph_exec_handle - opaque executable graph handle
+using graph_exec_handle = void*;
+
+// class graph - commands captured from a stream
+//
+// Between hipStreamBeginCapture and hipStreamEndCapture the commands
+// enqueued to a stream are appended to a graph instead of being
+// submitted.  The graph keeps the commands in the order they were
+// captured, which is also the order in which they are executed.
+class graph
+{
+  mutable std::mutex m_lock;
+  std::vector<std::shared_ptr<command>> m_nodes;
+
+public:
+  void
+  add_node(std::shared_ptr<command> cmd);
+
+  std::vector<std::shared_ptr<command>>
+  get_nodes() const;
+};
+
+// class graph_exec - executable graph created by hipGraphInstantiate
+//
+// Consecutive kernel launches on the same hardware context are
+// grouped in one xrt::runlist so that replaying them is a single
+// submission.  The run objects of the list are clones of the
+// captured run objects, leaving the graph free to be instantiated
+// again.  Copy commands are executed in between the lists.
+//
+// A graph_exec executes one launch at a time, a new launch completes
+// the previous launch before starting.
+class graph_exec
+{
+  struct step
+  {
+    xrt::runlist kernels;                       // kernel launches, or
+    std::shared_ptr<command> copy;              // a copy command
+    std::vector<std::shared_ptr<memory>> syncs; // host buffers used by kernels
+    module_xclbin* module = nullptr;
+  };
+
+  std::mutex m_lock;
+  std::vector<step> m_steps;
+  size_t m_current = 0; // step in progress
+  bool m_running = false;
+
+  void
+  submit_step(step& s);
+
+  void
+  wait_step(step& s);
+
+  void
+  finish_no_lock();
+
+public:
+  explicit graph_exec(const graph& g);
+
+  // Start a launch of the graph, returns once the first step is submitted
+  void
+  start();
+
+  // Complete the launch in progress
+  void
+  finish();
+};
+
+// command for launching an executable graph in a stream
+class graph_launch : public command
+{
+  std::shared_ptr<graph_exec> m_exec;
+
+public:
+  graph_launch(std::shared_ptr<stream> s, std::shared_ptr<graph_exec> exec)
+    : command(command::type::graph_launch, std::move(s)), m_exec(std::move(exec))
+  {}
+
+  bool submit() override;
+  bool wait() override;
+};
+
+// Global map of graphs
+extern xrt_core::handle_map<graph_handle, std::shared_ptr<graph>> graph_cache;
+
+// Global map of executable graphs
+extern xrt_core::handle_map<graph_exec_handle, std::shared_ptr<graph_exec>> graph_exec_cache;
+
+} // xrt::core::hip
+
+#endif
@@ -14,6 +14,10 @@
 #include "hip/hip_runtime_api.h"
 #include "memory.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 namespace xrt::core::hip
 {
 
@@ -42,6 +46,16 @@ namespace xrt::core::hip
     m_bo = xrt::ext::bo(xrt_device, host_mem, m_size);
   }
 
+  memory::memory(std::shared_ptr<device> dev, const xrt::bo& parent, size_t sz, size_t offset)
+      : m_device(std::move(dev)),
+	m_size(sz),
+	m_type(memory_type::device),
+	m_flags(0),
+	m_bo(parent, sz, offset)
+  {
+    assert(m_device);
+  }
+
   memory::memory(std::shared_ptr<device> dev, size_t sz, unsigned int flags)
       : m_device(std::move(dev)),
 	m_size(sz),
@@ -107,7 +121,7 @@ namespace xrt::core::hip
     src_ptr += src_offset;
     if (m_bo) {
       m_bo.write(src_ptr, size, offset);
-      m_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+      m_bo.sync(XCL_BO_SYNC_BO_TO_DEVICE, size, offset);
     }
   }
 
@@ -122,11 +136,66 @@ namespace xrt::core::hip
     auto dst_ptr = reinterpret_cast<unsigned char *>(dst);
     dst_ptr += dst_offset;
     if (m_bo) {
-      m_bo.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+      m_bo.sync(XCL_BO_SYNC_BO_FROM_DEVICE, size, offset);
       m_bo.read(dst_ptr, size, offset);
     }
   }
 
+  void
+  memory::fill(const void *pattern, size_t pattern_size, size_t size, size_t offset)
+  {
+    if (!m_bo || !size)
+      return;
+
+    m_bo.fill(pattern, pattern_size, size, offset);
+  }
+
+  xrt::bo::async_handle
+  memory::write_async(const void *src, size_t size, size_t offset)
+  {
+    assert(m_bo);
+    m_bo.write(src, size, offset);
+    return m_bo.async(XCL_BO_SYNC_BO_TO_DEVICE, size, offset);
+  }
+
+  xrt::bo::async_handle
+  memory::fill_async(const void *pattern, size_t pattern_size, size_t size, size_t offset)
+  {
+    assert(m_bo);
+    fill_host(pattern, pattern_size, size, offset);
+    return m_bo.async(XCL_BO_SYNC_BO_TO_DEVICE, size, offset);
+  }
+
+  xrt::bo::async_handle
+  memory::sync_async(xclBOSyncDirection direction, size_t size, size_t offset)
+  {
+    assert(m_bo);
+    return m_bo.async(direction, size, offset);
+  }
+
+  void
+  memory::read_host(void *dst, size_t size, size_t offset)
+  {
+    assert(m_bo);
+    m_bo.read(dst, size, offset);
+  }
+
+  void
+  memory::fill_host(const void *pattern, size_t pattern_size, size_t size, size_t offset)
+  {
+    // Replicate the pattern in a bounded chunk that is written
+    // repeatedly, rather than staging a host buffer of the full size
+    constexpr size_t max_chunk_size = 64 * 1024; // multiple of all pattern sizes
+    std::vector<unsigned char> chunk(std::min(size, max_chunk_size));
+    for (size_t i = 0; i + pattern_size <= chunk.size(); i += pattern_size)
+      std::memcpy(chunk.data() + i, pattern, pattern_size);
+
+    for (size_t done = 0; done < size; done += chunk.size()) {
+      auto bytes = std::min(chunk.size(), size - done);
+      m_bo.write(chunk.data(), bytes, offset + done);
+    }
+  }
+
   void
   memory::sync(xclBOSyncDirection direction)
   {
@@ -172,21 +241,21 @@ namespace xrt::core::hip
   void
   memory_database::insert(uint64_t addr, size_t size, std::shared_ptr<xrt::core::hip::memory> hip_mem)
   {
-    std::lock_guard lock(m_mutex);
+    std::unique_lock lock(m_mutex);
     m_addr_map.insert({address_range_key(addr, size), hip_mem});
   }
 
   void
   memory_database::remove(uint64_t addr)
   {
-    std::lock_guard lock(m_mutex);
+    std::unique_lock lock(m_mutex);
     m_addr_map.erase(address_range_key(addr, 0));
   }
 
   std::pair<std::shared_ptr<xrt::core::hip::memory>, size_t>
   memory_database::get_hip_mem_from_addr(void *addr)
   {
-    std::lock_guard lock(m_mutex);
+    std::shared_lock lock(m_mutex);
     auto itr = m_addr_map.find(address_range_key(reinterpret_cast<uint64_t>(addr), 0));
     if (itr == m_addr_map.end()) {
       return std::pair(nullptr, 0);
@@ -200,7 +269,7 @@ namespace xrt::core::hip
   std::pair<std::shared_ptr<xrt::core::hip::memory>, size_t>
   memory_database::get_hip_mem_from_addr(const void *addr)
   {
-    std::lock_guard lock(m_mutex);
+    std::shared_lock lock(m_mutex);
     auto itr = m_addr_map.find(address_range_key(reinterpret_cast<uint64_t>(addr), 0));
     if (itr == m_addr_map.end()) {
       return std::pair(nullptr, 0);
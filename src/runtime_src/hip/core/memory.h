@@ -11,6 +11,8 @@
 #include "xrt/device/hal.h"
 #include "xrt/util/range.h"
 
+#include <shared_mutex>
+
 namespace xrt::core::hip
 {
   enum class memory_type : int
@@ -41,6 +43,9 @@ namespace xrt::core::hip
 
     // allocate from user host buffer
     memory(std::shared_ptr<xrt::core::hip::device> dev, size_t sz, void *host_mem, unsigned int flags);
+
+    // device memory carved from a parent buffer, used by memory pools
+    memory(std::shared_ptr<xrt::core::hip::device> dev, const xrt::bo& parent, size_t sz, size_t offset);
     
     void*
     get_address();
@@ -53,6 +58,27 @@ namespace xrt::core::hip
 
     void
     read(void *dst, size_t size, size_t dst_offset = 0, size_t offset = 0); 
+
+    // fill size bytes at offset with a repeated pattern of pattern_size
+    // bytes, size must be a multiple of pattern_size
+    void
+    fill(const void *pattern, size_t pattern_size, size_t size, size_t offset = 0);
+
+    // Asynchronous variants for stream commands.  The host side of the
+    // buffer is updated by the calling thread, the sync with the device
+    // runs on the XRT DMA worker threads.  For reads from the device,
+    // sync_async() is followed by read_host() once the sync completed.
+    xrt::bo::async_handle
+    write_async(const void *src, size_t size, size_t offset = 0);
+
+    xrt::bo::async_handle
+    fill_async(const void *pattern, size_t pattern_size, size_t size, size_t offset = 0);
+
+    xrt::bo::async_handle
+    sync_async(xclBOSyncDirection direction, size_t size, size_t offset = 0);
+
+    void
+    read_host(void *dst, size_t size, size_t offset = 0);
     
     void
     sync(xclBOSyncDirection);
@@ -91,6 +117,9 @@ namespace xrt::core::hip
 
     void
     init_xrt_bo();
+
+    void
+    fill_host(const void *pattern, size_t pattern_size, size_t size, size_t offset);
   };
 
   class address_range_key
@@ -126,7 +155,7 @@ namespace xrt::core::hip
   {
   private:
     addr_map m_addr_map;
-    std::mutex m_mutex;
+    std::shared_mutex m_mutex; // lookups share the lock, only updates are exclusive
   
   protected:
     memory_database();
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+#include "memory_pool.h"
+
+#include "experimental/xrt_ext.h"
+
+#include <algorithm>
+
+namespace xrt::core::hip {
+
+static size_t
+round_up_pow2(size_t size)
+{
+  size_t rounded = 1;
+  while (rounded < size)
+    rounded <<= 1;
+  return rounded;
+}
+
+memory_pool::
+memory_pool(std::shared_ptr<device> dev)
+  : m_device(std::move(dev))
+{}
+
+std::shared_ptr<memory>
+memory_pool::
+new_block(size_t block_size)
+{
+  if (block_size > chunk_size / 4)
+    return std::make_shared<memory>(m_device, block_size);
+
+  // size classes are powers of two, align the block to its size
+  auto offset = (m_chunk_used + block_size - 1) & ~(block_size - 1);
+  if (!m_chunk || offset + block_size > chunk_size) {
+    m_chunk = xrt::ext::bo(m_device->get_xrt_device(), chunk_size);
+    offset = 0;
+  }
+
+  auto block = std::make_shared<memory>(m_device, m_chunk, block_size, offset);
+  m_chunk_used = offset + block_size;
+  return block;
+}
+
+std::shared_ptr<memory>
+memory_pool::
+allocate(size_t size)
+{
+  auto block_size = round_up_pow2(std::max(size, min_block_size));
+
+  std::lock_guard lock(m_lock);
+  std::shared_ptr<memory> block;
+  auto& free_list = m_free[block_size];
+  if (!free_list.empty()) {
+    block = std::move(free_list.back());
+    free_list.pop_back();
+  }
+  else {
+    block = new_block(block_size);
+  }
+
+  m_used.emplace(block->get_address(), block);
+  return block;
+}
+
+bool
+memory_pool::
+free(void* addr)
+{
+  std::lock_guard lock(m_lock);
+  auto itr = m_used.find(addr);
+  if (itr == m_used.end())
+    return false;
+
+  auto block = std::move(itr->second);
+  m_used.erase(itr);
+  m_free[block->get_size()].push_back(std::move(block));
+  return true;
+}
+
+} // xrt::core::hip
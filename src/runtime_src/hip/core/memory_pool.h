@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+#ifndef xrthip_memory_pool_h
+#define xrthip_memory_pool_h
+
+#include "device.h"
+#include "memory.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace xrt::core::hip {
+
+// class memory_pool - stream ordered device memory allocator
+//
+// Backs hipMallocAsync and hipFreeAsync.  Each stream owns a pool,
+// memory freed to the pool is reused only by allocations on the same
+// stream, which are ordered after the free.
+//
+// Allocations are rounded up to a power of two size class and carved
+// from large chunk buffers as sub buffers, so an allocation normally
+// costs no driver call.  Freed blocks are kept in per class free
+// lists and are never returned to the driver while the pool exists.
+// Allocations too large for a chunk get a buffer of their own, which
+// is recycled the same way.
+class memory_pool
+{
+  static constexpr size_t min_block_size = 4 * 1024;
+  static constexpr size_t chunk_size = 16 * 1024 * 1024;
+
+  std::shared_ptr<device> m_device;
+
+  std::mutex m_lock;
+  xrt::bo m_chunk;          // chunk blocks are currently carved from
+  size_t m_chunk_used = 0;  // bytes of m_chunk carved so far
+
+  // free blocks per size class
+  std::map<size_t, std::vector<std::shared_ptr<memory>>> m_free;
+
+  // blocks allocated from this pool and not yet freed
+  std::unordered_map<void*, std::shared_ptr<memory>> m_used;
+
+  std::shared_ptr<memory>
+  new_block(size_t block_size);
+
+public:
+  explicit memory_pool(std::shared_ptr<device> dev);
+
+  // Allocate a block of at least size bytes
+  std::shared_ptr<memory>
+  allocate(size_t size);
+
+  // Return a block to the pool, returns false if the address was not
+  // allocated from this pool
+  bool
+  free(void* addr);
+};
+
+} // xrt::core::hip
+
+#endif
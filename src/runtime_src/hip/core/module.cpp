@@ -40,6 +40,30 @@ function(module_xclbin* xclbin_mod_hdl, const xrt::module& xrt_module, const std
   , m_xrt_kernel{xrt::ext::kernel{m_xclbin_module->get_hw_context(), xrt_module, name}}
 {}
 
+function::run_slot
+function::
+acquire_run()
+{
+  {
+    std::lock_guard<std::mutex> lk(m_runs_mutex);
+    if (!m_idle_runs.empty()) {
+      auto slot = std::move(m_idle_runs.back());
+      m_idle_runs.pop_back();
+      return slot;
+    }
+  }
+  return {xrt::run(m_xrt_kernel), {}, {}};
+}
+
+void
+function::
+release_run(run_slot&& slot)
+{
+  std::lock_guard<std::mutex> lk(m_runs_mutex);
+  if (m_idle_runs.size() < max_idle_runs)
+    m_idle_runs.push_back(std::move(slot));
+}
+
 // Global map of modules
 //we should override clang-tidy warning by adding NOLINT since module_cache is non-const parameter
 xrt_core::handle_map<module_handle, std::shared_ptr<module>> module_cache; //NOLINT
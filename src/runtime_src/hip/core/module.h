@@ -9,6 +9,9 @@
 #include "xrt/xrt_hw_context.h"
 #include "xrt/xrt_kernel.h"
 
+#include <mutex>
+#include <vector>
+
 namespace xrt::core::hip {
 
 // module_handle - opaque module handle
@@ -19,6 +22,7 @@ using function_handle = void*;
 
 // forward declaration
 class function;
+class memory;
 
 // hipModuleLoad load call of hip is used to load xclbin
 // hipModuleLoadData call is used to load elf
@@ -100,10 +104,28 @@ public:
 
 class function
 {
+public:
+  // Run object along with the argument values last set on it, so a
+  // launch only sets arguments that changed since the run was last
+  // used.  Global arguments are compared by memory object identity.
+  struct run_slot
+  {
+    xrt::run run;
+    std::vector<std::vector<char>> scalars;
+    std::vector<std::weak_ptr<memory>> globals;
+  };
+
+private:
+  // upper bound of idle runs kept for reuse
+  static constexpr size_t max_idle_runs = 8;
+
   module_xclbin* m_xclbin_module = nullptr;
   std::string m_func_name;
   xrt::kernel m_xrt_kernel;
 
+  std::mutex m_runs_mutex;
+  std::vector<run_slot> m_idle_runs;
+
 public:
   function() = default;
   function(module_xclbin* mod_hdl, const xrt::module& xrt_module, const std::string& name);
@@ -119,6 +141,14 @@ public:
   {
     return m_xrt_kernel;
   }
+
+  // Get an idle run of this function, or a new one if none is idle
+  run_slot
+  acquire_run();
+
+  // Return a run that is not in use for reuse by later launches
+  void
+  release_run(run_slot&& slot);
 };
 
 extern xrt_core::handle_map<module_handle, std::shared_ptr<module>> module_cache;
@@ -6,8 +6,15 @@
 
 #include "common.h"
 #include "event.h"
+#include "graph.h"
+#include "memory_pool.h"
 #include "stream.h"
 
+#include "core/common/config_reader.h"
+
+#include <map>
+#include <utility>
+
 namespace xrt::core::hip {
 stream::
 stream(std::shared_ptr<context> ctx, unsigned int flags, bool is_null)
@@ -29,6 +36,23 @@ void
 stream::
 enqueue(std::shared_ptr<command> cmd)
 {
+  std::shared_ptr<graph> capture_graph;
+  {
+    std::lock_guard<std::mutex> lock(m_cmd_lock);
+    capture_graph = m_capture_graph;
+  }
+
+  if (capture_graph) {
+    // captured commands are executed when the graph is launched, they
+    // are owned by the graph and not by the stream
+    throw_if(cmd->get_type() != command::type::kernel_start &&
+             cmd->get_type() != command::type::buffer_copy,
+             hipErrorStreamCaptureUnsupported, "operation not supported while stream is capturing");
+    command_cache.remove(cmd.get());
+    capture_graph->add_node(std::move(cmd));
+    return;
+  }
+
   // if there is top event add command chain list of this event
   // else submit the command
   if (m_top_event)
@@ -38,6 +62,7 @@ enqueue(std::shared_ptr<command> cmd)
 
   std::lock_guard<std::mutex> lock(m_cmd_lock);
   m_cmd_queue.emplace_back(std::move(cmd));
+  m_pending = m_cmd_queue.size();
 }
 
 std::shared_ptr<command>
@@ -50,6 +75,7 @@ dequeue()
   }
   auto cmd = m_cmd_queue.front();
   m_cmd_queue.pop_front();
+  m_pending = m_cmd_queue.size();
   return cmd;
 }
 
@@ -61,6 +87,7 @@ erase_cmd(std::shared_ptr<command> cmd)
   auto it = std::find(m_cmd_queue.begin(), m_cmd_queue.end(), cmd);
   if (it != m_cmd_queue.end()) {
     m_cmd_queue.erase(it);
+    m_pending = m_cmd_queue.size();
     return true;
   }
   return false;
@@ -70,6 +97,9 @@ void
 stream::
 enqueue_event(const std::shared_ptr<event>& ev)
 {
+  throw_if(is_capturing(), hipErrorStreamCaptureUnsupported,
+           "events not supported while stream is capturing");
+
   {
     // iterate over commands and add them to recorded list of event
     std::lock_guard<std::mutex> lock(m_cmd_lock);
@@ -93,7 +123,7 @@ synchronize_streams()
     // check if valid stream, stream is blocking
     // and stream is not current stream
     auto hip_stream = stream_cache.get(stream_handle);
-    if (!hip_stream)
+    if (!hip_stream || !hip_stream->has_pending())
      continue;
 
     if (!(hip_stream->flags() & hipStreamNonBlocking) && hip_stream.get() != this) {
@@ -120,6 +150,7 @@ await_completion()
     if (cmd->get_type() != command::type::event)
       command_cache.remove(cmd.get());
     m_cmd_queue.pop_front();
+    m_pending = m_cmd_queue.size();
   }
 }
 
@@ -127,6 +158,9 @@ void
 stream::
 synchronize()
 {
+  throw_if(is_capturing(), hipErrorStreamCaptureUnsupported,
+           "stream synchronize not permitted while stream is capturing");
+
   // synchronize among streams in this ctx
   synchronize_streams();
 
@@ -142,22 +176,116 @@ record_top_event(event* ev)
   m_top_event = ev;
 }
 
+void
+stream::
+begin_capture()
+{
+  std::lock_guard<std::mutex> lk(m_cmd_lock);
+  throw_if(m_capture_graph != nullptr, hipErrorIllegalState, "stream is already capturing");
+  m_capture_graph = std::make_shared<graph>();
+}
+
+std::shared_ptr<graph>
+stream::
+end_capture()
+{
+  std::lock_guard<std::mutex> lk(m_cmd_lock);
+  throw_if(m_capture_graph == nullptr, hipErrorIllegalState, "stream is not capturing");
+  return std::exchange(m_capture_graph, nullptr);
+}
+
+bool
+stream::
+is_capturing()
+{
+  std::lock_guard<std::mutex> lk(m_cmd_lock);
+  return m_capture_graph != nullptr;
+}
+
+std::shared_ptr<memory_pool>
+stream::
+get_mem_pool()
+{
+  std::lock_guard<std::mutex> lk(m_cmd_lock);
+  if (!m_mem_pool)
+    m_mem_pool = std::make_shared<memory_pool>(m_ctx->get_device());
+  return m_mem_pool;
+}
+
+namespace {
+
+// Default streams of the calling thread, one per context.  The
+// streams are owned by stream_cache so that other streams in the
+// context synchronize with them, they are removed from the cache
+// when the thread exits.
+struct per_thread_streams
+{
+  std::map<context*, std::weak_ptr<stream>> streams;
+
+  ~per_thread_streams()
+  {
+    for (auto& [ctx, weak] : streams)
+      if (auto s = weak.lock())
+        stream_cache.remove(s.get());
+  }
+};
+
+thread_local per_thread_streams tls_streams; //NOLINT
+
+std::shared_ptr<stream>
+get_per_thread_stream()
+{
+  auto ctx = get_current_context();
+  throw_context_destroyed_if(!ctx, "context is destroyed, no active context");
+
+  // the stream holds its context, so a context address in the map is
+  // not reused while the stream exists
+  auto& weak = tls_streams.streams[ctx.get()];
+  if (auto s = weak.lock())
+    return s;
+
+  auto s = std::make_shared<stream>(ctx, hipStreamDefault);
+  weak = s;
+  insert_in_map(stream_cache, std::move(s));
+  return weak.lock();
+}
+
+} // namespace
+
 std::shared_ptr<stream>
 get_stream(hipStream_t stream)
 {
+  // hipStreamPerThread, or null stream when configured as per thread
+  //we should override clang-tidy warning by adding NOLINT since hipStreamPerThread coming from hip, we dont have control
+  if (stream == hipStreamPerThread || //NOLINT
+      (!stream && xrt_core::config::get_hip_per_thread_default_stream()))
+    return get_per_thread_stream();
+
   // app did not pass stream, use legacy default stream (null stream)
   if (!stream) {
     auto ctx = get_current_context();
     throw_context_destroyed_if(!ctx, "context is destroyed, no active context");
     return ctx->get_null_stream();
   }
-  // TODO: Add support for per thread streams
-  // if (stream == hipStreamPerThread)
-  //   return get_per_thread_stream();
 
   return stream_cache.get(stream);
 }
 
+void
+synchronize_device()
+{
+  auto ctx = get_current_context();
+  throw_context_destroyed_if(!ctx, "context is destroyed, no active context");
+
+  // streams without pending commands are skipped without taking
+  // their command lock
+  for (auto stream_handle : ctx->get_stream_handles()) {
+    auto hip_stream = stream_cache.get(stream_handle);
+    if (hip_stream && hip_stream->has_pending())
+      hip_stream->await_completion();
+  }
+}
+
 // Global map of streams
 //we should override clang-tidy warning by adding NOLINT since stream_cache is non-const parameter
 xrt_core::handle_map<stream_handle, std::shared_ptr<stream>> stream_cache; //NOLINT
@@ -5,6 +5,7 @@
 
 #include "context.h"
 
+#include <atomic>
 #include <list>
 
 namespace xrt::core::hip {
@@ -12,6 +13,8 @@ namespace xrt::core::hip {
 // forward declarations
 class event;
 class command;
+class graph;
+class memory_pool;
 
 class stream
 {
@@ -21,8 +24,16 @@ class stream
 
   std::list<std::shared_ptr<command>> m_cmd_queue;
   std::mutex m_cmd_lock;
+  // number of commands in m_cmd_queue, read without the lock
+  std::atomic<size_t> m_pending{0};
   event* m_top_event{nullptr};
 
+  // graph receiving the enqueued commands while stream is capturing
+  std::shared_ptr<graph> m_capture_graph;
+
+  // pool for stream ordered allocations, created on first use
+  std::shared_ptr<memory_pool> m_mem_pool;
+
 public:
   stream() = default;
   stream(std::shared_ptr<context> ctx, unsigned int flags, bool is_null = false);
@@ -41,6 +52,13 @@ public:
     return m_flags;
   }
 
+  // true if the stream has commands not yet awaited
+  bool
+  has_pending() const
+  {
+    return m_pending.load() != 0;
+  }
+
   void
   enqueue(std::shared_ptr<command> cmd);
 
@@ -64,6 +82,18 @@ public:
 
   void
   record_top_event(event* ev);
+
+  void
+  begin_capture();
+
+  std::shared_ptr<graph>
+  end_capture();
+
+  bool
+  is_capturing();
+
+  std::shared_ptr<memory_pool>
+  get_mem_pool();
 };
 
 // Global map of streams
@@ -71,6 +101,10 @@ extern xrt_core::handle_map<stream_handle, std::shared_ptr<stream>> stream_cache
 
 std::shared_ptr<stream>
 get_stream(hipStream_t stream);
+
+// Wait for all streams of the current context with pending commands
+void
+synchronize_device();
 } // xrt::core::hip
 
 #endif
@@ -224,6 +224,7 @@ ub_package_list()
      systemtap-sdt-dev \
      unzip \
      uuid-dev \
+     zlib1g-dev \
     )
 
     if [ $docker == 0 ] && [ $sysroot == 0 ]; then
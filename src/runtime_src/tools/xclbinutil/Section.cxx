@@ -60,6 +60,7 @@ Section::Section()
     , m_pBuffer(nullptr)
     , m_bufferSize(0)
     , m_name("")
+    , m_bCompressed(false)
 {
   // Empty
 }
@@ -71,12 +72,40 @@ Section::~Section()
 
 void
 Section::purgeBuffers()
+{
+  if ((m_pBuffer != nullptr) && (m_sourceImage == nullptr))
+    delete[] m_pBuffer;
+
+  m_pBuffer = nullptr;
+  m_sourceImage.reset();
+  m_bufferSize = 0;
+}
+
+void
+Section::setSourceImage(const std::shared_ptr<XUtil::MappedFile>& _sourceImage)
 {
   if (m_pBuffer != nullptr) {
-    delete m_pBuffer;
-    m_pBuffer = nullptr;
+    std::string errMsg = "ERROR: Binary buffer already exists.";
+    throw std::runtime_error(errMsg);
   }
-  m_bufferSize = 0;
+
+  m_sourceImage = _sourceImage;
+}
+
+void
+Section::detachSourceImage()
+{
+  if (m_sourceImage == nullptr)
+    return;
+
+  char* pBuffer = nullptr;
+  if ((m_pBuffer != nullptr) && (m_bufferSize != 0)) {
+    pBuffer = new char[m_bufferSize];
+    memcpy(pBuffer, m_pBuffer, m_bufferSize);
+  }
+
+  m_pBuffer = pBuffer;
+  m_sourceImage.reset();
 }
 
 void
@@ -85,6 +114,18 @@ Section::setName(const std::string& _sSectionName)
   m_name = _sSectionName;
 }
 
+void
+Section::setCompressed(bool _bCompressed)
+{
+  m_bCompressed = _bCompressed;
+}
+
+bool
+Section::isCompressed() const
+{
+  return m_bCompressed;
+}
+
 std::vector<std::string>
 Section::getSupportedKinds()
 {
@@ -321,7 +362,6 @@ Section::writeXclBinSectionBuffer(std::ostream& _ostream) const
   }
 
   _ostream.write(m_pBuffer, m_bufferSize);
-  _ostream.flush();
 }
 
 void
@@ -348,15 +388,28 @@ Section::readXclBinBinary(std::istream& _istream, const axlf_section_header& _se
 
   m_bufferSize = (unsigned int)_sectionHeader.m_sectionSize;
 
-  m_pBuffer = new char[m_bufferSize];
+  // Reference the payload in the mapped image rather than copying it
+  if (m_sourceImage != nullptr) {
+    if ((_sectionHeader.m_sectionOffset > m_sourceImage->size()) ||
+        (m_bufferSize > m_sourceImage->size() - _sectionHeader.m_sectionOffset)) {
+      m_sourceImage.reset();
+      m_bufferSize = 0;
+      std::string errMsg = "ERROR: Input stream for the binary buffer is smaller then the expected size.";
+      throw std::runtime_error(errMsg);
+    }
 
-  _istream.seekg(_sectionHeader.m_sectionOffset);
+    m_pBuffer = m_sourceImage->data() + _sectionHeader.m_sectionOffset;
+  } else {
+    m_pBuffer = new char[m_bufferSize];
 
-  _istream.read(m_pBuffer, m_bufferSize);
+    _istream.seekg(_sectionHeader.m_sectionOffset);
 
-  if (_istream.gcount() != (std::streamsize)m_bufferSize) {
-    std::string errMsg = "ERROR: Input stream for the binary buffer is smaller then the expected size.";
-    throw std::runtime_error(errMsg);
+    _istream.read(m_pBuffer, m_bufferSize);
+
+    if (_istream.gcount() != (std::streamsize)m_bufferSize) {
+      std::string errMsg = "ERROR: Input stream for the binary buffer is smaller then the expected size.";
+      throw std::runtime_error(errMsg);
+    }
   }
 
   XUtil::TRACE(boost::format("Section: %s (%d)") % getSectionKindAsString() % (unsigned int)getSectionKind());
@@ -681,11 +734,7 @@ Section::readSubPayload(std::istream& _istream,
   readSubPayload(m_pBuffer, m_bufferSize, _istream, _sSubSection, _eFormatType, buffer);
 
   // Now for some how cleaning
-  if (m_pBuffer != nullptr) {
-    delete m_pBuffer;
-    m_pBuffer = nullptr;
-    m_bufferSize = 0;
-  }
+  purgeBuffers();
 
   m_bufferSize = (unsigned int)buffer.tellp();
 
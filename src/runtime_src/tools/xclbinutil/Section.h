@@ -29,6 +29,9 @@
 #include <memory>
 #include <string>
 #include <vector>
+
+namespace XclBinUtilities { class MappedFile; }
+
 // ------------------- C L A S S :   S e c t i o n ---------------------------
 
 class Section {
@@ -113,7 +116,11 @@ class Section {
 
   void getPayload(boost::property_tree::ptree& _pt) const;
   void purgeBuffers();
+  void setSourceImage(const std::shared_ptr<XclBinUtilities::MappedFile>& _sourceImage);
+  void detachSourceImage();
   void setName(const std::string& _sSectionName);
+  void setCompressed(bool _bCompressed);
+  bool isCompressed() const;
   void setPathAndName(const std::string& _pathAndName);
   const std::string& getPathAndName() const;
 
@@ -135,8 +142,14 @@ class Section {
 
   char* m_pBuffer;
   unsigned int m_bufferSize;
+
+  // When set, m_pBuffer points into this mapped image and is not owned
+  std::shared_ptr<XclBinUtilities::MappedFile> m_sourceImage;
   std::string m_name;
 
+  // Written to the xclbin image as a compressed section
+  bool m_bCompressed;
+
   std::string m_pathAndName;
 
  private:
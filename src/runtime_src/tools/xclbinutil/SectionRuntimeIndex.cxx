@@ -0,0 +1,430 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "SectionRuntimeIndex.h"
+
+#include "XclBinUtilities.h"
+#include <algorithm>
+#include <array>
+#include <boost/format.hpp>
+#include <boost/functional/factory.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <vector>
+
+namespace XUtil = XclBinUtilities;
+
+// Static Variables / Classes
+SectionRuntimeIndex::init SectionRuntimeIndex::initializer;
+
+SectionRuntimeIndex::init::init()
+{
+  auto sectionInfo = std::make_unique<SectionInfo>(RUNTIME_INDEX, "RUNTIME_INDEX", boost::factory<SectionRuntimeIndex*>());
+  sectionInfo->nodeName = "runtime_index";
+
+  sectionInfo->supportedAddFormats.push_back(FormatType::raw);
+
+  sectionInfo->supportedDumpFormats.push_back(FormatType::json);
+  sectionInfo->supportedDumpFormats.push_back(FormatType::html);
+  sectionInfo->supportedDumpFormats.push_back(FormatType::raw);
+
+  addSectionType(std::move(sectionInfo));
+}
+
+// The index must resolve the XML exactly as the runtime parser does
+// (see core/common/xclbin_parser.cpp), including which attributes are
+// required.  A missing required attribute fails the index creation.
+namespace {
+
+namespace pt = boost::property_tree;
+
+// FNV-1a 64 bit hash identifying the indexed XML meta data
+uint64_t
+getMetadataHash(const std::string& sData)
+{
+  uint64_t hash = 0xcbf29ce484222325;
+  for (unsigned char c : sData) {
+    hash ^= c;
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+uint64_t
+convert(const std::string& str)
+{
+  return str.empty() ? 0 : std::stoull(str, nullptr, 0);
+}
+
+uint8_t
+toKernelType(const std::string& str)
+{
+  if (str == "pl")
+    return 1;
+  if (str == "ps")
+    return 2;
+  if (str == "dpu")
+    return 3;
+  return 0;
+}
+
+uint8_t
+toMailboxType(const std::string& str)
+{
+  static const std::map<std::string, uint8_t> table = {
+    { "none", 0 }, { "in", 1 }, { "out", 2 }, { "inout", 3 },
+    { "both", 3 }, { "true", 3 }, { "false", 0 },
+  };
+
+  auto itr = table.find(str);
+  if (itr == table.end())
+    throw std::runtime_error("ERROR: Invalid kernel mailbox property '" + str + "'");
+  return itr->second;
+}
+
+uint64_t
+getExtendedData(const pt::ptree& ptKernel, const std::string& attribute)
+{
+  for (const auto& elem : ptKernel) {
+    if (elem.first == "extended-data")
+      return convert(elem.second.get<std::string>("<xmlattr>." + attribute));
+  }
+  return 0;
+}
+
+uint64_t
+getAddressRange(const pt::ptree& ptKernel)
+{
+  for (const auto& port : ptKernel) {
+    if (port.first != "port")
+      continue;
+
+    // one AXI slave port per kernel
+    if (port.second.get<std::string>("<xmlattr>.mode") == "slave")
+      return convert(port.second.get<std::string>("<xmlattr>.range"));
+  }
+  return 64 * 1024;
+}
+
+void
+getXYZ(const pt::ptree& ptKernel, const std::string& element, uint64_t (&xyz)[3])
+{
+  xyz[0] = xyz[1] = xyz[2] = 0;
+  for (const auto& elem : ptKernel) {
+    if (elem.first != element)
+      continue;
+
+    xyz[0] = convert(elem.second.get<std::string>("<xmlattr>.x"));
+    xyz[1] = convert(elem.second.get<std::string>("<xmlattr>.y"));
+    xyz[2] = convert(elem.second.get<std::string>("<xmlattr>.z"));
+    return;
+  }
+}
+
+// Intermediate argument with unresolved string offsets
+struct IndexArg {
+  std::string name;
+  std::string hostType;
+  std::string port;
+  uint64_t index;
+  uint64_t portWidth;
+  uint64_t offset;
+  uint64_t size;
+  uint64_t hostSize;
+  uint8_t addressQualifier;
+};
+
+constexpr uint64_t noIndex = std::numeric_limits<uint64_t>::max();
+
+std::vector<IndexArg>
+getArgs(const pt::ptree& ptKernel)
+{
+  std::map<std::string, uint64_t> portWidths;
+  for (const auto& port : ptKernel) {
+    if (port.first != "port")
+      continue;
+
+    auto name = port.second.get<std::string>("<xmlattr>.name", "");
+    auto width = port.second.get<std::string>("<xmlattr>.dataWidth", "");
+    if (!name.empty() && !width.empty())
+      portWidths.emplace(name, convert(width));
+  }
+
+  std::vector<IndexArg> args;
+  for (const auto& ptArg : ptKernel) {
+    if (ptArg.first != "arg")
+      continue;
+
+    auto id = ptArg.second.get<std::string>("<xmlattr>.id");
+    auto port = ptArg.second.get<std::string>("<xmlattr>.port", "no-port");
+    auto itr = portWidths.find(port);
+
+    args.push_back(IndexArg{
+        ptArg.second.get<std::string>("<xmlattr>.name")
+      , ptArg.second.get<std::string>("<xmlattr>.type", "no-type")
+      , port
+      , id.empty() ? noIndex : convert(id)
+      , (itr != portWidths.end()) ? itr->second : 0
+      , convert(ptArg.second.get<std::string>("<xmlattr>.offset"))
+      , convert(ptArg.second.get<std::string>("<xmlattr>.size"))
+      , convert(ptArg.second.get<std::string>("<xmlattr>.hostSize"))
+      , static_cast<uint8_t>(ptArg.second.get<size_t>("<xmlattr>.addressQualifier"))
+    });
+  }
+
+  // Preserve the order of multi-component arguments, then merge the
+  // components into the first one
+  std::stable_sort(args.begin(), args.end(), [](const auto& a1, const auto& a2) { return a1.index < a2.index; });
+  for (size_t idx = 0; idx < args.size() && args[idx].index != noIndex; ++idx) {
+    auto& arg = args[idx];
+    auto next = idx + 1;
+    for (; next < args.size() && args[next].index == arg.index; ++next) {
+      arg.size += args[next].size;
+      arg.hostSize += args[next].hostSize;
+      arg.offset = std::min(arg.offset, args[next].offset);
+    }
+    args.erase(args.begin() + idx + 1, args.begin() + next);
+  }
+
+  for (size_t idx = 0; idx < args.size(); ++idx) {
+    if (args[idx].index != idx && args[idx].index != noIndex)
+      throw std::runtime_error("ERROR: Mismatched argument index in kernel '" + ptKernel.get<std::string>("<xmlattr>.name") + "'");
+  }
+
+  return args;
+}
+
+// String blob with de-duplicated null terminated strings
+class StringBlob {
+  std::string m_blob;
+  std::map<std::string, uint32_t> m_offsets;
+
+ public:
+  uint32_t add(const std::string& str)
+  {
+    auto itr = m_offsets.find(str);
+    if (itr != m_offsets.end())
+      return itr->second;
+
+    auto offset = static_cast<uint32_t>(m_blob.size());
+    m_blob.append(str).push_back('\0');
+    m_offsets.emplace(str, offset);
+    return offset;
+  }
+
+  const std::string& data() const { return m_blob; }
+};
+
+std::string
+getString(const char* pData, unsigned int size, uint32_t offset)
+{
+  if (offset >= size)
+    throw std::runtime_error("ERROR: RUNTIME_INDEX string offset out of range");
+
+  auto pEnd = static_cast<const char*>(std::memchr(pData + offset, '\0', size - offset));
+  if (pEnd == nullptr)
+    throw std::runtime_error("ERROR: RUNTIME_INDEX string not terminated");
+
+  return std::string(pData + offset, pEnd);
+}
+
+template <typename T>
+const T*
+getArray(const char* pData, unsigned int size, const array_offset& array)
+{
+  if ((array.offset > size) || (array.size > (size - array.offset) / sizeof(T)))
+    throw std::runtime_error("ERROR: RUNTIME_INDEX array out of range");
+
+  return reinterpret_cast<const T*>(pData + array.offset);
+}
+
+} // namespace
+
+void
+SectionRuntimeIndex::createIndex(const std::string& sXmlMetadata, std::ostream& buf)
+{
+  XUtil::TRACE("Creating RUNTIME_INDEX");
+
+  pt::ptree ptXml;
+  std::stringstream ss(sXmlMetadata);
+  pt::read_xml(ss, ptXml);
+
+  StringBlob strings;
+  std::vector<runtime_index_kernel> kernels;
+  std::vector<runtime_index_arg> args;
+  std::vector<runtime_index_string> stringTable;
+
+  // String offsets are relative to the blob until the layout is known
+  for (const auto& ptKernel : ptXml.get_child("project.platform.device.core")) {
+    if (ptKernel.first != "kernel")
+      continue;
+
+    const auto& ptK = ptKernel.second;
+    auto kernel = runtime_index_kernel{};
+    kernel.name = strings.add(ptK.get<std::string>("<xmlattr>.name"));
+    kernel.type = toKernelType(ptK.get<std::string>("<xmlattr>.type", "pl"));
+    kernel.mailbox = toMailboxType(ptK.get<std::string>("<xmlattr>.mailbox", "none"));
+    kernel.sw_reset = ptK.get<std::string>("<xmlattr>.swReset", "false") == "true";
+    kernel.counted_auto_restart = convert(ptK.get<std::string>("<xmlattr>.countedAutoRestart", "0"));
+    kernel.address_range = getAddressRange(ptK);
+    kernel.functional = getExtendedData(ptK, "functional");
+    kernel.kernel_id = getExtendedData(ptK, "dpu_kernel_id");
+    kernel.workgroup_size = convert(ptK.get<std::string>("<xmlattr>.workGroupSize", "0"));
+    getXYZ(ptK, "compileWorkGroupSize", kernel.compile_workgroup_size);
+    getXYZ(ptK, "maxWorkGroupSize", kernel.max_workgroup_size);
+
+    // Arguments
+    kernel.args.offset = static_cast<uint32_t>(args.size());
+    for (const auto& arg : getArgs(ptK)) {
+      auto xarg = runtime_index_arg{};
+      xarg.name = strings.add(arg.name);
+      xarg.host_type = strings.add(arg.hostType);
+      xarg.port = strings.add(arg.port);
+      xarg.index = (arg.index == noIndex) ? RUNTIME_INDEX_NO_INDEX : static_cast<uint32_t>(arg.index);
+      xarg.port_width = arg.portWidth;
+      xarg.offset = arg.offset;
+      xarg.size = arg.size;
+      xarg.host_size = arg.hostSize;
+      xarg.address_qualifier = arg.addressQualifier;
+      args.push_back(xarg);
+    }
+    kernel.args.size = static_cast<uint32_t>(args.size()) - kernel.args.offset;
+
+    // String table, ordered by id
+    std::map<uint32_t, std::string> ptStrings;
+    for (const auto& ptTable : ptK) {
+      if (ptTable.first != "string_table")
+        continue;
+
+      for (const auto& ptFormat : ptTable.second) {
+        if (ptFormat.first == "format_string")
+          ptStrings.emplace(ptFormat.second.get<uint32_t>("<xmlattr>.id"), ptFormat.second.get<std::string>("<xmlattr>.value"));
+      }
+    }
+
+    kernel.string_table.offset = static_cast<uint32_t>(stringTable.size());
+    for (const auto& entry : ptStrings)
+      stringTable.push_back(runtime_index_string{entry.first, strings.add(entry.second)});
+    kernel.string_table.size = static_cast<uint32_t>(stringTable.size()) - kernel.string_table.offset;
+
+    kernels.push_back(kernel);
+    XUtil::TRACE(boost::format("  kernel: %s, args: %d") % ptK.get<std::string>("<xmlattr>.name") % kernel.args.size);
+  }
+
+  auto header = runtime_index{};
+  header.schema_version = RUNTIME_INDEX_SCHEMA_VERSION;
+  header.metadata_size = sXmlMetadata.size();
+  header.metadata_hash = getMetadataHash(sXmlMetadata);
+  header.project_name = strings.add(ptXml.get<std::string>("project.<xmlattr>.name", ""));
+  header.fpga_device_name = strings.add(ptXml.get<std::string>("project.platform.device.<xmlattr>.fpgaDevice", ""));
+
+  // Layout: header, kernels, arguments, string tables, strings
+  const uint64_t kernelsOffset = sizeof(runtime_index);
+  const uint64_t argsOffset = kernelsOffset + kernels.size() * sizeof(runtime_index_kernel);
+  const uint64_t stringTableOffset = argsOffset + args.size() * sizeof(runtime_index_arg);
+  const uint64_t stringsOffset = stringTableOffset + stringTable.size() * sizeof(runtime_index_string);
+  if (stringsOffset + strings.data().size() > std::numeric_limits<uint32_t>::max())
+    throw std::runtime_error("ERROR: RUNTIME_INDEX exceeds the maximum section size");
+
+  const auto stringBase = static_cast<uint32_t>(stringsOffset);
+  header.project_name += stringBase;
+  header.fpga_device_name += stringBase;
+  header.kernels = array_offset{static_cast<uint32_t>(kernels.size()), static_cast<uint32_t>(kernelsOffset)};
+
+  for (auto& kernel : kernels) {
+    kernel.name += stringBase;
+    kernel.args.offset = static_cast<uint32_t>(argsOffset + kernel.args.offset * sizeof(runtime_index_arg));
+    kernel.string_table.offset = static_cast<uint32_t>(stringTableOffset + kernel.string_table.offset * sizeof(runtime_index_string));
+  }
+
+  for (auto& arg : args) {
+    arg.name += stringBase;
+    arg.host_type += stringBase;
+    arg.port += stringBase;
+  }
+
+  for (auto& entry : stringTable)
+    entry.value += stringBase;
+
+  buf.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  buf.write(reinterpret_cast<const char*>(kernels.data()), kernels.size() * sizeof(runtime_index_kernel));
+  buf.write(reinterpret_cast<const char*>(args.data()), args.size() * sizeof(runtime_index_arg));
+  buf.write(reinterpret_cast<const char*>(stringTable.data()), stringTable.size() * sizeof(runtime_index_string));
+  buf.write(strings.data().data(), strings.data().size());
+}
+
+void
+SectionRuntimeIndex::marshalToJSON(char* pDataSection,
+                                   unsigned int sectionSize,
+                                   boost::property_tree::ptree& ptree) const
+{
+  XUtil::TRACE("");
+  XUtil::TRACE("Extracting: RUNTIME_INDEX");
+  XUtil::TRACE_BUF("RUNTIME_INDEX Section Buffer", reinterpret_cast<const char*>(pDataSection), sectionSize);
+
+  if (sectionSize < sizeof(runtime_index)) {
+    auto errMsg = boost::format("ERROR: Section size (%d) is smaller than the size of the runtime_index structure (%d)")
+                                % sectionSize % sizeof(runtime_index);
+    throw std::runtime_error(errMsg.str());
+  }
+
+  auto pHdr = reinterpret_cast<const runtime_index*>(pDataSection);
+
+  boost::property_tree::ptree ptIndex;
+  ptIndex.put("schema_version", (unsigned int)pHdr->schema_version);
+  ptIndex.put("metadata_size", pHdr->metadata_size);
+  ptIndex.put("metadata_hash", (boost::format("0x%lx") % pHdr->metadata_hash).str());
+  ptIndex.put("project_name", getString(pDataSection, sectionSize, pHdr->project_name));
+  ptIndex.put("fpga_device_name", getString(pDataSection, sectionSize, pHdr->fpga_device_name));
+
+  boost::property_tree::ptree ptKernels;
+  auto pKernels = getArray<runtime_index_kernel>(pDataSection, sectionSize, pHdr->kernels);
+  for (uint32_t kidx = 0; kidx < pHdr->kernels.size; ++kidx) {
+    const auto& kernel = pKernels[kidx];
+    boost::property_tree::ptree ptKernel;
+    ptKernel.put("name", getString(pDataSection, sectionSize, kernel.name));
+    ptKernel.put("type", (unsigned int)kernel.type);
+    ptKernel.put("mailbox", (unsigned int)kernel.mailbox);
+    ptKernel.put("sw_reset", kernel.sw_reset ? "true" : "false");
+    ptKernel.put("counted_auto_restart", kernel.counted_auto_restart);
+    ptKernel.put("address_range", (boost::format("0x%lx") % kernel.address_range).str());
+    ptKernel.put("functional", kernel.functional);
+    ptKernel.put("kernel_id", kernel.kernel_id);
+
+    boost::property_tree::ptree ptArgs;
+    auto pArgs = getArray<runtime_index_arg>(pDataSection, sectionSize, kernel.args);
+    for (uint32_t aidx = 0; aidx < kernel.args.size; ++aidx) {
+      const auto& arg = pArgs[aidx];
+      boost::property_tree::ptree ptArg;
+      ptArg.put("name", getString(pDataSection, sectionSize, arg.name));
+      ptArg.put("index", arg.index == RUNTIME_INDEX_NO_INDEX ? std::string("none") : std::to_string(arg.index));
+      ptArg.put("host_type", getString(pDataSection, sectionSize, arg.host_type));
+      ptArg.put("port", getString(pDataSection, sectionSize, arg.port));
+      ptArg.put("offset", (boost::format("0x%lx") % arg.offset).str());
+      ptArg.put("size", (boost::format("0x%lx") % arg.size).str());
+      ptArg.put("host_size", (boost::format("0x%lx") % arg.host_size).str());
+      ptArg.put("address_qualifier", (unsigned int)arg.address_qualifier);
+      ptArgs.push_back({"", ptArg});
+    }
+    ptKernel.add_child("args", ptArgs);
+    ptKernels.push_back({"", ptKernel});
+  }
+  ptIndex.add_child("kernels", ptKernels);
+
+  ptree.add_child("runtime_index", ptIndex);
+}
@@ -0,0 +1,42 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __SectionRuntimeIndex_h_
+#define __SectionRuntimeIndex_h_
+
+// ----------------------- I N C L U D E S -----------------------------------
+#include "Section.h"
+
+#include <string>
+
+// --------- C L A S S :   S e c t i o n R u n t i m e I n d e x -------------
+class SectionRuntimeIndex : public Section {
+ public:
+  // Creates the RUNTIME_INDEX image of the given EMBEDDED_METADATA
+  static void createIndex(const std::string& sXmlMetadata, std::ostream& buf);
+
+ protected:
+  void marshalToJSON(char* pDataSection, unsigned int sectionSize, boost::property_tree::ptree& ptree) const override;
+
+ private:
+  // Static initializer helper class
+  static class init {
+   public:
+    init();
+  } initializer;
+};
+
+#endif
@@ -153,16 +153,65 @@ XclBin::readXclBinBinarySections(std::fstream& _istream)
       throw std::runtime_error(errMsg);
     }
 
+    if (sectionHeader.m_sectionKind & AXLF_SECTION_COMPRESSED) {
+      readXclBinCompressedSection(_istream, sectionHeader);
+      continue;
+    }
+
     Section* pSection = Section::createSectionObjectOfKind((enum axlf_section_kind)sectionHeader.m_sectionKind);
 
     // Here for testing purposes, when all segments are supported it should be removed
     if (pSection != nullptr) {
+      if (auto sourceImage = m_sourceImage.lock())
+        pSection->setSourceImage(sourceImage);
       pSection->readXclBinBinary(_istream, sectionHeader);
       addSection(pSection);
     }
   }
 }
 
+void
+XclBin::readXclBinCompressedSection(std::fstream& _istream,
+                                    const axlf_section_header& _sectionHeader)
+{
+  XUtil::TRACE(boost::format("Reading compressed section: %d") % (_sectionHeader.m_sectionKind & ~AXLF_SECTION_COMPRESSED));
+
+  // Decompress the payload straight from the mapped image when available
+  std::ostringstream buffer;
+  auto sourceImage = m_sourceImage.lock();
+  if (sourceImage) {
+    if ((_sectionHeader.m_sectionOffset > sourceImage->size()) ||
+        (_sectionHeader.m_sectionSize > sourceImage->size() - _sectionHeader.m_sectionOffset)) {
+      std::string errMsg = "ERROR: Input stream is smaller than the expected compressed section size.";
+      throw std::runtime_error(errMsg);
+    }
+
+    XUtil::decompressSectionBuffer(sourceImage->data() + _sectionHeader.m_sectionOffset, _sectionHeader.m_sectionSize, buffer);
+  } else {
+    std::vector<char> compressedData(_sectionHeader.m_sectionSize);
+    _istream.seekg(_sectionHeader.m_sectionOffset);
+    _istream.read(compressedData.data(), compressedData.size());
+    if (_istream.gcount() != (std::streamsize)compressedData.size()) {
+      std::string errMsg = "ERROR: Input stream is smaller than the expected compressed section size.";
+      throw std::runtime_error(errMsg);
+    }
+
+    XUtil::decompressSectionBuffer(compressedData.data(), compressedData.size(), buffer);
+  }
+
+  // Read the section as if it was stored uncompressed
+  axlf_section_header sectionHeader = _sectionHeader;
+  sectionHeader.m_sectionKind &= ~AXLF_SECTION_COMPRESSED;
+  sectionHeader.m_sectionOffset = 0;
+  sectionHeader.m_sectionSize = (uint64_t)buffer.tellp();
+
+  std::istringstream iBuffer(buffer.str());
+  Section* pSection = Section::createSectionObjectOfKind((enum axlf_section_kind)sectionHeader.m_sectionKind);
+  pSection->readXclBinBinary(iBuffer, sectionHeader);
+  pSection->setCompressed(true);
+  addSection(pSection);
+}
+
 void
 XclBin::readXclBinBinary(const std::string& _binaryFileName,
                          bool _bMigrate)
@@ -192,6 +241,11 @@ XclBin::readXclBinBinary(const std::string& _binaryFileName,
     // Read in the header
     readXclBinBinaryHeader(ifXclBin);
 
+    // Map the image so that the section payloads are not copied, the
+    // mapping is released with the last section referencing it
+    auto sourceImage = XUtil::MappedFile::create(_binaryFileName);
+    m_sourceImage = sourceImage;
+
     // Read the sections
     readXclBinBinarySections(ifXclBin);
   }
@@ -232,7 +286,6 @@ XclBin::writeXclBinBinaryHeader(std::ostream& _ostream, boost::property_tree::pt
   // Write the header (minus the section header array)
   XUtil::TRACE("Writing xclbin binary header");
   _ostream.write((char*)&m_xclBinHeader, sizeof(axlf) - sizeof(axlf_section_header));
-  _ostream.flush();
 
   // Get mirror data
   boost::property_tree::ptree pt_header;
@@ -254,6 +307,21 @@ XclBin::writeXclBinBinarySections(std::ostream& _ostream, boost::property_tree::
   struct axlf_section_header* sectionHeader = new struct axlf_section_header[m_sections.size()];
   memset(sectionHeader, 0, sizeof(struct axlf_section_header) * m_sections.size());  // Zero out memory
 
+  // Compress the sections up front, the compressed sizes determine the offsets
+  std::vector<std::string> compressedBuffers(m_sections.size());
+  for (unsigned int index = 0; index < m_sections.size(); ++index) {
+    if (!m_sections[index]->isCompressed())
+      continue;
+
+    std::ostringstream buffer;
+    m_sections[index]->writeXclBinSectionBuffer(buffer);
+    const std::string& sBuffer = buffer.str();
+
+    std::ostringstream compressedBuffer;
+    XUtil::compressSectionBuffer(sBuffer.data(), sBuffer.size(), compressedBuffer);
+    compressedBuffers[index] = compressedBuffer.str();
+  }
+
   // Populate the array size and offsets
   uint64_t currentOffset = (uint64_t)(sizeof(axlf) - sizeof(axlf_section_header) + (sizeof(axlf_section_header) * m_sections.size()));
 
@@ -263,25 +331,27 @@ XclBin::writeXclBinBinarySections(std::ostream& _ostream, boost::property_tree::
 
     // Initialize section header
     m_sections[index]->initXclBinSectionHeader(sectionHeader[index]);
+    if (m_sections[index]->isCompressed()) {
+      sectionHeader[index].m_sectionKind |= AXLF_SECTION_COMPRESSED;
+      sectionHeader[index].m_sectionSize = compressedBuffers[index].size();
+    }
     sectionHeader[index].m_sectionOffset = currentOffset;
     currentOffset += (uint64_t)sectionHeader[index].m_sectionSize;
   }
 
   XUtil::TRACE("Writing xclbin section header array");
   _ostream.write((char*)sectionHeader, sizeof(axlf_section_header) * m_sections.size());
-  _ostream.flush();
 
   // Write out each of the sections
   for (unsigned int index = 0; index < m_sections.size(); ++index) {
     XUtil::TRACE(boost::format("Writing section: Index: %d, ID: %d") % index % sectionHeader[index].m_sectionKind);
 
     // Align section to next 8 byte boundary
-    unsigned int runningOffset = (unsigned int)_ostream.tellp();
+    uint64_t runningOffset = (uint64_t)_ostream.tellp();
     unsigned int bytePadding = XUtil::bytesToAlign(runningOffset);
     if (bytePadding != 0) {
       static const char holePack[] = { (char)0, (char)0, (char)0, (char)0, (char)0, (char)0, (char)0, (char)0 };
       _ostream.write(holePack, bytePadding);
-      _ostream.flush();
     }
     runningOffset += bytePadding;
 
@@ -292,7 +362,10 @@ XclBin::writeXclBinBinarySections(std::ostream& _ostream, boost::property_tree::
     }
 
     // Write buffer
-    m_sections[index]->writeXclBinSectionBuffer(_ostream);
+    if (m_sections[index]->isCompressed())
+      _ostream.write(compressedBuffers[index].data(), compressedBuffers[index].size());
+    else
+      m_sections[index]->writeXclBinSectionBuffer(_ostream);
 
     // Write mirror data
     {
@@ -368,9 +441,24 @@ XclBin::writeXclBinBinary(const std::string& _binaryFileName,
     throw std::runtime_error(errMsg);
   }
 
-  // Write the xclbin file image
+  // Sections still referencing the mapped input image must own their
+  // payload before the output truncates that same file
+  if (auto sourceImage = m_sourceImage.lock()) {
+    std::error_code ec;
+    if (std::filesystem::equivalent(sourceImage->fileName(), _binaryFileName, ec)) {
+      XUtil::TRACE("Output file is the input file, detaching sections from the input image");
+      for (auto pSection : m_sections)
+        pSection->detachSourceImage();
+    }
+  }
+
+  // Write the xclbin file image through a large buffer, the payloads
+  // are written without intermediate flushes
   XUtil::TRACE("Writing the xclbin binary file: " + _binaryFileName);
+  static constexpr size_t writeBufferSize = 1024 * 1024;
+  std::vector<char> writeBuffer(writeBufferSize);
   std::fstream ofXclBin;
+  ofXclBin.rdbuf()->pubsetbuf(writeBuffer.data(), writeBuffer.size());
   ofXclBin.open(_binaryFileName, std::ifstream::out | std::ifstream::binary);
   if (!ofXclBin.is_open()) {
     std::string errMsg = "ERROR: Unable to open the file for writing: " + _binaryFileName;
@@ -770,6 +858,27 @@ XclBin::findSection(enum axlf_section_kind _eKind,
   return vSections;
 }
 
+void
+XclBin::compressSection(const std::string& _sSectionToCompress)
+{
+  XUtil::TRACE("Compressing Section: " + _sSectionToCompress);
+
+  enum axlf_section_kind eKind;
+  Section::translateSectionKindStrToKind(_sSectionToCompress, eKind);
+
+  // All indexed sections of the given kind are compressed
+  auto sections = findSection(eKind, true /*ignoreIndex*/);
+  if (sections.empty()) {
+    auto errMsg = boost::format("ERROR: Section '%s' is not part of the xclbin archive.") % _sSectionToCompress;
+    throw std::runtime_error(errMsg.str());
+  }
+
+  for (auto pSection : sections)
+    pSection->setCompressed(true);
+
+  XUtil::QUIET(boost::format("Section: '%s'(%d) will be written compressed.") % _sSectionToCompress % (unsigned int)eKind);
+}
+
 void
 XclBin::removeSection(const std::string& _sSectionToRemove)
 {
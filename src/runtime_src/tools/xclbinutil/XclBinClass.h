@@ -20,6 +20,7 @@
 
 #include <string>
 #include <fstream>
+#include <memory>
 #include <vector>
 #include <boost/property_tree/ptree.hpp>
 
@@ -27,6 +28,7 @@
 #include "ParameterSectionData.h"
 
 class Section;
+namespace XclBinUtilities { class MappedFile; }
 
 class XclBin {
  public:
@@ -47,6 +49,7 @@ class XclBin {
   void readXclBinBinary(const std::string &_binaryFileName, bool _bMigrate = false);
   void writeXclBinBinary(const std::string &_binaryFileName, bool _bSkipUUIDInsertion);
   void removeSection(const std::string & _sSectionToRemove);
+  void compressSection(const std::string & _sSectionToCompress);
   void addSection(ParameterSectionData &_PSD);
   void addReplaceSection(ParameterSectionData &_PSD);
   void addMergeSection(ParameterSectionData &_PSD);
@@ -75,6 +78,7 @@ class XclBin {
   void updateHeaderFromSection(Section *_pSection);
   void readXclBinBinaryHeader(std::fstream& _istream);
   void readXclBinBinarySections(std::fstream& _istream);
+  void readXclBinCompressedSection(std::fstream& _istream, const axlf_section_header& _sectionHeader);
 
   void findAndReadMirrorData(std::fstream& _istream, boost::property_tree::ptree& _mirrorData) const;
   void readXclBinaryMirrorImage(std::fstream& _istream, const boost::property_tree::ptree& _mirrorData);
@@ -108,6 +112,9 @@ class XclBin {
   std::vector<Section*> m_sections;
   axlf m_xclBinHeader;
 
+  // Image the sections were read from, sections reference it directly
+  std::weak_ptr<XclBinUtilities::MappedFile> m_sourceImage;
+
  protected:
   SchemaVersion m_SchemaVersionMirrorWrite;
 };
@@ -131,6 +131,7 @@ void insertTargetMode(const std::string & _sTarget, std::vector<std::string> & _
 
 // Program entry point
 int main_(int argc, const char** argv) {
+  bool bAddRuntimeIndex = false;
   bool bForce = false;
   bool bGetSignature = false;
   bool bListNames = false;
@@ -150,6 +151,7 @@ int main_(int argc, const char** argv) {
   std::string sSignature;
   std::string sTarget;
   std::vector<std::string> addPsKernels;
+  std::vector<std::string> sectionsToCompress;
   std::vector<std::string> keysToRemove;
   std::vector<std::string> keyValuePairs;
   std::vector<std::string> sectionsToAdd;
@@ -167,9 +169,11 @@ int main_(int argc, const char** argv) {
       ("add-merge-section", boost::program_options::value<decltype(sectionsToAddMerge)>(&sectionsToAddMerge)->multitoken(), "Section name to add or merge.  Format: <section>:<format>:<file>")
       ("add-pskernel", boost::program_options::value<decltype(addPsKernels)>(&addPsKernels)->multitoken(), "Helper option to add PS kernels.  Format: [<mem_banks>]:[<symbol_name>]:[<instances>]:<path_to_shared_library>")
       ("add-replace-section", boost::program_options::value<decltype(sectionsToAddReplace)>(&sectionsToAddReplace)->multitoken(), "Section name to add or replace.  Format: <section>:<format>:<file>")
+      ("add-runtime-index", boost::program_options::bool_switch(&bAddRuntimeIndex), "Adds (or replaces) the RUNTIME_INDEX section with the kernel meta data pre-resolved from EMBEDDED_METADATA.")
       ("add-section", boost::program_options::value<decltype(sectionsToAdd)>(&sectionsToAdd)->multitoken(), "Section name to add.  Format: <section>:<format>:<file>")
       ("add-signature", boost::program_options::value<decltype(sSignature)>(&sSignature), "Adds a user defined signature to the given xclbin image.")
       ("certificate", boost::program_options::value<decltype(sCertificate)>(&sCertificate), "Certificate used in signing and validating the xclbin image.")
+      ("compress-section", boost::program_options::value<decltype(sectionsToCompress)>(&sectionsToCompress)->multitoken(), "Section name to store zlib compressed in the output xclbin image.")
       ("digest-algorithm", boost::program_options::value<decltype(sDigestAlgorithm)>(&sDigestAlgorithm), "Digest algorithm. Default: sha512")
       ("dump-section", boost::program_options::value<decltype(sectionsToDump)>(&sectionsToDump)->multitoken(), "Section to dump. Format: <section>:<format>:<file>")
       ("force", boost::program_options::bool_switch(&bForce), "Forces a file overwrite.")
@@ -550,6 +554,14 @@ int main_(int argc, const char** argv) {
   // -- Update Interface uuid in xclbin --
   xclBin.updateInterfaceuuid();
 
+  // -- Create the runtime index last, after all meta data changes --
+  if (bAddRuntimeIndex)
+    XUtil::createRuntimeIndex(xclBin);
+
+  // -- Compress Sections --
+  for (const auto &section : sectionsToCompress)
+    xclBin.compressSection(section);
+
   // -- Dump Sections --
   for (const auto &section : sectionsToDump) {
     ParameterSectionData psd(section);
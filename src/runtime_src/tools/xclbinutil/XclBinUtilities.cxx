@@ -17,8 +17,10 @@
 #include "XclBinUtilities.h"
 
 #include "Section.h"                           // TODO: REMOVE SECTION INCLUDE
+#include "SectionRuntimeIndex.h"
 #include "XclBinClass.h"
 
+#include <algorithm>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/format.hpp>
 #include <boost/property_tree/json_parser.hpp>
@@ -52,6 +54,11 @@
   #include <winsock2.h>
 #else
   #include <arpa/inet.h>
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #include <zlib.h>
 #endif
 
 namespace XUtil = XclBinUtilities;
@@ -60,6 +67,51 @@ namespace fs = std::filesystem;
 static bool m_bVerbose = false;
 static bool m_bQuiet = false;
 
+XclBinUtilities::MappedFile::MappedFile(const std::string& _fileName, char* _pData, uint64_t _size)
+  : m_fileName(_fileName)
+  , m_pData(_pData)
+  , m_size(_size)
+{
+  // Empty
+}
+
+XclBinUtilities::MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+  if (m_pData != nullptr)
+    munmap(m_pData, m_size);
+#endif
+}
+
+std::shared_ptr<XclBinUtilities::MappedFile>
+XclBinUtilities::MappedFile::create(const std::string& _fileName)
+{
+#ifdef _WIN32
+  (void) _fileName;
+  return nullptr;
+#else
+  int fd = open(_fileName.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat st = {};
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+    close(fd);
+    return nullptr;
+  }
+
+  // Private and writable so that a section modifying its buffer in
+  // place never reaches the file on disk
+  void* pData = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (pData == MAP_FAILED)
+    return nullptr;
+
+  madvise(pData, st.st_size, MADV_SEQUENTIAL);
+  return std::shared_ptr<MappedFile>(new MappedFile(_fileName, static_cast<char*>(pData), st.st_size));
+#endif
+}
+
 void
 XclBinUtilities::setVerbose(bool _bVerbose) {
   m_bVerbose = _bVerbose;
@@ -607,6 +659,109 @@ XclBinUtilities::write_htonl(std::ostream & _buf, uint32_t _word32)
   _buf.write((char *) &word32, sizeof(uint32_t));
 }
 
+// The section data is streamed through zlib in chunks, a single z_stream
+// call is limited to 4GB of data.
+static constexpr uint64_t zlibChunkSize = 1024 * 1024;
+
+void
+XclBinUtilities::compressSectionBuffer(const char* _pData, uint64_t _size, std::ostream& _buf)
+{
+#ifndef _WIN32
+  XUtil::TRACE(boost::format("Compressing section data of %ld bytes") % _size);
+
+  axlf_compressed_section compressedHeader = axlf_compressed_section{};
+  compressedHeader.m_compression = AXLF_COMPRESSION_ZLIB;
+  compressedHeader.m_uncompressedSize = _size;
+  _buf.write((const char*)&compressedHeader, sizeof(axlf_compressed_section));
+
+  // The section is compressed once and decompressed on every load,
+  // the decompression speed does not depend on the compression level
+  z_stream stream = z_stream{};
+  if (deflateInit(&stream, Z_BEST_COMPRESSION) != Z_OK)
+    throw std::runtime_error("ERROR: Unable to initialize the zlib section compression.");
+
+  std::vector<unsigned char> chunk(zlibChunkSize);
+  stream.next_in = (Bytef*)_pData;
+  uint64_t remaining = _size;
+  int flush = Z_NO_FLUSH;
+  do {
+    uint64_t inSize = std::min(remaining, zlibChunkSize);
+    stream.avail_in = (uInt)inSize;
+    remaining -= inSize;
+    flush = (remaining == 0) ? Z_FINISH : Z_NO_FLUSH;
+
+    do {
+      stream.next_out = chunk.data();
+      stream.avail_out = (uInt)chunk.size();
+      deflate(&stream, flush);
+      _buf.write((const char*)chunk.data(), chunk.size() - stream.avail_out);
+    } while (stream.avail_out == 0);
+  } while (flush != Z_FINISH);
+
+  deflateEnd(&stream);
+#else
+  (void)_pData; (void)_size; (void)_buf;
+  throw std::runtime_error("ERROR: Compressed sections are only supported on Linux.");
+#endif
+}
+
+void
+XclBinUtilities::decompressSectionBuffer(const char* _pData, uint64_t _size, std::ostream& _buf)
+{
+#ifndef _WIN32
+  if (_size < sizeof(axlf_compressed_section)) {
+    auto errMsg = boost::format("ERROR: Compressed section size (%d) is smaller than the size of the axlf_compressed_section structure (%d)")
+                                % _size % sizeof(axlf_compressed_section);
+    throw std::runtime_error(errMsg.str());
+  }
+
+  const axlf_compressed_section* pHeader = (const axlf_compressed_section*)_pData;
+  if (pHeader->m_compression != AXLF_COMPRESSION_ZLIB) {
+    auto errMsg = boost::format("ERROR: Unsupported section compression: %d") % pHeader->m_compression;
+    throw std::runtime_error(errMsg.str());
+  }
+
+  XUtil::TRACE(boost::format("Decompressing section data of %ld bytes") % pHeader->m_uncompressedSize);
+
+  z_stream stream = z_stream{};
+  if (inflateInit(&stream) != Z_OK)
+    throw std::runtime_error("ERROR: Unable to initialize the zlib section decompression.");
+
+  std::vector<unsigned char> chunk(zlibChunkSize);
+  stream.next_in = (Bytef*)(_pData + sizeof(axlf_compressed_section));
+  uint64_t remaining = _size - sizeof(axlf_compressed_section);
+  uint64_t written = 0;
+  int ret = Z_OK;
+  while (ret != Z_STREAM_END) {
+    if (stream.avail_in == 0) {
+      if (remaining == 0)
+        break;
+
+      uint64_t inSize = std::min(remaining, zlibChunkSize);
+      stream.avail_in = (uInt)inSize;
+      remaining -= inSize;
+    }
+
+    stream.next_out = chunk.data();
+    stream.avail_out = (uInt)chunk.size();
+    ret = inflate(&stream, Z_NO_FLUSH);
+    if ((ret != Z_OK) && (ret != Z_STREAM_END))
+      break;
+
+    _buf.write((const char*)chunk.data(), chunk.size() - stream.avail_out);
+    written += chunk.size() - stream.avail_out;
+  }
+
+  inflateEnd(&stream);
+
+  if ((ret != Z_STREAM_END) || (written != pHeader->m_uncompressedSize))
+    throw std::runtime_error("ERROR: Compressed section data is corrupted.");
+#else
+  (void)_pData; (void)_size; (void)_buf;
+  throw std::runtime_error("ERROR: Compressed sections are only supported on Linux.");
+#endif
+}
+
 // ----------------------------------------------------------------------------
 
 // Connective entry plus supporting address metadata
@@ -1009,6 +1164,30 @@ XclBinUtilities::createMemoryBankGrouping(XclBin & xclbin)
   }
 }
 
+void
+XclBinUtilities::createRuntimeIndex(XclBin & xclbin)
+{
+  // -- DRC checks
+  Section *pEmbeddedMetadata = xclbin.findSection(EMBEDDED_METADATA);
+  if (pEmbeddedMetadata == nullptr)
+    throw std::runtime_error("ERROR: EMBEDDED_METADATA section is missing.  Unable to create the RUNTIME_INDEX section.");
+
+  // -- A previous index may describe other meta data, always re-create it
+  if (xclbin.findSection(RUNTIME_INDEX) != nullptr)
+    xclbin.removeSection("RUNTIME_INDEX");
+
+  std::ostringstream xmlBuffer;
+  pEmbeddedMetadata->writeXclBinSectionBuffer(xmlBuffer);
+
+  std::ostringstream indexBuffer;
+  SectionRuntimeIndex::createIndex(xmlBuffer.str(), indexBuffer);
+
+  std::istringstream iIndexBuffer(indexBuffer.str());
+  Section* pRuntimeIndex = Section::createSectionObjectOfKind(RUNTIME_INDEX);
+  pRuntimeIndex->readPayload(iIndexBuffer, Section::FormatType::raw);
+  xclbin.addSection(pRuntimeIndex);
+}
+
 #ifndef _WIN32
 // pdi_transform is only available on Linux
 // pdi_transform is defined in libtransformcdo.a
@@ -135,6 +135,31 @@ struct SignatureHeader {
    unsigned int totalSignatureSize;// Total size of this structure and strings
 };
 
+// Private, copy-on-write mapping of an entire file.  Sections read
+// from an xclbin image reference the mapping instead of copying their
+// payload, so only the pages actually touched are read from disk.
+class MappedFile {
+ public:
+  // Returns nullptr if the file cannot be mapped (e.g. on Windows),
+  // callers then fall back to reading the file through a stream.
+  static std::shared_ptr<MappedFile> create(const std::string& _fileName);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  char* data() const { return m_pData; }
+  uint64_t size() const { return m_size; }
+  const std::string& fileName() const { return m_fileName; }
+
+ private:
+  MappedFile(const std::string& _fileName, char* _pData, uint64_t _size);
+
+  std::string m_fileName;
+  char* m_pData;
+  uint64_t m_size;
+};
+
 void addSignature(const std::string& _sInputFile, const std::string& _sOutputFile, const std::string& _sSignature, const std::string& _sSignedBy);
 void reportSignature(const std::string& _sInputFile);
 void removeSignature(const std::string& _sInputFile, const std::string& _sOutputFile);
@@ -166,7 +191,12 @@ std::string getUUIDAsString( const unsigned char (&_uuid)[16] );
 int exec(const std::filesystem::path &cmd, const std::vector<std::string> &args, bool bThrow, std::ostringstream & os_stdout, std::ostringstream & os_stderr);
 void write_htonl(std::ostream & _buf, uint32_t _word32);
 
+// Compressed section data: struct axlf_compressed_section + zlib stream
+void compressSectionBuffer(const char* _pData, uint64_t _size, std::ostream& _buf);
+void decompressSectionBuffer(const char* _pData, uint64_t _size, std::ostream& _buf);
+
 void createMemoryBankGrouping(XclBin & xclbin);
+void createRuntimeIndex(XclBin & xclbin);
 
 // temporary for 2024.1, https://jira.xilinx.com/browse/SDXFLO-6890
 void transformAiePartitionPDIs(XclBin & xclbin);
@@ -42,6 +42,7 @@
 #include "core/include/xdp/counters.h"
 #include "core/include/xclbin.h"
 
+#include <cstring>
 #include <map>
 #include <sstream>
 #include <fstream>
@@ -918,6 +919,100 @@ clGetClMems()
   return adv;
 }
 
+namespace {
+
+//Fixed size writer into the snapshot buffer. Entries that do not fit
+//are counted but not written.
+class snapshot_writer {
+  char* m_buf;
+  size_t m_size;
+  size_t m_offset = sizeof(snapshot_header);
+public:
+  snapshot_header m_header {snapshot_magic, snapshot_version, 0, 0, 0, 0, 0};
+
+  snapshot_writer(void* aBuf, size_t aSize) : m_buf(static_cast<char*>(aBuf)), m_size(aBuf ? aSize : 0) {}
+
+  template <typename EntryType>
+  bool write(const EntryType& aEntry, uint32_t& aCount) {
+    auto end = m_offset + sizeof(EntryType);
+    m_offset = end;
+    if (end > m_size) {
+      m_header.flags |= snapshot_truncated;
+      return false;
+    }
+    std::memcpy(m_buf + end - sizeof(EntryType), &aEntry, sizeof(EntryType));
+    ++aCount;
+    return true;
+  }
+
+  //Index of a queue written to buffer, used to update its counts
+  snapshot_queue* queue(uint64_t aQueue) {
+    auto queues = reinterpret_cast<snapshot_queue*>(m_buf + sizeof(snapshot_header));
+    for (uint32_t idx = 0; idx < m_header.num_queues; ++idx)
+      if (queues[idx].queue == aQueue)
+        return &queues[idx];
+    return nullptr;
+  }
+
+  size_t finish() {
+    m_header.size = m_offset;
+    if (m_size >= sizeof(snapshot_header))
+      std::memcpy(m_buf, &m_header, sizeof(snapshot_header));
+    return m_offset;
+  }
+};
+
+} // namespace
+
+size_t
+clGetAppDebugSnapshot(void* aBuf, size_t aSize)
+{
+  snapshot_writer writer(aBuf, aSize);
+  auto& hdr = writer.m_header;
+
+  //Each tracker is only held while its objects are copied, none of the
+  //accessors below allocate or take object locks
+  try {
+    app_debug_track<cl_command_queue>::getInstance()->for_each([&](cl_command_queue aQueue) {
+      snapshot_queue entry {reinterpret_cast<uint64_t>(aQueue), xocl::xocl(aQueue)->get_uid(), 0, 0, 0};
+      writer.write(entry, hdr.num_queues);
+    });
+  }
+  catch (const xocl::error&) {
+    hdr.flags |= snapshot_queues_locked;
+  }
+
+  try {
+    app_debug_track<cl_mem>::getInstance()->for_each([&](cl_mem aMem) {
+      auto mem = xocl::xocl(aMem);
+      snapshot_mem entry {reinterpret_cast<uint64_t>(aMem), mem->get_size(),
+                          reinterpret_cast<uint64_t>(mem->get_host_ptr()), mem->get_uid(), 0};
+      writer.write(entry, hdr.num_mems);
+    });
+  }
+  catch (const xocl::error&) {
+    hdr.flags |= snapshot_mems_locked;
+  }
+
+  try {
+    app_debug_track<cl_event>::getInstance()->for_each([&](cl_event aEvent) {
+      auto event = xocl::xocl(aEvent);
+      auto cq = reinterpret_cast<uint64_t>(static_cast<cl_command_queue>(event->get_command_queue()));
+      auto status = event->try_get_status();
+      snapshot_event entry {reinterpret_cast<uint64_t>(aEvent), cq, event->get_uid(),
+                            event->get_command_type(), status, 0};
+      writer.write(entry, hdr.num_events);
+      if (auto queue = writer.queue(cq))
+        ++(status == CL_QUEUED ? queue->num_queued : queue->num_submitted);
+    });
+  }
+  catch (const xocl::error&) {
+    hdr.flags |= snapshot_events_locked;
+  }
+
+  return writer.finish();
+}
+
 static std::string
 getScalarArgValue(const xocl::kernel* kernel, const xocl::kernel::xargument* arg)
 {
@@ -293,6 +293,58 @@ clGetKernelInfo();
 app_debug_view<event_debug_view_base>*
 clGetEventInfo(cl_event aEvent);
 
+//Binary snapshot of tracked OpenCL objects. The snapshot is a header
+//followed by arrays of queues, mems, and events, copied without any
+//string formatting so that taking it does not stall the runtime.
+//Formatting is done by the debugger (see 'xprint snapshot').
+constexpr uint32_t snapshot_magic = 0x58444253; // "XDBS"
+constexpr uint32_t snapshot_version = 1;
+constexpr uint32_t snapshot_truncated = 0x1;        // buffer too small
+constexpr uint32_t snapshot_queues_locked = 0x2;    // queue tracker busy
+constexpr uint32_t snapshot_mems_locked = 0x4;      // mem tracker busy
+constexpr uint32_t snapshot_events_locked = 0x8;    // event tracker busy
+
+struct snapshot_header {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t size;         // bytes required for complete snapshot
+  uint32_t num_queues;   // entries present in buffer
+  uint32_t num_mems;
+  uint32_t num_events;
+  uint32_t flags;
+};
+
+struct snapshot_queue {
+  uint64_t queue;
+  uint32_t uid;
+  uint32_t num_queued;
+  uint32_t num_submitted;
+  uint32_t reserved;
+};
+
+struct snapshot_mem {
+  uint64_t mem;
+  uint64_t size;
+  uint64_t host_ptr;
+  uint32_t uid;
+  uint32_t reserved;
+};
+
+struct snapshot_event {
+  uint64_t event;
+  uint64_t queue;
+  uint32_t uid;
+  uint32_t command_type;
+  int32_t status;
+  uint32_t reserved;
+};
+
+//Copy snapshot into aBuf of aSize bytes. Returns number of bytes
+//required for a complete snapshot, if larger than aSize the snapshot
+//is truncated and can be retaken with a larger buffer.
+size_t
+clGetAppDebugSnapshot(void* aBuf, size_t aSize);
+
 //aim_debug_view requires xcl_app_debug.h, so don't include here
 //forward declare needed type
 struct aim_debug_view;
@@ -452,6 +452,68 @@ class xprintAll (gdb.Command,infCallUtil):
 		all_kernels.invoke(arg,from_tty)
 xprintAll()
 
+class xprintSnapshot (gdb.Command,infCallUtil):
+	"Print a binary snapshot of command queues, cl_mems and events"
+	hdr_fmt = "=IIQIIII"
+	queue_fmt = "=QIIII"
+	mem_fmt = "=QQQII"
+	event_fmt = "=QQIIiI"
+	flag_names = {0x1:"truncated", 0x2:"queues locked", 0x4:"mems locked", 0x8:"events locked"}
+
+	def __init__ (self):
+		super (xprintSnapshot, self).__init__ ("xprint snapshot",
+                         gdb.COMMAND_USER)
+
+	def take_snapshot(self, size):
+		buf = gdb.parse_and_eval("(void*)malloc({})".format(size))
+		try:
+			needed = int(gdb.parse_and_eval("appdebug::clGetAppDebugSnapshot((void*){},{})".format(int(buf), size)))
+			data = bytes(gdb.selected_inferior().read_memory(int(buf), min(needed, size)))
+		finally:
+			gdb.parse_and_eval("(void)free((void*){})".format(int(buf)))
+		return needed, data
+
+	def invoke (self, arg="", from_tty=True):
+		import struct
+		try:
+			self.check_app_debug_enabled()
+		except ValueError as e:
+			print (e)
+			return
+
+		# Retry once with the size reported by the first snapshot
+		needed, data = self.take_snapshot(65536)
+		if needed > len(data):
+			needed, data = self.take_snapshot(needed + 4096)
+
+		magic, version, size, nqueues, nmems, nevents, flags = struct.unpack_from(self.hdr_fmt, data, 0)
+		if magic != 0x58444253 or version != 1:
+			print ("Unknown snapshot format")
+			return
+		offset = struct.calcsize(self.hdr_fmt)
+		status = [name for bit, name in self.flag_names.items() if flags & bit]
+		if status:
+			print ("Snapshot incomplete: {}".format(", ".join(status)))
+
+		print ("Queues: {}".format(nqueues))
+		for i in range(nqueues):
+			queue, uid, nq, ns, _ = struct.unpack_from(self.queue_fmt, data, offset)
+			offset += struct.calcsize(self.queue_fmt)
+			print ("  Queue-{} ({:#x}): {} queued, {} submitted".format(uid, queue, nq, ns))
+
+		print ("cl_mems: {}".format(nmems))
+		for i in range(nmems):
+			mem, msize, host_ptr, uid, _ = struct.unpack_from(self.mem_fmt, data, offset)
+			offset += struct.calcsize(self.mem_fmt)
+			print ("  Mem-{} ({:#x}): size {} host_ptr {:#x}".format(uid, mem, msize, host_ptr))
+
+		print ("Events: {}".format(nevents))
+		for i in range(nevents):
+			event, queue, uid, cmd, estatus, _ = struct.unpack_from(self.event_fmt, data, offset)
+			offset += struct.calcsize(self.event_fmt)
+			print ("  Event-{} ({:#x}): queue {:#x} command {:#x} status {}".format(uid, event, queue, cmd, estatus))
+xprintSnapshot()
+
 class xprintJSONPrefix(gdb.Command):
 	"Xilinx internal command for printing OpenCL runtime data structure in JSON format"
 	def __init__(self):
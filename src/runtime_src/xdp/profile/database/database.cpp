@@ -19,6 +19,7 @@
 
 #include "core/common/config_reader.h"
 #include "xdp/profile/database/database.h"
+#include "xdp/profile/database/metrics_exporter.h"
 #include "xdp/profile/plugin/vp_base/vp_base_plugin.h"
 #include "xdp/profile/writer/vp_base/summary_writer.h"
 
@@ -32,6 +33,11 @@ namespace xdp {
     VPDatabase::live = true ;
 
     summary = std::make_unique<SummaryWriter>("summary.csv", this);
+
+    auto metricsFile = xrt_core::config::get_metrics_export_file() ;
+    if (!metricsFile.empty())
+      metrics = std::make_unique<MetricsExporter>(&stats, metricsFile,
+                  xrt_core::config::get_metrics_export_interval_ms()) ;
   }
 
   // The database and all the plugins are singletons and can be
@@ -46,6 +52,9 @@ namespace xdp {
       p->writeAll(false) ;
     }
 
+    // Stop the periodic export, it writes the final statistics
+    metrics.reset() ;
+
     // After all the plugins have written their data, we can dump the
     //  generic summary
     if (summary != nullptr) {
@@ -32,6 +32,7 @@ namespace xdp {
 
   // Forward declarations
   class XDPPlugin ;
+  class MetricsExporter ;
 
   // There will be one database per application, regardless of how
   //  many plugins are created.  All plugins will have a reference to
@@ -61,6 +62,9 @@ namespace xdp {
     // The database itself keeps track of the generic summary
     std::unique_ptr<VPWriter> summary;
 
+    // Optional export of the statistics while the application runs
+    std::unique_ptr<MetricsExporter> metrics;
+
     // Additionally, for summary generation, the database must expose
     //  what plugins were loaded and what information is available
     uint64_t pluginInfo ;
@@ -29,6 +29,10 @@ namespace xdp {
   
   VPDynamicDatabase::VPDynamicDatabase(VPDatabase* d) :
     db(d), eventId(1)
+    , dbId([] {
+        static std::atomic<uint64_t> nextId {1};
+        return nextId++;
+      }())
   {
     host = std::make_unique<HostDB>();
   }
@@ -46,7 +50,19 @@ namespace xdp {
   {
     if (event == nullptr)
       return;
-    event->setEventId(eventId++);
+
+    thread_local struct {
+      uint64_t id = 0;
+      uint64_t next = 0;
+      uint64_t end = 0;
+    } block;
+
+    if (block.id != dbId || block.next == block.end) {
+      block.id = dbId;
+      block.next = eventId.fetch_add(eventIdBlock, std::memory_order_relaxed);
+      block.end = block.next + eventIdBlock;
+    }
+    event->setEventId(block.next++);
   }
 
   // This function is only called internally once an ID has been issued
@@ -187,6 +203,11 @@ namespace xdp {
     return host->sortedEventsExist(filter);
   }
 
+  uint64_t VPDynamicDatabase::numHostEvents()
+  {
+    return host->numEvents();
+  }
+
   bool VPDynamicDatabase::deviceEventsExist(uint64_t deviceId)
   {
     auto device_db = getDeviceDB(deviceId);
@@ -317,6 +338,18 @@ namespace xdp {
     return device_db->isPLTraceBufferFull();
   }
 
+  void VPDynamicDatabase::setPLTraceDroppedPackets(uint64_t deviceId, uint64_t val)
+  {
+    auto device_db = getDeviceDB(deviceId);
+    device_db->setPLTraceDroppedPackets(val);
+  }
+
+  uint64_t VPDynamicDatabase::getPLTraceDroppedPackets(uint64_t deviceId)
+  {
+    auto device_db = getDeviceDB(deviceId);
+    return device_db->getPLTraceDroppedPackets();
+  }
+
   void VPDynamicDatabase::
   setPLDeadlockInfo(uint64_t deviceId, const std::string& info)
   {
@@ -67,10 +67,17 @@ namespace xdp {
 
     // A unique event id for every event added to the database, both host
     // and device events.  It starts with 1 so we can use 0 as an
-    // indicator of NULL.
+    // indicator of NULL.  Each thread reserves a block of ids at a time
+    // so issuing an id rarely touches the shared counter.  Ids are
+    // unique but not ordered by time across threads.
+    static constexpr uint64_t eventIdBlock = 64;
     std::atomic<uint64_t> eventId;
     void issueId(VTFEvent* event);
 
+    // Unique id of this database used to validate the thread local
+    // block of event ids
+    const uint64_t dbId;
+
     // For all strings associated with events, we keep only one unique
     // copy and will use uint64_t numbers as references instead.
     StringTable stringTable;
@@ -144,6 +151,7 @@ namespace xdp {
 
     XDP_CORE_EXPORT bool deviceEventsExist(uint64_t deviceId);
     XDP_CORE_EXPORT bool hostEventsExist(std::function<bool(VTFEvent*)> filter);
+    XDP_CORE_EXPORT uint64_t numHostEvents();
 
     XDP_CORE_EXPORT void setCounterResults(uint64_t deviceId,
 				      xrt_core::uuid uuid,
@@ -183,6 +191,8 @@ namespace xdp {
     // Device Trace Buffer Fullness Status - PL
     XDP_CORE_EXPORT void setPLTraceBufferFull(uint64_t deviceId, bool val);
     XDP_CORE_EXPORT bool isPLTraceBufferFull(uint64_t deviceId);
+    XDP_CORE_EXPORT void setPLTraceDroppedPackets(uint64_t deviceId, uint64_t val);
+    XDP_CORE_EXPORT uint64_t getPLTraceDroppedPackets(uint64_t deviceId);
 
     // Deadlock Diagnosis metadata
     XDP_CORE_EXPORT void setPLDeadlockInfo(uint64_t deviceId, const std::string& str);
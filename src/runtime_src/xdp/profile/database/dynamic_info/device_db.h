@@ -78,6 +78,12 @@ namespace xdp {
 
     inline bool isPLTraceBufferFull() { return pl_db.isPLTraceBufferFull(); }
 
+    inline void setPLTraceDroppedPackets(uint64_t val)
+    { pl_db.setPLTraceDroppedPackets(val); }
+
+    inline uint64_t getPLTraceDroppedPackets()
+    { return pl_db.getPLTraceDroppedPackets(); }
+
     inline void setPLCounterResults(xrt_core::uuid uuid, CounterResults& values)
     { pl_db.setPLCounterResults(uuid, values); }
     inline CounterResults getPLCounterResults(xrt_core::uuid uuid)
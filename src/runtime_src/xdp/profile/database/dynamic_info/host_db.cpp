@@ -22,8 +22,26 @@
 
 namespace xdp {
 
+  HostDB::HostDB()
+    : dbId([] {
+        static std::atomic<uint64_t> nextId {1};
+        return nextId++;
+      }())
+  {}
+
   HostDB::~HostDB()
   {
+    // Delete buffered events that were never merged
+    auto tevents = threadEvents.exchange(nullptr);
+    while (tevents != nullptr) {
+      auto next = tevents->next;
+      for (auto event : tevents->sorted)
+        delete event;
+      for (auto event : tevents->unsorted)
+        delete event;
+      delete tevents;
+      tevents = next;
+    }
     // Delete sorted events still in the database and not moved
     {
       std::lock_guard<std::mutex> lock(sortedLock);
@@ -40,13 +58,83 @@ namespace xdp {
     }
   }
 
+  HostDB::ThreadEvents* HostDB::getThreadEvents()
+  {
+    // Cache the buffer of the calling thread.  The id of the database
+    // guards against a cached buffer of a destroyed HostDB.
+    thread_local struct {
+      uint64_t id = 0;
+      ThreadEvents* events = nullptr;
+    } cache;
+
+    if (cache.id == dbId)
+      return cache.events;
+
+    // The thread may have used this database before while the cache
+    // was pointing to another one
+    auto self = std::this_thread::get_id();
+    auto tevents = threadEvents.load(std::memory_order_acquire);
+    for (; tevents != nullptr; tevents = tevents->next) {
+      if (tevents->owner == self)
+        break;
+    }
+
+    if (tevents == nullptr) {
+      tevents = new ThreadEvents;
+      tevents->owner = self;
+      tevents->next = threadEvents.load(std::memory_order_relaxed);
+      while (!threadEvents.compare_exchange_weak(tevents->next, tevents,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed))
+        ;
+    }
+
+    cache.id = dbId;
+    cache.events = tevents;
+    return tevents;
+  }
+
+  // Must be called with sortedLock held
+  void HostDB::mergeSortedEvents()
+  {
+    std::vector<VTFEvent*> events;
+    auto tevents = threadEvents.load(std::memory_order_acquire);
+    for (; tevents != nullptr; tevents = tevents->next) {
+      {
+        std::lock_guard<std::mutex> lock(tevents->lock);
+        events.swap(tevents->sorted);
+      }
+      for (auto event : events)
+        sortedEvents.emplace(event->getTimestamp(), event);
+      tevents->pending -= events.size();
+      merged += events.size();
+      events.clear();
+    }
+  }
+
+  // Must be called with unsortedLock held
+  void HostDB::mergeUnsortedEvents()
+  {
+    auto tevents = threadEvents.load(std::memory_order_acquire);
+    for (; tevents != nullptr; tevents = tevents->next) {
+      std::lock_guard<std::mutex> lock(tevents->lock);
+      unsortedEvents.insert(unsortedEvents.end(),
+                            tevents->unsorted.begin(), tevents->unsorted.end());
+      tevents->pending -= tevents->unsorted.size();
+      merged += tevents->unsorted.size();
+      tevents->unsorted.clear();
+    }
+  }
+
   void HostDB::addSortedEvent(VTFEvent* event)
   {
     if (event == nullptr)
       return;
 
-    std::lock_guard<std::mutex> lock(sortedLock);
-    sortedEvents.emplace(event->getTimestamp(), event);
+    auto tevents = getThreadEvents();
+    std::lock_guard<std::mutex> lock(tevents->lock);
+    tevents->sorted.push_back(event);
+    tevents->pending.fetch_add(1, std::memory_order_relaxed);
   }
 
   void HostDB::addUnsortedEvent(VTFEvent* event)
@@ -54,13 +142,25 @@ namespace xdp {
     if (event == nullptr)
       return;
 
-    std::lock_guard<std::mutex> lock(unsortedLock);
-    unsortedEvents.push_back(event);
+    auto tevents = getThreadEvents();
+    std::lock_guard<std::mutex> lock(tevents->lock);
+    tevents->unsorted.push_back(event);
+    tevents->pending.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint64_t HostDB::numEvents()
+  {
+    uint64_t count = merged.load(std::memory_order_relaxed);
+    auto tevents = threadEvents.load(std::memory_order_acquire);
+    for (; tevents != nullptr; tevents = tevents->next)
+      count += tevents->pending.load(std::memory_order_relaxed);
+    return count;
   }
 
   bool HostDB::sortedEventsExist(std::function<bool (VTFEvent*)>& filter)
   {
     std::lock_guard<std::mutex> lock(sortedLock);
+    mergeSortedEvents();
     for (auto& iter : sortedEvents) {
       auto event = iter.second;
       if (filter(event))
@@ -73,6 +173,7 @@ namespace xdp {
   HostDB::filterSortedEvents(std::function<bool (VTFEvent*)>& filter)
   {
     std::lock_guard<std::mutex> lock(sortedLock);
+    mergeSortedEvents();
 
     std::vector<VTFEvent*> collected;
     for (auto& iter : sortedEvents) {
@@ -87,6 +188,7 @@ namespace xdp {
   HostDB::filterUnsortedEvents(std::function<bool (VTFEvent*)>& filter)
   {
     std::lock_guard<std::mutex> lock(unsortedLock);
+    mergeUnsortedEvents();
 
     std::vector<VTFEvent*> collected;
     for (auto event : unsortedEvents) {
@@ -100,6 +202,7 @@ namespace xdp {
   HostDB::moveSortedEvents(std::function<bool (VTFEvent*)>& filter)
   {
     std::lock_guard<std::mutex> lock(sortedLock);
+    mergeSortedEvents();
 
     std::vector<std::unique_ptr<VTFEvent>> collected;
 
@@ -112,6 +215,7 @@ namespace xdp {
       else
         ++iter;
     }
+    merged -= collected.size();
     return collected;
   }
 
@@ -119,6 +223,7 @@ namespace xdp {
   HostDB::moveUnsortedEvents(std::function<bool (VTFEvent*)>& filter)
   {
     std::lock_guard<std::mutex> lock(unsortedLock);
+    mergeUnsortedEvents();
 
     std::vector<VTFEvent*> collected;
 
@@ -132,6 +237,7 @@ namespace xdp {
 
     // Resize the UnsortedEvents vector to keep only the remaining unfiltered events
     unsortedEvents.erase(newEnd, unsortedEvents.end());
+    merged -= collected.size();
 
     return collected;
   }
@@ -17,11 +17,13 @@
 #ifndef HOST_DB_DOT_H
 #define HOST_DB_DOT_H
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 #include "xdp/config.h"
@@ -72,14 +74,47 @@ namespace xdp {
     std::mutex sortedLock; // Protects the "sortedEvents" multimap
     std::mutex unsortedLock; // Protects the "unsortedEvents" vector
 
+    // Events are first appended to a buffer owned by the calling
+    // thread so that threads adding events in parallel do not contend
+    // on sortedLock and unsortedLock.  The buffers are merged into
+    // sortedEvents and unsortedEvents only when the events are read.
+    // The lock of a buffer is only contended by a reader merging it.
+    struct ThreadEvents
+    {
+      std::thread::id owner;
+      std::mutex lock;
+      std::vector<VTFEvent*> sorted;
+      std::vector<VTFEvent*> unsorted;
+      std::atomic<uint64_t> pending { 0 }; // Events not yet merged
+      ThreadEvents* next = nullptr;
+    };
+
+    // Singly linked list of all thread buffers, new buffers are
+    // pushed without a lock.  The buffers are deleted with the HostDB.
+    std::atomic<ThreadEvents*> threadEvents { nullptr };
+
+    // Unique id of this HostDB used to validate the cached thread buffer
+    const uint64_t dbId;
+
+    // Number of events in sortedEvents and unsortedEvents
+    std::atomic<uint64_t> merged { 0 };
+
+    ThreadEvents* getThreadEvents();
+    void mergeSortedEvents();
+    void mergeUnsortedEvents();
+
   public:
-    HostDB() = default;
+    XDP_CORE_EXPORT HostDB();
     XDP_CORE_EXPORT ~HostDB();
 
     // Functions to add host events to the database
     void addSortedEvent(VTFEvent* event);
     void addUnsortedEvent(VTFEvent* event);
 
+    // Approximate number of events currently held, used to trigger
+    // a continuous trace dump before the host memory grows too large
+    uint64_t numEvents();
+
     // A function to check the sorted events to see if any events that
     // fit the filter exist are currently stored in the database.
     bool sortedEventsExist(std::function<bool (VTFEvent*)>& filter);
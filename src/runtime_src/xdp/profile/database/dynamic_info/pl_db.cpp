@@ -109,6 +109,18 @@ namespace xdp {
     return plTraceBufferFull;
   }
 
+  void PLDB::setPLTraceDroppedPackets(uint64_t val)
+  {
+    std::lock_guard<std::mutex> lock(fullLock);
+    plTraceDroppedPackets = val;
+  }
+
+  uint64_t PLDB::getPLTraceDroppedPackets()
+  {
+    std::lock_guard<std::mutex> lock(fullLock);
+    return plTraceDroppedPackets;
+  }
+
   void PLDB::setPLCounterResults(xrt_core::uuid uuid, CounterResults& values)
   {
     std::lock_guard<std::mutex> lock(counterLock);
@@ -60,13 +60,14 @@ namespace xdp {
     std::map<xrt_core::uuid, CounterResults> plCounters;
 
     bool plTraceBufferFull = false; // Is the PL trace buffer full?
+    uint64_t plTraceDroppedPackets = 0; // Lost to circular buffer overwrite
 
     SampleContainer powerSamples;
 
     std::mutex eventLock;   // For protecting the events multimap
     std::mutex startLock;   // For protecting the startEvents map
     std::mutex counterLock; // For protecting the plCounters map
-    std::mutex fullLock;    // For protecting the trace buffer full bool
+    std::mutex fullLock;    // For protecting the trace buffer full status
 
     // Deadlock Diagnosis String
     std::string deadlockInfo;
@@ -86,6 +87,8 @@ namespace xdp {
 
     void setPLTraceBufferFull(bool val);
     bool isPLTraceBufferFull();
+    void setPLTraceDroppedPackets(uint64_t val);
+    uint64_t getPLTraceDroppedPackets();
 
     void setPLCounterResults(xrt_core::uuid uuid, CounterResults& values);
     CounterResults getPLCounterResults(xrt_core::uuid uuid);
@@ -18,24 +18,65 @@
 
 #include "xdp/profile/database/dynamic_info/string_table.h"
 
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
 namespace xdp {
 
+  StringTable::StringTable()
+    : tableId([] {
+        static std::atomic<uint64_t> nextId {1};
+        return nextId++;
+      }())
+  {}
+
   uint64_t StringTable::addString(const std::string& value)
   {
-    std::lock_guard<std::mutex> lock(dataLock);
+    // Strings seen by the calling thread.  The id of the table guards
+    // against entries cached from a destroyed StringTable.
+    thread_local struct {
+      uint64_t id = 0;
+      std::unordered_map<std::string, uint64_t> strings;
+    } cache;
+
+    if (cache.id != tableId) {
+      cache.strings.clear();
+      cache.id = tableId;
+    }
+
+    auto cached = cache.strings.find(value);
+    if (cached != cache.strings.end())
+      return cached->second;
 
-    if (table.find(value) == table.end())
-      table[value] = currentId++;
+    auto& shard = shards[std::hash<std::string>{}(value) % numShards];
+    uint64_t id = 0;
+    {
+      std::lock_guard<std::mutex> lock(shard.lock);
+      auto iter = shard.table.find(value);
+      if (iter == shard.table.end())
+        iter = shard.table.emplace(value, currentId++).first;
+      id = iter->second;
+    }
 
-    return table[value];
+    cache.strings.emplace(value, id);
+    return id;
   }
 
   void StringTable::dumpTable(std::ofstream& fout)
   {
-    std::lock_guard<std::mutex> lock(dataLock);
+    std::vector<std::pair<uint64_t, std::string>> strings;
+    for (auto& shard : shards) {
+      std::lock_guard<std::mutex> lock(shard.lock);
+      for (auto& s : shard.table)
+        strings.emplace_back(s.second, s.first);
+    }
 
-    for (auto& s : table)
-      fout << s.second << "," << s.first.c_str() << "\n";
+    // Dump in id order so the output is the same from run to run
+    std::sort(strings.begin(), strings.end());
+    for (auto& s : strings)
+      fout << s.first << "," << s.second.c_str() << "\n";
   }
 
 } // end namespace xdp
@@ -17,25 +17,42 @@
 #ifndef STRING_TABLE_DOT_H
 #define STRING_TABLE_DOT_H
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <fstream>
-#include <map>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "xdp/config.h"
 
 namespace xdp {
 
+  // The table is split in shards selected by the hash of the string so
+  // threads adding different strings rarely contend on the same lock.
+  // Each thread also keeps a private cache of the strings it has looked
+  // up, so repeated strings on the trace path take no lock at all.
   class StringTable
   {
   private:
-    std::map<std::string, uint64_t> table;
-    uint64_t currentId = 1; // Start at 1 so we can use 0 as a special value
+    static constexpr size_t numShards = 16;
+
+    struct Shard
+    {
+      std::mutex lock; // Protects "table"
+      std::unordered_map<std::string, uint64_t> table;
+    };
+    std::array<Shard, numShards> shards;
+
+    // Start at 1 so we can use 0 as a special value
+    std::atomic<uint64_t> currentId { 1 };
+
+    // Unique id of this table used to validate the thread local cache
+    const uint64_t tableId;
 
-    std::mutex dataLock; // Protects "table" map and currentId
   public:
-    StringTable() = default;
+    XDP_CORE_EXPORT StringTable();
     ~StringTable() = default;
 
     XDP_CORE_EXPORT uint64_t addString(const std::string& value);
@@ -15,6 +15,7 @@
  * under the License.
  */
 
+#include <cstdio>
 #include <iomanip>
 
 #define XDP_CORE_SOURCE
@@ -45,15 +46,17 @@ namespace xdp {
     // Device events are accurate up to nanoseconds.
     // Timestamps are in milliseconds, so we should print up to 
     //  6 past the decimal point
-    std::ios_base::fmtflags flags = fout.flags() ;
-    fout << std::fixed << std::setprecision(6) << timestamp ;
-    fout.flags(flags) ;
+    // Formatting through the stream manipulators is a noticeable
+    // part of writing millions of events
+    char buf[64] ;
+    auto len = std::snprintf(buf, sizeof(buf), "%.6f", timestamp) ;
+    fout.write(buf, len) ;
   }
 
   void VTFDeviceEvent::dump(std::ofstream& fout, uint32_t bucket)
   { 
     VTFEvent::dump(fout, bucket) ;
-    fout << std::endl;
+    fout << "\n" ;
   } 
 
   KernelEvent::KernelEvent(uint64_t s_id, double ts, VTFEventType ty,
@@ -88,7 +91,7 @@ namespace xdp {
   void KernelStall::dump(std::ofstream& fout, uint32_t bucket)
   {
     VTFEvent::dump(fout, bucket) ;
-    fout << std::endl;
+    fout << "\n" ;
   }
 
   DeviceMemoryAccess::DeviceMemoryAccess(uint64_t s_id, double ts, VTFEventType ty,
@@ -110,7 +113,7 @@ namespace xdp {
   void DeviceMemoryAccess::dump(std::ofstream& fout, uint32_t bucket)
   {
     VTFEvent::dump(fout, bucket) ;
-    fout << "," << memoryName << std::endl;
+    fout << "," << memoryName << "\n" ;
   }
 
   DeviceStreamAccess::DeviceStreamAccess(uint64_t s_id, double ts, VTFEventType ty,
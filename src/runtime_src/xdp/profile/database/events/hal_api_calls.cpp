@@ -33,7 +33,7 @@ namespace xdp {
   void HALAPICall::dump(std::ofstream& fout, uint32_t bucket)
   {
     VTFEvent::dump(fout, bucket) ;
-    fout << "," << functionName << std::endl ;
+    fout << "," << functionName << "\n" ;
   }
 
   AllocBoCall::AllocBoCall(uint64_t s_id, double ts, uint64_t name) 
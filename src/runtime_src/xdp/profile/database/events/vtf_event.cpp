@@ -15,15 +15,139 @@
  * under the License.
  */
 
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
+#include <new>
 
 #define XDP_CORE_SOURCE
 
 #include "xdp/profile/database/events/vtf_event.h"
 
+namespace {
+
+  // Pool allocator for trace events.  Records are grouped in size
+  // classes of 16 bytes.  Each thread carves records from its own
+  // chunks and keeps freed records on a private free list, so the
+  // common path takes no lock.  Free lists that grow too long are
+  // handed in batches to a global list shared by all threads.  Chunks
+  // are never returned to the system, the records are reused for the
+  // lifetime of the process.
+  constexpr std::size_t granule = 16 ;
+  constexpr std::size_t num_classes = 16 ; // Records up to 256 bytes
+  constexpr std::size_t chunk_size = 64 * 1024 ;
+  constexpr std::size_t batch_size = 256 ;
+
+  // Records are at least 16 bytes, enough for two links.  The first
+  // record of a batch on the global list links to the next batch.
+  struct free_record
+  {
+    free_record* next ;
+    free_record* next_batch ;
+  } ;
+
+  struct free_list
+  {
+    free_record* head ;
+    std::size_t count ;
+  } ;
+
+  // Trivial types only, no thread exit handling is needed.  Records
+  // cached by a thread that exits are not reused.
+  struct thread_pool
+  {
+    free_list free[num_classes] ;
+    char* bump[num_classes] ;
+    char* bump_end[num_classes] ;
+  } ;
+
+  thread_local thread_pool tpool ;
+
+  std::mutex global_lock ;
+  free_record* global_batches[num_classes] ; // Batches of batch_size records
+
+  void take_global(std::size_t cls, free_list& list)
+  {
+    std::lock_guard<std::mutex> lk(global_lock) ;
+    auto batch = global_batches[cls] ;
+    if (batch == nullptr)
+      return ;
+    global_batches[cls] = batch->next_batch ;
+    list.head = batch ;
+    list.count = batch_size ;
+  }
+
+  void give_global(std::size_t cls, free_list& list)
+  {
+    std::lock_guard<std::mutex> lk(global_lock) ;
+    list.head->next_batch = global_batches[cls] ;
+    global_batches[cls] = list.head ;
+    list.head = nullptr ;
+    list.count = 0 ;
+  }
+
+  void* alloc_record(std::size_t cls)
+  {
+    auto& list = tpool.free[cls] ;
+    if (list.head == nullptr)
+      take_global(cls, list) ;
+
+    if (list.head != nullptr) {
+      auto rec = list.head ;
+      list.head = rec->next ;
+      --list.count ;
+      return rec ;
+    }
+
+    auto rsz = (cls + 1) * granule ;
+    if (tpool.bump[cls] == nullptr ||
+        static_cast<std::size_t>(tpool.bump_end[cls] - tpool.bump[cls]) < rsz) {
+      tpool.bump[cls] = static_cast<char*>(::operator new(chunk_size)) ;
+      tpool.bump_end[cls] = tpool.bump[cls] + (chunk_size / rsz) * rsz ;
+    }
+    auto rec = tpool.bump[cls] ;
+    tpool.bump[cls] += rsz ;
+    return rec ;
+  }
+
+  void free_record_to_pool(void* ptr, std::size_t cls)
+  {
+    auto& list = tpool.free[cls] ;
+    auto rec = static_cast<free_record*>(ptr) ;
+    rec->next = list.head ;
+    list.head = rec ;
+
+    // Threads that only free events, like the writers, would otherwise
+    // hoard the records of the threads that create them
+    if (++list.count == batch_size)
+      give_global(cls, list) ;
+  }
+
+} // end anonymous namespace
+
 namespace xdp {
 
+  void* VTFEvent::operator new(std::size_t sz)
+  {
+    auto cls = (sz + granule - 1) / granule - 1 ;
+    if (sz == 0 || cls >= num_classes)
+      return ::operator new(sz) ;
+    return alloc_record(cls) ;
+  }
+
+  void VTFEvent::operator delete(void* ptr, std::size_t sz)
+  {
+    if (ptr == nullptr)
+      return ;
+    auto cls = (sz + granule - 1) / granule - 1 ;
+    if (sz == 0 || cls >= num_classes) {
+      ::operator delete(ptr) ;
+      return ;
+    }
+    free_record_to_pool(ptr, cls) ;
+  }
+
   // **************************
   // Base class definitions
   // **************************
@@ -50,9 +174,11 @@ namespace xdp {
     // Host events are accurate up to microseconds.
     // Timestamps are in milliseconds, so the precision should be 3 past
     // the decimal point
-    std::ios_base::fmtflags flags = fout.flags() ;
-    fout << std::fixed << std::setprecision(6) << (timestamp/1.0e6) ;
-    fout.flags(flags) ;
+    // Formatting through the stream manipulators is a noticeable
+    // part of writing millions of events
+    char buf[64] ;
+    auto len = std::snprintf(buf, sizeof(buf), "%.6f", (timestamp/1.0e6)) ;
+    fout.write(buf, len) ;
   }
 
   void VTFEvent::dumpType(std::ofstream& fout, bool humanReadable)
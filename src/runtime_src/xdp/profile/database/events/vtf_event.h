@@ -18,6 +18,7 @@
 #ifndef VTF_EVENT_DOT_H
 #define VTF_EVENT_DOT_H
 
+#include <cstddef>
 #include <cstdint>
 #include <fstream>
 
@@ -96,6 +97,12 @@ namespace xdp {
     XDP_CORE_EXPORT VTFEvent(uint64_t s_id, double ts, VTFEventType ty) ;
     XDP_CORE_EXPORT virtual ~VTFEvent() ;
 
+    // Events are small, created at a very high rate, and live until
+    // the writers consume them.  Allocate them from per thread pools
+    // of fixed size records rather than the general heap.
+    XDP_CORE_EXPORT static void* operator new(std::size_t sz) ;
+    XDP_CORE_EXPORT static void operator delete(void* ptr, std::size_t sz) ;
+
     // Getters and Setters
     inline double       getTimestamp()    const { return timestamp ; }
     inline void         setTimestamp(double ts) { timestamp = ts ; }
@@ -0,0 +1,74 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_CORE_SOURCE
+
+#include <cstdio>
+#include <fstream>
+
+#include "xdp/profile/database/metrics_exporter.h"
+#include "xdp/profile/database/statistics_database.h"
+
+namespace xdp {
+
+  MetricsExporter::MetricsExporter(VPStatisticsDatabase* s,
+                                   const std::string& file,
+                                   unsigned int intervalMs)
+    : stats(s)
+    , filename(file)
+    , interval(intervalMs ? intervalMs : 1)
+  {
+    exportThread = std::thread(&MetricsExporter::run, this);
+  }
+
+  MetricsExporter::~MetricsExporter()
+  {
+    {
+      std::lock_guard<std::mutex> lock(stopLock);
+      stop = true;
+    }
+    stopCond.notify_one();
+    exportThread.join();
+
+    // Leave the final statistics of the run behind
+    exportMetrics();
+  }
+
+  void MetricsExporter::run()
+  {
+    std::unique_lock<std::mutex> lock(stopLock);
+    while (!stopCond.wait_for(lock, interval, [this] { return stop; })) {
+      lock.unlock();
+      exportMetrics();
+      lock.lock();
+    }
+  }
+
+  void MetricsExporter::exportMetrics()
+  {
+    auto tmpname = filename + ".tmp";
+    {
+      std::ofstream fout(tmpname);
+      if (!fout)
+        return;
+      stats->writeMetrics(fout);
+      if (!fout)
+        return;
+    }
+    std::rename(tmpname.c_str(), filename.c_str());
+  }
+
+} // end namespace xdp
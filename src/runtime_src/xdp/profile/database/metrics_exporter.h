@@ -0,0 +1,59 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef METRICS_EXPORTER_DOT_H
+#define METRICS_EXPORTER_DOT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace xdp {
+
+  // Forward declarations
+  class VPStatisticsDatabase;
+
+  // The MetricsExporter periodically writes the statistics database
+  // to a file in Prometheus text format so running applications can
+  // be monitored, for example by the node exporter textfile collector.
+  // The file is replaced atomically so readers never see a partial
+  // snapshot.
+  class MetricsExporter
+  {
+  private:
+    VPStatisticsDatabase* stats;
+    std::string filename;
+    std::chrono::milliseconds interval;
+
+    std::thread exportThread;
+    std::mutex stopLock;
+    std::condition_variable stopCond;
+    bool stop = false;
+
+    void run();
+    void exportMetrics();
+
+  public:
+    MetricsExporter(VPStatisticsDatabase* s, const std::string& file,
+                    unsigned int intervalMs);
+    ~MetricsExporter();
+  };
+
+} // end namespace xdp
+
+#endif
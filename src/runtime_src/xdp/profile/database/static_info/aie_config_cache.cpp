@@ -0,0 +1,203 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_CORE_SOURCE
+
+#include "aie_config_cache.h"
+#include "core/common/config_reader.h"
+#include "core/common/message.h"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <type_traits>
+
+namespace {
+
+  namespace pt = boost::property_tree;
+
+  pt::ptree
+  toTree(const xdp::tile_type& tile)
+  {
+    pt::ptree tree;
+    tree.put("row", +tile.row);
+    tree.put("col", +tile.col);
+    tree.put("stream_id", +tile.stream_id);
+    tree.put("is_master", +tile.is_master);
+    tree.put("itr_mem_addr", tile.itr_mem_addr);
+    tree.put("active_core", tile.active_core);
+    tree.put("active_memory", tile.active_memory);
+    tree.put("is_trigger", tile.is_trigger);
+    tree.put("subtype", static_cast<int>(tile.subtype));
+    return tree;
+  }
+
+  xdp::tile_type
+  toTile(const pt::ptree& tree)
+  {
+    xdp::tile_type tile{};
+    tile.row = static_cast<uint8_t>(tree.get<unsigned int>("row"));
+    tile.col = static_cast<uint8_t>(tree.get<unsigned int>("col"));
+    tile.stream_id = static_cast<uint8_t>(tree.get<unsigned int>("stream_id"));
+    tile.is_master = static_cast<uint8_t>(tree.get<unsigned int>("is_master"));
+    tile.itr_mem_addr = tree.get<uint64_t>("itr_mem_addr");
+    tile.active_core = tree.get<bool>("active_core");
+    tile.active_memory = tree.get<bool>("active_memory");
+    tile.is_trigger = tree.get<bool>("is_trigger");
+    tile.subtype = static_cast<xdp::io_type>(tree.get<int>("subtype"));
+    return tile;
+  }
+
+  // ptree reads uint8_t as a character, values are stored as numbers
+  template <typename ValueType>
+  ValueType
+  getValue(const pt::ptree& tree)
+  {
+    if constexpr (std::is_same_v<ValueType, uint8_t>)
+      return static_cast<uint8_t>(tree.get<unsigned int>("value"));
+    else
+      return tree.get<ValueType>("value");
+  }
+
+  template <typename ValueType>
+  pt::ptree
+  toTree(const std::vector<std::map<xdp::tile_type, ValueType>>& maps)
+  {
+    pt::ptree tree;
+    for (auto& map : maps) {
+      pt::ptree mapTree;
+      for (auto& [tile, value] : map) {
+        auto entry = toTree(tile);
+        if constexpr (std::is_same_v<ValueType, uint8_t>)
+          entry.put("value", +value);
+        else
+          entry.put("value", value);
+        mapTree.push_back({"", entry});
+      }
+      tree.push_back({"", mapTree});
+    }
+    return tree;
+  }
+
+  template <typename ValueType>
+  std::vector<std::map<xdp::tile_type, ValueType>>
+  toMaps(const pt::ptree& tree)
+  {
+    std::vector<std::map<xdp::tile_type, ValueType>> maps;
+    for (auto& mapTree : tree) {
+      auto& map = maps.emplace_back();
+      for (auto& entry : mapTree.second)
+        map[toTile(entry.second)] = getValue<ValueType>(entry.second);
+    }
+    return maps;
+  }
+
+} // end anonymous namespace
+
+namespace xdp::aie {
+
+  using severity_level = xrt_core::message::severity_level;
+
+  ConfigCache::
+  ConfigCache(const std::string& name, const xrt_core::uuid& xclbinUuid,
+              std::vector<std::string> settingsVec)
+    : uuid(xclbinUuid.to_string())
+    , settings(std::move(settingsVec))
+  {
+    auto dir = xrt_core::config::get_aie_config_cache_dir();
+    if (dir.empty() || !xclbinUuid)
+      return;
+
+    std::string joined;
+    for (auto& setting : settings)
+      joined.append(setting).push_back('\n');
+
+    std::stringstream fnm;
+    fnm << name << "-" << uuid << "-" << std::hex << std::hash<std::string>{}(joined) << ".json";
+    path = (std::filesystem::path(dir) / fnm.str()).string();
+  }
+
+  bool
+  ConfigCache::
+  read(tile_config& config) const
+  {
+    if (path.empty() || !std::filesystem::exists(path))
+      return false;
+
+    try {
+      pt::ptree tree;
+      pt::read_json(path, tree);
+
+      // Settings hash can collide, compare the settings themselves
+      std::vector<std::string> cachedSettings;
+      for (auto& setting : tree.get_child("settings"))
+        cachedSettings.push_back(setting.second.get_value<std::string>());
+      if (tree.get<std::string>("uuid") != uuid || cachedSettings != settings)
+        return false;
+
+      config.metrics = toMaps<std::string>(tree.get_child("metrics"));
+      config.channels = toMaps<uint8_t>(tree.get_child("channels"));
+    }
+    catch (const std::exception& e) {
+      std::string msg = "Unable to read AIE configuration cache " + path + ": " + e.what();
+      xrt_core::message::send(severity_level::warning, "XRT", msg);
+      return false;
+    }
+
+    xrt_core::message::send(severity_level::info, "XRT", "Using cached AIE configuration " + path);
+    return true;
+  }
+
+  void
+  ConfigCache::
+  write(const tile_config& config) const
+  {
+    if (path.empty())
+      return;
+
+    pt::ptree settingsTree;
+    for (auto& setting : settings) {
+      pt::ptree value;
+      value.put("", setting);
+      settingsTree.push_back({"", value});
+    }
+
+    pt::ptree tree;
+    tree.put("uuid", uuid);
+    tree.add_child("settings", settingsTree);
+    tree.add_child("metrics", toTree(config.metrics));
+    tree.add_child("channels", toTree(config.channels));
+
+    // Write to a temporary file and rename, concurrent runs never
+    // observe a partially written entry
+    try {
+      std::filesystem::path fpath(path);
+      std::filesystem::create_directories(fpath.parent_path());
+      auto tmp = fpath;
+      tmp += ".tmp" + std::to_string(std::random_device{}());
+      pt::write_json(tmp.string(), tree);
+      std::filesystem::rename(tmp, fpath);
+    }
+    catch (const std::exception& e) {
+      std::string msg = "Unable to write AIE configuration cache " + path + ": " + e.what();
+      xrt_core::message::send(severity_level::warning, "XRT", msg);
+    }
+  }
+
+} // namespace xdp::aie
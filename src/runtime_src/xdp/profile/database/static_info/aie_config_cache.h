@@ -0,0 +1,68 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef AIE_CONFIG_CACHE_DOT_H
+#define AIE_CONFIG_CACHE_DOT_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "core/common/uuid.h"
+#include "xdp/config.h"
+#include "xdp/profile/database/static_info/aie_constructs.h"
+
+namespace xdp::aie {
+
+  // Tile configuration resolved from AIE metadata and xrt.ini
+  // settings, i.e. the metric set and channels of each tile
+  struct tile_config
+  {
+    std::vector<std::map<tile_type, std::string>> metrics;
+    std::vector<std::map<tile_type, uint8_t>> channels;
+  };
+
+  // On disk cache of resolved tile configurations.  An entry is keyed
+  // by the xclbin UUID and the xrt.ini settings it was resolved from,
+  // a run with the same xclbin and settings reuses it instead of
+  // resolving tiles again.  The cache is enabled by setting
+  // Debug.aie_config_cache_dir in xrt.ini.
+  class ConfigCache
+  {
+  public:
+    XDP_CORE_EXPORT
+    ConfigCache(const std::string& name, const xrt_core::uuid& uuid,
+                std::vector<std::string> settings);
+
+    // Read cached configuration, false if not cached
+    XDP_CORE_EXPORT
+    bool
+    read(tile_config& config) const;
+
+    XDP_CORE_EXPORT
+    void
+    write(const tile_config& config) const;
+
+  private:
+    std::string path;
+    std::string uuid;
+    std::vector<std::string> settings;
+  };
+
+} // namespace xdp::aie
+
+#endif
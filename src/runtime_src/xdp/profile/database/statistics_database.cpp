@@ -226,13 +226,7 @@ namespace xdp {
     // the starts in a vector.  If the thread makes a recursive call, we'll
     // have multiple elements where the start value is set but the end value
     // needs to be filled in.
-    if (callCount.find(key) == callCount.end()) {
-      std::vector<std::pair<double, double>> newVector;
-      newVector.push_back(value);
-      callCount[key] = newVector;
-    }
-    else
-      callCount[key].push_back(value);
+    callCount[key].push_back(value);
 
     // OpenCL specific information 
     if (name == "clEnqueueMigrateMemObjects")
@@ -250,15 +244,119 @@ namespace xdp {
     // Since some calls might be recursive, we must go backwards to find
     // the first call that has a start time set but no end time.  Since we've
     // incorporated the thread id as part of our key, we will match recursive
-    // calls correctly
-    for (auto iter = callCount[key].rbegin();
-         iter != callCount[key].rend();
-         ++iter) {
+    // calls correctly.  The completed call is folded into the statistics
+    // of the API, so only calls in flight are kept.
+    auto calls = callCount.find(key);
+    if (calls == callCount.end())
+      return;
+
+    auto& starts = calls->second;
+    for (auto iter = starts.rbegin(); iter != starts.rend(); ++iter) {
       if ((*iter).second == 0) {
-        (*iter).second = timestamp;
+        callStats[name].update(static_cast<uint64_t>(timestamp - (*iter).first));
+        starts.erase(std::next(iter).base());
         break;
       }
     }
+    if (starts.empty())
+      callCount.erase(calls);
+  }
+
+  void VPStatisticsDatabase::logFunctionCall(const std::string& name,
+                                             uint64_t duration)
+  {
+    std::lock_guard<std::mutex> lock(dbLock);
+    callStats[name].update(duration);
+  }
+
+  // Label values are quoted, escape what Prometheus requires
+  static std::string metricLabel(const std::string& value)
+  {
+    std::string escaped ;
+    for (auto c : value) {
+      if (c == '\\' || c == '"')
+        escaped += '\\' ;
+      if (c == '\n') {
+        escaped += "\\n" ;
+        continue ;
+      }
+      escaped += c ;
+    }
+    return escaped ;
+  }
+
+  void VPStatisticsDatabase::writeMetrics(std::ostream& out)
+  {
+    // All times in the database are in nanoseconds
+    constexpr double one_billion = 1.0e9 ;
+
+    auto header = [&out](const char* name, const char* help) {
+      out << "# HELP " << name << " " << help << "\n"
+          << "# TYPE " << name << " counter\n" ;
+    } ;
+
+    {
+      std::lock_guard<std::mutex> lock(dbLock) ;
+
+      // Completed calls across all threads
+      std::map<std::string, std::pair<uint64_t, double>> apis ;
+      for (const auto& stat : callStats) {
+        auto& api = apis[stat.first] ;
+        api.first += stat.second.numExecutions ;
+        api.second += static_cast<double>(stat.second.totalTime) ;
+      }
+
+      header("xrt_api_calls_total", "Number of completed API calls") ;
+      for (const auto& api : apis)
+        out << "xrt_api_calls_total{api=\"" << metricLabel(api.first) << "\"} "
+            << api.second.first << "\n" ;
+      header("xrt_api_call_seconds_total", "Time spent in API calls") ;
+      for (const auto& api : apis)
+        out << "xrt_api_call_seconds_total{api=\"" << metricLabel(api.first) << "\"} "
+            << api.second.second / one_billion << "\n" ;
+
+      header("xrt_kernel_executions_total", "Number of kernel executions") ;
+      for (const auto& kernel : kernelExecutionStats)
+        out << "xrt_kernel_executions_total{kernel=\"" << metricLabel(kernel.first) << "\"} "
+            << kernel.second.numExecutions << "\n" ;
+      header("xrt_kernel_execution_seconds_total", "Time spent in kernel executions") ;
+      for (const auto& kernel : kernelExecutionStats)
+        out << "xrt_kernel_execution_seconds_total{kernel=\"" << metricLabel(kernel.first) << "\"} "
+            << static_cast<double>(kernel.second.totalTime) / one_billion << "\n" ;
+
+      // Compute units are tracked per work group configuration
+      std::map<std::string, std::pair<uint64_t, uint64_t>> cus ;
+      for (const auto& cu : computeUnitExecutionStats) {
+        auto& total = cus[std::get<0>(cu.first)] ;
+        total.first += cu.second.numExecutions ;
+        total.second += cu.second.totalTime ;
+      }
+      header("xrt_cu_executions_total", "Number of compute unit executions") ;
+      for (const auto& cu : cus)
+        out << "xrt_cu_executions_total{cu=\"" << metricLabel(cu.first) << "\"} "
+            << cu.second.first << "\n" ;
+      header("xrt_cu_busy_seconds_total", "Time compute units were executing") ;
+      for (const auto& cu : cus)
+        out << "xrt_cu_busy_seconds_total{cu=\"" << metricLabel(cu.first) << "\"} "
+            << static_cast<double>(cu.second.second) / one_billion << "\n" ;
+    }
+
+    auto transfers = [&out, &header](const char* dir, std::mutex& lk,
+                      const std::map<std::pair<uint64_t, uint64_t>, BufferStatistics>& stats) {
+      std::lock_guard<std::mutex> lock(lk) ;
+      auto name = std::string("xrt_host_") + dir ;
+      header((name + "_bytes_total").c_str(), "Bytes transferred between host and device") ;
+      for (const auto& s : stats)
+        out << name << "_bytes_total{context=\"" << s.first.first
+            << "\",device=\"" << s.first.second << "\"} " << s.second.totalSize << "\n" ;
+      header((name + "_seconds_total").c_str(), "Time spent in host and device transfers") ;
+      for (const auto& s : stats)
+        out << name << "_seconds_total{context=\"" << s.first.first
+            << "\",device=\"" << s.first.second << "\"} "
+            << static_cast<double>(s.second.totalTime) / one_billion << "\n" ;
+    } ;
+    transfers("read", readsLock, hostReads) ;
+    transfers("write", writesLock, hostWrites) ;
   }
 
   void VPStatisticsDatabase::logMemoryTransfer(uint64_t deviceId,
@@ -306,6 +404,8 @@ namespace xdp {
                                                 const char** buffers,
                                                 uint64_t numBuffers)
   {
+    std::lock_guard<std::mutex> lock(dbLock) ;
+
     if (kernelExecutionStats.find(kernelName) == kernelExecutionStats.end())
     {
       TimeStatistics blank ;
@@ -344,6 +444,8 @@ namespace xdp {
                                                      const std::string& globalWorkGroup,
                                                      uint64_t executionTime)
   {
+    std::lock_guard<std::mutex> lock(dbLock) ;
+
     // If global work size is not known, then we need to get it from the latest enqueue 
     // of the associated kernel.
     std::string globalWork = globalWorkGroup;
@@ -448,17 +550,12 @@ namespace xdp {
     //  the number of calls
     std::map<std::string, uint64_t> counts ;
 
+    for (const auto& c : callStats)
+      counts[c.first] += c.second.numExecutions ;
+
+    // Calls still in flight
     for (const auto& c : callCount)
-    {
-      if (counts.find(c.first.first) == counts.end())
-      {
-        counts[c.first.first] = c.second.size() ;
-      }
-      else
-      {
-        counts[c.first.first] += c.second.size() ;
-      }
-    }
+      counts[c.first.first] += c.second.size() ;
 
     for (const auto& i : counts)
     {
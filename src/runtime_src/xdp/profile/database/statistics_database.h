@@ -175,10 +175,15 @@ namespace xdp {
     VPDatabase* db ;
 
   private:
-    // Statistics on API calls (OpenCL and HAL) have to be thread specific
+    // Start times of API calls in flight (OpenCL and HAL), these have
+    // to be thread specific
     std::map<std::pair<std::string, std::thread::id>,
              std::vector<std::pair<double, double>>> callCount ;
 
+    // Completed API calls keyed by name, aggregated as they complete
+    // so the summary does not revisit every call
+    std::map<std::string, TimeStatistics> callStats ;
+
     // **** User Level Event Statistics ****
     std::map<std::string, uint64_t> eventCounts ;
     std::map<std::pair<const char*, const char*>, uint64_t> rangeCounts ;
@@ -256,6 +261,8 @@ namespace xdp {
     inline const std::map<std::pair<std::string, std::thread::id>,
                     std::vector<std::pair<double, double>>>& getCallCount() 
       { return callCount ; }
+    inline const std::map<std::string, TimeStatistics>& getCallStats()
+      { return callStats ; }
     inline const std::map<uint64_t, DeviceMemoryStatistics>& getMemoryStats() 
       { return memoryStats ; }
     inline const std::map<std::string, TimeStatistics>& getKernelExecutionStats() 
@@ -336,6 +343,13 @@ namespace xdp {
                                          double timestamp) ;
     XDP_CORE_EXPORT void logFunctionCallEnd(const std::string& name, 
                                        double timestamp) ;
+    XDP_CORE_EXPORT void logFunctionCall(const std::string& name,
+                                         uint64_t duration) ;
+
+    // Write a consistent snapshot of the API, kernel, compute unit, and
+    // host transfer statistics in Prometheus text format.  Safe to call
+    // while the statistics are being updated.
+    XDP_CORE_EXPORT void writeMetrics(std::ostream& out) ;
 
     XDP_CORE_EXPORT void logMemoryTransfer(uint64_t deviceId, 
                                       DeviceMemoryStatistics::ChannelType channelType,
@@ -17,6 +17,7 @@
 
 #define XDP_PLUGIN_SOURCE
 
+#include <algorithm>
 #include <iostream>
 
 #include "core/common/message.h"
@@ -67,9 +68,11 @@ AIETraceOffload::AIETraceOffload
 
   // Select appropriate reader
   if (isPLIO)
-    mReadTrace = std::bind(&AIETraceOffload::readTracePLIO, this, std::placeholders::_1);
+    mReadTrace = std::bind(&AIETraceOffload::readTracePLIO, this, std::placeholders::_1,
+                           std::placeholders::_2, std::placeholders::_3);
   else
-    mReadTrace = std::bind(&AIETraceOffload::readTraceGMIO, this, std::placeholders::_1);
+    mReadTrace = std::bind(&AIETraceOffload::readTraceGMIO, this, std::placeholders::_1,
+                           std::placeholders::_2, std::placeholders::_3);
 }
 
 AIETraceOffload::~AIETraceOffload()
@@ -282,12 +285,15 @@ void AIETraceOffload::endReadTrace()
   bufferInitialized = false;
 }
 
-void AIETraceOffload::readTraceGMIO(bool final)
+// Read streams [first, last), return the largest amount of trace
+// read from any one of them
+uint64_t AIETraceOffload::readTraceGMIO(bool final, uint64_t first, uint64_t last)
 {
   // Keep it low to save bandwidth
   constexpr uint64_t chunk_512k = 0x80000;
+  uint64_t maxBytes = 0;
 
-  for (uint64_t index = 0; index < numStream; ++index) {
+  for (uint64_t index = first; index < last; ++index) {
     auto& bd = buffers[index];
     if (bd.offloadDone)
       continue;
@@ -298,16 +304,22 @@ void AIETraceOffload::readTraceGMIO(bool final)
       chunkEnd = bufAllocSz;
     bd.usedSz = chunkEnd;
 
-    bd.offset += syncAndLog(index);
+    auto nBytes = syncAndLog(index);
+    bd.offset += nBytes;
+    maxBytes = std::max(maxBytes, nBytes);
   }
+  return maxBytes;
 }
 
-void AIETraceOffload::readTracePLIO(bool final)
+// Read streams [first, last), return the largest amount of trace
+// read from any one of them
+uint64_t AIETraceOffload::readTracePLIO(bool final, uint64_t first, uint64_t last)
 {
+  uint64_t maxBytes = 0;
   if (mCircularBufOverwrite)
-    return;
+    return maxBytes;
 
-  for (uint64_t index = 0; index < numStream; ++index) {
+  for (uint64_t index = first; index < last; ++index) {
     auto& bd = buffers[index];
 
     if (bd.offloadDone)
@@ -337,7 +349,7 @@ void AIETraceOffload::readTracePLIO(bool final)
       // Fatal condition. Abort offload
       mCircularBufOverwrite = true;
       stopOffload();
-      return;
+      return maxBytes;
     }
 
     // Start Offload from previous offset
@@ -367,7 +379,8 @@ void AIETraceOffload::readTracePLIO(bool final)
         << std::endl;
     }
 
-    if (!syncAndLog(index))
+    auto nBytes = syncAndLog(index);
+    if (!nBytes)
       continue;
 
     // Do another sync if we're crossing circular buffer boundary
@@ -382,9 +395,11 @@ void AIETraceOffload::readTracePLIO(bool final)
         << "Circular buffer boundary read from 0x0 to 0x: "
         << std::hex << circBufRolloverBytes << std::dec << std::endl;
 
-      syncAndLog(index);
+      nBytes += syncAndLog(index);
     }
+    maxBytes = std::max(maxBytes, nBytes);
   }
+  return maxBytes;
 }
 
 uint64_t AIETraceOffload::syncAndLog(uint64_t index)
@@ -499,17 +514,51 @@ void AIETraceOffload::continuousOffload()
     return;
   }
 
-  while (keepOffloading()) {
-    mReadTrace(false);
-    std::this_thread::sleep_for(std::chrono::microseconds(offloadIntervalUs));
+  // Each group of streams is drained by its own worker so that
+  // buffers of a large number of streams are revisited in time
+  uint64_t numGroups = (numStream + AIE_TRACE_STREAMS_PER_OFFLOAD_THREAD - 1) / AIE_TRACE_STREAMS_PER_OFFLOAD_THREAD;
+  if (numGroups <= 1) {
+    offloadStreams(0, numStream);
+  }
+  else {
+    std::vector<std::thread> workers;
+    workers.reserve(numGroups);
+    for (uint64_t first = 0; first < numStream; first += AIE_TRACE_STREAMS_PER_OFFLOAD_THREAD) {
+      auto last = std::min(first + AIE_TRACE_STREAMS_PER_OFFLOAD_THREAD, numStream);
+      workers.emplace_back(&AIETraceOffload::offloadStreams, this, first, last);
+    }
+    for (auto& worker : workers)
+      worker.join();
   }
 
   // Note: This will call flush and reset on datamover
-  mReadTrace(true);
+  mReadTrace(true, 0, numStream);
   endReadTrace();
   offloadFinished();
 }
 
+// Offload streams [first, last) until stopped.  The interval between
+// reads starts at the requested offload interval and is shortened
+// while reads return more than half a buffer, then relaxed back once
+// reads return less than an eighth of a buffer.
+void AIETraceOffload::offloadStreams(uint64_t first, uint64_t last)
+{
+  uint64_t maxIntervalUs = offloadIntervalUs;
+  uint64_t minIntervalUs = std::min<uint64_t>(maxIntervalUs, AIE_TRACE_MIN_OFFLOAD_INT_US);
+  uint64_t intervalUs = maxIntervalUs;
+
+  while (keepOffloading()) {
+    auto nBytes = mReadTrace(false, first, last);
+
+    if (nBytes > bufAllocSz / 2)
+      intervalUs = std::max(minIntervalUs, intervalUs / 2);
+    else if (nBytes < bufAllocSz / 8)
+      intervalUs = std::min(maxIntervalUs, std::max<uint64_t>(intervalUs * 2, 1));
+
+    std::this_thread::sleep_for(std::chrono::microseconds(intervalUs));
+  }
+}
+
 bool AIETraceOffload::keepOffloading()
 {
   std::lock_guard<std::mutex> lock(statusLock);
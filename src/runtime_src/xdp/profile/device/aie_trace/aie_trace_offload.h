@@ -20,6 +20,12 @@
 
 #include "xdp/profile/device/tracedefs.h"
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 /*
  * XRT_NATIVE_BUILD is set only for x86 builds
  * We can only include/compile aie specific headers, when compiling for edge+versal.
@@ -115,7 +121,7 @@ public:
       return offloadStatus;
     };
 
-    void readTrace(bool final) {mReadTrace(final);};
+    void readTrace(bool final) {mReadTrace(final, 0, numStream);};
 
 private:
 
@@ -152,18 +158,19 @@ private:
 
     //Circular Buffer Tracking
     bool mEnCircularBuf;
-    bool mCircularBufOverwrite;
+    std::atomic<bool> mCircularBufOverwrite;
 
 private:
-    void readTracePLIO(bool final);
-    void readTraceGMIO(bool final);
+    uint64_t readTracePLIO(bool final, uint64_t first, uint64_t last);
+    uint64_t readTraceGMIO(bool final, uint64_t first, uint64_t last);
     bool setupPSKernel();
     void continuousOffload();
+    void offloadStreams(uint64_t first, uint64_t last);
     bool keepOffloading();
     void offloadFinished();
     void checkCircularBufferSupport();
     uint64_t syncAndLog(uint64_t index);
-    std::function<void(bool)> mReadTrace;
+    std::function<uint64_t(bool, uint64_t, uint64_t)> mReadTrace;
     uint64_t searchWrittenBytes(void * buf, uint64_t bytes);
 };
 
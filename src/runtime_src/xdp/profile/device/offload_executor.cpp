@@ -0,0 +1,172 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_CORE_SOURCE
+
+#include "xdp/profile/device/offload_executor.h"
+
+#include "core/common/config_reader.h"
+#include "core/common/message.h"
+
+#include <algorithm>
+#include <exception>
+#include <string>
+
+namespace xdp {
+
+OffloadExecutor&
+OffloadExecutor::
+instance()
+{
+  static OffloadExecutor executor(std::max(1u, xrt_core::config::get_device_offload_threads()));
+  return executor;
+}
+
+OffloadExecutor::
+OffloadExecutor(unsigned int max_threads)
+  : m_max_threads(max_threads)
+{}
+
+OffloadExecutor::
+~OffloadExecutor()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_work.notify_all();
+  m_done.notify_all();
+  for (auto& t : m_threads)
+    t.join();
+}
+
+uint64_t
+OffloadExecutor::
+add(task_type task, std::chrono::milliseconds interval, fill_type fill)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto id = m_next_id++;
+  auto& e = m_tasks[id];
+  e.task = std::move(task);
+  e.fill = std::move(fill);
+  e.interval = interval;
+  e.due = clock::now();
+
+  // Threads are added as tasks are added, up to the bound
+  auto active = std::count_if(m_tasks.begin(), m_tasks.end(),
+                              [](const auto& t) { return !t.second.finished; });
+  if (m_threads.size() < std::min<size_t>(m_max_threads, active))
+    m_threads.emplace_back(&OffloadExecutor::worker, this);
+
+  m_work.notify_one();
+  return id;
+}
+
+void
+OffloadExecutor::
+remove(uint64_t id)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto itr = m_tasks.find(id);
+  if (itr == m_tasks.end())
+    return;
+
+  m_done.wait(lock, [this, &itr] {
+    return !itr->second.running && (itr->second.finished || m_stop);
+  });
+  m_tasks.erase(itr);
+}
+
+std::chrono::microseconds
+OffloadExecutor::
+max_lag(uint64_t id)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto itr = m_tasks.find(id);
+  return (itr == m_tasks.end()) ? std::chrono::microseconds(0) : itr->second.max_lag;
+}
+
+// Pick the due task with the fullest buffers, or compute when the
+// next task becomes due.  Called with m_mutex held.
+std::map<uint64_t, OffloadExecutor::entry>::iterator
+OffloadExecutor::
+next_task(clock::time_point now, clock::time_point& wakeup)
+{
+  auto next = m_tasks.end();
+  double next_fill = -1;
+  wakeup = clock::time_point::max();
+
+  for (auto itr = m_tasks.begin(); itr != m_tasks.end(); ++itr) {
+    auto& e = itr->second;
+    if (e.running || e.finished)
+      continue;
+
+    if (e.due > now) {
+      wakeup = std::min(wakeup, e.due);
+      continue;
+    }
+
+    auto fill = e.fill ? e.fill() : 0.0;
+    if (fill > next_fill) {
+      next = itr;
+      next_fill = fill;
+    }
+  }
+  return next;
+}
+
+void
+OffloadExecutor::
+worker()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stop) {
+    auto now = clock::now();
+    clock::time_point wakeup;
+    auto itr = next_task(now, wakeup);
+    if (itr == m_tasks.end()) {
+      if (wakeup == clock::time_point::max())
+        m_work.wait(lock);
+      else
+        m_work.wait_until(lock, wakeup);
+      continue;
+    }
+
+    auto& e = itr->second;
+    auto lag = std::chrono::duration_cast<std::chrono::microseconds>(now - e.due);
+    e.max_lag = std::max(e.max_lag, lag);
+    e.running = true;
+
+    // The entry is not erased while running, remove() waits for it
+    lock.unlock();
+    bool more = false;
+    try {
+      more = e.task();
+    }
+    catch (const std::exception& ex) {
+      std::string msg = std::string("Device offload task failed: ") + ex.what();
+      xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", msg);
+    }
+    lock.lock();
+
+    e.running = false;
+    e.finished = !more;
+    e.due = clock::now() + e.interval;
+    m_done.notify_all();
+  }
+}
+
+} // namespace xdp
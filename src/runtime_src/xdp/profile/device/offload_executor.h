@@ -0,0 +1,104 @@
+/**
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. - All rights reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef XDP_PROFILE_DEVICE_OFFLOAD_EXECUTOR_H_
+#define XDP_PROFILE_DEVICE_OFFLOAD_EXECUTOR_H_
+
+#include "xdp/config.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace xdp {
+
+// class OffloadExecutor - Bounded thread pool for periodic offload
+//
+// Device offloaders register periodic tasks instead of running a
+// thread each.  A task is run again one interval after its previous
+// run finished, and is never run concurrently with itself.  When more
+// tasks are due than there are threads, the task reporting the fullest
+// buffers runs first.  The executor records how late each task was
+// started relative to when it was due.
+class OffloadExecutor
+{
+public:
+  // Run one pass, return false once the task is finished
+  using task_type = std::function<bool()>;
+  // Fill level of the buffers drained by a task in [0, 1]
+  using fill_type = std::function<double()>;
+  using clock = std::chrono::steady_clock;
+
+  XDP_CORE_EXPORT
+  static OffloadExecutor&
+  instance();
+
+  XDP_CORE_EXPORT
+  ~OffloadExecutor();
+
+  // Schedule task to run now and every interval after
+  XDP_CORE_EXPORT
+  uint64_t
+  add(task_type task, std::chrono::milliseconds interval, fill_type fill = nullptr);
+
+  // Wait for task to finish and unschedule it
+  XDP_CORE_EXPORT
+  void
+  remove(uint64_t id);
+
+  // Largest delay between task being due and being run
+  XDP_CORE_EXPORT
+  std::chrono::microseconds
+  max_lag(uint64_t id);
+
+private:
+  struct entry
+  {
+    task_type task;
+    fill_type fill;
+    std::chrono::milliseconds interval;
+    clock::time_point due;
+    std::chrono::microseconds max_lag {0};
+    bool running = false;
+    bool finished = false;
+  };
+
+  explicit OffloadExecutor(unsigned int max_threads);
+
+  void
+  worker();
+
+  std::map<uint64_t, entry>::iterator
+  next_task(clock::time_point now, clock::time_point& wakeup);
+
+  std::mutex m_mutex;
+  std::condition_variable m_work;   // task added or due
+  std::condition_variable m_done;   // pass completed
+  std::map<uint64_t, entry> m_tasks;
+  std::vector<std::thread> m_threads;
+  unsigned int m_max_threads;
+  uint64_t m_next_id = 1;
+  bool m_stop = false;
+};
+
+} // namespace xdp
+
+#endif
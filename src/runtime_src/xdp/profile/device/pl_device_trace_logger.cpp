@@ -696,35 +696,40 @@ namespace xdp {
   }
 
   // Clock training packets in hardware have pairs of device timestamps and
-  // corresponding host timestamps.  We need at least two training packets
-  // to plot a line and get the slopes we use for adjusting timestamps.
-  // As the device progresses, we'll encounter additional training packets and
-  // they may not be continuous, so this function uses static variables
-  // to keep track of the last packet we've seen.
+  // corresponding host timestamps.  Every pair is added to a least squares
+  // fit of host time over device time, so the mapping improves with each
+  // training instead of being rederived from the last two samples, and
+  // training can be issued less often.  Older samples are discounted so
+  // the slope follows drift of the device clock.  Until two distinct
+  // samples are seen the nominal trace clock rate is used as slope.
   void PLDeviceTraceLogger::trainDeviceHostTimestamps(uint64_t deviceTimestamp, uint64_t hostTimestamp)
   {
-    static double y1 = 0.0;
-    static double y2 = 0.0;
-    static double x1 = 0.0;
-    static double x2 = 0.0;
-
-    if (!y1 && !x1) {
-      y1 = static_cast <double> (hostTimestamp);
-      x1 = static_cast <double> (deviceTimestamp);
-    } else {
-      y2 = static_cast <double> (hostTimestamp);
-      x2 = static_cast <double> (deviceTimestamp);
-      // slope in ns/cycle
-      if (xdp::getFlowMode() == HW) {
-        clockTrainSlope = 1000.0/traceClockRateMHz;
-      } else {
-        clockTrainSlope = (y2 - y1) / (x2 - x1);
-      }
-      clockTrainOffset = y2 - clockTrainSlope * x2;
-      // next time update x1, y1
-      y1 = 0.0;
-      x1 = 0.0;
-    }
+    constexpr double forget = 0.9;
+
+    if (!clockTrainSamples) {
+      clockTrainDevice0 = deviceTimestamp;
+      clockTrainHost0 = hostTimestamp;
+    }
+
+    auto x = static_cast<double>(static_cast<int64_t>(deviceTimestamp - clockTrainDevice0));
+    auto y = static_cast<double>(static_cast<int64_t>(hostTimestamp - clockTrainHost0));
+    ++clockTrainSamples;
+    clockTrainWeight = clockTrainWeight * forget + 1;
+    clockTrainSumX = clockTrainSumX * forget + x;
+    clockTrainSumY = clockTrainSumY * forget + y;
+    clockTrainSumXX = clockTrainSumXX * forget + x * x;
+    clockTrainSumXY = clockTrainSumXY * forget + x * y;
+
+    // slope in ns/cycle
+    double slope = 1000.0/traceClockRateMHz;
+    double varX = clockTrainSumXX - clockTrainSumX * clockTrainSumX / clockTrainWeight;
+    if (clockTrainSamples > 1 && varX > 0)
+      slope = (clockTrainSumXY - clockTrainSumX * clockTrainSumY / clockTrainWeight) / varX;
+
+    clockTrainSlope = slope;
+    clockTrainOffset = static_cast<double>(clockTrainHost0)
+      + (clockTrainSumY - slope * clockTrainSumX) / clockTrainWeight
+      - slope * static_cast<double>(clockTrainDevice0);
   }
 
   // Convert device timestamp to host time domain (in msec)
@@ -742,33 +747,28 @@ namespace xdp {
 
     uint64_t numPackets = numBytes / sizeof(uint64_t);
     uint64_t start = 0;
+    auto packets = static_cast<uint64_t*>(data);
 
     // Try to find 8 contiguous clock training packets.  Anything before that
     //  is garbage from the previous run
     // Note: This needs to be done only in beginning chunk of data
-    static bool found = false;
-    if (!found) {
-      for (uint64_t i = 0; i < numPackets - 8; ++i) {
-        for (uint64_t j = i; j < i + 8; ++j) {
-          uint64_t packet = (static_cast<uint64_t*>(data))[j];
-          if (!isClockTraining(packet))
-            break;
-          if (j == (i + 7)) {
-            start = i ;
-            found = true;
-          }
+    if (!foundClockTraining) {
+      uint64_t run = 0;
+      for (uint64_t i = 0; i < numPackets; ++i) {
+        if (!isClockTraining(packets[i])) {
+          run = 0;
+          continue;
         }
-        if (found)
+        if (++run == 8) {
+          start = i - 7;
+          foundClockTraining = true;
           break;
+        }
       }
     }
 
-    // Clock Training state is preserved across calls
-    static uint32_t modulus = 0;
-    static uint64_t clockTrainingHostTimestamp = 0;
-
     for (uint64_t i = start ; i < numPackets ; ++i) {
-      uint64_t packet = (static_cast<uint64_t*>(data))[i];
+      uint64_t packet = packets[i];
       auto deviceTimestamp = getDeviceTimestamp(packet);
       auto traceId = getTraceId(packet);
       auto clockTrainingDeviceTimestamp = deviceTimestamp;
@@ -780,7 +780,7 @@ namespace xdp {
       */
 
       if (isClockTraining(packet)) {
-        if (modulus == 0) {
+        if (clockTrainingModulus == 0) {
           if (clockTrainingDeviceTimestamp >= firstTimestamp) {
             clockTrainingDeviceTimestamp =
               clockTrainingDeviceTimestamp - firstTimestamp;
@@ -790,16 +790,16 @@ namespace xdp {
               clockTrainingDeviceTimestamp + (0x1FFFFFFFFFFF - firstTimestamp);
           }
         }
-        clockTrainingHostTimestamp |= ((packet >> 45) & 0xFFFF) << (16 * modulus);
-        ++modulus;
-        if (modulus == 4) {
+        clockTrainingHostTimestamp |= ((packet >> 45) & 0xFFFF) << (16 * clockTrainingModulus);
+        ++clockTrainingModulus;
+        if (clockTrainingModulus == 4) {
           // It requires four complete clock training packets before
           //  we can perform the clock training algorithm
           trainDeviceHostTimestamps(clockTrainingDeviceTimestamp,
                                     clockTrainingHostTimestamp);
           clockTrainingHostTimestamp = 0;
           clockTrainingDeviceTimestamp = 0;
-          modulus = 0;
+          clockTrainingModulus = 0;
         }
         continue;
       }
@@ -102,6 +102,24 @@ namespace xdp {
     // Used to mark timeline trace if trace buffer gets full
     double mLatestHostTimestampMs = 0;
 
+    // Clock training state preserved across calls to processTraceData.
+    // Kept per logger so devices can be processed on separate threads.
+    bool foundClockTraining = false;
+    uint32_t clockTrainingModulus = 0;
+    uint64_t clockTrainingHostTimestamp = 0;
+
+    // Weighted least squares fit of host time over device time across
+    // clock training samples.  Sums are relative to the first sample to
+    // keep precision.
+    uint64_t clockTrainSamples = 0;
+    uint64_t clockTrainDevice0 = 0;
+    uint64_t clockTrainHost0 = 0;
+    double clockTrainWeight = 0;
+    double clockTrainSumX = 0;
+    double clockTrainSumY = 0;
+    double clockTrainSumXX = 0;
+    double clockTrainSumXY = 0;
+
   private:
     static constexpr uint64_t CU_MASK        = 0x1;
     static constexpr uint64_t STALL_INT_MASK = 0x2;
@@ -18,9 +18,12 @@
 #define XDP_CORE_SOURCE
 
 #include "xdp/profile/device/pl_device_trace_offload.h"
+#include "xdp/profile/device/offload_executor.h"
 #include "xdp/profile/device/pl_device_trace_logger.h"
 #include "experimental/xrt_profile.h"
 
+#include <algorithm>
+
 namespace xdp {
 
 PLDeviceTraceOffload::
@@ -33,9 +36,9 @@ PLDeviceTraceOffload
   : dev_intf(dInt)
   , deviceTraceLogger(dTraceLogger)
   , sleep_interval_ms(sleep_interval_ms)
+  , m_fill(0)
   , m_prev_clk_train_time(std::chrono::system_clock::now())
   , m_process_trace(false)
-  , m_process_trace_done(false)
 {
   // Select appropriate reader
   if (has_fifo()) {
@@ -52,71 +55,78 @@ PLDeviceTraceOffload::
 ~PLDeviceTraceOffload()
 {
   stop_offload();
-  if (offload_thread.joinable()) {
-    offload_thread.join();
-  }
-  if (process_thread.joinable()) {
-    process_thread.join();
-  }
+
+  // Tasks finish their final pass once offload is stopped
+  auto& executor = OffloadExecutor::instance();
+  if (offload_task)
+    executor.remove(offload_task);
+  if (process_task)
+    executor.remove(process_task);
 }
 
-void PLDeviceTraceOffload::
+// One pass of continuous offload, false once offload is finished
+bool PLDeviceTraceOffload::
 offload_device_continuous()
 {
   if (!m_initialized) {
     offload_finished();
-    return;
+    return false;
   }
 
-  while (should_continue()) {
+  if (should_continue()) {
     train_clock();
     // Can't flush datamover in middle of offload
     m_read_trace(false);
-    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_interval_ms));
+    return true;
   }
 
   // Do final forced read
   // Note : Passing "true" also flushes and resets the datamover
   m_read_trace(true);
 
-  // Stop processing thread
-  m_process_trace = false;
-  while (!m_process_trace_done);
+  // Processing task completes the offload once it has processed
+  // all trace read
+  if (process_task) {
+    m_process_trace = false;
+    return false;
+  }
 
   // Clear all state and add approximations
   read_trace_end();
 
   // Tell external plugin that offload has finished
   offload_finished();
+  return false;
 }
 
-void PLDeviceTraceOffload::
+bool PLDeviceTraceOffload::
 train_clock_continuous()
 {
-  while (should_continue()) {
+  if (should_continue()) {
     train_clock();
-    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_interval_ms));
+    return true;
   }
 
   offload_finished();
+  return false;
 }
 
-void PLDeviceTraceOffload::
+bool PLDeviceTraceOffload::
 process_trace_continuous()
 {
-  if (!has_ts2mm())
-    return;
+  process_trace();
+  if (m_process_trace)
+    return true;
 
-  m_process_trace = true;
-  m_process_trace_done = false;
-  while (m_process_trace)
-  {
-    process_trace();
-    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_interval_ms));
-  }
   // One last time
   process_trace();
-  m_process_trace_done = true;
+
+  // Clear all state and add approximations
+  read_trace_end();
+
+  // Tell external plugin that offload has finished
+  offload_finished();
+  return false;
 }
 
 void PLDeviceTraceOffload::
@@ -172,13 +182,27 @@ start_offload(OffloadThreadType type)
   std::lock_guard<std::mutex> lock(status_lock);
   status = OffloadThreadStatus::RUNNING;
 
+  // Devices share a bounded pool of offload threads, the device with
+  // the fullest trace buffers is serviced first
+  auto& executor = OffloadExecutor::instance();
+  auto interval = std::chrono::milliseconds(sleep_interval_ms);
   if (type == OffloadThreadType::TRACE) {
-    offload_thread = std::thread(&PLDeviceTraceOffload::offload_device_continuous, this);
-    process_thread = std::thread(&PLDeviceTraceOffload::process_trace_continuous, this);
+    if (has_ts2mm() && m_initialized) {
+      m_process_trace = true;
+      process_task = executor.add([this] { return process_trace_continuous(); }, interval);
+    }
+    offload_task = executor.add([this] { return offload_device_continuous(); }, interval,
+                                [this] { return m_fill.load(); });
   } else if (type == OffloadThreadType::CLOCK_TRAIN) {
-    offload_thread = std::thread(&PLDeviceTraceOffload::train_clock_continuous, this);
+    offload_task = executor.add([this] { return train_clock_continuous(); }, interval);
   }
+}
 
+std::chrono::microseconds PLDeviceTraceOffload::
+offload_lag()
+{
+  return offload_task ? OffloadExecutor::instance().max_lag(offload_task)
+                      : std::chrono::microseconds(0);
 }
 
 void PLDeviceTraceOffload::
@@ -203,14 +227,17 @@ train_clock()
   auto now = std::chrono::system_clock::now();
   auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_prev_clk_train_time).count();
 
-  // Clock training data is accurate upto 3 seconds
-  // 500 ms is a reasonable time
+  // The trace logger fits all training samples and estimates drift,
+  // so after the first trainings the interval is doubled up to a
+  // maximum.  Fewer training packets interrupt the trace stream.
   // No need of making it user configurable
-  bool enough_time_passed = milliseconds >= 500 ? true: false;
+  bool enough_time_passed = (static_cast<uint64_t>(milliseconds) >= m_clk_train_interval_ms);
 
   if (enough_time_passed || m_force_clk_train) {
     dev_intf->clockTraining(m_force_clk_train);
     m_prev_clk_train_time = now;
+    if (!m_force_clk_train)
+      m_clk_train_interval_ms = std::min<uint64_t>(m_clk_train_interval_ms * 2, CLOCK_TRAIN_MAX_INTERVAL_MS);
     debug_stream
       << "INFO Enough Time Passed.. Call Clock Training" << std::endl;
   }
@@ -251,6 +278,9 @@ read_trace_fifo(bool)
     // hw emulation has infinite fifo
     if ((num_packets >= fifo_size) && (xdp::getFlowMode() == xdp::Flow::HW))
       fifo_full = true;
+
+    if (fifo_size)
+      m_fill = std::min(1.0, static_cast<double>(num_packets) / fifo_size);
   }
 }
 
@@ -279,6 +309,19 @@ read_trace_end()
   bool isTS2MMFull = (dev_intf->hasTs2mm() && trace_buffer_full()) ? true : false;
   deviceTraceLogger->addEventMarkers(isFIFOFull, isTS2MMFull);
 
+  if (continuous) {
+    auto lag = std::chrono::duration_cast<std::chrono::milliseconds>(offload_lag()).count();
+    std::string msg = "Device trace offload ran up to " + std::to_string(lag)
+      + " ms behind its " + std::to_string(sleep_interval_ms) + " ms schedule.";
+    xrt_core::message::send(xrt_core::message::severity_level::info, "XRT", msg);
+  }
+
+  if (dropped_bytes) {
+    std::string msg = "Device trace dropped " + std::to_string(dropped_packets())
+      + " packets overwritten in the circular buffer before they could be offloaded.";
+    xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", msg);
+  }
+
   if (dev_intf->hasTs2mm()) {
     reset_s2mm();
     m_initialized = false;
@@ -288,6 +331,7 @@ read_trace_end()
 void PLDeviceTraceOffload::
 read_trace_s2mm(bool force)
 {
+  double fill = 0;
   for (uint64_t i = 0; i < ts2mm_info.num_ts2mm; i++) {
     auto& bd = ts2mm_info.buffers[i];
 
@@ -296,9 +340,16 @@ read_trace_s2mm(bool force)
 
     auto bytes_written = dev_intf->getWordCountTs2mm(i, force) * TRACE_PACKET_SIZE;
     auto bytes_read = bd.rollover_count * bd.alloc_size + bd.used_size;
-
-    // Offload cannot keep up with the DMA
-    if (bytes_written > bytes_read + bd.alloc_size) {
+    if (bd.alloc_size && bytes_written > bytes_read)
+      fill = std::max(fill, std::min(1.0, static_cast<double>(bytes_written - bytes_read) / bd.alloc_size));
+    m_fill = fill;
+
+    // Offload cannot keep up with the DMA.  A circular buffer drops
+    // the overwritten data and continues, otherwise abort.
+    if (bytes_written > bytes_read + bd.alloc_size && skip_overwritten(i, bytes_written)) {
+      bytes_read = bd.rollover_count * bd.alloc_size + bd.used_size;
+    }
+    else if (bytes_written > bytes_read + bd.alloc_size) {
       // Don't read any data
       bd.offload_done = true;
 
@@ -369,6 +420,44 @@ read_trace_s2mm(bool force)
   }
 }
 
+// The device has lapped the host in the circular buffer.  Rather than
+// giving up on the rest of the trace, drop what was overwritten and
+// resume half a buffer behind the device.  The host then reads one
+// half of the buffer while the device fills the other half.
+bool PLDeviceTraceOffload::
+skip_overwritten(uint64_t index, uint64_t bytes_written)
+{
+  auto& bd = ts2mm_info.buffers[index];
+  if (!ts2mm_info.use_circ_buf || bd.alloc_size < 2 * TRACE_PACKET_SIZE)
+    return false;
+
+  auto bytes_read = bd.rollover_count * bd.alloc_size + bd.used_size;
+  auto resume = bytes_written - bd.alloc_size / 2;
+  resume -= resume % TRACE_PACKET_SIZE;
+
+  dropped_bytes += resume - bytes_read;
+  bd.rollover_count = static_cast<uint32_t>(resume / bd.alloc_size);
+  bd.used_size = resume % bd.alloc_size;
+
+  debug_stream
+    << "ts2mm_" << index << " : dropped " << (resume - bytes_read)
+    << " bytes, resuming at 0x" << std::hex << bd.used_size << std::dec
+    << " Rollovers : " << bd.rollover_count << std::endl;
+
+  std::call_once(ts2mm_overwrite_warning_flag, [](){
+    xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", TS2MM_WARN_MSG_CIRC_BUF_OVERWRITE);
+    xrt::profile::user_event events;
+    events.mark("Trace Buffer Overwrite Detected");
+  });
+  return true;
+}
+
+uint64_t PLDeviceTraceOffload::
+dropped_packets()
+{
+  return dropped_bytes / TRACE_PACKET_SIZE;
+}
+
 bool PLDeviceTraceOffload::
 sync_and_log(uint64_t index)
 {
@@ -128,6 +128,8 @@ public:
   void process_trace();
   XDP_CORE_EXPORT
   bool trace_buffer_full();
+  XDP_CORE_EXPORT
+  uint64_t dropped_packets();
 
 public:
   bool has_fifo() {
@@ -154,6 +156,10 @@ public:
     return status;
   };
 
+  // Largest delay of continuous offload behind its schedule
+  XDP_CORE_EXPORT
+  std::chrono::microseconds offload_lag();
+
   inline bool continuous_offload() { return continuous ; }
   inline void set_continuous(bool value = true) { continuous = value ; }
 
@@ -164,11 +170,12 @@ private:
   bool init_s2mm(bool circ_buf, const std::vector<uint64_t> &);
   void reset_s2mm();
   bool should_continue();
-  void train_clock_continuous();
-  void offload_device_continuous();
+  bool train_clock_continuous();
+  bool offload_device_continuous();
   void offload_finished();
-  void process_trace_continuous();
+  bool process_trace_continuous();
   bool sync_and_log(uint64_t index);
+  bool skip_overwritten(uint64_t index, uint64_t bytes_written);
 
 protected:
   PLDeviceIntf* dev_intf;
@@ -183,26 +190,33 @@ private:
   // fifo doesn't support circular buffer mode
   bool fifo_full = false;
 
-  // Continuous offload
+  // Trace overwritten in the circular buffer before it could be read
+  uint64_t dropped_bytes = 0;
+
+  // Continuous offload runs as tasks of the shared OffloadExecutor
   std::mutex status_lock;
   uint64_t sleep_interval_ms;
   OffloadThreadStatus status = OffloadThreadStatus::IDLE;
-  std::thread offload_thread;
-  std::thread process_thread;
+  uint64_t offload_task = 0;
+  uint64_t process_task = 0;
   bool continuous = false;
 
+  // Largest unread fraction of a trace buffer seen by the last read
+  std::atomic<double> m_fill;
+
   // Clock Training Params
   bool m_force_clk_train = true;
+  uint64_t m_clk_train_interval_ms = CLOCK_TRAIN_MIN_INTERVAL_MS;
   std::chrono::time_point<std::chrono::system_clock> m_prev_clk_train_time;
 
-  // Internal flags to end trace processing thread
+  // Internal flag to end trace processing
   std::atomic<bool> m_process_trace;
-  std::atomic<bool> m_process_trace_done;
 
   // Internal flags to keep track of warnings
   std::once_flag ts2mm_queue_warning_flag;
   std::once_flag fifo_full_warning_flag;
   std::once_flag ts2mm_full_warning_flag;
+  std::once_flag ts2mm_overwrite_warning_flag;
 };
 
 }
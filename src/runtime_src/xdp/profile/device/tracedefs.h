@@ -54,6 +54,10 @@
 // Throw warning when too much trace in processing pipeline
 // Use some arbitrary large number here
 #define TS2MM_QUEUE_SZ_WARN_THRESHOLD 5000
+// Interval between clock trainings grows from min to max as the
+// device to host clock fit has enough samples to track drift
+#define CLOCK_TRAIN_MIN_INTERVAL_MS 500
+#define CLOCK_TRAIN_MAX_INTERVAL_MS 8000
 
 // In some cases, we cannot use coarse mode
 #define COARSE_MODE_UNSUPPORTED "Coarse mode cannot be enabled. Defaulting to fine mode. Please check compilation for details."
@@ -82,6 +86,10 @@ Please increase trace_buffer_size and trace_buffer_offload_interval together or
 #define AIE_TRACE_REUSE_MAX_STREAMS 4
 #define AIE_TRACE_REUSE_MAX_OFFLOAD_INT_US 100
 
+// Continuous offload of AIE trace streams
+#define AIE_TRACE_STREAMS_PER_OFFLOAD_THREAD 16
+#define AIE_TRACE_MIN_OFFLOAD_INT_US 10
+
 #define AIE_TRACE_UNAVAILABLE "Neither PLIO nor GMIO trace infrastucture is found in the given design. So, AIE event trace will not be available."
 #define AIE_TRACE_BUF_ALLOC_FAIL              "Allocation of buffer for AIE trace failed. AIE trace will not be available."
 #define AIE_TS2MM_WARN_MSG_BUF_FULL           "AIE Trace Buffer is full. Device trace could be incomplete."
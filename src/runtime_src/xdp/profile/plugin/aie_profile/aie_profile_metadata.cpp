@@ -26,6 +26,8 @@
 #include "core/common/device.h"
 #include "core/common/message.h"
 #include "xdp/profile/database/database.h"
+#include "xdp/profile/database/static_info/aie_config_cache.h"
+#include "xdp/profile/database/static_info/device_info.h"
 #include "xdp/profile/plugin/vp_base/vp_base_plugin.h"
 
 namespace xdp {
@@ -70,16 +72,33 @@ namespace xdp {
     graphMetricsConfig.push_back(xrt_core::config::get_aie_profile_settings_graph_based_interface_tile_metrics());
     graphMetricsConfig.push_back(xrt_core::config::get_aie_profile_settings_graph_based_memory_tile_metrics());
 
-    // Process all module types
-    for (int module = 0; module < NUM_MODULES; ++module) {
-      auto type = moduleTypes[module];
-      auto metricsSettings = getSettingsVector(metricsConfig[module]);
-      auto graphMetricsSettings = getSettingsVector(graphMetricsConfig[module]);
-
-      if (type == module_type::shim)
-        getConfigMetricsForInterfaceTiles(module, metricsSettings, graphMetricsSettings);
-      else
-        getConfigMetricsForTiles(module, metricsSettings, graphMetricsSettings, type);
+    // Resolving tiles is costly for large designs, reuse the
+    // configuration of an earlier run with same xclbin and settings
+    auto settings = metricsConfig;
+    settings.insert(settings.end(), graphMetricsConfig.begin(), graphMetricsConfig.end());
+    auto deviceInfo = (db->getStaticInfo()).getDeviceInfo(deviceID);
+    aie::ConfigCache cache("aie_profile",
+      deviceInfo ? deviceInfo->currentXclbinUUID() : xrt_core::uuid(), std::move(settings));
+
+    aie::tile_config cached;
+    if (cache.read(cached) && (cached.metrics.size() == NUM_MODULES) && (cached.channels.size() == 2)) {
+      configMetrics = std::move(cached.metrics);
+      configChannel0 = std::move(cached.channels[0]);
+      configChannel1 = std::move(cached.channels[1]);
+    }
+    else {
+      // Process all module types
+      for (int module = 0; module < NUM_MODULES; ++module) {
+        auto type = moduleTypes[module];
+        auto metricsSettings = getSettingsVector(metricsConfig[module]);
+        auto graphMetricsSettings = getSettingsVector(graphMetricsConfig[module]);
+
+        if (type == module_type::shim)
+          getConfigMetricsForInterfaceTiles(module, metricsSettings, graphMetricsSettings);
+        else
+          getConfigMetricsForTiles(module, metricsSettings, graphMetricsSettings, type);
+      }
+      cache.write({configMetrics, {configChannel0, configChannel1}});
     }
 
     xrt_core::message::send(severity_level::info,
@@ -26,8 +26,10 @@
 #include <cmath>
 #include <memory>
 #include <cstring>
+#include <limits>
 #include <map>
 
+#include "core/common/config_reader.h"
 #include "core/common/message.h"
 #include "core/common/time.h"
 #include "core/edge/user/shim.h"
@@ -577,8 +579,18 @@ namespace xdp {
     uint32_t prevRow = 0;
     uint64_t timerValue = 0;
 
+    // All counters of one poll share a timestamp in milliseconds
+    double timestamp = xrt_core::time_ns() / 1.0e6;
+
+    static const bool changedOnly =
+      xrt_core::config::get_aie_profile_settings_changed_counters_only();
+
     // Iterate over all AIE Counters & Timers
     auto numCounters = db->getStaticInfo().getNumAIECounter(index);
+    auto& lastValues = lastCounterValues[index];
+    if (changedOnly && lastValues.size() != numCounters)
+      lastValues.assign(numCounters, std::numeric_limits<uint64_t>::max());
+
     for (uint64_t c=0; c < numCounters; c++) {
       auto aie = db->getStaticInfo().getAIECounter(index, c);
       if (!aie)
@@ -619,8 +631,11 @@ namespace xdp {
       values.push_back(timerValue);
       values.push_back(aie->payload);
 
-      // Get timestamp in milliseconds
-      double timestamp = xrt_core::time_ns() / 1.0e6;
+      if (changedOnly) {
+        if (lastValues[c] == counterValue)
+          continue;
+        lastValues[c] = counterValue;
+      }
       db->getDynamicInfo().addAIESample(index, timestamp, values);
     }
   }
@@ -18,6 +18,8 @@
 #define AIE_PROFILE_H
 
 #include <cstdint>
+#include <map>
+#include <vector>
 
 #include "core/edge/common/aie_parser.h"
 #include "xdp/profile/plugin/aie_profile/aie_profile_impl.h"
@@ -84,6 +86,10 @@ namespace xdp {
       std::vector<std::shared_ptr<xaiefal::XAiePerfCounter>> perfCounters;
       std::vector<std::shared_ptr<xaiefal::XAieStreamPortSelect>> streamPorts;
 
+      // Last stored value of each counter per device, used to skip
+      // unchanged samples
+      std::map<uint32_t, std::vector<uint64_t>> lastCounterValues;
+
   };
 
 }   
@@ -28,6 +28,8 @@
 #include "core/common/message.h"
 
 #include "xdp/profile/database/database.h"
+#include "xdp/profile/database/static_info/aie_config_cache.h"
+#include "xdp/profile/database/static_info/device_info.h"
 #include "xdp/profile/device/tracedefs.h"
 #include "xdp/profile/plugin/vp_base/utility.h"
 #include "xdp/profile/plugin/vp_base/vp_base_plugin.h"
@@ -118,10 +120,31 @@ namespace xdp {
         && shimTileMetricsSettings.empty() && shimGraphMetricsSettings.empty()) {
       isValidMetrics = false;
     } else {
-      // Use DMA type here to include both core-active tiles and DMA-only tiles
-      getConfigMetricsForTiles(aieTileMetricsSettings, aieGraphMetricsSettings, module_type::dma);
-      getConfigMetricsForTiles(memTileMetricsSettings, memGraphMetricsSettings, module_type::mem_tile);
-      getConfigMetricsForInterfaceTiles(shimTileMetricsSettings, shimGraphMetricsSettings);
+      // Resolving tiles is costly for large designs, reuse the
+      // configuration of an earlier run with same xclbin and settings
+      auto deviceInfo = (VPDatabase::Instance()->getStaticInfo()).getDeviceInfo(deviceID);
+      aie::ConfigCache cache("aie_trace",
+        deviceInfo ? deviceInfo->currentXclbinUUID() : xrt_core::uuid(),
+        {xrt_core::config::get_aie_trace_settings_tile_based_aie_tile_metrics(),
+         xrt_core::config::get_aie_trace_settings_graph_based_aie_tile_metrics(),
+         xrt_core::config::get_aie_trace_settings_tile_based_memory_tile_metrics(),
+         xrt_core::config::get_aie_trace_settings_graph_based_memory_tile_metrics(),
+         xrt_core::config::get_aie_trace_settings_tile_based_interface_tile_metrics(),
+         xrt_core::config::get_aie_trace_settings_graph_based_interface_tile_metrics()});
+
+      aie::tile_config cached;
+      if (cache.read(cached) && (cached.metrics.size() == 1) && (cached.channels.size() == 2)) {
+        configMetrics = cached.metrics[0];
+        configChannel0 = cached.channels[0];
+        configChannel1 = cached.channels[1];
+      }
+      else {
+        // Use DMA type here to include both core-active tiles and DMA-only tiles
+        getConfigMetricsForTiles(aieTileMetricsSettings, aieGraphMetricsSettings, module_type::dma);
+        getConfigMetricsForTiles(memTileMetricsSettings, memGraphMetricsSettings, module_type::mem_tile);
+        getConfigMetricsForInterfaceTiles(shimTileMetricsSettings, shimGraphMetricsSettings);
+        cache.write({{configMetrics}, {configChannel0, configChannel1}});
+      }
       setTraceStartControl(compilerOptions.graph_iterator_event);
     }
   }
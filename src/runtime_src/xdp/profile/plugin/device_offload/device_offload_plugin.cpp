@@ -429,6 +429,7 @@ namespace xdp {
       return;
     if (device_trace) {
       db->getDynamicInfo().setPLTraceBufferFull(deviceId, offloader->trace_buffer_full());
+      db->getDynamicInfo().setPLTraceDroppedPackets(deviceId, offloader->dropped_packets());
     }
   }
 
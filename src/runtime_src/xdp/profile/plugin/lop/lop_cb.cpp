@@ -22,10 +22,49 @@
 #include "xdp/profile/database/events/opencl_host_events.h"
 #include "xrt/util/time.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 namespace xdp {
 
   static LowOverheadProfilingPlugin lopPluginInstance ;
 
+  // OpenCL API calls start and end on the same thread, so the state
+  // needed to record them is kept per thread rather than in the
+  // database, which would take a shared lock per call.  Function names
+  // are string literals and are looked up by address.
+  struct LOPThreadState
+  {
+    VPDatabase* db = nullptr ;
+    std::vector<std::pair<uint64_t, uint64_t>> starts ; // function id, event id
+    std::unordered_map<const char*, uint64_t> names ;
+    std::unordered_set<long long> queues ;
+  } ;
+
+  static LOPThreadState& getThreadState(VPDatabase* db)
+  {
+    thread_local LOPThreadState state ;
+    if (state.db != db) {
+      state = LOPThreadState() ;
+      state.db = db ;
+    }
+    return state ;
+  }
+
+  static uint64_t getNameId(LOPThreadState& state, const char* functionName)
+  {
+    auto iter = state.names.find(functionName) ;
+    if (iter != state.names.end())
+      return iter->second ;
+
+    auto id = (state.db->getDynamicInfo()).addString(functionName) ;
+    state.names.emplace(functionName, id) ;
+    return id ;
+  }
+
   static void lop_cb_log_function_start(const char* functionName,
                                         long long queueAddress,
                                         unsigned long long int functionID)
@@ -37,18 +76,19 @@ namespace xdp {
     //  level time functions to get the proper value of time zero.
     double timestamp = xrt_xocl::time_ns() ;
     VPDatabase* db = lopPluginInstance.getDatabase() ;
+    auto& state = getThreadState(db) ;
 
-    if (queueAddress != 0) 
+    if (queueAddress != 0 && state.queues.insert(queueAddress).second)
       (db->getStaticInfo()).addCommandQueueAddress(queueAddress) ;
 
     VTFEvent* event = new OpenCLAPICall(0,
                                         timestamp,
                                         functionID,
-                                        (db->getDynamicInfo()).addString(functionName),
+                                        getNameId(state, functionName),
                                         queueAddress,
                                         true); // is Low Overhead
     (db->getDynamicInfo()).addEvent(event) ;
-    (db->getDynamicInfo()).markStart(functionID, event->getEventId()) ;
+    state.starts.emplace_back(functionID, event->getEventId()) ;
   }
 
   static void lop_cb_log_function_end(const char* functionName,
@@ -60,13 +100,21 @@ namespace xdp {
 
     double timestamp = xrt_xocl::time_ns() ;
     VPDatabase* db = lopPluginInstance.getDatabase() ;
+    auto& state = getThreadState(db) ;
 
-    uint64_t start = (db->getDynamicInfo()).matchingStart(functionID) ;
+    // Calls nest, the matching start is the most recent one
+    uint64_t start = 0 ;
+    auto iter = std::find_if(state.starts.rbegin(), state.starts.rend(),
+                             [functionID](const auto& s) { return s.first == functionID ; }) ;
+    if (iter != state.starts.rend()) {
+      start = iter->second ;
+      state.starts.erase(std::next(iter).base()) ;
+    }
 
     VTFEvent* event = new OpenCLAPICall(start,
                                         timestamp,
                                         functionID,
-                                        (db->getDynamicInfo()).addString(functionName),
+                                        getNameId(state, functionName),
                                         queueAddress,
                                         true) ; // is Low Overhead
     (db->getDynamicInfo()).addEvent(event) ;
@@ -21,9 +21,12 @@
 
 #include <chrono>
 #include <fstream>
+#include <map>
 #include <regex>
+#include <sstream>
 
 #include "core/common/api/bo_int.h"
+#include "core/common/config_reader.h"
 #include "core/common/device.h"
 #include "core/common/message.h"
 
@@ -63,6 +66,19 @@ namespace xdp {
   {
     xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT", 
               "Created ML Timeline Plugin for Client Device.");
+
+    std::stringstream ids(xrt_core::config::get_ml_timeline_record_ids());
+    std::string id;
+    while (std::getline(ids, id, ',')) {
+      try {
+        mRecordIds.insert(static_cast<uint32_t>(std::stoul(id, nullptr, 0)));
+      }
+      catch (const std::exception&) {
+        xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",
+                  "Ignoring invalid ML Timeline record ID " + id);
+      }
+    }
+    mSampleInterval = std::max(1u, xrt_core::config::get_ml_timeline_sample_interval());
   }
 
   void MLTimelineClientDevImpl::updateDevice(void* /*hwCtxImpl*/)
@@ -109,12 +125,11 @@ namespace xdp {
 
     boost::property_tree::ptree ptSchema;
     ptSchema.put("major", "1");
-    ptSchema.put("minor", "0");
+    ptSchema.put("minor", "1");
     ptSchema.put("patch", "0");
     ptHeader.add_child("schema_version", ptSchema);
     ptHeader.put("device", "Client");
     ptHeader.put("clock_freq_MHz", 1000);
-    ptTop.add_child("header", ptHeader);
 
     // Record Timer TS in JSON
     // Assuming correct Stub has been called and Write Buffer contains valid data
@@ -128,24 +143,47 @@ namespace xdp {
         << std::hex << mBufSz << std::dec << std::endl;
     xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT", msg.str());
 
+    // A buffer filled up to the last entry may have dropped records,
+    // which the device does not count
+    uint32_t numRecords = numEntries;
+    uint32_t numFiltered = 0;
+    std::map<uint32_t, uint32_t> idCount;
     if (numEntries <= max_count) {
       for (uint32_t i = 0 ; i < numEntries; i++) {
-        boost::property_tree::ptree ptIdTS;
-        ptIdTS.put("id", *ptr);
+        uint32_t recordId = *ptr;
         ptr++;
         if (0 == *ptr) {
           // Zero value for Timestamp in cycles indicates end of recorded data
           std::string msgEntries = " Got " + std::to_string(i) + " records in buffer";
           xrt_core::message::send(xrt_core::message::severity_level::debug, "XRT", msgEntries);
+          numRecords = i;
           break;
         }
-        ptIdTS.put("cycle", *ptr);
+        uint32_t cycle = *ptr;
         ptr++;
 
+        if ((!mRecordIds.empty() && !mRecordIds.count(recordId))
+            || (idCount[recordId]++ % mSampleInterval)) {
+          numFiltered++;
+          continue;
+        }
+
+        boost::property_tree::ptree ptIdTS;
+        ptIdTS.put("id", recordId);
+        ptIdTS.put("cycle", cycle);
         ptRecordTimerTS.push_back(std::make_pair("", ptIdTS));
       }
     }    
 
+    ptHeader.put("records", numRecords);
+    ptHeader.put("records_filtered", numFiltered);
+    ptHeader.put("buffer_full", (numRecords == max_count) ? "true" : "false");
+    ptTop.add_child("header", ptHeader);
+    if (numRecords == max_count)
+      xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",
+                "ML Timeline buffer is full, later records were dropped. Increase ml_timeline_buffer_size "
+                "or reduce the recorded layers.");
+
     if (ptRecordTimerTS.empty()) {
       boost::property_tree::ptree ptEmpty;
       ptRecordTimerTS.push_back(std::make_pair("", ptEmpty));
@@ -20,12 +20,21 @@
 #include "xdp/config.h"
 #include "xdp/profile/plugin/ml_timeline/ml_timeline_impl.h"
 
+#include <cstdint>
+#include <set>
+
 namespace xdp {
 
   class ResultBOContainer;
   class MLTimelineClientDevImpl : public MLTimelineImpl
   {
     ResultBOContainer* mResultBOHolder;
+
+    // Record filter from xrt.ini, see ml_timeline_record_ids and
+    // ml_timeline_sample_interval
+    std::set<uint32_t> mRecordIds;
+    uint32_t mSampleInterval = 1;
+
     public :
       MLTimelineClientDevImpl(VPDatabase* dB);
 
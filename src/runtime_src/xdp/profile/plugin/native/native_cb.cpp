@@ -95,6 +95,20 @@ void native_function_end(const char* functionName,
   db->getDynamicInfo().addUnsortedEvent(event);
 }
 
+// Calls not sampled for the trace only contribute to the API call
+// statistics of the summary.  No events are created for them.
+extern "C"
+void native_function_stat(const char* functionName,
+                          unsigned long long int start,
+                          unsigned long long int end)
+{
+  if (!xdp::VPDatabase::alive() || !xdp::NativeProfilingPlugin::alive())
+    return;
+
+  xdp::VPDatabase* db = xdp::nativePluginInstance.getDatabase();
+  db->getStats().logFunctionCall(functionName, static_cast<uint64_t>(end - start));
+}
+
 // Callbacks for sync functions will create two separate events to be displayed
 // on the visualization.  One that is put on the API row to show that
 // xrt::sync was called, and one on the data transfer rows to show when
@@ -20,6 +20,7 @@
 #include "xdp/profile/plugin/native/native_plugin.h"
 #include "xdp/profile/writer/native/native_writer.h"
 #include "xdp/profile/plugin/vp_base/info.h"
+#include "core/common/config_reader.h"
 
 namespace xdp {
 
@@ -36,6 +37,11 @@ namespace xdp {
     writers.push_back(writer) ;
 
     (db->getStaticInfo()).addOpenedFile(writer->getcurrentFileName(), "VP_TRACE") ;
+
+    // Native events are moved out of the database when written, so
+    // continuous writing also bounds the host memory used by tracing
+    if (xrt_core::config::get_continuous_trace())
+      XDPPlugin::startWriteThread(XDPPlugin::get_trace_file_dump_int_s(), "VP_TRACE");
   }
 
   NativeProfilingPlugin::~NativeProfilingPlugin()
@@ -47,9 +53,7 @@ namespace xdp {
 
       // We were destroyed before the database, so write the writers
       //  and unregister ourselves from the database
-      for (auto w : writers) {
-        w->write(false) ;
-      }
+      XDPPlugin::endWrite() ;
       db->unregisterPlugin(this) ;
     }
     NativeProfilingPlugin::live = false;
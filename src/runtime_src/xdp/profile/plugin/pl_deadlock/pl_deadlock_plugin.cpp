@@ -17,12 +17,14 @@
 
 #define XDP_PLUGIN_SOURCE
 
+#include <algorithm>
 #include <array>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <memory>
 
+#include "core/common/config_reader.h"
 #include "core/common/message.h"
 #include "core/common/api/hw_context_int.h"
 #include "core/common/api/ip_int.h"
@@ -50,6 +52,8 @@ namespace xdp {
   PLDeadlockPlugin::PLDeadlockPlugin()
   : XDPPlugin()
   , mFileExists(false)
+  , mMinPollingIntervalMs(std::max(1u, xrt_core::config::get_pl_deadlock_min_poll_ms()))
+  , mMaxPollingIntervalMs(std::max(mMinPollingIntervalMs, xrt_core::config::get_pl_deadlock_max_poll_ms()))
   {
     db->registerPlugin(this);
   }
@@ -65,8 +69,12 @@ namespace xdp {
   void PLDeadlockPlugin::writeAll(bool /*openNewFiles*/)
   {
     // Ask all threads to end
-    for (auto& p : mThreadCtrlMap)
-      p.second = false;
+    {
+      std::lock_guard<std::mutex> lk(mPollLock);
+      for (auto& p : mThreadCtrlMap)
+        p.second = false;
+    }
+    mPollCond.notify_all();
 
     for (auto& t : mThreadMap)
       t.second.join();
@@ -90,6 +98,10 @@ namespace xdp {
 
     xrt::hw_context hwContext = xrt_core::hw_context_int::create_hw_context_from_implementation(hwCtxImpl);
 
+    // A deadlock is permanent once it occurs, so a detection latency of
+    // the max interval is acceptable while polling costs close to nothing
+    // over a long run.  Backoff restarts when the device is reloaded.
+    uint32_t interval = mMinPollingIntervalMs;
     while (should_continue) {
       if (deviceIntf->getDeadlockStatus()) {
         std::string deviceName = (db->getStaticInfo()).getDeviceName(deviceId);
@@ -148,7 +160,11 @@ namespace xdp {
         }
         return;
       }
-      std::this_thread::sleep_for(std::chrono::milliseconds(mPollingIntervalMs));
+      {
+        std::unique_lock<std::mutex> lk(mPollLock);
+        mPollCond.wait_for(lk, std::chrono::milliseconds(interval), [&should_continue] { return !should_continue; });
+      }
+      interval = std::min(interval * 2, mMaxPollingIntervalMs);
     }
   }
 
@@ -174,7 +190,7 @@ namespace xdp {
 
     uint64_t deviceId = db->addDevice(util::getDebugIpLayoutPath(handle));
 
-    mThreadCtrlMap[deviceId] = false;
+    stopPolling(deviceId);
     auto it = mThreadMap.find(deviceId);
     if (it != mThreadMap.end()) {
       it->second.join();
@@ -183,6 +199,15 @@ namespace xdp {
     }
   }
 
+  void PLDeadlockPlugin::stopPolling(uint64_t deviceId)
+  {
+    {
+      std::lock_guard<std::mutex> lk(mPollLock);
+      mThreadCtrlMap[deviceId] = false;
+    }
+    mPollCond.notify_all();
+  }
+
   void PLDeadlockPlugin::updateDevice(void* hwCtxImpl)
   {
     xrt::hw_context hwContext = xrt_core::hw_context_int::create_hw_context_from_implementation(hwCtxImpl);
@@ -19,7 +19,9 @@
 #define PL_DEADLOCK_PLUGIN_DOT_H
 
 #include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "xdp/profile/plugin/vp_base/vp_base_plugin.h"
@@ -36,7 +38,8 @@ namespace xdp {
   
   private:
     bool mFileExists;
-    uint32_t mPollingIntervalMs = 100;
+    uint32_t mMinPollingIntervalMs;
+    uint32_t mMaxPollingIntervalMs;
 
     std::unique_ptr<IpMetadata> mIpMetadata;
 
@@ -46,6 +49,12 @@ namespace xdp {
 //    std::map<void*,std::atomic<bool>> mThreadCtrlMap;
     std::mutex mWriteLock;
 
+    // Wakes polling threads early when they are asked to stop
+    std::mutex mPollLock;
+    std::condition_variable mPollCond;
+
+    void stopPolling(uint64_t deviceId);
+
   public:
     PLDeadlockPlugin();
     ~PLDeadlockPlugin();
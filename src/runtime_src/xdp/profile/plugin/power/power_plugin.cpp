@@ -17,7 +17,10 @@
 
 #define XDP_PLUGIN_SOURCE
 
+#include <chrono>
+#include <iomanip>
 #include <map>
+#include <sstream>
 #include <string>
 
 #include "core/common/config_reader.h"
@@ -82,6 +85,9 @@ namespace xdp {
         continue;
       }  
     }
+    batchedRead.assign(xrtDevices.size(), true);
+    energyJoules.assign(xrtDevices.size(), 0.0);
+
     // Start the power profiling thread
     pollingThread = std::thread(&PowerProfilingPlugin::pollPower, this) ;
   }
@@ -92,6 +98,15 @@ namespace xdp {
     keepPolling = false ;
     pollingThread.join() ;
 
+    double seconds = (lastTimestamp - firstTimestamp) / 1.0e3 ;
+    for (uint64_t index = 0 ; index < energyJoules.size() && seconds > 0 ; ++index) {
+      std::stringstream msg ;
+      msg << "Power profile of device " << index << ": "
+          << std::fixed << std::setprecision(3) << energyJoules[index] << " J in "
+          << seconds << " s, average " << (energyJoules[index] / seconds) << " W" ;
+      xrt_core::message::send(xrt_core::message::severity_level::info, "XRT", msg.str()) ;
+    }
+
     if (VPDatabase::alive())
     {
       for (auto w : writers)
@@ -103,87 +118,130 @@ namespace xdp {
     }
   }
 
+  std::vector<uint64_t> PowerProfilingPlugin::readSensors(uint64_t index)
+  {
+    std::vector<uint64_t> values ;
+    std::shared_ptr<xrt_core::device> coreDevice = xrtDevices[index]->get_handle();
+
+    if (batchedRead[index]) {
+      try {
+        values = xrt_core::device_query<xrt_core::query::power_sensors>(coreDevice);
+        return values;
+      }
+      catch (const std::exception&) {
+        batchedRead[index] = false;
+        values.clear();
+      }
+    }
+
+    try{
+      uint64_t data = 0;
+      data = xrt_core::device_query<xrt_core::query::v12v_aux_milliamps>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::v12v_aux_millivolts>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::v12v_pex_milliamps>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::v12v_pex_millivolts>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::int_vcc_milliamps>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::int_vcc_millivolts>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::v3v3_pex_milliamps>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::v3v3_pex_millivolts>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::cage_temp_0>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::cage_temp_1>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::cage_temp_2>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::cage_temp_3>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::dimm_temp_0>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::dimm_temp_1>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::dimm_temp_2>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::dimm_temp_3>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::fan_trigger_critical_temp>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::temp_fpga>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::hbm_temp>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::temp_card_top_front>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::temp_card_top_rear>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::temp_card_bottom_front>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::int_vcc_temp>(coreDevice);
+      values.push_back(data);
+      data = xrt_core::device_query<xrt_core::query::fan_speed_rpm>(coreDevice); 
+      values.push_back(data);
+    }
+    catch (const xrt_core::query::no_such_key&) {
+      //query is not implemented
+    }
+    catch (const std::exception&) {
+      // error retrieving information
+      std::string msg = "Error while retrieving data from power files. Using default value.";
+      xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", msg);
+    }
+    return values;
+  }
+
+  // Board input power in watts from 12V AUX, 12V PEX and 3V3 PEX
+  // current (mA) and voltage (mV) pairs, see power_sensors
+  static double boardPower(const std::vector<uint64_t>& values)
+  {
+    double watts = 0 ;
+    for (size_t rail : {0, 2, 6}) {
+      if (rail + 1 < values.size())
+        watts += static_cast<double>(values[rail]) * values[rail + 1] / 1.0e6 ;
+    }
+    return watts ;
+  }
+
   void PowerProfilingPlugin::pollPower()
   {
+    // Samples are taken on a fixed schedule so that the sampling rate
+    // does not drift with the time spent reading sensors
+    auto interval = std::chrono::milliseconds(pollingInterval) ;
+    auto next = std::chrono::steady_clock::now() ;
+    std::vector<double> lastPower(xrtDevices.size(), 0.0) ;
+
     while(keepPolling)
     {
       // Get timestamp in milliseconds
       double timestamp = xrt_core::time_ns() / 1.0e6 ;
-      uint64_t index = 0 ;
+      if (firstTimestamp == 0)
+        firstTimestamp = timestamp ;
 
-      for(auto& xrtDevice : xrtDevices)
+      for (uint64_t index = 0 ; index < xrtDevices.size() ; ++index)
       {
-        std::vector<uint64_t> values ;
-        std::shared_ptr<xrt_core::device> coreDevice = xrtDevice->get_handle();
-        
-        if (!coreDevice) {
-          ++index;
+        if (!xrtDevices[index]->get_handle())
           continue;
-        }
 
-        try{
-          uint64_t data = 0;
-          data = xrt_core::device_query<xrt_core::query::v12v_aux_milliamps>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::v12v_aux_millivolts>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::v12v_pex_milliamps>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::v12v_pex_millivolts>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::int_vcc_milliamps>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::int_vcc_millivolts>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::v3v3_pex_milliamps>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::v3v3_pex_millivolts>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::cage_temp_0>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::cage_temp_1>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::cage_temp_2>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::cage_temp_3>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::dimm_temp_0>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::dimm_temp_1>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::dimm_temp_2>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::dimm_temp_3>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::fan_trigger_critical_temp>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::temp_fpga>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::hbm_temp>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::temp_card_top_front>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::temp_card_top_rear>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::temp_card_bottom_front>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::int_vcc_temp>(coreDevice);
-          values.push_back(data);
-          data = xrt_core::device_query<xrt_core::query::fan_speed_rpm>(coreDevice); 
-          values.push_back(data);
-        }
-        catch (const xrt_core::query::no_such_key&) {
-          //query is not implemented
-        }
-        catch (const std::exception&) {
-          // error retrieving information
-          std::string msg = "Error while retrieving data from power files. Using default value.";
-          xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT", msg);
-        }
+        auto values = readSensors(index) ;
+
+        // Trapezoidal integration of power over the sample interval
+        auto power = boardPower(values) ;
+        if (lastTimestamp > 0)
+          energyJoules[index] += (power + lastPower[index]) / 2 * (timestamp - lastTimestamp) / 1.0e3 ;
+        lastPower[index] = power ;
+
         (db->getDynamicInfo()).addPowerSample(index, timestamp, values) ;
-        ++index ;
       }
-      std::this_thread::sleep_for(std::chrono::milliseconds(pollingInterval)) ;
+      lastTimestamp = timestamp ;
+
+      next += interval ;
+      std::this_thread::sleep_until(next) ;
     }
   }
 
@@ -35,6 +35,17 @@ namespace xdp {
   private:
     std::vector<std::unique_ptr<xrt::device>> xrtDevices;
 
+    // Per device, false once the batched sensor read is found to be
+    // unsupported and sensors are read one query at a time
+    std::vector<bool> batchedRead;
+
+    // Per device, energy integrated from board input rail power
+    std::vector<double> energyJoules;
+    double firstTimestamp = 0;
+    double lastTimestamp = 0;
+
+    std::vector<uint64_t> readSensors(uint64_t index);
+
     // Power profiling requires its own thread
     bool keepPolling ;
     std::thread pollingThread ;
@@ -115,8 +115,22 @@ namespace xdp {
   {
     is_write_thread_active = true;
 
-    while (writeCondWaitFor(std::chrono::seconds(interval)))
+    // With a host event limit, wake up regularly to dump early once
+    // the buffered host events reach the limit
+    const auto limit = xrt_core::config::get_trace_host_event_limit();
+    const auto period = std::chrono::seconds(interval);
+    const auto step = limit
+      ? std::chrono::milliseconds(host_event_poll_ms)
+      : std::chrono::duration_cast<std::chrono::milliseconds>(period);
+
+    auto deadline = std::chrono::steady_clock::now() + period;
+    while (writeCondWaitFor(step)) {
+      if (std::chrono::steady_clock::now() < deadline &&
+          (limit == 0 || db->getDynamicInfo().numHostEvents() < limit))
+        continue;
       trySafeWrite(type, openNewFiles);
+      deadline = std::chrono::steady_clock::now() + period;
+    }
 
     // Do a final write
     mtx_writer_list.lock();
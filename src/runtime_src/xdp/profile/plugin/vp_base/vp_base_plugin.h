@@ -38,6 +38,7 @@ namespace xdp {
     // Continuous write functionality
     static unsigned int trace_file_dump_int_s;
     static bool trace_int_cached;
+    static constexpr unsigned int host_event_poll_ms = 100;
 
     std::atomic<bool> is_write_thread_active;
     std::thread write_thread;
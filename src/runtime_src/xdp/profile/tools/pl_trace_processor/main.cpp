@@ -14,6 +14,7 @@
  * under the License.
  */
 
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -47,27 +48,30 @@ int main(int argc, char* argv[])
 
   db->getStaticInfo().updateDevice(deviceId, xclbinFile);
 
-  std::vector<uint64_t> traceData;
-
-  uint64_t packet = 0;
-  char* ch = reinterpret_cast<char*>(&packet);
-
-  while(fin.read(ch, 8)) {
-    traceData.push_back(packet);
-  }
+  fin.seekg(0, std::ios::end);
+  std::vector<uint64_t> traceData(static_cast<size_t>(fin.tellg()) / sizeof(uint64_t));
+  fin.seekg(0, std::ios::beg);
+  fin.read(reinterpret_cast<char*>(traceData.data()), traceData.size() * sizeof(uint64_t));
   fin.close();
 
-  // Add all of the events to the database
+  // Add all of the events to the database.  Report the decode rate
+  // so changes to the logger can be measured on real trace files.
   xdp::PLDeviceTraceLogger logger(deviceId);
   uint64_t numBytes = sizeof(uint64_t)*traceData.size();
+  auto start = std::chrono::steady_clock::now();
   logger.processTraceData(traceData.data(), numBytes);
+  auto end = std::chrono::steady_clock::now();
+
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  std::cout << "Processed " << traceData.size() << " packets in " << us << " us";
+  if (us)
+    std::cout << " (" << static_cast<double>(traceData.size()) / us << " Mpackets/s)";
+  std::cout << "\n";
 
   // Create a writer and have it write.
   xdp::DeviceTraceWriter writer("output.csv", deviceId, "1.1", xdp::getCurrentDateTime(), xdp::getXRTVersion(), xdp::getToolVersion());
   writer.write(false);
 
-  fin.close();
-
   return 0;
 }
 
@@ -88,6 +88,7 @@ namespace xdp {
     writeTraceEvents() ;
     fout << std::endl ;
     writeDependencies() ;
+    fout.flush() ;
 
     if (openNewFile) switchFiles() ;
 
@@ -535,6 +535,13 @@ namespace {
            << device->getUniqueDeviceName() << ","
            << (full ? "true" : "false")
            << "\n" ; // Should there be a comma at the end?
+
+      auto dropped = db->getDynamicInfo().getPLTraceDroppedPackets(device->deviceId);
+      if (dropped)
+        fout << "TRACE_BUFFER_DROPPED_PACKETS,"
+             << device->getUniqueDeviceName() << ","
+             << dropped
+             << ",\n" ;
     }
   }
 
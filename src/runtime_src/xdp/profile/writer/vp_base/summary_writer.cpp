@@ -190,56 +190,50 @@ namespace xdp {
   void
   SummaryWriter::writeAPICalls(APIType type)
   {
-    // For each function call, across all of the threads,
-    //  consolidate all the information into what we need
+    // Consolidate the statistics of each API into what we need
     std::map<std::string,
              std::tuple<uint64_t,
                         double,
                         double,
                         double> > rows ;
 
-    std::map<std::pair<std::string, std::thread::id>,
-             std::vector<std::pair<double, double>>> callCount =
-      (db->getStats()).getCallCount() ;
-
-    for (const auto& call : callCount) {
-      auto callAndThread = call.first ;
-      auto APIName = callAndThread.first ;
-
+    auto skipAPI = [this, type](const std::string& APIName) {
       switch (type) {
       case OPENCL:
-        if (OpenCLAPIs.find(APIName) == OpenCLAPIs.end()) continue ;
-        break ;
+        return OpenCLAPIs.find(APIName) == OpenCLAPIs.end() ;
       case NATIVE:
-        if (NativeAPIs.find(APIName) == NativeAPIs.end()) continue ;
-        break ;
+        return NativeAPIs.find(APIName) == NativeAPIs.end() ;
       case HAL:
-        if (HALAPIs.find(APIName) == HALAPIs.end()) continue ;
-        break ;
+        return HALAPIs.find(APIName) == HALAPIs.end() ;
       case ALL: // Intentionally fall through
       default:
-        break ;
+        return false ;
       }
+    } ;
 
-      std::vector<std::pair<double, double>> timesOfCalls = call.second ;
-
+    auto addRow = [&rows](const std::string& APIName) {
       if (rows.find(APIName) == rows.end()) {
         std::tuple<uint64_t, double, double, double> blank =
           std::make_tuple<uint64_t, double, double, double>(0,0,std::numeric_limits<double>::max(),0) ;
 
         rows[APIName] = blank ;
       }
-
-      for (const auto& executionTime : timesOfCalls) {
-        auto timeTaken = executionTime.second - executionTime.first ;
-
-        ++(std::get<0>(rows[APIName])) ;
-        std::get<1>(rows[APIName]) += timeTaken ;
-        if (timeTaken < std::get<2>(rows[APIName]))
-          std::get<2>(rows[APIName]) = timeTaken ;
-        if (timeTaken > std::get<3>(rows[APIName]))
-          std::get<3>(rows[APIName]) = timeTaken ;
-      }
+    } ;
+
+    // Calls are aggregated by the database as they complete
+    for (const auto& stat : (db->getStats()).getCallStats()) {
+      const auto& APIName = stat.first ;
+      const auto& times = stat.second ;
+      if (skipAPI(APIName) || times.numExecutions == 0) continue ;
+
+      addRow(APIName) ;
+      auto& row = rows[APIName] ;
+      std::get<0>(row) += times.numExecutions ;
+      std::get<1>(row) += static_cast<double>(times.totalTime) ;
+      if (static_cast<double>(times.minTime) < std::get<2>(row))
+        std::get<2>(row) = static_cast<double>(times.minTime) ;
+      if (static_cast<double>(times.maxTime) > std::get<3>(row))
+        std::get<3>(row) = static_cast<double>(times.maxTime) ;
     }
 
     for (const auto& row : rows) {
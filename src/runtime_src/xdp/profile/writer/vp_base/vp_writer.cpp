@@ -43,8 +43,12 @@ namespace xdp {
 #else
     separator('/'),
 #endif
-    fileNum(1), db(inst)
+    fileNum(1), db(inst), streamBuffer(new char[streamBufferSize])
   {
+    // Must be set before the file is opened.  The buffer is kept by
+    // the stream when switching files.
+    fout.rdbuf()->pubsetbuf(streamBuffer.get(), streamBufferSize) ;
+
 #ifdef _WIN32
     // On Windows, we are currently always opening the file in the
     // current directory and do not yet support the user specified
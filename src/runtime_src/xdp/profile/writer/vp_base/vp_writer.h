@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <fstream>
+#include <memory>
 #include <string>
 
 #include "xdp/config.h"
@@ -60,6 +61,14 @@ namespace xdp {
     // Connection to the database where all the information is stored
     VPDatabase* db ;
 
+  private:
+    // Trace files are millions of short lines, give the stream a
+    // buffer much larger than the default so it writes in big blocks.
+    // Declared before the stream, which flushes into it on destruction.
+    static constexpr std::size_t streamBufferSize = 1024 * 1024 ;
+    std::unique_ptr<char[]> streamBuffer ;
+
+  protected:
     // The output stream (which could go to many different files)
     std::ofstream fout ;
 
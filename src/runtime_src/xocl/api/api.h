@@ -48,6 +48,17 @@ clEnqueueWriteBuffer(cl_command_queue   command_queue,
                      const cl_event *   event_wait_list ,
                      cl_event *         event);
 
+cl_int
+clEnqueueFillBuffer(cl_command_queue command_queue,
+                    cl_mem           buffer,
+                    const void*      pattern,
+                    size_t           pattern_size,
+                    size_t           offset,
+                    size_t           size,
+                    cl_uint          num_events_in_wait_list,
+                    const cl_event*  event_wait_list,
+                    cl_event*        event);
+
 cl_int
 clEnqueueReadBuffer(cl_command_queue   command_queue,
                     cl_mem             buffer,
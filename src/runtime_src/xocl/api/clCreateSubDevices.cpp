@@ -22,6 +22,11 @@
 #include "plugin/xdp/profile_v2.h"
 #include <CL/cl.h>
 
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
 #ifdef _WIN32
 # pragma warning ( disable : 4267 )
 #endif
@@ -29,11 +34,69 @@
 namespace xocl {
 
 
-// TODO: partition cus properly
-static size_t
-number_of_clusters(const device::compute_unit_range& cu_range)
+using cu_partition_type = std::vector<device::compute_unit_vector_type>;
+
+// Partition the CUs of a device per the partition property.
+//
+// CL_DEVICE_PARTITION_EQUALLY creates as many sub devices with the
+// requested number of CUs as possible, CL_DEVICE_PARTITION_BY_COUNTS
+// creates a sub device per requested count, and
+// CL_DEVICE_PARTITION_BY_CONNECTIVITY creates a sub device per group
+// of CUs connected to the same memory banks.  CUs are assigned in CU
+// index order.
+static cu_partition_type
+partition(const device::compute_unit_range& cu_range,
+          const cl_device_partition_property* properties)
 {
-  return cu_range.size();
+  cu_partition_type partitions;
+  auto cus = cu_range.begin();
+  auto cus_left = [&cus,&cu_range] {
+    return static_cast<size_t>(std::distance(cus,cu_range.end()));
+  };
+
+  switch (properties[0]) {
+  case CL_DEVICE_PARTITION_EQUALLY: {
+    auto n = static_cast<size_t>(properties[1]);
+    if (n == 0)
+      throw error(CL_INVALID_VALUE,"Number of CUs per sub device must be non zero");
+    while (cus_left() >= n) {
+      partitions.emplace_back(cus,cus + n);
+      cus += n;
+    }
+    break;
+  }
+  case CL_DEVICE_PARTITION_BY_COUNTS:
+    for (auto count = properties + 1; *count != CL_DEVICE_PARTITION_BY_COUNTS_LIST_END; ++count) {
+      if (*count < 0)
+        throw error(CL_INVALID_DEVICE_PARTITION_COUNT,"Negative CU count");
+      auto n = static_cast<size_t>(*count);
+      if (n > cus_left())
+        throw error(CL_INVALID_DEVICE_PARTITION_COUNT,"Total CU count exceeds CUs of device");
+      if (n == 0)
+        continue;
+      partitions.emplace_back(cus,cus + n);
+      cus += n;
+    }
+    break;
+  case CL_DEVICE_PARTITION_BY_CONNECTIVITY: {
+    // Group CUs by the set of memory banks their arguments connect to
+    std::map<std::string, size_t> group;
+    for (const auto& cu : cu_range) {
+      auto banks = cu->get_memidx_union().to_string();
+      auto itr = group.find(banks);
+      if (itr == group.end()) {
+        itr = group.emplace(banks,partitions.size()).first;
+        partitions.emplace_back();
+      }
+      partitions[itr->second].push_back(cu);
+    }
+    break;
+  }
+  default:
+    break;
+  }
+
+  return partitions;
 }
 
 static void
@@ -55,30 +118,26 @@ validOrError(cl_device_id                        in_device,
   if (!properties)
     throw error(CL_INVALID_VALUE,"No device partitioning property provided");
 
-  // Support CL_DEVICE_PARTITION_EQUALLY
-  if (properties[0] == CL_DEVICE_PARTITION_EQUALLY) {
-    if (properties[1] != 1)
-      throw error(CL_INVALID_VALUE,"Only one CU per subdevice is supported");
-  }
-  else if (properties[0] == CL_DEVICE_PARTITION_BY_CONNECTIVITY) {
-  }
-  else {
+  if (properties[0] != CL_DEVICE_PARTITION_EQUALLY
+      && properties[0] != CL_DEVICE_PARTITION_BY_COUNTS
+      && properties[0] != CL_DEVICE_PARTITION_BY_CONNECTIVITY) {
     throw error(CL_INVALID_VALUE,"Invalid partition property, \
-                only CL_DEVICE_PARTITION_EQUALLY and CL_DEVICE_PARTITION_BY_CONNECTIVITY supported");
+                only CL_DEVICE_PARTITION_EQUALLY, CL_DEVICE_PARTITION_BY_COUNTS \
+                and CL_DEVICE_PARTITION_BY_CONNECTIVITY supported");
   }
 
   // CL_INVALID_VALUE if out_devices is not NULL and num_devices is
   // less than the number of sub-devices created by the partition
   // scheme.
   detail::device::validOrError(num_entries,out_devices);
-  auto clusters = number_of_clusters(xocl(in_device)->get_cu_range());
+  auto clusters = partition(xocl(in_device)->get_cu_range(),properties).size();
   if (out_devices && num_entries && num_entries < clusters)
     throw error(CL_INVALID_VALUE,"Not enough entries in out_devices");
 
   // CL_DEVICE_PARTITION_FAILED if the partition name is supported by
   // the implementation but in_device could not be further
   // partitioned.
-  if (clusters==1)
+  if (clusters<=1)
     throw error(CL_DEVICE_PARTITION_FAILED,"Nothing to partition");
 
   // CL_INVALID_DEVICE_PARTITION_COUNT if the partition name specified
@@ -107,13 +166,11 @@ clCreateSubDevices(cl_device_id                        in_device,
 {
   validOrError(in_device,properties,num_entries,out_devices,num_devices);
 
-  // For experimentation, create a subdevice per CU in in_device
-  size_t count = 0;
-  for (auto cuin : xocl(in_device)->get_cu_range()) {
-    std::vector<decltype(cuin)> cus;
-    cus.emplace_back(std::move(cuin));
-    ++count;
-    if (out_devices) {
+  // Each sub device owns a disjoint set of CUs, so kernels enqueued
+  // to different sub devices are scheduled on disjoint CUs
+  auto partitions = partition(xocl(in_device)->get_cu_range(),properties);
+  if (out_devices) {
+    for (const auto& cus : partitions) {
       auto sd  = std::make_unique<device>(xocl(in_device),cus);
       *out_devices = sd.release();
       ++out_devices;
@@ -121,7 +178,7 @@ clCreateSubDevices(cl_device_id                        in_device,
   }
 
   if (num_devices)
-    *num_devices = count;
+    *num_devices = static_cast<cl_uint>(partitions.size());
 
   return CL_SUCCESS;
 }
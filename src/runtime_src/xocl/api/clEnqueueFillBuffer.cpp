@@ -136,6 +136,26 @@ clEnqueueFillBuffer(cl_command_queue command_queue,
   return CL_SUCCESS;
 }
 
+namespace api {
+
+cl_int
+clEnqueueFillBuffer(cl_command_queue command_queue,
+                    cl_mem           buffer,
+                    const void*      pattern,
+                    size_t           pattern_size,
+                    size_t           offset,
+                    size_t           size,
+                    cl_uint          num_events_in_wait_list,
+                    const cl_event*  event_wait_list,
+                    cl_event*        event)
+{
+  return ::xocl::clEnqueueFillBuffer
+    (command_queue,buffer,pattern,pattern_size,offset,size
+     ,num_events_in_wait_list,event_wait_list,event);
+}
+
+} // api
+
 } // api_impl
 
 cl_int
@@ -477,29 +477,16 @@ struct CallbackArgs {
   std::vector<uint8_t> buf;
 };
 
-void CL_CALLBACK cb_BufferInitialized(cl_event event, cl_int status, void *data)
-{
-  CallbackArgs *args = reinterpret_cast<CallbackArgs*>(data);
-  delete args;
-  if ( XCL::Printf::isPrintfDebugMode() ) {
-    std::cout << "clEnqueueNDRangeKernel - printf buffer init callback\n";
-  }
-}
-
-
+// Hand the returned buffer to the background printer so that the
+// completion path is not delayed by parsing
 void CL_CALLBACK cb_BufferReturned(cl_event event, cl_int status, void *data)
 {
   CallbackArgs *args = reinterpret_cast<CallbackArgs*>(data);
-  cl_kernel kernel = args->kernel.get();
-  XCL::Printf::PrintfManager printfManager;
-  printfManager.enqueueBuffer(kernel, args->buf);
-  delete args;
   if ( XCL::Printf::isPrintfDebugMode() ) {
     std::cout << "clEnqueueNDRangeKernel - printf buffer returned callback\n";
-    printfManager.dbgDump();
   }
-  printfManager.print();
-  printfManager.clear();
+  XCL::Printf::printBufferAsync(args->kernel.get(), std::move(args->buf));
+  delete args;
 
   xocl::api::clReleaseEvent(event);
 }
@@ -526,28 +513,22 @@ createPrintfBuffer(cl_context context, cl_kernel kernel
 // Initialize the device printf buffer to known values. This must execute
 // BEFORE the clEnqueueNDRangeKernel starts so the event is returned so it
 // can be appended to the list of events the enqueue must wait for.
+// The fill replicates the pattern on device where supported, so no host
+// copy of the buffer is staged.
 cl_event enqueueInitializePrintfBuffer(cl_kernel kernel, cl_command_queue queue,cl_mem mem)
 {
+  static const uint8_t pattern = 0xFF;
   cl_event event = nullptr;
   if ( XCL::Printf::kernelHasPrintf(kernel) ) {
-    std::unique_ptr<CallbackArgs> args = std::make_unique<CallbackArgs>();
     auto bufSize = xocl::xocl(mem)->get_size();
-    args->kernel = xocl::xocl(kernel);
-    args->mem = xocl::xocl(mem);
-    args->buf.resize(bufSize);
-    uint8_t *hostBuf = &args->buf[0];
-    memset(hostBuf, 0xFF, bufSize);
-    cl_int err = xocl::api::clEnqueueWriteBuffer
-      (queue, mem, /*blocking_read*/CL_FALSE,
-       /*offset*/0, bufSize, hostBuf,
+    cl_int err = xocl::api::clEnqueueFillBuffer
+      (queue, mem, &pattern, sizeof(pattern),
+       /*offset*/0, bufSize,
        /*num_events_in_wait_list*/0,
        /*event_wait_list*/nullptr,
        /*return event*/&event);
     if ( err != CL_SUCCESS )
       throw xocl::error(err,"enqueueInitializePrintfBuffer");
-    err = xocl::api::clSetEventCallback(event, CL_COMPLETE, cb_BufferInitialized, args.get());
-    if (err == CL_SUCCESS)
-      args.release();
   }
   return event;
 }
@@ -87,57 +87,19 @@ clEnqueueWriteBufferRect(cl_command_queue     command_queue ,
                ,buffer_row_pitch,buffer_slice_pitch,host_row_pitch,host_slice_pitch
                ,ptr,num_events_in_wait_list ,event_wait_list,event);
 
-  size_t buffer_origin_in_bytes = 
-    buffer_origin[2]*buffer_slice_pitch+
-    buffer_origin[1]*buffer_row_pitch+
-    buffer_origin[0];
-  size_t host_origin_in_bytes = 
-    host_origin[2]*host_slice_pitch+
-    host_origin[1]*host_row_pitch+
-    host_origin[0];
-
-  //allocate and aggregate event
-  if (event) {
-
-    // Soft event
-    auto cmd = CL_COMMAND_WRITE_BUFFER_RECT;
-    auto context = xocl(command_queue)->get_context();
-    auto uevent = xocl::create_soft_event(context,cmd,num_events_in_wait_list,event_wait_list);
-
-    // this is a user visible event, user retains a reference
-    xocl::assign(event,uevent.get());
-
-    // queue the event, block until successfully submitted
-    uevent->queue(true/*wait*/);
-  }
-
-  // Now the event is running, this should be hard_event and handle asynchronously
-  auto device = xocl::xocl(command_queue)->get_device();
-  auto xdevice = device->get_xdevice();
-  auto boh = xocl::xocl(buffer)->get_buffer_object_or_error(device);
-  void* host_ptr = xdevice->map(boh);
-  
-  size_t yit,zit;
-  for(zit=0;zit<region[2];zit++){
-    for(yit=0;yit<region[1];yit++){
-      size_t buffer_row_origin_in_bytes =
-        buffer_origin_in_bytes+
-        zit*buffer_slice_pitch+
-        yit*buffer_row_pitch;
-      size_t host_row_origin_in_bytes =
-        host_origin_in_bytes+
-        zit*host_slice_pitch+
-        yit*host_row_pitch;
-      memcpy( &((uint8_t *)(host_ptr))[buffer_row_origin_in_bytes],
-              &((uint8_t *)(ptr))[host_row_origin_in_bytes],
-              region[0]);
-    }
-  }
-  xdevice->unmap(boh);
-
-  if (event)
-    xocl::xocl(*event)->set_status(CL_COMPLETE);
-
+  // Soft event
+  auto context = xocl(command_queue)->get_context();
+  auto uevent = xocl::create_soft_event(context,CL_COMMAND_WRITE_BUFFER_RECT,num_events_in_wait_list,event_wait_list);
+  // queue the event, block until successfully submitted
+  uevent->queue(true/*wait*/);
+  uevent->set_status(CL_RUNNING);
+
+  auto device = xocl(command_queue)->get_device();
+  device->write_buffer_rect(xocl(buffer),buffer_origin,host_origin,region
+                            ,buffer_row_pitch,buffer_slice_pitch,host_row_pitch,host_slice_pitch,ptr);
+
+  uevent->set_status(CL_COMPLETE);
+  xocl::assign(event,uevent.get());
   return CL_SUCCESS;
 }
 
@@ -211,17 +211,15 @@ unmap_svm_buffer(xocl::event* event,xocl::device* device
 }
 
 static void
-migrate_buffer(shared_event_completer sec,xocl::device* device
-               ,cl_mem buffer,cl_mem_migration_flags flags)
+migrate_buffers(shared_event_completer sec,xocl::device* device
+                ,const std::vector<xocl::memory*>& buffers,cl_mem_migration_flags flags)
 {
-  // The time recorded for CL_RUNNING is from first mem object
-  // starts migration.  If multiple buffers are migrated the
-  // recorded CL_COMPLTE time (per shared_event_completer) is
-  // after the last buffer is migrated. This is not accurate,
-  // but is the best supported by OpenCL.
+  // All buffers are migrated by one task so that their DMA transfers
+  // are submitted in one batch.  The shared_event_completer records
+  // CL_COMPLETE when the last task sharing the event is done.
   try {
     sec->set_status(CL_RUNNING);
-    device->migrate_buffer(xocl::xocl(buffer),flags);
+    device->migrate_buffers(buffers,flags);
   }
   catch (const std::exception& ex) {
     handle_device_exception(sec.get(),ex);
@@ -316,6 +314,7 @@ action_ndrange_migrate(cl_event event,cl_kernel kernel)
     auto xdevice = device->get_xdevice();
     auto ec = make_shared_event_completer(ev);
 
+    std::vector<xocl::memory*> migrate;
     for (auto mem : kernel_args) {
       // do not migrate if argument is write only, but trick the code
       // into assuming that the argument is resident
@@ -325,10 +324,12 @@ action_ndrange_migrate(cl_event event,cl_kernel kernel)
       }
 
       // only migrate if not already resident on device
-      if (!mem->is_resident(device)) {
-        xdevice->schedule(migrate_buffer,async_type::write,ec,device,mem,0);
-      }
+      if (!mem->is_resident(device))
+        migrate.push_back(mem);
     }
+
+    if (!migrate.empty())
+      xdevice->schedule(migrate_buffers,async_type::write,ec,device,std::move(migrate),0);
   };
 }
 
@@ -459,19 +460,25 @@ action_migrate_memobjects(size_t num, const cl_mem* memobjs, cl_mem_migration_fl
     auto device = command_queue->get_device();
     auto xdevice = device->get_xdevice();
     auto ec = make_shared_event_completer(ev);
-    for (auto mem : mo) {
-      // do not migrate if argument is CL_MIGRATE_MEM_OBJECT_CONTENT_UNDERFINED
-      // but trick code into assuming that the argument is resident
-      if (flags & CL_MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED) {
+
+    // do not migrate if argument is CL_MIGRATE_MEM_OBJECT_CONTENT_UNDERFINED
+    // but trick code into assuming that the argument is resident
+    if (flags & CL_MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED) {
+      for (auto mem : mo) {
         // at least allocate buffer on device if necessary
         xocl::xocl(mem)->get_buffer_object(device);
         xocl::xocl(mem)->set_resident(device);
-        continue;
       }
-
-      auto at = (flags & CL_MIGRATE_MEM_OBJECT_HOST) ? async_type::read : async_type::write;
-      xdevice->schedule(migrate_buffer,at,ec,device,mem,flags);
+      return;
     }
+
+    std::vector<xocl::memory*> migrate;
+    migrate.reserve(mo.size());
+    for (auto mem : mo)
+      migrate.push_back(xocl::xocl(mem));
+
+    auto at = (flags & CL_MIGRATE_MEM_OBJECT_HOST) ? async_type::read : async_type::write;
+    xdevice->schedule(migrate_buffers,at,ec,device,std::move(migrate),flags);
   };
 }
 
@@ -20,6 +20,11 @@
 #include "rt_printf.h"
 #include "xocl/core/kernel.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #ifdef _WIN32
 # pragma warning( disable : 4996 )
 #endif
@@ -80,5 +85,104 @@ bool isPrintfDebugMode()
   return retval;
 }
 
+/////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Background printer of returned printf buffers.  The thread is
+// started on first use and drains remaining buffers at exit.
+class PrintfDrain
+{
+  struct Entry
+  {
+    BufferPrintf::StringTable table;
+    BufferPrintf::MemBuffer buf;
+  };
+
+  std::mutex m_mutex;
+  std::condition_variable m_work;
+  std::condition_variable m_idle;
+  std::deque<Entry> m_queue;
+  bool m_busy = false;
+  bool m_stop = false;
+  std::thread m_thread;
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (true) {
+      m_work.wait(lk, [this] { return m_stop || !m_queue.empty(); });
+      if (m_queue.empty())
+        return;
+
+      auto entry = std::move(m_queue.front());
+      m_queue.pop_front();
+      m_busy = true;
+      lk.unlock();
+
+      try {
+        BufferPrintf bp(entry.buf, entry.table);
+        if (isPrintfDebugMode())
+          bp.dbgDump(std::cout);
+        bp.print(std::cout);
+        std::cout.flush();
+      }
+      catch (const std::exception& ex) {
+        std::cerr << "printf: " << ex.what() << std::endl;
+      }
+
+      lk.lock();
+      m_busy = false;
+      if (m_queue.empty())
+        m_idle.notify_all();
+    }
+  }
+
+public:
+  static PrintfDrain& instance()
+  {
+    static PrintfDrain drain;
+    return drain;
+  }
+
+  ~PrintfDrain()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_stop = true;
+    }
+    m_work.notify_one();
+    if (m_thread.joinable())
+      m_thread.join();
+  }
+
+  void push(BufferPrintf::StringTable&& table, BufferPrintf::MemBuffer&& buf)
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_thread.joinable())
+      m_thread = std::thread([this] { run(); });
+    m_queue.push_back({std::move(table), std::move(buf)});
+    m_work.notify_one();
+  }
+
+  void wait()
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_idle.wait(lk, [this] { return m_queue.empty() && !m_busy; });
+  }
+};
+
+} // namespace
+
+void printBufferAsync(cl_kernel kernel, std::vector<uint8_t>&& buf)
+{
+  PrintfDrain::instance().push(xocl::xocl(kernel)->get_stringtable(), std::move(buf));
+}
+
+void waitPrintBuffers()
+{
+  PrintfDrain::instance().wait();
+}
+
 } // namespace Printf
 } // namespace XCL
@@ -58,6 +58,14 @@ private:
 bool kernelHasPrintf(cl_kernel kernel);
 bool isPrintfDebugMode();
 
+// Queue a printf buffer returned from device to be parsed and printed
+// by a background thread, off the event completion path.  Buffers are
+// printed in the order they are queued.
+void printBufferAsync(cl_kernel kernel, std::vector<uint8_t>&& buf);
+
+// Block until all queued printf buffers have been printed
+void waitPrintBuffers();
+
 /////////////////////////////////////////////////////////////////////////
 
 } // namespace Printf
@@ -600,6 +600,39 @@ migrate_buffer(memory* buffer,cl_mem_migration_flags flags)
   buffer->set_resident(this);
 }
 
+void
+device::
+migrate_buffers(const std::vector<memory*>& buffers,cl_mem_migration_flags flags)
+{
+  if (buffers.size() == 1) {
+    migrate_buffer(buffers.front(),flags);
+    return;
+  }
+
+  std::vector<buffer_object_handle> bos;
+  bos.reserve(buffers.size());
+  for (auto buffer : buffers) {
+    if (buffer->no_host_memory())
+      throw xocl::error(CL_INVALID_OPERATION,"buffer flags do not allow migrate_buffer");
+    if (flags & CL_MIGRATE_MEM_OBJECT_HOST)
+      buffer_resident_or_error(buffer,this);
+    bos.push_back(buffer->get_buffer_object(this));
+  }
+
+  if (flags & CL_MIGRATE_MEM_OBJECT_HOST) {
+    m_xdevice->sync_many(bos,xrt_xocl::hal::device::direction::DEVICE2HOST);
+    for (size_t idx = 0; idx < buffers.size(); ++idx)
+      sync_to_ubuf(buffers[idx],0,buffers[idx]->get_size(),m_xdevice,bos[idx]);
+    return;
+  }
+
+  for (size_t idx = 0; idx < buffers.size(); ++idx)
+    sync_to_hbuf(buffers[idx],0,buffers[idx]->get_size(),m_xdevice,bos[idx]);
+  m_xdevice->sync_many(bos,xrt_xocl::hal::device::direction::HOST2DEVICE);
+  for (auto buffer : buffers)
+    buffer->set_resident(this);
+}
+
 void
 device::
 write_buffer(memory* buffer, size_t offset, size_t size, const void* ptr)
@@ -671,6 +704,19 @@ device::
 fill_buffer(memory* buffer, const void* pattern, size_t pattern_size, size_t offset, size_t size)
 {
   auto boh = xocl::xocl(buffer)->get_buffer_object(this);
+
+  // Fill on device when the device content is current or is
+  // overwritten entirely, which avoids a host transfer of the range
+  if (buffer->is_resident(this) || (offset == 0 && size == buffer->get_size())) {
+    try {
+      boh.fill(pattern, pattern_size, size, offset);
+      buffer->set_resident(this);
+      return;
+    }
+    catch (const std::exception&) {
+    }
+  }
+
   char* hbuf = static_cast<char*>(map_buffer(buffer,CL_MAP_WRITE_INVALIDATE_REGION,offset,size,nullptr));
   char* dst = hbuf;
   for (; pattern_size <= size; size-=pattern_size, dst+=pattern_size)
@@ -680,6 +726,115 @@ fill_buffer(memory* buffer, const void* pattern, size_t pattern_size, size_t off
   unmap_buffer(buffer,hbuf);
 }
 
+// Default zero pitches of a rectangular region as per OpenCL
+static void
+rect_pitch(const size_t* region, size_t& row_pitch, size_t& slice_pitch)
+{
+  if (!row_pitch)
+    row_pitch = region[0];
+  if (!slice_pitch)
+    slice_pitch = region[1] * row_pitch;
+}
+
+// Call fn(src_offset, dst_offset) for each row of a rectangular region
+template <typename RowFunction>
+static void
+for_each_rect_row(const size_t* region,
+                  const size_t* src_origin, size_t src_row_pitch, size_t src_slice_pitch,
+                  const size_t* dst_origin, size_t dst_row_pitch, size_t dst_slice_pitch,
+                  RowFunction fn)
+{
+  auto src = src_origin[2] * src_slice_pitch + src_origin[1] * src_row_pitch + src_origin[0];
+  auto dst = dst_origin[2] * dst_slice_pitch + dst_origin[1] * dst_row_pitch + dst_origin[0];
+  for (size_t z = 0; z < region[2]; ++z)
+    for (size_t y = 0; y < region[1]; ++y)
+      fn(src + z * src_slice_pitch + y * src_row_pitch, dst + z * dst_slice_pitch + y * dst_row_pitch);
+}
+
+static void
+sync_rect(device::buffer_object_handle& boh, xclBOSyncDirection dir, const size_t* origin,
+          const size_t* region, size_t row_pitch, size_t slice_pitch)
+{
+  boh.sync_rect(dir, {origin[0], origin[1], origin[2]}, {region[0], region[1], region[2]}, row_pitch, slice_pitch);
+}
+
+void
+device::
+read_buffer_rect(memory* buffer, const size_t* buffer_origin, const size_t* host_origin,
+                 const size_t* region, size_t buffer_row_pitch, size_t buffer_slice_pitch,
+                 size_t host_row_pitch, size_t host_slice_pitch, void* ptr)
+{
+  rect_pitch(region, buffer_row_pitch, buffer_slice_pitch);
+  rect_pitch(region, host_row_pitch, host_slice_pitch);
+
+  auto boh = buffer->get_buffer_object(this);
+  if (buffer->is_resident(this) && !buffer->no_host_memory())
+    sync_rect(boh, XCL_BO_SYNC_BO_FROM_DEVICE, buffer_origin, region, buffer_row_pitch, buffer_slice_pitch);
+
+  auto hbuf = static_cast<const char*>(m_xdevice->map(boh));
+  m_xdevice->unmap(boh);
+  auto dst = static_cast<char*>(ptr);
+  for_each_rect_row
+    (region, buffer_origin, buffer_row_pitch, buffer_slice_pitch, host_origin, host_row_pitch, host_slice_pitch,
+     [&](size_t boff, size_t hoff) {
+       std::memcpy(dst + hoff, hbuf + boff, region[0]);
+       sync_to_ubuf(buffer, boff, region[0], m_xdevice, boh);
+     });
+}
+
+void
+device::
+write_buffer_rect(memory* buffer, const size_t* buffer_origin, const size_t* host_origin,
+                  const size_t* region, size_t buffer_row_pitch, size_t buffer_slice_pitch,
+                  size_t host_row_pitch, size_t host_slice_pitch, const void* ptr)
+{
+  rect_pitch(region, buffer_row_pitch, buffer_slice_pitch);
+  rect_pitch(region, host_row_pitch, host_slice_pitch);
+
+  auto boh = buffer->get_buffer_object(this);
+  auto hbuf = static_cast<char*>(m_xdevice->map(boh));
+  m_xdevice->unmap(boh);
+  auto src = static_cast<const char*>(ptr);
+  for_each_rect_row
+    (region, host_origin, host_row_pitch, host_slice_pitch, buffer_origin, buffer_row_pitch, buffer_slice_pitch,
+     [&](size_t hoff, size_t boff) {
+       std::memcpy(hbuf + boff, src + hoff, region[0]);
+       sync_to_ubuf(buffer, boff, region[0], m_xdevice, boh);
+     });
+
+  if (buffer->is_resident(this) && !buffer->no_host_memory())
+    sync_rect(boh, XCL_BO_SYNC_BO_TO_DEVICE, buffer_origin, region, buffer_row_pitch, buffer_slice_pitch);
+}
+
+void
+device::
+copy_buffer_rect(memory* src_buffer, memory* dst_buffer, const size_t* src_origin, const size_t* dst_origin,
+                 const size_t* region, size_t src_row_pitch, size_t src_slice_pitch,
+                 size_t dst_row_pitch, size_t dst_slice_pitch)
+{
+  rect_pitch(region, src_row_pitch, src_slice_pitch);
+  rect_pitch(region, dst_row_pitch, dst_slice_pitch);
+
+  auto src_boh = src_buffer->get_buffer_object(this);
+  auto dst_boh = dst_buffer->get_buffer_object(this);
+  if (src_buffer->is_resident(this) && !src_buffer->no_host_memory())
+    sync_rect(src_boh, XCL_BO_SYNC_BO_FROM_DEVICE, src_origin, region, src_row_pitch, src_slice_pitch);
+
+  auto src = static_cast<const char*>(m_xdevice->map(src_boh));
+  m_xdevice->unmap(src_boh);
+  auto dst = static_cast<char*>(m_xdevice->map(dst_boh));
+  m_xdevice->unmap(dst_boh);
+  for_each_rect_row
+    (region, src_origin, src_row_pitch, src_slice_pitch, dst_origin, dst_row_pitch, dst_slice_pitch,
+     [&](size_t soff, size_t doff) {
+       std::memcpy(dst + doff, src + soff, region[0]);
+       sync_to_ubuf(dst_buffer, doff, region[0], m_xdevice, dst_boh);
+     });
+
+  if (dst_buffer->is_resident(this) && !dst_buffer->no_host_memory())
+    sync_rect(dst_boh, XCL_BO_SYNC_BO_TO_DEVICE, dst_origin, region, dst_row_pitch, dst_slice_pitch);
+}
+
 static void
 rw_image(device* device,
          memory* image,const size_t* origin,const size_t* region,size_t row_pitch,size_t slice_pitch
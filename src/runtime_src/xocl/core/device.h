@@ -342,6 +342,15 @@ public:
   void
   migrate_buffer(memory* buffer,cl_mem_migration_flags flags);
 
+  /**
+   * Migrate many buffers to this device
+   *
+   * Same as migrate_buffer() for each buffer, but the device side
+   * transfers of all buffers are submitted as one batch.
+   */
+  void
+  migrate_buffers(const std::vector<memory*>& buffers,cl_mem_migration_flags flags);
+
   /**
    * Write data size bytes to buffer at specified offset
    *
@@ -413,6 +422,40 @@ public:
   void
   fill_buffer(memory* buffer, const void* pattern, size_t pattern_size, size_t offset, size_t size);
 
+  /**
+   * Read a rectangular region of buffer into host memory
+   *
+   * The rows of the region are synced from device with one request if
+   * and only if the buffer is currently resident on the device.  Zero
+   * pitches are computed from region as in clEnqueueReadBufferRect.
+   */
+  void
+  read_buffer_rect(memory* buffer, const size_t* buffer_origin, const size_t* host_origin,
+                   const size_t* region, size_t buffer_row_pitch, size_t buffer_slice_pitch,
+                   size_t host_row_pitch, size_t host_slice_pitch, void* ptr);
+
+  /**
+   * Write a rectangular region of host memory into buffer
+   *
+   * The rows of the region are synced to device with one request if
+   * and only if the buffer is currently resident on the device.
+   */
+  void
+  write_buffer_rect(memory* buffer, const size_t* buffer_origin, const size_t* host_origin,
+                    const size_t* region, size_t buffer_row_pitch, size_t buffer_slice_pitch,
+                    size_t host_row_pitch, size_t host_slice_pitch, const void* ptr);
+
+  /**
+   * Copy a rectangular region from src buffer to dst buffer
+   *
+   * The src rows are synced from device if src is resident and the
+   * dst rows are synced to device if dst is resident.
+   */
+  void
+  copy_buffer_rect(memory* src_buffer, memory* dst_buffer, const size_t* src_origin, const size_t* dst_origin,
+                   const size_t* region, size_t src_row_pitch, size_t src_slice_pitch,
+                   size_t dst_row_pitch, size_t dst_slice_pitch);
+
   void
   write_image(memory* image,const size_t* origin,const size_t* region,size_t row_pitch,size_t slice_pitch,const void *ptr);
 
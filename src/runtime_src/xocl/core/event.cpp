@@ -17,14 +17,17 @@
 #include "event.h"
 #include "command_queue.h"
 #include "context.h"
+#include "device.h"
 
 #include "xrt/config.h"
+#include "xrt/util/message.h"
 #include "xrt/util/task.h"
 
 #include "xocl/api/plugin/xdp/profile_v2.h"
 
 #include <iostream>
 #include <cassert>
+#include <vector>
 
 #ifdef _WIN32
 #pragma warning ( disable : 4189 4505 )
@@ -61,7 +64,7 @@ event::
 event(command_queue* cq, context* ctx, cl_command_type cmd)
   : m_context(ctx), m_command_queue(cq), m_command_type(cmd), m_wait_count(1)
 {
-  static unsigned int uid_count = 0;
+  static std::atomic<unsigned int> uid_count {0};
   m_uid = uid_count++;
   debug::add_command_type(this,cmd);
 
@@ -75,9 +78,15 @@ event::
 event(command_queue* cq, context* ctx, cl_command_type cmd, cl_uint num_deps, const cl_event* deps)
   : event(cq,ctx,cmd)
 {
+  // An in-order queue chains every event to the event queued before
+  // it, so a dependency on an earlier event of the same queue is
+  // already implied and need not be tracked
+  bool in_order = cq && !cq->get_properties().test(CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+
   for (auto dep : get_range(deps,deps+num_deps)) {
     XOCL_DEBUG(std::cout,"event(",m_uid,") depends on event(",xocl(dep)->get_uid(),")\n");
-    xocl(dep)->chain(this);
+    if (!in_order || xocl(dep)->get_command_queue() != cq)
+      xocl(dep)->chain(this);
     profile::log_dependency(get_uid(), xocl(dep)->get_uid()) ;
   }
   debug::add_dependencies(this,num_deps,deps);
@@ -110,7 +119,7 @@ set_status(cl_int s)
 
     // Some enqueue operations may need to record CL_RUNNING
     // without knowing that the enqueue operation is invoked
-    // multiple times.  See api/enqueue.cpp migrate_buffer
+    // multiple times.  See api/enqueue.cpp migrate_buffers
     if (s==m_status) {
       assert(s==CL_RUNNING);
       return s;
@@ -118,7 +127,7 @@ set_status(cl_int s)
 
     XOCL_DEBUG(std::cout,"event(",m_uid,") [",to_string(m_status),"->",to_string(s),"]\n");
 
-    std::swap(m_status,s);
+    s = m_status.exchange(s);
     time_set(m_status);
   } // lk
 
@@ -141,8 +150,7 @@ set_status(cl_int s)
     // remove the completed event from queue (submitted queue)
     // before event_scheduler attempts to submit next event.
     queue_remove();   // 1 (order matters)
-    for (auto& c : m_chain) // not a race, since m_chain is blocked by CL_COMPLETE
-      c->submit();
+    submit_chain();
   }
 
   return s;
@@ -184,14 +192,22 @@ queue(bool blocking_submit)
 bool
 event::
 submit()
+{
+  if (!release_dependency()) {
+    XOCL_DEBUG(std::cout,"event(",m_uid,") cannot submit wait_count(",m_wait_count,")\n");
+    return false;
+  }
+
+  submit_ready();
+  return true;
+}
+
+void
+event::
+submit_ready()
 {
   {
     std::lock_guard<std::mutex> lk(m_mutex);
-    if (--m_wait_count) {
-      XOCL_DEBUG(std::cout,"event(",m_uid,") cannot submit wait_count(",m_wait_count,")\n");
-      return false;
-    }
-
     XOCL_UNUSED auto submitted = queue_submit();
     assert(submitted);
 
@@ -207,8 +223,47 @@ submit()
 
   if (is_hard())
     trigger_enqueue_action();
+}
 
-  return true;
+void
+event::
+submit_chain()
+{
+  // not a race, since m_chain is blocked by CL_COMPLETE
+  std::vector<event*> ready;
+  for (auto& c : m_chain)
+    if (c->release_dependency())
+      ready.push_back(c);
+
+  if (ready.empty())
+    return;
+
+  // Events that became ready together are independent of each other,
+  // for example NDRanges and migrations of an out-of-order queue
+  // waiting on the same barrier.  All but the last are submitted by
+  // device task workers so that their enqueue actions start
+  // concurrently, the last is submitted by this thread.  A ready
+  // event is retained by its command queue until it completes.
+  auto last = ready.back();
+  ready.pop_back();
+  for (auto ev : ready) {
+    auto xdevice = ev->is_hard() ? ev->get_command_queue()->get_device()->get_xdevice() : nullptr;
+    if (!xdevice) {
+      ev->submit_ready();
+      continue;
+    }
+
+    xdevice->schedule([](event* rev) {
+      try {
+        rev->submit_ready();
+      }
+      catch (const std::exception& ex) {
+        xrt_xocl::message::send(xrt_xocl::message::severity_level::error,
+                                std::string("event submit failed: ") + ex.what());
+      }
+    },xrt_xocl::device::queue_type::misc,ev);
+  }
+  last->submit_ready();
 }
 
 bool
@@ -258,6 +313,9 @@ event::
 wait() const
 {
   XOCL_DEBUG(std::cout,"xocl::event::wait(",m_uid,")\n");
+  if (m_status<=0)
+    return;
+
   std::unique_lock<std::mutex> lk(m_mutex);
   while (m_status>0)  // (<0 => aborted) (==0 => CL_COMPLETE)
     m_event_complete.wait(lk);
@@ -332,6 +390,10 @@ chain(event* ev)
   // assert(ev is locked because it is being enqueued || called from "ev" event ctor);
   assert(ev->m_status == -1); // ev is being enq'ed or ctored
 
+  // complete is a final state, no need to lock
+  if (m_status == CL_COMPLETE)
+    return;
+
   std::lock_guard<std::mutex> lk(m_mutex);
   if (m_status == CL_COMPLETE)
     return;
@@ -27,6 +27,7 @@
 
 #include "xrt/config.h"
 
+#include <atomic>
 #include <vector>
 #include <functional>
 #include <iostream>
@@ -221,10 +222,10 @@ public:
   set_status(cl_int s);
 
   // likely temporary
+  // Status is changed under m_mutex, but can be read without lock
   cl_int
   get_status() const
   {
-    std::lock_guard<std::mutex> lk(m_mutex);
     return m_status;
   }
 
@@ -447,6 +448,32 @@ private:
   bool
   submit();
 
+  /**
+   * Release one dependency of this event
+   *
+   * @return
+   *   true if this was the last dependency and the event is ready
+   *   to be submitted by submit_ready()
+   */
+  bool
+  release_dependency()
+  {
+    return --m_wait_count == 0;
+  }
+
+  /**
+   * Submit this event after its last dependency was released
+   */
+  void
+  submit_ready();
+
+  /**
+   * Release the dependency of chained events on this completed event
+   * and submit the events that become ready
+   */
+  void
+  submit_chain();
+
   /**
    * Check if this event chains argument event
    */
@@ -544,7 +571,9 @@ private:
   // execution context, probably should create some derived class
   std::unique_ptr<execution_context> m_execution_context;
 
-  cl_int m_status = -1;
+  // Atomic so status can be polled without locking m_mutex.  All
+  // transitions are still made with m_mutex held.
+  std::atomic<cl_int> m_status {-1};
   cl_command_type m_command_type = 0;
   mutable std::mutex m_mutex;
   mutable std::condition_variable m_event_complete;
@@ -558,8 +587,10 @@ private:
   event_vector_type m_chain;
 
   // Number of events this event is waiting on.  This includes
-  // explicit event depedencies and events that chain this
-  unsigned int m_wait_count = 0;
+  // explicit event depedencies and events that chain this.  Atomic
+  // since dependencies are added and released under the locks of
+  // the events depended on, not under the lock of this event.
+  std::atomic<unsigned int> m_wait_count {0};
 };
 
 /**
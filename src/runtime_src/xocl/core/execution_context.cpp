@@ -146,22 +146,38 @@ set_rtinfo_args(xrt::run& run)
       set_rtinfo_arg3(run, arg->get_arginfo_idx(), num_workgroups);
       break;
     }
-    case xocl::kernel::rtinfo_type::gid:
-      set_rtinfo_arg3(run, arg->get_arginfo_idx(), m_cu_global_id);
-      break;
     case xocl::kernel::rtinfo_type::lid: {
       size3 local_id {0,0,0};
       set_rtinfo_arg3(run, arg->get_arginfo_idx(), local_id);
       break;
     }
+    case xocl::kernel::rtinfo_type::gid:
     case xocl::kernel::rtinfo_type::grid:
-      set_rtinfo_arg3(run, arg->get_arginfo_idx(), m_cu_group_id);
+      // per workgroup, see set_rtinfo_workgroup_args
       break;
     case xocl::kernel::rtinfo_type::printf:
       throw std::runtime_error("internal error: rtinfo may not contain printf arg");
       break;
     }
   }
+}
+
+void
+execution_context::
+set_rtinfo_workgroup_args(xrt::run& run)
+{
+  for (auto& arg : m_kernel->get_rtinfo_xargument_range()) {
+    switch (arg->get_rtinfo_type()) {
+    case xocl::kernel::rtinfo_type::gid:
+      set_rtinfo_arg3(run, arg->get_arginfo_idx(), m_cu_global_id);
+      break;
+    case xocl::kernel::rtinfo_type::grid:
+      set_rtinfo_arg3(run, arg->get_arginfo_idx(), m_cu_group_id);
+      break;
+    default:
+      break;
+    }
+  }
 
   // printf
   for (auto& arg : m_kernel->get_printf_xargument_range()) {
@@ -174,7 +190,6 @@ set_rtinfo_args(xrt::run& run)
       break;
     }
   }
-  
 }
 
 execution_context::
@@ -211,6 +226,10 @@ execution_context(device* device
     ++argidx;
   }
 
+  // runtime arguments common to all workgroups, the run objects used
+  // for workgroups are clones of m_run and need not set them again
+  set_rtinfo_args(m_run);
+
   m_num_cus = xrt_core::kernel_int::get_num_cus(m_run);
   m_control = xrt_core::kernel_int::get_control_protocol(m_run);
 
@@ -284,8 +303,8 @@ start()
   auto run = get_free_run();
   
   // Set OCL specific runtime control parameters which are based
-  // current workgroups, etc
-  set_rtinfo_args(run);
+  // current workgroup
+  set_rtinfo_workgroup_args(run);
 
   // After setting rtinfo the work group data can be updated
   // This must be done before chance of calling run_done()
@@ -124,10 +124,15 @@ private:
   void
   set_rtinfo_arg3(xrt::run&, size_t index, const size3&);
 
-  // Set OpenCL specific runtime argument
+  // Set OpenCL specific runtime arguments that are the same for
+  // all workgroups.  Set once on m_run and inherited by its clones.
   void
   set_rtinfo_args(xrt::run&);
 
+  // Set OpenCL specific runtime arguments that change per workgroup
+  void
+  set_rtinfo_workgroup_args(xrt::run&);
+
   // Run object to use for starting work group
   xrt::run
   get_free_run();
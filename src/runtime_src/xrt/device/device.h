@@ -273,6 +273,16 @@ public:
   sync(const buffer_object_handle& bo, size_t sz, size_t offset, direction dir, bool async=true)
   { return m_hal->sync(bo,sz,offset,dir,async); }
 
+  /**
+   * Sync entire content of many buffers to/from device
+   *
+   * Buffers are synced with one driver request where supported, and
+   * the function returns when all buffers are synced.
+   */
+  void
+  sync_many(const std::vector<buffer_object_handle>& bos, direction dir)
+  { m_hal->sync_many(bos,dir); }
+
   /**
    * Copy sz bytes at offset from device to device/host
    *
@@ -764,7 +774,7 @@ public:
     if (!m_setup_done)
       setup();
 
-    task::queue* q = m_hal->getQueue(qt);
+    auto q = m_hal->getQueue(qt);
     return task::createF(*q,f,std::forward<Args>(args)...);
   }
 
@@ -780,7 +790,7 @@ public:
     if (!m_setup_done)
       setup();
 
-    task::queue* q = m_hal->getQueue(qt);
+    auto q = m_hal->getQueue(qt);
     return task::createM(*q,f,c,std::forward<Args>(args)...);
   }
 
@@ -249,6 +249,13 @@ public:
   virtual event
   sync(const buffer_object_handle& bo, size_t sz, size_t offset, direction dir, bool async) = 0;
 
+  virtual void
+  sync_many(const std::vector<buffer_object_handle>& bos, direction dir)
+  {
+    for (const auto& bo : bos)
+      sync(bo, bo.size(), 0, dir, false);
+  }
+
   virtual event
   copy(const buffer_object_handle& dst_bo, const buffer_object_handle& src_bo, size_t sz,
        size_t dst_offset, size_t src_offset) = 0;
@@ -630,7 +637,7 @@ public:
     return operations_result<void>();
   }
 
-  virtual task::queue*
+  virtual task::executor::lane*
   getQueue(hal::queue_type qt) {return nullptr; }
 
   virtual void*
@@ -19,7 +19,9 @@
 #include <cstring> // for std::memcpy
 #include <iostream>
 #include <regex>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #ifdef _WIN32
 # pragma warning( disable : 4267 4996 4244 4245 )
@@ -46,6 +48,26 @@ send_exception_message(const std::string& msg)
   send_exception_message(msg.c_str());
 }
 
+// Comma separated list of unsigned integers from xrt.ini, invalid
+// entries are ignored with a warning
+static std::vector<unsigned int>
+parse_uint_list(const std::string& str, const std::string& what)
+{
+  std::vector<unsigned int> value;
+  std::stringstream ss(str);
+  std::string tok;
+  while (std::getline(ss, tok, ',')) {
+    try {
+      value.push_back(static_cast<unsigned int>(std::stoul(tok)));
+    }
+    catch (const std::exception&) {
+      xrt_core::message::send(xrt_core::message::severity_level::warning, "XRT",
+                              "Ignoring invalid " + what + " '" + tok + "'");
+    }
+  }
+  return value;
+}
+
 }
 
 namespace xrt_xocl { namespace hal2 {
@@ -70,8 +92,7 @@ device::
     }
   }
 
-  for (auto& q : m_queue)
-    q.stop();
+  m_queue.stop();
   for (auto& t : m_workers)
     t.join();
 }
@@ -162,14 +183,26 @@ setup()
   if (!threads) // Guard against drivers who do not set m_devinfo.mDMAThreads
     threads = 2;
 
-  XRT_DEBUG(std::cout,"Creating ",2*threads," DMA worker threads\n");
+  auto priorities = parse_uint_list(xrt_core::config::get_dma_queue_priorities(),"task queue priority");
+  for (size_t idx=0; idx<priorities.size() && idx<m_queue.size(); ++idx)
+    m_queue.set_priority(idx,priorities[idx]);
+
+  // read and write queue workers homed on their queue, plus a single
+  // misc queue worker.  Idle workers steal from the other queues
+  std::vector<qtype> homes;
   for (unsigned int i=0; i<threads; ++i) {
-    // read and write queue workers
-    m_workers.emplace_back(xrt_core::thread(task::worker2,std::ref(m_queue[static_cast<qtype>(hal::queue_type::read)]),"read"));
-    m_workers.emplace_back(xrt_core::thread(task::worker2,std::ref(m_queue[static_cast<qtype>(hal::queue_type::write)]),"write"));
+    homes.push_back(static_cast<qtype>(hal::queue_type::read));
+    homes.push_back(static_cast<qtype>(hal::queue_type::write));
+  }
+  homes.push_back(static_cast<qtype>(hal::queue_type::misc));
+
+  auto cpus = parse_uint_list(xrt_core::config::get_dma_worker_cpus(),"task worker cpu");
+  XRT_DEBUG(std::cout,"Creating ",homes.size()," DMA worker threads\n");
+  for (size_t i=0; i<homes.size(); ++i) {
+    m_workers.emplace_back(xrt_core::thread(&task::executor::worker,&m_queue,homes[i]));
+    if (!cpus.empty())
+      xrt_core::detail::set_cpu_affinity(m_workers.back(),cpus[i % cpus.size()]);
   }
-  // single misc queue worker
-  m_workers.emplace_back(xrt_core::thread(task::worker2,std::ref(m_queue[static_cast<qtype>(hal::queue_type::misc)]),"misc"));
 }
 
 device::ExecBufferObject*
@@ -392,6 +425,14 @@ sync(const buffer_object_handle& boh, size_t sz, size_t offset, direction dir1,
   return event(typed_event<int>(0));
 }
 
+void
+device::
+sync_many(const std::vector<buffer_object_handle>& bos, direction dir1)
+{
+  auto dir = (dir1 == direction::HOST2DEVICE) ? XCL_BO_SYNC_BO_TO_DEVICE : XCL_BO_SYNC_BO_FROM_DEVICE;
+  xrt::bo::sync_many(bos, dir);
+}
+
 event
 device::
 copy(const buffer_object_handle& dst_boh, const buffer_object_handle& src_boh, size_t sz, size_t dst_offset, size_t src_offset)
@@ -57,9 +57,10 @@ class device : public xrt_xocl::hal::device
 {
   // separate queues for read,write, and misc operations
   // primarily done so that independent operations can be serviced
-  // by a worker simultaneously
+  // by a worker simultaneously.  The queues share a pool of workers
+  // that steal work from other queues when their own queue is empty
   using qtype = std::underlying_type<hal::queue_type>::type;
-  std::array<task::queue,static_cast<qtype>(hal::queue_type::max)> m_queue;
+  task::executor m_queue {static_cast<qtype>(hal::queue_type::max)};
   std::vector<std::thread> m_workers;
   svmbomap_type m_svmbomap;
 
@@ -94,10 +95,10 @@ class device : public xrt_xocl::hal::device
   hal2::device_info*
   get_device_info_nolock() const;
 
-  task::queue&
+  task::executor::lane&
   get_queue(hal::queue_type qt)
   {
-    return m_queue[static_cast<qtype>(qt)];
+    return m_queue.get_lane(static_cast<qtype>(qt));
   }
 
   // helper function
@@ -133,7 +134,7 @@ public:
    */
   template <typename F,typename ...Args>
   auto
-  addTaskM(F&& f,hal::queue_type qt,Args&&... args) -> decltype(task::createM(m_queue,f,*this,std::forward<Args>(args)...))
+  addTaskM(F&& f,hal::queue_type qt,Args&&... args) -> decltype(task::createM(get_queue(qt),f,*this,std::forward<Args>(args)...))
   {
     return task::createM(get_queue(qt),f,*this,std::forward<Args>(args)...);
   }
@@ -146,7 +147,7 @@ public:
 #endif
   template <typename F,typename ...Args>
   auto
-  addTaskF(F&& f,hal::queue_type qt,Args&&... args) -> decltype(task::createF(m_queue,f,std::forward<Args>(args)...))
+  addTaskF(F&& f,hal::queue_type qt,Args&&... args) -> decltype(task::createF(get_queue(qt),f,std::forward<Args>(args)...))
   {
     return task::createF(get_queue(qt),f,std::forward<Args>(args)...);
   }
@@ -203,10 +204,10 @@ public:
   virtual void
   release_cu_context(const uuid& uuid,size_t cuidx) override;
 
-  virtual task::queue*
+  virtual task::executor::lane*
   getQueue(hal::queue_type qt) override
   {
-    return &m_queue[static_cast<qtype>(qt)];
+    return &get_queue(qt);
   }
 
   virtual std::string
@@ -281,6 +282,9 @@ public:
   virtual event
   sync(const buffer_object_handle& bo, size_t sz, size_t offset, direction dir, bool async) override;
 
+  virtual void
+  sync_many(const std::vector<buffer_object_handle>& bos, direction dir) override;
+
   virtual event
   copy(const buffer_object_handle& dst_bo, const buffer_object_handle& src_bo, size_t sz, size_t dst_offset, size_t src_offset) override;
 
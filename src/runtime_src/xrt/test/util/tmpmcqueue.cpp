@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2016-2020 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+////////////////////////////////////////////////////////////////
+// Unit testing and contention benchmark of task queues in
+// core/common/task.h
+////////////////////////////////////////////////////////////////
+#include <boost/test/unit_test.hpp>
+
+#include "xrt/util/task.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE ( test_mpmcqueue )
+
+namespace {
+
+static int sleepy_waiter(int i)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(i));
+  return i;
+}
+
+// Push 'items' integers through queue 'q' with 'producers' producer
+// threads and 'consumers' consumer threads.  Return ns per item.
+template <typename Queue>
+static double
+contention(Queue& q, unsigned int producers, unsigned int consumers, unsigned int items)
+{
+  std::atomic<unsigned long> sum {0};
+  std::atomic<unsigned int> consumed {0};
+  std::vector<std::thread> threads;
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (unsigned int c = 0; c < consumers; ++c)
+    threads.emplace_back([&] {
+      while (true) {
+        auto i = q.getWork();
+        if (!i)
+          break;
+        sum += *i;
+        delete i;
+        if (++consumed == items)
+          q.stop();
+      }
+    });
+
+  for (unsigned int p = 0; p < producers; ++p)
+    threads.emplace_back([&, p] {
+      for (unsigned int i = p; i < items; i += producers)
+        q.addWork(new unsigned int(i + 1));
+    });
+
+  for (auto& t : threads)
+    t.join();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  BOOST_CHECK_EQUAL(consumed, items);
+  BOOST_CHECK_EQUAL(sum, static_cast<unsigned long>(items) * (items + 1) / 2);
+  return std::chrono::duration<double, std::nano>(end - start).count() / items;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( test_lockfree_queue )
+{
+  xrt_xocl::task::lockfree_queue queue(4);
+  BOOST_CHECK_EQUAL(queue.capacity(), 4);
+
+  std::vector<std::thread> workers;
+  workers.push_back(std::thread(xrt_xocl::task::lockfree_worker,std::ref(queue),""));
+  workers.push_back(std::thread(xrt_xocl::task::lockfree_worker,std::ref(queue),""));
+
+  {
+    // more tasks than capacity, producer parks while queue is full
+    std::vector<xrt_xocl::task::event<int>> events;
+    for (int i = 0; i < 16; ++i)
+      events.push_back(xrt_xocl::task::createF(queue,&sleepy_waiter,i % 4));
+    for (int i = 0; i < 16; ++i)
+      BOOST_CHECK_EQUAL(events[i].get(), i % 4);
+  }
+
+  queue.stop();
+  for (auto& t : workers)
+    t.join();
+}
+
+BOOST_AUTO_TEST_CASE( test_queue_contention )
+{
+  const unsigned int items = 1000000;
+  const unsigned int threads[][2] = { {1,1}, {2,2}, {4,4}, {8,1}, {1,8} };
+  for (auto& pc : threads) {
+    xrt_xocl::task::mpmcqueue<unsigned int*> mq;
+    xrt_xocl::task::lockfree_mpmcqueue<unsigned int*> lq;
+    auto mns = contention(mq, pc[0], pc[1], items);
+    auto lns = contention(lq, pc[0], pc[1], items);
+    std::cout << "producers: " << pc[0] << ", consumers: " << pc[1]
+              << ", mpmcqueue (ns/item): " << mns
+              << ", lockfree_mpmcqueue (ns/item): " << lns << "\n";
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
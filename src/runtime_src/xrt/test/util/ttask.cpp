@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <iostream>
+#include <thread>
 
 BOOST_AUTO_TEST_SUITE ( test_task )
 
@@ -110,6 +111,41 @@ BOOST_AUTO_TEST_CASE( test_task1 )
     t.join();
 }
 
+BOOST_AUTO_TEST_CASE( test_task_executor )
+{
+  // two lanes, both workers homed on lane 0
+  xrt_xocl::task::executor exec(2);
+  exec.set_priority(1,1);
+  std::vector<std::thread> workers;
+  workers.push_back(std::thread(&xrt_xocl::task::executor::worker,&exec,0));
+  workers.push_back(std::thread(&xrt_xocl::task::executor::worker,&exec,0));
+
+  {
+    // tasks on lane 1 are executed by stealing workers
+    auto tev1 = xrt_xocl::task::createF(exec.get_lane(1),&sleepy_waiter,100);
+    auto tev2 = xrt_xocl::task::createF(exec.get_lane(1),&sleepy_waiter,100);
+    BOOST_CHECK_EQUAL(tev1.get(),100);
+    BOOST_CHECK_EQUAL(tev2.get(),100);
+    auto stats = exec.get_lane(1).get_stats();
+    BOOST_CHECK_EQUAL(stats.executed,2);
+    BOOST_CHECK_EQUAL(stats.stolen,2);
+  }
+
+  {
+    // create task from member function with args on home lane
+    API api;
+    auto tev = xrt_xocl::task::createM(exec.get_lane(0),&API::foo,api,10,'a');
+    BOOST_CHECK_EQUAL(tev.get(),10);
+    auto stats = exec.get_lane(0).get_stats();
+    BOOST_CHECK_EQUAL(stats.executed,1);
+    BOOST_CHECK_EQUAL(stats.stolen,0);
+  }
+
+  exec.stop();
+  for (auto& t : workers)
+    t.join();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
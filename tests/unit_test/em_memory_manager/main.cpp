@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Microbenchmark of the emulation device memory manager.  Allocates
+// many buffers, frees every other one to fragment the free space,
+// then frees and reallocates in random order.  Verifies that busy
+// ranges never overlap and that all memory is returned at the end.
+//
+// % em_memory_manager.exe [buffers]
+
+#include "memorymanager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::high_resolution_clock;
+
+static double
+elapsed_ns(clock_type::time_point start, size_t ops)
+{
+  return std::chrono::duration<double, std::nano>(clock_type::now() - start).count() / ops;
+}
+
+static void
+check_disjoint(std::vector<std::pair<uint64_t, uint64_t>> ranges)
+{
+  std::sort(ranges.begin(), ranges.end());
+  for (size_t i = 1; i < ranges.size(); ++i)
+    if (ranges[i-1].first + ranges[i-1].second > ranges[i].first)
+      throw std::runtime_error("overlapping allocations at " + std::to_string(ranges[i].first));
+}
+
+static int
+run(int argc, char** argv)
+{
+  size_t buffers = (argc > 1) ? std::strtoul(argv[1], nullptr, 0) : 50000;
+  if (!buffers)
+    throw std::runtime_error("buffers must be positive");
+
+  constexpr uint64_t alignment = 4096;
+  const uint64_t mem_size = buffers * 8 * alignment;
+  xclemulation::MemoryManager mm(mem_size, 0, alignment);
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<size_t> pages(1, 4);
+
+  // allocate
+  std::vector<std::pair<uint64_t, uint64_t>> busy;
+  busy.reserve(buffers);
+  auto start = clock_type::now();
+  for (size_t i = 0; i < buffers; ++i) {
+    size_t size = pages(gen) * alignment - 100;  // not aligned, rounded up
+    auto addr = mm.alloc(size);
+    if (addr == xclemulation::MemoryManager::mNull)
+      throw std::runtime_error("allocation " + std::to_string(i) + " failed");
+    if (addr % alignment)
+      throw std::runtime_error("misaligned allocation");
+    busy.emplace_back(addr, size);
+  }
+  std::cout << "alloc (ns/op): " << elapsed_ns(start, buffers) << "\n";
+  check_disjoint(busy);
+
+  // fragment
+  start = clock_type::now();
+  std::vector<std::pair<uint64_t, uint64_t>> kept;
+  for (size_t i = 0; i < busy.size(); ++i) {
+    if (i % 2)
+      mm.free(busy[i].first);
+    else
+      kept.push_back(busy[i]);
+  }
+  std::cout << "free (ns/op): " << elapsed_ns(start, busy.size() - kept.size()) << "\n";
+  busy = std::move(kept);
+
+  // churn, free a random buffer and allocate a new one
+  start = clock_type::now();
+  std::uniform_int_distribution<size_t> pick(0, busy.size() - 1);
+  for (size_t i = 0; i < buffers; ++i) {
+    auto& victim = busy[pick(gen)];
+    mm.free(victim.first);
+    size_t size = pages(gen) * alignment;
+    auto addr = mm.alloc(size);
+    if (addr == xclemulation::MemoryManager::mNull)
+      throw std::runtime_error("churn allocation " + std::to_string(i) + " failed");
+    victim = {addr, size};
+  }
+  std::cout << "free+alloc (ns/op): " << elapsed_ns(start, buffers) << "\n";
+  check_disjoint(busy);
+
+  for (const auto& b : busy) {
+    if (mm.lookup(b.first).second != b.second)
+      throw std::runtime_error("lookup mismatch at " + std::to_string(b.first));
+    mm.free(b.first);
+  }
+  if (mm.freeSize() != mem_size)
+    throw std::runtime_error("memory leaked, free size " + std::to_string(mm.freeSize()));
+
+  // everything coalesced back into one range
+  size_t all = mem_size;
+  if (mm.alloc(all) != 0)
+    throw std::runtime_error("free ranges not coalesced");
+
+  return 0;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+// Time construction of xrt::xclbin from a file and first access of
+// the xclbin meta data.  Construction maps the file and indexes the
+// sections, the meta data including the embedded XML is parsed on
+// first access only.
+//
+// % xclbin_load.exe <xclbin> [iterations]
+
+#include "experimental/xrt_xclbin.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using clock_type = std::chrono::high_resolution_clock;
+
+static double
+elapsed_us(clock_type::time_point start)
+{
+  return std::chrono::duration<double, std::micro>(clock_type::now() - start).count();
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 2)
+    throw std::runtime_error("usage: " + std::string(argv[0]) + " <xclbin> [iterations]");
+
+  std::string xclbin_fnm = argv[1];
+  int iterations = (argc > 2) ? std::atoi(argv[2]) : 10;
+  if (iterations <= 0)
+    throw std::runtime_error("iterations must be positive");
+
+  double load_us = 0;
+  double meta_us = 0;
+  double cached_us = 0;
+  for (int i = 0; i < iterations; ++i) {
+    auto start = clock_type::now();
+    xrt::xclbin xclbin{xclbin_fnm};
+    load_us += elapsed_us(start);
+
+    start = clock_type::now();
+    auto kernels = xclbin.get_kernels();
+    auto ips = xclbin.get_ips();
+    auto mems = xclbin.get_mems();
+    meta_us += elapsed_us(start);
+
+    if (kernels.empty())
+      throw std::runtime_error("no kernels in xclbin '" + xclbin_fnm + "'");
+
+    start = clock_type::now();
+    kernels = xclbin.get_kernels();
+    cached_us += elapsed_us(start);
+  }
+
+  std::cout << "xclbin load (us): " << load_us / iterations << "\n"
+            << "first meta data access (us): " << meta_us / iterations << "\n"
+            << "cached meta data access (us): " << cached_us / iterations << "\n";
+  return 0;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << '\n';
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,337 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+// Microbenchmarks of native XRT host API hot paths.
+//
+// Measures host side overhead of xrt::bo create/free/sync/address, xrt::kernel
+// construction, xrt::run set_arg/start/wait, sub-buffers versus views, xrt::runlist::execute,
+// and xrt::hw_context creation.  Meant to be run against the noop
+// shim, which completes commands without a device, so that results
+// reflect XRT host overhead only:
+//
+// % XCL_EMULATION_MODE=noop host_bench.exe -k kernel.xclbin
+//
+// Each benchmark is repeated until it has run for a minimum time and
+// reported as ns per operation.  Results can be saved with -o and
+// compared against a previous run with -r, in which case the program
+// fails if any benchmark is slower than the baseline by more than the
+// tolerance given with -t.  This makes the program usable as a
+// regression gate for host overhead.
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o host_bench.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_hw_context.h"
+#include "xrt/xrt_kernel.h"
+#include "experimental/xrt_kernel.h"
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::high_resolution_clock;
+
+struct benchmark
+{
+  std::string name;
+  std::function<void(unsigned int)> fn;  // run specified number of iterations
+};
+
+struct result
+{
+  unsigned int iterations;
+  double ns_per_op;
+};
+
+static void
+usage()
+{
+  std::cout << "usage: host_bench.exe [options]\n\n"
+            << "  -k <bitstream>\n"
+            << "  -d <bdf | device_index>\n"
+            << "  -f <benchmark name filter>\n"
+            << "  -m <minimum time per benchmark in ms>\n"
+            << "  -o <file to save results in>\n"
+            << "  -r <file with baseline results>\n"
+            << "  -t <tolerance in percent for baseline comparison>\n"
+            << "  -h\n\n"
+            << "* Bitstream is required\n"
+            << "* Kernel argument 0 of first kernel in bitstream must be a global buffer\n";
+}
+
+// Run a benchmark with increasing iteration count until it runs for
+// at least min_ms.
+static result
+measure(const benchmark& bm, unsigned int min_ms)
+{
+  const std::chrono::nanoseconds min_time = std::chrono::milliseconds(min_ms);
+  unsigned int iterations = 1;
+  while (true) {
+    auto start = clock_type::now();
+    bm.fn(iterations);
+    auto elapsed = clock_type::now() - start;
+    if (elapsed >= min_time || iterations >= (1u << 30))
+      return {iterations, std::chrono::duration<double, std::nano>(elapsed).count() / iterations};
+
+    // Estimate iterations needed, grow by at most 10x per round
+    auto ns = std::max<double>(1.0, std::chrono::duration<double, std::nano>(elapsed).count());
+    auto estimate = static_cast<double>(iterations) * 1.4 * min_time.count() / ns;
+    iterations = static_cast<unsigned int>(std::min(estimate, 10.0 * iterations)) + 1;
+  }
+}
+
+static std::map<std::string, double>
+read_results(const std::string& fnm)
+{
+  std::ifstream ifs(fnm);
+  if (!ifs)
+    throw std::runtime_error("Failed to open baseline '" + fnm + "'");
+
+  std::map<std::string, double> results;
+  std::string name;
+  unsigned int iterations = 0;
+  double ns = 0;
+  while (ifs >> name >> iterations >> ns)
+    results[name] = ns;
+  return results;
+}
+
+static std::vector<benchmark>
+create_benchmarks(const xrt::device& device, const xrt::xclbin& xclbin)
+{
+  auto uuid = xclbin.get_uuid();
+  auto kernels = xclbin.get_kernels();
+  if (kernels.empty())
+    throw std::runtime_error("No kernels in xclbin");
+  auto kname = kernels.front().get_name();
+
+  xrt::hw_context hwctx{device, uuid};
+  xrt::kernel kernel{hwctx, kname};
+  auto grpid = static_cast<xrt::memory_group>(kernel.group_id(0));
+  xrt::bo bo{device, 4096, grpid};
+  xrt::bo bo2{device, 4096, grpid};
+
+  std::vector<benchmark> benchmarks;
+
+  benchmarks.push_back({"bo_create_free_4k", [=](unsigned int n) {
+    for (unsigned int i = 0; i < n; ++i)
+      xrt::bo{device, 4096, grpid};
+  }});
+
+  benchmarks.push_back({"bo_create_free_1m", [=](unsigned int n) {
+    for (unsigned int i = 0; i < n; ++i)
+      xrt::bo{device, 1024*1024, grpid};
+  }});
+
+  benchmarks.push_back({"bo_sync_to_device_4k", [=](unsigned int n) mutable {
+    for (unsigned int i = 0; i < n; ++i)
+      bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+  }});
+
+  benchmarks.push_back({"bo_sync_from_device_4k", [=](unsigned int n) mutable {
+    for (unsigned int i = 0; i < n; ++i)
+      bo.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+  }});
+
+  // Trivial accessor, measures the native API profiling wrapper
+  benchmarks.push_back({"bo_address", [=](unsigned int n) {
+    uint64_t sum = 0;
+    for (unsigned int i = 0; i < n; ++i)
+      sum += bo.address();
+    if (sum == 1)
+      std::cout << sum;  // keep the calls
+  }});
+
+  benchmarks.push_back({"hw_context_create", [=](unsigned int n) {
+    for (unsigned int i = 0; i < n; ++i)
+      xrt::hw_context{device, uuid};
+  }});
+
+  benchmarks.push_back({"kernel_create", [=](unsigned int n) {
+    for (unsigned int i = 0; i < n; ++i)
+      xrt::kernel{hwctx, kname};
+  }});
+
+  benchmarks.push_back({"run_create", [=](unsigned int n) {
+    for (unsigned int i = 0; i < n; ++i)
+      xrt::run{kernel};
+  }});
+
+  benchmarks.push_back({"run_set_arg", [=](unsigned int n) {
+    xrt::run run{kernel};
+    for (unsigned int i = 0; i < n; ++i)
+      run.set_arg(0, (i & 1) ? bo : bo2);
+  }});
+
+  // Slice of a buffer per argument, sub-buffer versus view
+  benchmarks.push_back({"run_set_arg_sub_bo", [=](unsigned int n) mutable {
+    xrt::run run{kernel};
+    for (unsigned int i = 0; i < n; ++i)
+      run.set_arg(0, xrt::bo{bo, 1024, (i & 3) * 1024});
+  }});
+
+  benchmarks.push_back({"run_set_arg_bo_view", [=](unsigned int n) mutable {
+    xrt::run run{kernel};
+    for (unsigned int i = 0; i < n; ++i)
+      run.set_arg(0, xrt::bo_view{bo, 1024, (i & 3) * 1024});
+  }});
+
+  benchmarks.push_back({"run_start_wait", [=](unsigned int n) {
+    xrt::run run{kernel};
+    run.set_arg(0, bo);
+    for (unsigned int i = 0; i < n; ++i) {
+      run.start();
+      run.wait();
+    }
+  }});
+
+  benchmarks.push_back({"run_set_arg_start_wait", [=](unsigned int n) {
+    xrt::run run{kernel};
+    for (unsigned int i = 0; i < n; ++i) {
+      run.set_arg(0, (i & 1) ? bo : bo2);
+      run.start();
+      run.wait();
+    }
+  }});
+
+  benchmarks.push_back({"runlist_execute_8", [=](unsigned int n) {
+    xrt::runlist runlist{hwctx};
+    for (int i = 0; i < 8; ++i) {
+      xrt::run run{kernel};
+      run.set_arg(0, bo);
+      runlist.add(run);
+    }
+    for (unsigned int i = 0; i < n; ++i) {
+      runlist.execute();
+      runlist.wait();
+    }
+  }});
+
+  return benchmarks;
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  std::string device_index = "0";
+  std::string filter;
+  std::string output_fnm;
+  std::string baseline_fnm;
+  unsigned int min_ms = 500;
+  double tolerance = 10.0;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      device_index = arg;
+    else if (cur == "-f")
+      filter = arg;
+    else if (cur == "-m")
+      min_ms = std::stoi(arg);
+    else if (cur == "-o")
+      output_fnm = arg;
+    else if (cur == "-r")
+      baseline_fnm = arg;
+    else if (cur == "-t")
+      tolerance = std::stod(arg);
+    else
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("FAILED_TEST\nNo xclbin specified");
+
+  xrt::device device{device_index};
+  xrt::xclbin xclbin{xclbin_fnm};
+  device.register_xclbin(xclbin);
+
+  std::map<std::string, double> baseline;
+  if (!baseline_fnm.empty())
+    baseline = read_results(baseline_fnm);
+
+  std::ofstream ofs;
+  if (!output_fnm.empty())
+    ofs.open(output_fnm);
+
+  int regressions = 0;
+  for (auto& bm : create_benchmarks(device, xclbin)) {
+    if (!filter.empty() && bm.name.find(filter) == std::string::npos)
+      continue;
+
+    auto res = measure(bm, min_ms);
+    std::cout << std::left << std::setw(28) << bm.name << std::right
+              << std::setw(12) << res.iterations << " iterations"
+              << std::setw(14) << std::fixed << std::setprecision(1) << res.ns_per_op << " ns/op";
+
+    if (ofs.is_open())
+      ofs << bm.name << ' ' << res.iterations << ' ' << res.ns_per_op << '\n';
+
+    auto itr = baseline.find(bm.name);
+    if (itr != baseline.end()) {
+      auto delta = 100.0 * (res.ns_per_op - itr->second) / itr->second;
+      std::cout << "  (" << std::showpos << delta << std::noshowpos << "% vs baseline)";
+      if (delta > tolerance) {
+        std::cout << " REGRESSION";
+        ++regressions;
+      }
+    }
+    std::cout << '\n';
+  }
+
+  if (regressions)
+    throw std::runtime_error(std::to_string(regressions) + " benchmark(s) regressed more than "
+                             + std::to_string(tolerance) + "% against baseline");
+
+  return 0;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& ex) {
+    std::cout << "Exception: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "Exception\n";
+  }
+
+  std::cout << "FAILED TEST\n";
+  return 1;
+}
@@ -0,0 +1,167 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+// Card to card copy bandwidth with xrt::bo::copy.
+//
+// Allocates a device buffer on the source device and a P2P buffer on
+// the destination device and copies between the two in both
+// directions.  When the devices are P2P peers below a common PCIe
+// switch the copy is a direct peer DMA, otherwise it reverts to the
+// export/import path.  The same copies to a plain device buffer on
+// the destination device are timed for comparison.  Content is
+// verified after each copy.
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o p2p_copy.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void
+usage()
+{
+  std::cout << "usage: p2p_copy.exe [options]\n\n"
+            << "  -k <bitstream>\n"
+            << "  -s <source bdf | device_index>\n"
+            << "  -d <destination bdf | device_index>\n"
+            << "  -b <buffer size in bytes>\n"
+            << "  -i <iterations>\n"
+            << "  -h\n\n"
+            << "* Bitstream is required and is loaded on both devices\n";
+}
+
+static void
+fill(xrt::bo& bo, int value)
+{
+  std::memset(bo.map(), value, bo.size());
+  bo.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+}
+
+static void
+verify(xrt::bo& bo, int value)
+{
+  bo.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+  auto data = bo.map<unsigned char*>();
+  for (size_t i = 0; i < bo.size(); ++i)
+    if (data[i] != static_cast<unsigned char>(value))
+      throw std::runtime_error("content mismatch at offset " + std::to_string(i));
+}
+
+// Copy src to dst iterations times and return bandwidth in MB/s
+static double
+run(xrt::bo& dst, xrt::bo& src, unsigned int iterations)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    dst.copy(src);
+  auto end = std::chrono::high_resolution_clock::now();
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  return us ? static_cast<double>(src.size()) * iterations / us : 0;
+}
+
+static void
+report(const char* what, double mbps)
+{
+  std::cout << std::setw(24) << what << ": " << std::setw(10) << mbps << " MB/s\n";
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  std::string src_index = "0";
+  std::string dst_index = "1";
+  size_t bo_size = 16 * 1024 * 1024;
+  unsigned int iterations = 16;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-s")
+      src_index = arg;
+    else if (cur == "-d")
+      dst_index = arg;
+    else if (cur == "-b")
+      bo_size = std::stoul(arg);
+    else if (cur == "-i")
+      iterations = std::stoi(arg);
+    else
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("FAILED_TEST\nNo xclbin specified");
+
+  xrt::device src_device{src_index};
+  xrt::device dst_device{dst_index};
+  src_device.load_xclbin(xclbin_fnm);
+  dst_device.load_xclbin(xclbin_fnm);
+
+  xrt::bo src{src_device, bo_size, 0};
+  xrt::bo dst{dst_device, bo_size, 0};
+  xrt::bo dst_p2p{dst_device, bo_size, xrt::bo::flags::p2p, 0};
+
+  // Card to card into and out of P2P buffer
+  fill(src, 0xa5);
+  dst_p2p.copy(src);
+  verify(dst_p2p, 0xa5);
+  fill(dst_p2p, 0x5a);
+  src.copy(dst_p2p);
+  verify(src, 0x5a);
+
+  // Card to card through export of buffer
+  dst.copy(src);
+  verify(dst, 0x5a);
+
+  std::cout << bo_size << " bytes, " << iterations << " iterations\n";
+  report("to p2p buffer", run(dst_p2p, src, iterations));
+  report("from p2p buffer", run(src, dst_p2p, iterations));
+  report("to device buffer", run(dst, src, iterations));
+
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& ex) {
+    std::cout << "Exception: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "Exception\n";
+  }
+
+  std::cout << "FAILED TEST\n";
+  return 1;
+}
@@ -0,0 +1,170 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ */
+
+// Benchmark xrt::bo::sync_many against syncing buffers one by one.
+//
+// Allocates a number of small buffers in memory bank of kernel argument
+// 0 and syncs them to and from device, first with a per BO loop, then
+// with xrt::bo::sync_many.  Content is verified after round trip.
+//
+// % g++ -g -std=c++17 -I$XILINX_XRT/include -L$XILINX_XRT/lib -o sync_many.exe main.cpp -lxrt_coreutil -luuid -pthread
+
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_device.h"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void
+usage()
+{
+  std::cout << "usage: sync_many.exe [options]\n\n"
+            << "  -k <bitstream>\n"
+            << "  -d <bdf | device_index>\n"
+            << "  -n <number of buffers per sync>\n"
+            << "  -s <buffer size in bytes>\n"
+            << "  -i <iterations>\n"
+            << "  -h\n\n"
+            << "* Bitstream is required\n";
+}
+
+static double
+run_loop(std::vector<xrt::bo>& bos, xclBOSyncDirection dir, unsigned int iterations)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    for (auto& bo : bos)
+      bo.sync(dir);
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+static double
+run_many(const std::vector<xrt::bo>& bos, xclBOSyncDirection dir, unsigned int iterations)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    xrt::bo::sync_many(bos, dir);
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+static void
+verify(std::vector<xrt::bo>& bos)
+{
+  for (size_t idx = 0; idx < bos.size(); ++idx)
+    std::memset(bos[idx].map(), static_cast<int>(idx + 1), bos[idx].size());
+
+  xrt::bo::sync_many(bos, XCL_BO_SYNC_BO_TO_DEVICE);
+
+  for (auto& bo : bos)
+    std::memset(bo.map(), 0, bo.size());
+
+  xrt::bo::sync_many(bos, XCL_BO_SYNC_BO_FROM_DEVICE);
+
+  for (size_t idx = 0; idx < bos.size(); ++idx) {
+    auto data = bos[idx].map<unsigned char*>();
+    for (size_t i = 0; i < bos[idx].size(); ++i)
+      if (data[i] != static_cast<unsigned char>(idx + 1))
+        throw std::runtime_error("content mismatch in buffer " + std::to_string(idx));
+  }
+}
+
+static void
+report(const char* what, double loop_us, double many_us, size_t syncs)
+{
+  std::cout << std::setw(12) << what
+            << " loop: " << std::setw(10) << loop_us / syncs << " us/bo"
+            << " sync_many: " << std::setw(10) << many_us / syncs << " us/bo"
+            << " speedup: " << loop_us / many_us << "x\n";
+}
+
+static int
+run(int argc, char** argv)
+{
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fnm;
+  std::string device_index = "0";
+  unsigned int num_bos = 32;
+  size_t bo_size = 4096;
+  unsigned int iterations = 1000;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-k")
+      xclbin_fnm = arg;
+    else if (cur == "-d")
+      device_index = arg;
+    else if (cur == "-n")
+      num_bos = std::stoi(arg);
+    else if (cur == "-s")
+      bo_size = std::stoul(arg);
+    else if (cur == "-i")
+      iterations = std::stoi(arg);
+    else
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  if (xclbin_fnm.empty())
+    throw std::runtime_error("FAILED_TEST\nNo xclbin specified");
+
+  xrt::device device{device_index};
+  device.load_xclbin(xclbin_fnm);
+
+  std::vector<xrt::bo> bos;
+  for (unsigned int i = 0; i < num_bos; ++i)
+    bos.emplace_back(device, bo_size, 0);
+
+  verify(bos);
+
+  auto syncs = static_cast<size_t>(num_bos) * iterations;
+  std::cout << num_bos << " buffers of " << bo_size << " bytes, "
+            << iterations << " iterations\n";
+  report("to device", run_loop(bos, XCL_BO_SYNC_BO_TO_DEVICE, iterations),
+         run_many(bos, XCL_BO_SYNC_BO_TO_DEVICE, iterations), syncs);
+  report("from device", run_loop(bos, XCL_BO_SYNC_BO_FROM_DEVICE, iterations),
+         run_many(bos, XCL_BO_SYNC_BO_FROM_DEVICE, iterations), syncs);
+
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    auto ret = run(argc, argv);
+    std::cout << "PASSED TEST\n";
+    return ret;
+  }
+  catch (std::exception const& ex) {
+    std::cout << "Exception: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "Exception\n";
+  }
+
+  std::cout << "FAILED TEST\n";
+  return 1;
+}